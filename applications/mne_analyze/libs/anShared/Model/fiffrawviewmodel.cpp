@@ -85,6 +85,9 @@ using namespace RTPROCESSINGLIB;
 
 FiffRawViewModel::FiffRawViewModel(QObject *pParent)
 : AbstractModel(pParent)
+, m_iFilterGeneration(0)
+, m_iFilterRunGeneration(0)
+, m_bFilterPending(false)
 {
     qInfo() << "[FiffRawViewModel::FiffRawViewModel] Default constructor called !";
 }
@@ -107,6 +110,8 @@ FiffRawViewModel::FiffRawViewModel(const QString &sFilePath,
 , m_bEndOfFileReached(false)
 , m_blockLoadFutureWatcher()
 , m_bCurrentlyLoading(false)
+, m_iCacheBytes(0)
+, m_iMaxCacheBytes(512 * 1024 * 1024)
 , m_pRtFilter(FilterOverlapAdd::SPtr::create())
 , m_bPerformFiltering(false)
 , m_iDistanceTimerSpacer(1000)
@@ -115,6 +120,9 @@ FiffRawViewModel::FiffRawViewModel(const QString &sFilePath,
 , m_bDispEvent(true)
 , m_bRealtime(false)
 , m_iLastFileEndSample(0)
+, m_iFilterGeneration(0)
+, m_iFilterRunGeneration(0)
+, m_bFilterPending(false)
 //, m_pEventModel(QSharedPointer<EventModel>::create())
 {
     // connect data reloading: this will be run concurrently
@@ -123,6 +131,12 @@ FiffRawViewModel::FiffRawViewModel(const QString &sFilePath,
                 postBlockLoad(m_blockLoadFutureWatcher.future().result());
             });
 
+    // connect background filtering
+    connect(&m_filterFutureWatcher, &QFutureWatcher<QList<QSharedPointer<DataBlock> > >::finished,
+            [this]() {
+                postFilter(m_filterFutureWatcher.future().result());
+            });
+
     if(byteLoadedData.isEmpty()) {
         m_file.setFileName(sFilePath);
         initFiffData(m_file);
@@ -139,6 +153,9 @@ FiffRawViewModel::FiffRawViewModel(const QString &sFilePath,
 
 FiffRawViewModel::~FiffRawViewModel()
 {
+    m_prefetchFuture.waitForFinished();
+    m_filterFutureWatcher.waitForFinished();
+
     if(m_bRealtime){
         m_file.remove();
     }
@@ -148,6 +165,15 @@ FiffRawViewModel::~FiffRawViewModel()
 
 bool FiffRawViewModel::initFiffData(QIODevice& p_IODevice)
 {
+    // Held and cached blocks belong to the previous file
+    clearBlockCache();
+    ++m_iFilterGeneration;
+
+    m_dataMutex.lock();
+    m_lData.clear();
+    m_lFilteredData.clear();
+    m_dataMutex.unlock();
+
     // build FiffIO
     m_pFiffIO = QSharedPointer<FiffIO>::create(p_IODevice);
 
@@ -218,7 +244,16 @@ QVariant FiffRawViewModel::data(const QModelIndex &index,
 
                     // wrap in ChannelData container and then wrap into QVariant
                     if(m_bPerformFiltering) {
-                        result.setValue(ChannelData(m_lFilteredData, index.row()));
+                        // Show the raw data of dirty blocks until they got filtered in the background
+                        std::list<QSharedPointer<DataBlock> > lData;
+                        std::list<QSharedPointer<DataBlock> >::const_iterator itRaw = m_lData.begin();
+
+                        for(const QSharedPointer<DataBlock>& pBlock : m_lFilteredData) {
+                            lData.push_back(pBlock ? pBlock : *itRaw);
+                            ++itRaw;
+                        }
+
+                        result.setValue(ChannelData(lData, index.row()));
                     } else {
                         result.setValue(ChannelData(m_lData, index.row()));
                     }
@@ -503,7 +538,7 @@ void FiffRawViewModel::setFilter(const FilterKernel& filterData)
     m_filterKernel = filterData;
 
     if(m_bPerformFiltering) {
-        reloadAllData();
+        invalidateFilteredData();
     }
 }
 //=============================================================================================================
@@ -520,7 +555,7 @@ void FiffRawViewModel::setFilterActive(bool bState)
     m_bPerformFiltering = bState;
 
     if(m_bPerformFiltering) {
-        reloadAllData();
+        invalidateFilteredData();
     }
     emit dataChanged(createIndex(0,0), createIndex(rowCount(), columnCount()));
 }
@@ -555,7 +590,7 @@ void FiffRawViewModel::setFilterChannelType(const QString& channelType)
     }
 
     if(m_bPerformFiltering) {
-        reloadAllData();
+        invalidateFilteredData();
     }
 }
 
@@ -630,19 +665,19 @@ void FiffRawViewModel::updateHorizontalScrollPosition(qint32 newScrollPosition)
             postBlockLoad(loadLaterBlocks(blockDist));
         }
     }
+
+    filterVisibleBlocks();
 }
 
 //=============================================================================================================
 
 bool FiffRawViewModel::filterDataBlock(MatrixXd& matData,
+                                       const FilterKernel& filterKernel,
+                                       const RowVectorXi& vecChannels,
                                        bool bFilterEnd,
                                        bool bKeepOverhead)
 {
-    if(!m_bPerformFiltering) {
-        return false;
-    }
-
-    if(m_lFilterChannelList.cols() == 0) {
+    if(vecChannels.cols() == 0) {
         qWarning() << "[FiffRawViewModel::filterDataBlock] No channels to filter specified.";
         return false;
     }
@@ -653,9 +688,23 @@ bool FiffRawViewModel::filterDataBlock(MatrixXd& matData,
     bUseThread = false;
     #endif
 
+    // The data is fully available offline, filter IIR kernels forward and backward to avoid any phase distortion
+    if(filterKernel.isIir()) {
+        matData = RTPROCESSINGLIB::filterData(matData,
+                                              filterKernel,
+                                              vecChannels,
+                                              bUseThread,
+                                              bKeepOverhead);
+        return true;
+    }
+
+    // Blocks are filtered out of order, overlaps of the previous call do not belong to this data. Only one filter
+    // run is going on at a time, so the filter object is not shared between threads.
+    m_pRtFilter->reset();
+
     matData = m_pRtFilter->calculate(matData,
-                                     m_filterKernel,
-                                     m_lFilterChannelList,
+                                     filterKernel,
+                                     vecChannels,
                                      bFilterEnd,
                                      bUseThread,
                                      bKeepOverhead);
@@ -701,81 +750,23 @@ int FiffRawViewModel::loadEarlierBlocks(qint32 numBlocks)
         }
     }
 
-    // we expect m_lNewData and m_lFilteredNewData to be empty:
-    if (m_lNewData.empty() == false ||
-        m_lFilteredNewData.empty() == false) {
+    // we expect m_lNewData to be empty:
+    if (m_lNewData.empty() == false) {
         qWarning() << "[FiffRawViewModel::loadEarlierBlocks] Warning! Temporary data storage non empty !";
         return -1;
     }
 
-    // build data structures to be filled from file
-    MatrixXd matData, matTimes;
-
-    // initialize start and end indices
     int start = m_iFiffCursorBegin - (numBlocks * m_iSamplesPerBlock);
-    int end = m_iFiffCursorBegin - 1;
-
-    // Update m_iFiffCursorBegin before we account for the filter delay
-    if(start <= absoluteFirstSample()) {
-        m_iFiffCursorBegin = absoluteFirstSample();
-    } else {
-        m_iFiffCursorBegin = start;
-    }
 
-    // When filtering load more data than we need in order to allow arbiritary filter lengths
-    int iFilterDelay = 0;
-    bool bBeforeStartReached = false;
-
-    if(m_bPerformFiltering) {
-        iFilterDelay = m_filterKernel.getFilterOrder()/2;
-        end += m_filterKernel.getFilterOrder()/2;
+    // Read the raw data. Filtering is done lazily once the blocks become visible.
+    m_lNewData = readBlocks(start, numBlocks);
 
-        // Check if we have reached the beginning/end of the file
-        if(start-iFilterDelay >= absoluteFirstSample()) {
-            start -= m_filterKernel.getFilterOrder()/2;
-        } else {
-            // Add another filter delay because we need enough data to sucessfully filter with arbiritary filter lengths
-            end += m_filterKernel.getFilterOrder()/2;
-            iFilterDelay = 0;
-            bBeforeStartReached = true;
-        }
-    }
-
-    // Read the raw data
-    if(m_pFiffIO->m_qlistRaw[0]->read_raw_segment(matData, matTimes, start, end)) {
-        // qDebug() << "[FiffRawViewModel::loadFiffData] Successfully read a block ";
-    } else {
+    if(m_lNewData.empty()) {
         qWarning() << "[FiffRawViewModel::loadEarlierBlocks] Could not read block ";
         return -1;
     }
 
-    for(int i = 0; i < numBlocks; ++i) {
-        m_lNewData.push_front(QSharedPointer<QPair<MatrixXd, MatrixXd> >::create(qMakePair(matData.block(0, i*m_iSamplesPerBlock+iFilterDelay, matData.rows(), m_iSamplesPerBlock),
-                                                                                           matTimes.block(0, i*m_iSamplesPerBlock+iFilterDelay, matTimes.rows(), m_iSamplesPerBlock))));
-    }
-
-    // Filter data if activated, otherwise set to raw data
-    if(m_bPerformFiltering) {
-        bool bFilterSuccess = false;
-        if(bBeforeStartReached) {
-            iFilterDelay = m_filterKernel.getFilterOrder()/4;
-            bFilterSuccess = filterDataBlock(matData, true, true);
-        } else {
-            bFilterSuccess = filterDataBlock(matData, true);
-        }
-
-        if(!bFilterSuccess) {
-            m_lFilteredNewData = m_lNewData;
-            return 0;
-        }
-
-        for(int i = 0; i < numBlocks; ++i) {
-            m_lFilteredNewData.push_front(QSharedPointer<QPair<MatrixXd, MatrixXd> >::create(qMakePair(matData.block(0, (i*m_iSamplesPerBlock)+(2*iFilterDelay), matData.rows(), m_iSamplesPerBlock),
-                                                                                                       matTimes.block(0, (i*m_iSamplesPerBlock)+(2*iFilterDelay), matTimes.rows(), m_iSamplesPerBlock))));
-        }
-    } else {
-        m_lFilteredNewData = m_lNewData;
-    }
+    m_iFiffCursorBegin = start;
 
     // return 0, meaning that this was a loading of earlier blocks
     return 0;
@@ -801,70 +792,24 @@ int FiffRawViewModel::loadLaterBlocks(qint32 numBlocks)
         }
     }
 
-    // we expect m_lNewData and m_lFilteredNewData to be empty:
-    if (m_lNewData.empty() == false ||
-        m_lFilteredNewData.empty() == false) {
-        qWarning() << "[FiffRawViewModel::loadEarlierBlocks] Warning! Temporary data storage non empty !";
+    // we expect m_lNewData to be empty:
+    if (m_lNewData.empty() == false) {
+        qWarning() << "[FiffRawViewModel::loadLaterBlocks] Warning! Temporary data storage non empty !";
         return -1;
     }
 
-    // build data structures to be filled from file
-    MatrixXd matData, matTimes;
-
-    // initialize start and end indices
     int start = m_iFiffCursorBegin + (m_iTotalBlockCount * m_iSamplesPerBlock);
-    int end = start + (m_iSamplesPerBlock * numBlocks) - 1;
 
-    // adjust fiff cursor
-    m_iFiffCursorBegin += numBlocks * m_iSamplesPerBlock;
-
-    // Account for filter delay of current filter kernel
-    int iFilterDelay = 0;
+    // Read the raw data. Filtering is done lazily once the blocks become visible.
+    m_lNewData = readBlocks(start, numBlocks);
 
-    if(m_bPerformFiltering) {
-        iFilterDelay = m_filterKernel.getFilterOrder()/2;
-
-        // Check if we have reached the beginning/end of the file
-        if(start-iFilterDelay > absoluteFirstSample()) {
-            start -= m_filterKernel.getFilterOrder()/2;
-        } else {
-            iFilterDelay = 0;
-        }
-
-        if(end+iFilterDelay < m_pFiffIO->m_qlistRaw[0]->last_samp) {
-            end += m_filterKernel.getFilterOrder()/2;
-        } else {
-            iFilterDelay = 0;
-        }
-    }
-
-    // read data
-    if(m_pFiffIO->m_qlistRaw[0]->read_raw_segment(matData, matTimes, start, end)) {
-        // qDebug() << "[FiffRawViewModel::loadFiffData] Successfully read a block ";
-    } else {
+    if(m_lNewData.empty()) {
         qWarning() << "[FiffRawViewModel::loadLaterBlocks] Could not read block ";
         return -1;
     }
 
-    for(int i = 0; i < numBlocks; ++i) {
-        m_lNewData.push_back(QSharedPointer<QPair<MatrixXd, MatrixXd> >::create(qMakePair(matData.block(0, i*m_iSamplesPerBlock+iFilterDelay, matData.rows(), m_iSamplesPerBlock),
-                                                                                          matTimes.block(0, i*m_iSamplesPerBlock+iFilterDelay, matTimes.rows(), m_iSamplesPerBlock))));
-    }
-
-    // Filter data if activated, otherwise set to raw data
-    if(m_bPerformFiltering) {
-        if(!filterDataBlock(matData, true)) {
-            m_lFilteredNewData = m_lNewData;
-            return 1;
-        }
-
-        for(int i = 0; i < numBlocks; ++i) {
-            m_lFilteredNewData.push_back(QSharedPointer<QPair<MatrixXd, MatrixXd> >::create(qMakePair(matData.block(0, i*m_iSamplesPerBlock+(2*iFilterDelay), matData.rows(), m_iSamplesPerBlock),
-                                                                                                      matTimes.block(0, i*m_iSamplesPerBlock+(2*iFilterDelay), matTimes.rows(), m_iSamplesPerBlock))));
-        }
-    } else {
-        m_lFilteredNewData = m_lNewData;
-    }
+    // adjust fiff cursor
+    m_iFiffCursorBegin += numBlocks * m_iSamplesPerBlock;
 
     // return 1, meaning that this was a loading of later blocks
     return 1;
@@ -874,28 +819,30 @@ int FiffRawViewModel::loadLaterBlocks(qint32 numBlocks)
 
 void FiffRawViewModel::postBlockLoad(int result)
 {
+    std::list<QSharedPointer<DataBlock> > lDroppedData;
+
     switch(result){
         case -1:
             qWarning() << "[FiffRawViewModel::postBlockLoad] QFuture returned an error: " << result;
             break;
         case 0:
         {
-            // insertion of earlier blocks
+            // insertion of earlier blocks, m_lNewData is sorted ascending so start with the last one
             int iNewBlocks = static_cast<int>(m_lNewData.size());
 
             m_dataMutex.lock();
             for (int i = 0; i < iNewBlocks; ++i) {
                 //Raw data
-                m_lData.push_front(m_lNewData.front());
-                m_lData.pop_back(); // @TODO check if this really frees the associated memory
+                m_lData.push_front(m_lNewData.back());
+                lDroppedData.push_back(m_lData.back());
+                m_lData.pop_back();
 
-                //Filtered data
-                m_lFilteredData.push_front(m_lFilteredNewData.front());
+                //Filtered data, marked as dirty
+                m_lFilteredData.push_front(QSharedPointer<DataBlock>());
                 m_lFilteredData.pop_back();
 
-                //Pop new data, which is now stored in m_lData and m_lFilteredData
-                m_lNewData.pop_front();
-                m_lFilteredNewData.pop_front();
+                //Pop new data, which is now stored in m_lData
+                m_lNewData.pop_back();
             }
             m_dataMutex.unlock();
 
@@ -912,15 +859,15 @@ void FiffRawViewModel::postBlockLoad(int result)
             for (int i = 0; i < iNewBlocks; ++i) {
                 //Raw data
                 m_lData.push_back(m_lNewData.front());
+                lDroppedData.push_back(m_lData.front());
                 m_lData.pop_front();
 
-                //Filtered data
-                m_lFilteredData.push_back(m_lFilteredNewData.front());
+                //Filtered data, marked as dirty
+                m_lFilteredData.push_back(QSharedPointer<DataBlock>());
                 m_lFilteredData.pop_front();
 
-                //Pop new data, which is now stored in m_lData and m_lFilteredData
+                //Pop new data, which is now stored in m_lData
                 m_lNewData.pop_front();
-                m_lFilteredNewData.pop_front();
             }
             m_dataMutex.unlock();
 
@@ -932,9 +879,19 @@ void FiffRawViewModel::postBlockLoad(int result)
             qWarning() << "[FiffRawViewModel::postBlockLoad] FATAL Non-intended return value: " << result;
     }
 
+    // Keep the dropped blocks around in case the user scrolls back
+    for(const QSharedPointer<DataBlock>& pBlock : lDroppedData) {
+        cacheBlock(pBlock);
+    }
+
     updateEndStartFlags();
     m_bCurrentlyLoading = false;
 
+    // Read ahead in scroll direction
+    if(result == 0 || result == 1) {
+        startPrefetch(result == 1);
+    }
+
     emit dataChanged(createIndex(0,0), createIndex(rowCount(), columnCount()));
 }
 
@@ -946,73 +903,342 @@ void FiffRawViewModel::reloadAllData()
         return;
     }
 
-    m_lData.clear();
-    m_lFilteredData.clear();
+    // Keep the blocks we already hold, the new window might overlap with the old one
+    for(const QSharedPointer<DataBlock>& pBlock : m_lData) {
+        cacheBlock(pBlock);
+    }
 
-    MatrixXd matData, matTimes;
+    std::list<QSharedPointer<DataBlock> > lData = readBlocks(m_iFiffCursorBegin, m_iTotalBlockCount);
 
-    int start = m_iFiffCursorBegin;
+    m_dataMutex.lock();
+    m_lData = lData;
+    // All filtered blocks are dirty
+    m_lFilteredData.assign(m_lData.size(), QSharedPointer<DataBlock>());
+    m_dataMutex.unlock();
 
-    // for some reason the read_raw_segment function works with inclusive upper bound
-    int end = start + (m_iSamplesPerBlock * m_iTotalBlockCount) - 1;
+    if(m_lData.empty()) {
+        qWarning() << "[FiffRawViewModel::reloadAllData] Could not read samples " << m_iFiffCursorBegin << " to " << m_iFiffCursorBegin + (m_iSamplesPerBlock * m_iTotalBlockCount) - 1;
+        return;
+    }
 
-    // When filtering load more data than we need in order to allow arbiritary filter lengths
-    int iFilterDelay = 0;
-    bool bBeforeStartReached = false;
+    filterVisibleBlocks();
 
-    if(m_bPerformFiltering) {
-        iFilterDelay = m_filterKernel.getFilterOrder()/2;
-        end += m_filterKernel.getFilterOrder()/2;
+    emit dataChanged(createIndex(0,0), createIndex(rowCount(), columnCount()));
+}
 
-        // Check if we have reached the beginning of the file
-        if(start-iFilterDelay >= m_pFiffIO->m_qlistRaw[0]->first_samp) {
-            start -= m_filterKernel.getFilterOrder()/2;
-        } else {
-            // Add another filter delay because we need enough data to sucessfully filter with arbiritary filter lengths
-            end += m_filterKernel.getFilterOrder()/2;
-            iFilterDelay = 0;
-            bBeforeStartReached = true;
-        }
+//=============================================================================================================
+
+void FiffRawViewModel::invalidateFilteredData()
+{
+    // Results of a filter run which is still going on are outdated
+    ++m_iFilterGeneration;
+
+    m_dataMutex.lock();
+    m_lFilteredData.assign(m_lData.size(), QSharedPointer<DataBlock>());
+    m_dataMutex.unlock();
+
+    filterVisibleBlocks();
+}
+
+//=============================================================================================================
+
+void FiffRawViewModel::filterVisibleBlocks()
+{
+    if(!m_bPerformFiltering || m_lData.empty() || m_iSamplesPerBlock <= 0) {
+        return;
     }
 
-    // read in all blocks
-    if(m_pFiffIO->m_qlistRaw[0]->read_raw_segment(matData, matTimes, start, end)) {
-        // qDebug() << "[FiffRawmodel::loadFiffData] Successfully read a block ";
-    } else {
-        qWarning() << "[FiffRawViewModel::loadFiffData] Could not read samples " << start << " to " << end;
+    // Only one filter run at a time, check the visible window again once the current one finished
+    if(m_filterFutureWatcher.isRunning()) {
+        m_bFilterPending = true;
         return;
     }
 
-    // append a matrix pair for each block
-    for(int i = 0; i < m_iTotalBlockCount; ++i) {
-        m_lData.push_back(QSharedPointer<QPair<MatrixXd, MatrixXd> >::create(qMakePair(matData.block(0, i*m_iSamplesPerBlock+iFilterDelay, matData.rows(), m_iSamplesPerBlock),
-                                                                                       matTimes.block(0, i*m_iSamplesPerBlock+iFilterDelay, matTimes.rows(), m_iSamplesPerBlock))));
+    std::vector<QSharedPointer<DataBlock> > vecData(m_lData.begin(), m_lData.end());
+    std::vector<QSharedPointer<DataBlock> > vecFilteredData(m_lFilteredData.begin(), m_lFilteredData.end());
+    int iNumBlocks = static_cast<int>(vecData.size());
+
+    // Find the blocks covered by the visible window
+    qint32 iVisibleFirstSample = (m_iScrollPos / m_dDx) + absoluteFirstSample();
+    int iFirstBlock = qBound(0, (iVisibleFirstSample - m_iFiffCursorBegin) / m_iSamplesPerBlock, iNumBlocks - 1);
+    int iLastBlock = qBound(0, (iVisibleFirstSample + sampleWindowSize() - 1 - m_iFiffCursorBegin) / m_iSamplesPerBlock, iNumBlocks - 1);
+
+    while(iFirstBlock <= iLastBlock && vecFilteredData.at(iFirstBlock)) {
+        ++iFirstBlock;
+    }
+    while(iLastBlock >= iFirstBlock && vecFilteredData.at(iLastBlock)) {
+        --iLastBlock;
     }
 
-    // Filter data if activated, otherwise set to raw data
-    if(m_bPerformFiltering) {
-        bool bFilterSuccess = false;
-        if(bBeforeStartReached) {
-            iFilterDelay = m_filterKernel.getFilterOrder()/4;
-            bFilterSuccess = filterDataBlock(matData, true, true);
+    if(iFirstBlock > iLastBlock) {
+        return;
+    }
+
+    // Use the neighbouring raw blocks as filter context, so that the filter transients fall outside the dirty blocks
+    int iOrder = m_filterKernel.getFilterOrder();
+    int iContextBlocks = (iOrder + m_iSamplesPerBlock - 1) / m_iSamplesPerBlock;
+    if(m_filterKernel.isIir()) {
+        // The order of IIR kernels does not bound their impulse response, always use at least one context block
+        iContextBlocks = std::max(iContextBlocks, 1);
+    }
+    int iFrom = std::max(0, iFirstBlock - iContextBlocks);
+    int iTo = std::min(iNumBlocks - 1, iLastBlock + iContextBlocks);
+
+    QVector<QSharedPointer<DataBlock> > vecBlocks;
+    vecBlocks.reserve(iTo - iFrom + 1);
+    for(int i = iFrom; i <= iTo; ++i) {
+        vecBlocks.append(vecData.at(i));
+    }
+
+    m_iFilterRunGeneration = m_iFilterGeneration;
+
+    // In WASM mode do not use multithreading for filtering
+    #ifdef WASMBUILD
+    postFilter(filterBlocks(vecBlocks, iFirstBlock - iFrom, iLastBlock - iFrom, m_filterKernel, m_lFilterChannelList));
+    #else
+    QFuture<QList<QSharedPointer<DataBlock> > > future = QtConcurrent::run(this,
+                                                                           &FiffRawViewModel::filterBlocks,
+                                                                           vecBlocks,
+                                                                           iFirstBlock - iFrom,
+                                                                           iLastBlock - iFrom,
+                                                                           m_filterKernel,
+                                                                           m_lFilterChannelList);
+    m_filterFutureWatcher.setFuture(future);
+    #endif
+}
+
+//=============================================================================================================
+
+QList<QSharedPointer<DataBlock> > FiffRawViewModel::filterBlocks(const QVector<QSharedPointer<DataBlock> >& vecBlocks,
+                                                                 int iFirstDirty,
+                                                                 int iLastDirty,
+                                                                 const FilterKernel& filterKernel,
+                                                                 const RowVectorXi& vecChannels)
+{
+    QList<QSharedPointer<DataBlock> > lFilteredBlocks;
+
+    if(vecBlocks.isEmpty()) {
+        return lFilteredBlocks;
+    }
+
+    // All blocks have the same size, do not rely on m_iSamplesPerBlock which belongs to the GUI thread
+    int iSamplesPerBlock = vecBlocks.first()->matData.cols();
+    MatrixXd matData(vecBlocks.first()->matData.rows(), vecBlocks.size() * iSamplesPerBlock);
+
+    for(int i = 0; i < vecBlocks.size(); ++i) {
+        matData.middleCols(i * iSamplesPerBlock, iSamplesPerBlock) = vecBlocks.at(i)->matData.cast<double>();
+    }
+
+    // The filtered data keeps the overhead and is delayed by iOrder/2
+    int iOrder = filterKernel.getFilterOrder();
+    int iFilterDelay = iOrder/2;
+
+    if(matData.cols() < iOrder || !filterDataBlock(matData, filterKernel, vecChannels, true, true)) {
+        matData = MatrixXd();
+    }
+
+    for(int i = iFirstDirty; i <= iLastDirty; ++i) {
+        if(matData.size() == 0) {
+            // Filtering not possible, show raw data
+            lFilteredBlocks.append(vecBlocks.at(i));
         } else {
-            bFilterSuccess = filterDataBlock(matData, true);
+            lFilteredBlocks.append(QSharedPointer<DataBlock>::create(matData.middleCols(i * iSamplesPerBlock + iFilterDelay, iSamplesPerBlock),
+                                                                     vecBlocks.at(i)->iFirstSample));
+        }
+    }
+
+    return lFilteredBlocks;
+}
+
+//=============================================================================================================
+
+void FiffRawViewModel::postFilter(const QList<QSharedPointer<DataBlock> >& lFilteredBlocks)
+{
+    if(m_iFilterRunGeneration == m_iFilterGeneration && !lFilteredBlocks.isEmpty()) {
+        // The window might have been scrolled meanwhile, match the blocks by their first sample
+        m_dataMutex.lock();
+
+        std::list<QSharedPointer<DataBlock> >::const_iterator itRaw = m_lData.begin();
+        for(QSharedPointer<DataBlock>& pFiltered : m_lFilteredData) {
+            if(!pFiltered) {
+                for(const QSharedPointer<DataBlock>& pBlock : lFilteredBlocks) {
+                    if(pBlock->iFirstSample == (*itRaw)->iFirstSample) {
+                        pFiltered = pBlock;
+                        break;
+                    }
+                }
+            }
+            ++itRaw;
+        }
+
+        m_dataMutex.unlock();
+
+        emit dataChanged(createIndex(0,0), createIndex(rowCount(), columnCount()));
+    }
+
+    // Filter the blocks which became visible or dirty during the run
+    if(m_bFilterPending || m_iFilterRunGeneration != m_iFilterGeneration) {
+        m_bFilterPending = false;
+        filterVisibleBlocks();
+    }
+}
+
+//=============================================================================================================
+
+std::list<QSharedPointer<DataBlock> > FiffRawViewModel::readBlocks(qint32 iFirstSample,
+                                                                   qint32 iNumBlocks)
+{
+    std::vector<QSharedPointer<DataBlock> > vecBlocks(std::max(0, iNumBlocks));
+
+    for(int i = 0; i < iNumBlocks; ++i) {
+        vecBlocks[i] = takeCachedBlock(iFirstSample + i * m_iSamplesPerBlock);
+    }
+
+    MatrixXd matData, matTimes;
+    int i = 0;
+
+    while(i < iNumBlocks) {
+        if(vecBlocks.at(i)) {
+            ++i;
+            continue;
+        }
+
+        // Read consecutive missing blocks at once
+        int j = i;
+        while(j < iNumBlocks && !vecBlocks.at(j)) {
+            ++j;
+        }
+
+        int start = iFirstSample + i * m_iSamplesPerBlock;
+        // for some reason the read_raw_segment function works with inclusive upper bound
+        int end = iFirstSample + j * m_iSamplesPerBlock - 1;
+
+        m_fileMutex.lock();
+        bool bRead = m_pFiffIO->m_qlistRaw[0]->read_raw_segment(matData, matTimes, start, end);
+        m_fileMutex.unlock();
+
+        if(!bRead) {
+            qWarning() << "[FiffRawViewModel::readBlocks] Could not read samples " << start << " to " << end;
+            return std::list<QSharedPointer<DataBlock> >();
+        }
+
+        // The read is cut at the end of the file, pad the last block with zeros
+        int iNumSamples = matData.cols();
+        if(iNumSamples < end - start + 1) {
+            matData.conservativeResize(Eigen::NoChange, end - start + 1);
+            matData.rightCols(end - start + 1 - iNumSamples).setZero();
         }
 
-        if(!bFilterSuccess) {
-            m_lFilteredData = m_lData;
-            return;
+        for(int k = i; k < j; ++k) {
+            vecBlocks[k] = QSharedPointer<DataBlock>::create(matData.middleCols((k - i) * m_iSamplesPerBlock, m_iSamplesPerBlock),
+                                                             iFirstSample + k * m_iSamplesPerBlock);
         }
 
-        for(int i = 0; i < m_iTotalBlockCount; ++i) {
-            m_lFilteredData.push_back(QSharedPointer<QPair<MatrixXd, MatrixXd> >::create(qMakePair(matData.block(0, (i*m_iSamplesPerBlock)+(2*iFilterDelay), matData.rows(), m_iSamplesPerBlock),
-                                                                                                   matTimes.block(0, (i*m_iSamplesPerBlock)+(2*iFilterDelay), matTimes.rows(), m_iSamplesPerBlock))));
+        i = j;
+    }
+
+    return std::list<QSharedPointer<DataBlock> >(vecBlocks.begin(), vecBlocks.end());
+}
+
+//=============================================================================================================
+
+QSharedPointer<DataBlock> FiffRawViewModel::takeCachedBlock(qint32 iFirstSample)
+{
+    QMutexLocker locker(&m_cacheMutex);
+
+    QSharedPointer<DataBlock> pBlock = m_hashBlockCache.take(iFirstSample);
+
+    if(pBlock) {
+        m_lCacheOrder.remove(iFirstSample);
+        m_iCacheBytes -= pBlock->byteSize();
+    }
+
+    return pBlock;
+}
+
+//=============================================================================================================
+
+void FiffRawViewModel::cacheBlock(const QSharedPointer<DataBlock>& pBlock)
+{
+    if(!pBlock) {
+        return;
+    }
+
+    QMutexLocker locker(&m_cacheMutex);
+
+    QSharedPointer<DataBlock> pOldBlock = m_hashBlockCache.take(pBlock->iFirstSample);
+    if(pOldBlock) {
+        m_lCacheOrder.remove(pBlock->iFirstSample);
+        m_iCacheBytes -= pOldBlock->byteSize();
+    }
+
+    m_hashBlockCache.insert(pBlock->iFirstSample, pBlock);
+    m_lCacheOrder.push_back(pBlock->iFirstSample);
+    m_iCacheBytes += pBlock->byteSize();
+
+    // Evict least recently used blocks
+    while(m_iCacheBytes > m_iMaxCacheBytes && !m_lCacheOrder.empty()) {
+        QSharedPointer<DataBlock> pEvicted = m_hashBlockCache.take(m_lCacheOrder.front());
+        m_lCacheOrder.pop_front();
+
+        if(pEvicted) {
+            m_iCacheBytes -= pEvicted->byteSize();
         }
+    }
+}
+
+//=============================================================================================================
+
+void FiffRawViewModel::clearBlockCache()
+{
+    m_prefetchFuture.waitForFinished();
+
+    QMutexLocker locker(&m_cacheMutex);
+
+    m_hashBlockCache.clear();
+    m_lCacheOrder.clear();
+    m_iCacheBytes = 0;
+}
+
+//=============================================================================================================
+
+void FiffRawViewModel::startPrefetch(bool bLater)
+{
+    // In WASM mode do not use multithreading for prefetching
+    #ifdef WASMBUILD
+    Q_UNUSED(bLater);
+    #else
+    if(m_prefetchFuture.isRunning() || !m_pFiffIO || m_pFiffIO->m_qlistRaw.empty()) {
+        return;
+    }
+
+    qint32 iNumBlocks = m_iPreloadBufferSize;
+    qint32 iFirstSample;
+
+    if(bLater) {
+        iFirstSample = m_iFiffCursorBegin + m_iTotalBlockCount * m_iSamplesPerBlock;
+        iNumBlocks = std::min(iNumBlocks, (absoluteLastSample() - iFirstSample + 1) / m_iSamplesPerBlock);
     } else {
-        m_lFilteredData = m_lData;
+        iNumBlocks = std::min(iNumBlocks, (m_iFiffCursorBegin - absoluteFirstSample()) / m_iSamplesPerBlock);
+        iFirstSample = m_iFiffCursorBegin - iNumBlocks * m_iSamplesPerBlock;
     }
 
-    emit dataChanged(createIndex(0,0), createIndex(rowCount(), columnCount()));
+    if(iNumBlocks <= 0) {
+        return;
+    }
+
+    m_prefetchFuture = QtConcurrent::run(this, &FiffRawViewModel::prefetchBlocks, iFirstSample, iNumBlocks);
+    #endif
+}
+
+//=============================================================================================================
+
+void FiffRawViewModel::prefetchBlocks(qint32 iFirstSample,
+                                      qint32 iNumBlocks)
+{
+    for(const QSharedPointer<DataBlock>& pBlock : readBlocks(iFirstSample, iNumBlocks)) {
+        cacheBlock(pBlock);
+    }
 }
 
 //=============================================================================================================
@@ -51,13 +51,18 @@
 
 #include <rtprocessing/helpers/filterkernel.h>
 
+#include <disp/viewers/helpers/envelopepyramid.h>
+
 //=============================================================================================================
 // QT INCLUDES
 //=============================================================================================================
 
 #include <QSharedPointer>
 #include <QFutureWatcher>
+#include <QFuture>
 #include <QMutex>
+#include <QHash>
+#include <QVector>
 #include <QBuffer>
 #include <QFile>
 #include <QColor>
@@ -92,6 +97,43 @@ namespace ANSHAREDLIB {
 
 class EventModel;
 
+//=============================================================================================================
+/**
+ * A block of raw data as it is held by the FiffRawViewModel. Samples are stored in single precision, which is
+ * plenty for display purposes. The time of sample i is (iFirstSample + i) / sfreq and is not stored. The min/max
+ * envelopes are computed once when the block is loaded, so that zoomed out views can be plotted with two points
+ * per pixel column.
+ */
+struct DataBlock
+{
+    DataBlock(const MatrixXd& matBlockData,
+              qint32 iBlockFirstSample)
+    : matData(matBlockData.cast<float>())
+    , iFirstSample(iBlockFirstSample)
+    {
+        envelope.build(matData);
+    }
+
+    //=========================================================================================================
+    /**
+     * @return The memory held by this block in bytes.
+     */
+    qint64 byteSize() const
+    {
+        qint64 iBytes = matData.size() * sizeof(float);
+
+        for(int i = 0; i < envelope.numLevels(); ++i) {
+            iBytes += 2 * envelope.minimum(i).size() * sizeof(float);
+        }
+
+        return iBytes;
+    }
+
+    Eigen::MatrixXf             matData;        /**< The data (channels x samples). */
+    qint32                      iFirstSample;   /**< The absolute fiff sample of the first column. */
+    DISPLIB::EnvelopePyramid    envelope;       /**< The min/max envelopes of the data. */
+};
+
 //=============================================================================================================
 /**
  *
@@ -546,15 +588,119 @@ private:
      * Calculates the filtered version of one single datablock
      *
      * @param[in]   matData         The data block to be filtered.
+     * @param[in]   filterKernel    The filter kernel to apply.
+     * @param[in]   vecChannels     The indices of the channels to filter.
      * @param[in]   bFilterEnd      Whether to perform the overlap add in the beginning or end of the data.
      * @param[in]   bKeepOverhead   Whether to keep the overhead.
      *
      * @return Returns true if filtering was performed, otherwise returns false.
      */
     bool filterDataBlock(MatrixXd& matData,
+                         const RTPROCESSINGLIB::FilterKernel& filterKernel,
+                         const Eigen::RowVectorXi& vecChannels,
                          bool bFilterEnd,
                          bool bKeepOverhead = false);
 
+    //=========================================================================================================
+    /**
+     * Marks all filtered blocks as dirty and refilters the visible ones. This is called whenever the filter
+     * settings change. The raw data is not reloaded.
+     */
+    void invalidateFilteredData();
+
+    //=========================================================================================================
+    /**
+     * Starts filtering all dirty blocks which are part of the visible window on the global thread pool. Blocks
+     * in the preload buffers stay dirty until they are scrolled into view. The filter context is taken from the
+     * neighbouring raw blocks. Dirty blocks are displayed raw until postFilter stored their filtered version. If
+     * a filter run is still going on, the visible window is checked again once it finished.
+     */
+    void filterVisibleBlocks();
+
+    //=========================================================================================================
+    /**
+     * Filters a consecutive range of raw blocks and returns the filtered version of the dirty ones. This is run on
+     * the global thread pool.
+     *
+     * @param[in] vecBlocks      The raw blocks, including the context blocks around the dirty ones.
+     * @param[in] iFirstDirty    The index of the first dirty block in vecBlocks.
+     * @param[in] iLastDirty     The index of the last dirty block in vecBlocks.
+     * @param[in] filterKernel   The filter kernel at the time the run was started.
+     * @param[in] vecChannels    The channels to filter at the time the run was started.
+     *
+     * @return The filtered blocks iFirstDirty to iLastDirty. Raw blocks if filtering was not possible.
+     */
+    QList<QSharedPointer<DataBlock> > filterBlocks(const QVector<QSharedPointer<DataBlock> >& vecBlocks,
+                                                   int iFirstDirty,
+                                                   int iLastDirty,
+                                                   const RTPROCESSINGLIB::FilterKernel& filterKernel,
+                                                   const Eigen::RowVectorXi& vecChannels);
+
+    //=========================================================================================================
+    /**
+     * Stores the blocks of a finished filter run in the filtered data, unless the filter settings changed in the
+     * meantime. This is run by the filter FutureWatcher when it is finished.
+     *
+     * @param[in] lFilteredBlocks    The filtered blocks.
+     */
+    void postFilter(const QList<QSharedPointer<DataBlock> >& lFilteredBlocks);
+
+    //=========================================================================================================
+    /**
+     * Reads a segment of raw data from the file. Blocks which are present in the block cache are not read again.
+     *
+     * @param[in] iFirstSample   The first sample of the first block to read.
+     * @param[in] iNumBlocks     The number of blocks to read.
+     *
+     * @return The blocks in ascending order. Empty if the file could not be read.
+     */
+    std::list<QSharedPointer<DataBlock> > readBlocks(qint32 iFirstSample,
+                                                     qint32 iNumBlocks);
+
+    //=========================================================================================================
+    /**
+     * Looks up a block in the block cache.
+     *
+     * @param[in] iFirstSample   The first sample of the block.
+     *
+     * @return The cached block or a null pointer.
+     */
+    QSharedPointer<DataBlock> takeCachedBlock(qint32 iFirstSample);
+
+    //=========================================================================================================
+    /**
+     * Puts a block into the block cache and evicts the least recently used blocks if the cache exceeds
+     * m_iMaxCacheBytes.
+     *
+     * @param[in] pBlock     The block to cache.
+     */
+    void cacheBlock(const QSharedPointer<DataBlock>& pBlock);
+
+    //=========================================================================================================
+    /**
+     * Clears the block cache. Waits for pending prefetches.
+     */
+    void clearBlockCache();
+
+    //=========================================================================================================
+    /**
+     * Starts reading the given number of blocks in front of (bLater = false) or after (bLater = true) the
+     * currently held blocks on the global thread pool. The blocks end up in the block cache.
+     *
+     * @param[in] bLater     Whether to prefetch in scroll direction to the end of the file.
+     */
+    void startPrefetch(bool bLater);
+
+    //=========================================================================================================
+    /**
+     * Reads the given blocks into the block cache. This is run on the global thread pool.
+     *
+     * @param[in] iFirstSample   The first sample of the first block to read.
+     * @param[in] iNumBlocks     The number of blocks to read.
+     */
+    void prefetchBlocks(qint32 iFirstSample,
+                        qint32 iNumBlocks);
+
     //=========================================================================================================
     /**
      * This is a helper method thats is meant to correctly set the endOfFile / startOfFile flags whenever needed
@@ -608,10 +754,24 @@ private:
      */
     void readFromRealtimeFile(const QString &path);
 
-    std::list<QSharedPointer<QPair<MatrixXd, MatrixXd> > > m_lData;             /**< Data. */
-    std::list<QSharedPointer<QPair<MatrixXd, MatrixXd> > > m_lNewData;          /**< Data that is to be appended or prepended. */
-    std::list<QSharedPointer<QPair<MatrixXd, MatrixXd> > > m_lFilteredData;     /**< Filtered data. */
-    std::list<QSharedPointer<QPair<MatrixXd, MatrixXd> > > m_lFilteredNewData;  /**< Filtered data that is to be appended or prepended. */
+    std::list<QSharedPointer<DataBlock> > m_lData;             /**< Data. */
+    std::list<QSharedPointer<DataBlock> > m_lNewData;          /**< Data that is to be appended or prepended. */
+    std::list<QSharedPointer<DataBlock> > m_lFilteredData;     /**< Filtered data, parallel to m_lData. Null entries are dirty and not filtered yet. */
+
+    // background filtering
+    QFutureWatcher<QList<QSharedPointer<DataBlock> > >  m_filterFutureWatcher;  /**< Watches the currently running filter run. */
+    int                                                 m_iFilterGeneration;    /**< Incremented whenever the filter settings or the file change. */
+    int                                                 m_iFilterRunGeneration; /**< The filter generation the current filter run was started with. */
+    bool                                                m_bFilterPending;       /**< Whether the visible window changed while a filter run was going on. */
+
+    // block cache
+    QHash<qint32, QSharedPointer<DataBlock> >   m_hashBlockCache;   /**< Recently dropped and prefetched raw blocks, keyed by their first sample. */
+    std::list<qint32>                           m_lCacheOrder;      /**< First samples of the cached blocks, least recently used first. */
+    qint64                                      m_iCacheBytes;      /**< Memory currently held by the block cache. */
+    qint64                                      m_iMaxCacheBytes;   /**< Memory bound of the block cache. */
+    QFuture<void>                               m_prefetchFuture;   /**< The currently running prefetch. */
+    QMutex                                      m_cacheMutex;       /**< Guards the block cache. */
+    QMutex                                      m_fileMutex;        /**< Serializes reads from the fiff file. */
 
     // Display stuff
     double      m_dDx;              /**< pixel difference to the next sample. */
@@ -802,7 +962,7 @@ public:
         qint32 currentIndex;
 
         // Remember which block we are currently in
-        std::list<QSharedPointer<QPair<MatrixXd, MatrixXd> > >::const_iterator currentBlockToAccess;
+        std::list<QSharedPointer<DataBlock> >::const_iterator currentBlockToAccess;
         qint32 currentRelativeIndex; /**< Remember the relative sample in the current block. */
 
     public:
@@ -817,8 +977,8 @@ public:
             qint32 temp = currentIndex;
 
             // comparing temp against 0 to avoid index-out-of bound scenario for ChannelData::end()
-            while (temp > 0 && temp >= (*currentBlockToAccess)->first.cols()) {
-                temp -= (*currentBlockToAccess)->first.cols();
+            while (temp > 0 && temp >= (*currentBlockToAccess)->matData.cols()) {
+                temp -= (*currentBlockToAccess)->matData.cols();
                 currentBlockToAccess++;
             }
 
@@ -834,8 +994,8 @@ public:
         {
             currentIndex++;
             currentRelativeIndex++;
-            if (currentRelativeIndex >= (*currentBlockToAccess)->first.cols()) {
-                currentRelativeIndex -= (*currentBlockToAccess)->first.cols();
+            if (currentRelativeIndex >= (*currentBlockToAccess)->matData.cols()) {
+                currentRelativeIndex -= (*currentBlockToAccess)->matData.cols();
                 currentBlockToAccess++;
             }
 
@@ -846,8 +1006,8 @@ public:
         {
             currentIndex++;
             currentRelativeIndex++;
-            if (currentRelativeIndex >= (*currentBlockToAccess)->first.cols()) {
-                currentRelativeIndex -= (*currentBlockToAccess)->first.cols();
+            if (currentRelativeIndex >= (*currentBlockToAccess)->matData.cols()) {
+                currentRelativeIndex -= (*currentBlockToAccess)->matData.cols();
                 currentBlockToAccess++;
             }
 
@@ -861,10 +1021,10 @@ public:
 
         double operator * ()
         {
-            const double* pointerToMatrix = (*currentBlockToAccess)->first.data();
+            const float* pointerToMatrix = (*currentBlockToAccess)->matData.data();
 
             // go to row
-            pointerToMatrix += cd->m_iRowNumber * (*currentBlockToAccess)->first.cols();
+            pointerToMatrix += cd->m_iRowNumber * (*currentBlockToAccess)->matData.cols();
 
             // go to sample
             pointerToMatrix += currentRelativeIndex;
@@ -873,7 +1033,7 @@ public:
         }
     };
 
-    ChannelData(std::list<QSharedPointer<QPair<MatrixXd, MatrixXd>>>::const_iterator it,
+    ChannelData(std::list<QSharedPointer<DataBlock>>::const_iterator it,
                 qint32 numBlocks,
                 quint32 rowNumber)
     : m_lData()
@@ -886,11 +1046,11 @@ public:
         }
 
         for (const auto &a : m_lData) {
-            m_iNumSamples += a->first.cols();
+            m_iNumSamples += a->matData.cols();
         }
     }
 
-    ChannelData(const std::list<QSharedPointer<QPair<MatrixXd, MatrixXd>>> data,
+    ChannelData(const std::list<QSharedPointer<DataBlock>> data,
                 unsigned long rowNumber)
     : ChannelData(data.begin(), static_cast<qint32>(data.size()), rowNumber)
     {
@@ -920,18 +1080,18 @@ public:
     double operator [] (unsigned long i)
     {
         // see which block we have to access
-        std::list<QSharedPointer<QPair<MatrixXd, MatrixXd>>>::const_iterator blockToAccess = m_lData.begin();
-        while (i >= (unsigned long)(*blockToAccess)->first.cols())
+        std::list<QSharedPointer<DataBlock>>::const_iterator blockToAccess = m_lData.begin();
+        while (i >= (unsigned long)(*blockToAccess)->matData.cols())
         {
-            i -= (*blockToAccess)->first.cols();
+            i -= (*blockToAccess)->matData.cols();
             blockToAccess++;
         }
 
         // set the pointer to the start of matrix
-        const double* pointerToMatrix = (*blockToAccess)->first.data();
+        const float* pointerToMatrix = (*blockToAccess)->matData.data();
 
         // go to row
-        pointerToMatrix += i * (*blockToAccess)->first.rows();
+        pointerToMatrix += i * (*blockToAccess)->matData.rows();
 
         // go to sample
         pointerToMatrix += m_iRowNumber;
@@ -949,6 +1109,11 @@ public:
         return m_iRowNumber;
     }
 
+    const std::list<QSharedPointer<DataBlock> >& getBlocks() const
+    {
+        return m_lData;
+    }
+
     ChannelIterator begin() const
     {
         ChannelIterator begin(this, 0);
@@ -964,7 +1129,7 @@ public:
 private:
     // hold a list of smartpointers to the data that was in the model when the respective instance of ChannelData was created.
     // This prevents that pointers into the Eigen-matrices will become invalid when the background thread returns and changes the matrices.
-    std::list<QSharedPointer<QPair<MatrixXd, MatrixXd> > > m_lData;
+    std::list<QSharedPointer<DataBlock> > m_lData;
     quint32 m_iRowNumber;
     qint64 m_iNumSamples;
 };
@@ -634,15 +634,29 @@ FiffCoordTrans CoRegistration::computeICP(FiffCoordTrans transInit,
         vecWeightsICPClean(i) = vecWeightsICP(vecTake(i));
     }
 
-    // icp
-    RTPROCESSINGLIB::performIcp(mneSurfacePoints,
-                                matHspClean,
-                                transInit,
-                                fRMSE,
-                                bScale,
-                                iMaxIter,
-                                fTol,
-                                vecWeightsICPClean);
+    // icp, the point-to-plane variant converges faster but only fits rigid transformations
+    if(bScale) {
+        RTPROCESSINGLIB::performIcp(mneSurfacePoints,
+                                    matHspClean,
+                                    transInit,
+                                    fRMSE,
+                                    bScale,
+                                    iMaxIter,
+                                    fTol,
+                                    vecWeightsICPClean);
+    } else {
+        // Points beyond the omit distance are gone already, trimming only drops the worst fits of each iteration
+        const float fInlierRatio = 0.9f;
+
+        RTPROCESSINGLIB::performIcpPointToPlane(mneSurfacePoints,
+                                                matHspClean,
+                                                transInit,
+                                                fRMSE,
+                                                iMaxIter,
+                                                fTol,
+                                                fInlierRatio,
+                                                vecWeightsICPClean);
+    }
 
     FiffCoordTrans transHeadMri = transInit;
 
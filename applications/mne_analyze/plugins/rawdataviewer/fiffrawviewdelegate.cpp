@@ -49,6 +49,8 @@
 
 #include <rtprocessing/helpers/filterkernel.h>
 
+#include <algorithm>
+
 //=============================================================================================================
 // QT INCLUDES
 //=============================================================================================================
@@ -244,6 +246,23 @@ void FiffRawViewDelegate::createPlotPath(const QStyleOptionViewItem &option,
 
     QPointF qSamplePosition;
 
+    // If more than one sample falls into a pixel column plot the min/max envelopes of the blocks instead
+    const std::list<QSharedPointer<DataBlock> >& lBlocks = data.getBlocks();
+
+    if(!lBlocks.empty()) {
+        int iLevel = lBlocks.front()->envelope.selectLevel(dDx);
+
+        if(iLevel >= 0) {
+            createEnvelopePath(path,
+                               lBlocks,
+                               iLevel,
+                               data.getRowNumber(),
+                               dDx,
+                               dScaleY);
+            return;
+        }
+    }
+
     int iPaintStep = 1;
 
     for(unsigned int j = 0; j < data.size(); j = j + iPaintStep) {
@@ -266,6 +285,59 @@ void FiffRawViewDelegate::createPlotPath(const QStyleOptionViewItem &option,
 
 //=============================================================================================================
 
+void FiffRawViewDelegate::createEnvelopePath(QPainterPath& path,
+                                             const std::list<QSharedPointer<DataBlock> >& lBlocks,
+                                             int iLevel,
+                                             int iRow,
+                                             double dDx,
+                                             double dScaleY) const
+{
+    double y_base = path.currentPosition().y();
+    double dStartX = path.currentPosition().x();
+
+    int iColumn = -1;
+    int iBlockFirstSample = 0;
+    float fMin(0), fMax(0);
+
+    for(const QSharedPointer<DataBlock>& pBlock : lBlocks) {
+        const DISPLIB::EnvelopePyramid& envelope = pBlock->envelope;
+
+        if(iLevel < envelope.numLevels()) {
+            const Eigen::MatrixXf& matMin = envelope.minimum(iLevel);
+            const Eigen::MatrixXf& matMax = envelope.maximum(iLevel);
+            int iBinSize = envelope.binSize(iLevel);
+
+            for(int j = 0; j < matMin.cols(); ++j) {
+                int iBinColumn = static_cast<int>((iBlockFirstSample + j * iBinSize) * dDx);
+
+                if(iBinColumn != iColumn) {
+                    // Two points per pixel column, reverse direction -> plot the right way
+                    if(iColumn >= 0) {
+                        path.lineTo(dStartX + iColumn, y_base - fMax * dScaleY);
+                        path.lineTo(dStartX + iColumn, y_base - fMin * dScaleY);
+                    }
+
+                    iColumn = iBinColumn;
+                    fMin = matMin(iRow, j);
+                    fMax = matMax(iRow, j);
+                } else {
+                    fMin = std::min(fMin, matMin(iRow, j));
+                    fMax = std::max(fMax, matMax(iRow, j));
+                }
+            }
+        }
+
+        iBlockFirstSample += pBlock->matData.cols();
+    }
+
+    if(iColumn >= 0) {
+        path.lineTo(dStartX + iColumn, y_base - fMax * dScaleY);
+        path.lineTo(dStartX + iColumn, y_base - fMin * dScaleY);
+    }
+}
+
+//=============================================================================================================
+
 void FiffRawViewDelegate::setSignalColor(const QColor& signalColor)
 {
     m_penNormal.setColor(signalColor);
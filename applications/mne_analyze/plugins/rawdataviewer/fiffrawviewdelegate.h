@@ -44,12 +44,15 @@
 
 #include "rawdataviewer_global.h"
 
+#include <list>
+
 //=============================================================================================================
 // QT INCLUDES
 //=============================================================================================================
 
 #include <QAbstractItemDelegate>
 #include <QPen>
+#include <QSharedPointer>
 
 //=============================================================================================================
 // Eigen INCLUDES
@@ -61,6 +64,7 @@
 
 namespace ANSHAREDLIB {
     class ChannelData;
+    struct DataBlock;
 }
 
 //=============================================================================================================
@@ -154,6 +158,25 @@ private:
                         double dDx,
                         const QModelIndex &index) const;
 
+    //=========================================================================================================
+    /**
+     * createEnvelopePath creates the QPointer path for the data plot from the min/max envelopes of the loaded blocks.
+     * Each pixel column is plotted with two points only, independent of the number of samples it covers.
+     *
+     * @param[in, out] path   The QPointerPath to create for the data plot.
+     * @param[in] lBlocks    The data blocks of the given row.
+     * @param[in] iLevel     The envelope level to plot.
+     * @param[in] iRow       The row (channel) to plot.
+     * @param[in] dDx        pixel difference to the next sample in pixels.
+     * @param[in] dScaleY    The y scaling factor to apply.
+     */
+    void createEnvelopePath(QPainterPath& path,
+                            const std::list<QSharedPointer<ANSHAREDLIB::DataBlock> >& lBlocks,
+                            int iLevel,
+                            int iRow,
+                            double dDx,
+                            double dScaleY) const;
+
     //=========================================================================================================
     /**
      * createTimeSpacersPath Creates the QPointer path for the vertical time spacers.
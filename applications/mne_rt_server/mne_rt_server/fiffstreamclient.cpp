@@ -1,6 +1,6 @@
 //=============================================================================================================
 /**
- * @file     fiffstreamthread.cpp
+ * @file     fiffstreamclient.cpp
  * @author   Christoph Dinh <chdinh@nmr.mgh.harvard.edu>;
  *           Felix Arndt <Felix.Arndt@tu-ilmenau.de>;
  *           Limin Sun <limin.sun@childrens.harvard.edu>;
@@ -33,7 +33,7 @@
  * POSSIBILITY OF SUCH DAMAGE.
  *
  *
- * @brief     Definition of the FiffStreamThread Class.
+ * @brief     Definition of the FiffStreamClient Class.
  *
  */
 
@@ -41,8 +41,7 @@
 // INCLUDES
 //=============================================================================================================
 
-#include "fiffstreamthread.h"
-#include "fiffstreamserver.h"
+#include "fiffstreamclient.h"
 #include "mne_rt_commands.h"
 
 //=============================================================================================================
@@ -71,66 +70,102 @@ using namespace FIFFLIB;
 // DEFINE MEMBER METHODS
 //=============================================================================================================
 
-FiffStreamThread::FiffStreamThread(qint32 id, int socketDescriptor, QObject *parent)
-: QThread(parent)
+FiffStreamClient::FiffStreamClient(qint32 id,
+                                   qintptr socketDescriptor)
+: QObject()
 , m_iDataClientId(id)
 , m_sDataClientAlias(QString(""))
 , m_iSocketDescriptor(socketDescriptor)
+, m_pTcpSocket(Q_NULLPTR)
+, m_iQueuedBytes(0)
 , m_bIsSendingRawBuffer(false)
-, m_bIsRunning(false)
+, m_bIsClosed(false)
+, m_iDataEncoding(FIFFV_MNE_RT_ENCODING_FLOAT)
 {
 }
 
 //=============================================================================================================
 
-FiffStreamThread::~FiffStreamThread()
+FiffStreamClient::~FiffStreamClient()
 {
-    //Remove from client list
-    FiffStreamServer* t_pFiffStreamServer = qobject_cast<FiffStreamServer*>(this->parent());
-    if(t_pFiffStreamServer)
-        t_pFiffStreamServer->m_qClientList.remove(m_iDataClientId);
+}
+
+//=============================================================================================================
+
+void FiffStreamClient::init()
+{
+    m_pTcpSocket = new QTcpSocket(this);
+
+    if (!m_pTcpSocket->setSocketDescriptor(m_iSocketDescriptor)) {
+        emit error(m_pTcpSocket->error());
+        close();
+        return;
+    }
+    else
+    {
+        printf("FiffStreamClient (assigned ID %d) accepted from\n\tIP:\t%s\n\tPort:\t%d\n\n",
+               m_iDataClientId,
+               QHostAddress(m_pTcpSocket->peerAddress()).toString().toUtf8().constData(),
+               m_pTcpSocket->peerPort());
+    }
+
+    connect(m_pTcpSocket, &QTcpSocket::readyRead,
+            this, &FiffStreamClient::readCommands);
+    connect(m_pTcpSocket, &QTcpSocket::bytesWritten,
+            this, &FiffStreamClient::writeQueue);
+    connect(m_pTcpSocket, &QTcpSocket::disconnected,
+            this, &FiffStreamClient::close);
 
-    m_bIsRunning = false;
-    QThread::wait();
+    // Commands might have arrived before the notifiers were set up
+    readCommands();
 }
 
 //=============================================================================================================
 
-void FiffStreamThread::startMeas(qint32 ID)
+QString FiffStreamClient::getAlias()
+{
+    return m_sDataClientAlias;
+}
+
+//=============================================================================================================
+
+void FiffStreamClient::startMeas(qint32 ID)
 {
     if(ID == m_iDataClientId)
     {
         qDebug() << "Activate raw buffer sending.";
 
-        m_qMutex.lock();
         // ToDo send start meas
-        FiffStream t_FiffStreamOut(&m_qSendBlock, QIODevice::WriteOnly);
+        QByteArray t_blockOut;
+        FiffStream t_FiffStreamOut(&t_blockOut, QIODevice::WriteOnly);
         t_FiffStreamOut.start_block(FIFFB_RAW_DATA);
+        enqueue(t_blockOut);
+
         m_bIsSendingRawBuffer = true;
-        m_qMutex.unlock();
     }
 }
 
 //=============================================================================================================
 
-void FiffStreamThread::stopMeas(qint32 ID)
+void FiffStreamClient::stopMeas(qint32 ID)
 {
-    qDebug() << "void FiffStreamThread::stopMeas(qint32 ID)";
+    qDebug() << "void FiffStreamClient::stopMeas(qint32 ID)";
     if(ID == m_iDataClientId || ID == -1)
     {
         qDebug() << "stop raw buffer sending.";
 
-        m_qMutex.lock();
-        FiffStream t_FiffStreamOut(&m_qSendBlock, QIODevice::WriteOnly);
+        QByteArray t_blockOut;
+        FiffStream t_FiffStreamOut(&t_blockOut, QIODevice::WriteOnly);
         t_FiffStreamOut.end_block(FIFFB_RAW_DATA);
+        enqueue(t_blockOut);
+
         m_bIsSendingRawBuffer = false;
-        m_qMutex.unlock();
     }
 }
 
 //=============================================================================================================
 
-void FiffStreamThread::parseCommand(FiffTag::SPtr p_pTag)
+void FiffStreamClient::parseCommand(FiffTag::SPtr p_pTag)
 {
     if(p_pTag->size() >= 4)
     {
@@ -145,6 +180,7 @@ void FiffStreamThread::parseCommand(FiffTag::SPtr p_pTag)
             //
             m_sDataClientAlias = QString(p_pTag->mid(4, p_pTag->size()-4));
             printf("FiffStreamClient (ID %d): new alias = '%s'\r\n\n", m_iDataClientId, m_sDataClientAlias.toUtf8().constData());
+            emit aliasChanged(m_iDataClientId, m_sDataClientAlias);
         }
         else if(t_iCmd == MNE_RT_GET_CLIENT_ID)
         {
@@ -154,6 +190,25 @@ void FiffStreamThread::parseCommand(FiffTag::SPtr p_pTag)
             printf("FiffStreamClient (ID %d): send client ID %d\r\n\n", m_iDataClientId, m_iDataClientId);
             writeClientId();
         }
+        else if(t_iCmd == MNE_RT_SET_DATA_ENCODING)
+        {
+            //
+            // Set Data Encoding. The server switches the encoding via setDataEncoding once it serializes the
+            // requested frames, the confirmation is sent from there.
+            //
+            bool t_bIsInt = false;
+            qint32 t_iEncoding = QString(p_pTag->mid(4, p_pTag->size()-4)).toInt(&t_bIsInt);
+
+            if(t_bIsInt && (t_iEncoding == FIFFV_MNE_RT_ENCODING_FLOAT || t_iEncoding == FIFFV_MNE_RT_ENCODING_COMPRESSED))
+            {
+                emit dataEncodingRequested(m_iDataClientId, t_iEncoding);
+            }
+            else
+            {
+                printf("FiffStreamClient (ID %d): unknown data encoding, keep %d\r\n\n", m_iDataClientId, m_iDataEncoding);
+                writeDataEncoding();
+            }
+        }
         else
         {
             printf("FiffStreamClient (ID %d): unknown command\r\n\n", m_iDataClientId);
@@ -167,205 +222,178 @@ void FiffStreamThread::parseCommand(FiffTag::SPtr p_pTag)
 
 //=============================================================================================================
 
-void FiffStreamThread::sendRawBuffer(QSharedPointer<Eigen::MatrixXf> m_pMatRawData)
+void FiffStreamClient::setDataEncoding(qint32 encoding)
 {
-    if(m_bIsSendingRawBuffer)
-    {
-//        qDebug() << "Send RawBuffer to client";
+    m_iDataEncoding = encoding;
+    printf("FiffStreamClient (ID %d): new data encoding = %d\r\n\n", m_iDataClientId, m_iDataEncoding);
 
-        m_qMutex.lock();
+    writeDataEncoding();
+}
 
-        FiffStream t_FiffStreamOut(&m_qSendBlock, QIODevice::WriteOnly);
-        t_FiffStreamOut.write_float(FIFF_DATA_BUFFER,m_pMatRawData->data(),m_pMatRawData->rows()*m_pMatRawData->cols());
+//=============================================================================================================
+
+void FiffStreamClient::sendRawBuffer(QByteArray p_blockFrame,
+                                     QByteArray p_blockCompressedFrame)
+{
+    if(m_bIsSendingRawBuffer)
+    {
+        const QByteArray& t_blockFrame = m_iDataEncoding == FIFFV_MNE_RT_ENCODING_COMPRESSED
+                                         ? p_blockCompressedFrame
+                                         : p_blockFrame;
 
-        m_qMutex.unlock();
+        if(t_blockFrame.isEmpty()) {
+            printf("FiffStreamClient (ID %d): no frame in encoding %d, buffer is not sent\r\n\n", m_iDataClientId, m_iDataEncoding);
+            return;
+        }
 
+        enqueue(t_blockFrame);
     }
-//    else
-//    {
-//        qDebug() << "Send RawBuffer is not activated";
-//    }
 }
 
 //=============================================================================================================
 
-//void FiffStreamThread::sendData(QTcpSocket& p_qTcpSocket)
-//{
-//    if(p_qTcpSocket.state() != QAbstractSocket::UnconnectedState && m_bIsRunning)
-//    {
-//        m_qMutex.lock();
-//        qint32 t_iBlockSize = m_qSendBlock.size();
-//        if(t_iBlockSize > 0)
-//        {
-////            qDebug() << "data available" << t_iBlockSize;
-//            qint32 t_iBytesWritten = p_qTcpSocket.write(m_qSendBlock);
-//            qDebug()<<"[Block to write]"<<t_iBlockSize<<"[bytes has been Written]"<<t_iBytesWritten;
-//            p_qTcpSocket.waitForBytesWritten();
-//        }
-//        m_qMutex.unlock();
-//    }
-//}
-
-//=============================================================================================================
-
-void FiffStreamThread::sendMeasurementInfo(qint32 ID, const FiffInfo& p_fiffInfo)
+void FiffStreamClient::sendMeasurementInfo(qint32 ID, const FiffInfo& p_fiffInfo)
 {
     if(ID == m_iDataClientId)
     {
-        m_qMutex.lock();
-
-        FiffStream t_FiffStreamOut(&m_qSendBlock, QIODevice::WriteOnly);
-
-//        qint32 init_info[2];
-//        init_info[0] = FIFF_MNE_RT_CLIENT_ID;
-//        init_info[1] = m_iDataClientId;
-
-//        t_FiffStreamOut.start_block(FIFFB_MNE_RT_MEAS_INFO);
-
-//FiffStream::start_writing_raw
+        QByteArray t_blockOut;
+        FiffStream t_FiffStreamOut(&t_blockOut, QIODevice::WriteOnly);
 
         p_fiffInfo.writeToStream(&t_FiffStreamOut);
-        m_qMutex.unlock();
 
-//        qDebug() << "MeasInfo Blocksize: " << m_qSendBlock.size();
+        enqueue(t_blockOut);
     }
 }
 
 //=============================================================================================================
 
-void FiffStreamThread::writeClientId()
+void FiffStreamClient::writeClientId()
 {
-    FiffStream t_FiffStreamOut(&m_qSendBlock, QIODevice::WriteOnly);
+    QByteArray t_blockOut;
+    FiffStream t_FiffStreamOut(&t_blockOut, QIODevice::WriteOnly);
 
     t_FiffStreamOut.write_int(FIFF_MNE_RT_CLIENT_ID, &m_iDataClientId);
+
+    enqueue(t_blockOut);
 }
 
 //=============================================================================================================
 
-//void FiffStreamThread::readProc(QTcpSocket& p_qTcpSocket)
-//{
-//    FiffStream t_FiffStreamIn(&p_qTcpSocket);
-
-//    //
-//    // Read: Wait 10ms for incomming tag header, read and continue
-//    //
-//    p_qTcpSocket.waitForReadyRead(10);
-
-//    if (p_qTcpSocket.bytesAvailable() >= (int)sizeof(qint32)*4)
-//    {
-//        qDebug() << "goes to read bytes " ;
-//        FiffTag::SPtr t_pTag;
-//        FiffTag::read_tag_info(&t_FiffStreamIn, t_pTag, false);
-
-//        //
-//        // wait until tag size data are available and read the data
-//        //
-//        while (p_qTcpSocket.bytesAvailable() < t_pTag->size())
-//        {
-//            p_qTcpSocket.waitForReadyRead(10);
-//        }
-//        FiffTag::read_tag_data(&t_FiffStreamIn, t_pTag);
-
-//        //
-//        // Parse the tag
-//        //
-//        if(t_pTag->kind == FIFF_MNE_RT_COMMAND)
-//        {
-//            parseCommand(t_pTag);
-//        }
-//    }
-//}
+void FiffStreamClient::writeDataEncoding()
+{
+    QByteArray t_blockOut;
+    FiffStream t_FiffStreamOut(&t_blockOut, QIODevice::WriteOnly);
+
+    t_FiffStreamOut.write_int(FIFF_MNE_RT_DATA_ENCODING, &m_iDataEncoding);
+
+    enqueue(t_blockOut);
+}
 
 //=============================================================================================================
 
-void FiffStreamThread::run()
+void FiffStreamClient::enqueue(const QByteArray& p_blockFrame)
 {
-    m_bIsRunning = true;
-
-    FiffStreamServer* t_pParentServer = qobject_cast<FiffStreamServer*>(this->parent());
-
-    connect(t_pParentServer, &FiffStreamServer::remitMeasInfo,
-            this, &FiffStreamThread::sendMeasurementInfo);
-    connect(t_pParentServer, &FiffStreamServer::remitRawBuffer,
-            this, &FiffStreamThread::sendRawBuffer);
-    connect(t_pParentServer, &FiffStreamServer::startMeasFiffStreamClient,
-            this, &FiffStreamThread::startMeas);
-    connect(t_pParentServer, &FiffStreamServer::stopMeasFiffStreamClient,
-            this, &FiffStreamThread::stopMeas);
-
-    QTcpSocket t_qTcpSocket;
-    if (!t_qTcpSocket.setSocketDescriptor(m_iSocketDescriptor)) {
-        emit error(t_qTcpSocket.error());
+    if(m_bIsClosed || p_blockFrame.isEmpty()) {
         return;
     }
-    else
-    {
-        printf("FiffStreamClient (assigned ID %d) accepted from\n\tIP:\t%s\n\tPort:\t%d\n\n",
+
+    m_qSendQueue.enqueue(p_blockFrame);
+    m_iQueuedBytes += p_blockFrame.size();
+
+    if(m_iQueuedBytes > MAX_QUEUED_BYTES) {
+        // The client does not keep up, drop it instead of letting the queue grow without bound
+        printf("FiffStreamClient (ID %d): client is too slow (%lld bytes pending), dropping it\r\n\n",
                m_iDataClientId,
-               QHostAddress(t_qTcpSocket.peerAddress()).toString().toUtf8().constData(),
-               t_qTcpSocket.peerPort());
+               static_cast<long long>(m_iQueuedBytes));
+        close();
+        return;
+    }
+
+    writeQueue();
+}
+
+//=============================================================================================================
+
+void FiffStreamClient::writeQueue()
+{
+    if(!m_pTcpSocket || m_pTcpSocket->state() != QAbstractSocket::ConnectedState) {
+        return;
     }
 
-    FiffStream t_FiffStreamIn(&t_qTcpSocket);
+    while(!m_qSendQueue.isEmpty() && m_pTcpSocket->bytesToWrite() < MAX_SOCKET_BUFFER) {
+        const QByteArray t_blockFrame = m_qSendQueue.dequeue();
+        m_iQueuedBytes -= t_blockFrame.size();
 
-//    int i = 0;
-    while(t_qTcpSocket.state() != QAbstractSocket::UnconnectedState && m_bIsRunning)
+        if(m_pTcpSocket->write(t_blockFrame) != t_blockFrame.size()) {
+            emit error(m_pTcpSocket->error());
+            close();
+            return;
+        }
+    }
+}
+
+//=============================================================================================================
+
+void FiffStreamClient::readCommands()
+{
+    if(!m_pTcpSocket) {
+        return;
+    }
+
+    FiffStream t_FiffStreamIn(m_pTcpSocket);
+
+    while(true)
     {
         //
-        // Write available data
+        // Read the tag header as soon as it is available
         //
-        m_qMutex.lock();
-        qint32 t_iBlockSize = m_qSendBlock.size();
-//        qDebug() << "data available" << t_iBlockSize;
-        if(t_iBlockSize > 0)
+        if(!m_pPendingTag)
         {
-            qint32 t_iBytesWritten = t_qTcpSocket.write(m_qSendBlock);
-//            qDebug() << ++i<< "[wrote bytes] " << t_iBytesWritten;
-            t_qTcpSocket.waitForBytesWritten();
-            if(t_iBytesWritten == t_iBlockSize)
-            {
-                m_qSendBlock.clear();
-            }
-            else
-            {
-                //we have to store bytes which were not written to the socket, due to writing limit
-                //m_qSendBlock = m_qSendBlock.mid(t_iBytesWritten, t_iBlockSize-t_iBytesWritten);
-                m_qSendBlock.remove(0,t_iBytesWritten); //higher performance then mid
+            if(m_pTcpSocket->bytesAvailable() < (int)sizeof(qint32)*4) {
+                return;
             }
+
+            t_FiffStreamIn.read_tag_info(m_pPendingTag, false);
         }
-        m_qMutex.unlock();
 
         //
-        // Read: Wait 10ms for incomming tag header, read and continue
+        // Wait for the next readyRead until the tag data is available
         //
-        t_qTcpSocket.waitForReadyRead(10);
+        if(m_pTcpSocket->bytesAvailable() < m_pPendingTag->size()) {
+            return;
+        }
+
+        t_FiffStreamIn.read_tag_data(m_pPendingTag);
 
-        if (t_qTcpSocket.bytesAvailable() >= (int)sizeof(qint32)*4)
+        //
+        // Parse the tag
+        //
+        if(m_pPendingTag->kind == FIFF_MNE_RT_COMMAND)
         {
-//            qDebug() << "goes to read bytes " ;
-            FiffTag::SPtr t_pTag;
-            t_FiffStreamIn.read_tag_info(t_pTag, false);
+            parseCommand(m_pPendingTag);
+        }
 
-            //
-            // wait until tag size data are available and read the data
-            //
-            while (t_qTcpSocket.bytesAvailable() < t_pTag->size())
-            {
-                t_qTcpSocket.waitForReadyRead(10);
-            }
-            t_FiffStreamIn.read_tag_data(t_pTag);
+        m_pPendingTag.clear();
+    }
+}
 
-            //
-            // Parse the tag
-            //
-            if(t_pTag->kind == FIFF_MNE_RT_COMMAND)
-            {
-                parseCommand(t_pTag);
-            }
-        }
+//=============================================================================================================
+
+void FiffStreamClient::close()
+{
+    if(m_bIsClosed) {
+        return;
+    }
+
+    m_bIsClosed = true;
+
+    m_qSendQueue.clear();
+    m_iQueuedBytes = 0;
+
+    if(m_pTcpSocket) {
+        m_pTcpSocket->disconnect(this);
+        m_pTcpSocket->abort();
     }
 
-    t_qTcpSocket.disconnectFromHost();
-    if(t_qTcpSocket.state() != QAbstractSocket::UnconnectedState)
-        t_qTcpSocket.waitForDisconnected();
+    emit closed(m_iDataClientId);
 }
@@ -0,0 +1,240 @@
+//=============================================================================================================
+/**
+ * @file     fiffstreamclient.h
+ * @author   Christoph Dinh <chdinh@nmr.mgh.harvard.edu>;
+ *           Limin Sun <limin.sun@childrens.harvard.edu>;
+ *           Lorenz Esch <lesch@mgh.harvard.edu>;
+ *           Matti Hamalainen <msh@nmr.mgh.harvard.edu>
+ * @since    0.1.0
+ * @date     July, 2012
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2012, Christoph Dinh, Limin Sun, Lorenz Esch, Matti Hamalainen. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief     Declaration of the FiffStreamClient Class.
+ *
+ */
+
+#ifndef FIFFSTREAMCLIENT_H
+#define FIFFSTREAMCLIENT_H
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include <fiff/fiff_stream.h>
+#include <fiff/fiff_info.h>
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QObject>
+#include <QTcpSocket>
+#include <QQueue>
+#include <QByteArray>
+#include <QSharedPointer>
+
+//=============================================================================================================
+// DEFINE NAMESPACE RTSERVER
+//=============================================================================================================
+
+namespace RTSERVER
+{
+
+//=============================================================================================================
+// FORWARD DECLARATIONS
+//=============================================================================================================
+
+//=============================================================================================================
+/**
+ * A client of the FiffStreamServer. All clients live in the I/O thread of the server and are driven by its event
+ * loop, i.e. by the readyRead and bytesWritten notifications of their sockets. Raw buffers arrive as frames which
+ * were serialized once by the server and are shared by all client queues. Only as much data is handed to the
+ * socket as it can take without growing its write buffer beyond MAX_SOCKET_BUFFER; the rest waits in the send
+ * queue. Clients which fall behind by more than MAX_QUEUED_BYTES are disconnected.
+ */
+class FiffStreamClient : public QObject
+{
+    Q_OBJECT
+
+public:
+    //=========================================================================================================
+    /**
+     * Constructs a FiffStreamClient. The socket is created in init(), i.e. in the thread the client was moved to.
+     *
+     * @param[in] id                 The client id.
+     * @param[in] socketDescriptor   The native socket descriptor of the accepted connection.
+     */
+    FiffStreamClient(qint32 id,
+                     qintptr socketDescriptor);
+
+    ~FiffStreamClient();
+
+    //=========================================================================================================
+    /**
+     * Creates the socket and starts serving the client. Has to be called from the I/O thread.
+     */
+    void init();
+
+    inline qint32 getID();
+
+    //=========================================================================================================
+    /**
+     * @return The client alias. Only call from the I/O thread, the server keeps its own copy (see aliasChanged).
+     */
+    QString getAlias();
+
+    void parseCommand(QSharedPointer<FIFFLIB::FiffTag> p_pTag);
+
+    void writeClientId();
+
+    void startMeas(qint32 ID);
+
+    void stopMeas(qint32 ID);
+
+    void sendMeasurementInfo(qint32 ID, const FIFFLIB::FiffInfo& p_fiffInfo);
+
+    //=========================================================================================================
+    /**
+     * Queues the raw buffer frame matching the negotiated encoding. The frames are serialized once by the
+     * FiffStreamServer and shared, not copied.
+     *
+     * @param[in] p_blockFrame           The serialized FIFF_DATA_BUFFER tag.
+     * @param[in] p_blockCompressedFrame The serialized FIFF_MNE_RT_COMPRESSED_BUFFER tag. Empty if no client
+     *                                   requested the compressed encoding.
+     */
+    void sendRawBuffer(QByteArray p_blockFrame,
+                       QByteArray p_blockCompressedFrame);
+
+    //=========================================================================================================
+    /**
+     * Switches the data buffer encoding and confirms it to the client with a FIFF_MNE_RT_DATA_ENCODING tag. The
+     * server queues this call after the last frame it serialized for the old encoding, so the switch happens at a
+     * buffer boundary and no buffer is lost.
+     *
+     * @param[in] encoding   The new encoding (FIFFV_MNE_RT_ENCODING_*).
+     */
+    void setDataEncoding(qint32 encoding);
+
+    //=========================================================================================================
+    /**
+     * @return The data buffer encoding negotiated with the client.
+     */
+    inline qint32 getDataEncoding();
+
+signals:
+    void error(QTcpSocket::SocketError socketError);
+
+    //=========================================================================================================
+    /**
+     * Emitted when the connection was closed. The FiffStreamServer deletes the client afterwards.
+     *
+     * @param[in] id     The client id.
+     */
+    void closed(qint32 id);
+
+    //=========================================================================================================
+    /**
+     * Emitted when the client set a new alias.
+     *
+     * @param[in] id     The client id.
+     * @param[in] alias  The new alias.
+     */
+    void aliasChanged(qint32 id, const QString& alias);
+
+    //=========================================================================================================
+    /**
+     * Emitted when the client requested a new data buffer encoding. The encoding is switched when the server
+     * calls setDataEncoding.
+     *
+     * @param[in] id         The client id.
+     * @param[in] encoding   The requested encoding (FIFFV_MNE_RT_ENCODING_*).
+     */
+    void dataEncodingRequested(qint32 id, qint32 encoding);
+
+private:
+    //=========================================================================================================
+    /**
+     * Appends a frame to the send queue and disconnects the client if the queue exceeds MAX_QUEUED_BYTES.
+     *
+     * @param[in] p_blockFrame   The frame to send.
+     */
+    void enqueue(const QByteArray& p_blockFrame);
+
+    //=========================================================================================================
+    /**
+     * Queues a FIFF_MNE_RT_DATA_ENCODING tag with the current encoding.
+     */
+    void writeDataEncoding();
+
+    //=========================================================================================================
+    /**
+     * Hands queued frames to the socket as long as its write buffer is below MAX_SOCKET_BUFFER.
+     */
+    void writeQueue();
+
+    //=========================================================================================================
+    /**
+     * Reads and parses all complete command tags available on the socket.
+     */
+    void readCommands();
+
+    //=========================================================================================================
+    /**
+     * Closes the connection.
+     */
+    void close();
+
+    static const qint64 MAX_SOCKET_BUFFER = 1024 * 1024;           /**< Bytes handed to the socket at most. */
+    static const qint64 MAX_QUEUED_BYTES = 64 * 1024 * 1024;       /**< Bytes a client may fall behind before it gets dropped. */
+
+    qint32 m_iDataClientId;
+    QString m_sDataClientAlias;
+
+    qintptr m_iSocketDescriptor;
+    QTcpSocket* m_pTcpSocket;
+
+    QQueue<QByteArray> m_qSendQueue;            /**< Frames waiting to be written to the socket. */
+    qint64 m_iQueuedBytes;                      /**< Number of bytes in the send queue. */
+
+    QSharedPointer<FIFFLIB::FiffTag> m_pPendingTag;     /**< Command tag whose data did not fully arrive yet. */
+
+    bool m_bIsSendingRawBuffer;
+    bool m_bIsClosed;
+
+    qint32 m_iDataEncoding;                     /**< The data buffer encoding, FIFFV_MNE_RT_ENCODING_*. */
+};
+
+inline qint32 FiffStreamClient::getID()
+{
+    return m_iDataClientId;
+}
+
+inline qint32 FiffStreamClient::getDataEncoding()
+{
+    return m_iDataEncoding;
+}
+} // NAMESPACE
+
+#endif //FIFFSTREAMCLIENT_H
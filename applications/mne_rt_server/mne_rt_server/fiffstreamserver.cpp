@@ -40,12 +40,17 @@
 //=============================================================================================================
 
 #include "fiffstreamserver.h"
-#include "fiffstreamthread.h"
+#include "fiffstreamclient.h"
 
 #include "mne_rt_server.h"
 
+#include <communication/rtClient/rtdatacodec.h>
+
 #include <stdlib.h>
 
+#include <fiff/fiff_constants.h>
+#include <fiff/fiff_tag.h>
+
 //=============================================================================================================
 // USED NAMESPACES
 //=============================================================================================================
@@ -62,6 +67,7 @@ FiffStreamServer::FiffStreamServer(QObject *parent)
 : QTcpServer(parent)
 , m_iNextClientId(0)
 {
+    m_ioThread.start();
 }
 
 //=============================================================================================================
@@ -69,6 +75,10 @@ FiffStreamServer::FiffStreamServer(QObject *parent)
 FiffStreamServer::~FiffStreamServer()
 {
     emit closeFiffStreamServer();
+
+    // Clients are deleted when the I/O thread finishes
+    m_ioThread.quit();
+    m_ioThread.wait();
 }
 
 //=============================================================================================================
@@ -78,10 +88,10 @@ void FiffStreamServer::comClist(Command p_command)
     //ToDo JSON
     QString t_sOutput("");
     t_sOutput.append("\tID\tAlias\r\n");
-    QMap<qint32, FiffStreamThread*>::iterator i;
-    for (i = this->m_qClientList.begin(); i != this->m_qClientList.end(); ++i)
+    QMap<qint32, QString>::const_iterator i;
+    for (i = this->m_qClientAliases.constBegin(); i != this->m_qClientAliases.constEnd(); ++i)
     {
-        QString str = QString("\t%1\t%2\r\n").arg(i.key()).arg(i.value()->getAlias());
+        QString str = QString("\t%1\t%2\r\n").arg(i.key()).arg(i.value());
         t_sOutput.append(str);
     }
     t_sOutput.append("\n");
@@ -191,7 +201,7 @@ void FiffStreamServer::connectCommands()
 //        printf("clist\n");
 
 //        p_blockOutputInfo.append("\tID\tAlias\r\n");
-//        QMap<qint32, FiffStreamThread*>::iterator i;
+//        QMap<qint32, FiffStreamClient*>::iterator i;
 //        for (i = this->m_qClientList.begin(); i != this->m_qClientList.end(); ++i)
 //        {
 //            QString str = QString("\t%1\t%2\r\n").arg(i.key()).arg(i.value()->getAlias());
@@ -304,13 +314,13 @@ QByteArray FiffStreamServer::parseToId(QString& p_sRawId, qint32& p_iParsedId)
         }
         else
         {
-            QMap<qint32, FiffStreamThread*>::iterator i;
-            for (i = this->m_qClientList.begin(); i != this->m_qClientList.end(); ++i)
+            QMap<qint32, QString>::const_iterator i;
+            for (i = this->m_qClientAliases.constBegin(); i != this->m_qClientAliases.constEnd(); ++i)
             {
-                if(i.value()->getAlias().compare(p_sRawId) == 0)
+                if(i.value().compare(p_sRawId) == 0)
                 {
                     p_iParsedId = i.key();
-                    QString str = QString("\tconvert alias '%1' => %2\r\n").arg(i.value()->getAlias()).arg(i.key());
+                    QString str = QString("\tconvert alias '%1' => %2\r\n").arg(i.value()).arg(i.key());
                     t_blockCmdIdInfo.append(str);
                     break;
                 }
@@ -348,6 +358,12 @@ QByteArray FiffStreamServer::parseToId(QString& p_sRawId, qint32& p_iParsedId)
 
 void FiffStreamServer::forwardMeasInfo(qint32 ID, const FiffInfo& p_fiffInfo)
 {
+    // Keep the calibration steps for the compressed encoding
+    m_vecCals.resize(p_fiffInfo.chs.size());
+    for(int i = 0; i < p_fiffInfo.chs.size(); ++i) {
+        m_vecCals[i] = p_fiffInfo.chs.at(i).cal * p_fiffInfo.chs.at(i).range;
+    }
+
     emit remitMeasInfo(ID, p_fiffInfo);
 }
 
@@ -355,21 +371,105 @@ void FiffStreamServer::forwardMeasInfo(qint32 ID, const FiffInfo& p_fiffInfo)
 //ToDo increase preformance --> try inline
 void FiffStreamServer::forwardRawBuffer(QSharedPointer<Eigen::MatrixXf> m_pMatRawData)
 {
-    emit remitRawBuffer(m_pMatRawData);
+    if(m_qClientList.isEmpty()) {
+        return;
+    }
+
+    // Only serialize the encodings which are actually requested
+    QByteArray t_blockFrame;
+    if(m_qCompressedClients.size() < m_qClientList.size()) {
+        FiffStream t_FiffStreamOut(&t_blockFrame, QIODevice::WriteOnly);
+        t_FiffStreamOut.write_float(FIFF_DATA_BUFFER,m_pMatRawData->data(),m_pMatRawData->rows()*m_pMatRawData->cols());
+    }
+
+    QByteArray t_blockCompressedFrame;
+    if(!m_qCompressedClients.isEmpty()) {
+        FiffTag::SPtr t_pTag(new FiffTag());
+        t_pTag->kind = FIFF_MNE_RT_COMPRESSED_BUFFER;
+        t_pTag->type = FIFFT_BYTE;
+        t_pTag->next = FIFFV_NEXT_SEQ;
+        t_pTag->append(RtDataCodec::encode(*m_pMatRawData, m_vecCals));
+
+        FiffStream t_FiffStreamOut(&t_blockCompressedFrame, QIODevice::WriteOnly);
+        t_FiffStreamOut.write_tag(t_pTag);
+    }
+
+    emit remitRawBuffer(t_blockFrame, t_blockCompressedFrame);
+}
+
+//=============================================================================================================
+
+void FiffStreamServer::removeClient(qint32 id)
+{
+    FiffStreamClient* t_pStreamClient = m_qClientList.take(id);
+    m_qClientAliases.remove(id);
+    m_qCompressedClients.remove(id);
+
+    if(t_pStreamClient) {
+        t_pStreamClient->deleteLater();
+    }
+}
+
+//=============================================================================================================
+
+void FiffStreamServer::setClientAlias(qint32 id, const QString& alias)
+{
+    if(m_qClientList.contains(id)) {
+        m_qClientAliases.insert(id, alias);
+    }
+}
+
+//=============================================================================================================
+
+void FiffStreamServer::setClientDataEncoding(qint32 id, qint32 encoding)
+{
+    FiffStreamClient* t_pStreamClient = m_qClientList.value(id, Q_NULLPTR);
+    if(!t_pStreamClient) {
+        return;
+    }
+
+    if(encoding == FIFFV_MNE_RT_ENCODING_COMPRESSED) {
+        m_qCompressedClients.insert(id);
+    } else {
+        m_qCompressedClients.remove(id);
+    }
+
+    // Frames serialized from now on contain the new encoding. The switch is queued behind the frames which were
+    // already emitted, so the client picks the matching frame for every buffer.
+    QMetaObject::invokeMethod(t_pStreamClient, [t_pStreamClient, encoding]() { t_pStreamClient->setDataEncoding(encoding); }, Qt::QueuedConnection);
 }
 
 //=============================================================================================================
 
 void FiffStreamServer::incomingConnection(qintptr socketDescriptor)
 {
-    FiffStreamThread* t_pStreamThread = new FiffStreamThread(m_iNextClientId, socketDescriptor, this);
+    FiffStreamClient* t_pStreamClient = new FiffStreamClient(m_iNextClientId, socketDescriptor);
 
-    m_qClientList.insert(m_iNextClientId, t_pStreamThread);
+    m_qClientList.insert(m_iNextClientId, t_pStreamClient);
+    m_qClientAliases.insert(m_iNextClientId, QString(""));
     ++m_iNextClientId;
 
-    //when thread has finished it gets deleted
-    connect(t_pStreamThread, SIGNAL(finished()), t_pStreamThread, SLOT(deleteLater()));
-    connect(this, SIGNAL(closeFiffStreamServer()), t_pStreamThread, SLOT(deleteLater()));
-
-    t_pStreamThread->start();
+    // All clients share the event loop of the I/O thread, the connections below are queued into it
+    t_pStreamClient->moveToThread(&m_ioThread);
+
+    connect(this, &FiffStreamServer::remitMeasInfo,
+            t_pStreamClient, &FiffStreamClient::sendMeasurementInfo);
+    connect(this, &FiffStreamServer::remitRawBuffer,
+            t_pStreamClient, &FiffStreamClient::sendRawBuffer);
+    connect(this, &FiffStreamServer::startMeasFiffStreamClient,
+            t_pStreamClient, &FiffStreamClient::startMeas);
+    connect(this, &FiffStreamServer::stopMeasFiffStreamClient,
+            t_pStreamClient, &FiffStreamClient::stopMeas);
+
+    //when the connection was closed the client gets deleted
+    connect(t_pStreamClient, &FiffStreamClient::closed,
+            this, &FiffStreamServer::removeClient);
+    connect(t_pStreamClient, &FiffStreamClient::aliasChanged,
+            this, &FiffStreamServer::setClientAlias);
+    connect(t_pStreamClient, &FiffStreamClient::dataEncodingRequested,
+            this, &FiffStreamServer::setClientDataEncoding);
+    connect(&m_ioThread, &QThread::finished,
+            t_pStreamClient, &QObject::deleteLater);
+
+    QMetaObject::invokeMethod(t_pStreamClient, [t_pStreamClient]() { t_pStreamClient->init(); }, Qt::QueuedConnection);
 }
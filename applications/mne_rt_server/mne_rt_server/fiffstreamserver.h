@@ -50,6 +50,10 @@
 
 #include <QStringList>
 #include <QTcpServer>
+#include <QThread>
+#include <QByteArray>
+#include <QMap>
+#include <QSet>
 
 //=============================================================================================================
 // DEFINE NAMESPACE RTSERVER
@@ -62,7 +66,7 @@ namespace RTSERVER
 // FORWARD DECLARATIONS
 //=============================================================================================================
 
-class FiffStreamThread;
+class FiffStreamClient;
 
 //=============================================================================================================
 /**
@@ -74,7 +78,6 @@ class FiffStreamServer : public QTcpServer//, public ICommandParser //OLD remove
 {
     Q_OBJECT
 
-    friend class FiffStreamThread;
 
 public:
 
@@ -90,7 +93,7 @@ public:
     /**
      * ToDo...
      */
-    inline FiffStreamThread* getClient(qint32 id);
+    inline FiffStreamClient* getClient(qint32 id);
 
     //=========================================================================================================
     /**
@@ -108,6 +111,13 @@ public:
 
 //public slots: --> in Qt 5 not anymore declared as slot
     void forwardMeasInfo(qint32 ID, const FIFFLIB::FiffInfo& p_fiffInfo);
+    //=========================================================================================================
+    /**
+     * Serializes the raw buffer once per requested encoding into a FIFF_DATA_BUFFER and/or a
+     * FIFF_MNE_RT_COMPRESSED_BUFFER frame and hands the same, implicitly shared frames to all clients.
+     *
+     * @param[in] m_pMatRawData  The raw buffer.
+     */
     void forwardRawBuffer(QSharedPointer<Eigen::MatrixXf> m_pMatRawData);
 
 signals:
@@ -117,7 +127,7 @@ signals:
     void stopMeasFiffStreamClient(qint32 ID);
 
     void remitMeasInfo(qint32 ID, const FIFFLIB::FiffInfo& p_fiffInfo);
-    void remitRawBuffer(QSharedPointer<Eigen::MatrixXf>);
+    void remitRawBuffer(QByteArray p_blockFrame, QByteArray p_blockCompressedFrame);
 
     void closeFiffStreamServer();
 
@@ -168,15 +178,46 @@ private:
 
     QByteArray parseToId(QString& p_sRawId, qint32& p_iParsedId);
 
-    QMap<qint32, FiffStreamThread*> m_qClientList;
+    //=========================================================================================================
+    /**
+     * Removes a client after its connection was closed and schedules it for deletion in the I/O thread.
+     *
+     * @param[in] id     The client id.
+     */
+    void removeClient(qint32 id);
+
+    //=========================================================================================================
+    /**
+     * Stores the alias the client set, so that the alias can be looked up without touching the client.
+     *
+     * @param[in] id         The client id.
+     * @param[in] alias      The new client alias.
+     */
+    void setClientAlias(qint32 id, const QString& alias);
+
+    //=========================================================================================================
+    /**
+     * Updates the set of clients which receive compressed buffers and switches the client to the encoding. Runs
+     * in the server thread, like forwardRawBuffer, so the set does not change while a buffer is serialized.
+     *
+     * @param[in] id         The client id.
+     * @param[in] encoding   The requested encoding (FIFFV_MNE_RT_ENCODING_*).
+     */
+    void setClientDataEncoding(qint32 id, qint32 encoding);
+
+    QMap<qint32, FiffStreamClient*> m_qClientList;
+    QMap<qint32, QString>           m_qClientAliases;   /**< Copies of the client aliases, only used from the server thread. */
     qint32                          m_iNextClientId;
+    QThread                         m_ioThread;         /**< Runs the event loop which serves all client sockets. */
+    QSet<qint32>                    m_qCompressedClients;   /**< Ids of the clients which requested compressed buffers, only used from the server thread. */
+    Eigen::VectorXf                 m_vecCals;          /**< Quantization steps (cal * range) of the channels. */
 };
 
 //=============================================================================================================
 // INLINE DEFINITIONS
 //=============================================================================================================
 
-FiffStreamThread* FiffStreamServer::getClient(qint32 id)
+FiffStreamClient* FiffStreamServer::getClient(qint32 id)
 {
     return m_qClientList[id];
 }
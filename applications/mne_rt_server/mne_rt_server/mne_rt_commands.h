@@ -36,6 +36,12 @@
 #ifndef MNE_RT_COMMANDS_H
 #define MNE_RT_COMMANDS_H
 
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include <fiff/fiff_constants.h>
+
 //=============================================================================================================
 // DEFINE NAMESPACE RTSERVER
 //=============================================================================================================
@@ -47,8 +53,9 @@ namespace RTSERVER
 // MNE RT Communication Constants
 //=============================================================================================================
 
-#define MNE_RT_GET_CLIENT_ID        1       /**< Request client id at mne_rt_server. */
-#define MNE_RT_SET_CLIENT_ALIAS     2       /**< Set client alias at mne_rt_server. */
+#define MNE_RT_GET_CLIENT_ID        FIFFV_MNE_RT_GET_CLIENT_ID      /**< Request client id at mne_rt_server. */
+#define MNE_RT_SET_CLIENT_ALIAS     FIFFV_MNE_RT_SET_CLIENT_ALIAS   /**< Set client alias at mne_rt_server. */
+#define MNE_RT_SET_DATA_ENCODING    FIFFV_MNE_RT_SET_DATA_ENCODING  /**< Set data buffer encoding (FIFFV_MNE_RT_ENCODING_*) at mne_rt_server. */
 } // NAMESPACE
 
 #endif // MNE_RT_COMMANDS_H
@@ -112,17 +112,24 @@ void RealTimeMultiSampleArrayWidget::update(SCMEASLIB::Measurement::SPtr pMeasur
     }
 
     if(m_pRTMSA) {
-        if(m_pRTMSA->isChInit() && !m_pFiffInfo) {
+        const QList<MultiSampleFrame::ConstSPtr> lFrames = m_pRTMSA->getMultiSampleFrames();
+
+        if(m_pRTMSA->isChInit() && !m_pFiffInfo && !lFrames.isEmpty()) {
             m_pFiffInfo = m_pRTMSA->info();
-            m_iMaxFilterTapSize = m_pRTMSA->getMultiSampleArray().first().cols();
+            m_iMaxFilterTapSize = lFrames.first()->data().cols();
 
             if(!m_bDisplayWidgetsInitialized) {
                 initDisplayControllWidgets();
             }
         }
-        if (!m_pRTMSA->getMultiSampleArray().isEmpty()) {
+        if (!lFrames.isEmpty()) {
             //Add data to table view
-            m_pChannelDataView->addData(m_pRTMSA->getMultiSampleArray());
+            QList<Eigen::MatrixXd> lData;
+            lData.reserve(lFrames.size());
+            for(const MultiSampleFrame::ConstSPtr& pFrame : lFrames) {
+                lData.append(pFrame->data());
+            }
+            m_pChannelDataView->addData(lData);
         }
     }
 }
@@ -0,0 +1,158 @@
+//=============================================================================================================
+/**
+ * @file     multisampleframe.cpp
+ * @author   agent <agent@local>
+ * @since    0.1.9
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, agent. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    Definition of the MultiSampleFrame and MultiSampleFramePool classes.
+ *
+ */
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include "multisampleframe.h"
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QMutexLocker>
+
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace SCMEASLIB;
+using namespace Eigen;
+
+//=============================================================================================================
+// DEFINE MEMBER METHODS
+//=============================================================================================================
+
+MultiSampleFrame::MultiSampleFrame(const MatrixXd& matData,
+                                   qint64 iFirstSample,
+                                   qint64 iTimestamp)
+: m_matData(matData)
+, m_iFirstSample(iFirstSample)
+, m_iTimestamp(iTimestamp)
+{
+}
+
+//=============================================================================================================
+
+MultiSampleFramePool::FreeList::~FreeList()
+{
+    qDeleteAll(frames);
+}
+
+//=============================================================================================================
+
+MultiSampleFramePool::MultiSampleFramePool(int iMaxNumFrames)
+: m_pFreeList(new FreeList)
+{
+    m_pFreeList->iMaxNumFrames = iMaxNumFrames;
+    m_pFreeList->iNumAllocations = 0;
+    m_pFreeList->frames.reserve(iMaxNumFrames);
+}
+
+//=============================================================================================================
+
+MultiSampleFrame::ConstSPtr MultiSampleFramePool::acquire(const MatrixXd& matData,
+                                                          qint64 iFirstSample,
+                                                          qint64 iTimestamp)
+{
+    MultiSampleFrame* pFrame = Q_NULLPTR;
+
+    {
+        QMutexLocker locker(&m_pFreeList->mutex);
+        QVector<MultiSampleFrame*>& frames = m_pFreeList->frames;
+
+        // Prefer a frame of the same size, its storage can be reused as is
+        for(int i = frames.size() - 1; i >= 0; --i) {
+            if(frames[i]->m_matData.size() == matData.size()) {
+                pFrame = frames[i];
+                frames[i] = frames.last();
+                frames.removeLast();
+                break;
+            }
+        }
+        if(!pFrame && !frames.isEmpty()) {
+            pFrame = frames.takeLast();
+        }
+        if(!pFrame) {
+            ++m_pFreeList->iNumAllocations;
+        }
+    }
+
+    if(pFrame) {
+        pFrame->m_matData = matData;
+    } else {
+        pFrame = new MultiSampleFrame(matData);
+    }
+    pFrame->m_iFirstSample = iFirstSample;
+    pFrame->m_iTimestamp = iTimestamp;
+
+    QWeakPointer<FreeList> pFreeList = m_pFreeList;
+    return MultiSampleFrame::SPtr(pFrame, [pFreeList](MultiSampleFrame* pReleased) {
+        MultiSampleFramePool::release(pFreeList, pReleased);
+    });
+}
+
+//=============================================================================================================
+
+qint64 MultiSampleFramePool::numAllocations() const
+{
+    QMutexLocker locker(&m_pFreeList->mutex);
+    return m_pFreeList->iNumAllocations;
+}
+
+//=============================================================================================================
+
+int MultiSampleFramePool::numFreeFrames() const
+{
+    QMutexLocker locker(&m_pFreeList->mutex);
+    return m_pFreeList->frames.size();
+}
+
+//=============================================================================================================
+
+void MultiSampleFramePool::release(const QWeakPointer<FreeList>& pFreeList,
+                                   MultiSampleFrame* pFrame)
+{
+    QSharedPointer<FreeList> pList = pFreeList.toStrongRef();
+    if(pList) {
+        QMutexLocker locker(&pList->mutex);
+        if(pList->frames.size() < pList->iMaxNumFrames) {
+            pList->frames.append(pFrame);
+            return;
+        }
+    }
+
+    delete pFrame;
+}
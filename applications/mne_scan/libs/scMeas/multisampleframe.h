@@ -0,0 +1,228 @@
+//=============================================================================================================
+/**
+ * @file     multisampleframe.h
+ * @author   agent <agent@local>
+ * @since    0.1.9
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, agent. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    MultiSampleFrame and MultiSampleFramePool declaration.
+ *
+ */
+
+#ifndef MULTISAMPLEFRAME_H
+#define MULTISAMPLEFRAME_H
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include "scmeas_global.h"
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QSharedPointer>
+#include <QMutex>
+#include <QVector>
+
+//=============================================================================================================
+// EIGEN INCLUDES
+//=============================================================================================================
+
+#include <Eigen/Core>
+
+//=============================================================================================================
+// DEFINE NAMESPACE SCMEASLIB
+//=============================================================================================================
+
+namespace SCMEASLIB
+{
+
+//=============================================================================================================
+// SCMEASLIB FORWARD DECLARATIONS
+//=============================================================================================================
+
+class MultiSampleFramePool;
+
+//=========================================================================================================
+/**
+ * One block of multi channel data as it travels through the measurement bus. Frames are immutable once handed
+ * out, so all consumers of a measurement share the same allocation and can keep a frame as long as they like
+ * without locking.
+ *
+ * @brief Immutable, reference counted block of multi channel data.
+ */
+class SCMEASSHARED_EXPORT MultiSampleFrame
+{
+    friend class MultiSampleFramePool;
+
+public:
+    typedef QSharedPointer<MultiSampleFrame> SPtr;               /**< Shared pointer type for MultiSampleFrame. */
+    typedef QSharedPointer<const MultiSampleFrame> ConstSPtr;    /**< Const shared pointer type for MultiSampleFrame. */
+
+    //=========================================================================================================
+    /**
+     * Constructs a frame.
+     *
+     * @param[in] matData        the data, channels x samples.
+     * @param[in] iFirstSample   index of the first sample since the measurement started.
+     * @param[in] iTimestamp     time the frame entered the measurement bus, in ms since epoch.
+     */
+    explicit MultiSampleFrame(const Eigen::MatrixXd& matData = Eigen::MatrixXd(),
+                              qint64 iFirstSample = 0,
+                              qint64 iTimestamp = 0);
+
+    //=========================================================================================================
+    /**
+     * Returns the data, channels x samples.
+     *
+     * @return the data.
+     */
+    inline const Eigen::MatrixXd& data() const;
+
+    //=========================================================================================================
+    /**
+     * Returns the index of the first sample since the measurement started.
+     *
+     * @return the first sample.
+     */
+    inline qint64 firstSample() const;
+
+    //=========================================================================================================
+    /**
+     * Returns the time the frame entered the measurement bus.
+     *
+     * @return the time stamp in ms since epoch.
+     */
+    inline qint64 timestamp() const;
+
+private:
+    Eigen::MatrixXd     m_matData;          /**< The data, channels x samples. */
+    qint64              m_iFirstSample;     /**< Index of the first sample since the measurement started. */
+    qint64              m_iTimestamp;       /**< Time the frame entered the measurement bus, in ms since epoch. */
+};
+
+//=========================================================================================================
+/**
+ * Hands out frames and takes them back once the last consumer released them, so steady streaming reuses the
+ * same matrix allocations instead of allocating one per block. Frames which outlive the pool are simply
+ * deleted.
+ *
+ * @brief Pool of MultiSampleFrame objects.
+ */
+class SCMEASSHARED_EXPORT MultiSampleFramePool
+{
+
+public:
+    typedef QSharedPointer<MultiSampleFramePool> SPtr;               /**< Shared pointer type for MultiSampleFramePool. */
+    typedef QSharedPointer<const MultiSampleFramePool> ConstSPtr;    /**< Const shared pointer type for MultiSampleFramePool. */
+
+    //=========================================================================================================
+    /**
+     * Constructs a pool.
+     *
+     * @param[in] iMaxNumFrames  the maximal number of released frames which are kept for reuse.
+     */
+    explicit MultiSampleFramePool(int iMaxNumFrames = 64);
+
+    //=========================================================================================================
+    /**
+     * Returns a frame holding a copy of the data. Reuses a released frame of the same size if there is one.
+     *
+     * @param[in] matData        the data, channels x samples.
+     * @param[in] iFirstSample   index of the first sample since the measurement started.
+     * @param[in] iTimestamp     time the frame entered the measurement bus, in ms since epoch.
+     *
+     * @return the frame.
+     */
+    MultiSampleFrame::ConstSPtr acquire(const Eigen::MatrixXd& matData,
+                                        qint64 iFirstSample,
+                                        qint64 iTimestamp);
+
+    //=========================================================================================================
+    /**
+     * Returns the number of frames which were allocated because no released frame could be reused.
+     *
+     * @return the number of allocations.
+     */
+    qint64 numAllocations() const;
+
+    //=========================================================================================================
+    /**
+     * Returns the number of released frames which wait for reuse.
+     *
+     * @return the number of free frames.
+     */
+    int numFreeFrames() const;
+
+private:
+    struct FreeList
+    {
+        QMutex                      mutex;              /**< Guards the free list, frames are released from any thread. */
+        QVector<MultiSampleFrame*>  frames;             /**< Released frames. */
+        int                         iMaxNumFrames;      /**< Maximal number of kept frames. */
+        qint64                      iNumAllocations;    /**< Number of allocated frames. */
+
+        ~FreeList();
+    };
+
+    //=========================================================================================================
+    /**
+     * Puts a frame back into the free list, or deletes it if the pool is gone or full.
+     */
+    static void release(const QWeakPointer<FreeList>& pFreeList, MultiSampleFrame* pFrame);
+
+    QSharedPointer<FreeList>    m_pFreeList;    /**< Released frames, shared with the deleters of the frames handed out. */
+};
+
+//=============================================================================================================
+// INLINE DEFINITIONS
+//=============================================================================================================
+
+inline const Eigen::MatrixXd& MultiSampleFrame::data() const
+{
+    return m_matData;
+}
+
+//=============================================================================================================
+
+inline qint64 MultiSampleFrame::firstSample() const
+{
+    return m_iFirstSample;
+}
+
+//=============================================================================================================
+
+inline qint64 MultiSampleFrame::timestamp() const
+{
+    return m_iTimestamp;
+}
+} // NAMESPACE
+
+Q_DECLARE_METATYPE(SCMEASLIB::MultiSampleFrame::ConstSPtr)
+
+#endif // MULTISAMPLEFRAME_H
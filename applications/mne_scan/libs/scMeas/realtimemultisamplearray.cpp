@@ -46,6 +46,7 @@
 //=============================================================================================================
 
 #include <QDebug>
+#include <QDateTime>
 
 //=============================================================================================================
 // USED NAMESPACES
@@ -63,6 +64,7 @@ RealTimeMultiSampleArray::RealTimeMultiSampleArray(QObject *parent)
 : Measurement(QMetaType::type("RealTimeMultiSampleArray::SPtr"), parent)
 , m_fSamplingRate(0)
 , m_iMultiArraySize(10)
+, m_iNumSamples(0)
 , m_bChInfoIsInit(false)
 {
 }
@@ -245,15 +247,56 @@ void RealTimeMultiSampleArray::setValue(const MatrixXd& mat)
 //        else if(v[i] > m_qListChInfo[i].getMaxValue()) v[i] = m_qListChInfo[i].getMaxValue();
 //    }
 
-    //Store
-    m_matSamples.push_back(mat);
+    //Store, the only copy of the data on its way to all consumers
+    m_lFrames.push_back(m_framePool.acquire(mat, m_iNumSamples, QDateTime::currentMSecsSinceEpoch()));
+    m_iNumSamples += mat.cols();
 
     m_qMutex.unlock();
-    if(m_matSamples.size() >= m_iMultiArraySize)
+    notifyIfFull();
+}
+
+//=============================================================================================================
+
+void RealTimeMultiSampleArray::setValue(const MultiSampleFrame::ConstSPtr& pFrame)
+{
+    if(!m_bChInfoIsInit || !pFrame)
+        return;
+
+    m_qMutex.lock();
+    if(pFrame->data().rows() != m_qListChInfo.size())
+        qCritical() << "Error Occured in RealTimeMultiSampleArray::setValue: Frame size does not match the number of channels! ";
+
+    m_lFrames.push_back(pFrame);
+    m_iNumSamples = pFrame->firstSample() + pFrame->data().cols();
+
+    m_qMutex.unlock();
+    notifyIfFull();
+}
+
+//=============================================================================================================
+
+QList<MatrixXd> RealTimeMultiSampleArray::getMultiSampleArray() const
+{
+    QList<MatrixXd> lData;
+    for(const MultiSampleFrame::ConstSPtr& pFrame : getMultiSampleFrames())
+        lData.append(pFrame->data());
+
+    return lData;
+}
+
+//=============================================================================================================
+
+void RealTimeMultiSampleArray::notifyIfFull()
+{
+    m_qMutex.lock();
+    bool bFull = m_lFrames.size() >= m_iMultiArraySize;
+    m_qMutex.unlock();
+
+    if(bFull)
     {
         emit notify();
         m_qMutex.lock();
-        m_matSamples.clear();
+        m_lFrames.clear();
         m_qMutex.unlock();
     }
 }
@@ -42,6 +42,7 @@
 
 #include "scmeas_global.h"
 #include "measurement.h"
+#include "multisampleframe.h"
 #include "realtimesamplearraychinfo.h"
 
 #include <fiff/fiff_info.h>
@@ -193,21 +194,52 @@ public:
 
     //=========================================================================================================
     /**
-     * Returns the gathered multi sample array.
+     * Returns the gathered frames. The frames are shared with all other consumers, keep them instead of copying
+     * their data.
+     *
+     * @return the current frames.
+     */
+    inline QList<MultiSampleFrame::ConstSPtr> getMultiSampleFrames() const;
+
+    //=========================================================================================================
+    /**
+     * Returns a copy of the data of the gathered frames. Prefer getMultiSampleFrames, which does not copy.
      *
      * @return the current multi sample array.
      */
-    inline const QList<Eigen::MatrixXd>& getMultiSampleArray();
+    QList<Eigen::MatrixXd> getMultiSampleArray() const;
 
     //=========================================================================================================
     /**
-     * Attaches a value to the sample array list.
+     * Attaches a value to the sample array list. The data is copied once into a pooled frame.
      *
      * @param[in] mat   the value which is attached to the sample array list.
      */
     virtual void setValue(const Eigen::MatrixXd& mat);
 
+    //=========================================================================================================
+    /**
+     * Attaches a frame to the sample array list without copying it, e.g. to pass on a frame unchanged.
+     *
+     * @param[in] pFrame    the frame which is attached to the sample array list.
+     */
+    virtual void setValue(const MultiSampleFrame::ConstSPtr& pFrame);
+
+    //=========================================================================================================
+    /**
+     * Returns the pool the frames of setValue(const Eigen::MatrixXd&) are taken from.
+     *
+     * @return the frame pool.
+     */
+    inline const MultiSampleFramePool& framePool() const;
+
 private:
+    //=========================================================================================================
+    /**
+     * Notifies the consumers and starts a new list once enough frames were gathered.
+     */
+    void notifyIfFull();
+
     mutable QMutex              m_qMutex;           /**< Mutex to ensure thread safety. */
 
     FIFFLIB::FiffInfo::SPtr     m_pFiffInfo_orig;   /**< Original Fiff Info if initialized by fiff info. */
@@ -215,7 +247,9 @@ private:
     QString                     m_sXMLLayoutFile;   /**< Layout file name. */
     float                       m_fSamplingRate;    /**< Sampling rate of the RealTimeSampleArray.*/
     qint32                      m_iMultiArraySize;  /**< Sample size of the multi sample array.*/
-    QList<Eigen::MatrixXd>      m_matSamples;       /**< The multi sample array.*/
+    QList<MultiSampleFrame::ConstSPtr> m_lFrames;   /**< The gathered frames.*/
+    MultiSampleFramePool        m_framePool;        /**< Pool the frames are taken from.*/
+    qint64                      m_iNumSamples;      /**< Number of samples since the measurement started.*/
     bool                        m_bChInfoIsInit;    /**< If channel info is initialized.*/
 
     QList<RealTimeSampleArrayChInfo> m_qListChInfo; /**< Channel info list.*/
@@ -228,7 +262,7 @@ private:
 inline void RealTimeMultiSampleArray::clear()
 {
     QMutexLocker locker(&m_qMutex);
-    m_matSamples.clear();
+    m_lFrames.clear();
 }
 
 //=============================================================================================================
@@ -317,9 +351,17 @@ qint32 RealTimeMultiSampleArray::getMultiArraySize() const
 
 //=============================================================================================================
 
-inline const QList<Eigen::MatrixXd>& RealTimeMultiSampleArray::getMultiSampleArray()
+inline QList<MultiSampleFrame::ConstSPtr> RealTimeMultiSampleArray::getMultiSampleFrames() const
+{
+    QMutexLocker locker(&m_qMutex);
+    return m_lFrames;
+}
+
+//=============================================================================================================
+
+inline const MultiSampleFramePool& RealTimeMultiSampleArray::framePool() const
 {
-    return m_matSamples;
+    return m_framePool;
 }
 } // NAMESPACE
 
@@ -74,6 +74,7 @@ SOURCES += \
     realtimesourceestimate.cpp \
     realtimeconnectivityestimate.cpp \
     realtimemultisamplearray.cpp \
+    multisampleframe.cpp \
     realtimesamplearraychinfo.cpp \
     numeric.cpp \
     measurement.cpp \
@@ -89,6 +90,7 @@ HEADERS += \
     realtimesourceestimate.h \
     realtimeconnectivityestimate.h \
     realtimemultisamplearray.h \
+    multisampleframe.h \
     realtimesamplearraychinfo.h \
     numeric.h \
     measurement.h \
@@ -50,6 +50,7 @@
 #include <scShared/Plugins/abstractplugin.h>
 
 #include <utils/generics/applicationlogger.h>
+#include <utils/mnetracer.h>
 
 //=============================================================================================================
 // EIGEN INCLUDES
@@ -171,7 +172,12 @@ int main(int argc, char *argv[])
     fmt.setSamples(10);
     QSurfaceFormat::setDefaultFormat(fmt);
 
+    // Only active in builds with MNECPP_CONFIG+=trace
+    MNE_TRACER_ENABLE(mne_scan_trace.json)
+
     int returnValue(app.exec());
 
+    MNE_TRACER_DISABLE
+
     return returnValue;
 }
@@ -47,6 +47,7 @@
 #include <scMeas/realtimemultisamplearray.h>
 
 #include <rtprocessing/rtaveraging.h>
+#include <utils/mnetracer.h>
 
 //=============================================================================================================
 // QT INCLUDES
@@ -167,17 +168,11 @@ void Averaging::update(SCMEASLIB::Measurement::SPtr pMeasurement)
         }
 
         // Append new data
-        MatrixXd matData;
-
-        if(m_pFiffInfo) {
-            for(qint32 i = 0; i < pRTMSA->getMultiSampleArray().size(); ++i) {
-                if(m_pRtAve) {
-                    // This extra copy is necessary since the referenced data is getting deleted as soon as
-                    // m_pRtAve->append() returns. m_pRtAve->append() returns without a copy since it communicates
-                    // via signals with the worker thread of RtCov.
-                    matData = pRTMSA->getMultiSampleArray()[i];
-                    m_pRtAve->append(matData);
-                }
+        if(m_pFiffInfo && m_pRtAve) {
+            // The frames stay alive until append() returns, the queued signal takes its own copy for the
+            // worker thread of RtAveraging.
+            for(const MultiSampleFrame::ConstSPtr& pFrame : pRTMSA->getMultiSampleFrames()) {
+                m_pRtAve->append(pFrame->data());
             }
         }
     }
@@ -441,6 +436,7 @@ void Averaging::run()
 
     while(!isInterruptionRequested()){
         if(m_pCircularBuffer->pop(evokedSet)) {
+            MNE_TRACE_SCOPE("Averaging::run");
             m_qMutex.lock();
             lResponsibleTriggerTypes = m_lResponsibleTriggerTypes;
             m_qMutex.unlock();
@@ -52,6 +52,7 @@
 #include <disp/viewers/projectsettingsview.h>
 #include <communication/rtClient/rtcmdclient.h>
 #include <scMeas/realtimemultisamplearray.h>
+#include <utils/mnetracer.h>
 
 //=============================================================================================================
 // QT INCLUDES
@@ -263,6 +264,7 @@ void BabyMEG::run()
     while(!isInterruptionRequested()) {
         //pop matrix
         if(m_pCircularBuffer->pop(matValue)) {
+            MNE_TRACE_SCOPE("BabyMEG::run");
             //Create digital trigger information
             createDigTrig(matValue);
 
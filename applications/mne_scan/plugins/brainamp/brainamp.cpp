@@ -47,6 +47,7 @@
 
 #include <fiff/fiff.h>
 #include <scMeas/realtimemultisamplearray.h>
+#include <utils/mnetracer.h>
 
 //=============================================================================================================
 // QT INCLUDES
@@ -376,6 +377,7 @@ void BrainAMP::run()
         if(m_pBrainAMPProducer->isRunning()) {
             //pop matrix
             if(m_pCircularBuffer->pop(matData)) {
+                MNE_TRACE_SCOPE("BrainAMP::run");
                 //emit values to real time multi sample array
                 m_pRMTSA_BrainAMP->measurementData()->setValue(matData);
             }       
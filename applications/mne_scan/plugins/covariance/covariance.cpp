@@ -49,6 +49,7 @@
 
 #include <fiff/fiff_info.h>
 #include <fiff/fiff_cov.h>
+#include <utils/mnetracer.h>
 
 //=============================================================================================================
 // EIGEN INCLUDES
@@ -81,7 +82,7 @@ using namespace Eigen;
 
 Covariance::Covariance()
 : m_iEstimationSamples(2000)
-, m_pCircularBuffer(CircularBuffer_Matrix_double::SPtr::create(40))
+, m_pCircularBuffer(CircularBuffer<MultiSampleFrame::ConstSPtr>::SPtr::create(40))
 {
 }
 
@@ -219,11 +220,9 @@ void Covariance::update(SCMEASLIB::Measurement::SPtr pMeasurement)
             initPluginControlWidgets();
         }
 
-        for(qint32 i = 0; i < pRTMSA->getMultiArraySize(); ++i) {
-            // Please note that we do not need a copy here since this function will block until
-            // the buffer accepts new data again. Hence, the data is not deleted in the actual
-            // Measurement function after it emitted the notify signal.
-            while(!m_pCircularBuffer->push(pRTMSA->getMultiSampleArray()[i])) {
+        // The frames are shared with all other consumers, only the reference is queued
+        for(const MultiSampleFrame::ConstSPtr& pFrame : pRTMSA->getMultiSampleFrames()) {
+            while(!m_pCircularBuffer->push(pFrame)) {
                 //Do nothing until the circular buffer is ready to accept new data again
             }
         }
@@ -252,7 +251,7 @@ void Covariance::run()
         msleep(100);
     }
 
-    MatrixXd matData;
+    MultiSampleFrame::ConstSPtr pFrame;
     FiffCov fiffCov;
     m_mutex.lock();
     int iEstimationSamples = m_iEstimationSamples;
@@ -262,12 +261,13 @@ void Covariance::run()
     // Start processing data
     while(!isInterruptionRequested()) {
         // Get the current data
-        if(m_pCircularBuffer->pop(matData)) {
+        if(m_pCircularBuffer->pop(pFrame) && pFrame) {
+            MNE_TRACE_SCOPE("Covariance::run");
             m_mutex.lock();
             iEstimationSamples = m_iEstimationSamples;
             m_mutex.unlock();
 
-            fiffCov = rtCov.estimateCovariance(matData, iEstimationSamples);
+            fiffCov = rtCov.estimateCovariance(pFrame->data(), iEstimationSamples);
             if(!fiffCov.names.isEmpty()) {
                 m_pCovarianceOutput->measurementData()->setValue(fiffCov);
             }
@@ -44,6 +44,7 @@
 
 #include <scShared/Plugins/abstractalgorithm.h>
 #include <utils/generics/circularbuffer.h>
+#include <scMeas/multisampleframe.h>
 
 //=============================================================================================================
 // EIGEN INCLUDES
@@ -155,7 +156,7 @@ private:
     QMutex      m_mutex;
     qint32      m_iEstimationSamples;
 
-    UTILSLIB::CircularBuffer_Matrix_double::SPtr        m_pCircularBuffer;              /**< Matrix data circular buffer. */
+    UTILSLIB::CircularBuffer<SCMEASLIB::MultiSampleFrame::ConstSPtr>::SPtr m_pCircularBuffer; /**< Data frame circular buffer. */
 
     QSharedPointer<FIFFLIB::FiffInfo>                   m_pFiffInfo;                    /**< Fiff measurement info.*/
 
@@ -40,6 +40,8 @@
 
 #include "dummytoolbox.h"
 
+#include <utils/mnetracer.h>
+
 //=============================================================================================================
 // QT INCLUDES
 //=============================================================================================================
@@ -65,7 +67,7 @@ using namespace Eigen;
 //=============================================================================================================
 
 DummyToolbox::DummyToolbox()
-: m_pCircularBuffer(QSharedPointer<CircularBuffer_Matrix_double>(new CircularBuffer_Matrix_double(40)))
+: m_pCircularBuffer(QSharedPointer<CircularBuffer<MultiSampleFrame::ConstSPtr> >::create(40))
 {
 }
 
@@ -174,11 +176,9 @@ void DummyToolbox::update(SCMEASLIB::Measurement::SPtr pMeasurement)
             initPluginControlWidgets();
         }
 
-        for(unsigned char i = 0; i < pRTMSA->getMultiArraySize(); ++i) {
-            // Please note that we do not need a copy here since this function will block until
-            // the buffer accepts new data again. Hence, the data is not deleted in the actual
-            // Mesaurement function after it emitted the notify signal.
-            while(!m_pCircularBuffer->push(pRTMSA->getMultiSampleArray()[i])) {
+        // The frames are shared with all other consumers, only the reference is queued
+        for(const MultiSampleFrame::ConstSPtr& pFrame : pRTMSA->getMultiSampleFrames()) {
+            while(!m_pCircularBuffer->push(pFrame)) {
                 //Do nothing until the circular buffer is ready to accept new data again
             }
         }
@@ -208,7 +208,7 @@ void DummyToolbox::initPluginControlWidgets()
 
 void DummyToolbox::run()
 {
-    MatrixXd matData;
+    MultiSampleFrame::ConstSPtr pFrame;
 
     // Wait for Fiff Info
     while(!m_pFiffInfo) {
@@ -217,13 +217,15 @@ void DummyToolbox::run()
 
     while(!isInterruptionRequested()) {
         // Get the current data
-        if(m_pCircularBuffer->pop(matData)) {
-            //ToDo: Implement your algorithm here
+        if(m_pCircularBuffer->pop(pFrame) && pFrame) {
+            MNE_TRACE_SCOPE("DummyToolbox::run");
+            //ToDo: Implement your algorithm here. The frame is shared with other consumers, copy pFrame->data()
+            //before changing it and pass the result to setValue(const MatrixXd&).
 
             //Send the data to the connected plugins and the online display
             //Unocmment this if you also uncommented the m_pOutput in the constructor above
             if(!isInterruptionRequested()) {
-                m_pOutput->measurementData()->setValue(matData);
+                m_pOutput->measurementData()->setValue(pFrame);
             }
         }
     }
@@ -142,7 +142,7 @@ private:
 
     QSharedPointer<DummyYourWidget>                 m_pYourWidget;              /**< The widget used to control this plugin by the user.*/
 
-    QSharedPointer<UTILSLIB::CircularBuffer_Matrix_double>       m_pCircularBuffer;          /**< Holds incoming raw data. */
+    QSharedPointer<UTILSLIB::CircularBuffer<SCMEASLIB::MultiSampleFrame::ConstSPtr> > m_pCircularBuffer; /**< Holds incoming raw data frames. */
 
     SCSHAREDLIB::PluginInputData<SCMEASLIB::RealTimeMultiSampleArray>::SPtr      m_pInput;      /**< The incoming data.*/
     SCSHAREDLIB::PluginOutputData<SCMEASLIB::RealTimeMultiSampleArray>::SPtr     m_pOutput;     /**< The outgoing data.*/
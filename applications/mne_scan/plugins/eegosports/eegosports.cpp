@@ -47,6 +47,7 @@
 
 #include <utils/layoutloader.h>
 #include <utils/layoutmaker.h>
+#include <utils/mnetracer.h>
 
 #include <scMeas/realtimemultisamplearray.h>
 
@@ -706,10 +707,12 @@ void EEGoSports::run()
             if(m_bCheckImpedances) {
                 //pop matrix
                 if(m_pCircularBuffer->pop(matData)) {
+                    MNE_TRACE_SCOPE("EEGoSports::run");
                     m_pEEGoSportsImpedanceWidget->updateGraphicScene(matData.col(0));
                 }
             } else {
                 if(m_pCircularBuffer->pop(matData)) {
+                    MNE_TRACE_SCOPE("EEGoSports::run");
                     //emit values to real time multi sample array
                     //qDebug()<<"EEGoSports::run - mat size"<<matValue.rows()<<"x"<<matValue.cols();
                     m_pRMTSA_EEGoSports->measurementData()->setValue(matData);
@@ -45,6 +45,7 @@
 #include <utils/ioutils.h>
 #include <fiff/fiff_info.h>
 #include <scMeas/realtimemultisamplearray.h>
+#include <utils/mnetracer.h>
 
 //=============================================================================================================
 // QT INCLUDES
@@ -55,6 +56,7 @@
 #include <QtCore/QFile>
 #include <QMutexLocker>
 #include <QList>
+#include <QSettings>
 
 #include <QDebug>
 
@@ -79,6 +81,7 @@ FiffSimulator::FiffSimulator()
 , m_bCmdClientIsConnected(false)
 , m_sFiffSimulatorIP("127.0.0.1")
 , m_sFiffSimulatorClientAlias("mne_scan")
+, m_bUseCompressedBuffers(false)
 , m_iActiveConnectorId(0)
 , m_iBufferSize(-1)
 , m_pCircularBuffer(QSharedPointer<CircularBuffer_Matrix_float>(new CircularBuffer_Matrix_float(40)))
@@ -124,6 +127,10 @@ void FiffSimulator::init()
     m_pRTMSA_FiffSimulator->measurementData()->setName(this->getName());//Provide name to auto store widget settings
     m_outputConnectors.append(m_pRTMSA_FiffSimulator);
 
+    // Compressed buffers are quantized to the calibration steps, which is exact for acquired data only
+    QSettings settings("MNECPP");
+    m_bUseCompressedBuffers = settings.value(QString("MNESCAN/%1/compressedBuffers").arg(getName()), false).toBool();
+
     //Try to connect the cmd client on start up using localhost connection
  //   this->connectCmdClient();
 }
@@ -216,6 +223,7 @@ void FiffSimulator::run()
     while(!isInterruptionRequested()) {
         //pop matrix
         if(m_pCircularBuffer->pop(matValue)) {
+            MNE_TRACE_SCOPE("FiffSimulator::run");
             //emit values
             if(!isInterruptionRequested()) {
                 m_pRTMSA_FiffSimulator->measurementData()->setValue(matValue.cast<double>());
@@ -198,6 +198,7 @@ protected:
     bool                    m_bCmdClientIsConnected;        /**< If the command client is connected.*/
     QString                 m_sFiffSimulatorIP;             /**< The IP Adress of mne_rt_server.*/
     QString                 m_sFiffSimulatorClientAlias;    /**< The rt server client alias.*/
+    bool                    m_bUseCompressedBuffers;        /**< Whether the data client requests compressed data buffers from mne_rt_server.*/
 
     qint32                  m_iActiveConnectorId;           /**< The active connector.*/
     qint32                  m_iBufferSize;                  /**< The raw data buffer size.*/
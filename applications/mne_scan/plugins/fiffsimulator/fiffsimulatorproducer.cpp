@@ -40,11 +40,14 @@
 #include "fiffsimulatorproducer.h"
 #include "fiffsimulator.h"
 
+#include <fiff/fiff_constants.h>
+
 //=============================================================================================================
 // QT INCLUDES
 //=============================================================================================================
 
 #include <QMutexLocker>
+#include <QDebug>
 
 //=============================================================================================================
 // EIGEN INCLUDES
@@ -105,6 +108,12 @@ void FiffSimulatorProducer::connectDataClient(QString p_sRtSeverIP)
             // set data client alias -> for convinience (optional)
             m_pRtDataClient->setClientAlias(m_pFiffSimulator->m_sFiffSimulatorClientAlias); // used in option 2 later on
 
+            // request compressed data buffers, servers which do not support them keep sending float buffers
+            if(m_pFiffSimulator->m_bUseCompressedBuffers
+               && !m_pRtDataClient->requestDataEncoding(FIFFV_MNE_RT_ENCODING_COMPRESSED)) {
+                qInfo() << "[FiffSimulatorProducer::connectDataClient] mne_rt_server does not support compressed buffers.";
+            }
+
             // set new state
             m_bDataClientIsConnected = true;
             emit dataConnectionChanged(m_bDataClientIsConnected);
@@ -40,6 +40,8 @@
 #include "ftbuffer.h"
 #include "ftbuffproducer.h"
 
+#include <utils/mnetracer.h>
+
 //=============================================================================================================
 // QT INCLUDES
 //=============================================================================================================
@@ -199,6 +201,7 @@ void FtBuffer::run()
         //qDebug() << "[FtBuffer::run] m_pFiffInfo->dig.size()" << m_pFiffInfo->dig.size();
         //pop matrix
         if(m_pCircularBuffer->pop(matData)) {
+            MNE_TRACE_SCOPE("FtBuffer::run");
             //emit values
             if(!isInterruptionRequested()) {
                 m_pRTMSA_BufferOutput->measurementData()->setValue(matData);
@@ -90,6 +90,7 @@ void FtBuffProducer::runMainLoop()
     qInfo() << "[FtBuffProducer::runMainLoop] Connected to buffer and ready to receive data.";
 
     while(!this->thread()->isInterruptionRequested()) {
+        //Blocks until new samples arrived or the buffer's wait timed out, so interruption requests are still seen
         m_pFtConnector->getData();
 
         //Sends up new data when FtConnector flags new data
@@ -97,8 +98,6 @@ void FtBuffProducer::runMainLoop()
             emit newDataAvailable(m_pFtConnector->getMatrix());
             m_pFtConnector->resetEmitData();
         }
-
-        //QThread::usleep(50);
     }
 
     this->thread()->quit();
@@ -54,6 +54,56 @@
 //=============================================================================================================
 
 using namespace FTBUFFERPLUGIN;
+using namespace Eigen;
+
+//=============================================================================================================
+// DEFINE GLOBAL METHODS
+//=============================================================================================================
+
+namespace {
+    const qint32 WAIT_TIMEOUT_MSEC = 100;       /**< Time the buffer waits for new samples before answering WAIT_DAT. */
+    const int SOCKET_TIMEOUT_MSEC = 5000;       /**< Time to wait for an answer before giving up on the buffer. */
+
+    /**
+     * Returns the size of one sample of the given FieldTrip data type in bytes, or 0 if the type is unknown.
+     */
+    int sampleSize(qint32 iDataType)
+    {
+        switch (iDataType) {
+            case DATATYPE_UINT8:
+            case DATATYPE_INT8:
+                return 1;
+            case DATATYPE_UINT16:
+            case DATATYPE_INT16:
+                return 2;
+            case DATATYPE_UINT32:
+            case DATATYPE_INT32:
+            case DATATYPE_FLOAT32:
+                return 4;
+            case DATATYPE_UINT64:
+            case DATATYPE_INT64:
+            case DATATYPE_FLOAT64:
+                return 8;
+            default:
+                return 0;
+        }
+    }
+
+    /**
+     * Converts interleaved samples (channels vary fastest) of type T to a channels x samples matrix. The sample
+     * layout is the one of a column major matrix, so this is a single vectorized cast.
+     */
+    template<typename T>
+    void castSamples(const char* pData,
+                     int iNumChannels,
+                     int iNumSamples,
+                     MatrixXd& matData)
+    {
+        matData = Map<const Matrix<T, Dynamic, Dynamic> >(reinterpret_cast<const T*>(pData),
+                                                         iNumChannels,
+                                                         iNumSamples).template cast<double>();
+    }
+}
 
 //=============================================================================================================
 // DEFINE MEMBER METHODS
@@ -90,6 +140,8 @@ bool FtConnector::connect()
         m_pSocket = Q_NULLPTR;
     }
 
+    m_qPendingRequests.clear();
+
     m_pSocket = new QTcpSocket();
     m_pSocket->connectToHost(QHostAddress(m_sAddress), m_iPort);
     qint8 iTries = 0;
@@ -120,42 +172,40 @@ bool FtConnector::getHeader()
 {
     qInfo() << "[FtConnector::getHeader] Attempting to get header...";
 
-    m_pSocket->readAll(); //Ensure receiving buffer is empty
+    m_baExtendedHeader.clear();
 
-    // Defining parameters to send a get header message to buffer
-    messagedef_t messagedef;
-    messagedef.bufsize = 0;
-    messagedef.command = GET_HDR;
+    // The answers to pipelined requests arrive first
+    if(!discardPendingResponses()) {
+        return false;
+    }
 
-    // Send request to buffer
-    sendRequest(messagedef);
+    sendRequest(GET_HDR);
 
-    //Waiting for response.
-    while(static_cast<quint64>(m_pSocket->bytesAvailable()) < sizeof (messagedef_t)) {
-        m_pSocket->waitForReadyRead(10);
+    messagedef_t response;
+    if(!readResponse(GET_HDR, response)) {
+        return false;
     }
 
-    //Parse return message from buffer
-    QBuffer msgBuffer;
-    prepBuffer(msgBuffer, sizeof (messagedef_t));
-    int bufsize = parseMessageDef(msgBuffer);
-
-    if (bufsize == 0) {
+    if (response.command != GET_OK || response.bufsize < static_cast<qint32>(sizeof(headerdef_t))) {
         qInfo() << "[FtConnector::getHeader] No header data found";
+        skipBytes(response.bufsize);
         return false;
     }
 
-    //Waiting for response.
-    while(m_pSocket->bytesAvailable() < bufsize) {
-        m_pSocket->waitForReadyRead(10);
+    QByteArray baHeader(sizeof(headerdef_t), 0);
+    m_baExtendedHeader.resize(response.bufsize - sizeof(headerdef_t));
+
+    if(!readExactly(baHeader.data(), baHeader.size()) ||
+       !readExactly(m_baExtendedHeader.data(), m_baExtendedHeader.size())) {
+        m_baExtendedHeader.clear();
+        return false;
     }
 
     //Parse header info from buffer
-    QBuffer hdrBuffer;
-    prepBuffer(hdrBuffer, sizeof (headerdef_t)); // if implementing header chunks: change from sizeof (headerdef) to bufsize
-    parseHeaderDef(hdrBuffer);
+    QBuffer hdrBuffer(&baHeader);
+    hdrBuffer.open(QIODevice::ReadOnly);
 
-    return true;
+    return parseHeaderDef(hdrBuffer);
 }
 
 //=============================================================================================================
@@ -209,7 +259,7 @@ bool FtConnector::parseHeaderDef(QBuffer &readBuffer)
 
     qInfo() << "[FtConnector::parseHeaderDef] Got header parameters.";
 
-    if (m_iDataType != 9) {
+    if (m_iDataType == DATATYPE_CHAR || m_iDataType < 0 || m_iDataType > DATATYPE_FLOAT64) {
         qCritical() << "Data type not supported. Plugin will not behave correctly.";
     }
 
@@ -218,170 +268,306 @@ bool FtConnector::parseHeaderDef(QBuffer &readBuffer)
 
 //=============================================================================================================
 
-int FtConnector::parseMessageDef(QBuffer &readBuffer)
+void FtConnector::sendRequest(qint16 iCommand,
+                              const QByteArray &baPayload)
 {
-    messagedef_t response;
+    messagedef_t messagedef;
+    messagedef.version = VERSION; //we only use VERSION == 1
+    messagedef.command = iCommand;
+    messagedef.bufsize = baPayload.size();
 
-    //Get version, int16
-    char c_version[sizeof(response.version)];
-    readBuffer.read(c_version, sizeof(response.version));
-    std::memcpy(&response.version, c_version, sizeof(response.version));
+    QByteArray baRequest;
+    baRequest.reserve(sizeof(messagedef_t) + baPayload.size());
+    baRequest.append(reinterpret_cast<const char*>(&messagedef.version), sizeof(messagedef.version));
+    baRequest.append(reinterpret_cast<const char*>(&messagedef.command), sizeof(messagedef.command));
+    baRequest.append(reinterpret_cast<const char*>(&messagedef.bufsize), sizeof(messagedef.bufsize));
+    baRequest.append(baPayload);
 
-    //Get command, int16
-    char c_command[sizeof(response.command)];
-    readBuffer.read(c_command, sizeof(response.command));
-    std::memcpy(&response.command, c_command, sizeof(response.command));
+    m_pSocket->write(baRequest);
 
-    //Get bufsize, int32
-    char c_buffsize[sizeof(response.bufsize)];
-    readBuffer.read(c_buffsize, sizeof(response.bufsize));
-    std::memcpy(&response.bufsize, c_buffsize, sizeof(response.bufsize));
+    m_qPendingRequests.enqueue(iCommand);
+}
 
-    return response.bufsize;
+//=============================================================================================================
+
+bool FtConnector::readResponse(qint16 iCommand,
+                               messagedef_t &response)
+{
+    if(m_qPendingRequests.isEmpty() || m_qPendingRequests.head() != iCommand) {
+        qWarning() << "[FtConnector::readResponse] Expected answer to request" << iCommand << "is not the next one.";
+        resetConnection();
+        return false;
+    }
+
+    if(!readExactly(reinterpret_cast<char*>(&response.version), sizeof(response.version)) ||
+       !readExactly(reinterpret_cast<char*>(&response.command), sizeof(response.command)) ||
+       !readExactly(reinterpret_cast<char*>(&response.bufsize), sizeof(response.bufsize))) {
+        return false;
+    }
+
+    m_qPendingRequests.dequeue();
+
+    if(response.bufsize < 0) {
+        qWarning() << "[FtConnector::readResponse] Invalid answer size" << response.bufsize;
+        resetConnection();
+        return false;
+    }
+
+    return true;
 }
 
 //=============================================================================================================
 
-void FtConnector::sendRequest(messagedef_t &messagedef)
+bool FtConnector::discardPendingResponses()
 {
-    messagedef.version = VERSION; //we only use VERSION == 1
+    while(!m_qPendingRequests.isEmpty()) {
+        messagedef_t response;
+
+        if(!readResponse(m_qPendingRequests.head(), response) || !skipBytes(response.bufsize)) {
+            return false;
+        }
+    }
 
-    m_pSocket->write(reinterpret_cast<char*>(&messagedef.version), sizeof(messagedef.version));
-    m_pSocket->write(reinterpret_cast<char*>(&messagedef.command), sizeof(messagedef.command));
-    m_pSocket->write(reinterpret_cast<char*>(&messagedef.bufsize), sizeof(messagedef.bufsize));
+    return true;
 }
 
 //=============================================================================================================
 
 bool FtConnector::getData()
 {
-    m_iNumNewSamples = totalBuffSamples();
+    // Only the WAIT_DAT queued by the last call may be pending, anything else is dropped
+    if(m_qPendingRequests.size() != 1 || m_qPendingRequests.head() != WAIT_DAT) {
+        if(!discardPendingResponses()) {
+            return false;
+        }
+
+        sendWaitRequest(m_iNumSamples, WAIT_TIMEOUT_MSEC);
+    }
+
+    // Blocks until the buffer has new samples or the wait timed out
+    qint32 iNumSamples;
+    if(!readWaitResponse(iNumSamples)) {
+        return false;
+    }
+
+    m_iNumNewSamples = iNumSamples;
+
+    if (m_iNumNewSamples < m_iNumSamples) {
+        qWarning() << "[FtConnector::getData] Buffer was reset. Continuing from sample" << m_iNumNewSamples;
+        m_iNumSamples = m_iNumNewSamples;
+    }
 
     if (m_iNumNewSamples == m_iNumSamples) {
         // no new unread data in buffer
         return false;
     }
 
-    m_pSocket->readAll(); //Ensure receiving buffer is empty
+    // Request the new samples and already queue the wait for the next block, so the buffer waits while we decode
+    sendDataRequest(m_iNumSamples, m_iNumNewSamples - 1);
+    sendWaitRequest(m_iNumNewSamples, WAIT_TIMEOUT_MSEC);
 
-    // Get data message + data selection params
-    messagedef_t messagedef;
-    messagedef.bufsize = sizeof (datasel_t);
-    messagedef.command = GET_DAT;
+    if(!readDataResponse()) {
+        return false;
+    }
 
-    datasel_t datasel;
-    datasel.begsample = m_iNumSamples;
-    datasel.endsample = m_iNumNewSamples - 1;
+    //update sample tracking
+    m_iNumSamples = m_iNumNewSamples;
+
+    return m_bNewData;
+}
+
+//=============================================================================================================
+
+void FtConnector::sendWaitRequest(qint32 iNumSamples,
+                                  qint32 iTimeoutMsec)
+{
+    //Set threshold to return more than number samples read, ignore events.
+    waitdef_t waitdef;
+    waitdef.threshold.nsamples = iNumSamples;
+    waitdef.threshold.nevents = static_cast<qint32>(0xFFFFFFFF);
+    waitdef.milliseconds = iTimeoutMsec;
+
+    QByteArray baPayload;
+    baPayload.reserve(sizeof(waitdef_t));
+    baPayload.append(reinterpret_cast<const char*>(&waitdef.threshold.nsamples), sizeof(waitdef.threshold.nsamples));
+    baPayload.append(reinterpret_cast<const char*>(&waitdef.threshold.nevents), sizeof(waitdef.threshold.nevents));
+    baPayload.append(reinterpret_cast<const char*>(&waitdef.milliseconds), sizeof(waitdef.milliseconds));
+
+    sendRequest(WAIT_DAT, baPayload);
+    m_pSocket->flush();
+}
+
+//=============================================================================================================
 
-    sendRequest(messagedef);
-    sendDataSel(datasel);
+bool FtConnector::readWaitResponse(qint32 &iNumSamples)
+{
+    messagedef_t response;
+    samples_events_t samplesEvents;
 
-    //Waiting for response.
-    while(static_cast<unsigned long>(m_pSocket->bytesAvailable()) < sizeof (messagedef_t)) {
-        m_pSocket->waitForReadyRead(10);
+    if(!readResponse(WAIT_DAT, response)) {
+        return false;
     }
 
-    //Parse return message from buffer
-    QBuffer msgBuffer;
-    prepBuffer(msgBuffer, sizeof (messagedef_t));
-    int bufsize = parseMessageDef(msgBuffer);
+    if(response.command != WAIT_OK || response.bufsize != sizeof(samples_events_t)) {
+        qWarning() << "[FtConnector::readWaitResponse] Buffer did not accept WAIT_DAT request.";
+        skipBytes(response.bufsize);
+        return false;
+    }
 
-    //Waiting for response.
-    while(m_pSocket->bytesAvailable() < bufsize) {
-        m_pSocket->waitForReadyRead(10);
+    if(!readExactly(reinterpret_cast<char*>(&samplesEvents.nsamples), sizeof(samplesEvents.nsamples)) ||
+       !readExactly(reinterpret_cast<char*>(&samplesEvents.nevents), sizeof(samplesEvents.nevents))) {
+        return false;
     }
 
-    //Parse return data def from buffer
-    QBuffer datadefBuffer;
-    prepBuffer(datadefBuffer, sizeof (datadef_t));
-    bufsize = parseDataDef(datadefBuffer);
+    iNumSamples = samplesEvents.nsamples;
+
+    return true;
+}
 
-    //Parse actual data from buffer
-    QBuffer datasampBuffer;
-    prepBuffer(datasampBuffer, bufsize);
-    parseData(datasampBuffer, bufsize);
+//=============================================================================================================
 
-    //update sample tracking
-    m_iNumSamples = m_iNumNewSamples;
+void FtConnector::sendDataRequest(qint32 iBegSample,
+                                  qint32 iEndSample)
+{
+    datasel_t datasel;
+    datasel.begsample = iBegSample;
+    datasel.endsample = iEndSample;
 
-    //echoStatus();
+    QByteArray baPayload;
+    baPayload.reserve(sizeof(datasel_t));
+    baPayload.append(reinterpret_cast<const char*>(&datasel.begsample), sizeof(datasel.begsample));
+    baPayload.append(reinterpret_cast<const char*>(&datasel.endsample), sizeof(datasel.endsample));
 
-    return true;
+    sendRequest(GET_DAT, baPayload);
 }
 
 //=============================================================================================================
 
-bool FtConnector::setAddr(const QString &sNewAddress)
+bool FtConnector::readDataResponse()
 {
-    m_sAddress.clear();
-    m_sAddress.append(sNewAddress);
+    messagedef_t response;
+    datadef_t datadef;
 
-    return true;
+    if(!readResponse(GET_DAT, response)) {
+        return false;
+    }
+
+    if(response.command != GET_OK || response.bufsize < static_cast<qint32>(sizeof(datadef_t))) {
+        qWarning() << "[FtConnector::readDataResponse] Buffer did not accept GET_DAT request.";
+        skipBytes(response.bufsize);
+        return false;
+    }
+
+    if(!readExactly(reinterpret_cast<char*>(&datadef.nchans), sizeof(datadef.nchans)) ||
+       !readExactly(reinterpret_cast<char*>(&datadef.nsamples), sizeof(datadef.nsamples)) ||
+       !readExactly(reinterpret_cast<char*>(&datadef.data_type), sizeof(datadef.data_type)) ||
+       !readExactly(reinterpret_cast<char*>(&datadef.bufsize), sizeof(datadef.bufsize))) {
+        return false;
+    }
+
+    if(datadef.nchans < 0 || datadef.nsamples < 0 ||
+       datadef.bufsize != response.bufsize - static_cast<qint32>(sizeof(datadef_t)) ||
+       datadef.bufsize < static_cast<qint64>(datadef.nchans) * datadef.nsamples * sampleSize(datadef.data_type)) {
+        qWarning() << "[FtConnector::readDataResponse] Inconsistent data definition.";
+        skipBytes(response.bufsize - sizeof(datadef_t));
+        return false;
+    }
+
+    // Reuse the receive buffer, it only grows
+    if(m_baDataBuffer.size() < datadef.bufsize) {
+        m_baDataBuffer.resize(datadef.bufsize);
+    }
+
+    if(!readExactly(m_baDataBuffer.data(), datadef.bufsize)) {
+        return false;
+    }
+
+    m_iMsgSamples = datadef.nsamples;
+
+    return parseData(datadef.data_type, datadef.nchans, datadef.nsamples);
 }
 
 //=============================================================================================================
 
-bool FtConnector::setPort(const int &iPort)
+bool FtConnector::readExactly(char* pData,
+                              qint64 iNumBytes)
 {
-    m_iPort = iPort;
+    while(m_pSocket->bytesAvailable() < iNumBytes) {
+        if(!m_pSocket->waitForReadyRead(SOCKET_TIMEOUT_MSEC)) {
+            qWarning() << "[FtConnector::readExactly] No answer from buffer:" << m_pSocket->errorString();
+            resetConnection();
+            return false;
+        }
+    }
+
+    if(m_pSocket->read(pData, iNumBytes) != iNumBytes) {
+        resetConnection();
+        return false;
+    }
 
     return true;
 }
 
 //=============================================================================================================
 
-void FtConnector::prepBuffer(QBuffer &buffer,
-                             int numBytes)
+bool FtConnector::skipBytes(qint64 iNumBytes)
 {
-    buffer.open(QIODevice::ReadWrite);
-    buffer.write(m_pSocket->read(numBytes));
-    buffer.reset(); //Start reading from beggining of buffer
+    QByteArray baSkip(static_cast<int>(qMin<qint64>(iNumBytes, 65536)), 0);
+
+    while(iNumBytes > 0) {
+        const qint64 iChunk = qMin<qint64>(iNumBytes, baSkip.size());
+
+        if(!readExactly(baSkip.data(), iChunk)) {
+            return false;
+        }
+
+        iNumBytes -= iChunk;
+    }
+
+    return true;
 }
 
 //=============================================================================================================
 
-int FtConnector::parseDataDef(QBuffer &dataBuffer)
+void FtConnector::resetConnection()
 {
-    datadef_t datadef;
+    qWarning() << "[FtConnector::resetConnection] Lost track of the buffer answers. Reconnecting...";
 
-    //Get nchans, int32
-    char c_chans[sizeof(datadef.nchans)];
-    dataBuffer.read(c_chans, sizeof(datadef.nchans));
-    std::memcpy(&datadef.nchans, c_chans, sizeof(datadef.nchans));
+    m_qPendingRequests.clear();
 
-    //Get nsamples, int32
-    char c_nsamples[sizeof(datadef.nsamples)];
-    dataBuffer.read(c_nsamples, sizeof(datadef.nsamples));
-    std::memcpy(&datadef.nsamples, c_nsamples, sizeof(datadef.nsamples));
+    if(m_pSocket == Q_NULLPTR) {
+        return;
+    }
 
-    //Get data_type, int32
-    char c_datatype[sizeof(datadef.data_type)];
-    dataBuffer.read(c_datatype, sizeof(datadef.data_type));
-    std::memcpy(&datadef.data_type, c_datatype, sizeof(datadef.data_type));
+    // Answers still in flight belong to the old connection and are dropped with it
+    m_pSocket->abort();
+    m_pSocket->connectToHost(QHostAddress(m_sAddress), m_iPort);
 
-    //Get bufsize, int32
-    char c_bufsize[sizeof(datadef.bufsize)];
-    dataBuffer.read(c_bufsize, sizeof(datadef.bufsize));
-    std::memcpy(&datadef.bufsize, c_bufsize, sizeof(datadef.bufsize));
+    if(!m_pSocket->waitForConnected(SOCKET_TIMEOUT_MSEC)) {
+        qWarning() << "[FtConnector::resetConnection] Failed to reconnect:" << m_pSocket->errorString();
+    }
+}
 
-//    if(datadef.nchans != m_iNumChannels) {
-//        qWarning() << "Data has different number of channels than expected.";
-//        return false;
-//    }
+//=============================================================================================================
 
-    m_iMsgSamples = datadef.nsamples;
+bool FtConnector::setAddr(const QString &sNewAddress)
+{
+    m_sAddress.clear();
+    m_sAddress.append(sNewAddress);
 
-    return datadef.bufsize;
+    return true;
 }
 
 //=============================================================================================================
 
-void FtConnector::sendDataSel(datasel_t &datasel)
+bool FtConnector::setPort(const int &iPort)
 {
-    m_pSocket->write(reinterpret_cast<char*>(&datasel.begsample), sizeof(datasel.begsample));
-    m_pSocket->write(reinterpret_cast<char*>(&datasel.endsample), sizeof(datasel.endsample));
+    m_iPort = iPort;
+
+    return true;
 }
 
+
 //=============================================================================================================
 
 void FtConnector::echoStatus()
@@ -401,96 +587,69 @@ void FtConnector::echoStatus()
 
 int FtConnector::totalBuffSamples()
 {
-    m_pSocket->readAll(); //Ensure receiving buffer is empty
-
-    messagedef_t messagedef;
-    messagedef.bufsize = sizeof(samples_events_t) + sizeof (qint32);
-    messagedef.command = WAIT_DAT;
-
-    //Set threshold to return more than number samples read.
-    samples_events_t threshold;
-    threshold.nsamples = m_iNumSamples;
-    threshold.nevents = static_cast<qint32>(0xFFFFFFFF);
+    qint32 iNumSamp = m_iNumSamples;
 
-    // timeout for waiting in milliseconds
-    qint32 timeout = 20;
-
-    sendRequest(messagedef);
-    sendSampleEvents(threshold);
-    m_pSocket->write(reinterpret_cast<char*>(&timeout), sizeof (qint32));
-
-    //Waiting for response.
-    while(static_cast<quint64>(m_pSocket->bytesAvailable()) < sizeof (messagedef_t)) {
-        m_pSocket->waitForReadyRead(10);
+    // Drop the answers of pipelined requests first
+    if(!discardPendingResponses()) {
+        return m_iNumSamples;
     }
 
-    //Parse return message from buffer
-    QBuffer msgBuffer;
-    prepBuffer(msgBuffer, sizeof (messagedef_t));
-    parseMessageDef(msgBuffer);
+    // A zero timeout makes the buffer answer immediately
+    sendWaitRequest(0, 0);
 
-    //Waiting for response.
-    while(static_cast<quint64>(m_pSocket->bytesAvailable()) < sizeof (samples_events_t)) {
-        m_pSocket->waitForReadyRead(10);
+    if(!readWaitResponse(iNumSamp)) {
+        return m_iNumSamples;
     }
 
-    qint32 iNumSamp;
-
-    QBuffer sampeventsBuffer;
-    prepBuffer(sampeventsBuffer, sizeof(samples_events_t));
-
-    char cSamps[sizeof(iNumSamp)];
-    sampeventsBuffer.read(cSamps, sizeof(iNumSamp));
-    std::memcpy(&iNumSamp, cSamps, sizeof(iNumSamp));
-
     return iNumSamp;
 }
 
 //=============================================================================================================
 
-void FtConnector::sendSampleEvents(samples_events_t &threshold)
+bool FtConnector::parseData(qint32 iDataType,
+                            int iNumChannels,
+                            int iNumSamples)
 {
-    m_pSocket->write(reinterpret_cast<char*>(&threshold.nsamples), sizeof(threshold.nsamples));
-    m_pSocket->write(reinterpret_cast<char*>(&threshold.nevents), sizeof(threshold.nevents));
-}
-
-//=============================================================================================================
+    const char* pData = m_baDataBuffer.constData();
 
-bool FtConnector::parseData(QBuffer &datasampBuffer,
-                            int bufsize)
-{
-    Q_UNUSED(bufsize)
-    //start interpreting data as float instead of char
-    QByteArray dataArray = datasampBuffer.readAll();
-    float* fdata = reinterpret_cast<float*> (dataArray.data());
-
-//TODO: Implement receiving other types of data
-//    switch (m_iDataType) {
-//        case DATATYPE_FLOAT32:
-//            auto data = reinterpret_cast<float*>(dataArray.data(), bufsize);
-//            qDebug() << "*** Would you look at that, we're all the way here ***";
-//            qDebug() << "Data sample:";
-
-//            for (int i = 0; i < 10 ; i++) {
-//                qDebug() << data[i];
-//            }
-//            break;
-//    }
-
-    //format data into eigen matrix to pass up
-    Eigen::MatrixXf matData;
-    matData.resize(m_iNumChannels, m_iMsgSamples);
-
-    int count = 0;
-    for (int i = 0; i < int (m_iMsgSamples); i++) {
-        for (int j = 0; j < int (m_iNumChannels); j++) {
-            matData(j,i) = fdata[count];
-            count++;
-        }
+    //format data into eigen matrix to pass up, m_matEmit only reallocates if the block size changes
+    switch (iDataType) {
+        case DATATYPE_UINT8:
+            castSamples<quint8>(pData, iNumChannels, iNumSamples, m_matEmit);
+            break;
+        case DATATYPE_UINT16:
+            castSamples<quint16>(pData, iNumChannels, iNumSamples, m_matEmit);
+            break;
+        case DATATYPE_UINT32:
+            castSamples<quint32>(pData, iNumChannels, iNumSamples, m_matEmit);
+            break;
+        case DATATYPE_UINT64:
+            castSamples<quint64>(pData, iNumChannels, iNumSamples, m_matEmit);
+            break;
+        case DATATYPE_INT8:
+            castSamples<qint8>(pData, iNumChannels, iNumSamples, m_matEmit);
+            break;
+        case DATATYPE_INT16:
+            castSamples<qint16>(pData, iNumChannels, iNumSamples, m_matEmit);
+            break;
+        case DATATYPE_INT32:
+            castSamples<qint32>(pData, iNumChannels, iNumSamples, m_matEmit);
+            break;
+        case DATATYPE_INT64:
+            castSamples<qint64>(pData, iNumChannels, iNumSamples, m_matEmit);
+            break;
+        case DATATYPE_FLOAT32:
+            castSamples<float>(pData, iNumChannels, iNumSamples, m_matEmit);
+            break;
+        case DATATYPE_FLOAT64:
+            castSamples<double>(pData, iNumChannels, iNumSamples, m_matEmit);
+            break;
+        default:
+            qWarning() << "[FtConnector::parseData] Data type" << iDataType << "not supported.";
+            return false;
     }
 
-    //store and flag new data
-    m_pMatEmit = new Eigen::MatrixXd(matData.cast<double>());
+    //flag new data
     m_bNewData = true;
 
     return m_bNewData;
@@ -501,8 +660,6 @@ bool FtConnector::parseData(QBuffer &datasampBuffer,
 void FtConnector::resetEmitData()
 {
     m_bNewData = false;
-    delete m_pMatEmit;
-    m_pMatEmit = Q_NULLPTR;
 }
 
 //=============================================================================================================
@@ -517,9 +674,9 @@ bool FtConnector::disconnect()
 
 //=============================================================================================================
 
-Eigen::MatrixXd FtConnector::getMatrix()
+const Eigen::MatrixXd& FtConnector::getMatrix()
 {
-    return *m_pMatEmit;
+    return m_matEmit;
 }
 
 //=============================================================================================================
@@ -547,13 +704,14 @@ FIFFLIB::FiffInfo FtConnector::parseExtenedHeaders()
 
     getHeader();
 
-    prepBuffer(chunkBuffer, m_iExtendedHeaderSize);
+    chunkBuffer.setData(m_baExtendedHeader);
+    chunkBuffer.open(QIODevice::ReadOnly);
 
     int iRead = 0;
 
     std::cout << "Parsing extended header\n";
 
-    while(iRead < m_iExtendedHeaderSize) {
+    while(iRead < m_baExtendedHeader.size()) {
         qint32 iType;
         char cType[sizeof(qint32)];
         chunkBuffer.read(cType, sizeof(qint32));
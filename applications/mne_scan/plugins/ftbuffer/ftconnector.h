@@ -58,6 +58,7 @@
 #include <QBuffer>
 #include <QThread>
 #include <QFile>
+#include <QQueue>
 
 //=============================================================================================================
 // EIGEN INCLUDES
@@ -98,6 +99,18 @@ namespace FTBUFFERPLUGIN
 #define PUT_DAT_NORESPONSE static_cast<qint16>(0x0502) /* decimal 1282 */
 #define PUT_EVT_NORESPONSE static_cast<qint16>(0x0503) /* decimal 1283 */
 
+#define DATATYPE_CHAR      static_cast<qint32>(0)
+#define DATATYPE_UINT8     static_cast<qint32>(1)
+#define DATATYPE_UINT16    static_cast<qint32>(2)
+#define DATATYPE_UINT32    static_cast<qint32>(3)
+#define DATATYPE_UINT64    static_cast<qint32>(4)
+#define DATATYPE_INT8      static_cast<qint32>(5)
+#define DATATYPE_INT16     static_cast<qint32>(6)
+#define DATATYPE_INT32     static_cast<qint32>(7)
+#define DATATYPE_INT64     static_cast<qint32>(8)
+#define DATATYPE_FLOAT32   static_cast<qint32>(9)
+#define DATATYPE_FLOAT64   static_cast<qint32>(10)
+
 //=============================================================================================================
 // STRUCT DEFINITIONS
 //=============================================================================================================
@@ -139,6 +152,11 @@ typedef struct {
     qint32 nevents;
 } samples_events_t;
 
+typedef struct {
+    samples_events_t threshold;
+    qint32 milliseconds;
+} waitdef_t;
+
 struct BufferInfo{
     int     iNumSamples;                          /**< Number of samples we've read from the buffer. */
     int     iNumNewSamples;                       /**< Number of total samples (read and unread) in the buffer. */
@@ -188,7 +206,9 @@ public:
 
     //=========================================================================================================
     /**
-     * Requests and receives header data from buffer, saves relevant parameters internally.
+     * Requests and receives header data from buffer, saves relevant parameters internally. Answers to requests
+     * which are still pending, e.g. the WAIT_DAT queued by getData, are read and dropped first, so the answer
+     * read is the one to GET_HDR. The extended header chunks are kept in m_baExtendedHeader.
      *
      * @return true if successful, false if unsuccessful.
      */
@@ -196,9 +216,11 @@ public:
 
     //=========================================================================================================
     /**
-     * equests and receives data from buffer, parses it, and stores it in m_pMatEmit
+     * Blocks until the buffer holds unread samples (WAIT_DAT) or the wait times out, then receives the new samples
+     * and stores them in m_matEmit. The GET_DAT request is sent together with the WAIT_DAT request for the
+     * following block, so the buffer is already waiting for new samples while the current block is decoded.
      *
-     * @return true if successful, false if unsuccessful.
+     * @return true if new data was received, false otherwise.
      */
     bool getData();
 
@@ -246,11 +268,11 @@ public:
 
     //=========================================================================================================
     /**
-     * Returns member m_pMatEmit, newest buffer data formatted as an Eigen MatrixXd
+     * Returns member m_matEmit, newest buffer data formatted as an Eigen MatrixXd
      *
-     * @return returns m_pMatEmit.
+     * @return returns m_matEmit.
      */
-    Eigen::MatrixXd getMatrix();
+    const Eigen::MatrixXd& getMatrix();
 
     //=========================================================================================================
     /**
@@ -262,7 +284,7 @@ public:
 
     //=========================================================================================================
     /**
-     * Sets m_bNewData to false, deletes m_pMatEmit
+     * Sets m_bNewData to false. m_matEmit keeps its memory for the next block.
      */
     void resetEmitData();
 
@@ -285,79 +307,127 @@ public:
 private:
     //=========================================================================================================
     /**
-     * Sends a formated message to the buffer. command and bufsize must be set before calling.
+     * Writes a request to the socket and queues its command in m_qPendingRequests until its answer is read.
      *
-     * @param[in] messagedef    request structure with the appropriate command and bufszie paramters set.
+     * @param[in] iCommand      The request command, e.g. GET_HDR.
+     * @param[in] baPayload     The request body following the message definition.
      */
-    void sendRequest(messagedef_t &messagedef);
+    void sendRequest(qint16 iCommand,
+                     const QByteArray &baPayload = QByteArray());
 
     //=========================================================================================================
     /**
-     * Sends a formated datasel message, for defining the first and last sample we are requesting from the buffer
+     * Reads the message definition of the answer to the oldest pending request. The buffer answers in request
+     * order, so the connection is reset if the oldest pending request is not iCommand.
+     *
+     * @param[in] iCommand      The request the caller expects the answer to.
+     * @param[out] response     The message definition of the answer.
      *
-     * @param[in] datasel   Formattd first and last sample index we are requesting from the buffer.
+     * @return true if successful, false if unsuccessful.
      */
-    void sendDataSel(datasel_t &datasel);
+    bool readResponse(qint16 iCommand,
+                      messagedef_t &response);
 
     //=========================================================================================================
     /**
-     * Sends a formated sampleevents message, used for receving updated sample an event numbers from buffer
+     * Reads and drops the answers to all pending requests.
      *
-     * @param[in] threshold     Buffer will respond once sample/event numbers reach the thresholds.
+     * @return true if successful, false if the connection had to be reset.
      */
-    void sendSampleEvents(samples_events_t &threshold);
+    bool discardPendingResponses();
 
     //=========================================================================================================
     /**
-     * Parses headerdef message and saves parameters(channels, frequency, datatype, newsamples)
+     * Sends a WAIT_DAT request. The buffer answers once it holds more than iNumSamples samples or after
+     * iTimeoutMsec milliseconds.
      *
-     * @param[in] readBuffer    QBuffer with return headerdef_t data from buffer.
+     * @param[in] iNumSamples   The sample threshold.
+     * @param[in] iTimeoutMsec  The time the buffer waits at most.
+     */
+    void sendWaitRequest(qint32 iNumSamples,
+                         qint32 iTimeoutMsec);
+
+    //=========================================================================================================
+    /**
+     * Reads the answer to a pending WAIT_DAT request.
+     *
+     * @param[out] iNumSamples  The total number of samples in the buffer.
      *
      * @return true if successful, false if unsuccessful.
      */
-    bool parseHeaderDef(QBuffer &readBuffer);
+    bool readWaitResponse(qint32 &iNumSamples);
 
     //=========================================================================================================
     /**
-     * Parses messadef and returns bufsize
+     * Sends a GET_DAT request for the samples [iBegSample, iEndSample].
      *
-     * @param[in] readBuffer    QBuffer with return messagedef_t data from buffer.
+     * @param[in] iBegSample    The first sample.
+     * @param[in] iEndSample    The last sample.
+     */
+    void sendDataRequest(qint32 iBegSample,
+                         qint32 iEndSample);
+
+    //=========================================================================================================
+    /**
+     * Reads the answer to a GET_DAT request and decodes the samples into m_matEmit.
      *
-     * @return returns messagedef_t.bufsize.
+     * @return true if successful, false if unsuccessful.
      */
-    int parseMessageDef(QBuffer &readBuffer);
+    bool readDataResponse();
 
     //=========================================================================================================
     /**
-     * Parses datadef and returns bufsize
+     * Blocks until iNumBytes bytes could be read from the socket. If the socket times out or was closed, the
+     * position in the answer stream is lost and the connection is reset.
      *
-     * @param[in] dataBuffer    QBuffer with return datadef_t data from buffer.
+     * @param[out] pData        Destination of the bytes.
+     * @param[in] iNumBytes     How many bytes to read from socket.
      *
-     * @return returns datadef_t.bufsize.
+     * @return true if successful, false if the socket timed out or was closed.
      */
-    int parseDataDef(QBuffer &dataBuffer);
+    bool readExactly(char* pData,
+                     qint64 iNumBytes);
 
     //=========================================================================================================
     /**
-     * Parses sample data received from buffer, formates it and saves it to m_pMatEmit;
+     * Reads and drops the remaining iNumBytes bytes of an answer, e.g. the body of an error answer.
      *
-     * @param[in] datasampBuffer    QBuffer with return data from buffer.
-     * @param[in] bufsize           Buffer size of sample data.
+     * @param[in] iNumBytes     How many bytes to drop.
+     *
+     * @return true if successful, false if the socket timed out or was closed.
+     */
+    bool skipBytes(qint64 iNumBytes);
+
+    //=========================================================================================================
+    /**
+     * Drops the connection together with all pending requests and connects again, so that the next answer read
+     * belongs to the next request sent.
+     */
+    void resetConnection();
+
+    //=========================================================================================================
+    /**
+     * Parses headerdef message and saves parameters(channels, frequency, datatype, newsamples)
+     *
+     * @param[in] readBuffer    QBuffer with return headerdef_t data from buffer.
      *
      * @return true if successful, false if unsuccessful.
      */
-    bool parseData(QBuffer &datasampBuffer,
-                   int bufsize);
+    bool parseHeaderDef(QBuffer &readBuffer);
 
     //=========================================================================================================
     /**
-     * @brief Opens Buffer, reads numBytes from socket and sets index to zero
+     * Converts the samples in m_baDataBuffer (channels vary fastest) to m_matEmit.
+     *
+     * @param[in] iDataType     The FieldTrip data type of the samples.
+     * @param[in] iNumChannels  The number of channels.
+     * @param[in] iNumSamples   The number of samples.
      *
-     * @param[out] buffer       QBuffer to which daa will be written.
-     * @param[in] numBytes      How many bytes to read from socket.
+     * @return true if successful, false if the data type is not supported.
      */
-    void prepBuffer(QBuffer &buffer,
-                    int numBytes);
+    bool parseData(qint32 iDataType,
+                   int iNumChannels,
+                   int iNumSamples);
 
     //=========================================================================================================
     /**
@@ -385,7 +455,12 @@ private:
 
     QTcpSocket*                             m_pSocket;                              /**< Socket that manages the connection to the ft buffer. */
 
-    Eigen::MatrixXd*                        m_pMatEmit;                             /**< Container to format data to tansmit to FtBuffProducer. */
+    QByteArray                              m_baDataBuffer;                         /**< Receive buffer for sample data, reused between blocks. */
+    QByteArray                              m_baExtendedHeader;                     /**< Extended header chunks of the last GET_HDR answer. */
+
+    QQueue<qint16>                          m_qPendingRequests;                     /**< Commands of the sent requests whose answers were not read yet, in send order. */
+
+    Eigen::MatrixXd                         m_matEmit;                              /**< Container to format data to tansmit to FtBuffProducer. */
 };
 
 }//namespace end bracket
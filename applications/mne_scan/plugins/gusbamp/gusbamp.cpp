@@ -41,6 +41,7 @@
 #include "gusbamp.h"
 #include "gusbampproducer.h"   
 #include <fiff/fiff_ch_info.h>
+#include <utils/mnetracer.h>
 
 //=============================================================================================================
 // QT INCLUDES
@@ -276,6 +277,7 @@ void GUSBAmp::run()
         if(m_pGUSBAmpProducer->isRunning()) {
             //pop matrix
             if(m_pCircularBuffer->pop(matValue)) {
+                MNE_TRACE_SCOPE("GUSBAmp::run");
                 for(int i = 0; i < matValue.cols(); i++) {
                     qDebug() << matValue(0,i);
                 }
@@ -47,6 +47,7 @@
 #include <scMeas/realtimemultisamplearray.h>
 #include <scMeas/realtimehpiresult.h>
 #include <inverse/hpiFit/hpifit.h>
+#include <utils/mnetracer.h>
 
 //=============================================================================================================
 // QT INCLUDES
@@ -80,7 +81,7 @@ Hpi::Hpi()
 , m_bDoContinousHpi(false)
 , m_bUseSSP(false)
 , m_bUseComp(false)
-, m_pCircularBuffer(CircularBuffer_Matrix_double::SPtr::create(40))
+, m_pCircularBuffer(CircularBuffer<MultiSampleFrame::ConstSPtr>::SPtr::create(40))
 {
     connect(this, &Hpi::devHeadTransAvailable,
             this, &Hpi::onDevHeadTransAvailable, Qt::BlockingQueuedConnection);
@@ -188,8 +189,10 @@ void Hpi::update(SCMEASLIB::Measurement::SPtr pMeasurement)
             initPluginControlWidgets();
         }
 
+        const QList<MultiSampleFrame::ConstSPtr> lFrames = pRTMSA->getMultiSampleFrames();
+
         // Check if data is present
-        if(pRTMSA->getMultiSampleArray().size() > 0) {
+        if(!lFrames.isEmpty()) {
             //If bad channels changed, recalcluate projectors
             updateProjections();
 
@@ -199,17 +202,15 @@ void Hpi::update(SCMEASLIB::Measurement::SPtr pMeasurement)
             m_mutex.unlock();
 
             if(bDoFreqOrder || bDoSingleHpi) {
-                while(!m_pCircularBuffer->push(pRTMSA->getMultiSampleArray()[0])) {
+                while(!m_pCircularBuffer->push(lFrames.first())) {
                     //Do nothing until the circular buffer is ready to accept new data again
                 }
             }
 
             if(m_bDoContinousHpi) {
-                for(unsigned char i = 0; i < pRTMSA->getMultiSampleArray().size(); ++i) {
-                    // Please note that we do not need a copy here since this function will block until
-                    // the buffer accepts new data again. Hence, the data is not deleted in the actual
-                    // Measurement function after it emitted the notify signal.
-                    while(!m_pCircularBuffer->push(pRTMSA->getMultiSampleArray()[i])) {
+                // The frames are shared with all other consumers, only the reference is queued
+                for(const MultiSampleFrame::ConstSPtr& pFrame : lFrames) {
+                    while(!m_pCircularBuffer->push(pFrame)) {
                         //Do nothing until the circular buffer is ready to accept new data again
                     }
                 }
@@ -486,7 +487,7 @@ void Hpi::run()
     double dRotation = 0.0;
 
     int iDataIndexCounter = 0;
-    MatrixXd matData;
+    MultiSampleFrame::ConstSPtr pFrame;
 
     m_mutex.lock();
     int iNumberOfFitsPerSecond = m_iNumberOfFitsPerSecond;
@@ -502,8 +503,11 @@ void Hpi::run()
         }
         m_mutex.unlock();
 
-        //pop matrix
-        if(m_pCircularBuffer->pop(matData)) {
+        //pop frame
+        if(m_pCircularBuffer->pop(pFrame) && pFrame) {
+            MNE_TRACE_SCOPE("Hpi::run");
+            const MatrixXd& matData = pFrame->data();
+
             if(iDataIndexCounter + matData.cols() < matDataMerged.cols()) {
                 matDataMerged.block(0, iDataIndexCounter, matData.rows(), matData.cols()) = matData;
                 iDataIndexCounter += matData.cols();
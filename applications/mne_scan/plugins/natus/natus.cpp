@@ -42,6 +42,7 @@
 
 #include <fiff/fiff.h>
 #include <scMeas/realtimemultisamplearray.h>
+#include <utils/mnetracer.h>
 
 //=============================================================================================================
 // QT INCLUDES
@@ -301,6 +302,7 @@ void Natus::run()
 
     while(!isInterruptionRequested()) {
         if(m_pCircularBuffer->pop(matData)) {
+            MNE_TRACE_SCOPE("Natus::run");
             //emit values
             if(!isInterruptionRequested()) {
                 m_pRMTSA_Natus->measurementData()->setValue(matData);
@@ -55,6 +55,7 @@
 #include <mne/mne_bem.h>
 
 #include <disp/viewers/connectivitysettingsview.h>
+#include <utils/mnetracer.h>
 
 //=============================================================================================================
 // QT INCLUDES
@@ -338,9 +339,9 @@ void NeuronalConnectivity::updateRTMSA(SCMEASLIB::Measurement::SPtr pMeasurement
 
             MatrixXd data;
 
-            for(qint32 i = 0; i < pRTMSA->getMultiSampleArray().size(); ++i) {
-                const MatrixXd& t_mat = pRTMSA->getMultiSampleArray()[i];
-                m_iBlockSize = pRTMSA->getMultiSampleArray()[i].cols();
+            for(const MultiSampleFrame::ConstSPtr& pFrame : pRTMSA->getMultiSampleFrames()) {
+                const MatrixXd& t_mat = pFrame->data();
+                m_iBlockSize = t_mat.cols();
 
                 // Check row and colum integrity and restart if necessary
                 if(m_connectivitySettings.size() != 0) {
@@ -520,6 +521,7 @@ void NeuronalConnectivity::run()
         //Do processing after skip count has reached limit
         if((skip_count % m_iDownSample) == 0) {
             if(m_pCircularBuffer->pop(network)) {
+                MNE_TRACE_SCOPE("NeuronalConnectivity::run");
                 //Send the data to the connected plugins and the online display
                 if(!network.isEmpty()) {
                     //qDebug()<<"NeuronalConnectivity::run - Total time"<<m_timer.elapsed();
@@ -53,6 +53,7 @@
 #include <utils/ioutils.h>
 
 #include <scMeas/realtimemultisamplearray.h>
+#include <utils/mnetracer.h>
 
 #include "FormFiles/noisereductionsetupwidget.h"
 
@@ -90,7 +91,7 @@ NoiseReduction::NoiseReduction()
 , m_iMaxFilterLength(1)
 , m_iMaxFilterTapSize(-1)
 , m_sCurrentSystem("VectorView")
-, m_pCircularBuffer(QSharedPointer<UTILSLIB::CircularBuffer_Matrix_double>::create(40))
+, m_pCircularBuffer(QSharedPointer<UTILSLIB::CircularBuffer<MultiSampleFrame::ConstSPtr> >::create(40))
 , m_pNoiseReductionInput(Q_NULLPTR)
 , m_pNoiseReductionOutput(Q_NULLPTR)
 {
@@ -218,20 +219,20 @@ void NoiseReduction::update(SCMEASLIB::Measurement::SPtr pMeasurement)
             m_pNoiseReductionOutput->measurementData()->setMultiArraySize(1);
         }
 
+        const QList<MultiSampleFrame::ConstSPtr> lFrames = pRTMSA->getMultiSampleFrames();
+
         // Check if data is present
-        if(pRTMSA->getMultiSampleArray().size() > 0) {
+        if(!lFrames.isEmpty()) {
             //Init widgets
             if(m_iMaxFilterTapSize == -1) {
-                m_iMaxFilterTapSize = pRTMSA->getMultiSampleArray().first().cols();
+                m_iMaxFilterTapSize = lFrames.first()->data().cols();
                 initPluginControlWidgets();
                 QThread::start();
             }
 
-            for(unsigned char i = 0; i < pRTMSA->getMultiSampleArray().size(); ++i) {
-                // Please note that we do not need a copy here since this function will block until
-                // the buffer accepts new data again. Hence, the data is not deleted in the actual
-                // Measurement function after it emitted the notify signal.
-                while(!m_pCircularBuffer->push(pRTMSA->getMultiSampleArray()[i])) {
+            // The frames are shared with all other consumers, only the reference is queued
+            for(const MultiSampleFrame::ConstSPtr& pFrame : lFrames) {
+                while(!m_pCircularBuffer->push(pFrame)) {
                     //Do nothing until the circular buffer is ready to accept new data again
                 }
             }
@@ -342,28 +343,37 @@ void NoiseReduction::run()
     createSpharaOperator();
 
     // Init
+    MultiSampleFrame::ConstSPtr pFrame;
     MatrixXd matData;
+    bool bDataChanged;
     QScopedPointer<RTPROCESSINGLIB::FilterOverlapAdd> pRtFilter(new RTPROCESSINGLIB::FilterOverlapAdd());
 
     while(!isInterruptionRequested()) {
         // Get the current data
-        if(m_pCircularBuffer->pop(matData)) {
+        if(m_pCircularBuffer->pop(pFrame) && pFrame) {
+            MNE_TRACE_SCOPE("NoiseReduction::run");
             m_mutex.lock();
+            bDataChanged = true;
+
             //Do SSP's and compensators here
             if(m_bCompActivated) {
                 if(m_bProjActivated) {
                     //Comp + Proj
-                    matData = m_matSparseProjCompMult * matData;
+                    matData = m_matSparseProjCompMult * pFrame->data();
                 } else {
                     //Comp
-                    matData = m_matSparseCompMult * matData;
+                    matData = m_matSparseCompMult * pFrame->data();
                 }
             } else {
                 if(m_bProjActivated) {
                     //Proj
-                    matData = m_matSparseProjMult * matData;
+                    matData = m_matSparseProjMult * pFrame->data();
                 } else {
-                    //None - Raw
+                    //None - Raw, the frame is only copied if a later step changes it
+                    bDataChanged = m_bFilterActivated || m_bSpharaActive;
+                    if(bDataChanged) {
+                        matData = pFrame->data();
+                    }
                 }
             }
 
@@ -410,7 +420,11 @@ void NoiseReduction::run()
 
             //Send the data to the connected plugins and the display
             if(!isInterruptionRequested()) {
-                m_pNoiseReductionOutput->measurementData()->setValue(matData);
+                if(bDataChanged) {
+                    m_pNoiseReductionOutput->measurementData()->setValue(matData);
+                } else {
+                    m_pNoiseReductionOutput->measurementData()->setValue(pFrame);
+                }
             }
         }
     }
@@ -49,6 +49,7 @@
 #include <rtprocessing/helpers/filterkernel.h>
 
 #include <scShared/Plugins/abstractalgorithm.h>
+#include <scMeas/multisampleframe.h>
 
 //=============================================================================================================
 // QT INCLUDES
@@ -257,7 +258,7 @@ private:
 
     QSharedPointer<FIFFLIB::FiffInfo>                               m_pFiffInfo;            /**< Fiff measurement info.*/
 
-    QSharedPointer<UTILSLIB::CircularBuffer_Matrix_double>          m_pCircularBuffer;      /**< Holds incoming raw data. */
+    QSharedPointer<UTILSLIB::CircularBuffer<SCMEASLIB::MultiSampleFrame::ConstSPtr> > m_pCircularBuffer; /**< Holds incoming raw data frames. */
 
     SCSHAREDLIB::PluginInputData<SCMEASLIB::RealTimeMultiSampleArray>::SPtr      m_pNoiseReductionInput;      /**< The RealTimeMultiSampleArray of the NoiseReduction input.*/
     SCSHAREDLIB::PluginOutputData<SCMEASLIB::RealTimeMultiSampleArray>::SPtr     m_pNoiseReductionOutput;     /**< The RealTimeMultiSampleArray of the NoiseReduction output.*/
@@ -63,6 +63,7 @@
 #include <scMeas/realtimefwdsolution.h>
 
 #include <utils/ioutils.h>
+#include <utils/mnetracer.h>
 
 //=============================================================================================================
 // QT INCLUDES
@@ -93,7 +94,7 @@ using namespace Eigen;
 //=============================================================================================================
 
 RtcMne::RtcMne()
-: m_pCircularMatrixBuffer(CircularBuffer_Matrix_double::SPtr(new CircularBuffer_Matrix_double(40)))
+: m_pCircularMatrixBuffer(CircularBuffer<MultiSampleFrame::ConstSPtr>::SPtr::create(40))
 , m_pCircularEvokedBuffer(CircularBuffer<FIFFLIB::FiffEvoked>::SPtr::create(40))
 , m_bEvokedInput(false)
 , m_bRawInput(false)
@@ -405,16 +406,14 @@ void RtcMne::updateRTMSA(SCMEASLIB::Measurement::SPtr pMeasurement)
                 QMap<QString,double> mapReject;
                 mapReject.insert("eog", 150e-06);
 
-                for(qint32 i = 0; i < pRTMSA->getMultiSampleArray().size(); ++i) {
-                    bool bArtifactDetected = MNEEpochDataList::checkForArtifact(pRTMSA->getMultiSampleArray()[i],
+                for(const MultiSampleFrame::ConstSPtr& pFrame : pRTMSA->getMultiSampleFrames()) {
+                    bool bArtifactDetected = MNEEpochDataList::checkForArtifact(pFrame->data(),
                                                                                 *m_pFiffInfoInput,
                                                                                 mapReject);
 
                     if(!bArtifactDetected) {
-                        // Please note that we do not need a copy here since this function will block until
-                        // the buffer accepts new data again. Hence, the data is not deleted in the actual
-                        // Measurement function after it emitted the notify signal.
-                        while(!m_pCircularMatrixBuffer->push(pRTMSA->getMultiSampleArray()[i])) {
+                        // The frames are shared with all other consumers, only the reference is queued
+                        while(!m_pCircularMatrixBuffer->push(pFrame)) {
                             //Do nothing until the circular buffer is ready to accept new data again
                         }
                     } else {
@@ -571,7 +570,7 @@ void RtcMne::run()
     // Init parameters
     qint32 skip_count = 0;
     FiffEvoked evoked;
-    MatrixXd matData;
+    MultiSampleFrame::ConstSPtr pFrame;
     MatrixXd matDataResized;
     qint32 j;
     int iTimePointSps = 0;
@@ -616,7 +615,10 @@ void RtcMne::run()
         if(bRawInput && pMinimumNorm) {
             if(((skip_count % iDownSample) == 0)) {
                 // Get the current raw data
-                if(m_pCircularMatrixBuffer->pop(matData)) {
+                if(m_pCircularMatrixBuffer->pop(pFrame) && pFrame) {
+                    MNE_TRACE_SCOPE("RtcMne::run");
+                    const MatrixXd& matData = pFrame->data();
+
                     //Pick the same channels as in the inverse operator
                     matDataResized.resize(iNumberChannels, matData.cols());
 
@@ -640,13 +642,14 @@ void RtcMne::run()
                     }
                 }
             } else {
-                m_pCircularMatrixBuffer->pop(matData);
+                m_pCircularMatrixBuffer->pop(pFrame);
             }
         }
 
         //Process data from averaging input
         if(bEvokedInput && pMinimumNorm) {
             if(m_pCircularEvokedBuffer->pop(evoked)) {
+                MNE_TRACE_SCOPE("RtcMne::run");
                 // Get the current evoked data
                 if(((skip_count % iDownSample) == 0)) {
                     sourceEstimate = pMinimumNorm->calculateInverse(evoked);
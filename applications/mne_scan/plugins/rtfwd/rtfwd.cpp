@@ -52,6 +52,7 @@
 #include <scMeas/realtimehpiresult.h>
 #include <scMeas/realtimefwdsolution.h>
 #include <scMeas/realtimemultisamplearray.h>
+#include <utils/mnetracer.h>
 
 //=============================================================================================================
 // QT INCLUDES
@@ -105,6 +106,7 @@ RtFwd::RtFwd()
     m_pFwdSettings->include_eeg = true;
     m_pFwdSettings->accurate = true;
     m_pFwdSettings->mindist = 5.0f/1000.0f;
+    m_pFwdSettings->incremental_update = true;
 
     m_sAtlasDir = QCoreApplication::applicationDirPath() + "/MNE-sample-data/subjects/sample/label";
 }
@@ -435,6 +437,7 @@ void RtFwd::run()
         m_mutex.unlock();
 
         if(bDoFwdComputation) {
+            MNE_TRACE_SCOPE("RtFwd::run");
             emit statusInformationChanged(1);   // computing
             m_mutex.lock();
             m_bBusy = true;
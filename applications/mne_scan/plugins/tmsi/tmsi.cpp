@@ -40,6 +40,8 @@
 #include "tmsi.h"
 #include "tmsiproducer.h"
 
+#include <utils/mnetracer.h>
+
 //=============================================================================================================
 // QT INCLUDES
 //=============================================================================================================
@@ -572,6 +574,7 @@ void TMSI::run()
         // Check impedances - send new impedance values to graphic scene
         if(m_pTMSIProducer->isRunning() && m_bCheckImpedances) {
             if(m_pCircularBuffer->pop(matData)) {
+                MNE_TRACE_SCOPE("TMSI::run");
                 for(qint32 i = 0; i < matData.cols(); ++i) {
                     m_pTmsiImpedanceWidget->updateGraphicScene(matData.col(i).cast<double>());
                 }
@@ -581,6 +584,7 @@ void TMSI::run()
         //pop matrix only if the producer thread is running
         if(m_pTMSIProducer->isRunning() && !m_bCheckImpedances) {
             if(m_pCircularBuffer->pop(matData)) {
+                MNE_TRACE_SCOPE("TMSI::run");
                 // Set Beep trigger (if activated)
                 if(m_bBeepTrigger && m_qTimerTrigger.elapsed() >= m_iTriggerInterval) {
                     QtConcurrent::run(Beep, 450, 700);
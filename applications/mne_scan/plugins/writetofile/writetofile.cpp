@@ -43,6 +43,7 @@
 #include <disp/viewers/projectsettingsview.h>
 #include <scMeas/realtimemultisamplearray.h>
 #include <fiff/fiff_stream.h>
+#include <utils/mnetracer.h>
 
 //=============================================================================================================
 // QT INCLUDES
@@ -75,7 +76,7 @@ WriteToFile::WriteToFile()
 , m_iBlinkStatus(0)
 , m_iSplitCount(0)
 , m_iRecordingMSeconds(5*60*1000)
-, m_pCircularBuffer(CircularBuffer_Matrix_double::SPtr(new CircularBuffer_Matrix_double(40)))
+, m_pCircularBuffer(CircularBuffer<MultiSampleFrame::ConstSPtr>::SPtr::create(40))
 {
     m_pActionRecordFile = new QAction(QIcon(":/images/record.png"), tr("Start Recording"),this);
     m_pActionRecordFile->setStatusTip(tr("Start Recording"));
@@ -201,14 +202,10 @@ void WriteToFile::update(SCMEASLIB::Measurement::SPtr pMeasurement)
         }
 
         // Check if data is present
-        if(pRTMSA->getMultiSampleArray().size() > 0) {
-            for(unsigned char i = 0; i < pRTMSA->getMultiSampleArray().size(); ++i) {
-                // Please note that we do not need a copy here since this function will block until
-                // the buffer accepts new data again. Hence, the data is not deleted in the actual
-                // Measurement function after it emitted the notify signal.
-                while(!m_pCircularBuffer->push(pRTMSA->getMultiSampleArray()[i])) {
-                    //Do nothing until the circular buffer is ready to accept new data again
-                }
+        // The frames are shared with all other consumers, only the reference is queued
+        for(const MultiSampleFrame::ConstSPtr& pFrame : pRTMSA->getMultiSampleFrames()) {
+            while(!m_pCircularBuffer->push(pFrame)) {
+                //Do nothing until the circular buffer is ready to accept new data again
             }
         }
     }
@@ -283,14 +280,17 @@ void WriteToFile::initPluginControlWidgets()
 
 void WriteToFile::run()
 {
-    MatrixXd matData;
+    MultiSampleFrame::ConstSPtr pFrame;
     qint32 size = 0;
 
     while(!isInterruptionRequested()) {
         if(m_pCircularBuffer) {
-            //pop matrix
+            //pop frame
+
+            if(m_pCircularBuffer->pop(pFrame) && pFrame) {
+                MNE_TRACE_SCOPE("WriteToFile::run");
+                const MatrixXd& matData = pFrame->data();
 
-            if(m_pCircularBuffer->pop(matData)) {
                 //Write raw data to fif file
                 m_mutex.lock();
                 if(m_bWriteToFile) {
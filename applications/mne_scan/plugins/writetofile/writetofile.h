@@ -43,6 +43,7 @@
 
 #include <utils/generics/circularbuffer.h>
 #include <scShared/Plugins/abstractalgorithm.h>
+#include <scMeas/multisampleframe.h>
 #include <fiff/fifffilesharer.h>
 
 //=============================================================================================================
@@ -236,7 +237,7 @@ private:
     QPointer<QAction>                       m_pActionRecordFile;            /**< start recording action. */
     QPointer<QAction>                       m_pActionClipRecording;
 
-    QSharedPointer<UTILSLIB::CircularBuffer_Matrix_double>                      m_pCircularBuffer;      /**< Holds incoming raw data. */
+    QSharedPointer<UTILSLIB::CircularBuffer<SCMEASLIB::MultiSampleFrame::ConstSPtr> >  m_pCircularBuffer; /**< Holds incoming raw data frames. */
 
     SCSHAREDLIB::PluginInputData<SCMEASLIB::RealTimeMultiSampleArray>::SPtr      m_pWriteToFileInput;   /**< The RealTimeMultiSampleArray of the WriteToFile input.*/
 
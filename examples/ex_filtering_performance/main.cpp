@@ -0,0 +1,230 @@
+//=============================================================================================================
+/**
+ * @file     main.cpp
+ * @author   agent <agent@local>
+ * @since    0.1.9
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, agent. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    Example comparing the performance of the FIR filtering paths.
+ *
+ */
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include <iostream>
+
+#include <rtprocessing/helpers/filterkernel.h>
+#include <rtprocessing/filter.h>
+
+#include <utils/generics/applicationlogger.h>
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QtCore/QCoreApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QtConcurrent>
+
+//=============================================================================================================
+// EIGEN INCLUDES
+//=============================================================================================================
+
+#include <Eigen/Core>
+
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace UTILSLIB;
+using namespace RTPROCESSINGLIB;
+using namespace Eigen;
+
+//=============================================================================================================
+// DEFINE GLOBAL METHODS
+//=============================================================================================================
+
+namespace {
+
+//=============================================================================================================
+/**
+ * Reference implementation of the former filterData path: the data is sliced into chunks of about twice the
+ * filter order, every channel of every chunk is filtered with its own kernel copy and a whole-chunk FFT, and the
+ * chunks are overlap-added.
+ */
+MatrixXd filterDataPerChannel(const MatrixXd& matData,
+                              const FilterKernel& filterKernel)
+{
+    int iOrder = filterKernel.getFilterOrder();
+    int iSize = 2 * iOrder;
+
+    MatrixXd matDataOut = MatrixXd::Zero(matData.rows(), matData.cols() + iOrder);
+
+    for(int from = 0; from < matData.cols(); from += iSize) {
+        int iLength = std::min(iSize, static_cast<int>(matData.cols()) - from);
+
+        FilterKernel filterKernelSetup = filterKernel;
+        filterKernelSetup.prepareFilter(iLength);
+
+        QList<FilterObject> timeData;
+        for(int i = 0; i < matData.rows(); ++i) {
+            FilterObject data;
+            data.filterKernel = filterKernelSetup;
+            data.iRow = i;
+            data.vecData = matData.row(i).segment(from, iLength);
+            timeData.append(data);
+        }
+
+        QFuture<void> future = QtConcurrent::map(timeData,
+                                                 filterChannel);
+        future.waitForFinished();
+
+        for(int i = 0; i < timeData.size(); ++i) {
+            matDataOut.row(i).segment(from, iLength + iOrder) += timeData.at(i).vecData.head(iLength + iOrder);
+        }
+    }
+
+    return matDataOut.middleCols(iOrder/2, matData.cols());
+}
+
+//=============================================================================================================
+
+void printResult(const QString& sName,
+                 qint64 iMSecs,
+                 double dSeconds,
+                 double dMaxDiff = -1.0)
+{
+    std::cout << sName.leftJustified(36).toStdString()
+              << QString::number(iMSecs).rightJustified(8).toStdString() << " ms   "
+              << QString::number(dSeconds * 1000.0 / std::max<qint64>(iMSecs, 1), 'f', 1).rightJustified(8).toStdString() << " x real time";
+    if(dMaxDiff >= 0.0) {
+        std::cout << "   max abs diff " << dMaxDiff;
+    }
+    std::cout << std::endl;
+}
+
+} // namespace
+
+//=============================================================================================================
+// MAIN
+//=============================================================================================================
+
+//=============================================================================================================
+/**
+ * The function main marks the entry point of the program.
+ * By default, main has the storage class extern.
+ *
+ * @param[in] argc (argument count) is an integer that indicates how many arguments were entered on the command line when the program was started.
+ * @param[in] argv (argument vector) is an array of pointers to arrays of character objects. The array objects are null-terminated strings, representing the arguments that were entered on the command line when the program was started.
+ * @return the value that was set to exit() (which is 0 if exit() is called via quit()).
+ */
+int main(int argc, char *argv[])
+{
+    qInstallMessageHandler(ApplicationLogger::customLogWriter);
+    QCoreApplication a(argc, argv);
+
+    // Command Line Parser
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Filtering Performance Example. Compares the per channel FFT filtering with the "
+                                     "overlap-save engine on synthetic data. The default 306 channels x 1 hour "
+                                     "need about 9 GB per data copy.");
+    parser.addHelpOption();
+
+    QCommandLineOption channelsOption("channels", "The number of channels <n>.", "n", "306");
+    QCommandLineOption durationOption("duration", "The recording length in seconds <sec>.", "sec", "3600");
+    QCommandLineOption sFreqOption("sfreq", "The sampling frequency in Hz <hz>.", "hz", "1000");
+    QCommandLineOption orderOption("order", "The filter order <order>.", "order", "1024");
+    QCommandLineOption blockOption("block", "The block length in seconds for the streaming comparison <sec>.", "sec", "1");
+    QCommandLineOption legacyOption("legacy", "Also run the former per channel path.");
+
+    parser.addOption(channelsOption);
+    parser.addOption(durationOption);
+    parser.addOption(sFreqOption);
+    parser.addOption(orderOption);
+    parser.addOption(blockOption);
+    parser.addOption(legacyOption);
+
+    parser.process(a);
+
+    int iNumChannels = parser.value(channelsOption).toInt();
+    double dDuration = parser.value(durationOption).toDouble();
+    double dSFreq = parser.value(sFreqOption).toDouble();
+    int iOrder = parser.value(orderOption).toInt();
+    int iBlockSize = parser.value(blockOption).toDouble() * dSFreq;
+    int iNumSamples = dDuration * dSFreq;
+
+    FilterKernel filterKernel("filter_kernel",
+                              FilterKernel::m_filterTypes.indexOf(FilterParameter("BPF")),
+                              iOrder,
+                              10.0 / (dSFreq / 2.0),
+                              10.0 / (dSFreq / 2.0),
+                              1.0 / (dSFreq / 2.0),
+                              dSFreq,
+                              FilterKernel::m_designMethods.indexOf(FilterParameter("Cosine")));
+
+    std::cout << "Channels " << iNumChannels << ", samples " << iNumSamples << ", filter order " << iOrder
+              << ", overlap-save FFT length " << FilterKernel::getOptimalFftLength(filterKernel.getCoefficients().cols())
+              << std::endl;
+
+    MatrixXd matData = MatrixXd::Random(iNumChannels, iNumSamples);
+    QElapsedTimer timer;
+
+    // Whole recording
+    timer.start();
+    MatrixXd matFiltered = filterData(matData,
+                                      filterKernel);
+    printResult("filterData (overlap-save)", timer.elapsed(), dDuration);
+
+    if(parser.isSet(legacyOption)) {
+        timer.start();
+        MatrixXd matFilteredLegacy = filterDataPerChannel(matData,
+                                                          filterKernel);
+        qint64 iLegacyMSecs = timer.elapsed();
+        printResult("filterData (per channel FFT)", iLegacyMSecs, dDuration, (matFilteredLegacy - matFiltered).cwiseAbs().maxCoeff());
+    }
+
+    // Streaming in blocks
+    FilterOverlapAdd filterOverlapAdd;
+    MatrixXd matBlockFiltered;
+    double dMaxDiff = 0.0;
+
+    timer.start();
+    for(int from = 0; from + iBlockSize <= iNumSamples; from += iBlockSize) {
+        matBlockFiltered = filterOverlapAdd.calculate(matData.middleCols(from, iBlockSize),
+                                                      filterKernel);
+
+        // The first block lacks the preceding overlap, the output is delayed by half the filter order
+        if(from > 0 && from - iOrder/2 >= 0) {
+            dMaxDiff = std::max(dMaxDiff, (matBlockFiltered - matFiltered.middleCols(from - iOrder/2, iBlockSize)).cwiseAbs().maxCoeff());
+        }
+    }
+    printResult("FilterOverlapAdd (streaming)", timer.elapsed(), dDuration, dMaxDiff);
+
+    return 0;
+}
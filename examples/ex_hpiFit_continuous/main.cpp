@@ -0,0 +1,181 @@
+//=============================================================================================================
+/**
+ * @file     main.cpp
+ * @author   agent <agent@local>
+ * @since    0.1.9
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, agent. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    Example for continuous cHPI fitting of a whole raw file. The head positions are written in MaxFilter's .pos format.
+ *
+ */
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include <fiff/fiff.h>
+#include <fiff/fiff_info.h>
+#include <fiff/fiff_dig_point_set.h>
+
+#include <inverse/hpiFit/hpifit.h>
+#include <inverse/hpiFit/hpifitcontinuous.h>
+
+#include <utils/generics/applicationlogger.h>
+
+//=============================================================================================================
+// Qt INCLUDES
+//=============================================================================================================
+
+#include <QtCore/QCoreApplication>
+#include <QFile>
+#include <QCommandLineParser>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QThread>
+
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace INVERSELIB;
+using namespace FIFFLIB;
+using namespace UTILSLIB;
+using namespace Eigen;
+
+//=============================================================================================================
+// MAIN
+//=============================================================================================================
+
+//=============================================================================================================
+/**
+ * The function main marks the entry point of the program.
+ * By default, main has the storage class extern.
+ *
+ * @param[in] argc (argument count) is an integer that indicates how many arguments were entered on the command line when the program was started.
+ * @param[in] argv (argument vector) is an array of pointers to arrays of character objects. The array objects are null-terminated strings, representing the arguments that were entered on the command line when the program was started.
+ * @return the value that was set to exit() (which is 0 if exit() is called via quit()).
+ */
+
+int main(int argc, char *argv[])
+{
+    qInstallMessageHandler(ApplicationLogger::customLogWriter);
+    QElapsedTimer timer;
+    QCoreApplication a(argc, argv);
+
+    // Command Line Parser
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Continuous hpiFit Example");
+    parser.addHelpOption();
+    qInfo() << "Please download the mne-cpp-test-data folder from Github (mne-tools) into mne-cpp/bin.";
+    QCommandLineOption inputOption("fileIn", "The input file <in>.", "in", QCoreApplication::applicationDirPath() + "/mne-cpp-test-data/MEG/sample/test_hpiFit_raw.fif");
+    QCommandLineOption outputOption("fileOut", "The head position file <out>.", "out", QCoreApplication::applicationDirPath() + "/mne-cpp-test-data/MEG/sample/test_hpiFit_raw.pos");
+    QCommandLineOption windowOption("window", "The window length <window> in seconds.", "window", "0.2");
+    QCommandLineOption stepOption("step", "The time <step> between two fits in seconds.", "step", "0.1");
+    QCommandLineOption threadsOption("threads", "The number of <threads> fitting in parallel.", "threads", QString::number(QThread::idealThreadCount()));
+    QCommandLineOption freqsOption("freqs", "The comma separated coil frequencies <freqs> in Hz.", "freqs", "154,158,161,166");
+
+    parser.addOption(inputOption);
+    parser.addOption(outputOption);
+    parser.addOption(windowOption);
+    parser.addOption(stepOption);
+    parser.addOption(threadsOption);
+    parser.addOption(freqsOption);
+
+    parser.process(a);
+
+    // Init data loading
+    QFile t_fileIn(parser.value(inputOption));
+    FiffRawData raw(t_fileIn);
+    QSharedPointer<FiffInfo> pFiffInfo = QSharedPointer<FiffInfo>(new FiffInfo(raw.info));
+
+    QVector<int> vecFreqs;
+    for(const QString& sFreq : parser.value(freqsOption).split(",", QString::SkipEmptyParts)) {
+        vecFreqs.append(sFreq.toInt());
+    }
+
+    // Use SSP + SGM + calibration
+    MatrixXd matProjectors = MatrixXd::Identity(pFiffInfo->chs.size(), pFiffInfo->chs.size());
+
+    //Do a copy here because we are going to change the activity flags of the SSP's
+    FiffInfo infoTemp = *(pFiffInfo.data());
+
+    //Turn on all SSP
+    for(int i = 0; i < infoTemp.projs.size(); ++i) {
+        infoTemp.projs[i].active = true;
+    }
+
+    //Create the projector for all SSP's on
+    infoTemp.make_projector(matProjectors);
+
+    //set columns of matrix to zero depending on bad channels indexes
+    for(qint32 j = 0; j < infoTemp.bads.size(); ++j) {
+        matProjectors.col(infoTemp.ch_names.indexOf(infoTemp.bads.at(j))).setZero();
+    }
+
+    // order frequencies on the first window
+    MatrixXd matData, matTimes;
+    const float fWindowSec = parser.value(windowOption).toFloat();
+    fiff_int_t from = raw.first_samp;
+    fiff_int_t to = from + ceil(fWindowSec * pFiffInfo->sfreq);
+    if(!raw.read_raw_segment(matData, matTimes, from, to)) {
+        qCritical("error during read_raw_segment");
+        return -1;
+    }
+
+    QVector<double> vecError;
+    VectorXd vecGoF;
+    FiffDigPointSet fittedPointSet;
+    FiffCoordTrans transDevHead = pFiffInfo->dev_head_t;
+
+    qInfo() << "Find Order...";
+    HPIFit HPI = HPIFit(pFiffInfo);
+    HPI.findOrder(matData,
+                  matProjectors,
+                  transDevHead,
+                  vecFreqs,
+                  vecError,
+                  vecGoF,
+                  fittedPointSet,
+                  pFiffInfo);
+    qInfo() << "[done]";
+
+    // fit the whole recording
+    HPIFitContinuous hpiContinuous(pFiffInfo);
+    hpiContinuous.setWindow(fWindowSec, parser.value(stepOption).toFloat());
+    hpiContinuous.setParallelization(parser.value(threadsOption).toInt(), 20);
+
+    qInfo() << "Continuous HPI-Fit...";
+    timer.start();
+    MatrixXd matPosition = hpiContinuous.fit(raw, vecFreqs, matProjectors);
+    qInfo() << "Fitting" << matPosition.rows() << "windows took" << timer.elapsed() << "milliseconds";
+
+    if(!HPIFitContinuous::writePositions(matPosition, parser.value(outputOption))) {
+        return -1;
+    }
+    qInfo() << "[done]";
+
+    return 0;
+}
@@ -78,8 +78,10 @@ SUBDIRS += \
             ex_disp_3D \
             ex_fs_surface \
             ex_filtering \
+            ex_filtering_performance \
             ex_histogram \
             ex_hpiFit \
+            ex_hpiFit_continuous \
             ex_inverse_mne_raw \
             ex_inverse_pwl_rap_music \
             ex_inverse_rap_music \
@@ -73,6 +73,7 @@ SOURCES += \
     rtClient/rtclient.cpp \
     rtClient/rtdataclient.cpp \
     rtClient/rtcmdclient.cpp \
+    rtClient/rtdatacodec.cpp \
     rtCommand/command.cpp \
     rtCommand/commandmanager.cpp \
     rtCommand/commandparser.cpp \
@@ -83,6 +84,7 @@ HEADERS +=  \
     rtClient/rtclient.h \
     rtClient/rtcmdclient.h \
     rtClient/rtdataclient.h \
+    rtClient/rtdatacodec.h \
     rtCommand/command.h \
     rtCommand/commandmanager.h \
     rtCommand/commandparser.h \
@@ -39,7 +39,16 @@
 //=============================================================================================================
 
 #include "rtdataclient.h"
+#include "rtdatacodec.h"
+
 #include <fiff/fiff_file.h>
+#include <fiff/fiff_constants.h>
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QDebug>
 
 //=============================================================================================================
 // USED NAMESPACES
@@ -79,7 +88,7 @@ qint32 RtDataClient::getClientId()
         FiffStream t_fiffStream(this);
 
         QString t_sCommand("");
-        t_fiffStream.write_rt_command(1, t_sCommand);
+        t_fiffStream.write_rt_command(FIFFV_MNE_RT_GET_CLIENT_ID, t_sCommand);
 
         this->waitForReadyRead(100);
         // ID is send as answer
@@ -366,6 +375,25 @@ FiffInfo::SPtr RtDataClient::readInfo()
 
 //=============================================================================================================
 
+bool RtDataClient::requestDataEncoding(qint32 p_iEncoding)
+{
+    FiffStream t_fiffStream(this);
+    t_fiffStream.write_rt_command(FIFFV_MNE_RT_SET_DATA_ENCODING, QString::number(p_iEncoding));
+    this->flush();
+
+    // Servers which do not know the command do not answer. The server thread confirms the switch, allow for a busy one.
+    if(!this->waitForReadyRead(1000)) {
+        return false;
+    }
+
+    FiffTag::SPtr t_pTag;
+    t_fiffStream.read_rt_tag(t_pTag);
+
+    return t_pTag->kind == FIFF_MNE_RT_DATA_ENCODING && *t_pTag->toInt() == p_iEncoding;
+}
+
+//=============================================================================================================
+
 void RtDataClient::readRawBuffer(qint32 p_nChannels,
                                  MatrixXf& data,
                                  fiff_int_t& kind)
@@ -385,6 +413,14 @@ void RtDataClient::readRawBuffer(qint32 p_nChannels,
         qint32 nSamples = (t_pTag->size()/4)/p_nChannels;
         data = MatrixXf(Map< MatrixXf >(t_pTag->toFloat(), p_nChannels, nSamples));
     }
+    else if(kind == FIFF_MNE_RT_COMPRESSED_BUFFER)
+    {
+        if(RtDataCodec::decode(*t_pTag, data) && data.rows() == p_nChannels) {
+            kind = FIFF_DATA_BUFFER;
+        } else {
+            qWarning() << "[RtDataClient::readRawBuffer] Could not decode compressed buffer.";
+        }
+    }
 //        else
 //            data = tag.data;
 }
@@ -394,6 +430,6 @@ void RtDataClient::readRawBuffer(qint32 p_nChannels,
 void RtDataClient::setClientAlias(const QString &p_sAlias)
 {
     FiffStream t_fiffStream(this);
-    t_fiffStream.write_rt_command(2, p_sAlias);//MNE_RT.MNE_RT_SET_CLIENT_ALIAS, alias);
+    t_fiffStream.write_rt_command(FIFFV_MNE_RT_SET_CLIENT_ALIAS, p_sAlias);
     this->flush();
 }
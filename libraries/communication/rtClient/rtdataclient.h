@@ -110,7 +110,19 @@ public:
 
     //=========================================================================================================
     /**
-     * Reads fiff measurement information of a data the connection
+     * Asks mne_rt_server to send the data buffers in the given encoding. Has to be called before the measurement is
+     * started. Servers which do not know the encoding keep sending float32 buffers.
+     *
+     * @param[in] p_iEncoding    The requested encoding, e.g. FIFFV_MNE_RT_ENCODING_COMPRESSED.
+     *
+     * @return True if the server confirmed the encoding, false otherwise.
+     */
+    bool requestDataEncoding(qint32 p_iEncoding);
+
+    //=========================================================================================================
+    /**
+     * Reads fiff measurement information of a data the connection. Compressed buffers are decoded, kind is set to
+     * FIFF_DATA_BUFFER for them.
      *
      * @param[in] p_nChannels    Number of channels to reshape the received data.
      * @param[out] data          The read data - ToDo change this to raw buffer data object.
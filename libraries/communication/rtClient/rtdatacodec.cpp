@@ -0,0 +1,212 @@
+//=============================================================================================================
+/**
+ * @file     rtdatacodec.cpp
+ * @author   agent <agent@local>
+ * @since    0.1.9
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, agent. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    Definition of the RtDataCodec Class.
+ *
+ */
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include "rtdatacodec.h"
+
+#include <cmath>
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QDataStream>
+#include <QDebug>
+
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace COMMUNICATIONLIB;
+using namespace Eigen;
+
+//=============================================================================================================
+// DEFINE GLOBAL METHODS
+//=============================================================================================================
+
+namespace {
+    const double MAX_QUANTIZED_VALUE = 1073741824.0;        /**< 2^30, quantized values are kept well inside int32. */
+    const float RELATIVE_RESOLUTION = 8388608.0f;           /**< 2^23, the mantissa resolution of float32. */
+}
+
+//=============================================================================================================
+// DEFINE MEMBER METHODS
+//=============================================================================================================
+
+QByteArray RtDataCodec::encode(const MatrixXf& matData,
+                               const VectorXf& vecCals,
+                               int iLevel)
+{
+    const qint32 iChannels = static_cast<qint32>(matData.rows());
+    const qint32 iSamples = static_cast<qint32>(matData.cols());
+
+    //
+    // Choose the quantization steps
+    //
+    VectorXf vecSteps(iChannels);
+
+    for(qint32 r = 0; r < iChannels; ++r) {
+        float fStep = r < vecCals.size() ? std::fabs(vecCals[r]) : 0.0f;
+        float fMaxAbs = 0.0f;
+
+        for(qint32 c = 0; c < iSamples; ++c) {
+            if(std::isfinite(matData(r,c))) {
+                fMaxAbs = std::max(fMaxAbs, std::fabs(matData(r,c)));
+            }
+        }
+
+        if(!std::isfinite(fStep) || fStep <= 0.0f || fMaxAbs / fStep > MAX_QUANTIZED_VALUE) {
+            fStep = fMaxAbs > 0.0f ? fMaxAbs / RELATIVE_RESOLUTION : 1.0f;
+        }
+
+        vecSteps[r] = fStep;
+    }
+
+    //
+    // Quantize, delta code and write zigzag varints, channel by channel
+    //
+    QByteArray baStream;
+    baStream.resize(iChannels * iSamples * 5);
+    uchar* pOut = reinterpret_cast<uchar*>(baStream.data());
+
+    for(qint32 r = 0; r < iChannels; ++r) {
+        const double dInvStep = 1.0 / static_cast<double>(vecSteps[r]);
+        qint64 iPrevious = 0;
+
+        for(qint32 c = 0; c < iSamples; ++c) {
+            const float fValue = matData(r,c);
+            const qint64 iValue = std::isfinite(fValue) ? std::llround(static_cast<double>(fValue) * dInvStep) : 0;
+            const qint64 iDelta = iValue - iPrevious;
+            iPrevious = iValue;
+
+            quint64 uZigZag = (static_cast<quint64>(iDelta) << 1) ^ static_cast<quint64>(iDelta >> 63);
+
+            while(uZigZag >= 0x80) {
+                *pOut++ = static_cast<uchar>(uZigZag | 0x80);
+                uZigZag >>= 7;
+            }
+            *pOut++ = static_cast<uchar>(uZigZag);
+        }
+    }
+
+    baStream.resize(static_cast<int>(pOut - reinterpret_cast<uchar*>(baStream.data())));
+
+    //
+    // Write header and deflated stream
+    //
+    QByteArray baEncoded;
+    QDataStream t_streamOut(&baEncoded, QIODevice::WriteOnly);
+    t_streamOut.setFloatingPointPrecision(QDataStream::SinglePrecision);
+
+    t_streamOut << iChannels << iSamples;
+    for(qint32 r = 0; r < iChannels; ++r) {
+        t_streamOut << vecSteps[r];
+    }
+
+    baEncoded.append(qCompress(baStream, iLevel));
+
+    return baEncoded;
+}
+
+//=============================================================================================================
+
+bool RtDataCodec::decode(const QByteArray& baEncoded,
+                         MatrixXf& matData)
+{
+    QDataStream t_streamIn(baEncoded);
+    t_streamIn.setFloatingPointPrecision(QDataStream::SinglePrecision);
+
+    qint32 iChannels = 0, iSamples = 0;
+    t_streamIn >> iChannels >> iSamples;
+
+    const qint64 iHeaderSize = 8 + 4 * static_cast<qint64>(iChannels);
+
+    if(t_streamIn.status() != QDataStream::Ok || iChannels < 0 || iSamples < 0 || baEncoded.size() < iHeaderSize) {
+        qWarning() << "[RtDataCodec::decode] Corrupt buffer header.";
+        return false;
+    }
+
+    VectorXf vecSteps(iChannels);
+    for(qint32 r = 0; r < iChannels; ++r) {
+        t_streamIn >> vecSteps[r];
+    }
+
+    const QByteArray baStream = qUncompress(reinterpret_cast<const uchar*>(baEncoded.constData()) + iHeaderSize,
+                                            baEncoded.size() - static_cast<int>(iHeaderSize));
+
+    // Every value takes at least one byte, reject headers the payload can't hold before allocating
+    if(static_cast<qint64>(iChannels) * static_cast<qint64>(iSamples) > baStream.size()) {
+        qWarning() << "[RtDataCodec::decode] Buffer header doesn't match the payload size.";
+        return false;
+    }
+
+    const uchar* pIn = reinterpret_cast<const uchar*>(baStream.constData());
+    const uchar* pEnd = pIn + baStream.size();
+
+    matData.resize(iChannels, iSamples);
+
+    for(qint32 r = 0; r < iChannels; ++r) {
+        const float fStep = vecSteps[r];
+        qint64 iValue = 0;
+
+        for(qint32 c = 0; c < iSamples; ++c) {
+            quint64 uZigZag = 0;
+            int iShift = 0;
+
+            while(true) {
+                if(pIn >= pEnd || iShift > 63) {
+                    qWarning() << "[RtDataCodec::decode] Truncated buffer.";
+                    return false;
+                }
+
+                const uchar cByte = *pIn++;
+                uZigZag |= static_cast<quint64>(cByte & 0x7F) << iShift;
+
+                if(!(cByte & 0x80)) {
+                    break;
+                }
+
+                iShift += 7;
+            }
+
+            iValue += static_cast<qint64>(uZigZag >> 1) ^ -static_cast<qint64>(uZigZag & 1);
+            matData(r,c) = static_cast<float>(static_cast<double>(iValue) * fStep);
+        }
+    }
+
+    return true;
+}
@@ -1,16 +1,13 @@
 //=============================================================================================================
 /**
- * @file     fiffstreamthread.h
- * @author   Christoph Dinh <chdinh@nmr.mgh.harvard.edu>;
- *           Limin Sun <limin.sun@childrens.harvard.edu>;
- *           Lorenz Esch <lesch@mgh.harvard.edu>;
- *           Matti Hamalainen <msh@nmr.mgh.harvard.edu>
- * @since    0.1.0
- * @date     July, 2012
+ * @file     rtdatacodec.h
+ * @author   agent <agent@local>
+ * @since    0.1.9
+ * @date     October, 2026
  *
  * @section  LICENSE
  *
- * Copyright (C) 2012, Christoph Dinh, Limin Sun, Lorenz Esch, Matti Hamalainen. All rights reserved.
+ * Copyright (C) 2026, agent. All rights reserved.
  *
  * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
  * the following conditions are met:
@@ -31,99 +28,80 @@
  * POSSIBILITY OF SUCH DAMAGE.
  *
  *
- * @brief     Declaration of the FiffStreamThread Class.
+ * @brief    Declaration of the RtDataCodec Class.
  *
  */
 
-#ifndef FIFFSTREAMTHREAD_H
-#define FIFFSTREAMTHREAD_H
+#ifndef RTDATACODEC_H
+#define RTDATACODEC_H
 
 //=============================================================================================================
 // INCLUDES
 //=============================================================================================================
 
-#include <fiff/fiff_stream.h>
-#include <fiff/fiff_info.h>
+#include "../communication_global.h"
 
 //=============================================================================================================
 // QT INCLUDES
 //=============================================================================================================
 
-#include <QThread>
-#include <QTcpSocket>
-#include <QMutex>
-#include <QSharedPointer>
+#include <QByteArray>
 
 //=============================================================================================================
-// DEFINE NAMESPACE RTSERVER
+// EIGEN INCLUDES
 //=============================================================================================================
 
-namespace RTSERVER
-{
+#include <Eigen/Core>
 
 //=============================================================================================================
-// FORWARD DECLARATIONS
+// DEFINE NAMESPACE COMMUNICATIONLIB
 //=============================================================================================================
 
-class FiffStreamThread : public QThread
+namespace COMMUNICATIONLIB
 {
-    Q_OBJECT
 
+//=============================================================================================================
+/**
+ * The compressed encoding of the real-time data buffers (FIFF_MNE_RT_COMPRESSED_BUFFER). Every channel is quantized
+ * to integer multiples of its calibration step (cal * range), which recovers the ADC values of acquired data.
+ * Consecutive samples of a channel are delta coded, zigzag mapped and written as variable length integers before
+ * the byte stream is deflated with qCompress. The steps are part of the buffer, so the decoder does not need the
+ * measurement info. The maximal absolute error per sample is half the step.
+ *
+ * Layout (big endian): nchan (int32), nsamp (int32), nchan x step (float32), deflated varint stream.
+ *
+ * @brief Encoder and decoder of compressed real-time data buffers.
+ */
+class COMMUNICATIONSHARED_EXPORT RtDataCodec
+{
 public:
-    FiffStreamThread(qint32 id, int socketDescriptor, QObject *parent);
-
-    ~FiffStreamThread();
-
-    void run();
-
-    inline qint32 getID();
-
-    inline QString getAlias();
-
-//    void deactivateRawBufferSending();
-
-    void parseCommand(QSharedPointer<FIFFLIB::FiffTag> p_pTag);
-
-    void writeClientId();
-
-//    void sendData(QTcpSocket& p_qTcpSocket);
-
-signals:
-    void error(QTcpSocket::SocketError socketError);
-
-private:
-    qint32 m_iDataClientId;
-    QString m_sDataClientAlias;
-
-    int m_iSocketDescriptor;
-
-    QMutex m_qMutex;
-    QByteArray m_qSendBlock;
-
-    bool m_bIsSendingRawBuffer;
-
-    bool m_bIsRunning;
-
-    void startMeas(qint32 ID);
-
-    void stopMeas(qint32 ID);
-
-    void sendMeasurementInfo(qint32 ID, const FIFFLIB::FiffInfo& p_fiffInfo);
-
-    void sendRawBuffer(QSharedPointer<Eigen::MatrixXf> m_pMatRawData);
-    //void readToBuffer1();
-//    void readProc(QTcpSocket& p_qTcpSocket);
+    //=========================================================================================================
+    /**
+     * Encodes a data buffer.
+     *
+     * @param[in] matData        The data (channels x samples).
+     * @param[in] vecCals        The quantization step per channel, usually cal * range. Channels without a valid
+     *                           step, or which would overflow the integer range, get a step derived from their data.
+     * @param[in] iLevel         The qCompress level. Default is 1, which trades a little ratio for speed.
+     *
+     * @return The encoded buffer.
+     */
+    static QByteArray encode(const Eigen::MatrixXf& matData,
+                             const Eigen::VectorXf& vecCals,
+                             int iLevel = 1);
+
+    //=========================================================================================================
+    /**
+     * Decodes a data buffer.
+     *
+     * @param[in] baEncoded      The encoded buffer.
+     * @param[out] matData       The decoded data (channels x samples).
+     *
+     * @return True if the buffer could be decoded, false otherwise.
+     */
+    static bool decode(const QByteArray& baEncoded,
+                       Eigen::MatrixXf& matData);
 };
-
-inline qint32 FiffStreamThread::getID()
-{
-    return m_iDataClientId;
-}
-
-inline QString FiffStreamThread::getAlias()
-{
-    return m_sDataClientAlias;
-}
 } // NAMESPACE
 
-#endif //FIFFSTREAMTHREAD_H
+#endif // RTDATACODEC_H
@@ -51,6 +51,7 @@
 #include "metrics/weightedphaselagindex.h"
 #include "metrics/unbiasedsquaredphaselagindex.h"
 #include "metrics/debiasedsquaredweightedphaselagindex.h"
+#include "metrics/spectralmetricengine.h"
 
 //=============================================================================================================
 // QT INCLUDES
@@ -91,12 +92,36 @@ QList<Network> Connectivity::calculate(ConnectivitySettings& connectivitySetting
     QElapsedTimer timer;
     timer.start();
 
+    // Spectral methods share their tapered spectra and CSD. If more than one of them is requested compute them
+    // together in one fused pass and only reduce the results per method.
+    QMap<QString, Network> mapFusedNetworks;
+    int iNumberSpectralMethods = 0;
+
+    for(const QString& sMethod : SpectralMetricEngine::getSupportedMethods()) {
+        if(lMethods.contains(sMethod)) {
+            iNumberSpectralMethods++;
+        }
+    }
+
+    if(iNumberSpectralMethods > 1) {
+        mapFusedNetworks = SpectralMetricEngine::calculate(connectivitySettings,
+                                                           lMethods);
+    }
+
     if(lMethods.contains("WPLI")) {
-        results.append(WeightedPhaseLagIndex::calculate(connectivitySettings));
+        if(mapFusedNetworks.contains("WPLI")) {
+            results.append(mapFusedNetworks.value("WPLI"));
+        } else {
+            results.append(WeightedPhaseLagIndex::calculate(connectivitySettings));
+        }
     }
 
     if(lMethods.contains("USPLI")) {
-        results.append(UnbiasedSquaredPhaseLagIndex::calculate(connectivitySettings));
+        if(mapFusedNetworks.contains("USPLI")) {
+            results.append(mapFusedNetworks.value("USPLI"));
+        } else {
+            results.append(UnbiasedSquaredPhaseLagIndex::calculate(connectivitySettings));
+        }
     }
 
     if(lMethods.contains("COR")) {
@@ -108,23 +133,43 @@ QList<Network> Connectivity::calculate(ConnectivitySettings& connectivitySetting
     }
 
     if(lMethods.contains("PLI")) {
-        results.append(PhaseLagIndex::calculate(connectivitySettings));
+        if(mapFusedNetworks.contains("PLI")) {
+            results.append(mapFusedNetworks.value("PLI"));
+        } else {
+            results.append(PhaseLagIndex::calculate(connectivitySettings));
+        }
     }
 
     if(lMethods.contains("COH")) {
-        results.append(Coherence::calculate(connectivitySettings));
+        if(mapFusedNetworks.contains("COH")) {
+            results.append(mapFusedNetworks.value("COH"));
+        } else {
+            results.append(Coherence::calculate(connectivitySettings));
+        }
     }
 
     if(lMethods.contains("IMAGCOH")) {
-        results.append(ImagCoherence::calculate(connectivitySettings));
+        if(mapFusedNetworks.contains("IMAGCOH")) {
+            results.append(mapFusedNetworks.value("IMAGCOH"));
+        } else {
+            results.append(ImagCoherence::calculate(connectivitySettings));
+        }
     }
 
     if(lMethods.contains("PLV")) {
-        results.append(PhaseLockingValue::calculate(connectivitySettings));
+        if(mapFusedNetworks.contains("PLV")) {
+            results.append(mapFusedNetworks.value("PLV"));
+        } else {
+            results.append(PhaseLockingValue::calculate(connectivitySettings));
+        }
     }
 
     if(lMethods.contains("DSWPLI")) {
-        results.append(DebiasedSquaredWeightedPhaseLagIndex::calculate(connectivitySettings));
+        if(mapFusedNetworks.contains("DSWPLI")) {
+            results.append(mapFusedNetworks.value("DSWPLI"));
+        } else {
+            results.append(DebiasedSquaredWeightedPhaseLagIndex::calculate(connectivitySettings));
+        }
     }
 
     qWarning() << "Total" << timer.elapsed();
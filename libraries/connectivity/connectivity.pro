@@ -84,6 +84,7 @@ SOURCES += \
     metrics/weightedphaselagindex.cpp \
     metrics/debiasedsquaredweightedphaselagindex.cpp \
     metrics/phaselagindex.cpp \
+    metrics/spectralmetricengine.cpp \
     network/network.cpp \
     network/networknode.cpp \
     network/networkedge.cpp \
@@ -103,6 +104,7 @@ HEADERS += \
     metrics/weightedphaselagindex.h \
     metrics/debiasedsquaredweightedphaselagindex.h \
     metrics/phaselagindex.h \
+    metrics/spectralmetricengine.h \
     network/network.h \
     network/networknode.h \
     network/networkedge.h \
@@ -135,16 +135,8 @@ void Coherency::calculateAbs(Network& finalNetwork,
 //    timer.restart();
 
     // Compute CSD/sqrt(PSD_X * PSD_Y)
-    std::function<void(QPair<int,MatrixXcd>&)> computePSDCSDLambda = [&](QPair<int,MatrixXcd>& pairInput) {
-        computePSDCSDAbs(mutex,
-                         finalNetwork,
-                         pairInput,
-                         connectivitySettings.getIntermediateSumData().matPsdSum);
-    };
-
-    QFuture<void> resultCSDPSD = QtConcurrent::map(connectivitySettings.getIntermediateSumData().vecPairCsdSum,
-                                                   computePSDCSDLambda);
-    resultCSDPSD.waitForFinished();
+    computeCoherencyAbs(connectivitySettings,
+                        finalNetwork);
 
 //    iTime = timer.elapsed();
 //    qWarning() << "Compute" << iTime;
@@ -206,6 +198,40 @@ void Coherency::calculateImag(Network& finalNetwork,
 //    timer.restart();
 
     // Compute CSD/sqrt(PSD_X * PSD_Y)
+    computeCoherencyImag(connectivitySettings,
+                         finalNetwork);
+
+//    iTime = timer.elapsed();
+//    qWarning() << "Compute" << iTime;
+//    timer.restart();
+}
+
+//=============================================================================================================
+
+void Coherency::computeCoherencyAbs(ConnectivitySettings &connectivitySettings,
+                                    Network& finalNetwork)
+{
+    QMutex mutex;
+
+    std::function<void(QPair<int,MatrixXcd>&)> computePSDCSDLambda = [&](QPair<int,MatrixXcd>& pairInput) {
+        computePSDCSDAbs(mutex,
+                         finalNetwork,
+                         pairInput,
+                         connectivitySettings.getIntermediateSumData().matPsdSum);
+    };
+
+    QFuture<void> resultCSDPSD = QtConcurrent::map(connectivitySettings.getIntermediateSumData().vecPairCsdSum,
+                                                   computePSDCSDLambda);
+    resultCSDPSD.waitForFinished();
+}
+
+//=============================================================================================================
+
+void Coherency::computeCoherencyImag(ConnectivitySettings &connectivitySettings,
+                                     Network& finalNetwork)
+{
+    QMutex mutex;
+
     std::function<void(QPair<int,MatrixXcd>&)> computePSDCSDLambda = [&](QPair<int,MatrixXcd>& pairInput) {
         computePSDCSDImag(mutex,
                           finalNetwork,
@@ -216,10 +242,6 @@ void Coherency::calculateImag(Network& finalNetwork,
     QFuture<void> resultCSDPSD = QtConcurrent::map(connectivitySettings.getIntermediateSumData().vecPairCsdSum,
                                                    computePSDCSDLambda);
     resultCSDPSD.waitForFinished();
-
-//    iTime = timer.elapsed();
-//    qWarning() << "Compute" << iTime;
-//    timer.restart();
 }
 
 //=============================================================================================================
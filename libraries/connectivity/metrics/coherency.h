@@ -116,6 +116,26 @@ public:
     static void calculateImag(Network& finalNetwork,
                               ConnectivitySettings &connectivitySettings);
 
+    //=========================================================================================================
+    /**
+     * Reduces the summed PSD and CSD to the absolute value of coherency and adds the edges to the network.
+     *
+     * @param[in]   connectivitySettings  The input data holding the summed intermediate data.
+     * @param[out]   finalNetwork          The resulting network.
+     */
+    static void computeCoherencyAbs(ConnectivitySettings &connectivitySettings,
+                                    Network& finalNetwork);
+
+    //=========================================================================================================
+    /**
+     * Reduces the summed PSD and CSD to the imaginary part of coherency and adds the edges to the network.
+     *
+     * @param[in]   connectivitySettings  The input data holding the summed intermediate data.
+     * @param[out]   finalNetwork          The resulting network.
+     */
+    static void computeCoherencyImag(ConnectivitySettings &connectivitySettings,
+                                     Network& finalNetwork);
+
 private:
     //=========================================================================================================
     /**
@@ -123,24 +123,56 @@ Network CrossCorrelation::calculate(ConnectivitySettings& connectivitySettings)
 
     QPair<MatrixXd, VectorXd> tapers = Spectral::generateTapers(iSignalLength, connectivitySettings.getWindowType());
 
-    // Compute the cross correlation in parallel
-    QMutex mutex;
-    MatrixXd matDist;
+    // Compute the taper averaged spectra of all trials in parallel
+    QList<ConnectivitySettings::IntermediateTrialData>& lTrialData = connectivitySettings.getTrialData();
+    QVector<ConnectivitySettings::IntermediateTrialData*> vecTrialData;
+    QVector<int> vecTrialIndices;
+
+    for(int i = 0; i < lTrialData.size(); ++i) {
+        vecTrialData.append(&lTrialData[i]);
+        vecTrialIndices.append(i);
+    }
 
-    std::function<void(ConnectivitySettings::IntermediateTrialData&)> computeLambda = [&](ConnectivitySettings::IntermediateTrialData& inputData) {
-        compute(inputData,
-                matDist,
-                mutex,
-                iNfft,
-                tapers);
+    QVector<MatrixXcd> vecSpectra(lTrialData.size());
+
+    std::function<void(int&)> computeSpectraLambda = [&](int& iTrial) {
+        vecSpectra[iTrial] = computeSpectra(*vecTrialData.at(iTrial),
+                                            iNfft,
+                                            tapers);
     };
 
 //    iTime = timer.elapsed();
 //    qWarning() << "Preparation" << iTime;
 //    timer.restart();
 
+    QFuture<void> resultSpectra = QtConcurrent::map(vecTrialIndices,
+                                                    computeSpectraLambda);
+    resultSpectra.waitForFinished();
+
+    // Split the upper triangle of each trial into blocks of rows and compute the blocks of all trials in parallel
+    const int iRowsPerBlock = 8;
+    QVector<QPair<int,int> > vecBlocks;
+
+    for(int i = 0; i < lTrialData.size(); ++i) {
+        for(int j = 0; j < rows; j += iRowsPerBlock) {
+            vecBlocks.append(QPair<int,int>(i,j));
+        }
+    }
+
+    QMutex mutex;
+    MatrixXd matDist = MatrixXd::Zero(rows, rows);
+
+    std::function<void(QPair<int,int>&)> computeLambda = [&](QPair<int,int>& pairBlock) {
+        compute(vecSpectra.at(pairBlock.first),
+                matDist,
+                mutex,
+                pairBlock.second,
+                std::min(pairBlock.second + iRowsPerBlock, rows),
+                iNfft);
+    };
+
     // Calculate connectivity matrix over epochs and average afterwards
-    QFuture<void> resultMat = QtConcurrent::map(connectivitySettings.getTrialData(),
+    QFuture<void> resultMat = QtConcurrent::map(vecBlocks,
                                                 computeLambda);
     resultMat.waitForFinished();
 
@@ -176,17 +208,10 @@ Network CrossCorrelation::calculate(ConnectivitySettings& connectivitySettings)
 
 //=============================================================================================================
 
-void CrossCorrelation::compute(ConnectivitySettings::IntermediateTrialData& inputData,
-                               MatrixXd& matDist,
-                               QMutex& mutex,
-                               int iNfft,
-                               const QPair<MatrixXd, VectorXd>& tapers)
+MatrixXcd CrossCorrelation::computeSpectra(ConnectivitySettings::IntermediateTrialData& inputData,
+                                           int iNfft,
+                                           const QPair<MatrixXd, VectorXd>& tapers)
 {
-//    QElapsedTimer timer;
-//    qint64 iTime = 0;
-//    timer.start();
-
-    // Calculate tapered spectra if not available already
     RowVectorXd vecInputFFT, rowData;
     RowVectorXcd vecResultFreq;
 
@@ -195,11 +220,11 @@ void CrossCorrelation::compute(ConnectivitySettings::IntermediateTrialData& inpu
 
     int i, j;
     int iNRows = inputData.matData.rows();
+    int iNFreqs = int(floor(iNfft / 2.0)) + 1;
 
     // Calculate tapered spectra if not available already
     // This code was copied and changed modified Utils/Spectra since we do not want to call the function due to time loss.
     if(inputData.vecTapSpectra.isEmpty()) {
-        int iNFreqs = int(floor(iNfft / 2.0)) + 1;
         MatrixXcd matTapSpectrum(tapers.first.rows(), iNFreqs);
 
         for (i = 0; i < iNRows; ++i) {
@@ -225,52 +250,64 @@ void CrossCorrelation::compute(ConnectivitySettings::IntermediateTrialData& inpu
         }
     }
 
-//    iTime = timer.elapsed();
-//    qDebug() << QThread::currentThreadId() << "CrossCorrelation::compute timer - Tapered spectra:" << iTime;
-//    timer.restart();
-
-    // Perform multiplication and transform back to time domain to find max XCOR coefficient
-    // Note that the result in time domain is mirrored around the center of the data (compared to Matlab)
-    MatrixXd matDistTrial = MatrixXd::Zero(iNRows, iNRows);
-    RowVectorXcd vecResultXCor;
-    int idx = 0;
+    // Average over tapers once per row instead of once per pair
+    MatrixXcd matSpectra(inputData.vecTapSpectra.size(), iNFreqs);
     double denom = tapers.second.sum();
 
     for(i = 0; i < inputData.vecTapSpectra.size(); ++i) {
-        vecResultFreq = inputData.vecTapSpectra.at(i).colwise().sum() / denom;
+        matSpectra.row(i) = inputData.vecTapSpectra.at(i).colwise().sum() / denom;
+    }
 
-        for(j = i; j < inputData.vecTapSpectra.size(); ++j) {
-            vecResultXCor = vecResultFreq.cwiseProduct(inputData.vecTapSpectra.at(j).colwise().sum() / denom);
+    if(!m_bStorageModeIsActive) {
+        inputData.vecTapSpectra.clear();
+    }
 
-            fft.inv(vecInputFFT, vecResultXCor, iNfft);
+    return matSpectra;
+}
 
-            vecInputFFT.maxCoeff(&idx);
+//=============================================================================================================
 
-            matDistTrial(i,j) = vecInputFFT(idx);
-        }
-    }
+void CrossCorrelation::compute(const MatrixXcd& matSpectra,
+                               MatrixXd& matDist,
+                               QMutex& mutex,
+                               int iRowStart,
+                               int iRowEnd,
+                               int iNfft)
+{
+    // The plan of the inverse FFT is reused for all pairs of the block
+    FFT<double> fft;
+    fft.SetFlag(fft.HalfSpectrum);
 
-//    iTime = timer.elapsed();
-//    qDebug() << QThread::currentThreadId() << "CrossCorrelation::compute timer - Multiplication and inv FFT:" << iTime;
-//    timer.restart();
+    int i, j;
+    int iNRows = matSpectra.rows();
+    int iNPairs;
+    int idx = 0;
 
-    // Sum up weights
-    mutex.lock();
+    // Row major storage so every pair is contiguous in memory and can directly be passed to the inverse FFT
+    Matrix<std::complex<double>, Dynamic, Dynamic, RowMajor> matResultXCor;
+    Matrix<double, Dynamic, Dynamic, RowMajor> matResultTime(iNRows - iRowStart, iNfft);
+    RowVectorXcd vecResultFreq;
+    MatrixXd matDistBlock = MatrixXd::Zero(iRowEnd - iRowStart, iNRows);
 
-    if(matDist.rows() != matDistTrial.rows() || matDist.cols() != matDistTrial.cols()) {
-        matDist.resize(matDistTrial.rows(), matDistTrial.cols());
-        matDist.setZero();
-    }
+    // Perform multiplication and transform back to time domain to find max XCOR coefficient
+    // Note that the result in time domain is mirrored around the center of the data (compared to Matlab)
+    for(i = iRowStart; i < iRowEnd; ++i) {
+        iNPairs = iNRows - i;
+        vecResultFreq = matSpectra.row(i);
 
-    matDist += matDistTrial;
+        matResultXCor = vecResultFreq.replicate(iNPairs, 1).cwiseProduct(matSpectra.bottomRows(iNPairs));
 
-    mutex.unlock();
+        for(j = 0; j < iNPairs; ++j) {
+            fft.inv(matResultTime.row(j).data(), matResultXCor.row(j).data(), iNfft);
 
-//    iTime = timer.elapsed();
-//    qDebug() << QThread::currentThreadId() << "CrossCorrelation::compute timer - Summing up matDist:" << iTime;
-//    timer.restart();
+            matResultTime.row(j).maxCoeff(&idx);
 
-    if(!m_bStorageModeIsActive) {
-        inputData.vecTapSpectra.clear();
+            matDistBlock(i - iRowStart, i + j) = matResultTime(j, idx);
+        }
     }
+
+    // Sum up weights
+    mutex.lock();
+    matDist.middleRows(iRowStart, iRowEnd - iRowStart) += matDistBlock;
+    mutex.unlock();
 }
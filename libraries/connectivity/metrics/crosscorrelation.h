@@ -105,19 +105,36 @@ public:
 protected:
     //=========================================================================================================
     /**
-     * Calculates the connectivity matrix for a given input data matrix based on the cross correlation coefficient.
+     * Computes the taper averaged spectra of all rows of one trial. This function gets called in parallel.
      *
      * @param[in]   inputData           The input data.
+     * @param[in]   iNfft               The FFT length.
+     * @param[in]   tapers              The taper information.
+     *
+     * @return The taper averaged half spectra, one row per data row.
+     */
+    static Eigen::MatrixXcd computeSpectra(ConnectivitySettings::IntermediateTrialData& inputData,
+                                           int iNfft,
+                                           const QPair<Eigen::MatrixXd, Eigen::VectorXd>& tapers);
+
+    //=========================================================================================================
+    /**
+     * Calculates the cross correlation coefficients of the rows iRowStart to iRowEnd-1 with all following rows of
+     * one trial and adds them to the connectivity matrix. This function gets called in parallel.
+     *
+     * @param[in]   matSpectra          The taper averaged spectra of the trial.
      * @param[out]   matDist             The sum of all edge weights.
      * @param[in]   mutex               The mutex used to safely access matDist.
+     * @param[in]   iRowStart           The first row of the block.
+     * @param[in]   iRowEnd             The row after the last row of the block.
      * @param[in]   iNfft               The FFT length.
-     * @param[in]   tapers              The taper information.
      */
-    static void compute(ConnectivitySettings::IntermediateTrialData& inputData,
+    static void compute(const Eigen::MatrixXcd& matSpectra,
                         Eigen::MatrixXd& matDist,
                         QMutex& mutex,
-                        int iNfft,
-                        const QPair<Eigen::MatrixXd, Eigen::VectorXd>& tapers);
+                        int iRowStart,
+                        int iRowEnd,
+                        int iNfft);
 };
 
 //=============================================================================================================
@@ -106,6 +106,16 @@ public:
      */
     static Network calculate(ConnectivitySettings &connectivitySettings);
 
+    //=========================================================================================================
+    /**
+     * Reduces the DSWPLI computation to a final result.
+     *
+     * @param[out] connectivitySettings   The input data.
+     * @param[in] finalNetwork           The final network.
+     */
+    static void computeDSWPLI(ConnectivitySettings &connectivitySettings,
+                              Network& finalNetwork);
+
 protected:
     //=========================================================================================================
     /**
@@ -130,16 +140,6 @@ protected:
                         int iNFreqs,
                         int iNfft,
                         const QPair<Eigen::MatrixXd, Eigen::VectorXd>& tapers);
-
-    //=========================================================================================================
-    /**
-     * Reduces the DSWPLI computation to a final result.
-     *
-     * @param[out] connectivitySettings   The input data.
-     * @param[in] finalNetwork           The final network.
-     */
-    static void computeDSWPLI(ConnectivitySettings &connectivitySettings,
-                              Network& finalNetwork);
 };
 
 //=============================================================================================================
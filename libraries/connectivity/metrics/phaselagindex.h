@@ -106,6 +106,16 @@ public:
      */
     static Network calculate(ConnectivitySettings& connectivitySettings);
 
+    //=========================================================================================================
+    /**
+     * Reduces the PLI computation to a final result.
+     *
+     * @param[out] connectivitySettings   The input data.
+     * @param[in] finalNetwork           The final network.
+     */
+    static void computePLI(ConnectivitySettings &connectivitySettings,
+                          Network& finalNetwork);
+
 protected:
     //=========================================================================================================
     /**
@@ -128,16 +138,6 @@ protected:
                         int iNFreqs,
                         int iNfft,
                         const QPair<Eigen::MatrixXd, Eigen::VectorXd>& tapers);
-
-    //=========================================================================================================
-    /**
-     * Reduces the PLI computation to a final result.
-     *
-     * @param[out] connectivitySettings   The input data.
-     * @param[in] finalNetwork           The final network.
-     */
-    static void computePLI(ConnectivitySettings &connectivitySettings,
-                          Network& finalNetwork);
 };
 
 //=============================================================================================================
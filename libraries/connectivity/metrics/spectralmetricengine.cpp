@@ -0,0 +1,519 @@
+//=============================================================================================================
+/**
+ * @file     spectralmetricengine.cpp
+ * @author   agent <agent@local>
+ * @since    0.1.9
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, agent. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    SpectralMetricEngine class definition.
+ *
+ */
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include "spectralmetricengine.h"
+#include "coherency.h"
+#include "phaselagindex.h"
+#include "phaselockingvalue.h"
+#include "weightedphaselagindex.h"
+#include "unbiasedsquaredphaselagindex.h"
+#include "debiasedsquaredweightedphaselagindex.h"
+#include "network/networknode.h"
+#include "network/networkedge.h"
+#include "network/network.h"
+
+#include <utils/spectral.h>
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QDebug>
+#include <QtConcurrent>
+
+//=============================================================================================================
+// EIGEN INCLUDES
+//=============================================================================================================
+
+#include <unsupported/Eigen/FFT>
+
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace CONNECTIVITYLIB;
+using namespace Eigen;
+using namespace UTILSLIB;
+
+//=============================================================================================================
+// DEFINE GLOBAL METHODS
+//=============================================================================================================
+
+namespace {
+
+template<typename T>
+void initPairSum(QVector<QPair<int,T> >& vecPairSum,
+                 int iNRows,
+                 int iNBins)
+{
+    if(vecPairSum.size() == iNRows) {
+        return;
+    }
+
+    vecPairSum.clear();
+
+    for(int i = 0; i < iNRows; ++i) {
+        vecPairSum.append(QPair<int,T>(i, T::Zero(iNRows, iNBins)));
+    }
+}
+
+//=============================================================================================================
+
+template<typename T>
+void appendPairRow(QVector<QPair<int,T> >& vecPair,
+                   int i,
+                   const T& matRows,
+                   int iNRows)
+{
+    // Only rows i to iNRows-1 hold valid pairs. Keep the full size so the trial can be subtracted from the sum later on.
+    T matPair = T::Zero(iNRows, matRows.cols());
+    matPair.bottomRows(matRows.rows()) = matRows;
+    vecPair.append(QPair<int,T>(i, matPair));
+}
+
+} // namespace
+
+//=============================================================================================================
+// DEFINE MEMBER METHODS
+//=============================================================================================================
+
+SpectralMetricEngine::SpectralMetricEngine()
+: AbstractMetric()
+{
+}
+
+//=============================================================================================================
+
+QStringList SpectralMetricEngine::getSupportedMethods()
+{
+    return QStringList() << "WPLI" << "USPLI" << "PLI" << "COH" << "IMAGCOH" << "PLV" << "DSWPLI";
+}
+
+//=============================================================================================================
+
+QMap<QString, Network> SpectralMetricEngine::calculate(ConnectivitySettings& connectivitySettings,
+                                                       const QStringList& lMethods)
+{
+    QMap<QString, Network> mapNetworks;
+
+    QStringList lFusedMethods;
+    for(const QString& sMethod : getSupportedMethods()) {
+        if(lMethods.contains(sMethod)) {
+            lFusedMethods << sMethod;
+        }
+    }
+
+    if(lFusedMethods.isEmpty()) {
+        return mapNetworks;
+    }
+
+    if(connectivitySettings.isEmpty()) {
+        qWarning() << "SpectralMetricEngine::calculate - Input data is empty";
+        return mapNetworks;
+    }
+
+    if(AbstractMetric::m_bStorageModeIsActive == false) {
+        connectivitySettings.clearIntermediateData();
+    }
+
+    #ifdef EIGEN_FFTW_DEFAULT
+        fftw_make_planner_thread_safe();
+    #endif
+
+    int iSignalLength = connectivitySettings.at(0).matData.cols();
+    int iNfft = connectivitySettings.getFFTSize();
+
+    // Generate tapers
+    QPair<MatrixXd, VectorXd> tapers = Spectral::generateTapers(iSignalLength, connectivitySettings.getWindowType());
+
+    // Initialize
+    int iNRows = connectivitySettings.at(0).matData.rows();
+    int iNFreqs = int(floor(iNfft / 2.0)) + 1;
+
+    // Check if start and bin amount need to be reset to full spectrum
+    if(m_iNumberBinStart == -1 ||
+       m_iNumberBinAmount == -1 ||
+       m_iNumberBinStart > iNFreqs ||
+       m_iNumberBinAmount > iNFreqs ||
+       m_iNumberBinAmount + m_iNumberBinStart > iNFreqs) {
+        qDebug() << "SpectralMetricEngine::calculate - Resetting to full spectrum";
+        AbstractMetric::m_iNumberBinStart = 0;
+        AbstractMetric::m_iNumberBinAmount = iNFreqs;
+    }
+
+    // Only accumulate what the requested methods need. The CSD itself is always summed up since the metric classes
+    // rely on vecPairCsdSum being complete whenever a trial holds its CSD.
+    RequiredData requiredData;
+    requiredData.bPsd = lFusedMethods.contains("COH") || lFusedMethods.contains("IMAGCOH");
+    requiredData.bImagSign = lFusedMethods.contains("PLI") || lFusedMethods.contains("USPLI");
+    requiredData.bImagAbs = lFusedMethods.contains("WPLI") || lFusedMethods.contains("DSWPLI");
+    requiredData.bImagSqrd = lFusedMethods.contains("DSWPLI");
+    requiredData.bNormalized = lFusedMethods.contains("PLV");
+
+    ConnectivitySettings::IntermediateSumData& sumData = connectivitySettings.getIntermediateSumData();
+
+    initPairSum(sumData.vecPairCsdSum, iNRows, m_iNumberBinAmount);
+
+    if(requiredData.bPsd && sumData.matPsdSum.rows() != iNRows) {
+        sumData.matPsdSum = MatrixXd::Zero(iNRows, m_iNumberBinAmount);
+    }
+    if(requiredData.bImagSign) {
+        initPairSum(sumData.vecPairCsdImagSignSum, iNRows, m_iNumberBinAmount);
+    }
+    if(requiredData.bImagAbs) {
+        initPairSum(sumData.vecPairCsdImagAbsSum, iNRows, m_iNumberBinAmount);
+    }
+    if(requiredData.bImagSqrd) {
+        initPairSum(sumData.vecPairCsdImagSqrdSum, iNRows, m_iNumberBinAmount);
+    }
+    if(requiredData.bNormalized) {
+        initPairSum(sumData.vecPairCsdNormalizedSum, iNRows, m_iNumberBinAmount);
+    }
+
+    // Lock the sums row wise so that trials being processed in parallel rarely wait on each other
+    std::vector<QMutex> vecRowMutex(iNRows);
+    QMutex mutex;
+
+    std::function<void(ConnectivitySettings::IntermediateTrialData&)> computeLambda = [&](ConnectivitySettings::IntermediateTrialData& inputData) {
+        compute(inputData,
+                sumData,
+                vecRowMutex,
+                mutex,
+                requiredData,
+                iNRows,
+                iNFreqs,
+                iNfft,
+                tapers);
+    };
+
+    // Compute the intermediate data in parallel for all trials
+    QFuture<void> result = QtConcurrent::map(connectivitySettings.getTrialData(),
+                                             computeLambda);
+    result.waitForFinished();
+
+    // Reduce the intermediate sums to the final networks
+    for(const QString& sMethod : lFusedMethods) {
+        Network finalNetwork = createNetwork(sMethod,
+                                             connectivitySettings,
+                                             iNFreqs);
+
+        if(sMethod == "WPLI") {
+            WeightedPhaseLagIndex::computeWPLI(connectivitySettings,
+                                               finalNetwork);
+        } else if(sMethod == "USPLI") {
+            UnbiasedSquaredPhaseLagIndex::computeUSPLI(connectivitySettings,
+                                                       finalNetwork);
+        } else if(sMethod == "PLI") {
+            PhaseLagIndex::computePLI(connectivitySettings,
+                                      finalNetwork);
+        } else if(sMethod == "COH") {
+            Coherency::computeCoherencyAbs(connectivitySettings,
+                                           finalNetwork);
+        } else if(sMethod == "IMAGCOH") {
+            Coherency::computeCoherencyImag(connectivitySettings,
+                                            finalNetwork);
+        } else if(sMethod == "PLV") {
+            PhaseLockingValue::computePLV(connectivitySettings,
+                                          finalNetwork);
+        } else if(sMethod == "DSWPLI") {
+            DebiasedSquaredWeightedPhaseLagIndex::computeDSWPLI(connectivitySettings,
+                                                                finalNetwork);
+        }
+
+        mapNetworks.insert(sMethod, finalNetwork);
+    }
+
+    return mapNetworks;
+}
+
+//=============================================================================================================
+
+void SpectralMetricEngine::compute(ConnectivitySettings::IntermediateTrialData& inputData,
+                                   ConnectivitySettings::IntermediateSumData& sumData,
+                                   std::vector<QMutex>& vecRowMutex,
+                                   QMutex& mutex,
+                                   const RequiredData& requiredData,
+                                   int iNRows,
+                                   int iNFreqs,
+                                   int iNfft,
+                                   const QPair<MatrixXd, VectorXd>& tapers)
+{
+    // In storage mode a trial may already hold parts of the intermediate data from earlier calls
+    bool bComputeCsd = inputData.vecPairCsd.size() != iNRows;
+    bool bComputePsd = requiredData.bPsd && inputData.matPsd.rows() != iNRows;
+    bool bComputeImagSign = requiredData.bImagSign && inputData.vecPairCsdImagSign.size() != iNRows;
+    bool bComputeImagAbs = requiredData.bImagAbs && inputData.vecPairCsdImagAbs.size() != iNRows;
+    bool bComputeImagSqrd = requiredData.bImagSqrd && inputData.vecPairCsdImagSqrd.size() != iNRows;
+    bool bComputeNormalized = requiredData.bNormalized && inputData.vecPairCsdNormalized.size() != iNRows;
+
+    if(!bComputeCsd && !bComputePsd && !bComputeImagSign && !bComputeImagAbs && !bComputeImagSqrd && !bComputeNormalized) {
+        return;
+    }
+
+    int i,j,k;
+    int iNTapers = tapers.first.rows();
+    int iNBins = m_iNumberBinAmount;
+
+    // Calculate tapered spectra if not available already
+    if((bComputeCsd || bComputePsd) && inputData.vecTapSpectra.size() != iNRows) {
+        inputData.vecTapSpectra.clear();
+
+        RowVectorXd vecInputFFT, rowData;
+        RowVectorXcd vecTmpFreq;
+
+        MatrixXcd matTapSpectrum(iNTapers, iNFreqs);
+
+        FFT<double> fft;
+        fft.SetFlag(fft.HalfSpectrum);
+
+        for (i = 0; i < iNRows; ++i) {
+            // Substract mean
+            rowData.array() = inputData.matData.row(i).array() - inputData.matData.row(i).mean();
+
+            for(j = 0; j < iNTapers; j++) {
+                // Zero padd if necessary. The zero padding in Eigen's FFT is only working for column vectors.
+                if (rowData.cols() < iNfft) {
+                    vecInputFFT.setZero(iNfft);
+                    vecInputFFT.block(0,0,1,rowData.cols()) = rowData.cwiseProduct(tapers.first.row(j));
+                } else {
+                    vecInputFFT = rowData.cwiseProduct(tapers.first.row(j));
+                }
+
+                // FFT for freq domain returning the half spectrum and multiply taper weights
+                fft.fwd(vecTmpFreq, vecInputFFT, iNfft);
+                matTapSpectrum.row(j) = vecTmpFreq * tapers.second(j);
+            }
+
+            inputData.vecTapSpectra.append(matTapSpectrum);
+        }
+    }
+
+    // Divide first and last element by 2 due to half spectrum
+    bool bHalveFirstBin = m_iNumberBinStart == 0;
+    bool bHalveLastBin = iNfft % 2 == 0 && m_iNumberBinStart + m_iNumberBinAmount >= iNFreqs;
+
+    // Compute PSD
+    if(bComputePsd) {
+        double denomPSD = tapers.second.cwiseAbs2().sum() / 2.0;
+
+        MatrixXd matPsd(iNRows, iNBins);
+
+        for (i = 0; i < iNRows; ++i) {
+            matPsd.row(i) = inputData.vecTapSpectra.at(i).block(0,m_iNumberBinStart,iNTapers,iNBins).cwiseAbs2().colwise().sum() / denomPSD;
+        }
+
+        if(bHalveFirstBin) {
+            matPsd.col(0) /= 2.0;
+        }
+
+        if(bHalveLastBin) {
+            matPsd.rightCols(1) /= 2.0;
+        }
+
+        mutex.lock();
+        sumData.matPsdSum += matPsd;
+        mutex.unlock();
+
+        if(m_bStorageModeIsActive) {
+            inputData.matPsd = matPsd;
+        }
+    }
+
+    if(!bComputeCsd && !bComputeImagSign && !bComputeImagAbs && !bComputeImagSqrd && !bComputeNormalized) {
+        if(!m_bStorageModeIsActive) {
+            inputData.vecTapSpectra.clear();
+        }
+        return;
+    }
+
+    // Rearrange the used frequency bins per taper so that the CSD of one row with all following rows can be computed
+    // at once
+    QVector<MatrixXcd> vecTaperSpectra;
+
+    if(bComputeCsd) {
+        for(k = 0; k < iNTapers; ++k) {
+            MatrixXcd matTaperSpectrum(iNRows, iNBins);
+
+            for (i = 0; i < iNRows; ++i) {
+                matTaperSpectrum.row(i) = inputData.vecTapSpectra.at(i).block(k,m_iNumberBinStart,1,iNBins);
+            }
+
+            vecTaperSpectra.append(matTaperSpectrum);
+        }
+    }
+
+    double denomCSD = sqrt(tapers.second.cwiseAbs2().sum()) * sqrt(tapers.second.cwiseAbs2().sum()) / 2.0;
+
+    MatrixXcd matCsd = MatrixXcd::Zero(iNRows, iNBins);
+    MatrixXd matImagSign, matImagAbs, matImagSqrd;
+    MatrixXcd matNormalized;
+    RowVectorXcd rowSpectrum;
+    int iNPairs;
+
+    for (i = 0; i < iNRows; ++i) {
+        // Only the pairs (i,j) with j >= i are computed. They are stored in the bottom rows of matCsd.
+        iNPairs = iNRows - i;
+
+        if(bComputeCsd) {
+            // Compute CSD (average over tapers if necessary)
+            for(k = 0; k < iNTapers; ++k) {
+                rowSpectrum = vecTaperSpectra.at(k).row(i);
+
+                if(k == 0) {
+                    matCsd.bottomRows(iNPairs) = (vecTaperSpectra.at(k).bottomRows(iNPairs).conjugate().array().rowwise() * rowSpectrum.array()).matrix();
+                } else {
+                    matCsd.bottomRows(iNPairs) += (vecTaperSpectra.at(k).bottomRows(iNPairs).conjugate().array().rowwise() * rowSpectrum.array()).matrix();
+                }
+            }
+
+            matCsd.bottomRows(iNPairs) /= denomCSD;
+
+            if(bHalveFirstBin) {
+                matCsd.bottomRows(iNPairs).col(0) /= 2.0;
+            }
+
+            if(bHalveLastBin) {
+                matCsd.bottomRows(iNPairs).rightCols(1) /= 2.0;
+            }
+        } else {
+            matCsd = inputData.vecPairCsd.at(i).second;
+        }
+
+        // Derive the intermediate data of all requested methods from the same CSD
+        if(bComputeImagSign) {
+            matImagSign = matCsd.bottomRows(iNPairs).imag().cwiseSign();
+        }
+
+        if(bComputeImagAbs) {
+            matImagAbs = matCsd.bottomRows(iNPairs).imag().cwiseAbs();
+        }
+
+        if(bComputeImagSqrd) {
+            matImagSqrd = matCsd.bottomRows(iNPairs).imag().array().square();
+        }
+
+        if(bComputeNormalized) {
+            matNormalized = matCsd.bottomRows(iNPairs).cwiseQuotient(matCsd.bottomRows(iNPairs).cwiseAbs());
+        }
+
+        vecRowMutex[i].lock();
+
+        if(bComputeCsd) {
+            sumData.vecPairCsdSum[i].second.bottomRows(iNPairs) += matCsd.bottomRows(iNPairs);
+        }
+
+        if(bComputeImagSign) {
+            sumData.vecPairCsdImagSignSum[i].second.bottomRows(iNPairs) += matImagSign;
+        }
+
+        if(bComputeImagAbs) {
+            sumData.vecPairCsdImagAbsSum[i].second.bottomRows(iNPairs) += matImagAbs;
+        }
+
+        if(bComputeImagSqrd) {
+            sumData.vecPairCsdImagSqrdSum[i].second.bottomRows(iNPairs) += matImagSqrd;
+        }
+
+        if(bComputeNormalized) {
+            sumData.vecPairCsdNormalizedSum[i].second.bottomRows(iNPairs) += matNormalized;
+        }
+
+        vecRowMutex[i].unlock();
+
+        // Keep the intermediate data of this trial only if it is needed to remove the trial from the sums later on
+        if(m_bStorageModeIsActive) {
+            if(bComputeCsd) {
+                inputData.vecPairCsd.append(QPair<int,MatrixXcd>(i,matCsd));
+            }
+
+            if(bComputeImagSign) {
+                appendPairRow(inputData.vecPairCsdImagSign, i, matImagSign, iNRows);
+            }
+
+            if(bComputeImagAbs) {
+                appendPairRow(inputData.vecPairCsdImagAbs, i, matImagAbs, iNRows);
+            }
+
+            if(bComputeImagSqrd) {
+                appendPairRow(inputData.vecPairCsdImagSqrd, i, matImagSqrd, iNRows);
+            }
+
+            if(bComputeNormalized) {
+                appendPairRow(inputData.vecPairCsdNormalized, i, matNormalized, iNRows);
+            }
+        }
+    }
+
+    //Do not store data to save memory
+    if(!m_bStorageModeIsActive) {
+        inputData.vecTapSpectra.clear();
+    }
+}
+
+//=============================================================================================================
+
+Network SpectralMetricEngine::createNetwork(const QString& sConnectivityMethod,
+                                            ConnectivitySettings& connectivitySettings,
+                                            int iNFreqs)
+{
+    Network finalNetwork(sConnectivityMethod);
+
+    finalNetwork.setSamplingFrequency(connectivitySettings.getSamplingFrequency());
+
+    // Pass information about the FFT length. Use iNFreqs because we only use the half spectrum
+    finalNetwork.setFFTSize(iNFreqs);
+    finalNetwork.setUsedFreqBins(AbstractMetric::m_iNumberBinAmount);
+
+    //Create nodes
+    int rows = connectivitySettings.at(0).matData.rows();
+    RowVectorXf rowVert = RowVectorXf::Zero(3);
+
+    for(int i = 0; i < rows; ++i) {
+        rowVert = RowVectorXf::Zero(3);
+
+        if(connectivitySettings.getNodePositions().rows() != 0 && i < connectivitySettings.getNodePositions().rows()) {
+            rowVert(0) = connectivitySettings.getNodePositions().row(i)(0);
+            rowVert(1) = connectivitySettings.getNodePositions().row(i)(1);
+            rowVert(2) = connectivitySettings.getNodePositions().row(i)(2);
+        }
+
+        finalNetwork.append(NetworkNode::SPtr(new NetworkNode(i, rowVert)));
+    }
+
+    return finalNetwork;
+}
@@ -0,0 +1,180 @@
+//=============================================================================================================
+/**
+ * @file     spectralmetricengine.h
+ * @author   agent <agent@local>
+ * @since    0.1.9
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, agent. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    SpectralMetricEngine class declaration.
+ *
+ */
+
+#ifndef SPECTRALMETRICENGINE_H
+#define SPECTRALMETRICENGINE_H
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include "../connectivity_global.h"
+
+#include "abstractmetric.h"
+#include "../connectivitysettings.h"
+
+#include <vector>
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QSharedPointer>
+#include <QMutex>
+#include <QMap>
+#include <QStringList>
+
+//=============================================================================================================
+// EIGEN INCLUDES
+//=============================================================================================================
+
+#include <Eigen/Core>
+
+//=============================================================================================================
+// FORWARD DECLARATIONS
+//=============================================================================================================
+
+//=============================================================================================================
+// DEFINE NAMESPACE CONNECTIVITYLIB
+//=============================================================================================================
+
+namespace CONNECTIVITYLIB {
+
+//=============================================================================================================
+// CONNECTIVITYLIB FORWARD DECLARATIONS
+//=============================================================================================================
+
+class Network;
+
+//=============================================================================================================
+/**
+ * This class computes several spectral connectivity metrics (WPLI, USPLI, PLI, COH, IMAGCOH, PLV, DSWPLI) in one
+ * fused pass. The tapered spectra of each trial are computed once and the cross spectral density of every channel
+ * pair is derived once, while the intermediate sums needed by all requested metrics are accumulated together. The
+ * metric classes are then only used to reduce these sums to their final networks.
+ *
+ * @brief This class computes several spectral connectivity metrics in one fused pass.
+ */
+class CONNECTIVITYSHARED_EXPORT SpectralMetricEngine : public AbstractMetric
+{
+
+public:
+    typedef QSharedPointer<SpectralMetricEngine> SPtr;            /**< Shared pointer type for SpectralMetricEngine. */
+    typedef QSharedPointer<const SpectralMetricEngine> ConstSPtr; /**< Const shared pointer type for SpectralMetricEngine. */
+
+    //=========================================================================================================
+    /**
+     * Constructs a SpectralMetricEngine object.
+     */
+    explicit SpectralMetricEngine();
+
+    //=========================================================================================================
+    /**
+     * Returns the methods which can be computed by the fused pass.
+     *
+     * @return The list of supported connectivity methods.
+     */
+    static QStringList getSupportedMethods();
+
+    //=========================================================================================================
+    /**
+     * Calculates all supported methods in lMethods with one fused pass over the trials.
+     *
+     * @param[in] connectivitySettings   The input data and parameters.
+     * @param[in] lMethods               The requested connectivity methods. Unsupported methods are ignored.
+     *
+     * @return The resulting networks, mapped by their connectivity method.
+     */
+    static QMap<QString, Network> calculate(ConnectivitySettings& connectivitySettings,
+                                            const QStringList& lMethods);
+
+protected:
+    //=========================================================================================================
+    /**
+     * The intermediate data which needs to be accumulated for the requested methods.
+     */
+    struct RequiredData {
+        bool bPsd;          /**< Whether the PSD is needed (COH, IMAGCOH). */
+        bool bImagSign;     /**< Whether the sign of the imaginary CSD is needed (PLI, USPLI). */
+        bool bImagAbs;      /**< Whether the absolute imaginary CSD is needed (WPLI, DSWPLI). */
+        bool bImagSqrd;     /**< Whether the squared imaginary CSD is needed (DSWPLI). */
+        bool bNormalized;   /**< Whether the normalized CSD is needed (PLV). */
+    };
+
+    //=========================================================================================================
+    /**
+     * Computes the tapered spectra, PSD and CSD of one trial and adds everything the requested methods need to the
+     * intermediate sums. This function gets called in parallel.
+     *
+     * @param[in] inputData          The input data.
+     * @param[out] sumData           The intermediate sums.
+     * @param[in] vecRowMutex        One mutex per row of the intermediate sums.
+     * @param[in] mutex              The mutex used to safely access the PSD sum.
+     * @param[in] requiredData       The intermediate data needed by the requested methods.
+     * @param[in] iNRows             The number of rows.
+     * @param[in] iNFreqs            The number of frequenciy bins.
+     * @param[in] iNfft              The FFT length.
+     * @param[in] tapers             The taper information.
+     */
+    static void compute(ConnectivitySettings::IntermediateTrialData& inputData,
+                        ConnectivitySettings::IntermediateSumData& sumData,
+                        std::vector<QMutex>& vecRowMutex,
+                        QMutex& mutex,
+                        const RequiredData& requiredData,
+                        int iNRows,
+                        int iNFreqs,
+                        int iNfft,
+                        const QPair<Eigen::MatrixXd, Eigen::VectorXd>& tapers);
+
+    //=========================================================================================================
+    /**
+     * Creates an empty network with one node per row of the input data.
+     *
+     * @param[in] sConnectivityMethod    The connectivity method of the network.
+     * @param[in] connectivitySettings   The input data and parameters.
+     * @param[in] iNFreqs                The number of frequenciy bins of the half spectrum.
+     *
+     * @return The network holding only the nodes.
+     */
+    static Network createNetwork(const QString& sConnectivityMethod,
+                                 ConnectivitySettings& connectivitySettings,
+                                 int iNFreqs);
+};
+
+//=============================================================================================================
+// INLINE DEFINITIONS
+//=============================================================================================================
+} // namespace CONNECTIVITYLIB
+
+#endif // SPECTRALMETRICENGINE_H
@@ -86,6 +86,8 @@ FilterDesignView::FilterDesignView(const QString& sSettingsPath,
 : AbstractView(parent, f)
 , m_pUi(new Ui::FilterDesignViewWidget)
 , m_iFilterTaps(512)
+, m_iMaxFilterTaps(4096)
+, m_iIirOrder(4)
 , m_dSFreq(600)
 {
     m_sSettingsPath = sSettingsPath;
@@ -117,8 +119,13 @@ void FilterDesignView::setMaxAllowedFilterTaps(int iMaxNumberFilterTaps)
         iMaxNumberFilterTaps--;
     }
 
-    m_pUi->m_spinBox_filterTaps->setMaximum(iMaxNumberFilterTaps);
-    m_pUi->m_spinBox_filterTaps->setMinimum(16);
+    m_iMaxFilterTaps = iMaxNumberFilterTaps;
+
+    //The spin box holds the IIR order while an IIR design method is selected
+    if(!FilterKernel::isIirDesignMethod(getDesignMethod())) {
+        m_pUi->m_spinBox_filterTaps->setMaximum(iMaxNumberFilterTaps);
+        m_pUi->m_spinBox_filterTaps->setMinimum(16);
+    }
 
     //Update filter depending on new window size
     filterParametersChanged();
@@ -210,7 +217,8 @@ void FilterDesignView::saveSettings()
 
     settings.setValue(m_sSettingsPath + QString("/FilterDesignView/filterFrom"), m_filterKernel.getHighpassFreq());
     settings.setValue(m_sSettingsPath + QString("/FilterDesignView/filterTo"), m_filterKernel.getLowpassFreq());
-    settings.setValue(m_sSettingsPath + QString("/FilterDesignView/filterOrder"), m_filterKernel.getFilterOrder());
+    settings.setValue(m_sSettingsPath + QString("/FilterDesignView/filterOrder"), m_iFilterTaps);
+    settings.setValue(m_sSettingsPath + QString("/FilterDesignView/filterIirOrder"), m_iIirOrder);
     settings.setValue(m_sSettingsPath + QString("/FilterDesignView/filterDesignMethod"), FilterKernel::m_designMethods.indexOf(m_filterKernel.getDesignMethod()));
     settings.setValue(m_sSettingsPath + QString("/FilterDesignView/filterTransition"), m_filterKernel.getParksWidth()*(m_filterKernel.getSamplingFrequency()/2));
     settings.setValue(m_sSettingsPath + QString("/FilterDesignView/filterChannelType"), getChannelType());
@@ -230,7 +238,9 @@ void FilterDesignView::loadSettings()
     //Set stored filter settings from last session
     m_pUi->m_doubleSpinBox_to->setValue(settings.value(m_sSettingsPath + QString("/FilterDesignView/filterTo"), 40.0).toDouble());
     m_pUi->m_doubleSpinBox_from->setValue(settings.value(m_sSettingsPath + QString("/FilterDesignView/filterFrom"), 1.0).toDouble());
-    m_pUi->m_spinBox_filterTaps->setValue(settings.value(m_sSettingsPath + QString("/FilterDesignView/filterOrder"), 128).toInt());
+    m_iFilterTaps = settings.value(m_sSettingsPath + QString("/FilterDesignView/filterOrder"), 128).toInt();
+    m_iIirOrder = settings.value(m_sSettingsPath + QString("/FilterDesignView/filterIirOrder"), 4).toInt();
+    m_pUi->m_spinBox_filterTaps->setValue(m_iFilterTaps);
     m_pUi->m_comboBox_designMethod->setCurrentIndex(settings.value(m_sSettingsPath + QString("/FilterDesignView/filterDesignMethod"), FilterKernel::m_designMethods.indexOf(FilterParameter("Cosine"))).toInt());
     m_pUi->m_doubleSpinBox_transitionband->setValue(settings.value(m_sSettingsPath + QString("/FilterDesignView/filterTransition"), 0.1).toDouble());
     m_pUi->m_comboBox_filterApplyTo->setCurrentText(settings.value(m_sSettingsPath + QString("/FilterDesignView/filterChannelType"), "All").toString());
@@ -398,6 +408,23 @@ void FilterDesignView::changeStateSpinBoxes(int currentIndex)
             break;
     }
 
+    //IIR designs use the tap spin box for their order. They have no transition band parameter.
+    QSignalBlocker blocker(m_pUi->m_spinBox_filterTaps);
+
+    if(FilterKernel::isIirDesignMethod(getDesignMethod())) {
+        m_pUi->m_label_filterTaps->setText("Filter order:");
+        m_pUi->m_spinBox_filterTaps->setRange(1, 10);
+        m_pUi->m_spinBox_filterTaps->setSingleStep(1);
+        m_pUi->m_spinBox_filterTaps->setValue(m_iIirOrder);
+        m_pUi->m_doubleSpinBox_transitionband->setEnabled(false);
+    } else {
+        m_pUi->m_label_filterTaps->setText("Filter taps:");
+        m_pUi->m_spinBox_filterTaps->setRange(16, m_iMaxFilterTaps);
+        m_pUi->m_spinBox_filterTaps->setSingleStep(2);
+        m_pUi->m_spinBox_filterTaps->setValue(m_iFilterTaps);
+        m_pUi->m_doubleSpinBox_transitionband->setEnabled(true);
+    }
+
     filterParametersChanged();
 }
 
@@ -407,6 +434,7 @@ void FilterDesignView::filterParametersChanged()
 {
     emit updateFilterFrom(m_pUi->m_doubleSpinBox_from->value());
     emit updateFilterTo(m_pUi->m_doubleSpinBox_to->value());
+    emit updateFilterDesignMethod(getDesignMethod());
 
     //User defined filter parameters
     double from = m_pUi->m_doubleSpinBox_from->value();
@@ -419,10 +447,19 @@ void FilterDesignView::filterParametersChanged()
 
     double nyquistFrequency = m_dSFreq/2;
 
-    //Calculate the needed fft length
-    m_iFilterTaps = m_pUi->m_spinBox_filterTaps->value();
-    if(m_pUi->m_spinBox_filterTaps->value()%2 != 0) {
-        m_iFilterTaps--;
+    int iMethod = getDesignMethod();
+    int iOrder;
+
+    if(FilterKernel::isIirDesignMethod(iMethod)) {
+        m_iIirOrder = m_pUi->m_spinBox_filterTaps->value();
+        iOrder = m_iIirOrder;
+    } else {
+        //Calculate the needed fft length
+        m_iFilterTaps = m_pUi->m_spinBox_filterTaps->value();
+        if(m_pUi->m_spinBox_filterTaps->value()%2 != 0) {
+            m_iFilterTaps--;
+        }
+        iOrder = m_iFilterTaps;
     }
 
     //set maximum and minimum for cut off frequency spin boxes
@@ -438,12 +475,10 @@ void FilterDesignView::filterParametersChanged()
     m_pUi->m_doubleSpinBox_to->setMinimum(m_pUi->m_doubleSpinBox_from->value());
     m_pUi->m_doubleSpinBox_from->setMaximum(m_pUi->m_doubleSpinBox_to->value());
 
-    int iMethod = FilterKernel::m_designMethods.indexOf(FilterParameter(m_pUi->m_comboBox_designMethod->currentText()));
-
     //Generate filters
     m_filterKernel = FilterKernel("Designed Filter",
                                   FilterKernel::m_filterTypes.indexOf(FilterParameter("BPF")),
-                                  m_iFilterTaps,
+                                  iOrder,
                                   (double)center/nyquistFrequency,
                                   (double)bw/nyquistFrequency,
                                   (double)trans_width/nyquistFrequency,
@@ -573,14 +608,37 @@ double FilterDesignView::getTo()
 
 //=============================================================================================================
 
+void FilterDesignView::setDesignMethod(int iDesignMethod)
+{
+    //Changing the index triggers changeStateSpinBoxes() and thereby the filter design
+    m_pUi->m_comboBox_designMethod->setCurrentIndex(iDesignMethod);
+}
+
+//=============================================================================================================
+
+int FilterDesignView::getDesignMethod()
+{
+    return FilterKernel::m_designMethods.indexOf(FilterParameter(m_pUi->m_comboBox_designMethod->currentText()));
+}
+
+//=============================================================================================================
+
 void FilterDesignView::updateGuiFromFilter(const RTPROCESSINGLIB::FilterKernel& filter)
 {
+    int iMethod = FilterKernel::m_designMethods.indexOf(filter.getDesignMethod());
+
+    if(FilterKernel::isIirDesignMethod(iMethod)) {
+        m_iIirOrder = filter.getFilterOrder();
+    } else {
+        m_iFilterTaps = filter.getFilterOrder();
+    }
+
     m_pUi->m_doubleSpinBox_from->setValue(filter.getHighpassFreq());
     m_pUi->m_doubleSpinBox_to->setValue(filter.getLowpassFreq());
-    m_pUi->m_spinBox_filterTaps->setValue(filter.getFilterOrder());
     m_pUi->m_doubleSpinBox_transitionband->setValue(filter.getParksWidth()*(filter.getSamplingFrequency()/2));
 
-    m_pUi->m_comboBox_designMethod->setCurrentIndex(FilterKernel::m_designMethods.indexOf(filter.getDesignMethod()));
+    m_pUi->m_comboBox_designMethod->setCurrentIndex(iMethod);
+    m_pUi->m_spinBox_filterTaps->setValue(filter.getFilterOrder());
 }
 
 //=============================================================================================================
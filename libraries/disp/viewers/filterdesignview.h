@@ -166,6 +166,22 @@ public:
      */
     double getTo();
 
+    //=========================================================================================================
+    /**
+     * Sets the filter design method
+     *
+     * @param[in] iDesignMethod    the design method (index into FilterKernel::m_designMethods).
+     */
+    void setDesignMethod(int iDesignMethod);
+
+    //=========================================================================================================
+    /**
+     * Get the filter design method
+     *
+     * @return the design method (index into FilterKernel::m_designMethods).
+     */
+    int getDesignMethod();
+
     //=========================================================================================================
     /**
      * Returns the current filter.
@@ -331,6 +347,8 @@ protected:
     QString                             m_sSettingsPath;            /**< The settings path to store the GUI settings to. */
 
     int                                 m_iFilterTaps;              /**< The current number of filter taps.*/
+    int                                 m_iMaxFilterTaps;           /**< The maximum number of filter taps.*/
+    int                                 m_iIirOrder;                /**< The current order of IIR designs.*/
     double                              m_dSFreq;                   /**< The current sampling frequency.*/
 
 signals:
@@ -365,6 +383,14 @@ signals:
      * @param[in] dTo       change in filter 'To' value.
      */
     void updateFilterTo(double dTo);
+
+    //=========================================================================================================
+    /**
+     * Update to simple filter control 'Method'
+     *
+     * @param[in] iDesignMethod     change in filter design method.
+     */
+    void updateFilterDesignMethod(int iDesignMethod);
 };
 } // NAMESPACE DISPLIB
 
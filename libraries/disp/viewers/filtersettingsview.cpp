@@ -40,6 +40,8 @@
 
 #include "filterdesignview.h"
 
+#include <rtprocessing/helpers/filterkernel.h>
+
 #include "ui_filtersettingsview.h"
 
 //=============================================================================================================
@@ -89,6 +91,9 @@ FilterSettingsView::FilterSettingsView(const QString& sSettingsPath,
     connect(m_pFilterView.data(), &FilterDesignView::updateFilterTo,[=](double dTo){
                 m_pUi->m_pDoubleSpinBoxTo->setValue(dTo);
             });
+    connect(m_pFilterView.data(), &FilterDesignView::updateFilterDesignMethod,[=](int iDesignMethod){
+                m_pUi->m_pComboBoxDesignMethod->setCurrentIndex(iDesignMethod);
+            });
 
     connect(this, &FilterSettingsView::guiStyleChanged,
             m_pFilterView.data(), &FilterDesignView::guiStyleChanged);
@@ -96,6 +101,11 @@ FilterSettingsView::FilterSettingsView(const QString& sSettingsPath,
     m_pUi->m_pDoubleSpinBoxFrom->setValue(m_pFilterView->getFrom());
     m_pUi->m_pDoubleSpinBoxTo->setValue(m_pFilterView->getTo());
 
+    for(const RTPROCESSINGLIB::FilterParameter& method : RTPROCESSINGLIB::FilterKernel::m_designMethods) {
+        m_pUi->m_pComboBoxDesignMethod->addItem(method.getName());
+    }
+    m_pUi->m_pComboBoxDesignMethod->setCurrentIndex(m_pFilterView->getDesignMethod());
+
     //Connect GUI elements
     connect(m_pUi->m_pCheckBoxActivateFilter, &QCheckBox::toggled,
             this, &FilterSettingsView::onFilterActivationChanged);
@@ -107,6 +117,8 @@ FilterSettingsView::FilterSettingsView(const QString& sSettingsPath,
             this, &FilterSettingsView::onFilterToChanged);
     connect(m_pUi->m_pcomboBoxChannelTypes, &QComboBox::currentTextChanged,
             this, &FilterSettingsView::onFilterChannelTypeChanged);
+    connect(m_pUi->m_pComboBoxDesignMethod, static_cast<void (QComboBox::*)(int)>(&QComboBox::activated),
+            this, &FilterSettingsView::onFilterDesignMethodChanged);
 }
 
 //=============================================================================================================
@@ -267,6 +279,15 @@ void FilterSettingsView::onFilterChannelTypeChanged(const QString& sType)
 
 //=============================================================================================================
 
+void FilterSettingsView::onFilterDesignMethodChanged(int iDesignMethod)
+{
+    m_pFilterView->setDesignMethod(iDesignMethod);
+
+    saveSettings();
+}
+
+//=============================================================================================================
+
 void FilterSettingsView::clearView()
 {
 
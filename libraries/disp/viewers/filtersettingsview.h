@@ -199,6 +199,14 @@ protected:
      */
     void onFilterChannelTypeChanged(const QString& sType);
 
+    //=========================================================================================================
+    /**
+     * This function is called whenever the filter design method changed
+     *
+     * @param[in] iDesignMethod        the design method (index into FilterKernel::m_designMethods).
+     */
+    void onFilterDesignMethodChanged(int iDesignMethod);
+
     QString                                 m_sSettingsPath;                /**< The settings path to store the GUI settings to. */
 
     QSharedPointer<FilterDesignView>        m_pFilterView;                  /**< The filter view. */
@@ -0,0 +1,229 @@
+//=============================================================================================================
+/**
+ * @file     envelopepyramid.cpp
+ * @author   agent <agent@local>
+ * @since    0.1.9
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, agent. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    Definition of the EnvelopePyramid Class.
+ *
+ */
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include "envelopepyramid.h"
+
+#include <algorithm>
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QtGlobal>
+
+//=============================================================================================================
+// EIGEN INCLUDES
+//=============================================================================================================
+
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace DISPLIB;
+using namespace Eigen;
+
+//=============================================================================================================
+// DEFINE MEMBER METHODS
+//=============================================================================================================
+
+EnvelopePyramid::EnvelopePyramid(int iDecimation)
+: m_iDecimation(std::max(2, iDecimation))
+, m_iNumSamples(0)
+{
+}
+
+//=============================================================================================================
+
+void EnvelopePyramid::build(const MatrixXd& matData)
+{
+    allocate(matData.rows(), matData.cols());
+    updateLevels(matData, 0, matData.cols());
+}
+
+//=============================================================================================================
+
+void EnvelopePyramid::build(const MatrixXf& matData)
+{
+    allocate(matData.rows(), matData.cols());
+    updateLevels(matData, 0, matData.cols());
+}
+
+//=============================================================================================================
+
+void EnvelopePyramid::build(const MatrixXdR& matData)
+{
+    allocate(matData.rows(), matData.cols());
+    updateLevels(matData, 0, matData.cols());
+}
+
+//=============================================================================================================
+
+void EnvelopePyramid::update(const MatrixXd& matData,
+                             int iFirstSample,
+                             int iNumSamples)
+{
+    if(matData.cols() != m_iNumSamples || matData.rows() != numChannels()) {
+        build(matData);
+        return;
+    }
+
+    updateLevels(matData, iFirstSample, iNumSamples);
+}
+
+//=============================================================================================================
+
+void EnvelopePyramid::update(const MatrixXdR& matData,
+                             int iFirstSample,
+                             int iNumSamples)
+{
+    if(matData.cols() != m_iNumSamples || matData.rows() != numChannels()) {
+        build(matData);
+        return;
+    }
+
+    updateLevels(matData, iFirstSample, iNumSamples);
+}
+
+//=============================================================================================================
+
+void EnvelopePyramid::clear()
+{
+    m_iNumSamples = 0;
+    m_vecBinSizes.clear();
+    m_vecMin.clear();
+    m_vecMax.clear();
+}
+
+//=============================================================================================================
+
+int EnvelopePyramid::selectLevel(double dPixelsPerSample) const
+{
+    if(dPixelsPerSample <= 0.0) {
+        return -1;
+    }
+
+    double dSamplesPerPixel = 1.0 / dPixelsPerSample;
+    int iLevel = -1;
+
+    for(int i = 0; i < m_vecBinSizes.size(); ++i) {
+        if(m_vecBinSizes.at(i) > dSamplesPerPixel) {
+            break;
+        }
+        iLevel = i;
+    }
+
+    return iLevel;
+}
+
+//=============================================================================================================
+
+void EnvelopePyramid::allocate(int iRows,
+                               int iCols)
+{
+    clear();
+
+    m_iNumSamples = iCols;
+
+    if(iRows <= 0 || iCols <= 0) {
+        return;
+    }
+
+    // Add levels until a single bin covers all samples
+    int iBinSize = m_iDecimation;
+    while(true) {
+        int iNumBins = (iCols + iBinSize - 1) / iBinSize;
+
+        m_vecBinSizes.append(iBinSize);
+        m_vecMin.append(MatrixXf(iRows, iNumBins));
+        m_vecMax.append(MatrixXf(iRows, iNumBins));
+
+        if(iNumBins <= 1) {
+            break;
+        }
+
+        iBinSize *= m_iDecimation;
+    }
+}
+
+//=============================================================================================================
+
+template<typename T>
+void EnvelopePyramid::updateLevels(const MatrixBase<T>& matData,
+                                   int iFirstSample,
+                                   int iNumSamples)
+{
+    if(m_vecMin.isEmpty()) {
+        return;
+    }
+
+    iFirstSample = qBound(0, iFirstSample, m_iNumSamples);
+    int iLastSample = qBound(iFirstSample, iFirstSample + iNumSamples, m_iNumSamples);
+
+    if(iLastSample <= iFirstSample) {
+        return;
+    }
+
+    // Level 0 is computed from the samples
+    int iFirstBin = iFirstSample / m_iDecimation;
+    int iLastBin = (iLastSample - 1) / m_iDecimation;
+
+    for(int j = iFirstBin; j <= iLastBin; ++j) {
+        int iStart = j * m_iDecimation;
+        int iLength = std::min(m_iDecimation, m_iNumSamples - iStart);
+
+        m_vecMin[0].col(j) = matData.middleCols(iStart, iLength).rowwise().minCoeff().template cast<float>();
+        m_vecMax[0].col(j) = matData.middleCols(iStart, iLength).rowwise().maxCoeff().template cast<float>();
+    }
+
+    // Coarser levels are computed from the finer level only
+    for(int iLevel = 1; iLevel < m_vecMin.size(); ++iLevel) {
+        const MatrixXf& matFinerMin = m_vecMin.at(iLevel - 1);
+        const MatrixXf& matFinerMax = m_vecMax.at(iLevel - 1);
+
+        iFirstBin /= m_iDecimation;
+        iLastBin /= m_iDecimation;
+
+        for(int j = iFirstBin; j <= iLastBin; ++j) {
+            int iStart = j * m_iDecimation;
+            int iLength = std::min(m_iDecimation, static_cast<int>(matFinerMin.cols()) - iStart);
+
+            m_vecMin[iLevel].col(j) = matFinerMin.middleCols(iStart, iLength).rowwise().minCoeff();
+            m_vecMax[iLevel].col(j) = matFinerMax.middleCols(iStart, iLength).rowwise().maxCoeff();
+        }
+    }
+}
@@ -0,0 +1,260 @@
+//=============================================================================================================
+/**
+ * @file     envelopepyramid.h
+ * @author   agent <agent@local>
+ * @since    0.1.9
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, agent. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    Declaration of the EnvelopePyramid Class.
+ *
+ */
+
+#ifndef ENVELOPEPYRAMID_H
+#define ENVELOPEPYRAMID_H
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include "../../disp_global.h"
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QSharedPointer>
+#include <QVector>
+
+//=============================================================================================================
+// EIGEN INCLUDES
+//=============================================================================================================
+
+#include <Eigen/Core>
+
+//=============================================================================================================
+// FORWARD DECLARATIONS
+//=============================================================================================================
+
+//=============================================================================================================
+// DEFINE NAMESPACE DISPLIB
+//=============================================================================================================
+
+namespace DISPLIB
+{
+
+//=============================================================================================================
+// DISPLIB FORWARD DECLARATIONS
+//=============================================================================================================
+
+//=============================================================================================================
+/**
+ * DECLARE CLASS EnvelopePyramid
+ *
+ * @brief The EnvelopePyramid class holds per channel min/max envelopes of a data matrix at several decimation
+ *        levels. Level 0 summarizes bins of iDecimation samples, every further level summarizes iDecimation bins
+ *        of the level below. Raw data views pick the level matching their pixels-per-sample ratio, so that every
+ *        pixel column costs two points independent of the zoom level and no spikes are aliased away.
+ */
+class DISPSHARED_EXPORT EnvelopePyramid
+{
+
+public:
+    typedef QSharedPointer<EnvelopePyramid> SPtr;              /**< Shared pointer type for EnvelopePyramid. */
+    typedef QSharedPointer<const EnvelopePyramid> ConstSPtr;   /**< Const shared pointer type for EnvelopePyramid. */
+
+    typedef Eigen::Matrix<double,Eigen::Dynamic,Eigen::Dynamic,Eigen::RowMajor> MatrixXdR;
+
+    //=========================================================================================================
+    /**
+     * Constructs an empty EnvelopePyramid.
+     *
+     * @param[in] iDecimation    The number of samples (bins) summarized by one bin of the next level. Minimum is 2.
+     */
+    explicit EnvelopePyramid(int iDecimation = 4);
+
+    //=========================================================================================================
+    /**
+     * Builds all levels for the given data matrix (channels x samples).
+     *
+     * @param[in] matData    The data to summarize.
+     */
+    void build(const Eigen::MatrixXd& matData);
+    void build(const Eigen::MatrixXf& matData);
+    void build(const MatrixXdR& matData);
+
+    //=========================================================================================================
+    /**
+     * Incrementally updates all bins overlapping the sample range [iFirstSample, iFirstSample + iNumSamples).
+     * This is meant for streaming data which is written into a fixed size matrix. The matrix dimensions must not
+     * have changed since the last call to build().
+     *
+     * @param[in] matData        The full data matrix, already holding the new samples.
+     * @param[in] iFirstSample   The first sample which changed.
+     * @param[in] iNumSamples    The number of changed samples.
+     */
+    void update(const Eigen::MatrixXd& matData,
+                int iFirstSample,
+                int iNumSamples);
+    void update(const MatrixXdR& matData,
+                int iFirstSample,
+                int iNumSamples);
+
+    //=========================================================================================================
+    /**
+     * Clears all levels.
+     */
+    void clear();
+
+    //=========================================================================================================
+    /**
+     * Returns the coarsest level whose bin size does not exceed the number of samples per pixel
+     * (1 / dPixelsPerSample), or -1 if the raw samples should be plotted directly.
+     *
+     * @param[in] dPixelsPerSample   The horizontal pixel distance between two consecutive samples.
+     *
+     * @return The level to plot or -1.
+     */
+    int selectLevel(double dPixelsPerSample) const;
+
+    //=========================================================================================================
+    /**
+     * @return The number of levels.
+     */
+    inline int numLevels() const;
+
+    //=========================================================================================================
+    /**
+     * @return The number of summarized samples.
+     */
+    inline int numSamples() const;
+
+    //=========================================================================================================
+    /**
+     * @return The number of summarized channels.
+     */
+    inline int numChannels() const;
+
+    //=========================================================================================================
+    /**
+     * @param[in] iLevel     The level.
+     *
+     * @return The number of samples per bin at the given level.
+     */
+    inline int binSize(int iLevel) const;
+
+    //=========================================================================================================
+    /**
+     * @param[in] iLevel     The level.
+     *
+     * @return The per bin minima at the given level (channels x bins).
+     */
+    inline const Eigen::MatrixXf& minimum(int iLevel) const;
+
+    //=========================================================================================================
+    /**
+     * @param[in] iLevel     The level.
+     *
+     * @return The per bin maxima at the given level (channels x bins).
+     */
+    inline const Eigen::MatrixXf& maximum(int iLevel) const;
+
+private:
+    //=========================================================================================================
+    /**
+     * Resizes the levels to fit the given dimensions.
+     *
+     * @param[in] iRows      The number of channels.
+     * @param[in] iCols      The number of samples.
+     */
+    void allocate(int iRows,
+                  int iCols);
+
+    //=========================================================================================================
+    /**
+     * Recomputes level 0 from the data and all coarser levels from their finer level.
+     *
+     * @param[in] matData        The data matrix.
+     * @param[in] iFirstSample   The first sample which changed.
+     * @param[in] iNumSamples    The number of changed samples.
+     */
+    template<typename T>
+    void updateLevels(const Eigen::MatrixBase<T>& matData,
+                      int iFirstSample,
+                      int iNumSamples);
+
+    int                     m_iDecimation;      /**< Number of samples/bins combined into one bin of the next level. */
+    int                     m_iNumSamples;      /**< Number of samples summarized by the pyramid. */
+    QVector<int>            m_vecBinSizes;      /**< Samples per bin for each level. */
+    QVector<Eigen::MatrixXf> m_vecMin;          /**< Per level minima (channels x bins). */
+    QVector<Eigen::MatrixXf> m_vecMax;          /**< Per level maxima (channels x bins). */
+};
+
+//=============================================================================================================
+// INLINE DEFINITIONS
+//=============================================================================================================
+
+inline int EnvelopePyramid::numLevels() const
+{
+    return m_vecMin.size();
+}
+
+//=============================================================================================================
+
+inline int EnvelopePyramid::numSamples() const
+{
+    return m_iNumSamples;
+}
+
+//=============================================================================================================
+
+inline int EnvelopePyramid::numChannels() const
+{
+    return m_vecMin.isEmpty() ? 0 : m_vecMin.first().rows();
+}
+
+//=============================================================================================================
+
+inline int EnvelopePyramid::binSize(int iLevel) const
+{
+    return m_vecBinSizes.at(iLevel);
+}
+
+//=============================================================================================================
+
+inline const Eigen::MatrixXf& EnvelopePyramid::minimum(int iLevel) const
+{
+    return m_vecMin.at(iLevel);
+}
+
+//=============================================================================================================
+
+inline const Eigen::MatrixXf& EnvelopePyramid::maximum(int iLevel) const
+{
+    return m_vecMax.at(iLevel);
+}
+} // NAMESPACE DISPLIB
+
+#endif // ENVELOPEPYRAMID_H
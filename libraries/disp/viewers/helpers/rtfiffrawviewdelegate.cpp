@@ -455,6 +455,28 @@ void RtFiffRawViewDelegate::createPlotPath(const QModelIndex &index,
 
     //Move to initial starting point
     path.moveTo(calcPoint(path, 0., 0., dChannelOffset, dScaleY));
+
+    //If more than one sample falls into a pixel column plot the min/max envelope instead of every single sample
+    const EnvelopePyramid& envelope = t_pModel->getEnvelopePyramid();
+
+    if(envelope.numSamples() == data.second) {
+        int iLevel = envelope.selectLevel(dPixelsPerSample);
+
+        if(iLevel >= 0) {
+            createEnvelopePath(path,
+                               envelope,
+                               iLevel,
+                               t_pModel->getIdxSelMap().value(index.row(),0),
+                               dPixelsPerSample,
+                               iTimeCursorSample,
+                               data.first[0],
+                               firstValuePreviousPlot,
+                               dChannelOffset,
+                               dScaleY);
+            return;
+        }
+    }
+
     double dY(0);
 
     //The plot works as a rolling time-cursor, ploting data on top of previous runs.
@@ -476,6 +498,56 @@ void RtFiffRawViewDelegate::createPlotPath(const QModelIndex &index,
 
 //=============================================================================================================
 
+void RtFiffRawViewDelegate::createEnvelopePath(QPainterPath& path,
+                                               const EnvelopePyramid& envelope,
+                                               int iLevel,
+                                               int iChannel,
+                                               double dPixelsPerSample,
+                                               int iTimeCursorSample,
+                                               double dFirstValueCurrentPlot,
+                                               double dFirstValuePreviousPlot,
+                                               double dChannelOffset,
+                                               double dScaleY) const
+{
+    const Eigen::MatrixXf& matMin = envelope.minimum(iLevel);
+    const Eigen::MatrixXf& matMax = envelope.maximum(iLevel);
+    const int iBinSize = envelope.binSize(iLevel);
+    const double dStartX = path.currentPosition().x();
+
+    int iColumn = -1;
+    double dMin(0), dMax(0), dOffset(0);
+
+    for(int j = 0; j < matMin.cols(); ++j) {
+        int iSample = j * iBinSize;
+        int iBinColumn = static_cast<int>(iSample * dPixelsPerSample);
+
+        //Same offsets as in the per sample plot: A part left and B part right of the time-cursor
+        dOffset = iSample < iTimeCursorSample ? dFirstValueCurrentPlot : dFirstValuePreviousPlot;
+
+        if(iBinColumn != iColumn) {
+            //Two points per pixel column
+            if(iColumn >= 0) {
+                path.lineTo(calcPoint(path, dStartX + iColumn - path.currentPosition().x(), dMax, dChannelOffset, dScaleY));
+                path.lineTo(calcPoint(path, 0., dMin, dChannelOffset, dScaleY));
+            }
+
+            iColumn = iBinColumn;
+            dMin = matMin(iChannel, j) - dOffset;
+            dMax = matMax(iChannel, j) - dOffset;
+        } else {
+            dMin = std::min(dMin, matMin(iChannel, j) - dOffset);
+            dMax = std::max(dMax, matMax(iChannel, j) - dOffset);
+        }
+    }
+
+    if(iColumn >= 0) {
+        path.lineTo(calcPoint(path, dStartX + iColumn - path.currentPosition().x(), dMax, dChannelOffset, dScaleY));
+        path.lineTo(calcPoint(path, 0., dMin, dChannelOffset, dScaleY));
+    }
+}
+
+//=============================================================================================================
+
 void RtFiffRawViewDelegate::createCurrentPositionMarkerPath(const QModelIndex &index, const QStyleOptionViewItem &option, QPainterPath& path) const
 {
     const RtFiffRawViewModel* t_pModel = static_cast<const RtFiffRawViewModel*>(index.model());
@@ -44,6 +44,7 @@
 
 #include "../../disp_global.h"
 #include "../scalingview.h"
+#include "envelopepyramid.h"
 
 //=============================================================================================================
 // QT INCLUDES
@@ -184,6 +185,33 @@ private:
                         QPainterPath& path,
                         const DISPLIB::RowVectorPair &data) const;
 
+    //=========================================================================================================
+    /**
+     * createEnvelopePath creates the QPointer path for the data plot from the min/max envelopes of the given level.
+     * Each pixel column is plotted with two points only, independent of the number of samples it covers.
+     *
+     * @param[in, out] path                  The QPointerPath to create for the data plot.
+     * @param[in] envelope                   The envelope pyramid of the plotted data.
+     * @param[in] iLevel                     The envelope level to plot.
+     * @param[in] iChannel                   The channel (row) in the envelope pyramid.
+     * @param[in] dPixelsPerSample           The horizontal pixel distance between two samples.
+     * @param[in] iTimeCursorSample          The sample index of the time-cursor.
+     * @param[in] dFirstValueCurrentPlot     The first value of the current roll (left of the time-cursor).
+     * @param[in] dFirstValuePreviousPlot    The first value of the previous roll (right of the time-cursor).
+     * @param[in] dChannelOffset             The y offset to apply.
+     * @param[in] dScaleY                    The y scaling factor to apply.
+     */
+    void createEnvelopePath(QPainterPath& path,
+                            const EnvelopePyramid& envelope,
+                            int iLevel,
+                            int iChannel,
+                            double dPixelsPerSample,
+                            int iTimeCursorSample,
+                            double dFirstValueCurrentPlot,
+                            double dFirstValuePreviousPlot,
+                            double dChannelOffset,
+                            double dScaleY) const;
+
     //=========================================================================================================
     /**
      * createCurrentPositionMarkerPath Creates the QPointer path for the current marker position plot.
@@ -326,6 +326,8 @@ void RtFiffRawViewModel::setFiffInfo(QSharedPointer<FIFFLIB::FiffInfo> &p_pFiffI
 
         m_matOverlap.conservativeResize(m_pFiffInfo->chs.size(), m_iMaxFilterLength);
 
+        updateEnvelopes(0, -1);
+
         m_matSparseProjMult = SparseMatrix<double>(m_pFiffInfo->chs.size(),m_pFiffInfo->chs.size());
         m_matSparseCompMult = SparseMatrix<double>(m_pFiffInfo->chs.size(),m_pFiffInfo->chs.size());
         m_matSparseSpharaMult = SparseMatrix<double>(m_pFiffInfo->chs.size(),m_pFiffInfo->chs.size());
@@ -398,6 +400,8 @@ void RtFiffRawViewModel::setSamplingInfo(float sps, int T, bool bSetZero)
         m_iCurrentSample = 0;
     }
 
+    updateEnvelopes(0, -1);
+
     endResetModel();
 }
 
@@ -425,6 +429,10 @@ void RtFiffRawViewModel::addData(const QList<MatrixXd> &data)
     //SPHARA
     bool doSphara = m_bSpharaActivated && m_matSparseSpharaMult.cols() > 0 && m_matDataRaw.rows() == m_matSparseSpharaMult.cols() ? true : false;
 
+    //Remember the written range in order to update the envelope pyramids afterwards
+    int iFirstWrittenSample = m_iCurrentSample;
+    bool bWrapped = false;
+
     //Copy new data into the global data matrix
     for(qint32 b = 0; b < data.size(); ++b) {
         int nCol = data.at(b).cols();
@@ -471,6 +479,7 @@ void RtFiffRawViewModel::addData(const QList<MatrixXd> &data)
             m_iCurrentStartingSample += m_iResidual;
 
             m_iCurrentSample = 0;
+            bWrapped = true;
 
             if(!m_bIsFreezed) {
                 m_vecLastBlockFirstValuesFiltered = m_matDataFiltered.col(0);
@@ -561,6 +570,13 @@ void RtFiffRawViewModel::addData(const QList<MatrixXd> &data)
         }
     }
 
+    //Update the envelopes of the written range. A wrap around touches both ends of the matrix, simply rebuild then.
+    if(bWrapped) {
+        updateEnvelopes(0, -1);
+    } else {
+        updateEnvelopes(iFirstWrittenSample, m_iCurrentSample - iFirstWrittenSample);
+    }
+
     //Update data content
     QModelIndex topLeft = this->index(0,1);
     QModelIndex bottomRight = this->index(m_pFiffInfo->ch_names.size()-1,1);
@@ -667,6 +683,8 @@ void RtFiffRawViewModel::toggleFreeze(const QModelIndex &)
     if(m_bIsFreezed) {
         m_matDataRawFreeze = m_matDataRaw;
         m_matDataFilteredFreeze = m_matDataFiltered;
+        m_envelopeRawFreeze = m_envelopeRaw;
+        m_envelopeFilteredFreeze = m_envelopeFiltered;
         m_qMapDetectedTriggerFreeze = m_qMapDetectedTrigger;
         m_qMapDetectedTriggerOldFreeze = m_qMapDetectedTriggerOld;
 
@@ -896,10 +914,27 @@ void RtFiffRawViewModel::setFilter(QList<FilterKernel> filterData)
 {
     m_filterKernel = filterData;
 
-    m_iMaxFilterLength = 1;
+    //IIR filters are cascaded into one causal filter, FIR filters keep going through the overlap add path
+    m_lFirFilterKernel.clear();
+    MatrixXd matSos(0, 6);
+
     for(int i=0; i<filterData.size(); ++i) {
-        if(m_iMaxFilterLength<filterData.at(i).getFilterOrder()) {
-            m_iMaxFilterLength = filterData.at(i).getFilterOrder();
+        if(filterData.at(i).isIir()) {
+            const MatrixXd matKernelSos = filterData.at(i).getSos();
+            matSos.conservativeResize(matSos.rows() + matKernelSos.rows(), 6);
+            matSos.bottomRows(matKernelSos.rows()) = matKernelSos;
+        } else {
+            m_lFirFilterKernel.append(filterData.at(i));
+        }
+    }
+
+    m_iirFilter = IirFilter(matSos);
+
+    //IIR filters do not introduce a block delay
+    m_iMaxFilterLength = m_lFirFilterKernel.isEmpty() ? 0 : 1;
+    for(int i=0; i<m_lFirFilterKernel.size(); ++i) {
+        if(m_iMaxFilterLength<m_lFirFilterKernel.at(i).getFilterOrder()) {
+            m_iMaxFilterLength = m_lFirFilterKernel.at(i).getFilterOrder();
         }
     }
 
@@ -931,6 +966,7 @@ void RtFiffRawViewModel::setBackgroundColor(const QColor& color)
 void RtFiffRawViewModel::setFilterChannelType(const QString &channelType)
 {
     m_sFilterChannelType = channelType;
+    m_iirFilter.reset();
     m_filterChannelList = m_visibleChannelList;
 
     //This version is for when all channels of a type are to be filtered (not only the visible ones).
@@ -1119,7 +1155,7 @@ void RtFiffRawViewModel::filterDataBlock()
 {
     //std::cout<<"START RtFiffRawViewModel::filterDataBlock"<<std::endl;
 
-    if(m_filterKernel.isEmpty() || !m_bPerformFiltering) {
+    if(m_lFirFilterKernel.isEmpty() || !m_bPerformFiltering) {
         return;
     }
 
@@ -1130,15 +1166,15 @@ void RtFiffRawViewModel::filterDataBlock()
     int exp = ceil(MNEMath::log2(fftLength));
     fftLength = pow(2, exp) < 512 ? 512 : pow(2, exp);
 
-    for(int i = 0; i<m_filterKernel.size(); ++i) {
-        FilterKernel tempFilter(m_filterKernel.at(i).getName(),
-                                FilterKernel::m_filterTypes.indexOf(m_filterKernel.at(i).getFilterType()),
-                                m_filterKernel.at(i).getFilterOrder(),
-                                m_filterKernel.at(i).getCenterFrequency(),
-                                m_filterKernel.at(i).getBandwidth(),
-                                m_filterKernel.at(i).getParksWidth(),
-                                m_filterKernel.at(i).getSamplingFrequency(),
-                                FilterKernel::m_designMethods.indexOf(m_filterKernel.at(i).getDesignMethod()));
+    for(int i = 0; i<m_lFirFilterKernel.size(); ++i) {
+        FilterKernel tempFilter(m_lFirFilterKernel.at(i).getName(),
+                                FilterKernel::m_filterTypes.indexOf(m_lFirFilterKernel.at(i).getFilterType()),
+                                m_lFirFilterKernel.at(i).getFilterOrder(),
+                                m_lFirFilterKernel.at(i).getCenterFrequency(),
+                                m_lFirFilterKernel.at(i).getBandwidth(),
+                                m_lFirFilterKernel.at(i).getParksWidth(),
+                                m_lFirFilterKernel.at(i).getSamplingFrequency(),
+                                FilterKernel::m_designMethods.indexOf(m_lFirFilterKernel.at(i).getDesignMethod()));
 
         tempFilterList.append(tempFilter);
     }
@@ -1180,12 +1216,62 @@ void RtFiffRawViewModel::filterDataBlock()
         m_vecLastBlockFirstValuesFiltered = m_matDataFiltered.col(0);
     }
 
+    m_envelopeFiltered.build(m_matDataFiltered);
+
     //std::cout<<"END RtFiffRawViewModel::filterDataBlock"<<std::endl;
 }
 
 //=============================================================================================================
 
 void RtFiffRawViewModel::filterDataBlock(const MatrixXd &data, int iDataIndex)
+{
+    if(m_iirFilter.getSos().rows() == 0) {
+        filterDataBlockFir(data, iDataIndex);
+        return;
+    }
+
+    if(iDataIndex >= m_matDataFiltered.cols()) {
+        return;
+    }
+
+    //Run the causal IIR cascade on all channels to be filtered at once. The filter state carries over between blocks.
+    QList<int> lFilterChannelIndex;
+    for(qint32 i = 0; i < data.rows(); ++i) {
+        if(m_filterChannelList.contains(m_pFiffInfo->chs.at(i).ch_name)) {
+            lFilterChannelIndex.append(i);
+        }
+    }
+
+    MatrixXd matPicked(lFilterChannelIndex.size(), data.cols());
+    for(int i = 0; i < lFilterChannelIndex.size(); ++i) {
+        matPicked.row(i) = data.row(lFilterChannelIndex.at(i));
+    }
+
+    m_iirFilter.apply(matPicked);
+
+    MatrixXd matData = data;
+    for(int i = 0; i < lFilterChannelIndex.size(); ++i) {
+        matData.row(lFilterChannelIndex.at(i)) = matPicked.row(i);
+    }
+
+    if(!m_lFirFilterKernel.isEmpty()) {
+        filterDataBlockFir(matData, iDataIndex);
+        return;
+    }
+
+    m_matDataFiltered.block(0, iDataIndex, matData.rows(), matData.cols()) = matData;
+
+    //Copy residual data from the front to the back. The residual is != 0 if the chosen block size cannot be evenly fit into the matrix size
+    if(iDataIndex == 0 && m_iResidual > 0) {
+        m_matDataFiltered.rightCols(m_iResidual) = m_matDataFiltered.leftCols(m_iResidual);
+    }
+
+    m_bDrawFilterFront = true;
+}
+
+//=============================================================================================================
+
+void RtFiffRawViewModel::filterDataBlockFir(const MatrixXd &data, int iDataIndex)
 {
     //std::cout<<"START RtFiffRawViewModel::filterDataBlock"<<std::endl;
 
@@ -1199,7 +1285,7 @@ void RtFiffRawViewModel::filterDataBlock(const MatrixXd &data, int iDataIndex)
 
     for(qint32 i = 0; i < data.rows(); ++i) {
         if(m_filterChannelList.contains(m_pFiffInfo->chs.at(i).ch_name)) {
-            timeData.append(QPair<QList<FilterKernel>,QPair<int,RowVectorXd> >(m_filterKernel,QPair<int,RowVectorXd>(i,data.row(i))));
+            timeData.append(QPair<QList<FilterKernel>,QPair<int,RowVectorXd> >(m_lFirFilterKernel,QPair<int,RowVectorXd>(i,data.row(i))));
         } else {
             notFilterChannelIndex.append(i);
             }
@@ -1313,11 +1399,35 @@ void RtFiffRawViewModel::clearModel()
     m_vecLastBlockFirstValuesRaw.setZero();
     m_matOverlap.setZero();
 
+    m_envelopeRaw.build(m_matDataRaw);
+    m_envelopeFiltered.build(m_matDataFiltered);
+    m_envelopeRawFreeze.build(m_matDataRawFreeze);
+    m_envelopeFilteredFreeze.build(m_matDataFilteredFreeze);
+
     endResetModel();
 }
 
 //=============================================================================================================
 
+void RtFiffRawViewModel::updateEnvelopes(int iFirstSample,
+                                         int iNumSamples)
+{
+    if(iNumSamples < 0) {
+        m_envelopeRaw.build(m_matDataRaw);
+        m_envelopeFiltered.build(m_matDataFiltered);
+        return;
+    }
+
+    m_envelopeRaw.update(m_matDataRaw, iFirstSample, iNumSamples);
+
+    //The overlap add writes filtered data up to one filter length around the new block
+    m_envelopeFiltered.update(m_matDataFiltered,
+                              iFirstSample - m_iMaxFilterLength,
+                              iNumSamples + 2 * m_iMaxFilterLength);
+}
+
+//=============================================================================================================
+
 double RtFiffRawViewModel::getMaxValueFromRawViewModel(int row) const
 {
     double dMaxValue;
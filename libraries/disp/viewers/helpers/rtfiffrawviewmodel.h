@@ -43,11 +43,13 @@
 //=============================================================================================================
 
 #include "../../disp_global.h"
+#include "envelopepyramid.h"
 
 #include <fiff/fiff_types.h>
 #include <fiff/fiff_proj.h>
 
 #include <rtprocessing/helpers/filterkernel.h>
+#include <rtprocessing/helpers/iirfilter.h>
 
 #include <events/eventmanager.h>
 
@@ -262,6 +264,16 @@ public:
      */
     inline const QMap<qint32,qint32>& getIdxSelMap() const;
 
+    //=========================================================================================================
+    /**
+     * Returns the min/max envelope pyramid which belongs to the data currently returned by data(), i.e. taking
+     * the freeze and filter states into account. Rows of the pyramid correspond to channel indices, use
+     * getIdxSelMap() to map a model row to its channel.
+     *
+     * @return the envelope pyramid of the displayed data.
+     */
+    inline const EnvelopePyramid& getEnvelopePyramid() const;
+
     //=========================================================================================================
     /**
      * Selects the given list of channel indeces and unselect all other channels
@@ -573,12 +585,31 @@ private:
      */
     void filterDataBlock(const Eigen::MatrixXd &data, int iDataIndex);
 
+    //=========================================================================================================
+    /**
+     * Calculates the FIR filtered version of the input data via overlap add and stores it in m_matDataFiltered.
+     *
+     * @param[in] data          data which is to be filtered.
+     * @param[in] iDataIndex    current position in the global data matrix.
+     */
+    void filterDataBlockFir(const Eigen::MatrixXd &data, int iDataIndex);
+
     //=========================================================================================================
     /**
      * Clears the model
      */
     void clearModel();
 
+    //=========================================================================================================
+    /**
+     * Updates the envelope pyramids after new data was written to the data matrices.
+     *
+     * @param[in] iFirstSample   First sample which was written.
+     * @param[in] iNumSamples    Number of written samples. Pass a negative value to rebuild the whole pyramids.
+     */
+    void updateEnvelopes(int iFirstSample,
+                         int iNumSamples);
+
     bool                                m_bProjActivated;                           /**< Projections activated. */
     bool                                m_bCompActivated;                           /**< Compensator activated. */
     bool                                m_bSpharaActivated;                         /**< Sphara activated. */
@@ -616,6 +647,11 @@ private:
     MatrixXdR                           m_matDataFilteredFreeze;                    /**< The raw filtered data in freeze mode. */
     Eigen::MatrixXd                     m_matOverlap;                               /**< Last overlap block for the back. */
 
+    EnvelopePyramid                     m_envelopeRaw;                              /**< Min/max envelopes of the raw data. */
+    EnvelopePyramid                     m_envelopeFiltered;                         /**< Min/max envelopes of the filtered data. */
+    EnvelopePyramid                     m_envelopeRawFreeze;                        /**< Min/max envelopes of the raw data in freeze mode. */
+    EnvelopePyramid                     m_envelopeFilteredFreeze;                   /**< Min/max envelopes of the filtered data in freeze mode. */
+
     Eigen::VectorXi                     m_vecIndicesFirstVV;                        /**< The indices of the channels to pick for the first SPHARA operator in case of a VectorView system.*/
     Eigen::VectorXi                     m_vecIndicesSecondVV;                       /**< The indices of the channels to pick for the second SPHARA operator in case of a VectorView system.*/
     Eigen::VectorXi                     m_vecIndicesFirstBabyMEG;                   /**< The indices of the channels to pick for the first SPHARA operator in case of a BabyMEG system.*/
@@ -644,6 +680,8 @@ private:
     QMap<int,QList<QPair<int,double> > >m_qMapDetectedTriggerOldFreeze;             /**< Old detected trigger for each trigger channel while display is freezed. */
     QMap<qint32,float>                  m_qMapChScaling;                            /**< Channel scaling map. */
     QList<RTPROCESSINGLIB::FilterKernel>m_filterKernel;                             /**< List of currently active filters. */
+    QList<RTPROCESSINGLIB::FilterKernel>m_lFirFilterKernel;                         /**< List of currently active FIR filters. */
+    RTPROCESSINGLIB::IirFilter          m_iirFilter;                                /**< Cascade of all currently active IIR filters, holding the per channel state. */
     QStringList                         m_filterChannelList;                        /**< List of channels which are to be filtered.*/
     QStringList                         m_visibleChannelList;                       /**< List of currently visible channels in the view.*/
     QMap<qint32,qint32>                 m_qMapIdxRowSelection;                      /**< Selection mapping.*/
@@ -722,6 +760,17 @@ inline const QMap<qint32,qint32>& RtFiffRawViewModel::getIdxSelMap() const
 
 //=============================================================================================================
 
+inline const EnvelopePyramid& RtFiffRawViewModel::getEnvelopePyramid() const
+{
+    if(!m_filterKernel.isEmpty() && m_bPerformFiltering) {
+        return m_bIsFreezed ? m_envelopeFilteredFreeze : m_envelopeFiltered;
+    }
+
+    return m_bIsFreezed ? m_envelopeRawFreeze : m_envelopeRaw;
+}
+
+//=============================================================================================================
+
 inline qint32 RtFiffRawViewModel::numVLines() const
 {
     return (m_iT - 1);
@@ -73,7 +73,7 @@ RtSourceInterpolationMatWorker::RtSourceInterpolationMatWorker()
 {
     m_lInterpolationData.dCancelDistance = 0.05;
     m_lInterpolationData.interpolationFunction = DISP3DLIB::Interpolation::cubic;
-    m_lInterpolationData.matDistanceMatrix = QSharedPointer<MatrixXd>(new MatrixXd());
+    m_lInterpolationData.matDistanceMatrix = QSharedPointer<SparseMatrix<double> >::create();
 }
 
 //=============================================================================================================
@@ -200,11 +200,11 @@ void RtSourceInterpolationMatWorker::calculateInterpolationOperator()
         return;
     }
 
-    //SCDC with cancel distance
-    m_lInterpolationData.matDistanceMatrix = GeometryInfo::scdc(m_lInterpolationData.matVertices,
-                                                                m_lInterpolationData.vecNeighborVertices,
-                                                                m_lInterpolationData.vecMappedSubset,
-                                                                m_lInterpolationData.dCancelDistance);
+    //SCDC with cancel distance, only distances inside the cancel distance are stored
+    m_lInterpolationData.matDistanceMatrix = GeometryInfo::scdcSparse(m_lInterpolationData.matVertices,
+                                                                      m_lInterpolationData.vecNeighborVertices,
+                                                                      m_lInterpolationData.vecMappedSubset,
+                                                                      m_lInterpolationData.dCancelDistance);
 
     //create Interpolation matrix
     m_pMatInterpolationMat = Interpolation::createInterpolationMat(m_lInterpolationData.vecMappedSubset,
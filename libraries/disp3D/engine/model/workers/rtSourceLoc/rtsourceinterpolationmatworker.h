@@ -176,7 +176,7 @@ protected:
     struct InterpolationData {
         double                          dCancelDistance;                /**< Cancel distance for the interpolaion in meters. */
 
-        QSharedPointer<Eigen::MatrixXd> matDistanceMatrix;              /**< Distance matrix that holds distances from sensors positions to the near vertices in meters. */
+        QSharedPointer<Eigen::SparseMatrix<double> > matDistanceMatrix; /**< Sparse distance matrix that holds distances from sensors positions to the near vertices in meters. */
         Eigen::MatrixX3f                matVertices;                    /**< Holds all vertex information. */
 
         QList<FSLIB::Label>             lLabels;                        /**< The annotation labels. */
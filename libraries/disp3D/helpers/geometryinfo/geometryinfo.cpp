@@ -45,9 +45,13 @@
 // INCLUDES
 //=============================================================================================================
 
+#include <algorithm>
 #include <cmath>
 #include <fstream>
+#include <functional>
+#include <queue>
 #include <set>
+#include <vector>
 
 //=============================================================================================================
 // QT INCLUDES
@@ -66,6 +70,7 @@
 using namespace DISP3DLIB;
 using namespace Eigen;
 using namespace FIFFLIB;
+using namespace UTILSLIB;
 
 //=============================================================================================================
 // DEFINE GLOBAL METHODS
@@ -79,6 +84,16 @@ QSharedPointer<MatrixXd> GeometryInfo::scdc(const MatrixX3f &matVertices,
                                             const QVector<QVector<int> > &vecNeighborVertices,
                                             QVector<int> &vecVertSubset,
                                             double dCancelDist)
+{
+    return scdc(matVertices, MeshAdjacency::fromNeighborVert(vecNeighborVertices), vecVertSubset, dCancelDist);
+}
+
+//=============================================================================================================
+
+QSharedPointer<MatrixXd> GeometryInfo::scdc(const MatrixX3f &matVertices,
+                                            const MeshAdjacency &adjacency,
+                                            QVector<int> &vecVertSubset,
+                                            double dCancelDist)
 {
     // create matrix and check for empty subset:
     qint32 iCols = vecVertSubset.size();
@@ -115,7 +130,7 @@ QSharedPointer<MatrixXd> GeometryInfo::scdc(const MatrixX3f &matVertices,
             vecThreads[i] = QtConcurrent::run(std::bind(iterativeDijkstra,
                                                         returnMat,
                                                         std::cref(matVertices),
-                                                        std::cref(vecNeighborVertices),
+                                                        std::cref(adjacency),
                                                         std::cref(vecVertSubset),
                                                         iBegin,
                                                         vecVertSubset.size(),
@@ -127,7 +142,7 @@ QSharedPointer<MatrixXd> GeometryInfo::scdc(const MatrixX3f &matVertices,
             vecThreads[i] = QtConcurrent::run(std::bind(iterativeDijkstra,
                                                         returnMat,
                                                         std::cref(matVertices),
-                                                        std::cref(vecNeighborVertices),
+                                                        std::cref(adjacency),
                                                         std::cref(vecVertSubset),
                                                         iBegin,
                                                         iEnd,
@@ -147,6 +162,70 @@ QSharedPointer<MatrixXd> GeometryInfo::scdc(const MatrixX3f &matVertices,
 
 //=============================================================================================================
 
+QSharedPointer<SparseMatrix<double> > GeometryInfo::scdcSparse(const MatrixX3f &matVertices,
+                                                               const QVector<QVector<int> > &vecNeighborVertices,
+                                                               QVector<int> &vecVertSubset,
+                                                               double dCancelDist)
+{
+    return scdcSparse(matVertices, MeshAdjacency::fromNeighborVert(vecNeighborVertices), vecVertSubset, dCancelDist);
+}
+
+//=============================================================================================================
+
+QSharedPointer<SparseMatrix<double> > GeometryInfo::scdcSparse(const MatrixX3f &matVertices,
+                                                               const MeshAdjacency &adjacency,
+                                                               QVector<int> &vecVertSubset,
+                                                               double dCancelDist)
+{
+    if(vecVertSubset.empty()) {
+        // caller passed an empty subset, need to fill in all vertex IDs
+        vecVertSubset.reserve(matVertices.rows());
+        for(qint32 id = 0; id < matVertices.rows(); ++id) {
+            vecVertSubset.push_back(id);
+        }
+    }
+
+    // distribute the roots on cores, every thread works with its own queue and distance buffer
+    int iCores = QThread::idealThreadCount();
+    if (iCores <= 0) {
+        // assume that we have at least two available cores
+        iCores = 2;
+    }
+    iCores = std::max(1, std::min(iCores, vecVertSubset.size()));
+
+    const qint32 iSubArraySize = vecVertSubset.size() / iCores;
+    QVector<QFuture<QVector<Triplet<double> > > > vecThreads(iCores);
+    qint32 iBegin = 0;
+
+    for (int i = 0; i < vecThreads.size(); ++i) {
+        // last round takes the remainder
+        const qint32 iEnd = (i == vecThreads.size() - 1) ? vecVertSubset.size() : iBegin + iSubArraySize;
+        vecThreads[i] = QtConcurrent::run(std::bind(boundedDijkstra,
+                                                    std::cref(matVertices),
+                                                    std::cref(adjacency),
+                                                    std::cref(vecVertSubset),
+                                                    iBegin,
+                                                    iEnd,
+                                                    dCancelDist));
+        iBegin = iEnd;
+    }
+
+    // merge the triplets of all threads
+    QVector<Triplet<double> > vecTriplets;
+    for (QFuture<QVector<Triplet<double> > >& f : vecThreads) {
+        f.waitForFinished();
+        vecTriplets.append(f.result());
+    }
+
+    // convention: first dimension in distance table is "from", second dimension "to"
+    QSharedPointer<SparseMatrix<double> > returnMat = QSharedPointer<SparseMatrix<double> >::create(matVertices.rows(), vecVertSubset.size());
+    returnMat->setFromTriplets(vecTriplets.begin(), vecTriplets.end());
+
+    return returnMat;
+}
+
+//=============================================================================================================
+
 QVector<int> GeometryInfo::projectSensors(const MatrixX3f &matVertices,
                                           const QVector<Vector3f> &vecSensorPositions)
 {
@@ -247,14 +326,13 @@ int u =0;
 
 void GeometryInfo::iterativeDijkstra(QSharedPointer<MatrixXd> matOutputDistMatrix,
                                      const MatrixX3f &matVertices,
-                                     const QVector<QVector<int> > &vecNeighborVertices,
+                                     const MeshAdjacency &adjacency,
                                      const QVector<int> &vecVertSubset,
                                      qint32 iBegin,
                                      qint32 iEnd,
                                      double dCancelDistance) {
     // initialization
-    const QVector<QVector<int> > &vecAdjacency = vecNeighborVertices;
-    qint32 n = vecAdjacency.size();
+    qint32 n = adjacency.numVertices();
     QVector<double> vecMinDists(n);
     std::set< std::pair< double, qint32> > vertexQ;
     const double INF = FLOAT_INFINITY;
@@ -262,8 +340,6 @@ void GeometryInfo::iterativeDijkstra(QSharedPointer<MatrixXd> matOutputDistMatri
     // outer loop, iterated for each vertex of 'vertSubset' between 'begin' and 'end'
     for (qint32 i = iBegin; i < iEnd; ++i) {
         // init phase of dijkstra: set source node for current iteration and reset data fields
-        if(i ==123)
-            qDebug() << "blabla";
         qint32 iRoot = vecVertSubset.at(i);
         vertexQ.clear();
         vecMinDists.fill(INF);
@@ -280,10 +356,10 @@ void GeometryInfo::iterativeDijkstra(QSharedPointer<MatrixXd> matOutputDistMatri
             // check if we are still below cancel distance
             if (dDist <= dCancelDistance) {
                 // visit each neighbour of u
-                const QVector<int>& vecNeighbours = vecAdjacency[u];
+                const int* pNeighbours = adjacency.neighborVert(u);
 
-                for (qint32 ne = 0; ne < vecNeighbours.length(); ++ne) {
-                    qint32 v = vecNeighbours[ne];
+                for (qint32 ne = 0; ne < adjacency.numNeighborVert(u); ++ne) {
+                    qint32 v = pNeighbours[ne];
 
                     // distance from source (i.e. root) to v, using u as its predecessor
                     // calculate inline since designated function was magnitudes slower (even when declared as inline)
@@ -311,6 +387,72 @@ void GeometryInfo::iterativeDijkstra(QSharedPointer<MatrixXd> matOutputDistMatri
 
 //=============================================================================================================
 
+QVector<Triplet<double> > GeometryInfo::boundedDijkstra(const MatrixX3f &matVertices,
+                                                        const MeshAdjacency &adjacency,
+                                                        const QVector<int> &vecVertSubset,
+                                                        qint32 iBegin,
+                                                        qint32 iEnd,
+                                                        double dCancelDistance)
+{
+    typedef std::pair<double, qint32> QueueEntry;
+
+    // initialization, the distance buffer is only reset at the vertices touched by the previous root
+    QVector<Triplet<double> > vecTriplets;
+    std::vector<double> vecMinDists(adjacency.numVertices(), std::numeric_limits<double>::infinity());
+    std::vector<qint32> vecTouched;
+    std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry> > vertexQ;
+
+    for (qint32 i = iBegin; i < iEnd; ++i) {
+        const qint32 iRoot = vecVertSubset.at(i);
+        vecMinDists[iRoot] = 0.0;
+        vecTouched.push_back(iRoot);
+        vertexQ.push(std::make_pair(0.0, iRoot));
+
+        while (vertexQ.empty() == false) {
+            const double dDist = vertexQ.top().first;
+            const qint32 u = vertexQ.top().second;
+            vertexQ.pop();
+
+            // skip outdated queue entries instead of searching them on decreaseKey
+            if (dDist > vecMinDists[u]) {
+                continue;
+            }
+
+            // u is settled, only vertices inside the cancel distance are ever queued
+            vecTriplets.push_back(Triplet<double>(u, i, dDist));
+
+            const int* pNeighbours = adjacency.neighborVert(u);
+
+            for (qint32 ne = 0; ne < adjacency.numNeighborVert(u); ++ne) {
+                const qint32 v = pNeighbours[ne];
+
+                // same arithmetic as iterativeDijkstra, so both yield identical distances
+                const double dDistX = matVertices(u, 0) - matVertices(v, 0);
+                const double dDistY = matVertices(u, 1) - matVertices(v, 1);
+                const double dDistZ = matVertices(u, 2) - matVertices(v, 2);
+                const double dDistWithU = dDist + sqrt(dDistX * dDistX + dDistY * dDistY + dDistZ * dDistZ);
+
+                if (dDistWithU <= dCancelDistance && dDistWithU < vecMinDists[v]) {
+                    if (vecMinDists[v] == std::numeric_limits<double>::infinity()) {
+                        vecTouched.push_back(v);
+                    }
+                    vecMinDists[v] = dDistWithU;
+                    vertexQ.push(std::make_pair(dDistWithU, v));
+                }
+            }
+        }
+
+        for (qint32 v : vecTouched) {
+            vecMinDists[v] = std::numeric_limits<double>::infinity();
+        }
+        vecTouched.clear();
+    }
+
+    return vecTriplets;
+}
+
+//=============================================================================================================
+
 QVector<int> GeometryInfo::filterBadChannels(QSharedPointer<Eigen::MatrixXd> matDistanceTable,
                                                 const FIFFLIB::FiffInfo& fiffInfo,
                                                 qint32 iSensorType) {
@@ -41,6 +41,7 @@
 
 #include "../../disp3D_global.h"
 #include <fiff/fiff_evoked.h>
+#include <utils/meshadjacency.h>
 
 //=============================================================================================================
 // INCLUDES
@@ -60,6 +61,7 @@
 //=============================================================================================================
 
 #include <Eigen/Core>
+#include <Eigen/SparseCore>
 
 //=============================================================================================================
 // FORWARD DECLARATIONS
@@ -121,6 +123,55 @@ public:
                                                 QVector<int> &pVecVertSubset,
                                                 double dCancelDist = FLOAT_INFINITY);
 
+    //=========================================================================================================
+    /**
+     * @brief scdc                           Calculates surface constrained distances on a mesh.
+     * @param[in] matVertices                The surface on which distances should be calculated.
+     * @param[in] adjacency                  The CSR neighbor vertex information.
+     * @param[in/out] pVecVertSubset         The subset of IDs for which the distances should be calculated.
+     * @param[in] dCancelDist                Distances higher than this are ignored, i.e. set to infinity.
+     * @return                               A double matrix. One column represents the distances for one vertex inside of the passed subset.
+     */
+    static QSharedPointer<Eigen::MatrixXd> scdc(const Eigen::MatrixX3f &matVertices,
+                                                const UTILSLIB::MeshAdjacency &adjacency,
+                                                QVector<int> &pVecVertSubset,
+                                                double dCancelDist = FLOAT_INFINITY);
+
+    //=========================================================================================================
+    /**
+     * @brief scdcSparse                     Calculates surface constrained distances on a mesh up to a cancel distance.
+     *
+     * @param[in] matVertices                The surface on which distances should be calculated.
+     * @param[in] vecNeighborVertices        The neighbor vertex information.
+     * @param[in/out] pVecVertSubset         The subset of IDs for which the distances should be calculated.
+     * @param[in] dCancelDist                Vertices farther away than this are not stored.
+     *
+     * @return                               A sparse vertices x subset matrix holding all distances up to dCancelDist.
+     */
+    static QSharedPointer<Eigen::SparseMatrix<double> > scdcSparse(const Eigen::MatrixX3f &matVertices,
+                                                                   const QVector<QVector<int> > &vecNeighborVertices,
+                                                                   QVector<int> &pVecVertSubset,
+                                                                   double dCancelDist);
+
+    //=========================================================================================================
+    /**
+     * @brief scdcSparse                     Calculates surface constrained distances on a mesh up to a cancel distance.
+     *                                       Each root runs a Dijkstra that stops at dCancelDist, so the costs scale with the
+     *                                       number of vertices inside the cancel radius instead of the mesh size. The entries
+     *                                       are identical to the ones of scdc that are not larger than dCancelDist.
+     *
+     * @param[in] matVertices                The surface on which distances should be calculated.
+     * @param[in] adjacency                  The CSR neighbor vertex information.
+     * @param[in/out] pVecVertSubset         The subset of IDs for which the distances should be calculated.
+     * @param[in] dCancelDist                Vertices farther away than this are not stored.
+     *
+     * @return                               A sparse vertices x subset matrix holding all distances up to dCancelDist.
+     */
+    static QSharedPointer<Eigen::SparseMatrix<double> > scdcSparse(const Eigen::MatrixX3f &matVertices,
+                                                                   const UTILSLIB::MeshAdjacency &adjacency,
+                                                                   QVector<int> &pVecVertSubset,
+                                                                   double dCancelDist);
+
     //=========================================================================================================
     /**
      * @brief                            Calculates the nearest neighbor (euclidian distance) vertex to each sensor
@@ -179,7 +230,7 @@ protected:
      *
      * @param[out] matOutputDistMatrix  The matrix in which the distances will be stored.
      * @param[in] matVertices           The surface on which distances should be calculated.
-     * @param[in] vecNeighborVertices   The neighbor vertex information.
+     * @param[in] adjacency             The CSR neighbor vertex information.
      * @param[in] vecVertSubset         The subset of vertices.
      * @param[in] iBegin                Start index of distance calculation.
      * @param[in] iEnd                  End index of distance calculation, exclusive.
@@ -187,11 +238,31 @@ protected:
      */
     static void iterativeDijkstra(QSharedPointer<Eigen::MatrixXd> matOutputDistMatrix,
                                   const Eigen::MatrixX3f &matVertices,
-                                  const QVector<QVector<int> > &vecNeighborVertices,
+                                  const UTILSLIB::MeshAdjacency &adjacency,
                                   const QVector<int> &vecVertSubset,
                                   qint32 iBegin,
                                   qint32 iEnd,
                                   double dCancelDistance);
+
+    //=========================================================================================================
+    /**
+     * @brief boundedDijkstra       Calculates shortest distances up to a cancel distance for each vertex of the passed vector that lies between the two indices
+     *
+     * @param[in] matVertices           The surface on which distances should be calculated.
+     * @param[in] adjacency             The CSR neighbor vertex information.
+     * @param[in] vecVertSubset         The subset of vertices.
+     * @param[in] iBegin                Start index of distance calculation.
+     * @param[in] iEnd                  End index of distance calculation, exclusive.
+     * @param[in] dCancelDistance       Distance threshold: vertices with a higher distance to the respective root vertex are not visited.
+     *
+     * @return                          The (vertex, subset index, distance) triplets of all visited vertices.
+     */
+    static QVector<Eigen::Triplet<double> > boundedDijkstra(const Eigen::MatrixX3f &matVertices,
+                                                            const UTILSLIB::MeshAdjacency &adjacency,
+                                                            const QVector<int> &vecVertSubset,
+                                                            qint32 iBegin,
+                                                            qint32 iEnd,
+                                                            double dCancelDistance);
 };
 
 //=============================================================================================================
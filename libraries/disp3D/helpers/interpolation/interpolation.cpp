@@ -137,6 +137,85 @@ QSharedPointer<SparseMatrix<float> > Interpolation::createInterpolationMat(const
 
 //=============================================================================================================
 
+QSharedPointer<SparseMatrix<float> > Interpolation::createInterpolationMat(const QVector<int> &vecProjectedSensors,
+                                                                           const QSharedPointer<SparseMatrix<double> > matDistanceTable,
+                                                                           double (*interpolationFunction) (double),
+                                                                           const double dCancelDist,
+                                                                           const QVector<int> &vecExcludeIndex)
+{
+    if(matDistanceTable->rows() == 0 && matDistanceTable->cols() == 0) {
+        qDebug() << "[WARNING] Interpolation::createInterpolationMat - received an empty distance table.";
+        return QSharedPointer<SparseMatrix<float> >::create();
+    }
+
+    QSharedPointer<Eigen::SparseMatrix<float> > matInterpolationMatrix = QSharedPointer<SparseMatrix<float> >::create(matDistanceTable->rows(), vecProjectedSensors.size());
+
+    const qint32 iRows = matInterpolationMatrix->rows();
+    const qint32 iCols = std::min(matInterpolationMatrix->cols(), matDistanceTable->cols());
+
+    // lookup tables replace the per vertex set and indexOf searches: first subset index of each sensor vertex and excluded columns
+    QVector<qint32> vecSensorIndex(iRows, -1);
+    QVector<bool> vecIsSensor(iRows, false);
+    QVector<bool> vecIsExcluded(vecProjectedSensors.size(), false);
+
+    for(const int& idx : vecExcludeIndex) {
+        if(idx >= 0 && idx < vecIsExcluded.size()) {
+            vecIsExcluded[idx] = true;
+        }
+    }
+
+    for(qint32 idx = 0; idx < vecProjectedSensors.size(); ++idx) {
+        const qint32 s = vecProjectedSensors[idx];
+        if(s < 0 || s >= iRows) {
+            continue;
+        }
+        if(vecSensorIndex[s] < 0) {
+            vecSensorIndex[s] = idx;
+        }
+        if(!vecIsExcluded[idx]) {
+            vecIsSensor[s] = true;
+        }
+    }
+
+    // go through the stored distances column by column, weights are accumulated per vertex in the same order as in the dense version
+    QVector<Triplet<float> > vecNonZeroEntries;
+    VectorXf vecWeightSums = VectorXf::Zero(iRows);
+
+    for (qint32 c = 0; c < iCols; ++c) {
+        if(vecIsExcluded[c]) {
+            continue;
+        }
+
+        for (SparseMatrix<double>::InnerIterator it(*matDistanceTable, c); it; ++it) {
+            const qint32 r = it.row();
+            const float dDist = it.value();
+
+            if (!vecIsSensor[r] && dDist < dCancelDist) {
+                const float dValueWeight = std::fabs(1.0 / interpolationFunction(dDist));
+                vecWeightSums[r] += dValueWeight;
+                vecNonZeroEntries.push_back(Eigen::Triplet<float> (r, c, dValueWeight));
+            }
+        }
+    }
+
+    for (Triplet<float> &entry : vecNonZeroEntries) {
+        entry = Triplet<float> (entry.row(), entry.col(), entry.value() / vecWeightSums[entry.row()]);
+    }
+
+    // a sensor has been assigned to these nodes, final vertex signal is equal to sensor input signal, thus factor 1
+    for (qint32 r = 0; r < iRows; ++r) {
+        if (vecIsSensor[r]) {
+            vecNonZeroEntries.push_back(Eigen::Triplet<float> (r, vecSensorIndex[r], 1));
+        }
+    }
+
+    matInterpolationMatrix->setFromTriplets(vecNonZeroEntries.begin(), vecNonZeroEntries.end());
+
+    return matInterpolationMatrix;
+}
+
+//=============================================================================================================
+
 VectorXf Interpolation::interpolateSignal(const QSharedPointer<SparseMatrix<float> > matInterpolationMatrix,
                                           const QSharedPointer<VectorXf> &vecMeasurementData)
 {
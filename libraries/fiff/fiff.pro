@@ -75,6 +75,7 @@ SOURCES += fiff.cpp \
     fiff_tag.cpp \
     fiff_coord_trans.cpp \
     fiff_ch_info.cpp \
+    fiff_ch_name_index.cpp \
     fiff_proj.cpp \
     fiff_named_matrix.cpp \
     fiff_raw_data.cpp \
@@ -87,12 +88,14 @@ SOURCES += fiff.cpp \
     fiff_cov.cpp \
     fiff_stream.cpp \
     fiff_dir_entry.cpp \
+    fiff_dir_entry_list.cpp \
     fiff_info_base.cpp \
     fiff_evoked.cpp \
     fiff_evoked_set.cpp \
     fiff_io.cpp \
     fiff_dig_point_set.cpp \
     fiff_dir_node.cpp \
+    fiff_index.cpp \
     c/fiff_coord_trans_old.cpp \
     c/fiff_sparse_matrix.cpp \
     c/fiff_digitizer_data.cpp \
@@ -109,12 +112,14 @@ HEADERS += fiff.h \
     fiff_tag.h \
     fiff_coord_trans.h \
     fiff_ch_info.h \
+    fiff_ch_name_index.h \
     fiff_proj.h \
     fiff_named_matrix.h \
     fiff_ctf_comp.h \
     fiff_info.h \
     fiff_raw_data.h \
     fiff_dir_entry.h \
+    fiff_dir_entry_list.h \
     fiff_raw_dir.h \
     fiff_dig_point.h \
     fiff_ch_pos.h \
@@ -126,6 +131,7 @@ HEADERS += fiff.h \
     fiff_io.h \
     fiff_dig_point_set.h \
     fiff_dir_node.h \
+    fiff_index.h \
     c/fiff_coord_trans_old.h \
     c/fiff_sparse_matrix.h \
     c/fiff_types_mne-c.h \
@@ -0,0 +1,162 @@
+//=============================================================================================================
+/**
+ * @file     fiff_ch_name_index.cpp
+ * @author   agent <agent@local>
+ * @since    0.1.9
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, agent. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    Definition of the FiffChNameIndex Class.
+ *
+ */
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include "fiff_ch_name_index.h"
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QMutexLocker>
+
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace FIFFLIB;
+
+//=============================================================================================================
+// DEFINE MEMBER METHODS
+//=============================================================================================================
+
+FiffChNameIndex::FiffChNameIndex()
+: m_bValid(false)
+, m_bBadsValid(false)
+{
+}
+
+//=============================================================================================================
+
+FiffChNameIndex::FiffChNameIndex(const FiffChNameIndex& p_FiffChNameIndex)
+{
+    QMutexLocker locker(&p_FiffChNameIndex.m_mutex);
+    m_names = p_FiffChNameIndex.m_names;
+    m_hash = p_FiffChNameIndex.m_hash;
+    m_bads = p_FiffChNameIndex.m_bads;
+    m_badMask = p_FiffChNameIndex.m_badMask;
+    m_bValid = p_FiffChNameIndex.m_bValid;
+    m_bBadsValid = p_FiffChNameIndex.m_bBadsValid;
+}
+
+//=============================================================================================================
+
+FiffChNameIndex& FiffChNameIndex::operator= (const FiffChNameIndex& p_FiffChNameIndex)
+{
+    if(this == &p_FiffChNameIndex) {
+        return *this;
+    }
+
+    FiffChNameIndex t_copy(p_FiffChNameIndex);
+
+    QMutexLocker locker(&m_mutex);
+    m_names = t_copy.m_names;
+    m_hash = t_copy.m_hash;
+    m_bads = t_copy.m_bads;
+    m_badMask = t_copy.m_badMask;
+    m_bValid = t_copy.m_bValid;
+    m_bBadsValid = t_copy.m_bBadsValid;
+
+    return *this;
+}
+
+//=============================================================================================================
+
+QHash<QString,qint32> FiffChNameIndex::hash(const QStringList& names) const
+{
+    QMutexLocker locker(&m_mutex);
+    update(names);
+    return m_hash;
+}
+
+//=============================================================================================================
+
+qint32 FiffChNameIndex::indexOf(const QStringList& names, const QString& name) const
+{
+    QMutexLocker locker(&m_mutex);
+    update(names);
+    return m_hash.value(name, -1);
+}
+
+//=============================================================================================================
+
+QBitArray FiffChNameIndex::badMask(const QStringList& names, const QStringList& bads) const
+{
+    QMutexLocker locker(&m_mutex);
+    update(names);
+
+    if(!m_bBadsValid || m_bads != bads) {
+        m_badMask = QBitArray(m_names.size());
+        for(qint32 k = 0; k < bads.size(); ++k) {
+            // Set every occurrence, duplicate names are all bad
+            for(qint32 idx = m_hash.value(bads[k], -1); idx > -1; idx = m_names.indexOf(bads[k], idx + 1)) {
+                m_badMask.setBit(idx);
+            }
+        }
+        m_bads = bads;
+        m_bBadsValid = true;
+    }
+
+    return m_badMask;
+}
+
+//=============================================================================================================
+
+QHash<QString,qint32> FiffChNameIndex::build(const QStringList& names)
+{
+    QHash<QString,qint32> hash;
+    hash.reserve(names.size());
+    for(qint32 k = names.size() - 1; k >= 0; --k) {
+        hash.insert(names[k], k);
+    }
+    return hash;
+}
+
+//=============================================================================================================
+
+void FiffChNameIndex::update(const QStringList& names) const
+{
+    // QStringList compares the shared data first, so this is O(1) as long as the owner did not touch the list
+    if(m_bValid && m_names == names) {
+        return;
+    }
+
+    m_names = names;
+    m_hash = build(names);
+    m_bValid = true;
+    m_bBadsValid = false;
+}
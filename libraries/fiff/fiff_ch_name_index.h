@@ -0,0 +1,151 @@
+//=============================================================================================================
+/**
+ * @file     fiff_ch_name_index.h
+ * @author   agent <agent@local>
+ * @since    0.1.9
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, agent. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    FiffChNameIndex class declaration.
+ *
+ */
+
+#ifndef FIFF_CH_NAME_INDEX_H
+#define FIFF_CH_NAME_INDEX_H
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include "fiff_global.h"
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QBitArray>
+#include <QHash>
+#include <QMutex>
+#include <QStringList>
+
+//=============================================================================================================
+// DEFINE NAMESPACE FIFFLIB
+//=============================================================================================================
+
+namespace FIFFLIB
+{
+
+//=============================================================================================================
+/**
+ * Lazily built name -> index hash of a channel name list, plus a bit mask of the bad channels in that list.
+ * The owner keeps its plain QStringList members; the index remembers the lists it was built from and is
+ * rebuilt on the next lookup after one of them changed. Lookups are thread safe.
+ *
+ * @brief Hashed channel name index
+ */
+class FIFFSHARED_EXPORT FiffChNameIndex
+{
+public:
+    //=========================================================================================================
+    /**
+     * Constructs an empty index.
+     */
+    FiffChNameIndex();
+
+    //=========================================================================================================
+    /**
+     * Copy constructor. The already built index is shared with the copy.
+     *
+     * @param[in] p_FiffChNameIndex  Index which should be copied.
+     */
+    FiffChNameIndex(const FiffChNameIndex& p_FiffChNameIndex);
+
+    //=========================================================================================================
+    /**
+     * Assignment operator. The already built index is shared with the target.
+     *
+     * @param[in] p_FiffChNameIndex  Index which should be assigned.
+     *
+     * @return   This index.
+     */
+    FiffChNameIndex& operator= (const FiffChNameIndex& p_FiffChNameIndex);
+
+    //=========================================================================================================
+    /**
+     * Returns the name -> index hash of the given list. The first occurrence wins for duplicate names, as with
+     * QStringList::indexOf.
+     *
+     * @param[in] names      The channel names, usually the owner's list.
+     *
+     * @return   The hash (implicitly shared, cheap to copy).
+     */
+    QHash<QString,qint32> hash(const QStringList& names) const;
+
+    //=========================================================================================================
+    /**
+     * Returns the index of a channel name.
+     *
+     * @param[in] names      The channel names, usually the owner's list.
+     * @param[in] name       The name to look up.
+     *
+     * @return   The index of name in names, -1 if not found.
+     */
+    qint32 indexOf(const QStringList& names, const QString& name) const;
+
+    //=========================================================================================================
+    /**
+     * Returns a bit mask with one bit per entry of names, set if the channel is listed in bads.
+     *
+     * @param[in] names      The channel names, usually the owner's list.
+     * @param[in] bads       The bad channel names.
+     *
+     * @return   The bad channel mask.
+     */
+    QBitArray badMask(const QStringList& names, const QStringList& bads) const;
+
+    //=========================================================================================================
+    /**
+     * Builds a name -> index hash without caching, e.g. for include/exclude lists passed to selections.
+     *
+     * @param[in] names      The channel names.
+     *
+     * @return   The hash, first occurrence wins.
+     */
+    static QHash<QString,qint32> build(const QStringList& names);
+
+private:
+    void update(const QStringList& names) const;
+
+    mutable QMutex                  m_mutex;        /**< Guards the lazily built members. */
+    mutable QStringList             m_names;        /**< The names the hash was built from. */
+    mutable QHash<QString,qint32>   m_hash;         /**< Name -> index hash of m_names. */
+    mutable QStringList             m_bads;         /**< The bads the mask was built from. */
+    mutable QBitArray               m_badMask;      /**< Bad channel mask over m_names. */
+    mutable bool                    m_bValid;       /**< Whether m_hash has been built. */
+    mutable bool                    m_bBadsValid;   /**< Whether m_badMask has been built. */
+};
+} // NAMESPACE FIFFLIB
+
+#endif // FIFF_CH_NAME_INDEX_H
@@ -427,6 +427,15 @@ namespace FIFFLIB
  */
 #define FIFF_MNE_RT_COMMAND         3700              /**< Fiff Real-Time Command. */
 #define FIFF_MNE_RT_CLIENT_ID       3701              /**< Fiff Real-Time mne_t_server client id. */
+#define FIFF_MNE_RT_DATA_ENCODING   3702              /**< Fiff Real-Time data buffer encoding accepted by mne_rt_server. */
+#define FIFF_MNE_RT_COMPRESSED_BUFFER 3703            /**< Fiff Real-Time compressed data buffer, see COMMUNICATIONLIB::RtDataCodec. */
+
+#define FIFFV_MNE_RT_GET_CLIENT_ID        1           /**< Command: request the client id at mne_rt_server. */
+#define FIFFV_MNE_RT_SET_CLIENT_ALIAS     2           /**< Command: set the client alias at mne_rt_server. */
+#define FIFFV_MNE_RT_SET_DATA_ENCODING    3           /**< Command: set the data buffer encoding (FIFFV_MNE_RT_ENCODING_*) at mne_rt_server. */
+
+#define FIFFV_MNE_RT_ENCODING_FLOAT       0           /**< Data buffers are sent as FIFF_DATA_BUFFER float32 tags. */
+#define FIFFV_MNE_RT_ENCODING_COMPRESSED  1           /**< Data buffers are sent as FIFF_MNE_RT_COMPRESSED_BUFFER tags. */
 
 /*
  * 3710... Real-Time Blocks
@@ -116,6 +116,7 @@ FiffCov::FiffCov(const FiffCov &p_FiffCov)
 , nfree(p_FiffCov.nfree)
 , eig(p_FiffCov.eig)
 , eigvec(p_FiffCov.eigvec)
+, m_chNameIndex(p_FiffCov.m_chNameIndex)
 {
     qRegisterMetaType<QSharedPointer<FIFFLIB::FiffCov> >("QSharedPointer<FIFFLIB::FiffCov>");
     qRegisterMetaType<FIFFLIB::FiffCov>("FIFFLIB::FiffCov");
@@ -164,7 +165,7 @@ FiffCov FiffCov::pick_channels(const QStringList &p_include, const QStringList &
     res.projs = this->projs;
 
     for(qint32 k = 0; k < this->bads.size(); ++k)
-        if(res.names.contains(this->bads[k]))
+        if(res.ch_index(this->bads[k]) > -1)
             res.bads << this->bads[k];
     res.nfree = this->nfree;
 
@@ -181,7 +182,7 @@ FiffCov FiffCov::prepare_noise_cov(const FiffInfo &p_Info, const QStringList &p_
     qint32 count = 0;
     for(qint32 i = 0; i < p_ChNames.size(); ++i)
     {
-        qint32 idx = p_NoiseCov.names.indexOf(p_ChNames[i]);
+        qint32 idx = p_NoiseCov.ch_index(p_ChNames[i]);
         if(idx > -1)
         {
             C_ch_idx[count] = idx;
@@ -223,11 +224,12 @@ FiffCov FiffCov::prepare_noise_cov(const FiffInfo &p_Info, const QStringList &p_
 
     for(qint32 i = 0; i < pick_meg.size(); ++i)
         meg_names << p_Info.chs[pick_meg[i]].ch_name;
+    QHash<QString,qint32> meg_index = FiffChNameIndex::build(meg_names);
     VectorXi C_meg_idx = VectorXi::Zero(p_NoiseCov.names.size());
     count = 0;
     for(qint32 k = 0; k < C.rows(); ++k)
     {
-        if(meg_names.indexOf(p_ChNames[k]) > -1)
+        if(meg_index.contains(p_ChNames[k]))
         {
             C_meg_idx[count] = k;
             ++count;
@@ -241,11 +243,12 @@ FiffCov FiffCov::prepare_noise_cov(const FiffInfo &p_Info, const QStringList &p_
     //
     for(qint32 i = 0; i < pick_eeg.size(); ++i)
         eeg_names << p_Info.chs[pick_eeg(0,i)].ch_name;
+    QHash<QString,qint32> eeg_index = FiffChNameIndex::build(eeg_names);
     VectorXi C_eeg_idx = VectorXi::Zero(p_NoiseCov.names.size());
     count = 0;
     for(qint32 k = 0; k < C.rows(); ++k)
     {
-        if(eeg_names.indexOf(p_ChNames[k]) > -1)
+        if(eeg_index.contains(p_ChNames[k]))
         {
             C_eeg_idx[count] = k;
             ++count;
@@ -360,14 +363,18 @@ FiffCov FiffCov::regularize(const FiffInfo& p_info, double p_fRegMag, double p_f
     FiffCov cov_good = cov.pick_channels(info_ch_names, p_exclude);
     QStringList ch_names = cov_good.names;
 
+    QHash<QString,qint32> index_eeg = FiffChNameIndex::build(ch_names_eeg);
+    QHash<QString,qint32> index_mag = FiffChNameIndex::build(ch_names_mag);
+    QHash<QString,qint32> index_grad = FiffChNameIndex::build(ch_names_grad);
+
     std::vector<qint32> idx_eeg, idx_mag, idx_grad;
     for(qint32 i = 0; i < ch_names.size(); ++i)
     {
-        if(ch_names_eeg.contains(ch_names[i]))
+        if(index_eeg.contains(ch_names[i]))
             idx_eeg.push_back(i);
-        else if(ch_names_mag.contains(ch_names[i]))
+        else if(index_mag.contains(ch_names[i]))
             idx_mag.push_back(i);
-        else if(ch_names_grad.contains(ch_names[i]))
+        else if(index_grad.contains(ch_names[i]))
             idx_grad.push_back(i);
     }
 
@@ -473,7 +480,22 @@ FiffCov& FiffCov::operator= (const FiffCov &rhs)
         nfree = rhs.nfree;
         eig = rhs.eig;
         eigvec = rhs.eigvec;
+        m_chNameIndex = rhs.m_chNameIndex;
     }
     // to support chained assignment operators (a=b=c), always return *this
     return *this;
 }
+
+//=============================================================================================================
+
+qint32 FiffCov::ch_index(const QString& ch_name) const
+{
+    return m_chNameIndex.indexOf(names, ch_name);
+}
+
+//=============================================================================================================
+
+QBitArray FiffCov::bad_mask() const
+{
+    return m_chNameIndex.badMask(names, bads);
+}
@@ -45,6 +45,7 @@
 #include "fiff_proj.h"
 #include "fiff_types.h"
 #include "fiff_info.h"
+#include "fiff_ch_name_index.h"
 
 //=============================================================================================================
 // QT INCLUDES
@@ -186,6 +187,25 @@ public:
      */
     friend std::ostream& operator<<(std::ostream& out, const FIFFLIB::FiffCov &p_FiffCov);
 
+    //=========================================================================================================
+    /**
+     * Returns the index of a channel in names. The lookup uses a hash which is built on first use and
+     * rebuilt after names changed.
+     *
+     * @param[in] ch_name    The channel name to look up.
+     *
+     * @return the channel index, -1 if the channel is not present.
+     */
+    qint32 ch_index(const QString& ch_name) const;
+
+    //=========================================================================================================
+    /**
+     * Returns a bit mask over names in which the bits of the channels listed in bads are set.
+     *
+     * @return the bad channel mask.
+     */
+    QBitArray bad_mask() const;
+
 public:
     fiff_int_t  kind;       /**< Covariance kind -> fiff_constants.h. */
     Eigen::VectorXi chClass;
@@ -221,6 +241,9 @@ public:
 //    char       **bads;		/* Which channels were designated bad when this noise covariance matrix was computed? */
 //    int        nbad;		/* How many of them */
 // } *mneCovMatrix,mneCovMatrixRec;
+
+private:
+    FiffChNameIndex m_chNameIndex;  /**< Lazily built index of names and bads. */
 };
 
 //=============================================================================================================
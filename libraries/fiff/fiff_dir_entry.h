@@ -128,4 +128,6 @@ inline qint32 FiffDirEntry::storageSize()
 }
 } // NAMESPACE
 
+Q_DECLARE_TYPEINFO(FIFFLIB::FiffDirEntry, Q_MOVABLE_TYPE); /**< Lets QVector relocate the entries of a FiffDirEntryList with memcpy.*/
+
 #endif // FIFF_DIR_ENTRY_H
@@ -0,0 +1,200 @@
+//=============================================================================================================
+/**
+ * @file     fiff_dir_entry_list.cpp
+ * @author   agent <agent@local>
+ * @since    0.1.9
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, agent. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    Definition of the FiffDirEntryList Class.
+ *
+ */
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include "fiff_dir_entry_list.h"
+
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace FIFFLIB;
+
+//=============================================================================================================
+// DEFINE MEMBER METHODS
+//=============================================================================================================
+
+FiffDirEntryList::FiffDirEntryList()
+: m_iFirst(0)
+, m_iSize(0)
+{
+}
+
+//=============================================================================================================
+
+FiffDirEntryList::FiffDirEntryList(const QList<FiffDirEntry::SPtr>& p_listEntries)
+: m_iFirst(0)
+, m_iSize(0)
+{
+    m_vecEntries.reserve(p_listEntries.size());
+    for(const FiffDirEntry::SPtr& pEnt : p_listEntries) {
+        m_vecEntries.append(*pEnt);
+    }
+    m_iSize = m_vecEntries.size();
+}
+
+//=============================================================================================================
+
+FiffDirEntryList FiffDirEntryList::mid(int pos, int len) const
+{
+    FiffDirEntryList view;
+    if(pos < 0 || pos >= m_iSize) {
+        return view;
+    }
+    if(len < 0 || len > m_iSize - pos) {
+        len = m_iSize - pos;
+    }
+
+    view.m_vecEntries = m_vecEntries;
+    view.m_iSize = len;
+    if(m_vecIndices.isEmpty()) {
+        view.m_iFirst = m_iFirst + pos;
+    } else {
+        view.m_vecIndices = m_vecIndices.mid(pos, len);
+    }
+
+    return view;
+}
+
+//=============================================================================================================
+
+FiffDirEntryList FiffDirEntryList::select(const QVector<qint32>& vecPositions) const
+{
+    FiffDirEntryList view;
+    if(vecPositions.isEmpty()) {
+        return view;
+    }
+
+    view.m_vecEntries = m_vecEntries;
+    view.m_vecIndices.reserve(vecPositions.size());
+    for(qint32 k : vecPositions) {
+        view.m_vecIndices.append(storageIndex(k));
+    }
+    view.m_iSize = view.m_vecIndices.size();
+
+    return view;
+}
+
+//=============================================================================================================
+
+void FiffDirEntryList::reserve(int n)
+{
+    detach();
+    m_vecEntries.reserve(n);
+}
+
+//=============================================================================================================
+
+void FiffDirEntryList::clear()
+{
+    m_vecEntries.clear();
+    m_vecIndices.clear();
+    m_iFirst = 0;
+    m_iSize = 0;
+}
+
+//=============================================================================================================
+
+void FiffDirEntryList::append(const FiffDirEntry& p_FiffDirEntry)
+{
+    detach();
+    m_vecEntries.append(p_FiffDirEntry);
+    ++m_iSize;
+}
+
+//=============================================================================================================
+
+void FiffDirEntryList::append(const FiffDirEntryList& other)
+{
+    detach();
+    m_vecEntries.reserve(m_iSize + other.size());
+    for(qint32 k = 0; k < other.size(); ++k) {
+        m_vecEntries.append(*other.at(k));
+    }
+    m_iSize = m_vecEntries.size();
+}
+
+//=============================================================================================================
+
+void FiffDirEntryList::replace(int k, const FiffDirEntry& p_FiffDirEntry)
+{
+    Q_ASSERT(k >= 0 && k < m_iSize);
+    detach();
+    m_vecEntries[k] = p_FiffDirEntry;
+}
+
+//=============================================================================================================
+
+void FiffDirEntryList::removeLast()
+{
+    Q_ASSERT(m_iSize > 0);
+    detach();
+    m_vecEntries.removeLast();
+    --m_iSize;
+}
+
+//=============================================================================================================
+
+QList<FiffDirEntry::SPtr> FiffDirEntryList::toList() const
+{
+    QList<FiffDirEntry::SPtr> listEntries;
+    listEntries.reserve(m_iSize);
+    for(qint32 k = 0; k < m_iSize; ++k) {
+        listEntries.append(FiffDirEntry::SPtr(new FiffDirEntry(*at(k))));
+    }
+
+    return listEntries;
+}
+
+//=============================================================================================================
+
+void FiffDirEntryList::detach()
+{
+    if(m_vecIndices.isEmpty() && m_iFirst == 0 && m_iSize == m_vecEntries.size()) {
+        return;
+    }
+
+    QVector<FiffDirEntry> vecEntries;
+    vecEntries.reserve(m_iSize);
+    for(qint32 k = 0; k < m_iSize; ++k) {
+        vecEntries.append(*at(k));
+    }
+
+    m_vecEntries = vecEntries;
+    m_vecIndices.clear();
+    m_iFirst = 0;
+}
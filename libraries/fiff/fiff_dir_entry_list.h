@@ -0,0 +1,307 @@
+//=============================================================================================================
+/**
+ * @file     fiff_dir_entry_list.h
+ * @author   agent <agent@local>
+ * @since    0.1.9
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, agent. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    FiffDirEntryList class declaration.
+ *
+ */
+
+#ifndef FIFF_DIR_ENTRY_LIST_H
+#define FIFF_DIR_ENTRY_LIST_H
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include "fiff_global.h"
+#include "fiff_types.h"
+#include "fiff_dir_entry.h"
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QList>
+#include <QSharedPointer>
+#include <QVector>
+
+//=============================================================================================================
+// DEFINE NAMESPACE FIFFLIB
+//=============================================================================================================
+
+namespace FIFFLIB
+{
+
+//=============================================================================================================
+/**
+ * A list of directory entries. The entries are kept by value in one contiguous, implicitly shared array, so a
+ * directory of n tags costs one allocation instead of n. mid and select return views which share this array:
+ * a contiguous range of it, like the dir_tree of a node, or a list of indices into it, like the dir of a node.
+ * Element access is const and hands out pointers into the array, so reading through a view never copies it.
+ * Modifying a view first copies its entries into an array of its own.
+ *
+ * @brief Flat list of directory entries.
+ */
+class FIFFSHARED_EXPORT FiffDirEntryList
+{
+
+public:
+    //=========================================================================================================
+    /**
+     * Iterates the entries of a list, dereferences to a pointer to the entry.
+     */
+    class const_iterator
+    {
+    public:
+        inline const_iterator(const FiffDirEntryList* p_pList, int p_iPos) : m_pList(p_pList), m_iPos(p_iPos) {}
+        inline const FiffDirEntry* operator*() const { return m_pList->at(m_iPos); }
+        inline const_iterator& operator++() { ++m_iPos; return *this; }
+        inline bool operator==(const const_iterator& other) const { return m_iPos == other.m_iPos; }
+        inline bool operator!=(const const_iterator& other) const { return m_iPos != other.m_iPos; }
+
+    private:
+        const FiffDirEntryList* m_pList;
+        int                     m_iPos;
+    };
+
+    //=========================================================================================================
+    /**
+     * Constructs an empty list.
+     */
+    FiffDirEntryList();
+
+    //=========================================================================================================
+    /**
+     * Constructs the list from a list of shared entries. The entries are copied.
+     *
+     * @param[in] p_listEntries  The entries.
+     */
+    FiffDirEntryList(const QList<FiffDirEntry::SPtr>& p_listEntries);
+
+    //=========================================================================================================
+    /**
+     * Returns the number of entries.
+     *
+     * @return Number of entries.
+     */
+    inline int size() const;
+
+    //=========================================================================================================
+    /**
+     * Returns whether the list has no entries.
+     *
+     * @return true if the list is empty, false otherwise.
+     */
+    inline bool isEmpty() const;
+
+    //=========================================================================================================
+    /**
+     * Returns the entry at position k. The pointer stays valid until the list or a list sharing its entries
+     * is modified.
+     *
+     * @param[in] k  The position, 0 <= k < size().
+     *
+     * @return The entry.
+     */
+    inline const FiffDirEntry* at(int k) const;
+    inline const FiffDirEntry* operator[](int k) const;
+
+    //=========================================================================================================
+    /**
+     * Returns the index of the entry at position k in the entry array this list shares with the list it was
+     * taken from by mid or select.
+     *
+     * @param[in] k  The position, 0 <= k < size().
+     *
+     * @return The index in the shared entry array.
+     */
+    inline int storageIndex(int k) const;
+
+    //=========================================================================================================
+    /**
+     * Returns whether the list shares its entry array with another list.
+     *
+     * @param[in] other  The other list.
+     *
+     * @return true if both lists refer to the same entry array, false otherwise.
+     */
+    inline bool sharesStorage(const FiffDirEntryList& other) const;
+
+    //=========================================================================================================
+    /**
+     * Returns a view of len entries starting at position pos. A negative len, or one reaching beyond the end,
+     * selects all remaining entries.
+     *
+     * @param[in] pos    The first position.
+     * @param[in] len    The number of entries.
+     *
+     * @return The view.
+     */
+    FiffDirEntryList mid(int pos, int len = -1) const;
+
+    //=========================================================================================================
+    /**
+     * Returns a view of the entries at the given positions.
+     *
+     * @param[in] vecPositions   The positions, each 0 <= k < size().
+     *
+     * @return The view.
+     */
+    FiffDirEntryList select(const QVector<qint32>& vecPositions) const;
+
+    //=========================================================================================================
+    /**
+     * Reserves space for n entries.
+     *
+     * @param[in] n  The number of entries.
+     */
+    void reserve(int n);
+
+    //=========================================================================================================
+    /**
+     * Removes all entries.
+     */
+    void clear();
+
+    //=========================================================================================================
+    /**
+     * Appends an entry.
+     *
+     * @param[in] p_FiffDirEntry     The entry.
+     */
+    void append(const FiffDirEntry& p_FiffDirEntry);
+
+    //=========================================================================================================
+    /**
+     * Appends the entries of another list.
+     *
+     * @param[in] other  The list.
+     */
+    void append(const FiffDirEntryList& other);
+
+    //=========================================================================================================
+    /**
+     * Replaces the entry at position k.
+     *
+     * @param[in] k                  The position, 0 <= k < size().
+     * @param[in] p_FiffDirEntry     The entry.
+     */
+    void replace(int k, const FiffDirEntry& p_FiffDirEntry);
+
+    //=========================================================================================================
+    /**
+     * Removes the last entry.
+     */
+    void removeLast();
+
+    //=========================================================================================================
+    /**
+     * Returns the entries as a list of shared entries. Every entry is copied.
+     *
+     * @return The list of shared entries.
+     */
+    QList<FiffDirEntry::SPtr> toList() const;
+
+    inline const_iterator begin() const;
+    inline const_iterator end() const;
+
+private:
+    //=========================================================================================================
+    /**
+     * Copies the entries of a view into an entry array of its own, called before the list is modified.
+     */
+    void detach();
+
+    QVector<FiffDirEntry>   m_vecEntries;   /**< The entry array, possibly shared with other lists. */
+    QVector<qint32>         m_vecIndices;   /**< Indices of the entries in m_vecEntries, empty if the list is the range given by m_iFirst and m_iSize. */
+    qint32                  m_iFirst;       /**< First entry of the range. */
+    qint32                  m_iSize;        /**< Number of entries. */
+};
+
+//=============================================================================================================
+// INLINE DEFINITIONS
+//=============================================================================================================
+
+inline int FiffDirEntryList::size() const
+{
+    return m_iSize;
+}
+
+//=============================================================================================================
+
+inline bool FiffDirEntryList::isEmpty() const
+{
+    return m_iSize == 0;
+}
+
+//=============================================================================================================
+
+inline const FiffDirEntry* FiffDirEntryList::at(int k) const
+{
+    return m_vecEntries.constData() + storageIndex(k);
+}
+
+//=============================================================================================================
+
+inline const FiffDirEntry* FiffDirEntryList::operator[](int k) const
+{
+    return at(k);
+}
+
+//=============================================================================================================
+
+inline int FiffDirEntryList::storageIndex(int k) const
+{
+    Q_ASSERT(k >= 0 && k < m_iSize);
+    return m_vecIndices.isEmpty() ? m_iFirst + k : m_vecIndices.at(k);
+}
+
+//=============================================================================================================
+
+inline bool FiffDirEntryList::sharesStorage(const FiffDirEntryList& other) const
+{
+    return m_vecEntries.constData() == other.m_vecEntries.constData();
+}
+
+//=============================================================================================================
+
+inline FiffDirEntryList::const_iterator FiffDirEntryList::begin() const
+{
+    return const_iterator(this, 0);
+}
+
+//=============================================================================================================
+
+inline FiffDirEntryList::const_iterator FiffDirEntryList::end() const
+{
+    return const_iterator(this, m_iSize);
+}
+} // NAMESPACE
+
+#endif // FIFF_DIR_ENTRY_LIST_H
@@ -234,7 +234,7 @@ bool FiffDirNode::has_kind(fiff_int_t p_kind) const
 void FiffDirNode::print(int indent) const
 {
     int j, prev_kind,count;
-    QList<FiffDirEntry::SPtr> dentry = this->dir;
+    const FiffDirEntryList& dentry = this->dir;
 
     for (int k = 0; k < indent; k++)
         putchar(' ');
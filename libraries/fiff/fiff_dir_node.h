@@ -45,6 +45,7 @@
 #include "fiff_constants.h"
 #include "fiff_types.h"
 #include "fiff_dir_entry.h"
+#include "fiff_dir_entry_list.h"
 #include "fiff_id.h"
 #include "fiff_explain.h"
 
@@ -245,10 +246,10 @@ public:
 public:
     fiff_int_t                  type;       /**< Block type for this directory. */
     FiffId                      id;         /**< Id of this block if any. */
-    QList<FiffDirEntry::SPtr>   dir;        /**< Directory of tags in this node. */
+    FiffDirEntryList            dir;        /**< Directory of tags in this node, a view of the file directory. */
 //    fiff_int_t                  nent;       /**< Number of entries in this node. */
-    QList<FiffDirEntry::SPtr>   dir_tree;   /**< Directory of tags within this node subtrees
-                                                 as well as FIFF_BLOCK_START and FIFF_BLOCK_END */
+    FiffDirEntryList            dir_tree;   /**< Directory of tags within this node subtrees
+                                                 as well as FIFF_BLOCK_START and FIFF_BLOCK_END, a range of the file directory. */
     fiff_int_t                  nent_tree;  /**< Number of entries in the directory tree node. */
     FiffDirNode::SPtr           parent;     /**< Parent node. */
     FiffId                      parent_id;  /**< Newly added to stay consistent with MATLAB implementation. */
@@ -0,0 +1,414 @@
+//=============================================================================================================
+/**
+ * @file     fiff_index.cpp
+ * @author   agent <agent@local>
+ * @since    0.1.9
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, agent. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    Definition of the FiffIndex Class.
+ *
+ */
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include "fiff_index.h"
+#include "fiff_file.h"
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QSaveFile>
+#include <QVector>
+
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace FIFFLIB;
+
+//=============================================================================================================
+// DEFINE GLOBAL METHODS
+//=============================================================================================================
+
+bool FiffIndex::m_bEnabled = false;
+QString FiffIndex::m_sCacheDir = QString();
+
+namespace {
+const quint32 FIFF_INDEX_MAGIC = 0x4d4e4958; /* MNIX */
+const qint32 FIFF_INDEX_VERSION = 1;
+const int FIFF_INDEX_MAX_DEPTH = 1000;
+}
+
+//=============================================================================================================
+// DEFINE MEMBER METHODS
+//=============================================================================================================
+
+FiffIndex::FiffIndex()
+: nchan(-1)
+, first_samp(0)
+, last_samp(0)
+{
+}
+
+//=============================================================================================================
+
+FiffIndex::FiffIndex(const FiffId& p_id,
+                     const FiffDirEntryList& p_dir,
+                     const FiffDirNode::SPtr& p_dirtree)
+: id(p_id)
+, dir(p_dir)
+, dirtree(p_dirtree)
+, nchan(-1)
+, first_samp(0)
+, last_samp(0)
+{
+}
+
+//=============================================================================================================
+
+void FiffIndex::setEnabled(bool bEnabled)
+{
+    m_bEnabled = bEnabled;
+}
+
+//=============================================================================================================
+
+bool FiffIndex::isEnabled()
+{
+    return m_bEnabled;
+}
+
+//=============================================================================================================
+
+void FiffIndex::setCacheDir(const QString& sCacheDir)
+{
+    m_sCacheDir = sCacheDir;
+}
+
+//=============================================================================================================
+
+QString FiffIndex::cacheDir()
+{
+    return m_sCacheDir;
+}
+
+//=============================================================================================================
+
+QString FiffIndex::indexFileName(const QString& sFileName)
+{
+    if(m_sCacheDir.isEmpty()) {
+        return sFileName + ".mneidx";
+    }
+
+    // Files of the same name in different directories must not share an index
+    QFileInfo fileInfo(sFileName);
+    QByteArray baHash = QCryptographicHash::hash(fileInfo.absoluteFilePath().toUtf8(), QCryptographicHash::Sha1).toHex();
+
+    return QDir(m_sCacheDir).filePath(fileInfo.fileName() + "-" + QString::fromLatin1(baHash.left(16)) + ".mneidx");
+}
+
+//=============================================================================================================
+
+bool FiffIndex::read(const QString& sFileName,
+                     const FiffId& p_id)
+{
+    QFile file(indexFileName(sFileName));
+    if(!file.exists() || !file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_5_0);
+
+    quint32 iMagic;
+    qint32 iVersion;
+    stream >> iMagic >> iVersion;
+    if(stream.status() != QDataStream::Ok || iMagic != FIFF_INDEX_MAGIC || iVersion != FIFF_INDEX_VERSION) {
+        return false;
+    }
+
+    //
+    //   Does the index still belong to the file?
+    //
+    QFileInfo fileInfo(sFileName);
+    qint64 iSize, iLastModified;
+    stream >> iSize >> iLastModified;
+    FiffId t_id = readId(stream);
+    if(stream.status() != QDataStream::Ok
+       || iSize != fileInfo.size()
+       || iLastModified != fileInfo.lastModified().toMSecsSinceEpoch()
+       || t_id.version != p_id.version
+       || t_id.machid[0] != p_id.machid[0]
+       || t_id.machid[1] != p_id.machid[1]
+       || t_id.time.secs != p_id.time.secs
+       || t_id.time.usecs != p_id.time.usecs) {
+        qInfo("Ignoring outdated index %s", file.fileName().toUtf8().constData());
+        return false;
+    }
+
+    //
+    //   The directory
+    //
+    qint32 nent;
+    stream >> nent;
+    if(stream.status() != QDataStream::Ok || nent < 0 || nent > file.size()/FiffDirEntry::storageSize()) {
+        return false;
+    }
+
+    FiffDirEntryList t_dir;
+    FiffDirEntry t_ent;
+    t_dir.reserve(nent);
+    for(qint32 k = 0; k < nent; ++k) {
+        stream >> t_ent.kind >> t_ent.type >> t_ent.size >> t_ent.pos;
+        t_dir.append(t_ent);
+    }
+
+    //
+    //   The directory tree, it refers to the directory by index
+    //
+    this->id = t_id;
+    this->dir = t_dir;
+    this->dirtree = readNode(stream, 0);
+    if(!this->dirtree || stream.status() != QDataStream::Ok) {
+        this->dir.clear();
+        this->dirtree.clear();
+        return false;
+    }
+    this->dirtree->parent.clear();
+
+    //
+    //   The raw data buffers, if the file was set up for raw reading
+    //
+    qint32 t_nchan, nbuf;
+    stream >> t_nchan;
+    this->nchan = -1;
+    this->rawdir.clear();
+    if(stream.status() == QDataStream::Ok && t_nchan > 0) {
+        stream >> this->first_samp >> this->last_samp >> nbuf;
+        if(stream.status() != QDataStream::Ok || nbuf < 0 || nbuf > file.size()/16) {
+            return true;
+        }
+
+        QList<FiffRawDir> t_rawdir;
+        t_rawdir.reserve(nbuf);
+        for(qint32 k = 0; k < nbuf; ++k) {
+            qint32 iEnt;
+            FiffRawDir t_RawDir;
+            stream >> iEnt >> t_RawDir.first >> t_RawDir.last >> t_RawDir.nsamp;
+            if(iEnt >= nent) {
+                return true;
+            }
+            if(iEnt >= 0) {
+                t_RawDir.ent = FiffDirEntry::SPtr(new FiffDirEntry(*this->dir[iEnt]));
+            }
+            t_rawdir.append(t_RawDir);
+        }
+
+        if(stream.status() == QDataStream::Ok) {
+            this->nchan = t_nchan;
+            this->rawdir = t_rawdir;
+        }
+    }
+
+    return true;
+}
+
+//=============================================================================================================
+
+bool FiffIndex::write(const QString& sFileName) const
+{
+    // The nodes refer to the directory by their indices into its entry array
+    if(!this->dirtree || !this->dirtree->dir_tree.sharesStorage(this->dir)) {
+        return false;
+    }
+
+    QString sIndexFileName = indexFileName(sFileName);
+    if(!m_sCacheDir.isEmpty()) {
+        QDir().mkpath(m_sCacheDir);
+    }
+
+    // Readers never see a partially written index
+    QSaveFile file(sIndexFileName);
+    if(!file.open(QIODevice::WriteOnly)) {
+        qWarning("FiffIndex::write - Cannot write index %s", sIndexFileName.toUtf8().constData());
+        return false;
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_5_0);
+
+    QFileInfo fileInfo(sFileName);
+    stream << FIFF_INDEX_MAGIC << FIFF_INDEX_VERSION;
+    stream << static_cast<qint64>(fileInfo.size()) << static_cast<qint64>(fileInfo.lastModified().toMSecsSinceEpoch());
+    writeId(stream, this->id);
+
+    QHash<fiff_int_t, qint32> bufferIndex;
+    stream << static_cast<qint32>(this->dir.size());
+    for(qint32 k = 0; k < this->dir.size(); ++k) {
+        const FiffDirEntry* pEnt = this->dir[k];
+        stream << pEnt->kind << pEnt->type << pEnt->size << pEnt->pos;
+        if(pEnt->kind == FIFF_DATA_BUFFER) {
+            bufferIndex.insert(pEnt->pos, k);
+        }
+    }
+
+    writeNode(stream, this->dirtree);
+
+    stream << this->nchan;
+    if(this->nchan > 0) {
+        stream << this->first_samp << this->last_samp << static_cast<qint32>(this->rawdir.size());
+        for(const FiffRawDir& t_RawDir : this->rawdir) {
+            stream << (t_RawDir.ent ? bufferIndex.value(t_RawDir.ent->pos, -1) : -1);
+            stream << t_RawDir.first << t_RawDir.last << t_RawDir.nsamp;
+        }
+    }
+
+    if(stream.status() != QDataStream::Ok || !file.commit()) {
+        qWarning("FiffIndex::write - Cannot write index %s", sIndexFileName.toUtf8().constData());
+        return false;
+    }
+
+    return true;
+}
+
+//=============================================================================================================
+
+void FiffIndex::setRawDir(fiff_int_t p_nchan,
+                          fiff_int_t p_first_samp,
+                          fiff_int_t p_last_samp,
+                          const QList<FiffRawDir>& p_rawdir)
+{
+    this->nchan = p_nchan;
+    this->first_samp = p_first_samp;
+    this->last_samp = p_last_samp;
+    this->rawdir = p_rawdir;
+}
+
+//=============================================================================================================
+
+bool FiffIndex::hasRawDir(fiff_int_t p_nchan) const
+{
+    return this->nchan > 0 && this->nchan == p_nchan;
+}
+
+//=============================================================================================================
+
+void FiffIndex::writeNode(QDataStream& stream,
+                          const FiffDirNode::SPtr& p_pNode) const
+{
+    stream << p_pNode->type;
+    writeId(stream, p_pNode->id);
+    writeId(stream, p_pNode->parent_id);
+
+    qint32 first = p_pNode->dir_tree.isEmpty() ? -1 : p_pNode->dir_tree.storageIndex(0);
+    stream << first << p_pNode->nent_tree;
+
+    stream << static_cast<qint32>(p_pNode->dir.size());
+    for(qint32 k = 0; k < p_pNode->dir.size(); ++k) {
+        stream << static_cast<qint32>(p_pNode->dir.storageIndex(k));
+    }
+
+    stream << static_cast<qint32>(p_pNode->children.size());
+    for(const FiffDirNode::SPtr& pChild : p_pNode->children) {
+        writeNode(stream, pChild);
+    }
+}
+
+//=============================================================================================================
+
+FiffDirNode::SPtr FiffIndex::readNode(QDataStream& stream,
+                                      int iDepth)
+{
+    FiffDirNode::SPtr defaultNode;
+    if(iDepth > FIFF_INDEX_MAX_DEPTH) {
+        return defaultNode;
+    }
+
+    FiffDirNode::SPtr node(new FiffDirNode);
+    qint32 first, ndir, nchild;
+
+    stream >> node->type;
+    node->id = readId(stream);
+    node->parent_id = readId(stream);
+    stream >> first >> node->nent_tree >> ndir;
+    if(stream.status() != QDataStream::Ok || first < -1 || first >= this->dir.size() || ndir < 0 || ndir > this->dir.size()) {
+        return defaultNode;
+    }
+    if(first >= 0) {
+        node->dir_tree = this->dir.mid(first, node->nent_tree);
+    }
+
+    QVector<qint32> vecDir(ndir);
+    for(qint32 k = 0; k < ndir; ++k) {
+        stream >> vecDir[k];
+        if(vecDir[k] < 0 || vecDir[k] >= this->dir.size()) {
+            return defaultNode;
+        }
+    }
+    node->dir = this->dir.select(vecDir);
+
+    stream >> nchild;
+    if(stream.status() != QDataStream::Ok || nchild < 0 || nchild > this->dir.size()) {
+        return defaultNode;
+    }
+    for(qint32 k = 0; k < nchild; ++k) {
+        FiffDirNode::SPtr child = readNode(stream, iDepth + 1);
+        if(!child) {
+            return defaultNode;
+        }
+        child->parent = node;
+        node->children.append(child);
+    }
+
+    return node;
+}
+
+//=============================================================================================================
+
+void FiffIndex::writeId(QDataStream& stream,
+                        const FiffId& p_id)
+{
+    stream << p_id.version << p_id.machid[0] << p_id.machid[1] << p_id.time.secs << p_id.time.usecs;
+}
+
+//=============================================================================================================
+
+FiffId FiffIndex::readId(QDataStream& stream)
+{
+    FiffId t_id;
+    stream >> t_id.version >> t_id.machid[0] >> t_id.machid[1] >> t_id.time.secs >> t_id.time.usecs;
+    return t_id;
+}
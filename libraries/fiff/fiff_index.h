@@ -0,0 +1,220 @@
+//=============================================================================================================
+/**
+ * @file     fiff_index.h
+ * @author   agent <agent@local>
+ * @since    0.1.9
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, agent. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    FiffIndex class declaration.
+ *
+ */
+
+#ifndef FIFF_INDEX_H
+#define FIFF_INDEX_H
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include "fiff_global.h"
+#include "fiff_types.h"
+#include "fiff_id.h"
+#include "fiff_dir_entry.h"
+#include "fiff_dir_entry_list.h"
+#include "fiff_dir_node.h"
+#include "fiff_raw_dir.h"
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QDataStream>
+#include <QList>
+#include <QSharedPointer>
+#include <QString>
+
+//=============================================================================================================
+// DEFINE NAMESPACE FIFFLIB
+//=============================================================================================================
+
+namespace FIFFLIB
+{
+
+//=============================================================================================================
+/**
+ * A sidecar index of a fif file. It holds the tag directory, the directory tree and, once the file was set up
+ * for raw reading, the raw data buffer map. The index is stamped with the size, modification time and file id of
+ * the fif file and is only used while all three still match, so reopening a recording does not need to scan it.
+ *
+ * Indices are written next to the fif file (<file>.mneidx) or into the cache directory, if one is set. Writing
+ * is off by default, see setEnabled. Existing indices are picked up by FiffStream::open automatically.
+ *
+ * @brief Sidecar index of a fif file.
+ */
+class FIFFSHARED_EXPORT FiffIndex
+{
+
+public:
+    typedef QSharedPointer<FiffIndex> SPtr;            /**< Shared pointer type for FiffIndex. */
+    typedef QSharedPointer<const FiffIndex> ConstSPtr; /**< Const shared pointer type for FiffIndex. */
+
+    //=========================================================================================================
+    /**
+     * Default constructor
+     */
+    FiffIndex();
+
+    //=========================================================================================================
+    /**
+     * Creates the index of an opened fif file.
+     *
+     * @param[in] p_id       The file id.
+     * @param[in] p_dir      The tag directory.
+     * @param[in] p_dirtree  The directory tree, built from p_dir. The directories of its nodes are views of p_dir.
+     */
+    FiffIndex(const FiffId& p_id,
+              const FiffDirEntryList& p_dir,
+              const FiffDirNode::SPtr& p_dirtree);
+
+    //=========================================================================================================
+    /**
+     * Switches the writing of sidecar indices on or off. Off by default.
+     *
+     * @param[in] bEnabled   Whether FiffStream writes indices when opening files and setting up raw reading.
+     */
+    static void setEnabled(bool bEnabled);
+
+    //=========================================================================================================
+    /**
+     * Returns whether FiffStream writes sidecar indices.
+     *
+     * @return true if indices are written, false otherwise.
+     */
+    static bool isEnabled();
+
+    //=========================================================================================================
+    /**
+     * Sets the directory the indices are kept in. An empty string (default) keeps them next to the fif files.
+     *
+     * @param[in] sCacheDir  The cache directory.
+     */
+    static void setCacheDir(const QString& sCacheDir);
+
+    //=========================================================================================================
+    /**
+     * Returns the directory the indices are kept in, empty if they are kept next to the fif files.
+     *
+     * @return The cache directory.
+     */
+    static QString cacheDir();
+
+    //=========================================================================================================
+    /**
+     * Returns the name of the index file which belongs to a fif file.
+     *
+     * @param[in] sFileName  The fif file.
+     *
+     * @return The index file name.
+     */
+    static QString indexFileName(const QString& sFileName);
+
+    //=========================================================================================================
+    /**
+     * Reads the index of a fif file. Fails if there is no index or if it does not match the file anymore.
+     *
+     * @param[in] sFileName  The fif file.
+     * @param[in] p_id       The file id, as read from the beginning of the fif file.
+     *
+     * @return true if a valid index was read, false otherwise.
+     */
+    bool read(const QString& sFileName,
+              const FiffId& p_id);
+
+    //=========================================================================================================
+    /**
+     * Writes the index of a fif file and stamps it with the current size and modification time of the file.
+     *
+     * @param[in] sFileName  The fif file.
+     *
+     * @return true if succeeded, false otherwise.
+     */
+    bool write(const QString& sFileName) const;
+
+    //=========================================================================================================
+    /**
+     * Stores the raw data buffer map. The directory entries of rawdir have to be in the indexed directory, they
+     * are matched by their position in the file.
+     *
+     * @param[in] p_nchan        The number of channels the map was set up for.
+     * @param[in] p_first_samp   The first sample.
+     * @param[in] p_last_samp    The last sample.
+     * @param[in] p_rawdir       The raw data buffers.
+     */
+    void setRawDir(fiff_int_t p_nchan,
+                   fiff_int_t p_first_samp,
+                   fiff_int_t p_last_samp,
+                   const QList<FiffRawDir>& p_rawdir);
+
+    //=========================================================================================================
+    /**
+     * Returns whether the index holds a raw data buffer map for the given number of channels.
+     *
+     * @param[in] p_nchan    The number of channels.
+     *
+     * @return true if a matching raw data buffer map is present, false otherwise.
+     */
+    bool hasRawDir(fiff_int_t p_nchan) const;
+
+private:
+    //=========================================================================================================
+    /**
+     * Writes and reads one node of the directory tree and its children.
+     */
+    void writeNode(QDataStream& stream, const FiffDirNode::SPtr& p_pNode) const;
+    FiffDirNode::SPtr readNode(QDataStream& stream, int iDepth);
+
+    //=========================================================================================================
+    /**
+     * Writes and reads a file id.
+     */
+    static void writeId(QDataStream& stream, const FiffId& p_id);
+    static FiffId readId(QDataStream& stream);
+
+    static bool     m_bEnabled;     /**< Whether indices are written. */
+    static QString  m_sCacheDir;    /**< The directory the indices are kept in, empty to keep them next to the fif files. */
+
+public:
+    FiffId                      id;             /**< The file id. */
+    FiffDirEntryList            dir;            /**< The tag directory. */
+    FiffDirNode::SPtr           dirtree;        /**< The directory tree. */
+    fiff_int_t                  nchan;          /**< Number of channels of the raw data buffer map, -1 if there is none. */
+    fiff_int_t                  first_samp;     /**< First sample of the raw data. */
+    fiff_int_t                  last_samp;      /**< Last sample of the raw data. */
+    QList<FiffRawDir>           rawdir;         /**< The raw data buffers. */
+};
+} // NAMESPACE
+
+#endif // FIFF_INDEX_H
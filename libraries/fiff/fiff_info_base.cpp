@@ -70,6 +70,7 @@ FiffInfoBase::FiffInfoBase(const FiffInfoBase& p_FiffInfoBase)
 , ch_names(p_FiffInfoBase.ch_names)
 , dev_head_t(p_FiffInfoBase.dev_head_t)
 , ctf_head_t(p_FiffInfoBase.ctf_head_t)
+, m_chNameIndex(p_FiffInfoBase.m_chNameIndex)
 {
 }
 
@@ -199,19 +200,21 @@ RowVectorXi FiffInfoBase::pick_channels(const QStringList& ch_names, const QStri
 {
     RowVectorXi sel = RowVectorXi::Zero(ch_names.size());
 
-    QStringList t_includedSelection;
+    QHash<QString,qint32> t_hashInclude = FiffChNameIndex::build(include);
+    QHash<QString,qint32> t_hashExclude = FiffChNameIndex::build(exclude);
+    QHash<QString,qint32> t_includedSelection;
 
     qint32 count = 0;
     for(qint32 k = 0; k < ch_names.size(); ++k)
     {
-        if( (include.size() == 0 || include.contains(ch_names[k])) && !exclude.contains(ch_names[k]))
+        if( (include.size() == 0 || t_hashInclude.contains(ch_names[k])) && !t_hashExclude.contains(ch_names[k]))
         {
             //make sure channel is unique
             if(!t_includedSelection.contains(ch_names[k]))
             {
                 sel[count] = k;
                 ++count;
-                t_includedSelection << ch_names[k];
+                t_includedSelection.insert(ch_names[k], k);
             }
         }
     }
@@ -244,6 +247,20 @@ FiffInfoBase FiffInfoBase::pick_info(const RowVectorXi* sel) const
 }
 //=============================================================================================================
 
+qint32 FiffInfoBase::ch_index(const QString& ch_name) const
+{
+    return m_chNameIndex.indexOf(ch_names, ch_name);
+}
+
+//=============================================================================================================
+
+QBitArray FiffInfoBase::bad_mask() const
+{
+    return m_chNameIndex.badMask(ch_names, bads);
+}
+
+//=============================================================================================================
+
 QStringList FiffInfoBase::get_channel_types()
 {
     QStringList lChannelTypes;
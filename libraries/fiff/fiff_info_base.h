@@ -49,6 +49,7 @@
 #include "fiff_ctf_comp.h"
 #include "fiff_coord_trans.h"
 #include "fiff_proj.h"
+#include "fiff_ch_name_index.h"
 
 //=============================================================================================================
 // QT INCLUDES
@@ -215,6 +216,25 @@ public:
      */
     QStringList get_channel_types();
 
+    //=========================================================================================================
+    /**
+     * Returns the index of a channel in ch_names. The lookup uses a hash which is built on first use and
+     * rebuilt after ch_names changed.
+     *
+     * @param[in] ch_name    The channel name to look up.
+     *
+     * @return The channel index, -1 if the channel is not present.
+     */
+    qint32 ch_index(const QString& ch_name) const;
+
+    //=========================================================================================================
+    /**
+     * Returns a bit mask over ch_names in which the bits of the channels listed in bads are set.
+     *
+     * @return The bad channel mask.
+     */
+    QBitArray bad_mask() const;
+
 public:
     QString filename;           /**< Filename when the info is read of a fiff file. */
     QStringList bads;           /**< List of bad channels. */
@@ -224,6 +244,9 @@ public:
     QStringList ch_names;       /**< List of all channel names. */
     FiffCoordTrans dev_head_t;  /**< Coordinate transformation ToDo... */
     FiffCoordTrans ctf_head_t;  /**< Coordinate transformation ToDo... */
+
+private:
+    FiffChNameIndex m_chNameIndex;  /**< Lazily built index of ch_names and bads. */
 };
 
 //=============================================================================================================
@@ -77,6 +77,8 @@ FiffNamedMatrix::FiffNamedMatrix(const FiffNamedMatrix& p_FiffNamedMatrix)
 , row_names(p_FiffNamedMatrix.row_names)
 , col_names(p_FiffNamedMatrix.col_names)
 , data(p_FiffNamedMatrix.data)
+, m_rowIndex(p_FiffNamedMatrix.m_rowIndex)
+, m_colIndex(p_FiffNamedMatrix.m_colIndex)
 {
 }
 
@@ -110,3 +112,17 @@ void FiffNamedMatrix::transpose_named_matrix()
     this->nrow = this->data.rows();
     this->ncol = this->data.cols();
 }
+
+//=============================================================================================================
+
+qint32 FiffNamedMatrix::row_index(const QString& name) const
+{
+    return m_rowIndex.indexOf(row_names, name);
+}
+
+//=============================================================================================================
+
+qint32 FiffNamedMatrix::col_index(const QString& name) const
+{
+    return m_colIndex.indexOf(col_names, name);
+}
@@ -44,6 +44,7 @@
 #include "fiff_global.h"
 #include "fiff_constants.h"
 #include "fiff_types.h"
+#include "fiff_ch_name_index.h"
 
 //=============================================================================================================
 // EIGEN INCLUDES
@@ -167,6 +168,28 @@ public:
      */
     friend bool operator== (const FiffNamedMatrix &a, const FiffNamedMatrix &b);
 
+    //=========================================================================================================
+    /**
+     * Returns the index of a row name. The lookup uses a hash which is built on first use and rebuilt after
+     * row_names changed.
+     *
+     * @param[in] name   The row name to look up.
+     *
+     * @return the row index, -1 if the name is not present.
+     */
+    qint32 row_index(const QString& name) const;
+
+    //=========================================================================================================
+    /**
+     * Returns the index of a column name. The lookup uses a hash which is built on first use and rebuilt after
+     * col_names changed.
+     *
+     * @param[in] name   The column name to look up.
+     *
+     * @return the column index, -1 if the name is not present.
+     */
+    qint32 col_index(const QString& name) const;
+
 public:
     fiff_int_t nrow;        /**< Number of rows. */
     fiff_int_t  ncol;       /**< Number of columns. */
@@ -182,6 +205,10 @@ public:
 //    char  **collist;        /* Name list for the columns (may be NULL) */
 //    float **data;           /* The data itself (dense) */
 //} *mneNamedMatrix,mneNamedMatrixRec;
+
+private:
+    FiffChNameIndex m_rowIndex;     /**< Lazily built index of row_names. */
+    FiffChNameIndex m_colIndex;     /**< Lazily built index of col_names. */
 };
 
 //=============================================================================================================
@@ -39,9 +39,18 @@
 //=============================================================================================================
 
 #include "fiff_proj.h"
+#include "fiff_ch_name_index.h"
 #include <stdio.h>
 #include <utils/mnemath.h>
 
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QCache>
+#include <QCryptographicHash>
+#include <QMutex>
+#include <QMutexLocker>
 
 //=============================================================================================================
 // EIGEN INCLUDES
@@ -57,6 +66,59 @@ using namespace UTILSLIB;
 using namespace FIFFLIB;
 using namespace Eigen;
 
+//=============================================================================================================
+// DEFINE GLOBAL METHODS
+//=============================================================================================================
+
+namespace {
+
+struct ProjectorCacheEntry
+{
+    fiff_int_t nproj;   /**< Number of items in the projector. */
+    MatrixXd proj;      /**< The projection operator. */
+    MatrixXd U;         /**< The orthogonal basis of the projection vectors. */
+};
+
+QMutex s_projectorCacheMutex;
+QCache<QByteArray, ProjectorCacheEntry> s_projectorCache(64 * 1024);   // Cost in kB of operator storage
+
+void addNamesToHash(QCryptographicHash& hash, const QStringList& names)
+{
+    qint32 size = names.size();
+    hash.addData(reinterpret_cast<const char*>(&size), sizeof(size));
+    for(qint32 k = 0; k < names.size(); ++k) {
+        hash.addData(names[k].toUtf8());
+        hash.addData("", 1);
+    }
+}
+
+//=============================================================================================================
+
+QByteArray projectorKey(const QList<FiffProj>& projs, const QStringList& ch_names, const QStringList& bads)
+{
+    // Only what make_projector reads: the active items, the channel names and the bads
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+
+    for(qint32 k = 0; k < projs.size(); ++k) {
+        if(!projs[k].active) {
+            continue;
+        }
+        const FiffNamedMatrix& data = *projs[k].data;
+        qint32 dims[2] = {static_cast<qint32>(data.data.rows()), static_cast<qint32>(data.data.cols())};
+        hash.addData(reinterpret_cast<const char*>(dims), sizeof(dims));
+        hash.addData(reinterpret_cast<const char*>(&data.nrow), sizeof(data.nrow));
+        addNamesToHash(hash, data.col_names);
+        hash.addData(reinterpret_cast<const char*>(data.data.data()), static_cast<int>(data.data.size() * sizeof(double)));
+    }
+
+    addNamesToHash(hash, ch_names);
+    addNamesToHash(hash, bads);
+
+    return hash.result();
+}
+
+} // namespace
+
 //=============================================================================================================
 // DEFINE MEMBER METHODS
 //=============================================================================================================
@@ -113,6 +175,22 @@ void FiffProj::activate_projs(QList<FiffProj> &p_qListFiffProj)
 
 //=============================================================================================================
 
+void FiffProj::clear_projector_cache()
+{
+    QMutexLocker locker(&s_projectorCacheMutex);
+    s_projectorCache.clear();
+}
+
+//=============================================================================================================
+
+int FiffProj::projector_cache_size()
+{
+    QMutexLocker locker(&s_projectorCacheMutex);
+    return s_projectorCache.count();
+}
+
+//=============================================================================================================
+
 fiff_int_t FiffProj::make_projector(const QList<FiffProj>& projs, const QStringList& ch_names, MatrixXd& proj, const QStringList& bads, MatrixXd& U)
 {
     fiff_int_t nchan = ch_names.size();
@@ -122,17 +200,16 @@ fiff_int_t FiffProj::make_projector(const QList<FiffProj>& projs, const QStringL
         return 0;
     }
 
-//    if(proj)
-//        delete proj;
-    proj = MatrixXd::Identity(nchan,nchan);
     fiff_int_t nproj = 0;
     U = MatrixXd();
 
     //
     //   Check trivial cases first
     //
-    if (projs.size() == 0)
+    if (projs.size() == 0) {
+        proj = MatrixXd::Identity(nchan,nchan);
         return 0;
+    }
 
     fiff_int_t nvec    = 0;
     fiff_int_t k, l;
@@ -147,23 +224,38 @@ fiff_int_t FiffProj::make_projector(const QList<FiffProj>& projs, const QStringL
 
     if (nproj == 0) {
         printf("FiffProj::make_projector - No projectors nproj=0\n");
+        proj = MatrixXd::Identity(nchan,nchan);
         return 0;
     }
 
     if (nvec <= 0) {
         printf("FiffProj::make_projector - No rows in projector matrices found nvec<=0\n");
+        proj = MatrixXd::Identity(nchan,nchan);
         return 0;
     }
 
+    //
+    //   Reuse the operator if it was built for the same input before
+    //
+    QByteArray key = projectorKey(projs, ch_names, bads);
+    {
+        QMutexLocker locker(&s_projectorCacheMutex);
+        if (const ProjectorCacheEntry* entry = s_projectorCache.object(key)) {
+            proj = entry->proj;
+            U = entry->U;
+            return entry->nproj;
+        }
+    }
+
     //
     //   Pick the appropriate entries
     //
     MatrixXd vecs = MatrixXd::Zero(nchan,nvec);
     nvec = 0;
     fiff_int_t nonzero = 0;
-    qint32 p, c, i, j, v;
+    qint32 p, c, i, v;
     double onesize;
-    bool isBad = false;
+    QHash<QString,qint32> t_hashBads = FiffChNameIndex::build(bads);
     RowVectorXi sel(nchan);
     RowVectorXi vecSel(nchan);
     sel.setConstant(-1);
@@ -172,16 +264,16 @@ fiff_int_t FiffProj::make_projector(const QList<FiffProj>& projs, const QStringL
     {
         if (projs[k].active)
         {
-            FiffProj one = projs[k];
+            const FiffProj& one = projs[k];
 
-            QMap<QString, int> uniqueMap;
             for(l = 0; l < one.data->col_names.size(); ++l)
-                uniqueMap[one.data->col_names[l] ] = 0;
-
-            if (one.data->col_names.size() != uniqueMap.keys().size())
             {
-                printf("Channel name list in projection item %d contains duplicate items",k);
-                return 0;
+                if (one.data->col_index(one.data->col_names[l]) != l)
+                {
+                    printf("Channel name list in projection item %d contains duplicate items",k);
+                    proj = MatrixXd::Identity(nchan,nchan);
+                    return 0;
+                }
             }
 
             //
@@ -195,27 +287,12 @@ fiff_int_t FiffProj::make_projector(const QList<FiffProj>& projs, const QStringL
             p = 0;
             for (c = 0; c < nchan; ++c)
             {
-                for (i = 0; i < one.data->col_names.size(); ++i)
+                i = one.data->col_index(ch_names.at(c));
+                if (i > -1 && !t_hashBads.contains(ch_names.at(c)))
                 {
-                    if (QString::compare(ch_names.at(c),one.data->col_names[i]) == 0)
-                    {
-                        isBad = false;
-                        for (j = 0; j < bads.size(); ++j)
-                        {
-                            if (QString::compare(ch_names.at(c),bads.at(j)) == 0)
-                            {
-                                isBad = true;
-                            }
-                        }
-
-                        if (!isBad && sel[p] != c)
-                        {
-                            sel[p] = c;
-                            vecSel[p] = i;
-                            ++p;
-                        }
-
-                    }
+                    sel[p] = c;
+                    vecSel[p] = i;
+                    ++p;
                 }
             }
             sel.conservativeResize(p);
@@ -246,13 +323,15 @@ fiff_int_t FiffProj::make_projector(const QList<FiffProj>& projs, const QStringL
     //
     //   Check whether all of the vectors are exactly zero
     //
-    if (nonzero == 0)
+    if (nonzero == 0) {
+        proj = MatrixXd::Identity(nchan,nchan);
         return 0;
+    }
 
     //
-    //   Reorthogonalize the vectors
+    //   Reorthogonalize the vectors, only the first nvec columns of U are needed
     //
-    JacobiSVD<MatrixXd> svd(vecs.block(0,0,vecs.rows(),nvec), ComputeFullU);
+    JacobiSVD<MatrixXd> svd(vecs.leftCols(nvec), ComputeThinU);
     //Sort singular values and singular vectors
     VectorXd S = svd.singularValues();
     MatrixXd t_U = svd.matrixU();
@@ -266,12 +345,22 @@ fiff_int_t FiffProj::make_projector(const QList<FiffProj>& projs, const QStringL
         if (S[k]/S[0] > 1e-2)
             ++nproj;
 
-    U = t_U.block(0, 0, t_U.rows(), nproj);
+    U = t_U.leftCols(nproj);
 
     //
     //   Here is the celebrated result
     //
-    proj -= U*U.transpose();
+    proj.noalias() = -U*U.transpose();
+    proj.diagonal().array() += 1.0;
+
+    ProjectorCacheEntry* entry = new ProjectorCacheEntry;
+    entry->nproj = nproj;
+    entry->proj = proj;
+    entry->U = U;
+    {
+        QMutexLocker locker(&s_projectorCacheMutex);
+        s_projectorCache.insert(key, entry, static_cast<int>((entry->proj.size() + entry->U.size()) * sizeof(double) / 1024) + 1);
+    }
 
     return nproj;
 }
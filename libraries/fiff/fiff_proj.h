@@ -139,6 +139,21 @@ public:
                                      const QStringList& bads = defaultQStringList,
                                      Eigen::MatrixXd& U = defaultMatrixXd);
 
+    //=========================================================================================================
+    /**
+     * make_projector keeps the operators it built, keyed by the content of the active projectors, the channel
+     * names and the bad channels. Clears these cached operators.
+     */
+    static void clear_projector_cache();
+
+    //=========================================================================================================
+    /**
+     * Returns the number of operators currently cached by make_projector.
+     *
+     * @return the number of cached operators.
+     */
+    static int projector_cache_size();
+
     //=========================================================================================================
     /**
      * overloading the stream out operator<<
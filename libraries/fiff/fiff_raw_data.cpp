@@ -41,8 +41,13 @@
 #include "fiff_raw_data.h"
 #include "fiff_tag.h"
 #include "fiff_stream.h"
+#include <utils/mnetracer.h>
 #include "cstdlib"
 
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
 //=============================================================================================================
 // USED NAMESPACES
 //=============================================================================================================
@@ -133,6 +138,7 @@ bool FiffRawData::read_raw_segment(MatrixXd& data,
                                    const RowVectorXi& sel,
                                    bool do_debug) const
 {
+    MNE_TRACE();
     bool projAvailable = true;
 
     if (this->proj.size() == 0) {
@@ -293,7 +299,12 @@ bool FiffRawData::read_raw_segment(MatrixXd& data,
             }
             else
             {
-                fid->read_tag(t_pTag, thisRawDir.ent->pos);
+                fid->read_tag(t_pTag, thisRawDir.ent->pos, false);
+                //
+                //   Decode the buffer, the byte order is converted on the way
+                //
+                if (!t_pTag->toBufferMatrix(nchan, thisRawDir.nsamp, tmp_data))
+                    printf("Data Storage Format not known yet!! Type: %d\n", t_pTag->type);
                 //
                 //   Depending on the state of the projection and selection
                 //   we proceed a little bit differently
@@ -302,68 +313,20 @@ bool FiffRawData::read_raw_segment(MatrixXd& data,
                 {
                     if (sel.cols() == 0)
                     {
-                        if (t_pTag->type == FIFFT_DAU_PACK16)
-                            one = cal*(Map< MatrixDau16 >( t_pTag->toDauPack16(),nchan, thisRawDir.nsamp)).cast<double>();
-                        else if(t_pTag->type == FIFFT_INT)
-                            one = cal*(Map< MatrixXi >( t_pTag->toInt(),nchan, thisRawDir.nsamp)).cast<double>();
-                        else if(t_pTag->type == FIFFT_FLOAT)
-                            one = cal*(Map< MatrixXf >( t_pTag->toFloat(),nchan, thisRawDir.nsamp)).cast<double>();
-                        else if(t_pTag->type == FIFFT_SHORT)
-                            one = cal*(Map< MatrixShort >( t_pTag->toShort(),nchan, thisRawDir.nsamp)).cast<double>();
-                        else
-                            printf("Data Storage Format not known yet [1]!! Type: %d\n", t_pTag->type);
+                        one = cal*tmp_data;
                     }
                     else
                     {
-                        //ToDo find a faster solution for this!! --> make cal and mul sparse like in MATLAB
-                        newData.resize(sel.cols(), thisRawDir.nsamp); //ToDo this can be done much faster, without newData
-
-                        if (t_pTag->type == FIFFT_DAU_PACK16)
-                        {
-                            tmp_data = (Map< MatrixDau16 > ( t_pTag->toDauPack16(),nchan, thisRawDir.nsamp)).cast<double>();
-
-                            for(r = 0; r < sel.size(); ++r)
-                                newData.block(r,0,1,thisRawDir.nsamp) = tmp_data.block(sel[r],0,1,thisRawDir.nsamp);
-                        }
-                        else if(t_pTag->type == FIFFT_INT)
-                        {
-                            tmp_data = (Map< MatrixXi >( t_pTag->toInt(),nchan, thisRawDir.nsamp)).cast<double>();
-
-                            for(r = 0; r < sel.size(); ++r)
-                                newData.block(r,0,1,thisRawDir.nsamp) = tmp_data.block(sel[r],0,1,thisRawDir.nsamp);
-                        }
-                        else if(t_pTag->type == FIFFT_FLOAT)
-                        {
-                            tmp_data = (Map< MatrixXf > ( t_pTag->toFloat(),nchan, thisRawDir.nsamp)).cast<double>();
-
-                            for(r = 0; r < sel.size(); ++r)
-                                newData.block(r,0,1,thisRawDir.nsamp) = tmp_data.block(sel[r],0,1,thisRawDir.nsamp);
-                        }
-                        else if(t_pTag->type == FIFFT_SHORT)
-                        {
-                            tmp_data = (Map< MatrixShort > ( t_pTag->toShort(),nchan, thisRawDir.nsamp)).cast<double>();
-
-                            for(r = 0; r < sel.size(); ++r)
-                                newData.block(r,0,1,thisRawDir.nsamp) = tmp_data.block(sel[r],0,1,thisRawDir.nsamp);
-                        }
-                        else
-                        {
-                            printf("Data Storage Format not known yet [2]!! Type: %d\n", t_pTag->type);
-                        }
+                        newData.resize(sel.cols(), thisRawDir.nsamp);
+                        for(r = 0; r < sel.size(); ++r)
+                            newData.row(r) = tmp_data.row(sel[r]);
 
                         one = cal*newData;
                     }
                 }
                 else
                 {
-                    if (t_pTag->type == FIFFT_DAU_PACK16)
-                        one = mult*(Map< MatrixDau16 >( t_pTag->toDauPack16(),nchan, thisRawDir.nsamp)).cast<double>();
-                    else if(t_pTag->type == FIFFT_INT)
-                        one = mult*(Map< MatrixXi >( t_pTag->toInt(),nchan, thisRawDir.nsamp)).cast<double>();
-                    else if(t_pTag->type == FIFFT_FLOAT)
-                        one = mult*(Map< MatrixXf >( t_pTag->toFloat(),nchan, thisRawDir.nsamp)).cast<double>();
-                    else
-                        printf("Data Storage Format not known yet [3]!! Type: %d\n", t_pTag->type);
+                    one = mult*tmp_data;
                 }
             }
             //
@@ -466,6 +429,7 @@ bool FiffRawData::read_raw_segment(MatrixXd& data,
                                    const RowVectorXi& sel,
                                    bool do_debug) const
 {
+    MNE_TRACE();
     bool projAvailable = true;
 
     if (this->proj.size() == 0) {
@@ -600,7 +564,7 @@ bool FiffRawData::read_raw_segment(MatrixXd& data,
         fid = this->file;
     }
 
-    MatrixXd one;
+    MatrixXd one, newData, tmp_data;
     fiff_int_t first_pick, last_pick, picksamp;
     for(k = 0; k < this->rawdir.size(); ++k)
     {
@@ -627,7 +591,12 @@ bool FiffRawData::read_raw_segment(MatrixXd& data,
             else
             {
                 FiffTag::SPtr t_pTag;
-                fid->read_tag(t_pTag, thisRawDir.ent->pos);
+                fid->read_tag(t_pTag, thisRawDir.ent->pos, false);
+                //
+                //   Decode the buffer, the byte order is converted on the way
+                //
+                if (!t_pTag->toBufferMatrix(nchan, thisRawDir.nsamp, tmp_data))
+                    printf("Data Storage Format not known yet!! Type: %d\n", t_pTag->type);
                 //
                 //   Depending on the state of the projection and selection
                 //   we proceed a little bit differently
@@ -636,69 +605,20 @@ bool FiffRawData::read_raw_segment(MatrixXd& data,
                 {
                     if (sel.cols() == 0)
                     {
-                        if (t_pTag->type == FIFFT_DAU_PACK16)
-                            one = cal*(Map< MatrixDau16 >( t_pTag->toDauPack16(),nchan, thisRawDir.nsamp)).cast<double>();
-                        else if(t_pTag->type == FIFFT_INT)
-                            one = cal*(Map< MatrixXi >( t_pTag->toInt(),nchan, thisRawDir.nsamp)).cast<double>();
-                        else if(t_pTag->type == FIFFT_FLOAT)
-                            one = cal*(Map< MatrixXf >( t_pTag->toFloat(),nchan, thisRawDir.nsamp)).cast<double>();
-                        else if(t_pTag->type == FIFFT_SHORT)
-                            one = cal*(Map< MatrixShort >( t_pTag->toShort(),nchan, thisRawDir.nsamp)).cast<double>();
-                        else
-                            printf("Data Storage Format not known yet [1]!! Type: %d\n", t_pTag->type);
+                        one = cal*tmp_data;
                     }
                     else
                     {
-
-                        //ToDo find a faster solution for this!! --> make cal and mul sparse like in MATLAB
-                        MatrixXd newData(sel.cols(), thisRawDir.nsamp); //ToDo this can be done much faster, without newData
-
-                        if (t_pTag->type == FIFFT_DAU_PACK16)
-                        {
-                            MatrixXd tmp_data = (Map< MatrixDau16 > ( t_pTag->toDauPack16(),nchan, thisRawDir.nsamp)).cast<double>();
-
-                            for(r = 0; r < sel.size(); ++r)
-                                newData.block(r,0,1,thisRawDir.nsamp) = tmp_data.block(sel[r],0,1,thisRawDir.nsamp);
-                        }
-                        else if(t_pTag->type == FIFFT_INT)
-                        {
-                            MatrixXd tmp_data = (Map< MatrixXi >( t_pTag->toInt(),nchan, thisRawDir.nsamp)).cast<double>();
-
-                            for(r = 0; r < sel.size(); ++r)
-                                newData.block(r,0,1,thisRawDir.nsamp) = tmp_data.block(sel[r],0,1,thisRawDir.nsamp);
-                        }
-                        else if(t_pTag->type == FIFFT_FLOAT)
-                        {
-                            MatrixXd tmp_data = (Map< MatrixXf > ( t_pTag->toFloat(),nchan, thisRawDir.nsamp)).cast<double>();
-
-                            for(r = 0; r < sel.size(); ++r)
-                                newData.block(r,0,1,thisRawDir.nsamp) = tmp_data.block(sel[r],0,1,thisRawDir.nsamp);
-                        }
-                        else if(t_pTag->type == FIFFT_SHORT)
-                        {
-                            MatrixXd tmp_data = (Map< MatrixShort > ( t_pTag->toShort(),nchan, thisRawDir.nsamp)).cast<double>();
-
-                            for(r = 0; r < sel.size(); ++r)
-                                newData.block(r,0,1,thisRawDir.nsamp) = tmp_data.block(sel[r],0,1,thisRawDir.nsamp);
-                        }
-                        else
-                        {
-                            printf("Data Storage Format not known yet [2]!! Type: %d\n", t_pTag->type);
-                        }
+                        newData.resize(sel.cols(), thisRawDir.nsamp);
+                        for(r = 0; r < sel.size(); ++r)
+                            newData.row(r) = tmp_data.row(sel[r]);
 
                         one = cal*newData;
                     }
                 }
                 else
                 {
-                    if (t_pTag->type == FIFFT_DAU_PACK16)
-                        one = mult*(Map< MatrixDau16 >( t_pTag->toDauPack16(),nchan, thisRawDir.nsamp)).cast<double>();
-                    else if(t_pTag->type == FIFFT_INT)
-                        one = mult*(Map< MatrixXi >( t_pTag->toInt(),nchan, thisRawDir.nsamp)).cast<double>();
-                    else if(t_pTag->type == FIFFT_FLOAT)
-                        one = mult*(Map< MatrixXf >( t_pTag->toFloat(),nchan, thisRawDir.nsamp)).cast<double>();
-                    else
-                        printf("Data Storage Format not known yet [3]!! Type: %d\n", t_pTag->type);
+                    one = mult*tmp_data;
                 }
             }
             //
@@ -814,3 +734,135 @@ bool FiffRawData::read_raw_segment_times(MatrixXd& data,
     //
     return this->read_raw_segment(data, times, (qint32)from, (qint32)to, sel);
 }
+
+//=============================================================================================================
+
+bool FiffRawData::read_raw_segments(MatrixXd& data,
+                                    const VectorXi& from,
+                                    fiff_int_t nsamp,
+                                    const RowVectorXi& sel) const
+{
+    MNE_TRACE();
+    qint32 nseg = from.size();
+    if(nseg == 0 || nsamp <= 0) {
+        printf("No segments to read\n");
+        return false;
+    }
+
+    for(qint32 i = 0; i < nseg; ++i) {
+        if(from[i] < this->first_samp || from[i] + nsamp - 1 > this->last_samp) {
+            printf("Segment %d ... %d exceeds the data range %d ... %d\n", from[i], from[i] + nsamp - 1, this->first_samp, this->last_samp);
+            return false;
+        }
+    }
+
+    //
+    //  Channel selection, calibration, compensation and projection
+    //
+    qint32 nchan = this->info.nchan;
+    RowVectorXi picks = sel;
+    if(picks.size() == 0) {
+        picks = RowVectorXi::LinSpaced(nchan, 0, nchan - 1);
+    }
+    qint32 npick = picks.size();
+
+    bool projAvailable = this->proj.size() > 0;
+    SparseMatrix<double> mult;
+    if(projAvailable || this->comp.kind != -1) {
+        MatrixXd mult_full;
+        if(!projAvailable)
+            mult_full = this->comp.data->data;
+        else if(this->comp.kind == -1)
+            mult_full = this->proj;
+        else
+            mult_full = this->proj*this->comp.data->data;
+
+        MatrixXd selVect(npick, nchan);
+        for(qint32 i = 0; i < npick; ++i)
+            selVect.row(i) = mult_full.row(picks[i]);
+
+        mult = (selVect*this->cals.asDiagonal()).sparseView();
+    }
+
+    FiffStream::SPtr fid = this->file;
+    if (!fid->device()->isOpen())
+    {
+        if (!fid->device()->open(QIODevice::ReadOnly))
+        {
+            printf("Cannot open file %s",this->info.filename.toUtf8().constData());
+            return false;
+        }
+    }
+
+    //
+    //  Sweep the buffers once. The segments are visited in the order of their first sample; all of them have the
+    //  same length, so the segments touching a buffer always form the window [lo, hi) of the sorted order.
+    //
+    std::vector<qint32> order(nseg);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&from](qint32 a, qint32 b) { return from[a] < from[b]; });
+
+    data.resize(npick, static_cast<Index>(nseg) * nsamp);
+
+    qint32 lo = 0, hi = 0;
+    MatrixXd raw, one;
+    FiffTag::SPtr t_pTag;
+    for(qint32 k = 0; k < this->rawdir.size() && lo < nseg; ++k)
+    {
+        const FiffRawDir& thisRawDir = this->rawdir[k];
+
+        while(hi < nseg && from[order[hi]] <= thisRawDir.last)
+            ++hi;
+        while(lo < hi && from[order[lo]] + nsamp - 1 < thisRawDir.first)
+            ++lo;
+        if(lo == hi)
+            continue;
+
+        //
+        //  Decode the buffer a single time
+        //
+        if (thisRawDir.ent->kind == -1)
+        {
+            //
+            //  Skip is translated to zeros
+            //
+            one = MatrixXd::Zero(npick, thisRawDir.nsamp);
+        }
+        else
+        {
+            fid->read_tag(t_pTag, thisRawDir.ent->pos, false);
+
+            if (!t_pTag->toBufferMatrix(nchan, thisRawDir.nsamp, raw))
+            {
+                printf("Data Storage Format not known yet!! Type: %d\n", t_pTag->type);
+                return false;
+            }
+
+            if (mult.cols() == 0)
+            {
+                one.resize(npick, thisRawDir.nsamp);
+                for(qint32 i = 0; i < npick; ++i)
+                    one.row(i) = this->cals[picks[i]]*raw.row(picks[i]);
+            }
+            else
+            {
+                one = mult*raw;
+            }
+        }
+
+        //
+        //  Slice it into every segment it overlaps with
+        //
+        for(qint32 j = lo; j < hi; ++j)
+        {
+            qint32 seg = order[j];
+            fiff_int_t first = std::max(from[seg], thisRawDir.first);
+            fiff_int_t last = std::min(from[seg] + nsamp - 1, thisRawDir.last);
+
+            if(first <= last)
+                data.middleCols(static_cast<Index>(seg)*nsamp + first - from[seg], last - first + 1) = one.middleCols(first - thisRawDir.first, last - first + 1);
+        }
+    }
+
+    return true;
+}
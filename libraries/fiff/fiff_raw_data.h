@@ -192,6 +192,25 @@ public:
                                 float to,
                                 const Eigen::RowVectorXi& sel = defaultRowVectorXi) const;
 
+    //=========================================================================================================
+    /**
+     * Reads several raw data segments of equal length in a single sweep over the raw buffers. Every buffer is
+     * read and calibrated at most once, also if it is shared by several (overlapping or adjacent) segments.
+     * Calibration, compensation and projection are applied the same way as in read_raw_segment.
+     *
+     * @param[out] data      returns the segments stacked column wise (channels x (segments * samples)), segment i
+     *                       occupies the columns i*nsamp ... (i+1)*nsamp-1.
+     * @param[in] from       first sample of each segment. The segments do not need to be sorted.
+     * @param[in] nsamp      number of samples per segment.
+     * @param[in] sel        optional channel selection vector.
+     *
+     * @return true if succeeded, false otherwise, e.g. if a segment exceeds the recorded samples.
+     */
+    bool read_raw_segments(Eigen::MatrixXd& data,
+                           const Eigen::VectorXi& from,
+                           fiff_int_t nsamp,
+                           const Eigen::RowVectorXi& sel = defaultRowVectorXi) const;
+
 public:
     FiffStream::SPtr file;      /**< replaces fid. */
     FiffInfo info;              /**< Fiff measurement information. */
@@ -84,6 +84,7 @@
 
 #include <QFile>
 #include <QTcpSocket>
+#include <QtEndian>
 
 //=============================================================================================================
 // USED NAMESPACES
@@ -139,14 +140,14 @@ FiffId FiffStream::id() const
 
 //=============================================================================================================
 
-QList<FiffDirEntry::SPtr>& FiffStream::dir()
+FiffDirEntryList& FiffStream::dir()
 {
     return m_dir;
 }
 
 //=============================================================================================================
 
-const QList<FiffDirEntry::SPtr>& FiffStream::dir() const
+const FiffDirEntryList& FiffStream::dir() const
 {
     return m_dir;
 }
@@ -280,6 +281,23 @@ bool FiffStream::open(QIODevice::OpenModeFlag mode)
     }
     m_id = t_pTag->toFiffID();
 
+    //
+    //   Use the sidecar index if it still matches the file
+    //
+    m_pIndex.clear();
+    QFile* t_pFile = qobject_cast<QFile*>(this->device());
+    if (t_pFile) {
+        FiffIndex::SPtr t_pIndex(new FiffIndex);
+        if (t_pIndex->read(t_sFileName, m_id)) {
+            qInfo("Reading tag directory of %s from its index...", t_sFileName.toUtf8().constData());
+            m_pIndex = t_pIndex;
+            m_dir = t_pIndex->dir;
+            m_dirtree = t_pIndex->dirtree;
+            this->device()->seek(SEEK_SET);
+            return true;
+        }
+    }
+
     this->read_tag(t_pTag);
     if (t_pTag->kind != FIFF_DIR_POINTER) {
         qWarning("Fiff::open: file does have a directory pointer");//consider throw
@@ -317,10 +335,7 @@ bool FiffStream::open(QIODevice::OpenModeFlag mode)
      */
     if (m_dir[m_dir.size()-2]->kind == FIFF_DIR) {
         m_dir.removeLast();
-        m_dir[m_dir.size()-1]->kind = -1;
-        m_dir[m_dir.size()-1]->type = -1;
-        m_dir[m_dir.size()-1]->size = -1;
-        m_dir[m_dir.size()-1]->pos  = -1;
+        m_dir.replace(m_dir.size()-1, FiffDirEntry());
     }
 
     //
@@ -331,6 +346,11 @@ bool FiffStream::open(QIODevice::OpenModeFlag mode)
     else
         this->m_dirtree->parent.clear();
 
+    if (t_pFile && FiffIndex::isEnabled()) {
+        m_pIndex = FiffIndex::SPtr(new FiffIndex(m_id, m_dir, m_dirtree));
+        m_pIndex->write(t_sFileName);
+    }
+
     //
     //   Back to the beginning
     //
@@ -350,17 +370,23 @@ bool FiffStream::close()
 
 //=============================================================================================================
 
-FiffDirNode::SPtr FiffStream::make_subtree(QList<FiffDirEntry::SPtr> &dentry)
+FiffDirNode::SPtr FiffStream::make_subtree(const FiffDirEntryList &dentry)
+{
+    qint32 current = 0;
+    return this->make_subtree(dentry, current);
+}
+
+//=============================================================================================================
+
+FiffDirNode::SPtr FiffStream::make_subtree(const FiffDirEntryList& dentry, qint32& current)
 {
     FiffDirNode::SPtr defaultNode;
     FiffDirNode::SPtr node = FiffDirNode::SPtr(new FiffDirNode);
     FiffDirNode::SPtr child;
     FiffTag::SPtr t_pTag;
-    QList<FiffDirEntry::SPtr> dir;
-    qint32 current = 0;
+    QVector<qint32> vecDir;
+    qint32 first = current;
 
-    node->dir_tree    = dentry;
-    node->nent_tree   = 1;
     node->parent      = FiffDirNode::SPtr();
     node->type = FIFFB_ROOT;
 
@@ -374,45 +400,39 @@ FiffDirNode::SPtr FiffStream::make_subtree(QList<FiffDirEntry::SPtr> &dentry)
         node->id = this->id();
     }
 
-    ++current;
-    int level = 0;
-    for (; current < dentry.size(); ++current) {
-        ++node->nent_tree;
-        if (dentry[current]->kind == FIFF_BLOCK_START) {
-            level++;
-            if (level == 1) {
-                QList<FiffDirEntry::SPtr> sub_dentry = dentry.mid(current);
-                if (!(child = this->make_subtree(sub_dentry)))
-                    return defaultNode;
-                child->parent = node;
-                node->children.append(child);
-            }
-        }
-        else if (dentry[current]->kind == FIFF_BLOCK_END) {
-            level--;
-            if (level < 0)
-                break;
+    for (++current; current < dentry.size(); ++current) {
+        const FiffDirEntry* ent = dentry[current];
+        if (ent->kind == FIFF_BLOCK_START) {
+            /*
+            * The child consumes the entries up to its own FIFF_BLOCK_END
+            */
+            if (!(child = this->make_subtree(dentry, current)))
+                return defaultNode;
+            child->parent = node;
+            node->children.append(child);
         }
-        else if (dentry[current]->kind == -1)
+        else if (ent->kind == FIFF_BLOCK_END || ent->kind == -1)
             break;
-        else if (level == 0) {
+        else {
             /*
             * Take the node id from the parent block id,
             * block id, or file id. Let the block id
             * take precedence over parent block id and file id
             */
-            if (((dentry[current]->kind == FIFF_PARENT_BLOCK_ID || dentry[current]->kind == FIFF_FILE_ID) && node->id.isEmpty()) || dentry[current]->kind == FIFF_BLOCK_ID) {
-                if (!this->read_tag(t_pTag,dentry[current]->pos))
+            if (((ent->kind == FIFF_PARENT_BLOCK_ID || ent->kind == FIFF_FILE_ID) && node->id.isEmpty()) || ent->kind == FIFF_BLOCK_ID) {
+                if (!this->read_tag(t_pTag,ent->pos))
                     return defaultNode;
                 node->id = t_pTag->toFiffID();
             }
-            dir.append(FiffDirEntry::SPtr(new FiffDirEntry(*dentry[current])));//Memcopy necessary here - or is a pointer fine?
+            vecDir.append(current);
         }
     }
-    /*
-     * Strip unused entries
-     */
-    node->dir = dir;
+    current = std::min(current, static_cast<qint32>(dentry.size()) - 1);
+
+    node->dir       = dentry.select(vecDir);
+    node->nent_tree = current - first + 1;
+    node->dir_tree  = dentry.mid(first, node->nent_tree);
+
     return node;
 }
 
@@ -1585,53 +1605,75 @@ bool FiffStream::read_tag_data(FiffTag::SPtr &p_pTag, fiff_long_t pos)
 
 fiff_long_t FiffStream::read_tag_info(FiffTag::SPtr &p_pTag, bool p_bDoSkip)
 {
-    fiff_long_t pos = this->device()->pos();
+    fiffTagRec t_tagHeader;
+    fiff_long_t pos = this->read_tag_header(t_tagHeader, false);
 
     p_pTag = FiffTag::SPtr(new FiffTag());
+    if (pos == -1)
+        return pos;
 
-    //Option 1
-//    t_DataStream.readRawData((char *)p_pTag, FIFFC_TAG_INFO_SIZE);
-//    p_pTag->kind = Fiff::swap_int(p_pTag->kind);
-//    p_pTag->type = Fiff::swap_int(p_pTag->type);
-//    p_pTag->size = Fiff::swap_int(p_pTag->size);
-//    p_pTag->next = Fiff::swap_int(p_pTag->next);
-
-    //Option 2
-     *this  >> p_pTag->kind;
-     *this  >> p_pTag->type;
-    qint32 size;
-     *this  >> size;
-    p_pTag->resize(size);
-     *this  >> p_pTag->next;
+    p_pTag->kind = t_tagHeader.kind;
+    p_pTag->type = t_tagHeader.type;
+    p_pTag->resize(t_tagHeader.size);
+    p_pTag->next = t_tagHeader.next;
 
 //    qDebug() << "read_tag_info" << "  Kind:" << p_pTag->kind << "  Type:" << p_pTag->type << "  Size:" << p_pTag->size() << "  Next:" << p_pTag->next;
 
-    if (p_bDoSkip)
+    if (p_bDoSkip && !this->skip_tag_data(t_tagHeader))
+        pos = -1;
+
+    return pos;
+}
+
+//=============================================================================================================
+
+fiff_long_t FiffStream::read_tag_header(fiffTagRec& p_tagHeader, bool p_bDoSkip)
+{
+    fiff_long_t pos = this->device()->pos();
+
+    char t_header[16];
+    if (this->readRawData(t_header, 16) != 16)
+        return -1;
+
+    p_tagHeader.kind = qFromBigEndian<qint32>(reinterpret_cast<const uchar*>(t_header));
+    p_tagHeader.type = qFromBigEndian<qint32>(reinterpret_cast<const uchar*>(t_header + 4));
+    p_tagHeader.size = qFromBigEndian<qint32>(reinterpret_cast<const uchar*>(t_header + 8));
+    p_tagHeader.next = qFromBigEndian<qint32>(reinterpret_cast<const uchar*>(t_header + 12));
+    p_tagHeader.data = NULL;
+
+    if (p_bDoSkip && !this->skip_tag_data(p_tagHeader))
+        pos = -1;
+
+    return pos;
+}
+
+//=============================================================================================================
+
+bool FiffStream::skip_tag_data(const fiffTagRec& p_tagHeader)
+{
+    QTcpSocket* t_qTcpSocket = qobject_cast<QTcpSocket*>(this->device());
+    if(t_qTcpSocket)
+    {
+        this->skipRawData(p_tagHeader.size);
+    }
+    else
     {
-        QTcpSocket* t_qTcpSocket = qobject_cast<QTcpSocket*>(this->device());
-        if(t_qTcpSocket)
+        if (p_tagHeader.next > 0)
         {
-            this->skipRawData(p_pTag->size());
+            if(!this->device()->seek(p_tagHeader.next)) {
+                qCritical("fseek"); //fseek(fid,tag.next,'bof');
+                return false;
+            }
         }
-        else
+        else if (p_tagHeader.size > 0 && p_tagHeader.next == FIFFV_NEXT_SEQ)
         {
-            if (p_pTag->next > 0)
-            {
-                if(!this->device()->seek(p_pTag->next)) {
-                    qCritical("fseek"); //fseek(fid,tag.next,'bof');
-                    pos = -1;
-                }
-            }
-            else if (p_pTag->size() > 0 && p_pTag->next == FIFFV_NEXT_SEQ)
-            {
-                if(!this->device()->seek(this->device()->pos()+p_pTag->size())) {
-                    qCritical("fseek"); //fseek(fid,tag.size,'cof');
-                    pos = -1;
-                }
+            if(!this->device()->seek(this->device()->pos()+p_tagHeader.size)) {
+                qCritical("fseek"); //fseek(fid,tag.size,'cof');
+                return false;
             }
         }
     }
-    return pos;
+    return true;
 }
 
 //=============================================================================================================
@@ -1657,7 +1699,8 @@ bool FiffStream::read_rt_tag(FiffTag::SPtr &p_pTag)
 //=============================================================================================================
 
 bool FiffStream::read_tag(FiffTag::SPtr &p_pTag,
-                          fiff_long_t pos)
+                          fiff_long_t pos,
+                          bool p_bConvert)
 {
     if (pos >= 0) {
         this->device()->seek(pos);
@@ -1693,7 +1736,10 @@ bool FiffStream::read_tag(FiffTag::SPtr &p_pTag,
     {
         this->readRawData(p_pTag->data(), p_pTag->size());
         //FiffTag::convert_tag_data(p_pTag,FIFFV_BIG_ENDIAN,FIFFV_NATIVE_ENDIAN);
-        FiffTag::convert_tag_data(p_pTag,endian,FIFFV_NATIVE_ENDIAN);
+        if (p_bConvert)
+            FiffTag::convert_tag_data(p_pTag,endian,FIFFV_NATIVE_ENDIAN);
+        else
+            p_pTag->endian = endian;
     }
 
     if (p_pTag->next != FIFFV_NEXT_SEQ)
@@ -1777,111 +1823,131 @@ bool FiffStream::setup_read_raw(QIODevice &p_IODevice,
     //
     //   Process the directory
     //
-    QList<FiffDirEntry::SPtr> dir = raw[0]->dir;
+    FiffDirEntryList dir = raw[0]->dir;
     fiff_int_t nent = raw[0]->nent();
     fiff_int_t nchan = info.nchan;
     fiff_int_t first = 0;
     fiff_int_t first_samp = 0;
     fiff_int_t first_skip = 0;
     //
-    //  Get first sample tag if it is there
+    //   The buffer map may be in the index already
     //
-    FiffTag::SPtr t_pTag;
-    if (dir[first]->kind == FIFF_FIRST_SAMPLE)
+    FiffIndex::SPtr t_pIndex = t_pStream->m_pIndex;
+    if (t_pIndex && t_pIndex->hasRawDir(nchan))
     {
-        t_pStream->read_tag(t_pTag, dir[first]->pos);
-        first_samp = *t_pTag->toInt();
-        ++first;
+        data.first_samp = t_pIndex->first_samp;
+        data.last_samp  = t_pIndex->last_samp;
+        data.rawdir     = t_pIndex->rawdir;
     }
-    //
-    //  Omit initial skip
-    //
-    if (dir[first]->kind == FIFF_DATA_SKIP)
+    else
     {
         //
-        //  This first skip can be applied only after we know the buffer size
+        //  Get first sample tag if it is there
         //
-        t_pStream->read_tag(t_pTag, dir[first]->pos);
-        first_skip = *t_pTag->toInt();
-        ++first;
-    }
-    data.first_samp = first_samp;
-    //
-    //   Go through the remaining tags in the directory
-    //
-    QList<FiffRawDir> rawdir;
-//        rawdir = struct('ent',{},'first',{},'last',{},'nsamp',{});
-    fiff_int_t nskip = 0;
-    fiff_int_t ndir  = 0;
-    fiff_int_t nsamp = 0;
-    for (qint32 k = first; k < nent; ++k)
-    {
-        FiffDirEntry::SPtr ent = dir[k];
-        if (ent->kind == FIFF_DATA_SKIP)
+        FiffTag::SPtr t_pTag;
+        if (dir[first]->kind == FIFF_FIRST_SAMPLE)
         {
-            t_pStream->read_tag(t_pTag, ent->pos);
-            nskip = *t_pTag->toInt();
+            t_pStream->read_tag(t_pTag, dir[first]->pos);
+            first_samp = *t_pTag->toInt();
+            ++first;
         }
-        else if(ent->kind == FIFF_DATA_BUFFER)
+        //
+        //  Omit initial skip
+        //
+        if (dir[first]->kind == FIFF_DATA_SKIP)
         {
             //
-            //   Figure out the number of samples in this buffer
-            //
-            switch(ent->type)
-            {
-                case FIFFT_DAU_PACK16:
-                    nsamp = ent->size/(2*nchan);
-                    break;
-                case FIFFT_SHORT:
-                    nsamp = ent->size/(2*nchan);
-                    break;
-                case FIFFT_FLOAT:
-                    nsamp = ent->size/(4*nchan);
-                    break;
-                case FIFFT_INT:
-                    nsamp = ent->size/(4*nchan);
-                    break;
-                default:
-                    qWarning("Cannot handle data buffers of type %d\n",ent->type);
-                    return false;
-            }
-            //
-            //  Do we have an initial skip pending?
+            //  This first skip can be applied only after we know the buffer size
             //
-            if (first_skip > 0)
+            t_pStream->read_tag(t_pTag, dir[first]->pos);
+            first_skip = *t_pTag->toInt();
+            ++first;
+        }
+        data.first_samp = first_samp;
+        //
+        //   Go through the remaining tags in the directory
+        //
+        QList<FiffRawDir> rawdir;
+    //        rawdir = struct('ent',{},'first',{},'last',{},'nsamp',{});
+        fiff_int_t nskip = 0;
+        fiff_int_t ndir  = 0;
+        fiff_int_t nsamp = 0;
+        for (qint32 k = first; k < nent; ++k)
+        {
+            const FiffDirEntry* ent = dir[k];
+            if (ent->kind == FIFF_DATA_SKIP)
             {
-                first_samp += nsamp*first_skip;
-                data.first_samp = first_samp;
-                first_skip = 0;
+                t_pStream->read_tag(t_pTag, ent->pos);
+                nskip = *t_pTag->toInt();
             }
-            //
-            //  Do we have a skip pending?
-            //
-            if (nskip > 0)
+            else if(ent->kind == FIFF_DATA_BUFFER)
             {
+                //
+                //   Figure out the number of samples in this buffer
+                //
+                switch(ent->type)
+                {
+                    case FIFFT_DAU_PACK16:
+                        nsamp = ent->size/(2*nchan);
+                        break;
+                    case FIFFT_SHORT:
+                        nsamp = ent->size/(2*nchan);
+                        break;
+                    case FIFFT_FLOAT:
+                        nsamp = ent->size/(4*nchan);
+                        break;
+                    case FIFFT_INT:
+                        nsamp = ent->size/(4*nchan);
+                        break;
+                    default:
+                        qWarning("Cannot handle data buffers of type %d\n",ent->type);
+                        return false;
+                }
+                //
+                //  Do we have an initial skip pending?
+                //
+                if (first_skip > 0)
+                {
+                    first_samp += nsamp*first_skip;
+                    data.first_samp = first_samp;
+                    first_skip = 0;
+                }
+                //
+                //  Do we have a skip pending?
+                //
+                if (nskip > 0)
+                {
+                    FiffRawDir t_RawDir;
+                    t_RawDir.first = first_samp;
+                    t_RawDir.last  = first_samp + nskip*nsamp - 1;//ToDo -1 right or is that MATLAB syntax
+                    t_RawDir.nsamp = nskip*nsamp;
+                    rawdir.append(t_RawDir);
+                    first_samp = first_samp + nskip*nsamp;
+                    nskip = 0;
+                    ++ndir;
+                }
+                //
+                //  Add a data buffer
+                //
                 FiffRawDir t_RawDir;
+                t_RawDir.ent  = FiffDirEntry::SPtr(new FiffDirEntry(*ent));
                 t_RawDir.first = first_samp;
-                t_RawDir.last  = first_samp + nskip*nsamp - 1;//ToDo -1 right or is that MATLAB syntax
-                t_RawDir.nsamp = nskip*nsamp;
+                t_RawDir.last  = first_samp + nsamp - 1;//ToDo -1 right or is that MATLAB syntax
+                t_RawDir.nsamp = nsamp;
                 rawdir.append(t_RawDir);
-                first_samp = first_samp + nskip*nsamp;
-                nskip = 0;
+                first_samp += nsamp;
                 ++ndir;
             }
-            //
-            //  Add a data buffer
-            //
-            FiffRawDir t_RawDir;
-            t_RawDir.ent  = ent;
-            t_RawDir.first = first_samp;
-            t_RawDir.last  = first_samp + nsamp - 1;//ToDo -1 right or is that MATLAB syntax
-            t_RawDir.nsamp = nsamp;
-            rawdir.append(t_RawDir);
-            first_samp += nsamp;
-            ++ndir;
+        }
+        data.last_samp  = first_samp - 1;//ToDo -1 right or is that MATLAB syntax
+        data.rawdir     = rawdir;
+
+        if (t_pIndex && FiffIndex::isEnabled())
+        {
+            t_pIndex->setRawDir(nchan, data.first_samp, data.last_samp, rawdir);
+            t_pIndex->write(t_sFileName);
         }
     }
-    data.last_samp  = first_samp - 1;//ToDo -1 right or is that MATLAB syntax
     //
     //   Add the calibration factors
     //
@@ -1891,7 +1957,6 @@ bool FiffStream::setup_read_raw(QIODevice &p_IODevice,
         cals[k] = data.info.chs[k].range*data.info.chs[k].cal;
     //
     data.cals       = cals;
-    data.rawdir     = rawdir;
     //data->proj       = [];
     //data.comp       = [];
     //
@@ -2553,7 +2618,7 @@ fiff_long_t FiffStream::write_dir_pointer(fiff_int_t dirpos, fiff_long_t pos, fi
 
 //=============================================================================================================
 
-fiff_long_t FiffStream::write_dir_entries(const QList<FiffDirEntry::SPtr> &dir, fiff_long_t pos)
+fiff_long_t FiffStream::write_dir_entries(const FiffDirEntryList &dir, fiff_long_t pos)
 {
 //    /** Directories are composed of these structures. *
 //     typedef struct _fiffDirEntryRec {
@@ -3172,11 +3237,11 @@ void FiffStream::write_rt_command(fiff_int_t command, const QString& data)
 
 //=============================================================================================================
 
-QList<FiffDirEntry::SPtr> FiffStream::make_dir(bool *ok)
+FiffDirEntryList FiffStream::make_dir(bool *ok)
 {
-    FiffTag::SPtr t_pTag;
-    QList<FiffDirEntry::SPtr> dir;
-    FiffDirEntry::SPtr t_pFiffDirEntry;
+    fiffTagRec t_tagHeader;
+    FiffDirEntryList dir;
+    FiffDirEntry t_FiffDirEntry;
     fiff_long_t pos;
     if(ok) *ok = false;
     /*
@@ -3184,36 +3249,33 @@ QList<FiffDirEntry::SPtr> FiffStream::make_dir(bool *ok)
      */
     if(!this->device()->seek(SEEK_SET))
         return dir;
-    while ((pos = this->read_tag_info(t_pTag)) != -1) {
+    /*
+     * Only the tag headers are read, the data is skipped without being buffered
+     */
+    while ((pos = this->read_tag_header(t_tagHeader)) != -1) {
         /*
         * Check that we haven't run into the directory
         */
-        if (t_pTag->kind == FIFF_DIR)
+        if (t_tagHeader.kind == FIFF_DIR)
             break;
         /*
         * Put in the new entry
         */
-        t_pFiffDirEntry = FiffDirEntry::SPtr(new FiffDirEntry);
-        t_pFiffDirEntry->kind = t_pTag->kind;
-        t_pFiffDirEntry->type = t_pTag->type;
-        t_pFiffDirEntry->size = t_pTag->size();
-        t_pFiffDirEntry->pos = (fiff_long_t)pos;
+        t_FiffDirEntry.kind = t_tagHeader.kind;
+        t_FiffDirEntry.type = t_tagHeader.type;
+        t_FiffDirEntry.size = t_tagHeader.size;
+        t_FiffDirEntry.pos = (fiff_long_t)pos;
 
-        //qDebug() << "Kind: " << t_pTag->kind << "| Type:" << t_pTag->type << "| Size" << t_pTag->size() << "| Next:" << t_pTag->next;
+        //qDebug() << "Kind: " << t_tagHeader.kind << "| Type:" << t_tagHeader.type << "| Size" << t_tagHeader.size << "| Next:" << t_tagHeader.next;
 
-        dir.append(t_pFiffDirEntry);
-        if (t_pTag->next < 0)
+        dir.append(t_FiffDirEntry);
+        if (t_tagHeader.next < 0)
             break;
     }
     /*
      * Put in the new the terminating entry
      */
-    t_pFiffDirEntry = FiffDirEntry::SPtr(new FiffDirEntry);
-    t_pFiffDirEntry->kind = -1;
-    t_pFiffDirEntry->type = -1;
-    t_pFiffDirEntry->size = -1;
-    t_pFiffDirEntry->pos  = -1;
-    dir.append(t_pFiffDirEntry);
+    dir.append(FiffDirEntry());
 
     if(ok) *ok = true;
     return dir;
@@ -47,6 +47,8 @@
 
 #include "fiff_dir_node.h"
 #include "fiff_dir_entry.h"
+#include "fiff_dir_entry_list.h"
+#include "fiff_index.h"
 
 //=============================================================================================================
 // EIGEN INCLUDES
@@ -149,7 +151,7 @@ public:
      *
      * @return the directory.
      */
-    QList<FiffDirEntry::SPtr>& dir();
+    FiffDirEntryList& dir();
 
     //=========================================================================================================
     /**
@@ -158,7 +160,7 @@ public:
      *
      * @return the directory.
      */
-    const QList<FiffDirEntry::SPtr>& dir() const;
+    const FiffDirEntryList& dir() const;
 
     //=========================================================================================================
     /**
@@ -257,7 +259,20 @@ public:
      *
      * @return The created dir tree.
      */
-    FiffDirNode::SPtr make_subtree(QList<FiffDirEntry::SPtr>& dentry);
+    FiffDirNode::SPtr make_subtree(const FiffDirEntryList& dentry);
+
+    //=========================================================================================================
+    /**
+     * Create the directory tree structure of the block starting at dentry[current]. The dir and dir_tree of the
+     * nodes are views of dentry, sub blocks are built from the same list, so no entries are copied.
+     *
+     * @param[in] dentry         The dir entries of which the tree should be constructed.
+     * @param[in, out] current   The index of the first entry of the block. Returns the index of the last entry
+     *                           belonging to the block, usually its FIFF_BLOCK_END.
+     *
+     * @return The created dir tree.
+     */
+    FiffDirNode::SPtr make_subtree(const FiffDirEntryList& dentry, qint32& current);
 
     //=========================================================================================================
     /**
@@ -404,6 +419,19 @@ public:
      */
     fiff_long_t read_tag_info(QSharedPointer<FiffTag>& p_pTag, bool p_bDoSkip = true);
 
+    //=========================================================================================================
+    /**
+     * Reads the 16 byte header of one tag from the current file position. In contrast to read_tag_info nothing
+     * is allocated, neither a tag nor a buffer for the data, which makes this the method of choice for scanning
+     * files.
+     *
+     * @param[out] p_tagHeader   The kind, type, size and next fields of the tag. The data pointer is set to NULL.
+     * @param[in] p_bDoSkip      if true it skips the data of the tag (optional, default = true).
+     *
+     * @return the position where the tag header was read from, -1 if the header could not be read completely.
+     */
+    fiff_long_t read_tag_header(fiffTagRec& p_tagHeader, bool p_bDoSkip = true);
+
     //=========================================================================================================
     /**
      * Read one tag from a fif real-time stream.
@@ -423,11 +451,15 @@ public:
      *
      * @param[out] p_pTag the read tag.
      * @param[in] pos position of the tag inside the fif file.
+     * @param[in] p_bConvert whether to convert the data to native byte order. If false the data stays in file
+     *                       byte order, which is recorded in FiffTag::endian, and is converted when decoded
+     *                       (see FiffTag::toBufferMatrix).
      *
      * @return true if succeeded, false otherwise.
      */
     bool read_tag(QSharedPointer<FiffTag>& p_pTag,
-                  fiff_long_t pos = -1);
+                  fiff_long_t pos = -1,
+                  bool p_bConvert = true);
 
     //=========================================================================================================
     /**
@@ -627,7 +659,7 @@ public:
      *
      * @return the position where the directory entries struct was written to.
      */
-    fiff_long_t write_dir_entries(const QList<FiffDirEntry::SPtr>& dir, fiff_long_t pos = -1);
+    fiff_long_t write_dir_entries(const FiffDirEntryList& dir, fiff_long_t pos = -1);
 
     //=========================================================================================================
     /**
@@ -878,16 +910,27 @@ private:
      *
      * @return The created directory.
      */
-    QList<FiffDirEntry::SPtr> make_dir(bool *ok=Q_NULLPTR);
+    FiffDirEntryList make_dir(bool *ok=Q_NULLPTR);
+
+    //=========================================================================================================
+    /**
+     * Moves the stream behind the data of a tag whose header was just read.
+     *
+     * @param[in] p_tagHeader    The header of the tag.
+     *
+     * @return true if succeeded, false otherwise.
+     */
+    bool skip_tag_data(const fiffTagRec& p_tagHeader);
 
 private:
 
 //    char         *file_name;    /**< Name of the file. */ -> Use streamName() instead
 //    FILE         *fd;           /**< The normal file descriptor. */ -> file descitpion is part of the stream: stream->device()
     FiffId                      m_id;   /**< The file identifier. */
-    QList<FiffDirEntry::SPtr>   m_dir;  /**< This is the directory. If no directory exists, open automatically scans the file to create one. */
+    FiffDirEntryList            m_dir;  /**< This is the directory. If no directory exists, open automatically scans the file to create one. */
 //    int         nent;           /**< How many entries?. */ -> Use nent() instead
     FiffDirNode::SPtr           m_dirtree; /**< Directory compiled into a tree. */
+    FiffIndex::SPtr             m_pIndex;  /**< Sidecar index of the file, if one was read or written (see FiffIndex). */
 //    char        *ext_file_name; /**< Name of the file holding the external data. */
 //    FILE        *ext_fd;        /**< The file descriptor of the above file if open . */
 
@@ -65,6 +65,7 @@ FiffTag::FiffTag()
 : kind(0)
 , type(0)
 , next(0)
+, endian(FIFFV_NATIVE_ENDIAN)
 //, m_pComplexFloatData(NULL)
 //, m_pComplexDoubleData(NULL)
 {
@@ -77,6 +78,7 @@ FiffTag::FiffTag(const FiffTag* p_pFiffTag)
 , kind(p_pFiffTag->kind)
 , type(p_pFiffTag->type)
 , next(p_pFiffTag->next)
+, endian(p_pFiffTag->endian)
 {
 //    if(p_pFiffTag->m_pComplexFloatData)
 //        this->toComplexFloat();
@@ -265,6 +267,71 @@ QString FiffTag::getInfo() const
 
 //=============================================================================================================
 
+bool FiffTag::toBufferMatrix(int nchan, int nsamp, Eigen::MatrixXd& matData) const
+{
+    matData.resize(nchan, nsamp);
+
+    qint64 np = static_cast<qint64>(nchan)*nsamp;
+    int iWordSize = 0;
+    switch(this->type) {
+    case FIFFT_DAU_PACK16:
+    case FIFFT_SHORT:
+        iWordSize = sizeof(fiff_short_t);
+        break;
+    case FIFFT_INT:
+    case FIFFT_FLOAT:
+        iWordSize = sizeof(fiff_int_t);
+        break;
+    case FIFFT_DOUBLE:
+        iWordSize = sizeof(fiff_double_t);
+        break;
+    default:
+        break;
+    }
+
+    if(iWordSize == 0 || this->size() < np*iWordSize) {
+        matData.setZero();
+        return false;
+    }
+
+    int from_endian = (this->endian == FIFFV_NATIVE_ENDIAN) ? NATIVE_ENDIAN : this->endian;
+    bool bSwap = from_endian != NATIVE_ENDIAN;
+
+    // The buffer is stored sample by sample, which is the column major layout of a channels x samples matrix
+    double* dest = matData.data();
+    switch(this->type) {
+    case FIFFT_DAU_PACK16:
+    case FIFFT_SHORT:
+        if(bSwap)
+            IOUtils::swap_to_double((const qint16*)this->data(), dest, np);
+        else
+            matData = Eigen::Map<const MatrixDau16>((const qint16*)this->data(), nchan, nsamp).cast<double>();
+        break;
+    case FIFFT_INT:
+        if(bSwap)
+            IOUtils::swap_to_double((const qint32*)this->data(), dest, np);
+        else
+            matData = Eigen::Map<const Eigen::MatrixXi>((const qint32*)this->data(), nchan, nsamp).cast<double>();
+        break;
+    case FIFFT_FLOAT:
+        if(bSwap)
+            IOUtils::swap_to_double((const float*)this->data(), dest, np);
+        else
+            matData = Eigen::Map<const Eigen::MatrixXf>((const float*)this->data(), nchan, nsamp).cast<double>();
+        break;
+    case FIFFT_DOUBLE:
+        if(bSwap)
+            IOUtils::swap_to_double((const double*)this->data(), dest, np);
+        else
+            matData = Eigen::Map<const Eigen::MatrixXd>((const double*)this->data(), nchan, nsamp);
+        break;
+    }
+
+    return true;
+}
+
+//=============================================================================================================
+
 /*---------------------------------------------------------------------------
  *
  * Motorola like Architectures
@@ -322,9 +389,7 @@ void FiffTag::convert_matrix_from_file_data(FiffTag::SPtr tag)
 {
     int ndim;
     int k;
-    int *dimp,*data,kind,np,nz;
-    float *fdata;
-    double *ddata;
+    int *dimp,kind,np,nz;
     unsigned int tsize = tag->size();
 
     if (fiff_type_fundamental(tag->type) != FIFFTS_FS_MATRIX)
@@ -364,26 +429,19 @@ void FiffTag::convert_matrix_from_file_data(FiffTag::SPtr tag)
         /*
          * Take care of the indices
         */
-        for (data = (int *)(tag->data())+nz, k = 0; k < np; k++)
-            IOUtils::swap_intp(data+k);
+        IOUtils::swap_many((qint32 *)(tag->data())+nz, np);
         np = nz;
     }
     /*
      * Now convert data...
      */
     kind = fiff_type_base(tag->type);
-    if (kind == FIFFT_INT) {
-        for (data = (int *)(tag->data()), k = 0; k < np; k++)
-            IOUtils::swap_intp(data+k);
-    }
-    else if (kind == FIFFT_FLOAT) {
-        for (fdata = (float *)(tag->data()), k = 0; k < np; k++)
-            IOUtils::swap_floatp(fdata+k);
-    }
-    else if (kind == FIFFT_DOUBLE) {
-        for (ddata = (double *)(tag->data()), k = 0; k < np; k++)
-            IOUtils::swap_doublep(ddata+k);
-    }
+    if (kind == FIFFT_INT)
+        IOUtils::swap_many((qint32 *)(tag->data()), np);
+    else if (kind == FIFFT_FLOAT)
+        IOUtils::swap_many((float *)(tag->data()), np);
+    else if (kind == FIFFT_DOUBLE)
+        IOUtils::swap_many((double *)(tag->data()), np);
     return;
 }
 
@@ -396,9 +454,7 @@ void FiffTag::convert_matrix_to_file_data(FiffTag::SPtr tag)
 {
     int ndim;
     int k;
-    int *dimp,*data,kind,np;
-    float *fdata;
-    double *ddata;
+    int *dimp,kind,np;
     unsigned int tsize = tag->size();
 
     if (fiff_type_fundamental(tag->type) != FIFFTS_FS_MATRIX)
@@ -440,26 +496,16 @@ void FiffTag::convert_matrix_to_file_data(FiffTag::SPtr tag)
      * Now convert data...
      */
     kind = fiff_type_base(tag->type);
-    if (kind == FIFFT_INT) {
-        for (data = (int *)(tag->data()), k = 0; k < np; k++)
-            IOUtils::swap_intp(data+k);
-    }
-    else if (kind == FIFFT_FLOAT) {
-        for (fdata = (float *)(tag->data()), k = 0; k < np; k++)
-            IOUtils::swap_floatp(fdata+k);
-    }
-    else if (kind == FIFFT_DOUBLE) {
-        for (ddata = (double *)(tag->data()), k = 0; k < np; k++)
-            IOUtils::swap_doublep(ddata+k);
-    }
-    else if (kind == FIFFT_COMPLEX_FLOAT) {
-        for (fdata = (float *)(tag->data()), k = 0; k < 2*np; k++)
-            IOUtils::swap_floatp(fdata+k);
-    }
-    else if (kind == FIFFT_COMPLEX_DOUBLE) {
-        for (ddata = (double *)(tag->data()), k = 0; k < 2*np; k++)
-            IOUtils::swap_doublep(ddata+k);
-    }
+    if (kind == FIFFT_INT)
+        IOUtils::swap_many((qint32 *)(tag->data()), np);
+    else if (kind == FIFFT_FLOAT)
+        IOUtils::swap_many((float *)(tag->data()), np);
+    else if (kind == FIFFT_DOUBLE)
+        IOUtils::swap_many((double *)(tag->data()), np);
+    else if (kind == FIFFT_COMPLEX_FLOAT)
+        IOUtils::swap_many((float *)(tag->data()), 2*np);
+    else if (kind == FIFFT_COMPLEX_DOUBLE)
+        IOUtils::swap_many((double *)(tag->data()), 2*np);
     return;
 }
 
@@ -468,13 +514,9 @@ void FiffTag::convert_matrix_to_file_data(FiffTag::SPtr tag)
 void FiffTag::convert_tag_data(FiffTag::SPtr tag, int from_endian, int to_endian)
 {
     int            np;
-    int            k,r;//,c;
+    int            k;
     char           *offset;
-    fiff_int_t     *ithis;
-    fiff_short_t   *sthis;
-    fiff_long_t    *lthis;
     float          *fthis;
-    double         *dthis;
 //    fiffDirEntry   dethis;
 //    fiffId         idthis;
 //    fiffChInfoRec* chthis;//FiffChInfo*     chthis;//ToDo adapt parsing to the new class
@@ -508,37 +550,32 @@ void FiffTag::convert_tag_data(FiffTag::SPtr tag, int from_endian, int to_endian
     case FIFFT_UINT :
     case FIFFT_JULIAN :
         np = tag->size()/sizeof(fiff_int_t);
-        for (ithis = (fiff_int_t *)tag->data(), k = 0; k < np; k++, ithis++)
-            IOUtils::swap_intp(ithis);
+        IOUtils::swap_many((qint32 *)tag->data(), np);
         break;
 
     case FIFFT_LONG :
     case FIFFT_ULONG :
         np = tag->size()/sizeof(fiff_long_t);
-        for (lthis = (fiff_long_t *)tag->data(), k = 0; k < np; k++, lthis++)
-            IOUtils::swap_longp(lthis);
+        IOUtils::swap_many((qint64 *)tag->data(), np);
         break;
 
     case FIFFT_SHORT :
     case FIFFT_DAU_PACK16 :
     case FIFFT_USHORT :
         np = tag->size()/sizeof(fiff_short_t);
-        for (sthis = (fiff_short_t *)tag->data(), k = 0; k < np; k++, sthis++)
-            *sthis = IOUtils::swap_short(*sthis);
+        IOUtils::swap_many((qint16 *)tag->data(), np);
         break;
 
     case FIFFT_FLOAT :
     case FIFFT_COMPLEX_FLOAT :
         np = tag->size()/sizeof(fiff_float_t);
-        for (fthis = (fiff_float_t *)tag->data(), k = 0; k < np; k++, fthis++)
-            IOUtils::swap_floatp(fthis);
+        IOUtils::swap_many((float *)tag->data(), np);
         break;
 
     case FIFFT_DOUBLE :
     case FIFFT_COMPLEX_DOUBLE :
         np = tag->size()/sizeof(fiff_double_t);
-        for (dthis = (fiff_double_t *)tag->data(), k = 0; k < np; k++, dthis++)
-            IOUtils::swap_doublep(dthis);
+        IOUtils::swap_many((double *)tag->data(), np);
         break;
 
     case FIFFT_OLD_PACK :
@@ -548,10 +585,8 @@ void FiffTag::convert_tag_data(FiffTag::SPtr tag, int from_endian, int to_endian
      */
         IOUtils::swap_floatp(fthis+0);
         IOUtils::swap_floatp(fthis+1);
-        sthis = (short *)(fthis+2);
         np = (tag->size() - 2*sizeof(float))/sizeof(short);
-        for (k = 0; k < np; k++,sthis++)
-            *sthis = IOUtils::swap_short(*sthis);
+        IOUtils::swap_many((qint16 *)(fthis+2), np);
         break;
 
     case FIFFT_DIR_ENTRY_STRUCT :
@@ -562,15 +597,9 @@ void FiffTag::convert_tag_data(FiffTag::SPtr tag, int from_endian, int to_endian
 //            dethis->size = swap_int(dethis->size);
 //            dethis->pos  = swap_int(dethis->pos);
 //        }
+        // kind, type, size and pos are all 32 bit words
         np = tag->size()/FiffDirEntry::storageSize();
-        for (k = 0; k < np; k++) {
-            offset = (char*)tag->data() + k*FiffDirEntry::storageSize();
-            ithis = (fiff_int_t*) offset;
-            ithis[0] = IOUtils::swap_int(ithis[0]);//kind
-            ithis[1] = IOUtils::swap_int(ithis[1]);//type
-            ithis[2] = IOUtils::swap_int(ithis[2]);//size
-            ithis[3] = IOUtils::swap_int(ithis[3]);//pos
-        }
+        IOUtils::swap_many((qint32 *)tag->data(), np*FiffDirEntry::storageSize()/sizeof(fiff_int_t));
         break;
 
     case FIFFT_ID_STRUCT :
@@ -582,16 +611,9 @@ void FiffTag::convert_tag_data(FiffTag::SPtr tag, int from_endian, int to_endian
 //            idthis->time.secs  = swap_int(idthis->time.secs);
 //            idthis->time.usecs = swap_int(idthis->time.usecs);
 //        }
+        // version, machid[0], machid[1], time.secs and time.usecs are all 32 bit words
         np = tag->size()/FiffId::storageSize();
-        for (k = 0; k < np; k++) {
-            offset = (char*)tag->data() + k*FiffId::storageSize();
-            ithis = (fiff_int_t*) offset;
-            ithis[0] = IOUtils::swap_int(ithis[0]);//version
-            ithis[1] = IOUtils::swap_int(ithis[1]);//machid[0]
-            ithis[2] = IOUtils::swap_int(ithis[2]);//machid[1]
-            ithis[3] = IOUtils::swap_int(ithis[3]);//time.secs
-            ithis[4] = IOUtils::swap_int(ithis[4]);//time.usecs
-        }
+        IOUtils::swap_many((qint32 *)tag->data(), np*FiffId::storageSize()/sizeof(fiff_int_t));
         break;
 
     case FIFFT_CH_INFO_STRUCT :
@@ -610,19 +632,8 @@ void FiffTag::convert_tag_data(FiffTag::SPtr tag, int from_endian, int to_endian
         np = tag->size()/FiffChInfo::storageSize();
         for (k = 0; k < np; k++) {
             offset = (char*)tag->data() + k*FiffChInfo::storageSize();
-            ithis = (fiff_int_t*) offset;
-            fthis = (float*) offset;
-
-            ithis[0] = IOUtils::swap_int(ithis[0]);  //scanno
-            ithis[1] = IOUtils::swap_int(ithis[1]);  //logno
-            ithis[2] = IOUtils::swap_int(ithis[2]);  //kind
-            IOUtils::swap_floatp(&fthis[3]);         //range
-            IOUtils::swap_floatp(&fthis[4]);         //cal
-            ithis[5] = IOUtils::swap_int(ithis[5]);  //coil_type
-            for (r = 0; r < 12; ++r)
-                IOUtils::swap_floatp(&fthis[6+r]);   //loc
-            ithis[18] = IOUtils::swap_int(ithis[18]);//unit
-            ithis[19] = IOUtils::swap_int(ithis[19]);//unit_mul
+            // scanno, logno, kind, range, cal, coil_type, loc[12], unit and unit_mul, the name stays as is
+            IOUtils::swap_many((qint32 *)offset, 20);
         }
 
         break;
@@ -632,17 +643,9 @@ void FiffTag::convert_tag_data(FiffTag::SPtr tag, int from_endian, int to_endian
 //        for (cpthis = (fiffChPos)tag->data->data(), k = 0; k < np; k++, cpthis++)
 //            convert_ch_pos(cpthis);
 
+        // coil_type, r0, ex, ey and ez are all 32 bit words
         np = tag->size()/FiffChPos::storageSize();
-        for (k = 0; k < np; ++k)
-        {
-            offset = (char*)tag->data() + k*FiffChPos::storageSize();
-            ithis = (fiff_int_t*) offset;
-            fthis = (float*) offset;
-
-            ithis[0] = IOUtils::swap_int(ithis[0]);    //coil_type
-            for (r = 0; r < 12; r++)
-                IOUtils::swap_floatp(&fthis[1+r]);    //r0, ex, ey, ez
-        }
+        IOUtils::swap_many((qint32 *)tag->data(), np*FiffChPos::storageSize()/sizeof(fiff_int_t));
 
         break;
 
@@ -655,19 +658,9 @@ void FiffTag::convert_tag_data(FiffTag::SPtr tag, int from_endian, int to_endian
 //                swap_floatp(&dpthis->r[r]);
 //        }
 
+        // kind, ident and r are all 32 bit words
         np = tag->size()/FiffDigPoint::storageSize();
-
-        for (k = 0; k < np; k++) {
-            offset = tag->data() + k*FiffDigPoint::storageSize();
-            ithis = (fiff_int_t*) offset;
-            fthis = (float*) offset;
-
-            ithis[0] = IOUtils::swap_int(ithis[0]);//kind
-            ithis[1] = IOUtils::swap_int(ithis[1]);//ident
-
-            for (r = 0; r < 3; ++r)
-                IOUtils::swap_floatp(&fthis[2+r]);        //r
-        }
+        IOUtils::swap_many((qint32 *)tag->data(), np*FiffDigPoint::storageSize()/sizeof(fiff_int_t));
         break;
 
     case FIFFT_COORD_TRANS_STRUCT :
@@ -685,20 +678,9 @@ void FiffTag::convert_tag_data(FiffTag::SPtr tag, int from_endian, int to_endian
 //        }
 //    }
 
+        // from, to and the 24 transformation entries are all 32 bit words
         np = tag->size()/FiffCoordTrans::storageSize();
-
-        for( k = 0; k < np; ++k)
-        {
-            offset = tag->data() + k*FiffCoordTrans::storageSize();
-            ithis = (fiff_int_t*)offset;
-            fthis = (float*)offset;
-
-            ithis[0] = IOUtils::swap_int(ithis[0]);
-            ithis[1] = IOUtils::swap_int(ithis[1]);
-
-            for (r = 0; r < 24; ++r)
-                IOUtils::swap_floatp(&fthis[2+r]);
-        }
+        IOUtils::swap_many((qint32 *)tag->data(), np*FiffCoordTrans::storageSize()/sizeof(fiff_int_t));
         break;
 
     case FIFFT_DATA_REF_STRUCT :
@@ -89,6 +89,7 @@
 #include "fiff_ch_info.h"
 #include "fiff_ch_pos.h"
 #include "fiff_dir_entry.h"
+#include "fiff_dir_entry_list.h"
 #include "fiff_tag.h"
 #include "fiff_dig_point.h"
 
@@ -371,7 +372,7 @@ public:
      *
      * @return List of directory entry descriptors.
      */
-    inline QList< QSharedPointer<FiffDirEntry> > toDirEntry() const;
+    inline FiffDirEntryList toDirEntry() const;
 
     //
     // MATRIX
@@ -404,6 +405,20 @@ public:
      */
     inline Eigen::SparseMatrix<double> toSparseFloatMatrix() const;
 
+    //=========================================================================================================
+    /**
+     * Decodes a raw data buffer (FIFFT_DAU_PACK16, FIFFT_SHORT, FIFFT_INT, FIFFT_FLOAT or FIFFT_DOUBLE) into a
+     * channels x samples double matrix. Data which is still in file byte order (see FiffStream::read_tag) is
+     * swapped while it is widened, so each sample is touched once.
+     *
+     * @param[in] nchan      number of channels in the buffer.
+     * @param[in] nsamp      number of samples in the buffer.
+     * @param[out] matData   the decoded buffer, zeros if the type is not supported.
+     *
+     * @return true if the buffer type is supported and the tag holds enough data, false otherwise.
+     */
+    bool toBufferMatrix(int nchan, int nsamp, Eigen::MatrixXd& matData) const;
+
     //
     //from fiff_combat.c
     //
@@ -507,6 +522,9 @@ public:
                              *   Zero if the object follows
                              *   sequentially in file.
                              *   Negative at the end of file */
+    fiff_int_t  endian;     /**< Byte order of the data.
+                             *   FIFFV_NATIVE_ENDIAN unless the tag was read
+                             *   without conversion. */
 //    QByteArray* data;       /**< Pointer to the data.
 //                             *   This point to the data read or to be written. */
 private:
@@ -862,24 +880,24 @@ inline FiffChInfo FiffTag::toChInfo() const
 
 //=============================================================================================================
 
-inline QList< QSharedPointer<FiffDirEntry> > FiffTag::toDirEntry() const
+inline FiffDirEntryList FiffTag::toDirEntry() const
 {
 //         tag.data = struct('kind',{},'type',{},'size',{},'pos',{});
-    QList< QSharedPointer<FiffDirEntry> > p_ListFiffDir;
+    FiffDirEntryList p_ListFiffDir;
     if(this->isMatrix() || this->getType() != FIFFT_DIR_ENTRY_STRUCT || this->data() == NULL)
         return p_ListFiffDir;
     else
     {
-        QSharedPointer<FiffDirEntry> t_pFiffDirEntry;
+        FiffDirEntry t_FiffDirEntry;
         qint32* t_pInt32 = (qint32*)this->data();
+        p_ListFiffDir.reserve(this->size()/16);
         for (int k = 0; k < this->size()/16; ++k)
         {
-            t_pFiffDirEntry = QSharedPointer<FiffDirEntry>(new FiffDirEntry);
-            t_pFiffDirEntry->kind = t_pInt32[k*4];//fread(fid,1,'int32');
-            t_pFiffDirEntry->type = t_pInt32[k*4+1];//fread(fid,1,'uint32');
-            t_pFiffDirEntry->size = t_pInt32[k*4+2];//fread(fid,1,'int32');
-            t_pFiffDirEntry->pos  = t_pInt32[k*4+3];//fread(fid,1,'int32');
-            p_ListFiffDir.append(t_pFiffDirEntry);
+            t_FiffDirEntry.kind = t_pInt32[k*4];//fread(fid,1,'int32');
+            t_FiffDirEntry.type = t_pInt32[k*4+1];//fread(fid,1,'uint32');
+            t_FiffDirEntry.size = t_pInt32[k*4+2];//fread(fid,1,'int32');
+            t_FiffDirEntry.pos  = t_pInt32[k*4+3];//fread(fid,1,'int32');
+            p_ListFiffDir.append(t_FiffDirEntry);
         }
     }
     return p_ListFiffDir;
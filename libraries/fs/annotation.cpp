@@ -42,6 +42,8 @@
 #include "label.h"
 #include "surface.h"
 
+#include <utils/ioutils.h>
+
 #include <iostream>
 
 //=============================================================================================================
@@ -58,6 +60,7 @@
 //=============================================================================================================
 
 using namespace FSLIB;
+using namespace UTILSLIB;
 using namespace Eigen;
 
 //=============================================================================================================
@@ -160,20 +163,23 @@ bool Annotation::read(const QString& p_sFileName, Annotation &p_Annotation)
         return false;
     }
 
-    QDataStream t_Stream(&t_File);
+    // Slurp the whole file and parse it from memory
+    QByteArray t_Bytes = t_File.readAll();
+    t_File.close();
+
+    QDataStream t_Stream(t_Bytes);
     t_Stream.setByteOrder(QDataStream::BigEndian);
 
     qint32 numEl;
     t_Stream >> numEl;
 
-    p_Annotation.m_Vertices = VectorXi(numEl);
-    p_Annotation.m_LabelIds = VectorXi(numEl);
+    // Vertex and label pairs are interleaved, read them as one block and split afterwards
+    MatrixXi t_matPairs(2, numEl);
+    t_Stream.readRawData((char *)t_matPairs.data(), 2*numEl*sizeof(qint32));
+    IOUtils::from_big_endian_many(t_matPairs.data(), 2*numEl);
 
-    for(qint32 i = 0; i < numEl; ++i)
-    {
-        t_Stream >> p_Annotation.m_Vertices[i];
-        t_Stream >> p_Annotation.m_LabelIds[i];
-    }
+    p_Annotation.m_Vertices = t_matPairs.row(0).transpose();
+    p_Annotation.m_LabelIds = t_matPairs.row(1).transpose();
 
     qint32 hasColortable;
     t_Stream >> hasColortable;
@@ -284,8 +290,6 @@ bool Annotation::read(const QString& p_sFileName, Annotation &p_Annotation)
 
     printf("[done]\n");
 
-    t_File.close();
-
     return true;
 }
 
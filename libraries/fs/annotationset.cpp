@@ -43,6 +43,7 @@
 
 #include <QFile>
 #include <QDebug>
+#include <QtConcurrent>
 
 //=============================================================================================================
 // USED NAMESPACES
@@ -51,6 +52,17 @@
 using namespace FSLIB;
 using namespace Eigen;
 
+//=============================================================================================================
+// DEFINE GLOBAL METHODS
+//=============================================================================================================
+
+static Annotation readAnnotationFile(const QString& p_sFileName)
+{
+    Annotation t_Annotation;
+    Annotation::read(p_sFileName, t_Annotation);
+    return t_Annotation;
+}
+
 //=============================================================================================================
 // DEFINE MEMBER METHODS
 //=============================================================================================================
@@ -71,10 +83,9 @@ AnnotationSet::AnnotationSet(const QString &subject_id, qint32 hemi, const QStri
     }
     else if(hemi == 2)
     {
-        if(Annotation::read(subject_id, 0, atlas, subjects_dir, t_Annotation))
-            insert(t_Annotation);
-        if(Annotation::read(subject_id, 1, atlas, subjects_dir, t_Annotation))
-            insert(t_Annotation);
+        AnnotationSet::read(QString("%1/%2/label/lh.%3.annot").arg(subjects_dir).arg(subject_id).arg(atlas),
+                            QString("%1/%2/label/rh.%3.annot").arg(subjects_dir).arg(subject_id).arg(atlas),
+                            *this);
     }
 }
 
@@ -90,10 +101,9 @@ AnnotationSet::AnnotationSet(const QString &path, qint32 hemi, const QString &at
     }
     else if(hemi == 2)
     {
-        if(Annotation::read(path, 0, atlas, t_Annotation))
-            insert(t_Annotation);
-        if(Annotation::read(path, 1, atlas, t_Annotation))
-            insert(t_Annotation);
+        AnnotationSet::read(QString("%1/lh.%2.annot").arg(path).arg(atlas),
+                            QString("%1/rh.%2.annot").arg(path).arg(atlas),
+                            *this);
     }
 }
 
@@ -150,15 +160,17 @@ bool AnnotationSet::read(const QString& p_sLHFileName, const QString& p_sRHFileN
     QStringList t_qListFileName;
     t_qListFileName << p_sLHFileName << p_sRHFileName;
 
+    // Both hemispheres are read concurrently
+    QList<Annotation> t_qListAnnotations = QtConcurrent::blockingMapped<QList<Annotation> >(t_qListFileName, readAnnotationFile);
+
     for(qint32 i = 0; i < t_qListFileName.size(); ++i)
     {
-        Annotation t_Annotation;
-        if(Annotation::read(t_qListFileName[i], t_Annotation))
+        if(!t_qListAnnotations[i].isEmpty())
         {
             if(t_qListFileName[i].contains("lh."))
-                p_AnnotationSet.m_qMapAnnots.insert(0, t_Annotation);
+                p_AnnotationSet.m_qMapAnnots.insert(0, t_qListAnnotations[i]);
             else if(t_qListFileName[i].contains("rh."))
-                p_AnnotationSet.m_qMapAnnots.insert(1, t_Annotation);
+                p_AnnotationSet.m_qMapAnnots.insert(1, t_qListAnnotations[i]);
             else
                 return false;
         }
@@ -169,6 +181,32 @@ bool AnnotationSet::read(const QString& p_sLHFileName, const QString& p_sRHFileN
 
 //=============================================================================================================
 
+QList<AnnotationSet> AnnotationSet::read(const QString &subject_id, const QStringList &lAtlases, const QString &subjects_dir)
+{
+    QStringList t_qListFileName;
+    for(const QString& atlas : lAtlases)
+    {
+        t_qListFileName << QString("%1/%2/label/lh.%3.annot").arg(subjects_dir).arg(subject_id).arg(atlas)
+                        << QString("%1/%2/label/rh.%3.annot").arg(subjects_dir).arg(subject_id).arg(atlas);
+    }
+
+    // Fetch all files of the subject at once, every annotation is parsed by its own worker
+    QList<Annotation> t_qListAnnotations = QtConcurrent::blockingMapped<QList<Annotation> >(t_qListFileName, readAnnotationFile);
+
+    QList<AnnotationSet> t_qListAnnotationSets;
+    for(qint32 i = 0; i < lAtlases.size(); ++i)
+    {
+        AnnotationSet t_AnnotationSet;
+        t_AnnotationSet.insert(t_qListAnnotations[2*i]);
+        t_AnnotationSet.insert(t_qListAnnotations[2*i+1]);
+        t_qListAnnotationSets.append(t_AnnotationSet);
+    }
+
+    return t_qListAnnotationSets;
+}
+
+//=============================================================================================================
+
 bool AnnotationSet::toLabels(const SurfaceSet &p_surfSet,
                              QList<Label> &p_qListLabels,
                              QList<RowVector4i> &p_qListLabelRGBAs,
@@ -51,6 +51,8 @@
 #include <QString>
 #include <QSharedPointer>
 #include <QMap>
+#include <QList>
+#include <QStringList>
 
 //=============================================================================================================
 // EIGEN INCLUDES
@@ -176,6 +178,18 @@ public:
      */
     static bool read(const QString& p_sLHFileName, const QString& p_sRHFileName, AnnotationSet &p_AnnotationSet);
 
+    //=========================================================================================================
+    /**
+     * Reads several annotations of a subject at once. All files are loaded concurrently.
+     *
+     * @param[in] subject_id         Name of subject.
+     * @param[in] lAtlases           Names of the atlases to load (eg. aparc.a2009s, aparc ...).
+     * @param[in] subjects_dir       Subjects directory.
+     *
+     * @return the annotation sets in the order of lAtlases, holding both hemispheres each.
+     */
+    static QList<AnnotationSet> read(const QString &subject_id, const QStringList &lAtlases, const QString &subjects_dir);
+
     //=========================================================================================================
     /**
      * python labels_from_parc
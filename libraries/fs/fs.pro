@@ -41,6 +41,7 @@ TEMPLATE = lib
 CONFIG += skip_target_version_ext
 
 QT -= gui
+QT += concurrent
 
 DEFINES += FS_LIBRARY
 
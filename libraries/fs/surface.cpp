@@ -231,7 +231,11 @@ bool Surface::read(const QString &p_sFile, Surface &p_Surface, bool p_bLoadCurva
     p_Surface.m_sFilePath = p_sFile.mid(0,t_NameIdx);
     p_Surface.m_sFileName = p_sFile.mid(t_NameIdx,p_sFile.size()-t_NameIdx);
 
-    QDataStream t_DataStream(&t_File);
+    // Slurp the whole file and parse it from memory, all arrays are byte swapped in one go
+    QByteArray t_Bytes = t_File.readAll();
+    t_File.close();
+
+    QDataStream t_DataStream(t_Bytes);
     t_DataStream.setByteOrder(QDataStream::BigEndian);
 
     //
@@ -262,40 +266,22 @@ bool Surface::read(const QString &p_sFile, Surface &p_Surface, bool p_bLoadCurva
             printf("\t%s is a new quad file (nvert = %d nquad = %d)\n", p_sFile.toUtf8().constData(),nvert,nquad);
 
         //vertices
-        verts.resize(nvert, 3);
         if(magic == QUAD_FILE_MAGIC_NUMBER)
         {
-            qint16 iVal;
-            for(qint32 i = 0; i < nvert; ++i)
-            {
-                for(qint32 j = 0; j < 3; ++j)
-                {
-                    t_DataStream >> iVal;
-                    IOUtils::swap_short(iVal);
-                    verts(i,j) = ((float)iVal) / 100;
-                }
-            }
+            Matrix<qint16, Dynamic, Dynamic> iVerts(3, nvert);
+            t_DataStream.readRawData((char *)iVerts.data(), nvert*3*sizeof(qint16));
+            IOUtils::from_big_endian_many(iVerts.data(), nvert*3);
+            verts = iVerts.cast<float>() / 100;
         }
         else
         {
+            verts.resize(3, nvert);
             t_DataStream.readRawData((char *)verts.data(), nvert*3*sizeof(float));
-            for(qint32 i = 0; i < nvert; ++i)
-                for(qint32 j = 0; j < 3; ++j)
-                    IOUtils::swap_floatp(&verts(i,j));
+            IOUtils::from_big_endian_many(verts.data(), nvert*3);
         }
 
-        MatrixXi quads = IOUtils::fread3_many(t_DataStream, nquad*4);
-        MatrixXi quads_new(4, nquad);
-        qint32 count = 0;
-        for(qint32 j = 0; j < quads.cols(); ++j)
-        {
-            for(qint32 i = 0; i < quads.rows(); ++i)
-            {
-                quads_new(i,j) = quads(count, 0);
-                ++count;
-            }
-        }
-        quads = quads_new.transpose();
+        VectorXi quadIdx = IOUtils::fread3_many(t_DataStream, nquad*4);
+        MatrixXi quads = Map<MatrixXi>(quadIdx.data(), 4, nquad).transpose();
         //
         //  Face splitting follows
         //
@@ -331,13 +317,11 @@ bool Surface::read(const QString &p_sFile, Surface &p_Surface, bool p_bLoadCurva
     }
     else if(magic == TRIANGLE_FILE_MAGIC_NUMBER)
     {
-        QString s = t_File.readLine();
-        t_File.readLine();
+        QString s = t_DataStream.device()->readLine();
+        t_DataStream.device()->readLine();
 
         t_DataStream >> nvert;
         t_DataStream >> nface;
-        IOUtils::swap_int(nvert);
-        IOUtils::swap_int(nface);
 
         printf("\t%s is a triangle file (nvert = %d ntri = %d)\n", p_sFile.toUtf8().constData(), nvert, nface);
         printf("\t%s", s.toUtf8().constData());
@@ -345,22 +329,13 @@ bool Surface::read(const QString &p_sFile, Surface &p_Surface, bool p_bLoadCurva
         //vertices
         verts.resize(3, nvert);
         t_DataStream.readRawData((char *)verts.data(), nvert*3*sizeof(float));
-        for(qint32 i = 0; i < 3; ++i)
-            for(qint32 j = 0; j < nvert; ++j)
-                IOUtils::swap_floatp(&verts(i,j));
+        IOUtils::from_big_endian_many(verts.data(), nvert*3);
 
         //faces
-        faces.resize(nface, 3);
-        qint32 iVal;
-        for(qint32 i = 0; i < nface; ++i)
-        {
-            for(qint32 j = 0; j < 3; ++j)
-            {
-                t_DataStream >> iVal;
-                IOUtils::swap_int(iVal);
-                faces(i,j) = iVal;
-            }
-        }
+        faces.resize(3, nface);
+        t_DataStream.readRawData((char *)faces.data(), nface*3*sizeof(qint32));
+        IOUtils::from_big_endian_many(faces.data(), nface*3);
+        faces.transposeInPlace();
     }
     else
     {
@@ -368,6 +343,12 @@ bool Surface::read(const QString &p_sFile, Surface &p_Surface, bool p_bLoadCurva
         return false;
     }
 
+    if(t_DataStream.status() != QDataStream::Ok)
+    {
+        qWarning("Surface file %s is truncated",p_sFile.toUtf8().constData());
+        return false;
+    }
+
     verts.transposeInPlace();
     verts.array() *= 0.001f;
 
@@ -399,7 +380,6 @@ bool Surface::read(const QString &p_sFile, Surface &p_Surface, bool p_bLoadCurva
         p_Surface.m_vecCurv = Surface::read_curv(t_sCurvatureFile);
     }
 
-    t_File.close();
     printf("\tRead a surface with %d vertices from %s\n[done]\n",nvert,p_sFile.toUtf8().constData());
 
     return true;
@@ -420,7 +400,11 @@ VectorXf Surface::read_curv(const QString &p_sFileName)
         return curv;
     }
 
-    QDataStream t_DataStream(&t_File);
+    // Slurp the whole file and parse it from memory
+    QByteArray t_Bytes = t_File.readAll();
+    t_File.close();
+
+    QDataStream t_DataStream(t_Bytes);
     t_DataStream.setByteOrder(QDataStream::BigEndian);
 
     qint32 vnum = IOUtils::fread3(t_DataStream);
@@ -436,23 +420,23 @@ VectorXf Surface::read_curv(const QString &p_sFileName)
 
         curv.resize(vnum, 1);
         t_DataStream.readRawData((char *)curv.data(), vnum*sizeof(float));
-        for(qint32 i = 0; i < vnum; ++i)
-           IOUtils::swap_floatp(&curv(i));
+        IOUtils::from_big_endian_many(curv.data(), vnum);
     }
     else
     {
         qint32 fnum = IOUtils::fread3(t_DataStream);
         Q_UNUSED(fnum)
-        qint16 iVal;
-        curv.resize(vnum, 1);
-        for(qint32 i = 0; i < vnum; ++i)
-        {
-            t_DataStream >> iVal;
-            IOUtils::swap_short(iVal);
-            curv(i) = ((float)iVal) / 100;
-        }
+        Matrix<qint16, Dynamic, 1> iCurv(vnum);
+        t_DataStream.readRawData((char *)iCurv.data(), vnum*sizeof(qint16));
+        IOUtils::from_big_endian_many(iCurv.data(), vnum);
+        curv = iCurv.cast<float>() / 100;
+    }
+
+    if(t_DataStream.status() != QDataStream::Ok)
+    {
+        printf("\tError: The curvature file is truncated\n");
+        return VectorXf();
     }
-    t_File.close();
 
     printf("[done]\n");
 
@@ -45,6 +45,7 @@
 //=============================================================================================================
 
 #include <QStringList>
+#include <QtConcurrent>
 
 //=============================================================================================================
 // USED NAMESPACES
@@ -53,6 +54,17 @@
 using namespace FSLIB;
 using namespace Eigen;
 
+//=============================================================================================================
+// DEFINE GLOBAL METHODS
+//=============================================================================================================
+
+static Surface readSurfaceFile(const QString& p_sFileName)
+{
+    Surface t_Surface;
+    Surface::read(p_sFileName, t_Surface);
+    return t_Surface;
+}
+
 //=============================================================================================================
 // DEFINE MEMBER METHODS
 //=============================================================================================================
@@ -73,10 +85,9 @@ SurfaceSet::SurfaceSet(const QString &subject_id, qint32 hemi, const QString &su
     }
     else if(hemi == 2)
     {
-        if(Surface::read(subject_id, 0, surf, subjects_dir, t_Surface))
-            insert(t_Surface);
-        if(Surface::read(subject_id, 1, surf, subjects_dir, t_Surface))
-            insert(t_Surface);
+        SurfaceSet::read(QString("%1/%2/surf/lh.%3").arg(subjects_dir).arg(subject_id).arg(surf),
+                         QString("%1/%2/surf/rh.%3").arg(subjects_dir).arg(subject_id).arg(surf),
+                         *this);
     }
 
     calcOffset();
@@ -94,10 +105,9 @@ SurfaceSet::SurfaceSet(const QString &path, qint32 hemi, const QString &surf)
     }
     else if(hemi == 2)
     {
-        if(Surface::read(path, 0, surf, t_Surface))
-            insert(t_Surface);
-        if(Surface::read(path, 1, surf, t_Surface))
-            insert(t_Surface);
+        SurfaceSet::read(QString("%1/lh.%2").arg(path).arg(surf),
+                         QString("%1/rh.%2").arg(path).arg(surf),
+                         *this);
     }
 
     calcOffset();
@@ -164,15 +174,17 @@ bool SurfaceSet::read(const QString& p_sLHFileName, const QString& p_sRHFileName
     QStringList t_qListFileName;
     t_qListFileName << p_sLHFileName << p_sRHFileName;
 
+    // Both hemispheres are read concurrently
+    QList<Surface> t_qListSurfaces = QtConcurrent::blockingMapped<QList<Surface> >(t_qListFileName, readSurfaceFile);
+
     for(qint32 i = 0; i < t_qListFileName.size(); ++i)
     {
-        Surface t_Surface;
-        if(Surface::read(t_qListFileName[i], t_Surface))
+        if(!t_qListSurfaces[i].isEmpty())
         {
             if(t_qListFileName[i].contains("lh."))
-                p_SurfaceSet.m_qMapSurfs.insert(0, t_Surface);
+                p_SurfaceSet.m_qMapSurfs.insert(0, t_qListSurfaces[i]);
             else if(t_qListFileName[i].contains("rh."))
-                p_SurfaceSet.m_qMapSurfs.insert(1, t_Surface);
+                p_SurfaceSet.m_qMapSurfs.insert(1, t_qListSurfaces[i]);
             else
                 return false;
         }
@@ -185,6 +197,33 @@ bool SurfaceSet::read(const QString& p_sLHFileName, const QString& p_sRHFileName
 
 //=============================================================================================================
 
+QList<SurfaceSet> SurfaceSet::read(const QString &subject_id, const QStringList &lSurfs, const QString &subjects_dir)
+{
+    QStringList t_qListFileName;
+    for(const QString& surf : lSurfs)
+    {
+        t_qListFileName << QString("%1/%2/surf/lh.%3").arg(subjects_dir).arg(subject_id).arg(surf)
+                        << QString("%1/%2/surf/rh.%3").arg(subjects_dir).arg(subject_id).arg(surf);
+    }
+
+    // Fetch all files of the subject at once, every surface is parsed by its own worker
+    QList<Surface> t_qListSurfaces = QtConcurrent::blockingMapped<QList<Surface> >(t_qListFileName, readSurfaceFile);
+
+    QList<SurfaceSet> t_qListSurfaceSets;
+    for(qint32 i = 0; i < lSurfs.size(); ++i)
+    {
+        SurfaceSet t_SurfaceSet;
+        t_SurfaceSet.insert(t_qListSurfaces[2*i]);
+        t_SurfaceSet.insert(t_qListSurfaces[2*i+1]);
+        t_SurfaceSet.calcOffset();
+        t_qListSurfaceSets.append(t_SurfaceSet);
+    }
+
+    return t_qListSurfaceSets;
+}
+
+//=============================================================================================================
+
 const Surface& SurfaceSet::operator[] (qint32 idx) const
 {
     if(idx == 0)
@@ -50,6 +50,8 @@
 
 #include <QSharedPointer>
 #include <QMap>
+#include <QList>
+#include <QStringList>
 
 //=============================================================================================================
 // DEFINE NAMESPACE FSLIB
@@ -167,6 +169,18 @@ public:
      */
     static bool read(const QString& p_sLHFileName, const QString& p_sRHFileName, SurfaceSet &p_SurfaceSet);
 
+    //=========================================================================================================
+    /**
+     * Reads several surfaces of a subject at once. All files are loaded concurrently.
+     *
+     * @param[in] subject_id         Name of subject.
+     * @param[in] lSurfs             Names of the surfaces to load (eg. inflated, orig ...).
+     * @param[in] subjects_dir       Subjects directory.
+     *
+     * @return the surface sets in the order of lSurfs, holding both hemispheres each.
+     */
+    static QList<SurfaceSet> read(const QString &subject_id, const QStringList &lSurfs, const QString &subjects_dir);
+
     //=========================================================================================================
     /**
      * The kind of Surfaces which are held by the SurfaceSet (eg. inflated, orig ...)
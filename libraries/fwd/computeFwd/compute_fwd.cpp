@@ -18,6 +18,7 @@
 #include <fiff/c/fiff_sparse_matrix.h>
 
 #include <fiff/fiff_types.h>
+#include <utils/mnetracer.h>
 
 #include <time.h>
 
@@ -1356,7 +1357,7 @@ bad :
     return FIFF_FAIL;
 }
 
-bool fiff_put_dir (FiffStream::SPtr& t_pStream, const QList<FiffDirEntry::SPtr>& dir)
+bool fiff_put_dir (FiffStream::SPtr& t_pStream, const FiffDirEntryList& dir)
 /*
  * Put in new directory
  */
@@ -1735,8 +1736,8 @@ bool mne_attach_env(const QString& name, const QString& command)
     }
 
     FiffTag::SPtr t_pTagNext;
-    QList<FiffDirEntry::SPtr> old_dir = t_pStreamInOut->dir();
-    QList<FiffDirEntry::SPtr> this_ent = old_dir.mid(where);//this_ent = old_dir + where;
+    FiffDirEntryList old_dir = t_pStreamInOut->dir();
+    FiffDirEntryList this_ent = old_dir.mid(where);//this_ent = old_dir + where;
 
     if (!t_pStreamInOut->read_tag(t_pTagNext, this_ent[0]->pos))
         return false;
@@ -1752,7 +1753,7 @@ bool mne_attach_env(const QString& name, const QString& command)
      * Allocate new directory
      * Copy the beginning of old directory
      */
-    QList<FiffDirEntry::SPtr> new_dir = old_dir.mid(0,where+1);
+    FiffDirEntryList new_dir = old_dir.mid(0,where+1);
 
     /*
      * Save the old size for future purposes
@@ -1763,42 +1764,37 @@ bool mne_attach_env(const QString& name, const QString& command)
      */
 
     //Don't use the for loop here instead do it explicitly for specific tags
-    FiffDirEntry::SPtr new_this;
+    FiffDirEntry new_this;
 
-    new_this = FiffDirEntry::SPtr(new FiffDirEntry);
-    new_this->kind = FIFF_BLOCK_START;
-    new_this->type = FIFFT_INT;
-    new_this->size = 1 * 4;
-    new_this->pos = t_pStreamInOut->start_block(FIFFB_MNE_ENV);
+    new_this.kind = FIFF_BLOCK_START;
+    new_this.type = FIFFT_INT;
+    new_this.size = 1 * 4;
+    new_this.pos = t_pStreamInOut->start_block(FIFFB_MNE_ENV);
     new_dir.append(new_this);
 
-    new_this = FiffDirEntry::SPtr(new FiffDirEntry);
-    new_this->kind = FIFF_BLOCK_ID;
-    new_this->type = FIFFT_ID_STRUCT;
-    new_this->size =  5 * 4;
-    new_this->pos = t_pStreamInOut->write_id(FIFF_BLOCK_ID,id);
+    new_this.kind = FIFF_BLOCK_ID;
+    new_this.type = FIFFT_ID_STRUCT;
+    new_this.size =  5 * 4;
+    new_this.pos = t_pStreamInOut->write_id(FIFF_BLOCK_ID,id);
     new_dir.append(new_this);
 
-    new_this = FiffDirEntry::SPtr(new FiffDirEntry);
-    new_this->kind = FIFF_MNE_ENV_WORKING_DIR;
-    new_this->type = FIFFT_STRING;
-    new_this->size =  cwd.size();
-    new_this->pos = t_pStreamInOut->write_string(FIFF_MNE_ENV_WORKING_DIR,cwd);
+    new_this.kind = FIFF_MNE_ENV_WORKING_DIR;
+    new_this.type = FIFFT_STRING;
+    new_this.size =  cwd.size();
+    new_this.pos = t_pStreamInOut->write_string(FIFF_MNE_ENV_WORKING_DIR,cwd);
     new_dir.append(new_this);
 
-    new_this = FiffDirEntry::SPtr(new FiffDirEntry);
-    new_this->kind = FIFF_MNE_ENV_COMMAND_LINE;
-    new_this->type = FIFFT_STRING;
-    new_this->size =  command.size();
-    new_this->pos = t_pStreamInOut->write_string(FIFF_MNE_ENV_COMMAND_LINE,command);
+    new_this.kind = FIFF_MNE_ENV_COMMAND_LINE;
+    new_this.type = FIFFT_STRING;
+    new_this.size =  command.size();
+    new_this.pos = t_pStreamInOut->write_string(FIFF_MNE_ENV_COMMAND_LINE,command);
     new_dir.append(new_this);
 
-    new_this = FiffDirEntry::SPtr(new FiffDirEntry);
-    new_this->kind = FIFF_BLOCK_END;
-    new_this->type = FIFFT_INT;
-    new_this->size =  1 * 4;
+    new_this.kind = FIFF_BLOCK_END;
+    new_this.type = FIFFT_INT;
+    new_this.size =  1 * 4;
 
-    new_this->pos = t_pStreamInOut->end_block(FIFFB_MNE_ENV,next_tmp);
+    new_this.pos = t_pStreamInOut->end_block(FIFFB_MNE_ENV,next_tmp);
     new_dir.append(new_this);
 
     /*
@@ -2256,6 +2252,7 @@ void ComputeFwd::initFwd()
 
 void ComputeFwd::calculateFwd()
 {
+    MNE_TRACE();
     int iNMeg = 0;
     int iNEeg = 0;
 
@@ -2292,6 +2289,7 @@ void ComputeFwd::calculateFwd()
                                               m_pSettings->compute_grad)) == FAIL) {
             return;
         }
+        storeCoilPoints();
     }
     if (iNEeg > 0) {
         if ((FwdBemModel::compute_forward_eeg(m_spaces,
@@ -2356,7 +2354,7 @@ void ComputeFwd::updateHeadPos(FiffCoordTransOld* transDevHeadOld)
 
     int iNComp = 0;
     if(m_compcoils) {
-        iNMeg = m_megcoils->ncoil;
+        iNComp = m_compcoils->ncoil;
     }
 //    // transformation in head space
 //    FiffCoordTransOld* transHeadHeadOld = new FiffCoordTransOld;
@@ -2443,20 +2441,35 @@ void ComputeFwd::updateHeadPos(FiffCoordTransOld* transDevHeadOld)
         }
     }
 
-    // recompute meg forward
-    if ((FwdBemModel::compute_forward_meg(m_spaces,
-                                          m_iNSpace,
-                                          m_megcoils,
-                                          m_compcoils,
-                                          m_compData,                   // we might have to update this too
-                                          m_pSettings->fixed_ori,
-                                          m_bemModel,
-                                          &m_pSettings->r0,
-                                          m_pSettings->use_threads,
-                                          *m_meg_forward.data(),
-                                          *m_meg_forward_grad.data(),
-                                          m_pSettings->compute_grad)) == FAIL) {
-        return;
+    // The coil rows are independent of each other unless compensation mixes them
+    bool bIncremental = m_pSettings->incremental_update
+                        && !m_pSettings->compute_grad
+                        && !(m_compData && iNComp > 0)
+                        && m_vecCoilPoints.size() == m_megcoils->ncoil
+                        && m_meg_forward->data.rows() == m_megcoils->ncoil;
+
+    if (bIncremental) {
+        // recompute the rows of the moved coils only
+        if (updateMegForward() == FAIL) {
+            return;
+        }
+    } else {
+        // recompute meg forward
+        if ((FwdBemModel::compute_forward_meg(m_spaces,
+                                              m_iNSpace,
+                                              m_megcoils,
+                                              m_compcoils,
+                                              m_compData,                   // we might have to update this too
+                                              m_pSettings->fixed_ori,
+                                              m_bemModel,
+                                              &m_pSettings->r0,
+                                              m_pSettings->use_threads,
+                                              *m_meg_forward.data(),
+                                              *m_meg_forward_grad.data(),
+                                              m_pSettings->compute_grad)) == FAIL) {
+            return;
+        }
+        storeCoilPoints();
     }
 
     // Update new Transformation Matrix
@@ -2470,6 +2483,85 @@ void ComputeFwd::updateHeadPos(FiffCoordTransOld* transDevHeadOld)
 
 //=========================================================================================================
 
+static MatrixXf coil_points(const FwdCoil* coil)
+/*
+ * Integration point locations and directions of a coil, one point per row
+ */
+{
+    MatrixXf matPoints(coil->np,6);
+    for (int p = 0; p < coil->np; p++) {
+        for (int c = 0; c < 3; c++) {
+            matPoints(p,c) = coil->rmag[p][c];
+            matPoints(p,3+c) = coil->cosmag[p][c];
+        }
+    }
+    return matPoints;
+}
+
+//=========================================================================================================
+
+int ComputeFwd::updateMegForward()
+{
+    MNE_TRACE();
+    QVector<int> vecMoved;
+
+    for (int k = 0; k < m_megcoils->ncoil; k++) {
+        MatrixXf matPoints = coil_points(m_megcoils->coils[k]);
+
+        if (matPoints.rows() != m_vecCoilPoints.at(k).rows()
+            || (matPoints - m_vecCoilPoints.at(k)).cwiseAbs().maxCoeff() > m_pSettings->incremental_tol) {
+            vecMoved.append(k);
+        }
+    }
+
+    if (vecMoved.isEmpty()) {
+        return OK;
+    }
+
+    FwdCoilSet* pMovedCoils = m_megcoils->pick_coils(vecMoved);
+    if (!pMovedCoils) {
+        return FAIL;
+    }
+
+    MatrixXd matMoved;
+    int stat = FwdBemModel::compute_forward_meg_coils(m_spaces,
+                                                      m_iNSpace,
+                                                      pMovedCoils,
+                                                      m_pSettings->fixed_ori,
+                                                      m_bemModel,
+                                                      &m_pSettings->r0,
+                                                      matMoved);
+    delete pMovedCoils;
+
+    if (stat == FAIL) {
+        return FAIL;
+    }
+
+    for (int i = 0; i < vecMoved.size(); i++) {
+        m_meg_forward->data.row(vecMoved[i]) = matMoved.row(i);
+        m_vecCoilPoints[vecMoved[i]] = coil_points(m_megcoils->coils[vecMoved[i]]);
+    }
+
+    return OK;
+}
+
+//=========================================================================================================
+
+void ComputeFwd::storeCoilPoints()
+{
+    m_vecCoilPoints.clear();
+    if (!m_megcoils) {
+        return;
+    }
+
+    m_vecCoilPoints.resize(m_megcoils->ncoil);
+    for (int k = 0; k < m_megcoils->ncoil; k++) {
+        m_vecCoilPoints[k] = coil_points(m_megcoils->coils[k]);
+    }
+}
+
+//=========================================================================================================
+
 void ComputeFwd::storeFwd(const QString& sSolName)
 {
     // We are ready to spill it out
@@ -72,6 +72,7 @@
 
 #include <QSharedPointer>
 #include <QString>
+#include <QVector>
 
 #include <QCoreApplication>
 #include <QFile>
@@ -124,7 +125,10 @@ public:
 
     //=========================================================================================================
     /**
-     * Update the heaposition with meg_head_t and recalculate the forward solution for meg
+     * Update the heaposition with meg_head_t and recalculate the forward solution for meg.
+     * If ComputeFwdSettings::incremental_update is set, only the rows of the coils which moved by more than
+     * ComputeFwdSettings::incremental_tol are recomputed. The full solution is computed whenever compensation
+     * or the gradient solution is in use.
      * @param[in] transDevHeadOld        The meg <-> head transformation to use for updating head position.
      */
     void updateHeadPos(FIFFLIB::FiffCoordTransOld* transDevHeadOld);
@@ -159,6 +163,21 @@ private:
      */
     void initFwd();
 
+    //=========================================================================================================
+    /**
+     * Recompute the MEG forward rows of the coils which moved by more than ComputeFwdSettings::incremental_tol
+     * since their rows were computed.
+     *
+     * @return   OK on success, FAIL otherwise.
+     */
+    int updateMegForward();
+
+    //=========================================================================================================
+    /**
+     * Remember the integration points of the current MEG coils as the ones the MEG forward rows belong to.
+     */
+    void storeCoilPoints();
+
     MNELIB::MneSourceSpaceOld **m_spaces;           /**< Source spaces. */
     int m_iNSpace;                                  /**< The number of source spaces. */
     int m_iNSource;                                 /**< Number of source space points. */
@@ -181,6 +200,7 @@ private:
     FIFFLIB::FiffId m_meas_id;                      /**< The Measurement ID. */
     FIFFLIB::FiffCoordTransOld* m_mri_head_t;       /**< The MRI->head coordinate transformation. */
     FIFFLIB::FiffCoordTransOld* m_meg_head_t;       /**< The MEG->head coordinate transformation. */
+    QVector<Eigen::MatrixXf> m_vecCoilPoints;       /**< Integration points (positions | directions) of each MEG coil at which its forward rows were computed. */
 
     QSharedPointer<FIFFLIB::FiffInfoBase> m_pInfoBase;
 
@@ -100,6 +100,8 @@ void ComputeFwdSettings::initMembers()
     scale_eeg_pos = false;    
     use_equiv_eeg = true;     
     use_threads = true;
+    incremental_update = false;
+    incremental_tol = 0.0001f;
 
     pFiffInfo = Q_NULLPTR;
     meg_head_t = Q_NULLPTR;
@@ -138,6 +138,8 @@ public:
     bool scale_eeg_pos;     	/**< Scale the electrode locations to scalp in the sphere model. */
     bool use_equiv_eeg;      	/**< Use the equivalent source approach for the EEG sphere model. */
     bool use_threads;        	/**< Parallelize?. */
+    bool incremental_update;    /**< Only recompute the MEG rows of coils which moved in updateHeadPos. */
+    float incremental_tol;      /**< Coil displacement (m) below which rows are kept in an incremental update. */
 
     QSharedPointer<FIFFLIB::FiffInfo> pFiffInfo;    /**< The FiffInfo file from the measurement.*/
     FIFFLIB::FiffCoordTransOld* meg_head_t;         /**< Pointer to meg <-> head transformation.*/
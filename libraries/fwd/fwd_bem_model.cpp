@@ -51,6 +51,7 @@
 #include "fwd_thread_arg.h"
 
 #include <fiff/fiff_stream.h>
+#include <utils/mnetracer.h>
 #include <fiff/fiff_named_matrix.h>
 
 #include <QFile>
@@ -1473,6 +1474,7 @@ int FwdBemModel::fwd_bem_compute_solution(FwdBemModel *m, int bem_method)
  * Compute the solution
  */
 {
+    MNE_TRACE();
     /*
         * Compute the solution
         */
@@ -1494,6 +1496,7 @@ int FwdBemModel::fwd_bem_load_recompute_solution(const QString& name, int bem_me
  * Load or recompute the potential solution matrix
  */
 {
+    MNE_TRACE();
     int solres;
 
     if (!m) {
@@ -3114,6 +3117,7 @@ int FwdBemModel::compute_forward_meg(MneSourceSpaceOld **spaces,
  * Use either the sphere model or BEM in the calculations
  */
 {
+    MNE_TRACE();
     float               **res = NULL;       /* The forward solution matrix */
     float               **res_grad = NULL;  /* The gradient with respect to the dipole position */
     MatrixXd            matRes;
@@ -3361,6 +3365,144 @@ bad : {
 
 //=============================================================================================================
 
+int FwdBemModel::compute_forward_meg_coils(MneSourceSpaceOld **spaces,
+                                           int nspace,
+                                           FwdCoilSet *coils,
+                                           bool fixed_ori,
+                                           FwdBemModel *bem_model,
+                                           Vector3f *r0,
+                                           MatrixXd& matRes)
+{
+    MNE_TRACE();
+    int nmeg = coils ? coils->ncoil : 0;
+    int k,j;
+
+    QVector<float*> vecRr;              /* Positions of the sources in use */
+    QVector<float*> vecNn;              /* Normals of the sources in use */
+    for (k = 0; k < nspace; k++) {
+        for (j = 0; j < spaces[k]->np; j++) {
+            if (spaces[k]->inuse[j]) {
+                vecRr.append(spaces[k]->rr[j]);
+                vecNn.append(spaces[k]->nn[j]);
+            }
+        }
+    }
+    int nsource = vecRr.size();
+    int nrow = fixed_ori ? nsource : 3*nsource;
+
+    matRes.resize(nmeg,nrow);
+    if (nmeg == 0 || nsource == 0) {
+        return OK;
+    }
+
+    FwdCompData* comp = NULL;
+    if (bem_model) {
+        if (fwd_bem_specify_coils(bem_model,coils) == FAIL) {
+            return FAIL;
+        }
+        comp = FwdCompData::fwd_make_comp_data(NULL,
+                                               coils,
+                                               NULL,
+                                               FwdBemModel::fwd_bem_field,
+                                               NULL,
+                                               FwdBemModel::fwd_bem_field_grad,
+                                               bem_model,
+                                               NULL);
+    } else {
+        comp = FwdCompData::fwd_make_comp_data(NULL,
+                                               coils,
+                                               NULL,
+                                               fwd_sphere_field,
+                                               fwd_sphere_field_vec,
+                                               fwd_sphere_field_grad,
+                                               r0,
+                                               NULL);
+    }
+    if (!comp) {
+        return FAIL;
+    }
+
+    FwdThreadArg one_arg;
+    one_arg.coils_els      = coils;
+    one_arg.client         = comp;
+    one_arg.fixed_ori      = fixed_ori;
+    one_arg.field_pot      = FwdCompData::fwd_comp_field;
+    one_arg.vec_field_pot  = bem_model ? NULL : FwdCompData::fwd_comp_field_vec;
+    one_arg.field_pot_grad = NULL;
+
+    float **res = ALLOC_CMATRIX_40(nrow,nmeg);
+
+    /*
+     * Split the sources into a few chunks per processor. Each chunk gets its own copy of the
+     * workspaces, the read-only parts (BEM solution, coil coefficients) are shared.
+     */
+    int nchunk = qBound(1, 4*QThread::idealThreadCount(), nsource);
+    int nper = (nsource + nchunk - 1) / nchunk;
+    QList<QPair<int,int> > lChunks;
+    QList<FwdThreadArg*> lArgs;
+    for (k = 0; k < nsource; k += nper) {
+        lChunks.append(qMakePair(k, qMin(k + nper, nsource)));
+        lArgs.append(FwdThreadArg::create_meg_multi_thread_duplicate(&one_arg,bem_model != NULL));
+    }
+
+    std::function<void(int&)> computeChunk = [&](int& iChunk) {
+        FwdThreadArg* a = lArgs[iChunk];
+        float *xyz[3];
+        a->stat = OK;
+        for (int s = lChunks[iChunk].first; s < lChunks[iChunk].second; s++) {
+            if (a->fixed_ori) {
+                if (a->field_pot(vecRr[s],vecNn[s],a->coils_els,res[s],a->client) != OK) {
+                    a->stat = FAIL;
+                    return;
+                }
+            } else if (a->vec_field_pot) {
+                xyz[0] = res[3*s];
+                xyz[1] = res[3*s+1];
+                xyz[2] = res[3*s+2];
+                if (a->vec_field_pot(vecRr[s],a->coils_els,xyz,a->client) != OK) {
+                    a->stat = FAIL;
+                    return;
+                }
+            } else {
+                if (a->field_pot(vecRr[s],Qx,a->coils_els,res[3*s],a->client) != OK ||
+                    a->field_pot(vecRr[s],Qy,a->coils_els,res[3*s+1],a->client) != OK ||
+                    a->field_pot(vecRr[s],Qz,a->coils_els,res[3*s+2],a->client) != OK) {
+                    a->stat = FAIL;
+                    return;
+                }
+            }
+        }
+    };
+
+    QVector<int> vecChunkIdx(lChunks.size());
+    for (k = 0; k < vecChunkIdx.size(); k++) {
+        vecChunkIdx[k] = k;
+    }
+    QtConcurrent::blockingMap(vecChunkIdx, computeChunk);
+
+    int stat = OK;
+    for (k = 0; k < lArgs.size(); k++) {
+        if (lArgs[k]->stat != OK) {
+            stat = FAIL;
+        }
+        FwdThreadArg::free_meg_multi_thread_duplicate(lArgs[k],bem_model != NULL);
+    }
+    delete comp;
+
+    if (stat == OK) {
+        for (int i = 0; i < nrow; i++) {
+            for (j = 0; j < nmeg; j++) {
+                matRes(j,i) = res[i][j];
+            }
+        }
+    }
+    FREE_CMATRIX_40(res);
+
+    return stat;
+}
+
+//=============================================================================================================
+
 int FwdBemModel::compute_forward_eeg(MneSourceSpaceOld **spaces,
                                      int nspace,
                                      FwdCoilSet *els,
@@ -3376,6 +3518,7 @@ int FwdBemModel::compute_forward_eeg(MneSourceSpaceOld **spaces,
      * Use either the sphere model or BEM in the calculations
      */
 {
+    MNE_TRACE();
     float            **res = NULL;          /* The forward solution matrix */
     float            **res_grad = NULL;     /* The gradient with respect to the dipole position */
     MatrixXd matRes;
@@ -448,6 +448,30 @@ public:
                                     FIFFLIB::FiffNamedMatrix&   resp_grad,
                                     bool bDoGRad);                              /**< calculate gradient solution. */
 
+    //=========================================================================================================
+    /**
+     * Compute the uncompensated MEG forward solution for a (sub)set of coils only. This is used to refresh
+     * the rows of coils which moved with the head, while the source space and the BEM stay as they are.
+     * The sources are split into chunks which are evaluated in parallel, each with its own workspace.
+     *
+     * @param[in] spaces         The source spaces.
+     * @param[in] nspace         The number of source spaces.
+     * @param[in] coils          The MEG coils to compute the solution for.
+     * @param[in] fixed_ori      Use fixed-orientation dipoles.
+     * @param[in] bem_model      The BEM model definition, NULL for the sphere model.
+     * @param[in] r0             The sphere model origin.
+     * @param[out] matRes        The result, one row per coil and one column per source (component).
+     *
+     * @return   OK on success, FAIL otherwise.
+     */
+    static int compute_forward_meg_coils(MNELIB::MneSourceSpaceOld*  *spaces,
+                                         int                         nspace,
+                                         FwdCoilSet*                 coils,
+                                         bool                        fixed_ori,
+                                         FwdBemModel*                bem_model,
+                                         Eigen::Vector3f*            r0,
+                                         Eigen::MatrixXd&            matRes);
+
     static int compute_forward_eeg( MNELIB::MneSourceSpaceOld*  *spaces,        /**< Source spaces. */
                                     int                         nspace,         /**< How many?. */
                                     FwdCoilSet*                 els,            /**< Electrode locations. */
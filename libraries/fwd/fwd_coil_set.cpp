@@ -546,6 +546,28 @@ FwdCoilSet* FwdCoilSet::dup_coil_set(const FiffCoordTransOld* t) const
 
 //=============================================================================================================
 
+FwdCoilSet* FwdCoilSet::pick_coils(const QVector<int>& vecSel) const
+{
+    for (int k = 0; k < vecSel.size(); k++) {
+        if (vecSel[k] < 0 || vecSel[k] >= this->ncoil) {
+            qWarning("Coil index %d out of range in FwdCoilSet::pick_coils", vecSel[k]);
+            return NULL;
+        }
+    }
+
+    FwdCoilSet* res = new FwdCoilSet();
+    res->coord_frame = this->coord_frame;
+    res->coils = MALLOC_6(vecSel.size(),FwdCoil*);
+    res->ncoil = vecSel.size();
+
+    for (int k = 0; k < vecSel.size(); k++) {
+        res->coils[k] = new FwdCoil(*(this->coils[vecSel[k]]));
+    }
+    return res;
+}
+
+//=============================================================================================================
+
 bool FwdCoilSet::is_planar_coil_type(int type) const
 {
     if (type == FIFFV_COIL_EEG)
@@ -56,6 +56,7 @@
 //=============================================================================================================
 
 #include <QSharedPointer>
+#include <QVector>
 
 typedef void (*fwdUserFreeFunc)(void *);  /* General purpose */
 
@@ -177,6 +178,17 @@ public:
      */
     FwdCoilSet* dup_coil_set(const FIFFLIB::FiffCoordTransOld* t) const;
 
+    //=========================================================================================================
+    /**
+     * Make a duplicate which contains only a subset of the coils. The coil-specific user data (e.g. the BEM
+     * field coefficients) is not copied.
+     *
+     * @param[in] vecSel     Indices of the coils to pick, in the order they should appear in the new set.
+     *
+     * @return   The new coil set or NULL if an index is out of range.
+     */
+    FwdCoilSet* pick_coils(const QVector<int>& vecSel) const;
+
     //=========================================================================================================
     /**
      * Checks if a set of templates contains a planar coil of a specified type.
@@ -364,7 +364,7 @@ static QString get_comment (  FiffStream::SPtr& stream,
 {
     int k;
     FiffTag::SPtr t_pTag;
-    QList<FiffDirEntry::SPtr> ent = start->dir;
+    const FiffDirEntryList& ent = start->dir;
     for (k = 0; k < start->nent(); k++)
         if (ent[k]->kind == FIFF_COMMENT) {
             if (stream->read_tag(t_pTag,ent[k]->pos)) {
@@ -381,7 +381,7 @@ static void get_aspect_name_type(   FiffStream::SPtr& stream,
 {
     int k;
     FiffTag::SPtr t_pTag;
-    QList<FiffDirEntry::SPtr> ent = start->dir;
+    const FiffDirEntryList& ent = start->dir;
     QString res = "unknown";
     int  type = -1;
 
@@ -0,0 +1,350 @@
+//=============================================================================================================
+/**
+ * @file     hpifitcontinuous.cpp
+ * @author   agent <agent@local>
+ * @since    0.1.9
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, agent. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    HPIFitContinuous class definition.
+ *
+ */
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include "hpifitcontinuous.h"
+#include "hpifit.h"
+
+#include <fiff/fiff_info.h>
+#include <fiff/fiff_raw_data.h>
+#include <fiff/fiff_coord_trans.h>
+#include <fiff/fiff_dig_point_set.h>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+//=============================================================================================================
+// EIGEN INCLUDES
+//=============================================================================================================
+
+#include <Eigen/Geometry>
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QDebug>
+#include <QFile>
+#include <QTextStream>
+#include <QThreadPool>
+#include <QtConcurrent/QtConcurrent>
+
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace Eigen;
+using namespace INVERSELIB;
+using namespace FIFFLIB;
+
+//=============================================================================================================
+// DEFINE GLOBAL METHODS
+//=============================================================================================================
+
+namespace {
+
+//=============================================================================================================
+/**
+ * Consecutive windows which are fitted one after another by the same HPIFit.
+ */
+struct HpiFitRun {
+    HPIFit*                     pHpiFit;            /**< The fit object of this run, not shared with other runs. */
+    QSharedPointer<FiffInfo>    pFiffInfo;          /**< Associated Fiff Information. */
+    const MatrixXd*             pMatData;           /**< The data of the current chunk. */
+    fiff_int_t                  iDataFirst;         /**< The first sample held by pMatData. */
+    const QVector<fiff_int_t>*  pVecFrom;           /**< The first sample of each window. */
+    const QVector<fiff_int_t>*  pVecTo;             /**< The last sample of each window. */
+    const RowVectorXf*          pVecTimes;          /**< The time of each window. */
+    const QVector<int>*         pVecFreqs;          /**< The coil frequencies. */
+    const MatrixXd*             pMatProjectors;     /**< The projectors to apply. */
+    int                         iBegin;             /**< The first window of this run. */
+    int                         iEnd;               /**< The end of this run, exclusive. */
+    int                         iMaxIterations;     /**< The maximum number of dipole fit iterations. */
+    float                       fAbortError;        /**< The dipole fit abort error. */
+    FiffCoordTrans              transDevHead;       /**< The seed on start, the last fit result afterwards. */
+    QVector<double>             vecError;           /**< The coil errors belonging to transDevHead. */
+    MatrixXd*                   pMatPosition;       /**< The output, every run writes its own rows only. */
+};
+
+//=============================================================================================================
+
+void fitRun(HpiFitRun* pRun)
+{
+    VectorXd vecGoF;
+    FiffDigPointSet fittedPointSet;
+
+    for(int k = pRun->iBegin; k < pRun->iEnd; ++k) {
+        const fiff_int_t from = pRun->pVecFrom->at(k);
+        const fiff_int_t to = pRun->pVecTo->at(k);
+        const MatrixXd matData = pRun->pMatData->middleCols(from - pRun->iDataFirst, to - from + 1);
+
+        // transDevHead and vecError still hold the result of the previous window and serve as seed
+        pRun->pHpiFit->fitHPI(matData,
+                              *pRun->pMatProjectors,
+                              pRun->transDevHead,
+                              *pRun->pVecFreqs,
+                              pRun->vecError,
+                              vecGoF,
+                              fittedPointSet,
+                              pRun->pFiffInfo,
+                              false,
+                              QString("./HPIFittingDebug"),
+                              pRun->iMaxIterations,
+                              pRun->fAbortError);
+
+        // same layout as HPIFit::storeHeadPosition, without growing the matrix for each window
+        const Matrix3f matRot = pRun->transDevHead.trans.block(0,0,3,3);
+        const Quaternionf quatHPI(matRot);
+        MatrixXd& matPosition = *pRun->pMatPosition;
+
+        matPosition(k,0) = (*pRun->pVecTimes)(k);
+        matPosition(k,1) = quatHPI.x();
+        matPosition(k,2) = quatHPI.y();
+        matPosition(k,3) = quatHPI.z();
+        matPosition(k,4) = pRun->transDevHead.trans(0,3);
+        matPosition(k,5) = pRun->transDevHead.trans(1,3);
+        matPosition(k,6) = pRun->transDevHead.trans(2,3);
+        matPosition(k,7) = vecGoF.size() > 0 ? vecGoF.mean() : 0.0;
+        matPosition(k,8) = pRun->vecError.isEmpty() ? 0.0 : std::accumulate(pRun->vecError.begin(), pRun->vecError.end(), .0) / pRun->vecError.size();
+    }
+}
+
+} // namespace
+
+//=============================================================================================================
+// DEFINE MEMBER METHODS
+//=============================================================================================================
+
+HPIFitContinuous::HPIFitContinuous(QSharedPointer<FiffInfo> pFiffInfo,
+                                   bool bDoFastFit)
+: m_pFiffInfo(pFiffInfo)
+, m_bDoFastFit(bDoFastFit)
+, m_fWindowSec(0.2f)
+, m_fStepSec(0.1f)
+, m_iNumThreads(std::max(1, QThread::idealThreadCount()))
+, m_iWindowsPerRun(20)
+, m_iMaxIterations(500)
+, m_fAbortError(1e-9f)
+{
+}
+
+//=============================================================================================================
+
+void HPIFitContinuous::setWindow(float fWindowSec,
+                                 float fStepSec)
+{
+    m_fWindowSec = fWindowSec;
+    m_fStepSec = fStepSec;
+}
+
+//=============================================================================================================
+
+void HPIFitContinuous::setParallelization(int iNumThreads,
+                                          int iWindowsPerRun)
+{
+    m_iNumThreads = std::max(1, iNumThreads);
+    m_iWindowsPerRun = std::max(1, iWindowsPerRun);
+}
+
+//=============================================================================================================
+
+void HPIFitContinuous::setAbortCriteria(int iMaxIterations,
+                                        float fAbortError)
+{
+    m_iMaxIterations = iMaxIterations;
+    m_fAbortError = fAbortError;
+}
+
+//=============================================================================================================
+
+MatrixXd HPIFitContinuous::fit(const FiffRawData& raw,
+                               const QVector<int>& vecFreqs,
+                               const MatrixXd& matProjectors,
+                               const RowVectorXf& vecTimes) const
+{
+    const fiff_int_t first = raw.first_samp;
+    const fiff_int_t last = raw.last_samp;
+    const fiff_int_t iWindowSamples = ceil(m_fWindowSec * m_pFiffInfo->sfreq);
+
+    // create time vector that specifies when to fit
+    RowVectorXf vecFitTimes = vecTimes;
+
+    if(vecFitTimes.size() == 0) {
+        const int iStepSamples = floor(m_fStepSec * m_pFiffInfo->sfreq);
+        const int iNumSteps = iStepSamples > 0 ? (last - first) / iStepSamples : 0;
+        vecFitTimes = RowVectorXf::LinSpaced(iNumSteps, 0, iNumSteps - 1) * m_fStepSec;
+    }
+
+    // windows are read as in ex_hpiFit, i.e. from the window start up to and including from + iWindowSamples
+    QVector<fiff_int_t> vecFrom;
+    QVector<fiff_int_t> vecTo;
+
+    for(int k = 0; k < vecFitTimes.size(); ++k) {
+        const fiff_int_t from = first + vecFitTimes(k) * m_pFiffInfo->sfreq;
+        if(from > last) {
+            break;
+        }
+        vecFrom.append(from);
+        vecTo.append(std::min(from + iWindowSamples, last));
+    }
+
+    const int iNumWindows = vecFrom.size();
+
+    if(iNumWindows == 0) {
+        qWarning() << "HPIFitContinuous::fit - No windows to fit. Returning.";
+        return MatrixXd();
+    }
+
+    // one fit object per run slot, a run slot is never used by two threads at the same time
+    QVector<QSharedPointer<HPIFit> > vecHpiFits;
+    for(int i = 0; i < m_iNumThreads; ++i) {
+        vecHpiFits.append(QSharedPointer<HPIFit>(new HPIFit(m_pFiffInfo, m_bDoFastFit)));
+    }
+
+    // use a separate pool, HPIFit::dipfit distributes the coils on the global pool
+    QThreadPool threadPool;
+    threadPool.setMaxThreadCount(m_iNumThreads);
+
+    MatrixXd matPosition = MatrixXd::Zero(iNumWindows, 10);
+    MatrixXd matData[2];
+    MatrixXd matTimes;
+
+    const int iWindowsPerChunk = m_iNumThreads * m_iWindowsPerRun;
+    const int iNumChunks = (iNumWindows + iWindowsPerChunk - 1) / iWindowsPerChunk;
+    int iNumFitted = 0;
+
+    FiffCoordTrans transSeed = m_pFiffInfo->dev_head_t;
+    QVector<double> vecErrorSeed;
+
+    if(!raw.read_raw_segment(matData[0], matTimes, vecFrom.first(), vecTo.at(std::min(iWindowsPerChunk, iNumWindows) - 1))) {
+        qWarning() << "HPIFitContinuous::fit - Error during read_raw_segment. Returning.";
+        return MatrixXd();
+    }
+
+    for(int c = 0; c < iNumChunks; ++c) {
+        const int iChunkBegin = c * iWindowsPerChunk;
+        const int iChunkEnd = std::min(iChunkBegin + iWindowsPerChunk, iNumWindows);
+
+        // every run starts from the last result of the previous chunk
+        QVector<HpiFitRun> vecRuns;
+        for(int iBegin = iChunkBegin; iBegin < iChunkEnd; iBegin += m_iWindowsPerRun) {
+            HpiFitRun run;
+            run.pHpiFit = vecHpiFits.at(vecRuns.size()).data();
+            run.pFiffInfo = m_pFiffInfo;
+            run.pMatData = &matData[c % 2];
+            run.iDataFirst = vecFrom.at(iChunkBegin);
+            run.pVecFrom = &vecFrom;
+            run.pVecTo = &vecTo;
+            run.pVecTimes = &vecFitTimes;
+            run.pVecFreqs = &vecFreqs;
+            run.pMatProjectors = &matProjectors;
+            run.iBegin = iBegin;
+            run.iEnd = std::min(iBegin + m_iWindowsPerRun, iChunkEnd);
+            run.iMaxIterations = m_iMaxIterations;
+            run.fAbortError = m_fAbortError;
+            run.transDevHead = transSeed;
+            run.vecError = vecErrorSeed;
+            run.pMatPosition = &matPosition;
+            vecRuns.append(run);
+        }
+
+        QVector<QFuture<void> > vecFutures;
+        for(int i = 0; i < vecRuns.size(); ++i) {
+            vecFutures.append(QtConcurrent::run(&threadPool, fitRun, &vecRuns[i]));
+        }
+
+        // read the next chunk while the current one is being fitted
+        bool bReadNext = true;
+        if(c + 1 < iNumChunks) {
+            const int iNextBegin = iChunkEnd;
+            const int iNextEnd = std::min(iNextBegin + iWindowsPerChunk, iNumWindows);
+            bReadNext = raw.read_raw_segment(matData[(c + 1) % 2], matTimes, vecFrom.at(iNextBegin), vecTo.at(iNextEnd - 1));
+        }
+
+        for(QFuture<void>& future : vecFutures) {
+            future.waitForFinished();
+        }
+
+        iNumFitted = iChunkEnd;
+        transSeed = vecRuns.last().transDevHead;
+        vecErrorSeed = vecRuns.last().vecError;
+
+        if(!bReadNext) {
+            qWarning() << "HPIFitContinuous::fit - Error during read_raw_segment. Stopping after" << iNumFitted << "windows.";
+            break;
+        }
+    }
+
+    matPosition.conservativeResize(iNumFitted, 10);
+
+    // translation velocity between consecutive fits
+    for(int k = 1; k < matPosition.rows(); ++k) {
+        const double dDeltaTime = matPosition(k,0) - matPosition(k-1,0);
+        if(dDeltaTime > 0.0) {
+            matPosition(k,9) = (matPosition.block(k,4,1,3) - matPosition.block(k-1,4,1,3)).norm() / dDeltaTime;
+        }
+    }
+
+    return matPosition;
+}
+
+//=============================================================================================================
+
+bool HPIFitContinuous::writePositions(const MatrixXd& matPosition,
+                                      const QString& sPath)
+{
+    QFile file(sPath);
+    if(!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+        qWarning() << "HPIFitContinuous::writePositions - Could not open" << sPath;
+        return false;
+    }
+
+    // the header is commented out so the file can be read back with IOUtils::read_eigen_matrix
+    QTextStream stream(&file);
+    stream << "# Time q1 q2 q3 q4 q5 q6 g-value error velocity\n";
+
+    for(int row = 0; row < matPosition.rows(); ++row) {
+        stream << QString::number(matPosition(row,0), 'f', 3);
+        for(int col = 1; col < matPosition.cols(); ++col) {
+            stream << " " << QString::number(matPosition(row,col), 'f', 6);
+        }
+        stream << "\n";
+    }
+
+    return true;
+}
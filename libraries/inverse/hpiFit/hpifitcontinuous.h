@@ -0,0 +1,180 @@
+//=============================================================================================================
+/**
+ * @file     hpifitcontinuous.h
+ * @author   agent <agent@local>
+ * @since    0.1.9
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, agent. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    HPIFitContinuous class declaration.
+ *
+ */
+
+
+#ifndef HPIFITCONTINUOUS_H
+#define HPIFITCONTINUOUS_H
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include "../inverse_global.h"
+
+//=============================================================================================================
+// EIGEN INCLUDES
+//=============================================================================================================
+
+#include <Eigen/Core>
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QSharedPointer>
+#include <QVector>
+
+//=============================================================================================================
+// FORWARD DECLARATIONS
+//=============================================================================================================
+
+namespace FIFFLIB{
+    class FiffInfo;
+    class FiffRawData;
+}
+
+//=============================================================================================================
+// DEFINE NAMESPACE INVERSELIB
+//=============================================================================================================
+
+namespace INVERSELIB
+{
+
+//=============================================================================================================
+// INVERSELIB FORWARD DECLARATIONS
+//=============================================================================================================
+
+//=============================================================================================================
+/**
+ * Estimates the continuous head position of a whole recording. The raw file is read once in chunks. The windows
+ * of a chunk are split into runs of consecutive windows which are fitted in parallel, each run with its own HPIFit.
+ * Inside a run every fit is seeded with the result of the previous window, the first window of a run with the last
+ * result of the previous chunk. The next chunk is read while the current one is being fitted.
+ *
+ * @brief Offline continuous HPI fitting.
+ */
+class INVERSESHARED_EXPORT HPIFitContinuous
+{
+
+public:
+    typedef QSharedPointer<HPIFitContinuous> SPtr;             /**< Shared pointer type for HPIFitContinuous. */
+    typedef QSharedPointer<const HPIFitContinuous> ConstSPtr;  /**< Const shared pointer type for HPIFitContinuous. */
+
+    //=========================================================================================================
+    /**
+     * Default constructor.
+     *
+     * @param[in] pFiffInfo        Associated Fiff Information. The digitizers and dev_head_t are used as initial guess.
+     * @param[in] bDoFastFit       Do the fast fit by fitting to the more basic Model.
+     */
+    explicit HPIFitContinuous(QSharedPointer<FIFFLIB::FiffInfo> pFiffInfo,
+                              bool bDoFastFit = false);
+
+    //=========================================================================================================
+    /**
+     * Sets the window length and the time between two consecutive fits.
+     *
+     * @param[in] fWindowSec       The length of the data window used for each fit in seconds. Default is 0.2.
+     * @param[in] fStepSec         The time between two fits in seconds. Default is 0.1.
+     */
+    void setWindow(float fWindowSec,
+                   float fStepSec);
+
+    //=========================================================================================================
+    /**
+     * Sets how the windows are distributed on the cores.
+     *
+     * @param[in] iNumThreads          The number of runs fitted in parallel. Default is QThread::idealThreadCount().
+     * @param[in] iWindowsPerRun       The number of consecutive windows fitted by one run. Default is 20.
+     */
+    void setParallelization(int iNumThreads,
+                            int iWindowsPerRun);
+
+    //=========================================================================================================
+    /**
+     * Sets the abort criteria of the dipole fits.
+     *
+     * @param[in] iMaxIterations       The maximum allowed number of iterations used to fit the dipoles. Default is 500.
+     * @param[in] fAbortError          The error which will lead to aborting the dipole fitting process. Default is 1e-9.
+     */
+    void setAbortCriteria(int iMaxIterations,
+                          float fAbortError);
+
+    //=========================================================================================================
+    /**
+     * Fits the head position for all windows of the recording.
+     *
+     * @param[in] raw              The raw data to fit.
+     * @param[in] vecFreqs         The frequencies for each coil in correct order (see HPIFit::findOrder).
+     * @param[in] matProjectors    The projectors to apply. Bad channels are still included.
+     * @param[in] vecTimes         The ascending window start times in seconds relative to the first sample. If empty,
+     *                             the whole recording is covered with the step set by setWindow.
+     *
+     * @return The head positions, one row per window in the MaxFilter format (see HPIFit::storeHeadPosition).
+     *         The last column holds the translation velocity in m/s.
+     */
+    Eigen::MatrixXd fit(const FIFFLIB::FiffRawData& raw,
+                        const QVector<int>& vecFreqs,
+                        const Eigen::MatrixXd& matProjectors,
+                        const Eigen::RowVectorXf& vecTimes = Eigen::RowVectorXf()) const;
+
+    //=========================================================================================================
+    /**
+     * Writes head positions in the MaxFilter .pos text format.
+     *
+     * @param[in] matPosition      The head positions as returned by fit.
+     * @param[in] sPath            The path and file name to write to.
+     *
+     * @return true if succeeded, false otherwise.
+     */
+    static bool writePositions(const Eigen::MatrixXd& matPosition,
+                               const QString& sPath);
+
+private:
+    QSharedPointer<FIFFLIB::FiffInfo>   m_pFiffInfo;        /**< Associated Fiff Information. */
+    bool                                m_bDoFastFit;       /**< Do fast fit. */
+    float                               m_fWindowSec;       /**< The window length in seconds. */
+    float                               m_fStepSec;         /**< The time between two fits in seconds. */
+    int                                 m_iNumThreads;      /**< The number of runs fitted in parallel. */
+    int                                 m_iWindowsPerRun;   /**< The number of consecutive windows per run. */
+    int                                 m_iMaxIterations;   /**< The maximum number of dipole fit iterations. */
+    float                               m_fAbortError;      /**< The dipole fit abort error. */
+};
+
+//=============================================================================================================
+// INLINE DEFINITIONS
+//=============================================================================================================
+} //NAMESPACE
+
+#endif // HPIFITCONTINUOUS_H
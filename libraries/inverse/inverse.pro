@@ -91,7 +91,8 @@ SOURCES += \
     c/mne_meas_data.cpp \
     c/mne_meas_data_set.cpp \
     hpiFit/hpifit.cpp \
-    hpiFit/hpifitdata.cpp
+    hpiFit/hpifitdata.cpp \
+    hpiFit/hpifitcontinuous.cpp
 
 HEADERS +=\
     inverse_global.h \
@@ -112,7 +113,8 @@ HEADERS +=\
     c/mne_meas_data.h \
     c/mne_meas_data_set.h \
     hpiFit/hpifit.h \
-    hpiFit/hpifitdata.h
+    hpiFit/hpifitdata.h \
+    hpiFit/hpifitcontinuous.h
 
 INCLUDEPATH += $${EIGEN_INCLUDE_DIR}
 INCLUDEPATH += $${MNE_INCLUDE_DIR}
@@ -42,6 +42,7 @@
 
 #include <mne/mne_sourceestimate.h>
 #include <fiff/fiff_evoked.h>
+#include <utils/mnetracer.h>
 
 #include <iostream>
 
@@ -87,6 +88,7 @@ MinimumNorm::MinimumNorm(const MNEInverseOperator &p_inverseOperator, float lamb
 
 MNESourceEstimate MinimumNorm::calculateInverse(const FiffEvoked &p_fiffEvoked, bool pick_normal)
 {
+    MNE_TRACE();
     //
     //   Set up the inverse according to the parameters
     //
@@ -182,6 +184,7 @@ MNESourceEstimate MinimumNorm::calculateInverse(const FiffEvoked &p_fiffEvoked,
 
 MNESourceEstimate MinimumNorm::calculateInverse(const MatrixXd &data, float tmin, float tstep, bool pick_normal) const
 {
+    MNE_TRACE();
     if(!inverseSetup)
     {
         qWarning("MinimumNorm::calculateInverse - Inverse not setup -> call doInverseSetup first!");
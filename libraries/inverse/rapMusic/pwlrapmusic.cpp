@@ -171,13 +171,14 @@ MNESourceEstimate PwlRapMusic::calculateInverse(const MatrixXd& p_matMeasurement
     MatrixXT t_matProj_Phi_s(t_matOrthProj.rows(), t_pMatPhi_s->cols());
     //new Version: Calculate projection before
     MatrixXT t_matProj_LeadField(m_ForwardSolution.sol->data.rows(), m_ForwardSolution.sol->data.cols());
+    SourceBases t_sourceBases;
 
     for(int r = 0; r < t_iMaxSearch ; ++r)
     {
         t_matProj_Phi_s = t_matOrthProj*(*t_pMatPhi_s);
 
-        //new Version: Calculating Projection before
-        t_matProj_LeadField = t_matOrthProj * m_ForwardSolution.sol->data;//Subtract the found sources from the current found source
+        //new Version: Calculating Projection before - as low rank update, Pi_k_1 has rank r only
+        calcProjLeadField(t_matA_k_1, m_ForwardSolution.sol->data, t_matProj_LeadField);//Subtract the found sources from the current found source
 
         //###First Option###
         //Step 1: lt. Mosher 1998 -> Maybe tmp_Proj_Phi_S is already orthogonal -> so no SVD needed -> U_B = tmp_Proj_Phi_S;
@@ -185,6 +186,9 @@ MNESourceEstimate PwlRapMusic::calculateInverse(const MatrixXd& p_matMeasurement
         MatrixXT t_matU_B;
         useFullRank(t_svdProj_Phi_S.matrixU(), t_svdProj_Phi_S.singularValues().asDiagonal(), t_matU_B);
 
+        //Per source bases, shared by all pairs
+        calcSourceBases(t_matProj_LeadField, t_matU_B, t_sourceBases);
+
         //Inits
         VectorXT t_vecRoh(m_iNumLeadFieldCombinations,1);
         t_vecRoh.setZero();
@@ -226,16 +230,11 @@ MNESourceEstimate PwlRapMusic::calculateInverse(const MatrixXd& p_matMeasurement
                 for(int i = 0; i < t_iNumVecElements; i++)
                 {
                     int k = t_pVecIdxElements(i);
-                    //new Version: calculate matrix multiplication before
-                    //Create Lead Field combinations -> It would be better to use a pointer construction, to increase performance
-                    MatrixX6T t_matProj_G(t_matProj_LeadField.rows(),6);
 
                     int idx1 = m_ppPairIdxCombinations[k]->x1;
                     int idx2 = m_ppPairIdxCombinations[k]->x2;
 
-                    RapMusic::getGainMatrixPair(t_matProj_LeadField, t_matProj_G, idx1, idx2);
-
-                    t_vecRoh(k) = RapMusic::subcorr(t_matProj_G, t_matU_B);//t_vecRoh holds the correlations roh_k
+                    t_vecRoh(k) = RapMusic::subcorr(t_sourceBases, idx1, idx2);//t_vecRoh holds the correlations roh_k
                 }
             }
 
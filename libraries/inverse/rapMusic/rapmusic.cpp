@@ -41,6 +41,9 @@
 
 #include <utils/mnemath.h>
 
+#include <algorithm>
+#include <vector>
+
 #ifdef _OPENMP
 #include <omp.h>
 #endif
@@ -67,6 +70,7 @@ RapMusic::RapMusic()
 , m_ppPairIdxCombinations(NULL)
 , m_iMaxNumThreads(1)
 , m_bIsInit(false)
+, m_iNumPreScreenSources(0)
 , m_iSamplesStcWindow(-1)
 , m_fStcOverlap(-1)
 {
@@ -83,6 +87,7 @@ RapMusic::RapMusic(MNEForwardSolution& p_pFwd, bool p_bSparsed, int p_iN, double
 , m_ppPairIdxCombinations(NULL)
 , m_iMaxNumThreads(1)
 , m_bIsInit(false)
+, m_iNumPreScreenSources(0)
 , m_iSamplesStcWindow(-1)
 , m_fStcOverlap(-1)
 {
@@ -445,13 +450,14 @@ MNESourceEstimate RapMusic::calculateInverse(const MatrixXd& p_matMeasurement, Q
     MatrixXT t_matProj_Phi_s(t_matOrthProj.rows(), t_pMatPhi_s->cols());
     //new Version: Calculate projection before
     MatrixXT t_matProj_LeadField(m_ForwardSolution.sol->data.rows(), m_ForwardSolution.sol->data.cols());
+    SourceBases t_sourceBases;
 
     for(int r = 0; r < t_iMaxSearch ; ++r)
     {
         t_matProj_Phi_s = t_matOrthProj*(*t_pMatPhi_s);
 
-        //new Version: Calculating Projection before
-        t_matProj_LeadField = t_matOrthProj * m_ForwardSolution.sol->data;//Subtract the found sources from the current found source
+        //new Version: Calculating Projection before - as low rank update, Pi_k_1 has rank r only
+        calcProjLeadField(t_matA_k_1, m_ForwardSolution.sol->data, t_matProj_LeadField);//Subtract the found sources from the current found source
 
         //###First Option###
         //Step 1: lt. Mosher 1998 -> Maybe tmp_Proj_Phi_S is already orthogonal -> so no SVD needed -> U_B = tmp_Proj_Phi_S;
@@ -459,6 +465,10 @@ MNESourceEstimate RapMusic::calculateInverse(const MatrixXd& p_matMeasurement, Q
         MatrixXT t_matU_B;
         useFullRank(t_svdProj_Phi_S.matrixU(), t_svdProj_Phi_S.singularValues().asDiagonal(), t_matU_B);
 
+        //Per source bases, shared by all pairs
+        calcSourceBases(t_matProj_LeadField, t_matU_B, t_sourceBases);
+        QVector<bool> t_vecScanSource = preScreenSources(t_sourceBases);
+
         //Inits
         VectorXT t_vecRoh(m_iNumLeadFieldCombinations,1);
         t_vecRoh.setZero();
@@ -474,20 +484,18 @@ MNESourceEstimate RapMusic::calculateInverse(const MatrixXd& p_matMeasurement, Q
         #endif
         {
         #ifdef _OPENMP
-        #pragma omp for
+        #pragma omp for schedule(static)
         #endif
             for(int i = 0; i < m_iNumLeadFieldCombinations; i++)
             {
-                //new Version: calculate matrix multiplication before
-                //Create Lead Field combinations -> It would be better to use a pointer construction, to increase performance
-                MatrixX6T t_matProj_G(t_matProj_LeadField.rows(),6);
-
                 int idx1 = m_ppPairIdxCombinations[i]->x1;
                 int idx2 = m_ppPairIdxCombinations[i]->x2;
 
-                RapMusic::getGainMatrixPair(t_matProj_LeadField, t_matProj_G, idx1, idx2);
+                if(!t_vecScanSource.isEmpty() && !t_vecScanSource.at(idx1) && !t_vecScanSource.at(idx2)) {
+                    continue;
+                }
 
-                t_vecRoh(i) = RapMusic::subcorr(t_matProj_G, t_matU_B);//t_vecRoh holds the correlations roh_k
+                t_vecRoh(i) = RapMusic::subcorr(t_sourceBases, idx1, idx2);//t_vecRoh holds the correlations roh_k
             }
         }
 
@@ -737,6 +745,158 @@ double RapMusic::subcorr(MatrixX6T& p_matProj_G, const MatrixXT& p_matU_B, Vecto
 
 //=============================================================================================================
 
+void RapMusic::calcSourceBases(const MatrixXT& p_matProj_LeadField,
+                               const MatrixXT& p_matU_B,
+                               SourceBases& p_sourceBases) const
+{
+    int t_iNumSources = p_matProj_LeadField.cols()/3;
+
+    p_sourceBases.matQ.resize(p_matProj_LeadField.rows(), p_matProj_LeadField.cols());
+    p_sourceBases.matR.resize(3, p_matProj_LeadField.cols());
+    p_sourceBases.matSS.resize(3, p_matProj_LeadField.cols());
+
+    //S_i = (P*G_i)^T*U_B for all sources at once
+    p_sourceBases.matS = p_matProj_LeadField.transpose() * p_matU_B;
+
+    #ifdef _OPENMP
+    #pragma omp parallel for num_threads(m_iMaxNumThreads)
+    #endif
+    for(int i = 0; i < t_iNumSources; ++i)
+    {
+        Eigen::HouseholderQR<MatrixXT> t_qrG(p_matProj_LeadField.middleCols(3*i, 3));
+
+        p_sourceBases.matQ.middleCols(3*i, 3) = t_qrG.householderQ() * MatrixXT::Identity(p_matProj_LeadField.rows(), 3);
+        p_sourceBases.matR.middleCols(3*i, 3) = t_qrG.matrixQR().topRows(3).triangularView<Eigen::Upper>();
+        p_sourceBases.matSS.middleCols(3*i, 3) = p_sourceBases.matS.middleRows(3*i, 3) * p_sourceBases.matS.middleRows(3*i, 3).transpose();
+    }
+}
+
+//=============================================================================================================
+
+double RapMusic::subcorr(const SourceBases& p_sourceBases,
+                         int p_iIdx1,
+                         int p_iIdx2)
+{
+    //The singular values and right singular vectors of the pair P*G = [P*G_1 P*G_2] follow from the 6x6 Gram matrix
+    //K = (P*G)^T*(P*G). With P*G_i = Q_i*R_i only the 3x3 cross product Q_1^T*Q_2 touches the channel dimension.
+    const Matrix3T t_matR1 = p_sourceBases.matR.middleCols<3>(3*p_iIdx1);
+    const Matrix3T t_matR2 = p_sourceBases.matR.middleCols<3>(3*p_iIdx2);
+
+    Matrix3T t_matQ12;
+    if(p_iIdx1 == p_iIdx2) {
+        t_matQ12.setIdentity();
+    } else {
+        t_matQ12.noalias() = p_sourceBases.matQ.middleCols<3>(3*p_iIdx1).transpose() * p_sourceBases.matQ.middleCols<3>(3*p_iIdx2);
+    }
+
+    Matrix6T t_matK;
+    t_matK.topLeftCorner<3,3>().noalias() = t_matR1.transpose() * t_matR1;
+    t_matK.topRightCorner<3,3>().noalias() = t_matR1.transpose() * t_matQ12 * t_matR2;
+    t_matK.bottomLeftCorner<3,3>() = t_matK.topRightCorner<3,3>().transpose();
+    t_matK.bottomRightCorner<3,3>().noalias() = t_matR2.transpose() * t_matR2;
+
+    //H = (P*G)^T*U_B*U_B^T*(P*G)
+    Matrix6T t_matH;
+    t_matH.topLeftCorner<3,3>() = p_sourceBases.matSS.middleCols<3>(3*p_iIdx1);
+    t_matH.topRightCorner<3,3>().noalias() = p_sourceBases.matS.middleRows<3>(3*p_iIdx1) * p_sourceBases.matS.middleRows<3>(3*p_iIdx2).transpose();
+    t_matH.bottomLeftCorner<3,3>() = t_matH.topRightCorner<3,3>().transpose();
+    t_matH.bottomRightCorner<3,3>() = p_sourceBases.matSS.middleCols<3>(3*p_iIdx2);
+
+    Eigen::SelfAdjointEigenSolver<Matrix6T> t_eigK(t_matK);
+
+    //U_A = P*G*V_A*Sigma_A^-1, retaining only the components with nonzero singular values like useFullRank().
+    //Eigenvalues are sorted ascending, the largest component is always kept.
+    Matrix6T t_matT = Matrix6T::Zero();
+    for(int i = 5; i >= 0; --i) {
+        double t_dSigma = std::sqrt(std::max(t_eigK.eigenvalues()(i), 0.0));
+
+        if(i < 5 && t_dSigma <= 0.00001) {
+            break;
+        }
+        if(t_dSigma == 0.0) {
+            return 0.0;
+        }
+
+        t_matT.col(i) = t_eigK.eigenvectors().col(i) / t_dSigma;
+    }
+
+    //The squared singular values of C = U_A^T*U_B are the eigenvalues of C*C^T = T^T*H*T
+    Matrix6T t_matCC = t_matT.transpose() * t_matH * t_matT;
+    Eigen::SelfAdjointEigenSolver<Matrix6T> t_eigCC(t_matCC, Eigen::EigenvaluesOnly);
+
+    return std::sqrt(std::max(t_eigCC.eigenvalues()(5), 0.0));
+}
+
+//=============================================================================================================
+
+double RapMusic::subcorr(const SourceBases& p_sourceBases,
+                         int p_iIdx)
+{
+    const Matrix3T t_matR = p_sourceBases.matR.middleCols<3>(3*p_iIdx);
+
+    Eigen::SelfAdjointEigenSolver<Matrix3T> t_eigK(t_matR.transpose() * t_matR);
+
+    Matrix3T t_matT = Matrix3T::Zero();
+    for(int i = 2; i >= 0; --i) {
+        double t_dSigma = std::sqrt(std::max(t_eigK.eigenvalues()(i), 0.0));
+
+        if(i < 2 && t_dSigma <= 0.00001) {
+            break;
+        }
+        if(t_dSigma == 0.0) {
+            return 0.0;
+        }
+
+        t_matT.col(i) = t_eigK.eigenvectors().col(i) / t_dSigma;
+    }
+
+    Matrix3T t_matCC = t_matT.transpose() * p_sourceBases.matSS.middleCols<3>(3*p_iIdx) * t_matT;
+    Eigen::SelfAdjointEigenSolver<Matrix3T> t_eigCC(t_matCC, Eigen::EigenvaluesOnly);
+
+    return std::sqrt(std::max(t_eigCC.eigenvalues()(2), 0.0));
+}
+
+//=============================================================================================================
+
+QVector<bool> RapMusic::preScreenSources(const SourceBases& p_sourceBases) const
+{
+    int t_iNumSources = p_sourceBases.matR.cols()/3;
+
+    if(m_iNumPreScreenSources <= 0 || m_iNumPreScreenSources >= t_iNumSources) {
+        return QVector<bool>();
+    }
+
+    VectorXT t_vecRoh(t_iNumSources);
+
+    #ifdef _OPENMP
+    #pragma omp parallel for num_threads(m_iMaxNumThreads)
+    #endif
+    for(int i = 0; i < t_iNumSources; ++i)
+    {
+        t_vecRoh(i) = RapMusic::subcorr(p_sourceBases, i);
+    }
+
+    //Keep the m_iNumPreScreenSources sources with the highest single source correlation
+    std::vector<int> t_vecIdx(t_iNumSources);
+    for(int i = 0; i < t_iNumSources; ++i)
+    {
+        t_vecIdx[i] = i;
+    }
+
+    std::nth_element(t_vecIdx.begin(), t_vecIdx.begin() + m_iNumPreScreenSources, t_vecIdx.end(),
+                     [&t_vecRoh](int a, int b) { return t_vecRoh(a) > t_vecRoh(b); });
+
+    QVector<bool> t_vecScanSource(t_iNumSources, false);
+    for(int i = 0; i < m_iNumPreScreenSources; ++i)
+    {
+        t_vecScanSource[t_vecIdx[i]] = true;
+    }
+
+    return t_vecScanSource;
+}
+
+//=============================================================================================================
+
 void RapMusic::calcA_k_1(   const MatrixX6T& p_matG_k_1,
                             const Vector6T& p_matPhi_k_1,
                             const int p_iIdxk_1,
@@ -756,12 +916,56 @@ void RapMusic::calcOrthProj(const MatrixXT& p_matA_k_1, MatrixXT& p_matOrthProj)
 {
     //Calculate OrthProj=I-A_k_1*(A_k_1'*A_k_1)^-1*A_k_1' //Wetterling -> A_k_1 = Gain
 
+    MatrixXT t_matA_k_1_tmp = calcA_k_1_Inv(p_matA_k_1);//(A_k_1*A_k_1_tmp_inv) = A_k_1_tmp
+
+    MatrixXT t_matA_k_1_tmp2(p_matA_k_1.rows(), p_matA_k_1.rows());
+
+    t_matA_k_1_tmp2 = t_matA_k_1_tmp*p_matA_k_1.adjoint();//(A_k_1_tmp)*A_k_1' -> here A_k_1' is only transposed - it has to be adjoint
+
+    MatrixXT I(m_iNumChannels,m_iNumChannels);
+    I.setIdentity();
+
+    p_matOrthProj = I-t_matA_k_1_tmp2; //OrthProj=I-A_k_1*(A_k_1'*A_k_1)^-1*A_k_1';
+
+    //garbage collecting
+    //ToDo
+}
+
+//=============================================================================================================
+
+void RapMusic::calcProjLeadField(const MatrixXT& p_matA_k_1,
+                                 const MatrixXT& p_matLeadField,
+                                 MatrixXT& p_matProj_LeadField) const
+{
+    //Only the found sources span A_k_1, the remaining columns are zero
+    int t_iNumFound = 0;
+    while(t_iNumFound < p_matA_k_1.cols() && !p_matA_k_1.col(t_iNumFound).isZero(0)) {
+        ++t_iNumFound;
+    }
+
+    if(t_iNumFound == 0) {
+        p_matProj_LeadField = p_matLeadField;
+        return;
+    }
+
+    //Pi_k_1*G = G - (A_k_1*(A_k_1'*A_k_1)^-1)*(A_k_1'*G)
+    MatrixXT t_matA_k_1 = p_matA_k_1.leftCols(t_iNumFound);
+    MatrixXT t_matA_k_1_tmp = calcA_k_1_Inv(t_matA_k_1);
+
+    p_matProj_LeadField = p_matLeadField;
+    p_matProj_LeadField.noalias() -= t_matA_k_1_tmp * (t_matA_k_1.adjoint() * p_matLeadField);
+}
+
+//=============================================================================================================
+
+RapMusic::MatrixXT RapMusic::calcA_k_1_Inv(const MatrixXT& p_matA_k_1)
+{
     MatrixXT t_matA_k_1_tmp(p_matA_k_1.cols(), p_matA_k_1.cols());
     t_matA_k_1_tmp = p_matA_k_1.adjoint()*p_matA_k_1;//A_k_1'*A_k_1 = A_k_1_tmp -> A_k_1' has to be adjoint for complex
 
     int t_size = t_matA_k_1_tmp.cols();
 
-    while (!t_matA_k_1_tmp.block(0,0,t_size,t_size).fullPivLu().isInvertible())
+    while (t_size > 0 && !t_matA_k_1_tmp.block(0,0,t_size,t_size).fullPivLu().isInvertible())
     {
         --t_size;
     }
@@ -771,21 +975,7 @@ void RapMusic::calcOrthProj(const MatrixXT& p_matA_k_1, MatrixXT& p_matOrthProj)
 
     t_matA_k_1_tmp_inv.block(0,0,t_size,t_size) = t_matA_k_1_tmp.block(0,0,t_size,t_size).inverse();//(A_k_1_tmp)^-1 = A_k_1_tmp_inv
 
-    t_matA_k_1_tmp = MatrixXT::Zero(p_matA_k_1.rows(), p_matA_k_1.cols());
-
-    t_matA_k_1_tmp = p_matA_k_1*t_matA_k_1_tmp_inv;//(A_k_1*A_k_1_tmp_inv) = A_k_1_tmp
-
-    MatrixXT t_matA_k_1_tmp2(p_matA_k_1.rows(), p_matA_k_1.rows());
-
-    t_matA_k_1_tmp2 = t_matA_k_1_tmp*p_matA_k_1.adjoint();//(A_k_1_tmp)*A_k_1' -> here A_k_1' is only transposed - it has to be adjoint
-
-    MatrixXT I(m_iNumChannels,m_iNumChannels);
-    I.setIdentity();
-
-    p_matOrthProj = I-t_matA_k_1_tmp2; //OrthProj=I-A_k_1*(A_k_1'*A_k_1)^-1*A_k_1';
-
-    //garbage collecting
-    //ToDo
+    return p_matA_k_1*t_matA_k_1_tmp_inv;//(A_k_1*A_k_1_tmp_inv) = A_k_1_tmp
 }
 
 //=============================================================================================================
@@ -881,3 +1071,10 @@ void RapMusic::setStcAttr(int p_iSampStcWin, float p_fStcOverlap)
     m_iSamplesStcWindow = p_iSampStcWin;
     m_fStcOverlap = p_fStcOverlap;
 }
+
+//=============================================================================================================
+
+void RapMusic::setPreScreening(int p_iNumSources)
+{
+    m_iNumPreScreenSources = p_iNumSources;
+}
@@ -58,6 +58,8 @@
 #include <Eigen/Core>
 #include <Eigen/SVD>
 #include <Eigen/LU>
+#include <Eigen/QR>
+#include <Eigen/Eigenvalues>
 
 //=============================================================================================================
 // DEFINE NAMESPACE INVERSELIB
@@ -112,6 +114,22 @@ public:
                                                                              1> as VectorXT type. */
     typedef Eigen::Matrix<double, 6, 1> Vector6T;                            /**< Defines Eigen::Matrix<T, 6, 1>
                                                                              as Vector6T type. */
+    typedef Eigen::Matrix<double, 3, 3> Matrix3T;                            /**< Defines Eigen::Matrix<T, 3, 3>
+                                                                             as Matrix3T type. */
+
+    //=========================================================================================================
+    /**
+     * Per source quantities of the projected lead field. They are computed once per recursion and shared by all
+     * source pairs, so that the subspace correlation of a pair reduces to a 6x6 eigenproblem.
+     * With P*G_i = Q_i*R_i the QR decomposition of the projected gain of source i:
+     */
+    struct SourceBases
+    {
+        MatrixXT matQ;      /**< Orthonormal bases Q_i of all sources (channels x 3*sources). */
+        MatrixXT matR;      /**< Triangular factors R_i of all sources (3 x 3*sources). */
+        MatrixXT matS;      /**< Projections S_i = (P*G_i)^T*U_B onto the signal subspace (3*sources x rank). */
+        MatrixXT matSS;     /**< Products S_i*S_i^T of all sources (3 x 3*sources). */
+    };
 
     //=========================================================================================================
     /**
@@ -165,6 +183,17 @@ public:
      */
     void setStcAttr(int p_iSampStcWin, float p_fStcOverlap);
 
+    //=========================================================================================================
+    /**
+     * Sets the number of sources kept by the single source pre-screening. When set, each recursion first ranks
+     * all sources by their own subspace correlation and only scans the pairs which contain at least one of the
+     * p_iNumSources best sources. The correlation of a pair is never smaller than the one of its sources, so the
+     * skipped pairs are the ones least likely to win. Default is 0, which scans all pairs.
+     *
+     * @param[in] p_iNumSources  Number of pre-screened sources (0 = scan all pairs).
+     */
+    void setPreScreening(int p_iNumSources);
+
 protected:
     //=========================================================================================================
     /**
@@ -210,6 +239,56 @@ protected:
      */
     static double subcorr(MatrixX6T& p_matProj_G, const MatrixXT& p_matU_B, Vector6T& p_vec_phi_k_1);
 
+    //=========================================================================================================
+    /**
+     * Computes the per source bases of the projected lead field. Has to be called once per recursion.
+     *
+     * @param[in] p_matProj_LeadField    The projected lead field P*G.
+     * @param[in] p_matU_B               The orthonormal basis of the projected signal subspace.
+     * @param[out] p_sourceBases         The per source bases.
+     */
+    void calcSourceBases(const MatrixXT& p_matProj_LeadField,
+                         const MatrixXT& p_matU_B,
+                         SourceBases& p_sourceBases) const;
+
+    //=========================================================================================================
+    /**
+     * Calculates the subspace correlation of a source pair out of the precomputed source bases. This equals
+     * subcorr() on the projected gain matrix pair, including its rank truncation, but works on 6x6 matrices only.
+     *
+     * @param[in] p_sourceBases  The per source bases of the current recursion.
+     * @param[in] p_iIdx1        Index of the first source.
+     * @param[in] p_iIdx2        Index of the second source.
+     *
+     * @return   The subspace correlation of the source pair.
+     */
+    static double subcorr(const SourceBases& p_sourceBases,
+                          int p_iIdx1,
+                          int p_iIdx2);
+
+    //=========================================================================================================
+    /**
+     * Calculates the subspace correlation of a single source out of the precomputed source bases.
+     *
+     * @param[in] p_sourceBases  The per source bases of the current recursion.
+     * @param[in] p_iIdx         Index of the source.
+     *
+     * @return   The subspace correlation of the source.
+     */
+    static double subcorr(const SourceBases& p_sourceBases,
+                          int p_iIdx);
+
+    //=========================================================================================================
+    /**
+     * Marks the sources which pass the single source pre-screening (see setPreScreening).
+     *
+     * @param[in] p_sourceBases  The per source bases of the current recursion.
+     *
+     * @return   Per source flag, true if pairs containing the source are to be scanned. Empty if all pairs are to
+     *           be scanned.
+     */
+    QVector<bool> preScreenSources(const SourceBases& p_sourceBases) const;
+
     //=========================================================================================================
     /**
      * Calculates the accumulated manifold vectors A_{k1}
@@ -234,6 +313,29 @@ protected:
      */
     void calcOrthProj(const MatrixXT& p_matA_k_1, MatrixXT& p_matOrthProj) const;
 
+    //=========================================================================================================
+    /**
+     * Applies the orthogonal projector Pi_k_1 = I-A_k_1*(A_k_1'*A_k_1)^-1*A_k_1' to the lead field without
+     * forming it, i.e. as a low rank update of the lead field.
+     *
+     * @param[in] p_matA_k_1             The A_k_1 matrix.
+     * @param[in] p_matLeadField         The lead field G.
+     * @param[out] p_matProj_LeadField   The projected lead field Pi_k_1*G.
+     */
+    void calcProjLeadField(const MatrixXT& p_matA_k_1,
+                           const MatrixXT& p_matLeadField,
+                           MatrixXT& p_matProj_LeadField) const;
+
+    //=========================================================================================================
+    /**
+     * Computes A_k_1*(A_k_1'*A_k_1)^-1, inverting the largest invertible leading block of A_k_1'*A_k_1.
+     *
+     * @param[in] p_matA_k_1     The A_k_1 matrix.
+     *
+     * @return   A_k_1*(A_k_1'*A_k_1)^-1.
+     */
+    static MatrixXT calcA_k_1_Inv(const MatrixXT& p_matA_k_1);
+
     //=========================================================================================================
     /**
      * Pre-Calculates the gain matrix index combinations to search for a two dipole independent topography
@@ -312,6 +414,8 @@ protected:
 
     bool m_bIsInit; /**< Whether the algorithm is initialized. */
 
+    int m_iNumPreScreenSources; /**< Number of sources kept by the single source pre-screening, 0 = scan all pairs. */
+
     //Stc stuff
     int m_iSamplesStcWindow;    /**< Number of samples per localization window. */
     float m_fStcOverlap;        /**< Percentage of localization window overlap. */
@@ -1691,7 +1691,7 @@ MneRawData *MneRawData::mne_raw_open_file_comp(const QString& name,
     //    fiffFile           in    = NULL;
 
     FiffDirEntry::SPtr dir;
-    QList<FiffDirEntry::SPtr> dir0;
+    FiffDirEntryList dir0;
     //    fiffTagRec   tag;
     FiffTag::SPtr t_pTag;
     FiffChInfo   ch;
@@ -1849,7 +1849,7 @@ MneRawData *MneRawData::mne_raw_open_file_comp(const QString& name,
         if (dir0[k]->kind == FIFF_DATA_BUFFER ||
                 dir0[k]->kind == FIFF_DATA_SKIP) {
             bufs[nbuf].ns          = 0;
-            bufs[nbuf].ent         = dir0[k];
+            bufs[nbuf].ent         = FiffDirEntry::SPtr(new FiffDirEntry(*dir0[k]));
             bufs[nbuf].nchan       = data->info->nchan;
             bufs[nbuf].is_skip     = dir0[k]->kind == FIFF_DATA_SKIP;
             bufs[nbuf].vals        = NULL;
@@ -389,7 +389,7 @@ int MneRawInfo::mne_load_raw_info(const QString& name, int allow_maxshield, MneR
     QList<FiffChInfo> chs;	/* Channel info */
     FiffCoordTransOld* trans    = NULL;	/* The coordinate transformation */
     fiffId         id       = NULL;	/* Measurement id */
-    QList<FiffDirEntry::SPtr>   rawDir;	/* Directory of raw data tags */
+    FiffDirEntryList   rawDir;	/* Directory of raw data tags */
     MneRawInfo*    info     = NULL;
     int            nchan    = 0;		/* Number of channels */
     float          sfreq    = 0.0;	/* Sampling frequency */
@@ -143,13 +143,13 @@ public:
                                              * whence it may be inaccurate. */
     int         buf_size;       /**< Buffer size in samples. */
     int         maxshield_data; /**< Are these unprocessed MaxShield data. */
-    QList<FIFFLIB::FiffDirEntry::SPtr>  rawDir; /**< Directory of raw data tags
-                                                     * These may be of type
-                                                     *       FIFF_DATA_BUFFER
-                                                     *       FIFF_DATA_SKIP
-                                                     *       FIFF_DATA_SKIP_SAMP
-                                                     *       FIFF_NOP
-                                                     */
+    FIFFLIB::FiffDirEntryList   rawDir;     /**< Directory of raw data tags
+                                                 * These may be of type
+                                                 *       FIFF_DATA_BUFFER
+                                                 *       FIFF_DATA_SKIP
+                                                 *       FIFF_DATA_SKIP_SAMP
+                                                 *       FIFF_NOP
+                                                 */
     int           ndir;       /**< Number of tags in the above directory. */
 
 //// ### OLD STRUCT ###
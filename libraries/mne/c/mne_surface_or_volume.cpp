@@ -58,6 +58,7 @@
 
 #include <utils/sphere.h>
 #include <utils/ioutils.h>
+#include <utils/meshadjacency.h>
 
 #include <QFile>
 #include <QCoreApplication>
@@ -2552,12 +2553,10 @@ int MneSurfaceOrVolume::add_geometry_info(MneSourceSpaceOld* s, int do_normals,
           * Add vertex normals and neighbourhood information
           */
 {
-    int k,c,p,q;
-    int vert;
+    int k,c,p;
     int *ii;
     int *neighbors,nneighbors;
     float w,size;
-    int   found;
     int   nfix_distinct,nfix_no_neighbors,nfix_defect;
     MneTriangle* tri;
 
@@ -2603,6 +2602,7 @@ int MneSurfaceOrVolume::add_geometry_info(MneSourceSpaceOld* s, int do_normals,
     if (do_normals)
         printf("and vertex ");
     printf("normals and neighboring triangles...");
+    MatrixX3i tris(s->ntri,3);
     for (p = 0, tri = s->tris; p < s->ntri; p++, tri++) {
         ii = tri->vert;
         w = 1.0;			/* This should be related to the triangle size */
@@ -2613,13 +2613,18 @@ int MneSurfaceOrVolume::add_geometry_info(MneSourceSpaceOld* s, int do_normals,
             if (do_normals)
                 for (c = 0; c < 3; c++)
                     s->nn[ii[k]][c] += w*tri->nn[c];
-            /*
-           * Add to the list of neighbors
-           */
-            s->neighbor_tri[ii[k]] = REALLOC_17(s->neighbor_tri[ii[k]],
-                    s->nneighbor_tri[ii[k]]+1,int);
-            s->neighbor_tri[ii[k]][s->nneighbor_tri[ii[k]]] = p;
-            s->nneighbor_tri[ii[k]]++;
+            tris(p,k) = ii[k];
+        }
+    }
+    /*
+       * The neighbors are taken from the CSR adjacency, which is built in a single sort and scan
+       */
+    UTILSLIB::MeshAdjacency adjacency(tris,s->np);
+    for (k = 0; k < s->np; k++) {
+        s->nneighbor_tri[k] = adjacency.numNeighborTri(k);
+        if (s->nneighbor_tri[k] > 0) {
+            s->neighbor_tri[k] = MALLOC_17(s->nneighbor_tri[k],int);
+            std::copy(adjacency.neighborTri(k),adjacency.neighborTri(k)+s->nneighbor_tri[k],s->neighbor_tri[k]);
         }
     }
     nfix_no_neighbors = 0;
@@ -2707,36 +2712,24 @@ int MneSurfaceOrVolume::add_geometry_info(MneSourceSpaceOld* s, int do_normals,
     }
     nfix_distinct = 0;
     for (k = 0; k < s->np; k++) {
+        /*
+         * The distinct vertices of the neighboring triangles, vertices omitted above have none
+         */
         neighbors  = s->neighbor_vert[k];
-        nneighbors = 0;
-        for (p = 0; p < s->nneighbor_tri[k]; p++) {
-            /*
-           * Fit in the other vertices of the neighboring triangle
-           */
-            for (c = 0; c < 3; c++) {
-                vert = s->tris[s->neighbor_tri[k][p]].vert[c];
-                if (vert != k) {
-                    for (q = 0, found = FALSE; q < nneighbors; q++) {
-                        if (neighbors[q] == vert) {
-                            found = TRUE;
-                            break;
-                        }
-                    }
-                    if (!found) {
-                        if (nneighbors < s->nneighbor_vert[k])
-                            neighbors[nneighbors++] = vert;
-                        else if (!border || !border[k]) {
-                            if (check_too_many_neighbors) {
-                                printf("Too many neighbors for vertex %d.",k);
-                                return FAIL;
-                            }
-                            else
-                                printf("\tWarning: Too many neighbors for vertex %d\n",k);
-                        }
-                    }
+        nneighbors = s->nneighbor_tri[k] > 0 ? adjacency.numNeighborVert(k) : 0;
+        if (nneighbors > s->nneighbor_vert[k]) {
+            if (!border || !border[k]) {
+                if (check_too_many_neighbors) {
+                    printf("Too many neighbors for vertex %d.",k);
+                    return FAIL;
                 }
+                else
+                    printf("\tWarning: Too many neighbors for vertex %d\n",k);
             }
+            nneighbors = s->nneighbor_vert[k];
         }
+        if (nneighbors > 0)
+            std::copy(adjacency.neighborVert(k),adjacency.neighborVert(k)+nneighbors,neighbors);
         if (nneighbors != s->nneighbor_vert[k]) {
 #ifdef REPORT_WARNINGS
             printf("\n\tIncorrect number of distinct neighbors for vertex %d (%d instead of %d) [fixed].",
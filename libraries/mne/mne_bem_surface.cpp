@@ -48,6 +48,7 @@
 using namespace MNELIB;
 using namespace Eigen;
 using namespace FIFFLIB;
+using namespace UTILSLIB;
 
 //=============================================================================================================
 // DEFINE MEMBER METHODS
@@ -84,6 +85,7 @@ MNEBemSurface::MNEBemSurface(const MNEBemSurface& p_MNEBemSurface)
 , tri_area(p_MNEBemSurface.tri_area)
 , neighbor_tri(p_MNEBemSurface.neighbor_tri)
 , neighbor_vert(p_MNEBemSurface.neighbor_vert)
+, adjacency(p_MNEBemSurface.adjacency)
 {
     //*m_pGeometryData = *p_MNEBemSurface.m_pGeometryData;
 }
@@ -109,6 +111,9 @@ void MNEBemSurface::clear()
     tri_cent = MatrixX3d::Zero(0,3);
     tri_nn = MatrixX3d::Zero(0,3);
     tri_area = VectorXd::Zero(0);
+    neighbor_tri.clear();
+    neighbor_vert.clear();
+    adjacency = MeshAdjacency();
 }
 
 //=============================================================================================================
@@ -178,45 +183,11 @@ bool MNEBemSurface::addTriangleData()
 
 bool MNEBemSurface::add_geometry_info()
 {
-    int k,c,p,q;
-    bool found;
+    //Build the CSR adjacency once, the per vertex lists are expanded from it
+    adjacency = MeshAdjacency(this->tris, this->np);
 
-    //Create neighboring triangle vector
-    neighbor_tri = QVector<QVector<int> >(this->tris.rows());
-
-    //Create neighbor_tri information
-    for (p = 0; p < this->tris.rows(); p++) {
-        for (k = 0; k < 3; k++) {
-            this->neighbor_tri[this->tris(p,k)].append(p);
-        }
-    }
-
-    //Create the neighboring vertices vector
-    neighbor_vert = QVector<QVector<int> >(this->np);
-
-    for (k = 0; k < this->np; k++) {
-        for (p = 0; p < this->neighbor_tri[k].size(); p++) {
-            //Fit in the other vertices of the neighboring triangle
-            for (c = 0; c < 3; c++) {
-                int vert = this->tris(this->neighbor_tri[k][p], c);
-
-                if (vert != k) {
-                    found = false;
-
-                    for (q = 0; q < this->neighbor_vert[k].size(); q++) {
-                        if (this->neighbor_vert[k][q] == vert) {
-                            found = true;
-                            break;
-                        }
-                    }
-
-                    if(!found) {
-                        this->neighbor_vert[k].append(vert);
-                    }
-                }
-            }
-        }
-    }
+    neighbor_tri = adjacency.toNeighborTri();
+    neighbor_vert = adjacency.toNeighborVert();
 
     return true;
 }
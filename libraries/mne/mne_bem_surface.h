@@ -45,6 +45,7 @@
 
 #include <fiff/fiff_types.h>
 #include <fiff/fiff.h>
+#include <utils/meshadjacency.h>
 
 //=============================================================================================================
 // EIGEN INCLUDES
@@ -168,6 +169,7 @@ public:
     Eigen::VectorXd tri_area;          /**< Triangle areas. */
     QVector<QVector<int> > neighbor_tri;           /**< Vector of neighboring triangles for each vertex. */
     QVector<QVector<int> > neighbor_vert;          /**< Vector of neighboring vertices for each vertex. */
+    UTILSLIB::MeshAdjacency adjacency;             /**< CSR vertex and triangle adjacency, neighbor_tri and neighbor_vert are expanded from it. */
 };
 
 //=============================================================================================================
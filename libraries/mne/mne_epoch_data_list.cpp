@@ -48,7 +48,6 @@
 //=============================================================================================================
 
 #include <QPointer>
-#include <QtConcurrent>
 #include <QDebug>
 
 //=============================================================================================================
@@ -121,54 +120,82 @@ MNEEpochDataList MNEEpochDataList::readEpochs(const FiffRawData& raw,
         }
     }
 
+    // Determine the segments. All epochs need to have the same length, which is set by the first readable one.
     fiff_int_t event_samp, from, to;
-    fiff_int_t dropCount = 0;
-    MatrixXd timesDummy;
-    MatrixXd times;
-
-    QScopedPointer<MNEEpochData> epoch(Q_NULLPTR);
+    fiff_int_t nsamp = -1;
+    VectorXi vecFrom(count);
+    qint32 nepochs = 0;
 
     for (p = 0; p < count; ++p) {
-        // Read a data segment
         event_samp = events(selected(p),0);
         from = event_samp + tmin*raw.info.sfreq;
         to   = event_samp + floor(tmax*raw.info.sfreq + 0.5);
 
-        epoch.reset(new MNEEpochData());
+        if(from < raw.first_samp || to > raw.last_samp || to < from) {
+            qWarning("[MNEEpochDataList::readEpochs] Can't read the event data segment %d ... %d.", from, to);
+            continue;
+        }
 
-        if(raw.read_raw_segment(epoch->epoch, timesDummy, from, to, picksNew)) {
-            if (p == 0) {
-                times.resize(1, to-from+1);
-                for (qint32 i = 0; i < times.cols(); ++i)
-                    times(0, i) = ((float)(from-event_samp+i)) / raw.info.sfreq;
-            }
+        if(nsamp < 0) {
+            nsamp = to - from + 1;
+        } else if(to - from + 1 != nsamp) {
+            continue;
+        }
 
-            epoch->event = event;
-            epoch->tmin = tmin;
-            epoch->tmax = tmax;
+        vecFrom[nepochs++] = from;
+    }
+    vecFrom.conservativeResize(nepochs);
 
-            epoch->bReject = checkForArtifact(epoch->epoch,
-                                              raw.info,
-                                              mapReject,
-                                              lExcludeChs);
+    if(nepochs == 0) {
+        qWarning("[MNEEpochDataList::readEpochs] Can't read the event data segments.");
+        return MNEEpochDataList();
+    }
 
-            if (epoch->bReject) {
-                dropCount++;
-            }
+    // Read all epochs in a single sweep over the raw buffers into one contiguous (channels x (epochs * samples)) block
+    MatrixXd matEpochs;
+    if(!raw.read_raw_segments(matEpochs, vecFrom, nsamp, picksNew)) {
+        qWarning("[MNEEpochDataList::readEpochs] Can't read the event data segments.");
+        return MNEEpochDataList();
+    }
 
-            //Check if data block has the same size as the previous one
-            if(!data.isEmpty()) {
-                if(epoch->epoch.size() == data.last()->epoch.size()) {
-                    data.append(MNEEpochData::SPtr(epoch.take()));//List takes ownwership of the pointer - no delete need
-                }
-            } else {
-                data.append(MNEEpochData::SPtr(epoch.take()));//List takes ownwership of the pointer - no delete need
-            }
+    // Scan the whole block for artifacts at once
+    QVector<int> vecRejectedCh = scanForArtifacts(matEpochs, nsamp, raw.info, mapReject, lExcludeChs, picksNew);
+
+    // Hand out the epochs from the last one on and release the columns of each epoch from the block right after it
+    // was copied, so that the block and the epochs together never take much more than the epoch data once
+    QVector<MNEEpochData::SPtr> vecEpochs(nepochs);
+
+    for (p = nepochs - 1; p >= 0; --p) {
+        MNEEpochData::SPtr epoch(new MNEEpochData());
+
+        epoch->epoch = matEpochs.rightCols(nsamp);
+        epoch->event = event;
+        epoch->tmin = tmin;
+        epoch->tmax = tmax;
+        epoch->bReject = vecRejectedCh[p] >= 0;
+
+        vecEpochs[p] = epoch;
+
+        if(p > 0) {
+            // Column major, so this shrinks the allocation in place
+            matEpochs.conservativeResize(NoChange, static_cast<Index>(p) * nsamp);
         } else {
-            qWarning("[MNEEpochDataList::readEpochs] Can't read the event data segments.");
+            matEpochs.resize(0, 0);
         }
     }
 
+    fiff_int_t dropCount = 0;
+    data.reserve(nepochs);
+
+    for (p = 0; p < nepochs; ++p) {
+        if (vecEpochs[p]->bReject) {
+            qInfo().noquote() << "[MNEEpochDataList::readEpochs] Reject trial because of channel" << raw.info.chs.at(vecRejectedCh[p]).ch_name;
+            dropCount++;
+        }
+
+        data.append(vecEpochs[p]);
+    }
+
     qInfo().noquote() << "[MNEEpochDataList::readEpochs] Read a total of"<< data.size() <<"epochs of type" << event << "and marked"<< dropCount <<"for rejection.";
 
     return data;
@@ -277,82 +304,115 @@ bool MNEEpochDataList::checkForArtifact(const MatrixXd& data,
 {
     //qDebug() << "MNEEpochDataList::checkForArtifact - Doing artifact reduction for" << mapReject;
 
-    bool bReject = false;
-
-    //Prepare concurrent data handling
-    QList<ArtifactRejectionData> lchData;
-    QList<int> lChTypes;
+    QVector<int> vecRejectedCh = scanForArtifacts(data, data.cols(), pFiffInfo, mapReject, lExcludeChs);
 
-    if(mapReject.contains("grad") ||
-       mapReject.contains("mag") ) {
-        lChTypes << FIFFV_MEG_CH;
+    if(vecRejectedCh.isEmpty() || vecRejectedCh.first() < 0) {
+        return false;
     }
 
-    if(mapReject.contains("eeg")) {
-        lChTypes << FIFFV_EEG_CH;
-    }
+    qInfo().noquote() << "[MNEEpochDataList::checkForArtifact] Reject trial because of channel"<<pFiffInfo.chs.at(vecRejectedCh.first()).ch_name;
+
+    return true;
+}
+
+//=============================================================================================================
 
-    if(mapReject.contains("eog")) {
-        lChTypes << FIFFV_EOG_CH;
+QVector<int> MNEEpochDataList::scanForArtifacts(const MatrixXd& data,
+                                                 qint32 nsamp,
+                                                 const FiffInfo& pFiffInfo,
+                                                 const QMap<QString,double>& mapReject,
+                                                 const QStringList& lExcludeChs,
+                                                 const RowVectorXi& picks)
+{
+    qint32 nepochs = nsamp > 0 ? data.cols() / nsamp : 0;
+    QVector<int> vecRejectedCh(nepochs, -1);
+
+    if(!mapReject.contains("grad") &&
+       !mapReject.contains("mag") &&
+       !mapReject.contains("eeg") &&
+       !mapReject.contains("eog")) {
+        return vecRejectedCh;
     }
 
-    if(lChTypes.isEmpty()) {
-        return bReject;
+    // Row of every info channel in data, the rows correspond to the info channels if no picks are given
+    VectorXi vecRow = VectorXi::Constant(pFiffInfo.chs.size(), -1);
+    if(picks.size() > 0) {
+        for(int i = 0; i < picks.size(); ++i) {
+            vecRow[picks[i]] = i;
+        }
+    } else {
+        for(int i = 0; i < pFiffInfo.chs.size() && i < data.rows(); ++i) {
+            vecRow[i] = i;
+        }
     }
 
+    // Collect the channels to scan together with their thresholds once
+    QVector<int> vecChs;
+    QVector<double> vecThresholds;
+
     for(int i = 0; i < pFiffInfo.chs.size(); ++i) {
-        if(lChTypes.contains(pFiffInfo.chs.at(i).kind)
-           && !lExcludeChs.contains(pFiffInfo.chs.at(i).ch_name)
-           && !pFiffInfo.bads.contains(pFiffInfo.chs.at(i).ch_name)
-           && pFiffInfo.chs.at(i).chpos.coil_type != FIFFV_COIL_BABY_REF_MAG
-           && pFiffInfo.chs.at(i).chpos.coil_type != FIFFV_COIL_BABY_REF_MAG2) {
-            ArtifactRejectionData tempData;
-            tempData.data = data.row(i);
-
-            switch (pFiffInfo.chs.at(i).kind) {
-            case FIFFV_MEG_CH:
-                if(pFiffInfo.chs.at(i).unit == FIFF_UNIT_T) {
-                    tempData.dThreshold = mapReject["mag"];
-                } else if(pFiffInfo.chs.at(i).unit == FIFF_UNIT_T_M) {
-                    tempData.dThreshold = mapReject["grad"];
-                }
-            break;
-
-            case FIFFV_EEG_CH:
-                tempData.dThreshold = mapReject["eeg"];
-            break;
-
-            case FIFFV_EOG_CH:
-                tempData.dThreshold = mapReject["eog"];
-            break;
+        const FiffChInfo& chInfo = pFiffInfo.chs.at(i);
+
+        if(vecRow[i] < 0
+           || lExcludeChs.contains(chInfo.ch_name)
+           || pFiffInfo.bads.contains(chInfo.ch_name)
+           || chInfo.chpos.coil_type == FIFFV_COIL_BABY_REF_MAG
+           || chInfo.chpos.coil_type == FIFFV_COIL_BABY_REF_MAG2) {
+            continue;
+        }
+
+        QString sType;
+        switch (chInfo.kind) {
+        case FIFFV_MEG_CH:
+            if(chInfo.unit == FIFF_UNIT_T) {
+                sType = "mag";
+            } else if(chInfo.unit == FIFF_UNIT_T_M) {
+                sType = "grad";
             }
+        break;
 
-            tempData.sChName = pFiffInfo.chs.at(i).ch_name;
-            lchData.append(tempData);
+        case FIFFV_EEG_CH:
+            sType = "eeg";
+        break;
+
+        case FIFFV_EOG_CH:
+            sType = "eog";
+        break;
+        }
+
+        if(!sType.isEmpty() && mapReject.contains(sType)) {
+            vecChs.append(i);
+            vecThresholds.append(mapReject.value(sType));
         }
     }
 
-    if(lchData.isEmpty()) {
-        qWarning() << "[MNEEpochDataList::checkForArtifact] No channels found to scan for artifacts. Do not reject. Returning.";
+    if(vecChs.isEmpty()) {
+        qWarning() << "[MNEEpochDataList::scanForArtifacts] No channels found to scan for artifacts. Do not reject. Returning.";
 
-        return bReject;
+        return vecRejectedCh;
     }
 
-    //qDebug() << "MNEEpochDataList::checkForArtifact - lchData.size()" << lchData.size();
+    // Peak to peak of one channel across all epochs. The samples of a channel within one epoch are nrows apart,
+    // consecutive epochs nsamp * nrows apart.
+    const Index nrows = data.rows();
+    typedef Map<const MatrixXd, 0, Stride<Dynamic,Dynamic> > ChannelEpochsMap;
 
-    //Start the concurrent processing
-    QFuture<void> future = QtConcurrent::map(lchData, checkChThreshold);
-    future.waitForFinished();
+    for(int j = 0; j < vecChs.size(); ++j) {
+        ChannelEpochsMap matCh(data.data() + vecRow[vecChs[j]],
+                               nsamp,
+                               nepochs,
+                               Stride<Dynamic,Dynamic>(static_cast<Index>(nsamp) * nrows, nrows));
 
-    for(int i = 0; i < lchData.size(); ++i) {
-        if(lchData.at(i).bRejected) {
-            bReject = true;
-            qInfo().noquote() << "[MNEEpochDataList::checkForArtifact] Reject trial because of channel"<<lchData.at(i).sChName;
-            break;
+        ArrayXd vecPP = (matCh.colwise().maxCoeff() - matCh.colwise().minCoeff()).transpose().array().abs();
+
+        for(int e = 0; e < nepochs; ++e) {
+            if(vecRejectedCh[e] < 0 && vecPP[e] > vecThresholds[j]) {
+                vecRejectedCh[e] = vecChs[j];
+            }
         }
     }
 
-    return bReject;
+    return vecRejectedCh;
 }
 
 //=============================================================================================================
@@ -54,6 +54,7 @@
 
 #include <QList>
 #include <QSharedPointer>
+#include <QVector>
 
 //=============================================================================================================
 // DEFINE NAMESPACE MNELIB
@@ -170,6 +171,27 @@ public:
                                  const QStringList &lExcludeChs = QStringList());
 
     static void checkChThreshold(ArtifactRejectionData& inputData);
+
+    //=========================================================================================================
+    /**
+     * Checks several epochs of equal length, stored next to each other in one matrix, for artifacts beyond a
+     * threshold value. The peak to peak values are computed for all epochs of a channel at once.
+     *
+     * @param[in] data           The epochs stacked column wise (channels x (epochs * nsamp)).
+     * @param[in] nsamp          The number of samples per epoch.
+     * @param[in] pFiffInfo      The fiff info.
+     * @param[in] mapReject      The channel data types to scan for. EEG, MEG or EOG.
+     * @param[in] lExcludeChs    List of channel names to exclude.
+     * @param[in] picks          The info channels the rows of data correspond to. Empty if all channels are present.
+     *
+     * @return   For every epoch the index of the first info channel exceeding its threshold, -1 if none did.
+     */
+    static QVector<int> scanForArtifacts(const Eigen::MatrixXd& data,
+                                         qint32 nsamp,
+                                         const FIFFLIB::FiffInfo& pFiffInfo,
+                                         const QMap<QString,double>& mapReject,
+                                         const QStringList &lExcludeChs = QStringList(),
+                                         const Eigen::RowVectorXi& picks = Eigen::RowVectorXi());
 };
 } // NAMESPACE
 
@@ -42,6 +42,7 @@
 #include "mne_forwardsolution.h"
 
 #include <utils/ioutils.h>
+#include <fiff/fiff_ch_name_index.h>
 
 //=============================================================================================================
 // EIGEN INCLUDES
@@ -1002,8 +1003,9 @@ MNEForwardSolution MNEForwardSolution::pick_channels(const QStringList& include,
     fwd.info.nchan = nuse;
 
     QStringList bads;
+    QHash<QString,qint32> ch_index = FiffChNameIndex::build(ch_names);
     for(qint32 i = 0; i < fwd.info.bads.size(); ++i)
-        if(ch_names.contains(fwd.info.bads[i]))
+        if(ch_index.contains(fwd.info.bads[i]))
             bads.append(fwd.info.bads[i]);
     fwd.info.bads = bads;
 
@@ -1102,13 +1104,20 @@ void MNEForwardSolution::prepare_forward(const FiffInfo &p_info,
     for(qint32 i = 0; i < this->info.chs.size(); ++i)
         fwd_ch_names << this->info.chs[i].ch_name;
 
+    QHash<QString,qint32> fwd_ch_index = FiffChNameIndex::build(fwd_ch_names);
+    QHash<QString,qint32> info_bads_index = FiffChNameIndex::build(p_info.bads);
+    QBitArray noise_cov_bads = p_noise_cov.bad_mask();
+    qint32 cov_idx;
+
     ch_names.clear();
     for(qint32 i = 0; i < p_info.chs.size(); ++i)
-        if(!p_info.bads.contains(p_info.chs[i].ch_name)
-            && !p_noise_cov.bads.contains(p_info.chs[i].ch_name)
-            && p_noise_cov.names.contains(p_info.chs[i].ch_name)
-            && fwd_ch_names.contains(p_info.chs[i].ch_name))
+    {
+        cov_idx = p_noise_cov.ch_index(p_info.chs[i].ch_name);
+        if(!info_bads_index.contains(p_info.chs[i].ch_name)
+            && cov_idx > -1 && !noise_cov_bads.testBit(cov_idx)
+            && fwd_ch_index.contains(p_info.chs[i].ch_name))
             ch_names << p_info.chs[i].ch_name;
+    }
 
     qint32 n_chan = ch_names.size();
     printf("Computing inverse operator with %d channels.\n", n_chan);
@@ -1161,13 +1170,13 @@ void MNEForwardSolution::prepare_forward(const FiffInfo &p_info,
     qint32 count_info_idx = 0;
     for(qint32 i = 0; i < ch_names.size(); ++i)
     {
-        idx = fwd_ch_names.indexOf(ch_names[i]);
+        idx = fwd_ch_index.value(ch_names[i], -1);
         if(idx > -1)
         {
             fwd_idx[count_fwd_idx] = idx;
             ++count_fwd_idx;
         }
-        idx = p_info.ch_names.indexOf(ch_names[i]);
+        idx = p_info.ch_index(ch_names[i]);
         if(idx > -1)
         {
             info_idx[count_info_idx] = idx;
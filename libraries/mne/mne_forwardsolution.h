@@ -123,7 +123,7 @@ struct RegionData
         // Kmeans Reduction
         RegionDataOut p_RegionDataOut;
 
-        UTILSLIB::KMeans t_kMeans(t_sDistMeasure, QString("sample"), 5);
+        UTILSLIB::KMeans t_kMeans(t_sDistMeasure, QString("plus"), 5);
 
         if(bUseWhitened)
         {
@@ -46,6 +46,7 @@
 
 #include <fiff/fiff_types.h>
 #include <fiff/fiff.h>
+#include <utils/meshadjacency.h>
 
 //=============================================================================================================
 // EIGEN INCLUDES
@@ -205,6 +206,7 @@ public:
 
     QVector<QVector<int> > neighbor_tri;           /**< Vector of neighboring triangles for each vertex. */
     QVector<QVector<int> > neighbor_vert;          /**< Vector of neighboring vertices for each vertex. */
+    UTILSLIB::MeshAdjacency adjacency;             /**< CSR vertex and triangle adjacency, neighbor_tri and neighbor_vert are expanded from it. */
 
     MNEClusterInfo cluster_info; /**< Holds the cluster information. */
 private:
@@ -122,7 +122,7 @@ struct RegionMT
         // Kmeans Reduction
         RegionMTOut p_RegionMTOut;
 
-        UTILSLIB::KMeans t_kMeans(t_sDistMeasure, QString("sample"), 5);
+        UTILSLIB::KMeans t_kMeans(t_sDistMeasure, QString("plus"), 5);
 
         t_kMeans.calculate(this->matRoiMT, this->nClusters, p_RegionMTOut.roiIdx, p_RegionMTOut.ctrs, p_RegionMTOut.sumd, p_RegionMTOut.D);
 
@@ -46,10 +46,17 @@
 #include <mne/mne_bem_surface.h>
 #include <mne/mne_surface.h>
 
+#include <atomic>
+
 //=============================================================================================================
 // QT INCLUDES
 //=============================================================================================================
 
+#include <QtConcurrent>
+#include <QVector>
+#include <QPair>
+#include <QThread>
+
 //=============================================================================================================
 // EIGEN INCLUDES
 //=============================================================================================================
@@ -67,6 +74,20 @@ using namespace Eigen;
 // DEFINE GLOBAL METHODS
 //=============================================================================================================
 
+static QVector<QPair<int,int> > pointBlocks(int iNumPoints)
+{
+    const int iMinBlockSize = 64;
+    int iNumBlocks = std::max(1, std::min(4 * QThread::idealThreadCount(), iNumPoints / iMinBlockSize));
+    int iBlockSize = (iNumPoints + iNumBlocks - 1) / iNumBlocks;
+
+    QVector<QPair<int,int> > vecBlocks;
+    for(int iBegin = 0; iBegin < iNumPoints; iBegin += iBlockSize) {
+        vecBlocks.append(qMakePair(iBegin, std::min(iBegin + iBlockSize, iNumPoints)));
+    }
+
+    return vecBlocks;
+}
+
 //=============================================================================================================
 // DEFINE MEMBER METHODS
 //=============================================================================================================
@@ -80,6 +101,8 @@ MNEProjectToSurface::MNEProjectToSurface()
 , b(VectorXf::Zero(1))
 , c(VectorXf::Zero(1))
 , det(VectorXf::Zero(1))
+, center(MatrixX3f::Zero(1,3))
+, radius(VectorXf::Zero(1))
 {
 }
 
@@ -113,10 +136,12 @@ MNEProjectToSurface::MNEProjectToSurface(const MNEBemSurface &p_MNEBemSurf)
     {
         for (int i = 0; i < p_MNEBemSurf.ntri; ++i)
         {
-            nn.row(i) = r12.row(i).transpose().cross(r13.row(i).transpose()).transpose();
+            nn.row(i) = r12.row(i).transpose().cross(r13.row(i).transpose()).normalized().transpose();
         }
     }
     det = (a.array()*b.array() - c.array()*c.array()).matrix();
+
+    compute_bounding_spheres();
 }
 
 //=============================================================================================================
@@ -136,22 +161,32 @@ MNEProjectToSurface::MNEProjectToSurface(const MNESurface &p_MNESurf)
         r1.row(i) = p_MNESurf.rr.row(p_MNESurf.tris(i,0));
         r12.row(i) = p_MNESurf.rr.row(p_MNESurf.tris(i,1)) - r1.row(i);
         r13.row(i) = p_MNESurf.rr.row(p_MNESurf.tris(i,2)) - r1.row(i);
-        nn.row(i) = r12.row(i).transpose().cross(r13.row(i).transpose()).transpose();
+        nn.row(i) = r12.row(i).transpose().cross(r13.row(i).transpose()).normalized().transpose();
         a(i) = r12.row(i) * r12.row(i).transpose();
         b(i) = r13.row(i) * r13.row(i).transpose();
         c(i) = r12.row(i) * r13.row(i).transpose();
     }
 
     det = (a.array()*b.array() - c.array()*c.array()).matrix();
+
+    compute_bounding_spheres();
 }
 
 //=============================================================================================================
 
 bool MNEProjectToSurface::mne_find_closest_on_surface(const MatrixXf &r, const int np, MatrixXf &rTri,
-                                                      VectorXi &nearest, VectorXf &dist)
+                                                      VectorXi &nearest, VectorXf &dist, bool bWarmStart) const
 {
+    if (bWarmStart && nearest.size() != np)
+    {
+        bWarmStart = false;
+    }
+
     // resize output
-    nearest.resize(np);
+    if (!bWarmStart)
+    {
+        nearest.resize(np);
+    }
     dist.resize(np);
     rTri.resize(np,3);
 
@@ -160,36 +195,71 @@ bool MNEProjectToSurface::mne_find_closest_on_surface(const MatrixXf &r, const i
         qDebug() << "No surface loaded to make the projection./n";
         return false;
     }
-    int bestTri = -1;
-    float bestDist = -1;
-    Vector3f rTriK;
-    for (int k = 0; k < np; ++k)
-    {
-        /*
-         * To do: decide_search_restriction for the use in an iterative closest point to plane algorithm
-         * For now it's OK to go through all triangles.
-         */
-        if (!this->mne_project_to_surface(r.row(k).transpose(), rTriK, bestTri, bestDist))
+
+    // The points are independent of each other, so project them block wise in parallel
+    QVector<QPair<int,int> > vecBlocks = pointBlocks(np);
+    std::atomic<bool> bSuccess(true);
+    QtConcurrent::blockingMap(vecBlocks, [&](const QPair<int,int>& block) {
+        int bestTri = -1;
+        float bestDist = -1;
+        Vector3f rTriK;
+        for (int k = block.first; k < block.second; ++k)
         {
-            qDebug() << "The projection of point number " << k << " didn't work./n";
-            return false;
+            if (!this->mne_project_to_surface(r.row(k).transpose(), rTriK, bestTri, bestDist, bWarmStart ? nearest[k] : -1))
+            {
+                qDebug() << "The projection of point number " << k << " didn't work./n";
+                bSuccess = false;
+                return;
+            }
+            rTri.row(k) = rTriK.transpose();
+            nearest[k] = bestTri;
+            dist[k] = bestDist;
         }
-        rTri.row(k) = rTriK.transpose();
-        nearest[k] = bestTri;
-        dist[k] = bestDist;
-    }
-    return true;
+    });
+
+    return bSuccess;
 }
 
 //=============================================================================================================
 
-bool MNEProjectToSurface::mne_project_to_surface(const Vector3f &r, Vector3f &rTri, int &bestTri, float &bestDist)
+const MatrixX3f& MNEProjectToSurface::triangle_normals() const
+{
+    return this->nn;
+}
+
+//=============================================================================================================
+
+bool MNEProjectToSurface::mne_project_to_surface(const Vector3f &r, Vector3f &rTri, int &bestTri, float &bestDist, int hintTri) const
 {
     float p = 0, q = 0, p0 = 0, q0 = 0, dist0 = 0;
     bestDist = 0.0f;
     bestTri = -1;
+
+    // Start with the hint, its distance bounds the search from the beginning
+    if (hintTri >= 0 && hintTri < a.size())
+    {
+        if (!this->nearest_triangle_point(r, hintTri, p, q, bestDist))
+        {
+            qDebug() << "The projection on triangle " << hintTri << " didn't work./n";
+            return false;
+        }
+        bestTri = hintTri;
+    }
+
+    float fBound;
     for (int tri = 0; tri < a .size(); ++tri)
     {
+        // Skip triangles whose bounding sphere is farther away than the best triangle so far. The small slack keeps
+        // rounding from dropping a triangle which is equally close.
+        if (bestTri >= 0)
+        {
+            fBound = 1.0001f * std::fabs(bestDist) + this->radius(tri);
+            if ((r.transpose() - this->center.row(tri)).squaredNorm() > fBound * fBound)
+            {
+                continue;
+            }
+        }
+
         if (!this->nearest_triangle_point(r, tri, p0, q0, dist0))
         {
             qDebug() << "The projection on triangle " << tri << " didn't work./n";
@@ -221,7 +291,7 @@ bool MNEProjectToSurface::mne_project_to_surface(const Vector3f &r, Vector3f &rT
 
 //=============================================================================================================
 
-bool MNEProjectToSurface::nearest_triangle_point(const Vector3f &r, const int tri, float &p, float &q, float &dist)
+bool MNEProjectToSurface::nearest_triangle_point(const Vector3f &r, const int tri, float &p, float &q, float &dist) const
 {
     //Calculate some helpers
     Vector3f rr = r - this->r1.row(tri).transpose(); //Vector from triangle corner #1 to r
@@ -329,8 +399,23 @@ bool MNEProjectToSurface::nearest_triangle_point(const Vector3f &r, const int tr
 
 //=============================================================================================================
 
-bool MNEProjectToSurface::project_to_triangle(Vector3f &rTri, const float p, const float q, const int tri)
+bool MNEProjectToSurface::project_to_triangle(Vector3f &rTri, const float p, const float q, const int tri) const
 {
     rTri = this->r1.row(tri) + p*this->r12.row(tri) + q*this->r13.row(tri);
     return true;
 }
+
+//=============================================================================================================
+
+void MNEProjectToSurface::compute_bounding_spheres()
+{
+    // The centroid is not the center of the smallest enclosing sphere but close enough to prune the search
+    center = r1 + (r12 + r13) / 3.0f;
+    radius.resize(r1.rows());
+    for (int i = 0; i < r1.rows(); ++i)
+    {
+        Vector3f vecRel = -(r12.row(i) + r13.row(i)).transpose() / 3.0f;
+        radius(i) = std::max(vecRel.norm(),
+                             std::max((vecRel + r12.row(i).transpose()).norm(), (vecRel + r13.row(i).transpose()).norm()));
+    }
+}
@@ -115,16 +115,30 @@ public:
      *
      * @brief mne_find_closest_on_surface
      *
-     * @param[in] r         Set of pionts, which are to be projectied.
-     * @param[in] np        number of points.
-     * @param[out] rTri     set of points on the surface.
-     * @param[out] nearest  Triangle of the new point.
-     * @param[out] dist     Distance between r and rTri.
+     * The points are projected in parallel. Triangles which can not be closer than the best one found so far
+     * are skipped by means of their bounding spheres, the result is the same as for a full search.
+     *
+     * @param[in] r             Set of pionts, which are to be projectied.
+     * @param[in] np            number of points.
+     * @param[out] rTri         set of points on the surface.
+     * @param[in, out] nearest  Triangle of the new point. If bWarmStart is set, it holds the triangles found for a
+     *                          nearby position of the points (e.g. the previous ICP iteration) on input, which are
+     *                          tried first.
+     * @param[out] dist         Distance between r and rTri.
+     * @param[in] bWarmStart    Whether to start the search at the triangles passed in nearest, defaults to false.
      *
      * @return true if succeeded, false otherwise.
      */
     bool mne_find_closest_on_surface(const Eigen::MatrixXf &r, const int np, Eigen::MatrixXf &rTri,
-                                     Eigen::VectorXi &nearest, Eigen::VectorXf &dist);
+                                     Eigen::VectorXi &nearest, Eigen::VectorXf &dist, bool bWarmStart = false) const;
+
+    //=========================================================================================================
+    /**
+     * Returns the unit normals of the surface triangles.
+     *
+     * @return The triangle normals (ntri x 3).
+     */
+    const Eigen::MatrixX3f& triangle_normals() const;
 
 protected:
 
@@ -139,10 +153,11 @@ private:
      * @param[out] rTri     Point on the surface.
      * @param[out] bestTri  Triangle of the new point.
      * @param[out] bestDist Distance between r and rTri.
+     * @param[in] hintTri   Triangle to start the search with, -1 if none.
      *
      * @return true if succeeded, false otherwise.
      */
-    bool mne_project_to_surface(const Eigen::Vector3f &r, Eigen::Vector3f &rTri, int &bestTri, float &bestDist);
+    bool mne_project_to_surface(const Eigen::Vector3f &r, Eigen::Vector3f &rTri, int &bestTri, float &bestDist, int hintTri = -1) const;
 
     //=========================================================================================================
     /**
@@ -158,7 +173,7 @@ private:
      *
      * @return true if succeeded, false otherwise.
      */
-    bool nearest_triangle_point(const Eigen::Vector3f &r, const int tri, float &p, float &q, float &dist);
+    bool nearest_triangle_point(const Eigen::Vector3f &r, const int tri, float &p, float &q, float &dist) const;
 
     //=========================================================================================================
     /**
@@ -173,7 +188,13 @@ private:
      *
      * @return true if succeeded, false otherwise.
      */
-    bool project_to_triangle(Eigen::Vector3f &rTri, const float p, const float q, const int tri);
+    bool project_to_triangle(Eigen::Vector3f &rTri, const float p, const float q, const int tri) const;
+
+    //=========================================================================================================
+    /**
+     * Computes the bounding spheres of the triangles, which are used to skip triangles during the search.
+     */
+    void compute_bounding_spheres();
 
     Eigen::MatrixX3f r1;         /**< Cartesian Vector to the first triangel corner. */
     Eigen::MatrixX3f r12;        /**< Cartesian Vector from the first to the second triangel corner. */
@@ -183,6 +204,8 @@ private:
     Eigen::VectorXf b;           /**< r13*r13. */
     Eigen::VectorXf c;           /**< r12*r13. */
     Eigen::VectorXf det;         /**< Determinant of the Matrix [a c, c b]. */
+    Eigen::MatrixX3f center;     /**< Center of the triangle bounding sphere. */
+    Eigen::VectorXf radius;      /**< Radius of the triangle bounding sphere. */
 };
 
 //=============================================================================================================
@@ -40,6 +40,7 @@
 #include "filter.h"
 
 #include <utils/mnemath.h>
+#include <utils/mnetracer.h>
 #include <fiff/fiff_raw_data.h>
 
 //=============================================================================================================
@@ -64,6 +65,82 @@ using namespace Eigen;
 using namespace FIFFLIB;
 using namespace UTILSLIB;
 
+//=============================================================================================================
+// DEFINE GLOBAL METHODS
+//=============================================================================================================
+
+namespace {
+    /**
+     * Filters the file forward and backward block by block and writes one raw buffer per block.
+     */
+    bool filterFileIir(FiffStream::SPtr outfid,
+                       QSharedPointer<FiffRawData> pFiffRawData,
+                       const IirFilter& iirFilter,
+                       const RowVectorXi& vecPicks,
+                       const RowVectorXd& cals)
+    {
+        RowVectorXi vecPicksNew = vecPicks;
+        if(vecPicksNew.cols() == 0) {
+            vecPicksNew = RowVectorXi::LinSpaced(pFiffRawData->info.nchan, 0, pFiffRawData->info.nchan - 1);
+        }
+
+        fiff_int_t from = pFiffRawData->first_samp;
+        fiff_int_t to = pFiffRawData->last_samp;
+
+        // Every block is read together with a look-ahead in which the backward pass settles. The blocks are at least
+        // one second long, so the look-ahead is a small part of what is read.
+        const int iLookAhead = iirFilter.getSettlingLength();
+        const fiff_int_t quantum = qMax(2 * iLookAhead, static_cast<int>(ceil(pFiffRawData->info.sfreq)));
+
+        SparseMatrix<double> mult;
+        RowVectorXi sel;
+        MatrixXd matData, times, matPicked, matState;
+        fiff_int_t first, last;
+
+        for(first = from; first <= to; first = last + 1) {
+            last = first + quantum - 1;
+
+            // A remainder shorter than the look-ahead is filtered with this block
+            if(to - last < iLookAhead) {
+                last = to;
+            }
+
+            const bool bLastBlock = last == to;
+            const fiff_int_t lastRead = qMin(last + iLookAhead, to);
+            const int iNumSamples = last - first + 1;
+
+            if (!pFiffRawData->read_raw_segment(matData, times, mult, first, lastRead, sel)) {
+                qWarning("[Filter::filterFileIir] Error during read_raw_segment\n");
+                return false;
+            }
+
+            qInfo() << "Filtering and writing block" << first << "to" << last;
+
+            if (first == from && first > 0) {
+                outfid->write_int(FIFF_FIRST_SAMPLE,&first);
+            }
+
+            matPicked.resize(vecPicksNew.cols(), matData.cols());
+            for(int i = 0; i < vecPicksNew.cols(); ++i) {
+                matPicked.row(i) = matData.row(vecPicksNew[i]);
+            }
+
+            matPicked = iirFilter.applyZeroPhaseBlock(matPicked, iNumSamples, matState, bLastBlock);
+
+            matData.conservativeResize(NoChange, iNumSamples);
+            for(int i = 0; i < vecPicksNew.cols(); ++i) {
+                matData.row(vecPicksNew[i]) = matPicked.row(i);
+            }
+
+            outfid->write_raw_buffer(matData, cals);
+        }
+
+        outfid->finish_writing_raw();
+
+        return true;
+    }
+}
+
 //=============================================================================================================
 // DEFINE GLOBAL RTPROCESSINGLIB METHODS
 //=============================================================================================================
@@ -121,10 +198,19 @@ bool RTPROCESSINGLIB::filterFile(QIODevice &pIODevice,
     fiff_int_t from = pFiffRawData->first_samp;
     fiff_int_t to = pFiffRawData->last_samp;
 
+    if(filterKernel.isIir()) {
+        return filterFileIir(outfid,
+                             pFiffRawData,
+                             filterKernel.getIirFilter(),
+                             vecPicks,
+                             cals);
+    }
+
     // slice input data into data junks with proper length so that the slices are always >= the filter order
     float fFactor = 2.0f;
     int iSize = fFactor * iOrder;
     int residual = (to - from) % iSize;
+
     while(residual < iOrder) {
         fFactor = fFactor - 0.1f;
         iSize = fFactor * iOrder;
@@ -204,6 +290,7 @@ MatrixXd RTPROCESSINGLIB::filterData(const MatrixXd& mataData,
                                      bool bUseThreads,
                                      bool bKeepOverhead)
 {
+    MNE_TRACE();
     // Check for size of data
     if(mataData.cols() < iOrder){
         qWarning() << QString("[Filter::filterData] Filter length/order is bigger than data length. Returning.");
@@ -240,6 +327,7 @@ MatrixXd RTPROCESSINGLIB::filterData(const MatrixXd& mataData,
                                      bool bUseThreads,
                                      bool bKeepOverhead)
 {
+    MNE_TRACE();
     int iOrder = filterKernel.getFilterOrder();
 
     // Check for size of data
@@ -248,57 +336,12 @@ MatrixXd RTPROCESSINGLIB::filterData(const MatrixXd& mataData,
         return mataData;
     }
 
-    // Create output matrix with size of input matrix
-    MatrixXd matDataOut(mataData.rows(), mataData.cols()+iOrder);
-    matDataOut.setZero();
-    MatrixXd sliceFiltered;
-
-    // slice input data into data junks with proper length so that the slices are always >= the filter order
-    float fFactor = 2.0f;
-    int iSize = fFactor * iOrder;
-    int residual = mataData.cols() % iSize;
-    while(residual < iOrder) {
-        fFactor = fFactor - 0.1f;
-        iSize = fFactor * iOrder;
-        residual = mataData.cols() % iSize;
-
-        if(iSize < iOrder) {
-            iSize = mataData.cols();
-            break;
-        }
-    }
-
-    if(mataData.cols() > iSize) {
-        int from = 0;
-        int numSlices = ceil(float(mataData.cols())/float(iSize)); //calculate number of data slices
-
-        for (int i = 0; i < numSlices; i++) {
-            if(i == numSlices-1) {
-                //catch the last one that might be shorter than the other blocks
-                iSize = mataData.cols() - (iSize * (numSlices -1));
-            }
-
-            // Filter the data block. This will return data with a fitler delay of iOrder/2 in front and back
-            sliceFiltered = filterDataBlock(mataData.block(0,from,mataData.rows(),iSize),
-                                            vecPicks,
-                                            filterKernel,
-                                            bUseThreads);
-
-            // Perform overlap add
-            if(i == 0) {
-                matDataOut.block(0,0,mataData.rows(),sliceFiltered.cols()) += sliceFiltered;
-            } else {
-                matDataOut.block(0,from,mataData.rows(),sliceFiltered.cols()) += sliceFiltered;
-            }
-
-            from += iSize;
-        }
-    } else {
-        matDataOut = filterDataBlock(mataData,
-                                     vecPicks,
-                                     filterKernel,
-                                     bUseThreads);
-    }
+    // Filter the whole block at once. The overlap-save convolution inside filterDataBlock already works on blocks
+    // matched to the filter length. This will return data with a filter delay of iOrder/2 in front and back.
+    MatrixXd matDataOut = filterDataBlock(mataData,
+                                          vecPicks,
+                                          filterKernel,
+                                          bUseThreads);
 
     if(bKeepOverhead) {
         return matDataOut;
@@ -322,26 +365,9 @@ MatrixXd RTPROCESSINGLIB::filterDataBlock(const MatrixXd& mataData,
         return mataData;
     }
 
-    // Setup filters to the correct length, so we do not have to do this everytime we call the FFT filter function
-    FilterKernel filterKernelSetup = filterKernel;
-    filterKernelSetup.prepareFilter(mataData.cols());
-
-    // Do the concurrent filtering
     RowVectorXi vecPicksNew = vecPicks;
     if(vecPicksNew.cols() == 0) {
-        vecPicksNew = RowVectorXi::LinSpaced(mataData.rows(), 0, mataData.rows());
-    }
-
-    // Generate QList structure which can be handled by the QConcurrent framework
-    QList<FilterObject> timeData;
-
-    // Only select channels specified in vecPicksNew
-    FilterObject data;
-    for(qint32 i = 0; i < vecPicksNew.cols(); ++i) {
-        data.filterKernel = filterKernelSetup;
-        data.iRow = vecPicksNew[i];
-        data.vecData = mataData.row(vecPicksNew[i]);
-        timeData.append(data);
+        vecPicksNew = RowVectorXi::LinSpaced(mataData.rows(), 0, mataData.rows() - 1);
     }
 
     // Copy in data from last data block. This is necessary in order to also delay channels which are not filtered
@@ -349,24 +375,28 @@ MatrixXd RTPROCESSINGLIB::filterDataBlock(const MatrixXd& mataData,
     matDataOut.setZero();
     matDataOut.block(0, iOrder/2, mataData.rows(), mataData.cols()) = mataData;
 
-    if(bUseThreads) {
-        QFuture<void> future = QtConcurrent::map(timeData,
-                                                 filterChannel);
-        future.waitForFinished();
-    } else {
-        for(int i = 0; i < timeData.size(); ++i) {
-            filterChannel(timeData[i]);
+    if(filterKernel.isIir()) {
+        // Offline IIR filtering runs forward and backward, which keeps the zero phase of the FIR path
+        MatrixXd matPicked(vecPicksNew.cols(), mataData.cols());
+        for(int i = 0; i < vecPicksNew.cols(); ++i) {
+            matPicked.row(i) = mataData.row(vecPicksNew[i]);
         }
-    }
 
-    // Do the overlap add method and store in matDataOut
-    RowVectorXd tempData;
+        matPicked = filterKernel.getIirFilter().applyZeroPhase(matPicked);
 
-    for(int r = 0; r < timeData.size(); r++) {
-        // Write the newly calculated filtered data to the filter data matrix. This data has a delay of iOrder/2 in front and back
-        matDataOut.row(timeData.at(r).iRow) = timeData.at(r).vecData;
+        for(int i = 0; i < vecPicksNew.cols(); ++i) {
+            matDataOut.block(vecPicksNew[i], iOrder/2, 1, mataData.cols()) = matPicked.row(i);
+        }
+
+        return matDataOut;
     }
 
+    // Overwrite the picked rows with the filtered data. This data has a delay of iOrder/2 in front and back
+    filterKernel.applyOverlapSave(mataData,
+                                  vecPicksNew,
+                                  matDataOut,
+                                  bUseThreads);
+
     return matDataOut;
 }
 
@@ -441,6 +471,13 @@ MatrixXd FilterOverlapAdd::calculate(const MatrixXd& mataData,
         return mataData;
     }
 
+    if(filterKernel.isIir()) {
+        return calculateIir(mataData,
+                            filterKernel,
+                            vecPicks,
+                            bKeepOverhead);
+    }
+
     // Init overlaps from last block
     if(m_matOverlapBack.cols() != iOrder || m_matOverlapBack.rows() < mataData.rows()) {
         m_matOverlapBack.resize(mataData.rows(), iOrder);
@@ -452,67 +489,16 @@ MatrixXd FilterOverlapAdd::calculate(const MatrixXd& mataData,
         m_matOverlapFront.setZero();
     }
 
-    // Create output matrix with size of input matrix
-    MatrixXd matDataOut(mataData.rows(), mataData.cols()+iOrder);
-    matDataOut.setZero();
-    MatrixXd sliceFiltered;
-
-    // slice input data into data junks with proper length so that the slices are always >= the filter order
-    float fFactor = 2.0f;
-    int iSize = fFactor * iOrder;
-    int residual = mataData.cols() % iSize;
-    while(residual < iOrder) {
-        fFactor = fFactor - 0.1f;
-        iSize = fFactor * iOrder;
-        residual = mataData.cols() % iSize;
-
-        if(iSize < iOrder) {
-            iSize = mataData.cols();
-            break;
-        }
-    }
-
-    if(mataData.cols() > iSize) {
-        int from = 0;
-        int numSlices = ceil(float(mataData.cols())/float(iSize)); //calculate number of data slices
-
-        for (int i = 0; i < numSlices; i++) {
-            if(i == numSlices-1) {
-                //catch the last one that might be shorter than the other blocks
-                iSize = mataData.cols() - (iSize * (numSlices -1));
-            }
-
-            // Filter the data block. This will return data with a fitler delay of iOrder/2 in front and back
-            sliceFiltered = filterDataBlock(mataData.block(0,from,mataData.rows(),iSize),
-                                            vecPicks,
-                                            filterKernel,
-                                            bUseThreads);
+    // Filter the data block. This will return data with a filter delay of iOrder/2 in front and back
+    MatrixXd matDataOut = filterDataBlock(mataData,
+                                          vecPicks,
+                                          filterKernel,
+                                          bUseThreads);
 
-            if(i == 0) {
-                matDataOut.block(0,0,mataData.rows(),sliceFiltered.cols()) += sliceFiltered;
-            } else {
-                matDataOut.block(0,from,mataData.rows(),sliceFiltered.cols()) += sliceFiltered;
-            }
-
-            if(bFilterEnd && (i == 0)) {
-                matDataOut.block(0,0,matDataOut.rows(),iOrder) += m_matOverlapBack;
-            } else if (!bFilterEnd && (i == numSlices-1)) {
-                matDataOut.block(0,matDataOut.cols()-iOrder,matDataOut.rows(),iOrder) += m_matOverlapFront;
-            }
-
-            from += iSize;
-        }
+    if(bFilterEnd) {
+        matDataOut.block(0,0,matDataOut.rows(),iOrder) += m_matOverlapBack.topRows(matDataOut.rows());
     } else {
-        matDataOut = filterDataBlock(mataData,
-                                     vecPicks,
-                                     filterKernel,
-                                     bUseThreads);
-
-        if(bFilterEnd) {
-            matDataOut.block(0,0,matDataOut.rows(),iOrder) += m_matOverlapBack;
-        } else {
-            matDataOut.block(0,matDataOut.cols()-iOrder,matDataOut.rows(),iOrder) += m_matOverlapFront;
-        }
+        matDataOut.block(0,matDataOut.cols()-iOrder,matDataOut.rows(),iOrder) += m_matOverlapFront.topRows(matDataOut.rows());
     }
 
     // Refresh the overlap matrix with the new calculated filtered data
@@ -528,8 +514,46 @@ MatrixXd FilterOverlapAdd::calculate(const MatrixXd& mataData,
 
 //=============================================================================================================
 
+MatrixXd FilterOverlapAdd::calculateIir(const MatrixXd& mataData,
+                                        const FilterKernel& filterKernel,
+                                        const RowVectorXi& vecPicks,
+                                        bool bKeepOverhead)
+{
+    MatrixXd matSos = filterKernel.getSos();
+    if(m_iirFilter.getSos().rows() != matSos.rows() || m_iirFilter.getSos() != matSos) {
+        m_iirFilter = filterKernel.getIirFilter();
+    }
+
+    RowVectorXi vecPicksNew = vecPicks;
+    if(vecPicksNew.cols() == 0) {
+        vecPicksNew = RowVectorXi::LinSpaced(mataData.rows(), 0, mataData.rows() - 1);
+    }
+
+    MatrixXd matPicked(vecPicksNew.cols(), mataData.cols());
+    for(int i = 0; i < vecPicksNew.cols(); ++i) {
+        matPicked.row(i) = mataData.row(vecPicksNew[i]);
+    }
+
+    m_iirFilter.apply(matPicked);
+
+    // The causal result is not delayed, the overhead of the FIR layout stays empty
+    const int iOverhead = bKeepOverhead ? filterKernel.getFilterOrder() : 0;
+
+    MatrixXd matDataOut = MatrixXd::Zero(mataData.rows(), mataData.cols() + iOverhead);
+    matDataOut.leftCols(mataData.cols()) = mataData;
+
+    for(int i = 0; i < vecPicksNew.cols(); ++i) {
+        matDataOut.block(vecPicksNew[i], 0, 1, mataData.cols()) = matPicked.row(i);
+    }
+
+    return matDataOut;
+}
+
+//=============================================================================================================
+
 void FilterOverlapAdd::reset()
 {
     m_matOverlapBack.resize(0,0);
     m_matOverlapFront.resize(0,0);
+    m_iirFilter.reset();
 }
@@ -114,7 +114,7 @@ RTPROCESINGSHARED_EXPORT bool filterFile(QIODevice& pIODevice,
 //=========================================================================================================
 /**
  * Filters data from an input file based on an exisiting filter kernel and writes the filtered data to a
- * pIODevice.
+ * pIODevice. IIR kernels are applied forward and backward with zero phase, one block of at least a second at a time.
  *
  * @param[in] pIODevice            The IO device to write to.
  * @param[in] pFiffRawData         The fiff raw data object to read from.
@@ -165,6 +165,7 @@ RTPROCESINGSHARED_EXPORT Eigen::MatrixXd filterData(const Eigen::MatrixXd& matDa
 /**
  * Calculates the filtered version of the raw input data based on a given list filters
  * The data needs to be present all at once. For continous filtering via overlap add use the FilterOverlapAdd class.
+ * IIR kernels are applied forward and backward with zero phase.
  *
  * @param[in] mataData         The data which is to be filtered.
  * @param[in] filterKernel     The list of filter kernels to use.
@@ -208,7 +209,8 @@ RTPROCESINGSHARED_EXPORT void filterChannel(FilterObject &channelDataTime);
 //=============================================================================================================
 /**
  * Filtering with FFT convolution and the overlap add method for continous data streams. This class will hold
- * all needed information about the last block in order to overlap it with the current one.
+ * all needed information about the last block in order to overlap it with the current one. IIR kernels are
+ * applied causally instead, with their state kept between blocks and without the delay of the FIR path.
  *
  * @brief Filtering with FFT convolution and the overlap add method for continous data streams.
  */
@@ -272,13 +274,30 @@ public:
 
     //=========================================================================================================
     /**
-     * Reset the stored overlap matrices
+     * Reset the stored overlap matrices and the IIR filter state
      */
     void reset();
 
 private:
+    //=========================================================================================================
+    /**
+     * Filters the picked rows with the causal IIR filter of filterKernel, continuing from the last block.
+     *
+     * @param[in] mataData         The data which is to be filtered.
+     * @param[in] filterKernel     The IIR filter kernel.
+     * @param[in] vecPicks         Channel indexes to filter. Empty to filter all channels.
+     * @param[in] bKeepOverhead    Whether to append the (empty) overhead of the FIR layout.
+     *
+     * @return The filtered data in form of a matrix.
+     */
+    Eigen::MatrixXd calculateIir(const Eigen::MatrixXd& mataData,
+                                 const RTPROCESSINGLIB::FilterKernel& filterKernel,
+                                 const Eigen::RowVectorXi& vecPicks,
+                                 bool bKeepOverhead);
+
     Eigen::MatrixXd                 m_matOverlapBack;                   /**< Overlap block for the end of the data block. */
     Eigen::MatrixXd                 m_matOverlapFront;                  /**< Overlap block for the beginning of the data block. */
+    RTPROCESSINGLIB::IirFilter      m_iirFilter;                        /**< Streaming state of IIR kernels. */
 };
 
 //=============================================================================================================
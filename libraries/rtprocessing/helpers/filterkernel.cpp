@@ -46,18 +46,22 @@
 #include "cosinefilter.h"
 
 #include <iostream>
+#include <limits>
 
 //=============================================================================================================
 // QT INCLUDES
 //=============================================================================================================
 
 #include <QDebug>
+#include <QThread>
+#include <QtConcurrent/QtConcurrent>
 
 //=============================================================================================================
 // EIGEN INCLUDES
 //=============================================================================================================
 
 #include <Eigen/SparseCore>
+#include <Eigen/Dense>
 //#ifndef EIGEN_FFTW_DEFAULT
 //#define EIGEN_FFTW_DEFAULT
 //#endif
@@ -73,13 +77,25 @@ using namespace UTILSLIB;
 
 
 
+//=============================================================================================================
+// DEFINE GLOBAL METHODS
+//=============================================================================================================
+
+namespace {
+
+const int IIR_RESPONSE_LENGTH = 4096;   /**< Number of impulse response samples stored for IIR kernels. */
+
+} // namespace
+
 //=============================================================================================================
 // INIT STATIC MEMBERS
 //=============================================================================================================
 
 QVector<RTPROCESSINGLIB::FilterParameter> FilterKernel::m_designMethods ({
     FilterParameter(QString("Cosine"), QString("A cosine filter")),
-    FilterParameter(QString("Tschebyscheff"), QString("A tschebyscheff filter"))
+    FilterParameter(QString("Tschebyscheff"), QString("A tschebyscheff filter")),
+    FilterParameter(QString("Butterworth"), QString("A Butterworth IIR filter")),
+    FilterParameter(QString("Chebyshev"), QString("A Chebyshev type I IIR filter"))
 //    FilterParameter(QString("External"), QString("An external filter"))
 });
 QVector<RTPROCESSINGLIB::FilterParameter> FilterKernel::m_filterTypes ({
@@ -106,6 +122,7 @@ FilterKernel::FilterKernel()
 , m_iFilterType(m_filterTypes.indexOf(FilterParameter("BPF")))
 , m_sFilterName("Unknown")
 , m_sFilterShortDescription("")
+, m_iOlsFftLength(0)
 {
     designFilter();
 }
@@ -129,8 +146,9 @@ FilterKernel::FilterKernel(const QString& sFilterName,
 , m_iFilterType(iFilterType)
 , m_sFilterName(sFilterName)
 , m_sFilterShortDescription()
+, m_iOlsFftLength(0)
 {
-    if(iOrder < 9) {
+    if(iOrder < 9 && !isIirDesignMethod(iDesignMethod)) {
        qWarning() << "[FilterKernel::FilterKernel] Less than 9 taps were provided. Setting number of taps to 9.";
     }
 
@@ -228,6 +246,158 @@ void FilterKernel::applyFftFilter(RowVectorXd& vecData,
 
 //=============================================================================================================
 
+void FilterKernel::applyOverlapSave(const MatrixXd& matData,
+                                    const RowVectorXi& vecPicks,
+                                    MatrixXd& matDataOut,
+                                    bool bUseThreads) const
+{
+    #ifdef EIGEN_FFTW_DEFAULT
+    fftw_make_planner_thread_safe();
+    #endif
+
+    const int iNumTaps = m_vecCoeff.cols();
+    const int iNumSamples = matData.cols();
+
+    if(iNumTaps == 0 || iNumSamples == 0 || vecPicks.cols() == 0) {
+        return;
+    }
+
+    // Full linear convolution, cut to the preallocated output
+    const int iOutputLength = std::min(iNumSamples + iNumTaps - 1, static_cast<int>(matDataOut.cols()));
+
+    // Blocks longer than the whole convolution do not pay off. Transform the coefficients for shorter blocks once
+    // here, before the threads start.
+    int iFftLength = m_iOlsFftLength;
+    RowVectorXcd vecFftCoeffShort;
+    const RowVectorXcd* pFftCoeff = &m_vecOlsFftCoeff;
+
+    int iMinFftLength = pow(2, ceil(MNEMath::log2(iNumSamples + iNumTaps - 1)));
+    if(iFftLength == 0 || iMinFftLength < iFftLength) {
+        iFftLength = iMinFftLength;
+
+        Eigen::FFT<double> fft;
+        fft.SetFlag(fft.HalfSpectrum);
+
+        RowVectorXd vecCoeffPadded = RowVectorXd::Zero(iFftLength);
+        vecCoeffPadded.head(iNumTaps) = m_vecCoeff;
+        fft.fwd(vecFftCoeffShort, vecCoeffPadded, iFftLength);
+        pFftCoeff = &vecFftCoeffShort;
+    }
+
+    const RowVectorXcd& vecFftCoeff = *pFftCoeff;
+    const int iBlockStep = iFftLength - iNumTaps + 1;
+
+    // Split the channels into batches. Each batch creates its FFT plan and buffers once.
+    int iNumBatches = bUseThreads ? std::min(static_cast<int>(vecPicks.cols()), 4 * QThread::idealThreadCount()) : 1;
+    iNumBatches = std::max(iNumBatches, 1);
+    int iBatchSize = (vecPicks.cols() + iNumBatches - 1) / iNumBatches;
+
+    QVector<QPair<int,int> > lBatches;
+    for(int i = 0; i < vecPicks.cols(); i += iBatchSize) {
+        lBatches.append(qMakePair(i, std::min(i + iBatchSize, static_cast<int>(vecPicks.cols()))));
+    }
+
+    auto filterBatch = [&](const QPair<int,int>& batch) {
+        Eigen::FFT<double> fft;
+        fft.SetFlag(fft.HalfSpectrum);
+
+        RowVectorXd vecRow(iNumSamples);
+        RowVectorXd vecBlock(iFftLength);
+        RowVectorXcd vecFreqData(iFftLength/2+1);
+
+        for(int p = batch.first; p < batch.second; ++p) {
+            const int iRow = vecPicks[p];
+            vecRow = matData.row(iRow);
+
+            // The output sample o depends on the input samples o-iNumTaps+1 to o
+            for(int o = 0; o < iOutputLength; o += iBlockStep) {
+                const int iStart = o - iNumTaps + 1;
+                const int iFirst = std::max(0, -iStart);
+                const int iLast = std::max(iFirst, std::min(iFftLength, iNumSamples - iStart));
+
+                vecBlock.head(iFirst).setZero();
+                vecBlock.segment(iFirst, iLast - iFirst) = vecRow.segment(iStart + iFirst, iLast - iFirst);
+                vecBlock.tail(iFftLength - iLast).setZero();
+
+                fft.fwd(vecFreqData.data(), vecBlock.data(), iFftLength);
+                vecFreqData.array() *= vecFftCoeff.array();
+                fft.inv(vecBlock.data(), vecFreqData.data(), iFftLength);
+
+                // The first iNumTaps-1 samples are corrupted by the circular wrap-around
+                const int iLength = std::min(iBlockStep, iOutputLength - o);
+                matDataOut.row(iRow).segment(o, iLength) = vecBlock.segment(iNumTaps - 1, iLength);
+            }
+
+            if(iOutputLength < matDataOut.cols()) {
+                matDataOut.row(iRow).tail(matDataOut.cols() - iOutputLength).setZero();
+            }
+        }
+    };
+
+    if(bUseThreads && lBatches.size() > 1) {
+        QFuture<void> future = QtConcurrent::map(lBatches,
+                                                 filterBatch);
+        future.waitForFinished();
+    } else {
+        for(int i = 0; i < lBatches.size(); ++i) {
+            filterBatch(lBatches.at(i));
+        }
+    }
+}
+
+//=============================================================================================================
+
+int FilterKernel::getOptimalFftLength(int iNumTaps)
+{
+    int iBestLength = pow(2, ceil(MNEMath::log2(std::max(2 * iNumTaps, 2))));
+    double dBestCost = std::numeric_limits<double>::max();
+
+    // Cost per output sample of one forward and one inverse FFT of length M, which yield M - iNumTaps + 1 samples
+    for(int iLength = iBestLength; iLength <= (1 << 22); iLength *= 2) {
+        double dCost = iLength * MNEMath::log2(iLength) / (iLength - iNumTaps + 1);
+
+        if(dCost < dBestCost) {
+            dBestCost = dCost;
+            iBestLength = iLength;
+        } else {
+            break;
+        }
+    }
+
+    return iBestLength;
+}
+
+//=============================================================================================================
+
+bool FilterKernel::isIir() const
+{
+    return m_matSos.rows() > 0;
+}
+
+//=============================================================================================================
+
+bool FilterKernel::isIirDesignMethod(int iDesignMethod)
+{
+    return iDesignMethod == m_designMethods.indexOf(FilterParameter("Butterworth"))
+            || iDesignMethod == m_designMethods.indexOf(FilterParameter("Chebyshev"));
+}
+
+//=============================================================================================================
+
+MatrixXd FilterKernel::getSos() const
+{
+    return m_matSos;
+}
+
+//=============================================================================================================
+
+IirFilter FilterKernel::getIirFilter() const
+{
+    return IirFilter(m_matSos);
+}
+
+//=============================================================================================================
+
 QString FilterKernel::getName() const
 {
     return m_sFilterName;
@@ -350,6 +520,8 @@ Eigen::RowVectorXd FilterKernel::getCoefficients() const
 void FilterKernel::setCoefficients(const Eigen::RowVectorXd& vecCoeff)
 {
     m_vecCoeff = vecCoeff;
+    m_matSos.resize(0,0);
+    prepareOverlapSave();
 }
 
 //=============================================================================================================
@@ -473,6 +645,26 @@ void FilterKernel::designFilter()
 
             break;
         }
+
+        case 2:
+        case 3: {
+            m_matSos = IirFilter::designSos(m_iFilterType,
+                                            m_iFilterOrder,
+                                            m_dCenterFreq,
+                                            m_dBandwidth,
+                                            m_iDesignMethod == 2 ? IirFilter::Butterworth : IirFilter::Chebyshev);
+
+            //Keep a truncated impulse response for display and export and the exact frequency response for plotting
+            IirFilter iirFilter(m_matSos);
+            m_vecCoeff = iirFilter.getImpulseResponse(IIR_RESPONSE_LENGTH);
+            m_vecFftCoeff = iirFilter.getFrequencyResponse(IIR_RESPONSE_LENGTH/2+1);
+
+            break;
+        }
+    }
+
+    if(!isIir()) {
+        prepareOverlapSave();
     }
 
     switch(m_iFilterType) {
@@ -496,6 +688,26 @@ void FilterKernel::designFilter()
 
 //=============================================================================================================
 
+void FilterKernel::prepareOverlapSave()
+{
+    if(m_vecCoeff.cols() == 0) {
+        m_iOlsFftLength = 0;
+        m_vecOlsFftCoeff.resize(0);
+        return;
+    }
+
+    m_iOlsFftLength = getOptimalFftLength(m_vecCoeff.cols());
+
+    Eigen::FFT<double> fft;
+    fft.SetFlag(fft.HalfSpectrum);
+
+    RowVectorXd vecCoeffPadded = RowVectorXd::Zero(m_iOlsFftLength);
+    vecCoeffPadded.head(m_vecCoeff.cols()) = m_vecCoeff;
+    fft.fwd(m_vecOlsFftCoeff, vecCoeffPadded, m_iOlsFftLength);
+}
+
+//=============================================================================================================
+
 QString FilterKernel::getShortDescription() const
 {
     QString description(m_designMethods.at(m_iDesignMethod).getName() + "  -  " + \
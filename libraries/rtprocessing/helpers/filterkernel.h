@@ -52,6 +52,7 @@
 //=============================================================================================================
 
 #include "../rtprocessing_global.h"
+#include "iirfilter.h"
 //#include "filter.h"
 
 //=============================================================================================================
@@ -125,7 +126,8 @@ protected:
 
 //=============================================================================================================
 /**
- * The FilterKernel class provides methods to create/design a FIR filter kernel
+ * The FilterKernel class provides methods to create/design a FIR filter kernel. The Butterworth and Chebyshev
+ * design methods yield IIR kernels instead, which are applied via IirFilter.
  *
  * @brief The FilterKernel class provides methods to create/design a FIR filter kernel
  */
@@ -199,6 +201,65 @@ public:
     void applyFftFilter(Eigen::RowVectorXd& vecData,
                         bool bKeepOverhead = false);
 
+    //=========================================================================================================
+    /**
+     * Applies the current filter to the rows vecPicks of matData using overlap-save FFT convolution with a fixed
+     * block length chosen from the number of taps (see getOptimalFftLength). The kernel spectrum is computed once
+     * and shared read-only by all threads. Every thread filters a batch of channels with a single FFT plan and one
+     * set of buffers.
+     * @param[in] matData          Holds the data to be filtered (channels x samples).
+     * @param[in] vecPicks         The rows to filter.
+     * @param[out] matDataOut      The preallocated result with matData.cols() + getFilterOrder() columns. Picked
+     *                              rows receive the filtered data including the overhead of half the filter length
+     *                              in front and back. All other rows are left untouched.
+     * @param[in] bUseThreads      Whether to filter batches of channels in parallel. Default is set to true.
+     */
+    void applyOverlapSave(const Eigen::MatrixXd& matData,
+                          const Eigen::RowVectorXi& vecPicks,
+                          Eigen::MatrixXd& matDataOut,
+                          bool bUseThreads = true) const;
+
+    //=========================================================================================================
+    /**
+     * Returns the power of two FFT length for overlap-save filtering which minimizes the cost per output sample,
+     * M*log2(M)/(M - iNumTaps + 1).
+     * @param[in] iNumTaps         The number of filter taps.
+     * @return the FFT length.
+     */
+    static int getOptimalFftLength(int iNumTaps);
+
+    //=========================================================================================================
+    /**
+     * Returns whether this kernel holds an IIR filter (Butterworth or Chebyshev design). IIR kernels hold
+     * second-order sections, see getSos() and getIirFilter(). Their order is the order of the analog prototype.
+     * The coefficients only hold a truncated impulse response for display and export, the FIR application methods
+     * of this class must not be used with IIR kernels.
+     *
+     * @return Whether this is an IIR kernel.
+     */
+    bool isIir() const;
+
+    //=========================================================================================================
+    /**
+     * @param[in] iDesignMethod    The design method (index into m_designMethods).
+     *
+     * @return Whether the design method yields an IIR filter.
+     */
+    static bool isIirDesignMethod(int iDesignMethod);
+
+    //=========================================================================================================
+    /**
+     * @return The second-order sections of an IIR kernel, one row [b0 b1 b2 a0 a1 a2] per section. Empty for FIR
+     *         kernels.
+     */
+    Eigen::MatrixXd getSos() const;
+
+    //=========================================================================================================
+    /**
+     * @return A new IirFilter with cleared state running the second-order sections of this kernel.
+     */
+    IirFilter getIirFilter() const;
+
     QString getName() const;
     void setName(const QString& sFilterName);
 
@@ -255,6 +316,12 @@ private:
      */
     void designFilter();
 
+    //=========================================================================================================
+    /**
+     * Transforms the filter coefficients for overlap-save filtering with getOptimalFftLength()
+     */
+    void prepareOverlapSave();
+
 
     double          m_sFreq;                /**< the sampling frequency. */
     double          m_dCenterFreq;          /**< contains center freq of the filter. */
@@ -272,6 +339,9 @@ private:
 
     Eigen::RowVectorXd     m_vecCoeff;       /**< contains the forward filter coefficient set. */
     Eigen::RowVectorXcd    m_vecFftCoeff;    /**< the FFT-transformed forward filter coefficient set, required for frequency-domain filtering, zero-padded to m_iFftLength. */
+    Eigen::RowVectorXcd    m_vecOlsFftCoeff; /**< the FFT-transformed forward filter coefficient set for overlap-save filtering, zero-padded to m_iOlsFftLength. */
+    int                    m_iOlsFftLength;  /**< the FFT length of the overlap-save blocks. */
+    Eigen::MatrixXd        m_matSos;         /**< the second-order sections of IIR kernels, empty for FIR kernels. */
 };
 
 } // NAMESPACE RTPROCESSINGLIB
@@ -0,0 +1,585 @@
+//=============================================================================================================
+/**
+ * @file     iirfilter.cpp
+ * @author   agent <agent@local>
+ * @since    0.1.9
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, agent. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    Definition of the IirFilter class.
+ *
+ */
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include "iirfilter.h"
+
+#include <complex>
+#include <vector>
+#include <cmath>
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QDebug>
+#include <QList>
+
+//=============================================================================================================
+// EIGEN INCLUDES
+//=============================================================================================================
+
+#include <Eigen/Dense>
+
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace RTPROCESSINGLIB;
+using namespace Eigen;
+
+//=============================================================================================================
+// DEFINE GLOBAL METHODS
+//=============================================================================================================
+
+namespace {
+
+typedef std::complex<double> Complex;
+typedef std::vector<Complex> ComplexList;
+
+const double COMPLEX_TOLERANCE = 1e-10;
+
+//=============================================================================================================
+
+Complex product(const ComplexList& list,
+                const Complex& shift,
+                double dSign)
+{
+    Complex result(1.0, 0.0);
+    for(const Complex& value : list) {
+        result *= shift + dSign * value;
+    }
+    return result;
+}
+
+//=============================================================================================================
+
+bool isReal(const Complex& value)
+{
+    return std::abs(value.imag()) <= COMPLEX_TOLERANCE * std::max(1.0, std::abs(value));
+}
+
+//=============================================================================================================
+
+int takeNearest(ComplexList& list,
+                const Complex& target,
+                bool bRealOnly)
+{
+    int iBest = -1;
+    double dBestDist = 0.0;
+
+    for(int i = 0; i < static_cast<int>(list.size()); ++i) {
+        if(bRealOnly && !isReal(list[i])) {
+            continue;
+        }
+        double dDist = std::abs(list[i] - target);
+        if(iBest < 0 || dDist < dBestDist) {
+            iBest = i;
+            dBestDist = dDist;
+        }
+    }
+
+    return iBest;
+}
+
+//=============================================================================================================
+
+Complex takeAt(ComplexList& list,
+               int iIndex)
+{
+    Complex value = list[iIndex];
+    list.erase(list.begin() + iIndex);
+    return value;
+}
+
+//=============================================================================================================
+
+void analogPrototype(int iOrder,
+                     int iDesignMethod,
+                     double dRipple,
+                     ComplexList& p,
+                     double& k)
+{
+    p.clear();
+
+    if(iDesignMethod == IirFilter::Chebyshev) {
+        double eps = std::sqrt(std::pow(10.0, dRipple / 10.0) - 1.0);
+        double mu = std::asinh(1.0 / eps) / iOrder;
+
+        for(int m = -iOrder + 1; m < iOrder; m += 2) {
+            p.push_back(-std::sinh(Complex(mu, M_PI * m / (2.0 * iOrder))));
+        }
+
+        k = product(p, 0.0, -1.0).real();
+        if(iOrder % 2 == 0) {
+            k /= std::sqrt(1.0 + eps * eps);
+        }
+    } else {
+        for(int m = -iOrder + 1; m < iOrder; m += 2) {
+            p.push_back(-std::exp(Complex(0.0, M_PI * m / (2.0 * iOrder))));
+        }
+
+        k = 1.0;
+    }
+}
+
+//=============================================================================================================
+
+MatrixXd zpkToSos(ComplexList z,
+                  ComplexList p,
+                  double k)
+{
+    QList<RowVectorXd> lSections;
+
+    // Build the sections starting with the poles closest to the unit circle, pairing each with its nearest zeros
+    while(!p.empty()) {
+        int iFirst = 0;
+        for(int i = 1; i < static_cast<int>(p.size()); ++i) {
+            if(std::abs(std::abs(p[i]) - 1.0) < std::abs(std::abs(p[iFirst]) - 1.0)) {
+                iFirst = i;
+            }
+        }
+        Complex p1 = takeAt(p, iFirst);
+        Complex p2(0.0, 0.0);
+        bool bSecondOrder = true;
+
+        if(!isReal(p1)) {
+            p2 = takeAt(p, takeNearest(p, std::conj(p1), false));
+        } else {
+            int iSecond = takeNearest(p, p1, true);
+            if(iSecond >= 0) {
+                p2 = takeAt(p, iSecond);
+            } else {
+                bSecondOrder = false;
+            }
+        }
+
+        Complex z1(0.0, 0.0);
+        Complex z2(0.0, 0.0);
+        int iZero = takeNearest(z, p1, !bSecondOrder);
+        if(iZero >= 0) {
+            z1 = takeAt(z, iZero);
+            if(bSecondOrder) {
+                iZero = isReal(z1) ? takeNearest(z, p1, true) : takeNearest(z, std::conj(z1), false);
+                if(iZero < 0) {
+                    iZero = takeNearest(z, p1, false);
+                }
+                if(iZero >= 0) {
+                    z2 = takeAt(z, iZero);
+                }
+            }
+        }
+
+        RowVectorXd vecSection(6);
+        if(bSecondOrder) {
+            vecSection << 1.0, -(z1 + z2).real(), (z1 * z2).real(),
+                          1.0, -(p1 + p2).real(), (p1 * p2).real();
+        } else {
+            vecSection << 1.0, -z1.real(), 0.0,
+                          1.0, -p1.real(), 0.0;
+        }
+        lSections.prepend(vecSection);
+    }
+
+    MatrixXd matSos(lSections.size(), 6);
+    for(int i = 0; i < lSections.size(); ++i) {
+        matSos.row(i) = lSections.at(i);
+    }
+
+    if(matSos.rows() > 0) {
+        matSos.block(0, 0, 1, 3) *= k;
+    }
+
+    return matSos;
+}
+
+} // namespace
+
+//=============================================================================================================
+// DEFINE MEMBER METHODS
+//=============================================================================================================
+
+IirFilter::IirFilter()
+{
+}
+
+//=============================================================================================================
+
+IirFilter::IirFilter(int iFilterType,
+                     int iOrder,
+                     double dCenterfreq,
+                     double dBandwidth,
+                     int iDesignMethod,
+                     double dRipple)
+: m_matSos(designSos(iFilterType,
+                     iOrder,
+                     dCenterfreq,
+                     dBandwidth,
+                     iDesignMethod,
+                     dRipple))
+{
+}
+
+//=============================================================================================================
+
+IirFilter::IirFilter(const MatrixXd& matSos)
+: m_matSos(matSos)
+{
+}
+
+//=============================================================================================================
+
+MatrixXd IirFilter::designSos(int iFilterType,
+                              int iOrder,
+                              double dCenterfreq,
+                              double dBandwidth,
+                              int iDesignMethod,
+                              double dRipple)
+{
+    // Band edges normed to nyquist, the filter types follow FilterKernel::m_filterTypes
+    double dLow = dCenterfreq - dBandwidth / 2.0;
+    double dHigh = dCenterfreq + dBandwidth / 2.0;
+    bool bBand = (iFilterType == 2 || iFilterType == 3);
+
+    if(iOrder < 1 || iFilterType < 0 || iFilterType > 3
+       || (!bBand && (dCenterfreq <= 0.0 || dCenterfreq >= 1.0))
+       || (bBand && (dLow <= 0.0 || dHigh >= 1.0 || dBandwidth <= 0.0))) {
+        qWarning() << "[IirFilter::designSos] Invalid filter parameters. Returning empty filter.";
+        return MatrixXd();
+    }
+
+    ComplexList z;
+    ComplexList p;
+    double k;
+    analogPrototype(iOrder, iDesignMethod, dRipple, p, k);
+
+    // Pre-warp the frequencies for the bilinear transform with a sampling frequency of 2
+    const double fs2 = 4.0;
+    int iDegree = p.size() - z.size();
+
+    switch(iFilterType) {
+        case 0: {
+            double wo = fs2 * std::tan(M_PI * dCenterfreq / 2.0);
+            for(Complex& value : p) {
+                value *= wo;
+            }
+            k *= std::pow(wo, iDegree);
+            break;
+        }
+
+        case 1: {
+            double wo = fs2 * std::tan(M_PI * dCenterfreq / 2.0);
+            k *= (product(z, 0.0, -1.0) / product(p, 0.0, -1.0)).real();
+            for(Complex& value : p) {
+                value = wo / value;
+            }
+            z.assign(iDegree, Complex(0.0, 0.0));
+            break;
+        }
+
+        case 2:
+        case 3: {
+            double w1 = fs2 * std::tan(M_PI * dLow / 2.0);
+            double w2 = fs2 * std::tan(M_PI * dHigh / 2.0);
+            double bw = w2 - w1;
+            double wo = std::sqrt(w1 * w2);
+
+            if(iFilterType == 3) {
+                k *= (product(z, 0.0, -1.0) / product(p, 0.0, -1.0)).real();
+            } else {
+                k *= std::pow(bw, iDegree);
+            }
+
+            ComplexList pNew;
+            for(const Complex& value : p) {
+                Complex scaled = (iFilterType == 3) ? (bw / 2.0) / value : value * bw / 2.0;
+                Complex root = std::sqrt(scaled * scaled - wo * wo);
+                pNew.push_back(scaled + root);
+                pNew.push_back(scaled - root);
+            }
+            p = pNew;
+
+            z.clear();
+            for(int i = 0; i < iDegree; ++i) {
+                if(iFilterType == 3) {
+                    z.push_back(Complex(0.0, wo));
+                    z.push_back(Complex(0.0, -wo));
+                } else {
+                    z.push_back(Complex(0.0, 0.0));
+                }
+            }
+            break;
+        }
+    }
+
+    // Bilinear transform, zeros at infinity map to nyquist
+    iDegree = p.size() - z.size();
+    k *= (product(z, fs2, -1.0) / product(p, fs2, -1.0)).real();
+    for(Complex& value : z) {
+        value = (fs2 + value) / (fs2 - value);
+    }
+    for(Complex& value : p) {
+        value = (fs2 + value) / (fs2 - value);
+    }
+    z.insert(z.end(), iDegree, Complex(-1.0, 0.0));
+
+    return zpkToSos(z, p, k);
+}
+
+//=============================================================================================================
+
+void IirFilter::apply(MatrixXd& matData)
+{
+    if(m_matSos.rows() == 0) {
+        return;
+    }
+
+    if(m_matState.rows() != matData.rows() || m_matState.cols() != 2 * m_matSos.rows()) {
+        m_matState = MatrixXd::Zero(matData.rows(), 2 * m_matSos.rows());
+    }
+
+    filterInPlace(matData, m_matState);
+}
+
+//=============================================================================================================
+
+MatrixXd IirFilter::applyZeroPhase(const MatrixXd& matData) const
+{
+    MatrixXd matState;
+
+    return applyZeroPhaseBlock(matData, matData.cols(), matState, true);
+}
+
+//=============================================================================================================
+
+MatrixXd IirFilter::applyZeroPhaseBlock(const MatrixXd& matData,
+                                        int iNumSamples,
+                                        MatrixXd& matState,
+                                        bool bLastBlock) const
+{
+    const int iNumCols = matData.cols();
+
+    if(m_matSos.rows() == 0 || iNumCols < 2) {
+        return matData.leftCols(iNumSamples);
+    }
+
+    // Odd extension at the edges of the recording
+    const int iPad = std::min(3 * (2 * static_cast<int>(m_matSos.rows()) + 1), iNumCols - 1);
+    const bool bFirstBlock = matState.rows() != matData.rows() || matState.cols() != 2 * m_matSos.rows();
+    const int iFront = bFirstBlock ? iPad : 0;
+    const int iBack = bLastBlock ? iPad : 0;
+
+    MatrixXd matExt(matData.rows(), iFront + iNumCols + iBack);
+    matExt.middleCols(iFront, iNumCols) = matData;
+    for(int i = 0; i < iFront; ++i) {
+        matExt.col(iFront - 1 - i) = 2.0 * matData.col(0) - matData.col(i + 1);
+    }
+    for(int i = 0; i < iBack; ++i) {
+        matExt.col(iFront + iNumCols + i) = 2.0 * matData.col(iNumCols - 1) - matData.col(iNumCols - 2 - i);
+    }
+
+    RowVectorXd vecStepState = stepState();
+
+    if(bFirstBlock) {
+        matState = matExt.col(0) * vecStepState;
+    }
+
+    // Forward pass, the state carried to the next block is the one at the end of this block
+    const int iBlockCols = iFront + iNumSamples;
+    MatrixXd matBlock = matExt.leftCols(iBlockCols);
+    filterInPlace(matBlock, matState);
+
+    MatrixXd matAhead = matExt.rightCols(matExt.cols() - iBlockCols);
+    MatrixXd matAheadState = matState;
+    filterInPlace(matAhead, matAheadState);
+
+    matExt.leftCols(iBlockCols) = matBlock;
+    matExt.rightCols(matAhead.cols()) = matAhead;
+
+    // Backward pass
+    matExt = matExt.rowwise().reverse().eval();
+    MatrixXd matBackState = matExt.col(0) * vecStepState;
+    filterInPlace(matExt, matBackState);
+
+    return matExt.rowwise().reverse().middleCols(iFront, iNumSamples);
+}
+
+//=============================================================================================================
+
+int IirFilter::getSettlingLength(double dTolerance) const
+{
+    const int iMinLength = 3 * (2 * static_cast<int>(m_matSos.rows()) + 1) + 1;
+    const int iChunk = 1024;
+    const int iMaxLength = 1 << 24;
+
+    if(m_matSos.rows() == 0) {
+        return iMinLength;
+    }
+
+    // Run the impulse response chunk by chunk until a whole chunk stays below the tolerance
+    MatrixXd matImpulse = MatrixXd::Zero(1, iChunk);
+    matImpulse(0,0) = 1.0;
+    MatrixXd matState = MatrixXd::Zero(1, 2 * m_matSos.rows());
+
+    double dPeak = 0.0;
+    int iLength = 0;
+
+    for(int iOffset = 0; iOffset < iMaxLength; iOffset += iChunk) {
+        filterInPlace(matImpulse, matState);
+        dPeak = std::max(dPeak, matImpulse.cwiseAbs().maxCoeff());
+
+        bool bSettled = true;
+        for(int n = 0; n < iChunk; ++n) {
+            if(std::abs(matImpulse(0,n)) >= dTolerance * dPeak) {
+                iLength = iOffset + n + 1;
+                bSettled = false;
+            }
+        }
+
+        if(bSettled) {
+            break;
+        }
+
+        matImpulse.setZero();
+    }
+
+    return std::max(iLength, iMinLength);
+}
+
+//=============================================================================================================
+
+RowVectorXcd IirFilter::getFrequencyResponse(int iNumFreqs) const
+{
+    RowVectorXcd vecResponse = RowVectorXcd::Ones(iNumFreqs);
+
+    for(int i = 0; i < iNumFreqs; ++i) {
+        double w = iNumFreqs > 1 ? M_PI * i / (iNumFreqs - 1) : 0.0;
+        Complex e1 = std::exp(Complex(0.0, -w));
+        Complex e2 = e1 * e1;
+
+        for(int s = 0; s < m_matSos.rows(); ++s) {
+            vecResponse(i) *= (m_matSos(s,0) + m_matSos(s,1) * e1 + m_matSos(s,2) * e2)
+                              / (m_matSos(s,3) + m_matSos(s,4) * e1 + m_matSos(s,5) * e2);
+        }
+    }
+
+    return vecResponse;
+}
+
+//=============================================================================================================
+
+RowVectorXd IirFilter::getImpulseResponse(int iLength) const
+{
+    MatrixXd matImpulse = MatrixXd::Zero(1, iLength);
+    if(iLength > 0) {
+        matImpulse(0,0) = 1.0;
+    }
+
+    MatrixXd matState = MatrixXd::Zero(1, 2 * m_matSos.rows());
+    filterInPlace(matImpulse, matState);
+
+    return matImpulse.row(0);
+}
+
+//=============================================================================================================
+
+void IirFilter::reset()
+{
+    m_matState.resize(0,0);
+}
+
+//=============================================================================================================
+
+const MatrixXd& IirFilter::getSos() const
+{
+    return m_matSos;
+}
+
+//=============================================================================================================
+
+void IirFilter::filterInPlace(MatrixXd& matData,
+                              MatrixXd& matState) const
+{
+    // Transposed direct form II. Every section runs over the whole block before the next one starts, each step
+    // works on one column of contiguous channel values.
+    for(int s = 0; s < m_matSos.rows(); ++s) {
+        const double b0 = m_matSos(s,0) / m_matSos(s,3);
+        const double b1 = m_matSos(s,1) / m_matSos(s,3);
+        const double b2 = m_matSos(s,2) / m_matSos(s,3);
+        const double a1 = m_matSos(s,4) / m_matSos(s,3);
+        const double a2 = m_matSos(s,5) / m_matSos(s,3);
+
+        ArrayXd z1 = matState.col(2*s);
+        ArrayXd z2 = matState.col(2*s+1);
+        ArrayXd x(matData.rows());
+        ArrayXd y(matData.rows());
+
+        for(int n = 0; n < matData.cols(); ++n) {
+            x = matData.col(n);
+            y = b0 * x + z1;
+            z1 = b1 * x - a1 * y + z2;
+            z2 = b2 * x - a2 * y;
+            matData.col(n) = y;
+        }
+
+        matState.col(2*s) = z1;
+        matState.col(2*s+1) = z2;
+    }
+}
+
+//=============================================================================================================
+
+RowVectorXd IirFilter::stepState() const
+{
+    RowVectorXd vecState(2 * m_matSos.rows());
+    double x = 1.0;
+
+    for(int s = 0; s < m_matSos.rows(); ++s) {
+        const double b0 = m_matSos(s,0) / m_matSos(s,3);
+        const double b1 = m_matSos(s,1) / m_matSos(s,3);
+        const double b2 = m_matSos(s,2) / m_matSos(s,3);
+        const double a1 = m_matSos(s,4) / m_matSos(s,3);
+        const double a2 = m_matSos(s,5) / m_matSos(s,3);
+
+        double y = x * (b0 + b1 + b2) / (1.0 + a1 + a2);
+        vecState(2*s+1) = b2 * x - a2 * y;
+        vecState(2*s) = b1 * x - a1 * y + vecState(2*s+1);
+        x = y;
+    }
+
+    return vecState;
+}
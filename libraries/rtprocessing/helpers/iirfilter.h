@@ -0,0 +1,251 @@
+//=============================================================================================================
+/**
+ * @file     iirfilter.h
+ * @author   agent <agent@local>
+ * @since    0.1.9
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, agent. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    Declaration of the IirFilter class.
+ *
+ */
+
+#ifndef IIRFILTER_H
+#define IIRFILTER_H
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include "../rtprocessing_global.h"
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QSharedPointer>
+
+//=============================================================================================================
+// EIGEN INCLUDES
+//=============================================================================================================
+
+#include <Eigen/Core>
+
+//=============================================================================================================
+// DEFINE NAMESPACE RTPROCESSINGLIB
+//=============================================================================================================
+
+namespace RTPROCESSINGLIB
+{
+
+//=============================================================================================================
+/**
+ * The IirFilter class designs Butterworth and Chebyshev type I filters as cascades of second-order sections
+ * (biquads) via the bilinear transform and applies them either as a causal streaming filter with per channel
+ * state or forward-backward with zero phase.
+ *
+ * The sections are stored like scipy's sos format, one row [b0 b1 b2 a0 a1 a2] per section with a0 = 1. The
+ * streaming path runs the transposed direct form II sample by sample on whole columns, so that the work is
+ * vectorized across channels.
+ *
+ * @brief Butterworth/Chebyshev IIR filters as second-order sections.
+ */
+class RTPROCESINGSHARED_EXPORT IirFilter
+{
+
+public:
+    typedef QSharedPointer<IirFilter> SPtr;              /**< Shared pointer type for IirFilter. */
+    typedef QSharedPointer<const IirFilter> ConstSPtr;   /**< Const shared pointer type for IirFilter. */
+
+    enum DesignMethod {
+        Butterworth = 0,
+        Chebyshev = 1
+    };
+
+    //=========================================================================================================
+    /**
+     * Constructs an empty IirFilter which passes data unchanged.
+     */
+    IirFilter();
+
+    //=========================================================================================================
+    /**
+     * Constructs an IirFilter and designs its second-order sections.
+     *
+     * @param[in] iFilterType      The filter type: LPF, HPF, BPF, NOTCH (index into FilterKernel::m_filterTypes).
+     * @param[in] iOrder           The order of the analog prototype. Band pass and band stop filters have twice
+     *                              as many poles.
+     * @param[in] dCenterfreq      The cut off frequency (LPF, HPF) or band center (BPF, NOTCH) - normed to nyquist.
+     * @param[in] dBandwidth       The band width (BPF, NOTCH) - normed to nyquist. Ignored for LPF and HPF.
+     * @param[in] iDesignMethod    Butterworth or Chebyshev.
+     * @param[in] dRipple          The pass band ripple in dB of Chebyshev filters. Default is set to 0.5.
+     */
+    IirFilter(int iFilterType,
+              int iOrder,
+              double dCenterfreq,
+              double dBandwidth,
+              int iDesignMethod = Butterworth,
+              double dRipple = 0.5);
+
+    //=========================================================================================================
+    /**
+     * Constructs an IirFilter from given second-order sections.
+     *
+     * @param[in] matSos           The sections, one row [b0 b1 b2 a0 a1 a2] per section.
+     */
+    explicit IirFilter(const Eigen::MatrixXd& matSos);
+
+    //=========================================================================================================
+    /**
+     * Designs the second-order sections of a digital Butterworth or Chebyshev type I filter.
+     *
+     * @param[in] iFilterType      The filter type: LPF, HPF, BPF, NOTCH (index into FilterKernel::m_filterTypes).
+     * @param[in] iOrder           The order of the analog prototype.
+     * @param[in] dCenterfreq      The cut off frequency (LPF, HPF) or band center (BPF, NOTCH) - normed to nyquist.
+     * @param[in] dBandwidth       The band width (BPF, NOTCH) - normed to nyquist.
+     * @param[in] iDesignMethod    Butterworth or Chebyshev.
+     * @param[in] dRipple          The pass band ripple in dB of Chebyshev filters.
+     *
+     * @return The sections, one row [b0 b1 b2 a0 a1 a2] per section. Empty if the parameters are invalid.
+     */
+    static Eigen::MatrixXd designSos(int iFilterType,
+                                     int iOrder,
+                                     double dCenterfreq,
+                                     double dBandwidth,
+                                     int iDesignMethod = Butterworth,
+                                     double dRipple = 0.5);
+
+    //=========================================================================================================
+    /**
+     * Filters all rows of matData in place with the causal filter. The filter state is kept between calls, so
+     * that consecutive blocks of a stream are filtered without edge effects and without delay. The state is reset
+     * whenever the number of rows changes.
+     *
+     * @param[in, out] matData     The block to filter (channels x samples).
+     */
+    void apply(Eigen::MatrixXd& matData);
+
+    //=========================================================================================================
+    /**
+     * Filters all rows of matData forward and backward, which squares the magnitude response and cancels the
+     * phase. The edges are extended by odd reflection and the state is initialized to the step response steady
+     * state, as done by scipy's sosfiltfilt. The streaming state is not touched.
+     *
+     * @param[in] matData          The data to filter (channels x samples).
+     *
+     * @return The zero phase filtered data.
+     */
+    Eigen::MatrixXd applyZeroPhase(const Eigen::MatrixXd& matData) const;
+
+    //=========================================================================================================
+    /**
+     * Filters one block of a recording which is too long to be held in memory forward and backward. The forward
+     * pass continues from matState and leaves the state after the first iNumSamples samples in it. The samples
+     * after them are look-ahead, which is filtered forward on a copy of the state and lets the backward pass
+     * settle before it reaches the block. Blocks filtered one after another with a look-ahead of
+     * getSettlingLength() samples match applyZeroPhase on the whole recording.
+     *
+     * @param[in] matData          The block followed by its look-ahead (channels x samples).
+     * @param[in] iNumSamples      The number of samples of the block without the look-ahead.
+     * @param[in, out] matState    The forward state. Pass an empty matrix for the first block, whose start is
+     *                              extended like in applyZeroPhase.
+     * @param[in] bLastBlock       Whether this is the last block. Its end is extended like in applyZeroPhase.
+     *
+     * @return The zero phase filtered block (channels x iNumSamples).
+     */
+    Eigen::MatrixXd applyZeroPhaseBlock(const Eigen::MatrixXd& matData,
+                                        int iNumSamples,
+                                        Eigen::MatrixXd& matState,
+                                        bool bLastBlock) const;
+
+    //=========================================================================================================
+    /**
+     * Returns the number of samples after which the impulse response stays below dTolerance times its peak. It
+     * is never shorter than the edge extension of applyZeroPhase.
+     *
+     * @param[in] dTolerance       The relative amplitude at which the filter counts as settled.
+     *
+     * @return The settling length in samples.
+     */
+    int getSettlingLength(double dTolerance = 1e-6) const;
+
+    //=========================================================================================================
+    /**
+     * Evaluates the frequency response on iNumFreqs equally spaced frequencies from 0 to nyquist.
+     *
+     * @param[in] iNumFreqs        The number of frequencies.
+     *
+     * @return The complex frequency response.
+     */
+    Eigen::RowVectorXcd getFrequencyResponse(int iNumFreqs) const;
+
+    //=========================================================================================================
+    /**
+     * Returns the first iLength samples of the impulse response.
+     *
+     * @param[in] iLength          The number of samples.
+     *
+     * @return The impulse response.
+     */
+    Eigen::RowVectorXd getImpulseResponse(int iLength) const;
+
+    //=========================================================================================================
+    /**
+     * Clears the streaming state.
+     */
+    void reset();
+
+    //=========================================================================================================
+    /**
+     * @return The second-order sections, one row [b0 b1 b2 a0 a1 a2] per section.
+     */
+    const Eigen::MatrixXd& getSos() const;
+
+private:
+    //=========================================================================================================
+    /**
+     * Runs the sections over matData in place, starting from and updating matState.
+     *
+     * @param[in, out] matData     The data (channels x samples).
+     * @param[in, out] matState    The state (channels x 2*sections).
+     */
+    void filterInPlace(Eigen::MatrixXd& matData,
+                       Eigen::MatrixXd& matState) const;
+
+    //=========================================================================================================
+    /**
+     * Returns the state of all sections after a unit step has settled, to be scaled by the first sample.
+     *
+     * @return The steady state (1 x 2*sections).
+     */
+    Eigen::RowVectorXd stepState() const;
+
+    Eigen::MatrixXd     m_matSos;       /**< The second-order sections, one row [b0 b1 b2 a0 a1 a2] per section. */
+    Eigen::MatrixXd     m_matState;     /**< The streaming state (channels x 2*sections). */
+};
+
+} // NAMESPACE RTPROCESSINGLIB
+
+#endif // IIRFILTER_H
@@ -38,6 +38,9 @@
 
 #include "icp.h"
 #include <iostream>
+#include <algorithm>
+#include <limits>
+#include <vector>
 
 #include "fiff/fiff_coord_trans.h"
 #include "mne/mne_project_to_surface.h"
@@ -111,7 +114,7 @@ bool RTPROCESSINGLIB::performIcp(const MNEProjectToSurface::SPtr mneSurfacePoint
     for(int iIter = 0; iIter < iMaxIter; ++iIter) {
 
         // Step a: compute the closest point on the surface; eq 29
-        if(!mneSurfacePoints->mne_find_closest_on_surface(matPk, iNP, matYk, vecNearest, vecDist)) {
+        if(!mneSurfacePoints->mne_find_closest_on_surface(matPk, iNP, matYk, vecNearest, vecDist, iIter > 0)) {
             qWarning() << "[RTPROCESSINGLIB::icp] mne_find_closest_on_surface was not sucessfull.";
             return false;
         }
@@ -146,6 +149,127 @@ bool RTPROCESSINGLIB::performIcp(const MNEProjectToSurface::SPtr mneSurfacePoint
 
 //=============================================================================================================
 
+bool RTPROCESSINGLIB::performIcpPointToPlane(const MNEProjectToSurface::SPtr mneSurfacePoints,
+                                             const Eigen::MatrixXf& matPointCloud,
+                                             FiffCoordTrans& transFromTo,
+                                             float& fRMSE,
+                                             int iMaxIter,
+                                             float fTol,
+                                             float fInlierRatio,
+                                             const VectorXf& vecWeitgths)
+/**
+ * Linearized point-to-plane fit, see Y. Chen and G. Medioni, Object modelling by registration of multiple
+ * range images, Image and Vision Computing, 10, 145 - 155, 1992, and K.-L. Low, Linear Least-Squares Optimization
+ * for Point-to-Plane ICP Surface Registration, Technical Report TR04-004, UNC Chapel Hill, 2004.
+ */
+{
+    if(matPointCloud.rows() == 0){
+        qWarning() << "[RTPROCESSINGLIB::icpPointToPlane] Passed point cloud is empty.";
+        return false;
+    }
+
+    if(!vecWeitgths.isZero() && vecWeitgths.size() != matPointCloud.rows()){
+        qWarning() << "[RTPROCESSINGLIB::icpPointToPlane] Number of weights does not match the point cloud.";
+        return false;
+    }
+
+    // Initialization
+    int iNP = matPointCloud.rows();             // The number of points
+    int iNumInliers = std::min(iNP, std::max(6, static_cast<int>(std::ceil(fInlierRatio * iNP))));
+    float fMSEPrev = std::numeric_limits<float>::max();
+    float fMSE = 0.0;                           // The mean square error of the inliers
+    VectorXf vecW = vecWeitgths.isZero() ? VectorXf::Ones(iNP) : vecWeitgths;
+    MatrixXf matP0 = matPointCloud;             // Initial Set of points
+    MatrixXf matPk;                             // Transformed Set of points
+    MatrixXf matYk(iNP,3);                      // Iterative closest points on the surface
+    VectorXi vecNearest;                        // Triangle of the new point
+    VectorXf vecDist;                           // The Distance between matYk and matPk
+    std::vector<float> vecAbsDist(iNP);
+    const MatrixX3f& matNormals = mneSurfacePoints->triangle_normals();
+
+    // Initial transformation - From point cloud To surface
+    FiffCoordTrans transICP = transFromTo;
+    matPk = transICP.apply_trans(matP0);
+
+    Matrix<double,6,6> matA;
+    Matrix<double,6,1> vecB, vecRow;
+    Matrix4f matDelta;
+
+    for(int iIter = 0; iIter < iMaxIter; ++iIter) {
+
+        // Step a: compute the closest point on the surface, starting at the triangles of the last iteration
+        if(!mneSurfacePoints->mne_find_closest_on_surface(matPk, iNP, matYk, vecNearest, vecDist, iIter > 0)) {
+            qWarning() << "[RTPROCESSINGLIB::icpPointToPlane] mne_find_closest_on_surface was not sucessfull.";
+            return false;
+        }
+
+        // Step b: trim, only the iNumInliers points closest to the surface take part
+        for(int i = 0; i < iNP; ++i) {
+            vecAbsDist[i] = std::fabs(vecDist(i));
+        }
+        std::nth_element(vecAbsDist.begin(), vecAbsDist.begin() + iNumInliers - 1, vecAbsDist.end());
+        float fMaxDist = vecAbsDist[iNumInliers - 1];
+
+        // Step c: linearized point-to-plane fit of a small rotation w and a translation t,
+        // minimizing sum_i w_i ((p_i + w x p_i + t - y_i) * n_i)^2
+        matA.setZero();
+        vecB.setZero();
+        fMSE = 0.0;
+        int iUsed = 0;
+        for(int i = 0; i < iNP && iUsed < iNumInliers; ++i) {
+            if(std::fabs(vecDist(i)) > fMaxDist) {
+                continue;
+            }
+
+            Vector3d vecP = matPk.row(i).transpose().cast<double>();
+            Vector3d vecN = matNormals.row(vecNearest(i)).transpose().cast<double>();
+            vecRow << vecP.cross(vecN), vecN;
+
+            matA.selfadjointView<Lower>().rankUpdate(vecRow, vecW(i));
+            vecB += vecW(i) * (matYk.row(i).transpose().cast<double>() - vecP).dot(vecN) * vecRow;
+
+            fMSE += vecDist(i) * vecDist(i);
+            ++iUsed;
+        }
+        fMSE /= iUsed;
+        fRMSE = std::sqrt(fMSE);
+
+        Matrix<double,6,1> vecX = matA.selfadjointView<Lower>().ldlt().solve(vecB);
+        if(!vecX.allFinite()) {
+            qWarning() << "[RTPROCESSINGLIB::icpPointToPlane] Point-to-plane system is degenerate.";
+            return false;
+        }
+
+        // Step d: apply the increment as an exact rigid transformation
+        Vector3d vecOmega = vecX.head<3>();
+        double dAngle = vecOmega.norm();
+        matDelta.setIdentity();
+        if(dAngle > 0.0) {
+            matDelta.block<3,3>(0,0) = AngleAxisd(dAngle, vecOmega / dAngle).toRotationMatrix().cast<float>();
+        }
+        matDelta.block<3,1>(0,3) = vecX.tail<3>().cast<float>();
+
+        transICP.trans = matDelta * transICP.trans;
+        transICP.invtrans = transICP.trans.inverse();
+        matPk = transICP.apply_trans(matP0);
+
+        // step e: terminate if the change of the mean-square-error is below fTol
+        if(std::sqrt(std::fabs(fMSE - fMSEPrev)) < fTol) {
+            transFromTo = transICP;
+            qInfo() << "[RTPROCESSINGLIB::icpPointToPlane] ICP was succesfull and exceeded after " << iIter +1 << " Iterations with RMSE dist: " << fRMSE * 1000 << " mm.";
+            return true;
+        }
+        fMSEPrev = fMSE;
+        qInfo() << "[RTPROCESSINGLIB::icpPointToPlane] ICP iteration " << iIter + 1 << " with RMSE: " << fRMSE * 1000 << " mm.";
+    }
+    transFromTo = transICP;
+
+    qWarning() << "[RTPROCESSINGLIB::icpPointToPlane] Maximum number of " << iMaxIter << " Iterations exceeded with RMSE: " << fRMSE * 1000 << " mm.";
+    return true;
+}
+
+//=============================================================================================================
+
 bool RTPROCESSINGLIB::fitMatchedPoints(const MatrixXf& matSrcPoint,
                                        const MatrixXf& matDstPoint,
                                        Eigen::Matrix4f& matTrans,
@@ -102,6 +102,36 @@ RTPROCESINGSHARED_EXPORT bool performIcp(const QSharedPointer<MNELIB::MNEProject
                                          float fTol = 0.001,
                                          const Eigen::VectorXf& vecWeitgths = vecDefaultWeigths);
 
+//=========================================================================================================
+/**
+ * The point-to-plane variant of the ICP algorithm to rigidly register a point cloud with a surface. Instead of the
+ * distance to the closest surface point, the distance to the tangent plane at that point is minimized, which
+ * converges in considerably fewer iterations on smooth surfaces like the head. The closest points of one iteration
+ * are the starting point of the search in the next one. Outliers are handled by trimming: in every iteration only
+ * the fInlierRatio share of points closest to the surface takes part in the fit, so no separate
+ * discard3DPointOutliers pass is needed.
+ *
+ * @param[in] mneSurfacePoints    The MNEProjectToSurface object that contains the surface triangles etc. (To).
+ * @param[in] matPointCloud       The point cloud to be registrated (From).
+ * @param[in, out] transFromTo    The forward transformation matrix. It can contain an initial transformatin (e.g. from fiducial alignment).
+ * @param[in, out] fRMSE          The resulting Root-Mean-Square-Error of the inliers in m.
+ * @param[in] iMaxIter            The maximum number of iterations for the icp algorithms, defaults to 20.
+ * @param[in] fTol                The tolerance for the change of the RMSE in m, defaults to 0.001.
+ * @param[in] fInlierRatio        The share of points used in each iteration, defaults to 0.9.
+ * @param[in] vecWeitgths         The weitghts to apply, defaults to zeros.
+ *
+ * @return Wether the registration was succesfull.
+ */
+
+RTPROCESINGSHARED_EXPORT bool performIcpPointToPlane(const QSharedPointer<MNELIB::MNEProjectToSurface> mneSurfacePoints,
+                                                     const Eigen::MatrixXf& matPointCloud,
+                                                     FIFFLIB::FiffCoordTrans& transFromTo,
+                                                     float& fRMSE,
+                                                     int iMaxIter = 20,
+                                                     float fTol = 0.001,
+                                                     float fInlierRatio = 0.9,
+                                                     const Eigen::VectorXf& vecWeitgths = vecDefaultWeigths);
+
 //=========================================================================================================
 
 /**
@@ -44,6 +44,7 @@
 #include <utils/ioutils.h>
 #include <rtprocessing/detecttrigger.h>
 #include <utils/mnemath.h>
+#include <utils/mnetracer.h>
 
 //=============================================================================================================
 // QT INCLUDES
@@ -231,6 +232,7 @@ void RtAveragingWorker::setBaselineTo(int toSamp,
 
 void RtAveragingWorker::doAveraging(const MatrixXd& rawSegment)
 {
+    MNE_TRACE();
     //Detect trigger
     QList<QPair<int,double> > lDetectedTriggers = RTPROCESSINGLIB::detectTriggerFlanksMax(rawSegment, m_iTriggerChIndex, 0, m_fTriggerThreshold, true);
 
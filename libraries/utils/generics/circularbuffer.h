@@ -42,6 +42,8 @@
 
 #include "../utils_global.h"
 
+#include <utility>
+
 //=============================================================================================================
 // QT INCLUDES
 //=============================================================================================================
@@ -227,7 +229,8 @@ inline bool CircularBuffer<_Tp>::pop(_Tp& element)
 {
     if(!m_bPause) {
         if(m_pUsedElements->tryAcquire(1, m_iTimeout)) {
-            element = m_pBuffer[mapIndex(m_iCurrentReadIndex)];
+            // Move out so the slot does not keep the element alive until it is overwritten
+            element = std::move(m_pBuffer[mapIndex(m_iCurrentReadIndex)]);
             const QSemaphoreReleaser releaser(m_pFreeElements, 1);
         } else {
             return false;
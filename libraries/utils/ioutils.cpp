@@ -39,11 +39,27 @@
 
 #include "ioutils.h"
 
+#include <algorithm>
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSSE3__)
+#include <tmmintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define IOUTILS_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define IOUTILS_NEON
+#endif
+
 //=============================================================================================================
 // QT INCLUDES
 //=============================================================================================================
 
 #include <QDataStream>
+#include <QtEndian>
 
 //=============================================================================================================
 // EIGEN INCLUDES
@@ -58,16 +74,162 @@
 using namespace Eigen;
 using namespace UTILSLIB;
 
+//=============================================================================================================
+// DEFINE GLOBAL METHODS
+//=============================================================================================================
+
+template<int iBytes>
+struct SwapWord;
+
+template<>
+struct SwapWord<2> { typedef quint16 Type; };
+
+template<>
+struct SwapWord<4> { typedef quint32 Type; };
+
+template<>
+struct SwapWord<8> { typedef quint64 Type; };
+
+//=============================================================================================================
+
+#if defined(__AVX2__) || defined(__SSSE3__)
+template<int iBytes>
+struct ByteSwapMask
+{
+    // Reverses the bytes within every iBytes wide word of a 32 byte vector
+    ByteSwapMask()
+    {
+        for(int k = 0; k < 32; ++k) {
+            mask[k] = static_cast<char>((k % 16) / iBytes * iBytes + iBytes - 1 - k % iBytes);
+        }
+    }
+    char mask[32];
+};
+
+template<int iBytes>
+static const char* byteSwapMask()
+{
+    static const ByteSwapMask<iBytes> s_mask;
+    return s_mask.mask;
+}
+#endif
+
+//=============================================================================================================
+
+#ifdef IOUTILS_SSE2
+template<int iBytes>
+static __m128i byteSwapSse2(__m128i v);
+
+template<>
+__m128i byteSwapSse2<2>(__m128i v)
+{
+    return _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+}
+
+template<>
+__m128i byteSwapSse2<4>(__m128i v)
+{
+    v = byteSwapSse2<2>(v);
+    v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(2,3,0,1));
+    return _mm_shufflehi_epi16(v, _MM_SHUFFLE(2,3,0,1));
+}
+
+template<>
+__m128i byteSwapSse2<8>(__m128i v)
+{
+    v = byteSwapSse2<2>(v);
+    v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(0,1,2,3));
+    return _mm_shufflehi_epi16(v, _MM_SHUFFLE(0,1,2,3));
+}
+#endif
+
+//=============================================================================================================
+
+#ifdef IOUTILS_NEON
+template<int iBytes>
+static uint8x16_t byteSwapNeon(uint8x16_t v);
+
+template<>
+uint8x16_t byteSwapNeon<2>(uint8x16_t v) { return vrev16q_u8(v); }
+
+template<>
+uint8x16_t byteSwapNeon<4>(uint8x16_t v) { return vrev32q_u8(v); }
+
+template<>
+uint8x16_t byteSwapNeon<8>(uint8x16_t v) { return vrev64q_u8(v); }
+#endif
+
+//=============================================================================================================
+
+template<int iBytes>
+static void swapBytes(void *data, qint64 count)
+{
+    char* pData = static_cast<char*>(data);
+    const qint64 iNumBytes = count * iBytes;
+    qint64 i = 0;
+
+#if defined(__AVX2__)
+    const __m256i mask256 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(byteSwapMask<iBytes>()));
+    for(; i + 32 <= iNumBytes; i += 32) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pData + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(pData + i), _mm256_shuffle_epi8(v, mask256));
+    }
+#endif
+#if defined(__AVX2__) || defined(__SSSE3__)
+    const __m128i mask128 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(byteSwapMask<iBytes>()));
+    for(; i + 16 <= iNumBytes; i += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pData + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pData + i), _mm_shuffle_epi8(v, mask128));
+    }
+#elif defined(IOUTILS_SSE2)
+    for(; i + 16 <= iNumBytes; i += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pData + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pData + i), byteSwapSse2<iBytes>(v));
+    }
+#elif defined(IOUTILS_NEON)
+    for(; i + 16 <= iNumBytes; i += 16) {
+        uint8x16_t v = vld1q_u8(reinterpret_cast<const uint8_t*>(pData + i));
+        vst1q_u8(reinterpret_cast<uint8_t*>(pData + i), byteSwapNeon<iBytes>(v));
+    }
+#endif
+
+    // Remaining words, memcpy keeps this free of aliasing issues
+    typename SwapWord<iBytes>::Type value;
+    for(; i < iNumBytes; i += iBytes) {
+        memcpy(&value, pData + i, iBytes);
+        value = qbswap(value);
+        memcpy(pData + i, &value, iBytes);
+    }
+}
+
+//=============================================================================================================
+
+template<typename T>
+static void swapToDouble(const T *source, double *dest, qint64 count)
+{
+    // Swap a chunk which stays in the L1 cache and widen it from there
+    const qint64 iChunk = 2048 / sizeof(T);
+    T buffer[iChunk];
+
+    for(qint64 i = 0; i < count; i += iChunk) {
+        qint64 n = std::min(iChunk, count - i);
+        memcpy(buffer, source + i, n * sizeof(T));
+        swapBytes<sizeof(T)>(buffer, n);
+        for(qint64 k = 0; k < n; ++k) {
+            dest[i + k] = static_cast<double>(buffer[k]);
+        }
+    }
+}
+
 //=============================================================================================================
 // DEFINE MEMBER METHODS
 //=============================================================================================================
 
 qint32 IOUtils::fread3(QDataStream &p_qStream)
 {
-    char* bytes = new char[3];
-    p_qStream.readRawData(bytes, 3);
-    qint32 int3 = (((unsigned char) bytes[0]) << 16) + (((unsigned char) bytes[1]) << 8) + ((unsigned char) bytes[2]);
-    delete[] bytes;
+    unsigned char bytes[3];
+    p_qStream.readRawData(reinterpret_cast<char*>(bytes), 3);
+    qint32 int3 = (bytes[0] << 16) + (bytes[1] << 8) + bytes[2];
     return int3;
 }
 
@@ -75,10 +237,15 @@ qint32 IOUtils::fread3(QDataStream &p_qStream)
 
 VectorXi IOUtils::fread3_many(QDataStream &p_qStream, qint32 count)
 {
+    // Read all bytes at once and assemble the integers afterwards
+    QByteArray bytes(3 * count, 0);
+    p_qStream.readRawData(bytes.data(), bytes.size());
+    const unsigned char* data = reinterpret_cast<const unsigned char*>(bytes.constData());
+
     VectorXi res(count);
 
     for(qint32 i = 0; i < count; ++i)
-        res[i] = IOUtils::fread3(p_qStream);
+        res[i] = (data[3*i] << 16) + (data[3*i+1] << 8) + data[3*i+2];
 
     return res;
 }
@@ -237,6 +404,117 @@ void IOUtils::swap_doublep(double *source)
 
 //=============================================================================================================
 
+void IOUtils::from_big_endian_many(qint16 *data, qint64 count)
+{
+#if Q_BYTE_ORDER == Q_LITTLE_ENDIAN
+    swapBytes<sizeof(qint16)>(data, count);
+#else
+    Q_UNUSED(data)
+    Q_UNUSED(count)
+#endif
+}
+
+//=============================================================================================================
+
+void IOUtils::from_big_endian_many(qint32 *data, qint64 count)
+{
+#if Q_BYTE_ORDER == Q_LITTLE_ENDIAN
+    swapBytes<sizeof(qint32)>(data, count);
+#else
+    Q_UNUSED(data)
+    Q_UNUSED(count)
+#endif
+}
+
+//=============================================================================================================
+
+void IOUtils::from_big_endian_many(float *data, qint64 count)
+{
+#if Q_BYTE_ORDER == Q_LITTLE_ENDIAN
+    swapBytes<sizeof(float)>(data, count);
+#else
+    Q_UNUSED(data)
+    Q_UNUSED(count)
+#endif
+}
+
+//=============================================================================================================
+
+void IOUtils::from_big_endian_many(double *data, qint64 count)
+{
+#if Q_BYTE_ORDER == Q_LITTLE_ENDIAN
+    swapBytes<sizeof(double)>(data, count);
+#else
+    Q_UNUSED(data)
+    Q_UNUSED(count)
+#endif
+}
+
+//=============================================================================================================
+
+void IOUtils::swap_many(qint16 *data, qint64 count)
+{
+    swapBytes<sizeof(qint16)>(data, count);
+}
+
+//=============================================================================================================
+
+void IOUtils::swap_many(qint32 *data, qint64 count)
+{
+    swapBytes<sizeof(qint32)>(data, count);
+}
+
+//=============================================================================================================
+
+void IOUtils::swap_many(qint64 *data, qint64 count)
+{
+    swapBytes<sizeof(qint64)>(data, count);
+}
+
+//=============================================================================================================
+
+void IOUtils::swap_many(float *data, qint64 count)
+{
+    swapBytes<sizeof(float)>(data, count);
+}
+
+//=============================================================================================================
+
+void IOUtils::swap_many(double *data, qint64 count)
+{
+    swapBytes<sizeof(double)>(data, count);
+}
+
+//=============================================================================================================
+
+void IOUtils::swap_to_double(const qint16 *source, double *dest, qint64 count)
+{
+    swapToDouble<qint16>(source, dest, count);
+}
+
+//=============================================================================================================
+
+void IOUtils::swap_to_double(const qint32 *source, double *dest, qint64 count)
+{
+    swapToDouble<qint32>(source, dest, count);
+}
+
+//=============================================================================================================
+
+void IOUtils::swap_to_double(const float *source, double *dest, qint64 count)
+{
+    swapToDouble<float>(source, dest, count);
+}
+
+//=============================================================================================================
+
+void IOUtils::swap_to_double(const double *source, double *dest, qint64 count)
+{
+    swapToDouble<double>(source, dest, count);
+}
+
+//=============================================================================================================
+
 QStringList IOUtils::get_new_chnames_conventions(const QStringList& chNames)
 {
     QStringList result;
@@ -184,6 +184,47 @@ public:
      */
     static void swap_doublep(double *source);
 
+    //=========================================================================================================
+    /**
+     * Converts an array of big endian values in place to host byte order. The whole array is converted in a
+     * single pass, which is much faster than extracting the values one by one from a big endian stream.
+     *
+     * @param[in, out] data      values to convert.
+     * @param[in] count          number of values.
+     */
+    static void from_big_endian_many(qint16 *data, qint64 count);
+    static void from_big_endian_many(qint32 *data, qint64 count);
+    static void from_big_endian_many(float *data, qint64 count);
+    static void from_big_endian_many(double *data, qint64 count);
+
+    //=========================================================================================================
+    /**
+     * Swaps the byte order of an array of values in place. Uses SSE2/SSSE3/AVX2 or NEON shuffles, depending on
+     * what the compiler targets, and falls back to a scalar swap otherwise.
+     *
+     * @param[in, out] data      values to swap.
+     * @param[in] count          number of values.
+     */
+    static void swap_many(qint16 *data, qint64 count);
+    static void swap_many(qint32 *data, qint64 count);
+    static void swap_many(qint64 *data, qint64 count);
+    static void swap_many(float *data, qint64 count);
+    static void swap_many(double *data, qint64 count);
+
+    //=========================================================================================================
+    /**
+     * Converts an array of values to double, swapping the byte order on the way. The values are processed in
+     * small chunks, so the data passes through main memory only once.
+     *
+     * @param[in] source         values in swapped byte order.
+     * @param[out] dest          the converted values, needs room for count values.
+     * @param[in] count          number of values.
+     */
+    static void swap_to_double(const qint16 *source, double *dest, qint64 count);
+    static void swap_to_double(const qint32 *source, double *dest, qint64 count);
+    static void swap_to_double(const float *source, double *dest, qint64 count);
+    static void swap_to_double(const double *source, double *dest, qint64 count);
+
     //=========================================================================================================
     /**
      * Write Eigen Matrix to file
@@ -43,13 +43,16 @@
 #include <iostream>
 #include <algorithm>
 #include <vector>
-#include <time.h>
+#include <limits>
+#include <functional>
 
 //=============================================================================================================
 // QT INCLUDES
 //=============================================================================================================
 
 #include <QDebug>
+#include <QVector>
+#include <QtConcurrent>
 
 //=============================================================================================================
 // USED NAMESPACES
@@ -74,6 +77,7 @@ KMeans::KMeans(QString distance,
 , m_sEmptyact(emptyact)
 , m_iMaxit(maxit)
 , m_bOnline(online)
+, m_iSeed(0)
 , emptyErrCnt(0)
 , iter(0)
 , k(0)
@@ -89,6 +93,13 @@ KMeans::KMeans(QString distance,
 
 //=============================================================================================================
 
+void KMeans::setSeed(quint32 iSeed)
+{
+    m_iSeed = iSeed;
+}
+
+//=============================================================================================================
+
 bool KMeans::calculate(MatrixXd X,
                        qint32 kClusters,
                        VectorXi& idx,
@@ -96,12 +107,9 @@ bool KMeans::calculate(MatrixXd X,
                        VectorXd& sumD,
                        MatrixXd& D)
 {
-    if (kClusters < 1)
+    if (kClusters < 1 || X.rows() < 1)
         return false;
 
-    //Init random generator
-    srand ( time(NULL) );
-
 // n points in p dimensional space
     k = kClusters;
     n = X.rows();
@@ -109,13 +117,13 @@ bool KMeans::calculate(MatrixXd X,
 
     if(m_sDistance.compare("cosine") == 0)
     {
-//        Xnorm = sqrt(sum(X.^2, 2));
-//        if any(min(Xnorm) <= eps(max(Xnorm)))
-//            error(['Some points have small relative magnitudes, making them ', ...
-//                   'effectively zero.\nEither remove those points, or choose a ', ...
-//                   'distance other than ''cosine''.']);
-//        end
-//        X = X ./ Xnorm(:,ones(1,p));
+        VectorXd Xnorm = X.rowwise().norm();
+        if(Xnorm.minCoeff() <= std::numeric_limits<double>::epsilon() * Xnorm.maxCoeff())
+        {
+            qWarning() << "[KMeans::calculate] Some points have small relative magnitudes, making them effectively zero. Either remove those points, or choose a distance other than cosine.";
+            return false;
+        }
+        X.array().colwise() /= Xnorm.array();
     }
     else if(m_sDistance.compare("correlation")==0)
     {
@@ -136,8 +144,6 @@ bool KMeans::calculate(MatrixXd X,
 //    }
 
     // Start
-    RowVectorXd Xmins;
-    RowVectorXd Xmaxs;
     if (m_sStart.compare("uniform") == 0)
     {
         if (m_sDistance.compare("hamming") == 0)
@@ -152,196 +158,209 @@ bool KMeans::calculate(MatrixXd X,
     //
     // Done with input argument processing, begin clustering
     //
+    emptyErrCnt = 0;
+
+    // Replicates are independent. Each one runs on its own copy of this object, so that the per replicate
+    // state (iter, Del, d, m, ...) is not shared. Results are collected in replicate order.
+    QVector<ReplicateResult> results;
+    if (m_iReps == 1)
+    {
+        results.append(runReplicate(X, 0));
+    }
+    else
+    {
+        QVector<qint32> reps(m_iReps);
+        for(qint32 rep = 0; rep < m_iReps; ++rep)
+            reps[rep] = rep;
+
+        std::function<ReplicateResult(const qint32&)> run = [this, &X](const qint32& rep) {
+            KMeans worker(*this);
+            return worker.runReplicate(X, rep);
+        };
+
+        results = QtConcurrent::blockingMapped<QVector<ReplicateResult> >(reps, run);
+    }
+
+    // Return the best solution, ties go to the lower replicate
+    qint32 iBest = 0;
+    for(qint32 rep = 1; rep < results.size(); ++rep)
+        if (results[rep].totsumD < results[iBest].totsumD)
+            iBest = rep;
+
+    idx = results[iBest].idx;
+    C = results[iBest].C;
+    sumD = results[iBest].sumD;
+    D = results[iBest].D;
+
+//if hadNaNs
+//    idx = statinsertnan(wasnan, idx);
+//end
+    return true;
+}
+
+//=============================================================================================================
+
+KMeans::ReplicateResult KMeans::runReplicate(const MatrixXd& X,
+                                             qint32 rep)
+{
+    m_generator.seed(m_iSeed + static_cast<quint32>(rep));
+
+    MatrixXd C;
+    if (m_sStart.compare("uniform") == 0)
+    {
+        C = MatrixXd::Zero(k,p);
+        for(qint32 i = 0; i < k; ++i)
+            for(qint32 j = 0; j < p; ++j)
+                C(i,j) = unifrnd(Xmins[j], Xmaxs[j]);
+        // For 'cosine' and 'correlation', these are uniform inside a subset
+        // of the unit hypersphere.  Still need to center them for
+        // 'correlation'.  (Re)normalization for 'cosine'/'correlation' is
+        // done at each iteration.
+        if (m_sDistance.compare("correlation") == 0)
+            C.array() -= (C.array().rowwise().sum()/p).replicate(1, p).array();
+    }
+    else if (m_sStart.compare("sample") == 0)
+    {
+        std::uniform_int_distribution<qint32> sample(0, n - 1);
+        C = MatrixXd::Zero(k,p);
+        for(qint32 i = 0; i < k; ++i)
+            C.row(i) = X.row(sample(m_generator));
+    }
+    else
+    {
+        initPlus(X, C);
+    }
+//    else if (start.compare("cluster") == 0)
+//    {
+//        Xsubset = X(randsample(n,floor(.1*n)),:);
+//        [dum, C] = kmeans(Xsubset, k, varargin{:}, 'start','sample', 'replicates',1);
+//    }
+//    else if (start.compare("numeric") == 0)
+//    {
+//        C = CC(:,:,rep);
+//    }
+
+    // Compute the distance from every point to each cluster centroid and the
+    // initial assignment of points to clusters
+    MatrixXd D = distfun(X, C);
+    VectorXi idx = VectorXi::Zero(n);
+    d = VectorXd::Zero(n);
+
+    for(qint32 i = 0; i < n; ++i)
+        d[i] = D.row(i).minCoeff(&idx[i]);
+
+    m = VectorXi::Zero(k);
+    for(qint32 i = 0; i < n; ++i)
+        ++m[idx[i]];
+
     if (m_bOnline)
     {
         Del = MatrixXd(n,k);
         Del.fill(std::numeric_limits<double>::quiet_NaN());// reassignment criterion
     }
 
-    double totsumDBest = std::numeric_limits<double>::max();
-    emptyErrCnt = 0;
+    // Begin phase one:  batch reassignments
+    bool converged = batchUpdate(X, C, idx, D);
 
-    VectorXi idxBest;
-    MatrixXd Cbest;
-    VectorXd sumDBest;
-    MatrixXd Dbest;
+    // Begin phase two:  single reassignments
+    if (m_bOnline)
+        converged = onlineUpdate(X, C, idx);
 
-    for(qint32 rep = 0; rep < m_iReps; ++rep)
-    {
-        if (m_sStart.compare("uniform") == 0)
-        {
-            C = MatrixXd::Zero(k,p);
-            for(qint32 i = 0; i < k; ++i)
-                for(qint32 j = 0; j < p; ++j)
-                    C(i,j) = unifrnd(Xmins[j], Xmaxs[j]);
-            // For 'cosine' and 'correlation', these are uniform inside a subset
-            // of the unit hypersphere.  Still need to center them for
-            // 'correlation'.  (Re)normalization for 'cosine'/'correlation' is
-            // done at each iteration.
-            if (m_sDistance.compare("correlation") == 0)
-                C.array() -= (C.array().rowwise().sum()/p).replicate(1, p).array();
-        }
-        else if (m_sStart.compare("sample") == 0)
-        {
-            C = MatrixXd::Zero(k,p);
-            for(qint32 i = 0; i < k; ++i)
-                C.block(i,0,1,p) = X.block(rand() % n, 0, 1, p);
-            // DEBUG
-//            C.block(0,0,1,p) = X.block(2, 0, 1, p);
-//            C.block(1,0,1,p) = X.block(7, 0, 1, p);
-//            C.block(2,0,1,p) = X.block(17, 0, 1, p);
-        }
-    //    else if (start.compare("cluster") == 0)
-    //    {
-    //        Xsubset = X(randsample(n,floor(.1*n)),:);
-    //        [dum, C] = kmeans(Xsubset, k, varargin{:}, 'start','sample', 'replicates',1);
-    //    }
-    //    else if (start.compare("numeric") == 0)
-    //    {
-    //        C = CC(:,:,rep);
-    //    }
-
-        // Compute the distance from every point to each cluster centroid and the
-        // initial assignment of points to clusters
-        D = distfun(X, C);//, 0);
-        idx = VectorXi::Zero(D.rows());
-        d = VectorXd::Zero(D.rows());
-
-        for(qint32 i = 0; i < D.rows(); ++i)
-            d[i] = D.row(i).minCoeff(&idx[i]);
-
-        m = VectorXi::Zero(k);
-        for(qint32 i = 0; i < k; ++i)
-            for (qint32 j = 0; j < idx.rows(); ++j)
-                if(idx[j] == i)
-                    ++ m[i];
+    if (!converged)
+        printf("Failed To Converge during replicate %d\n", rep);
 
-        try // catch empty cluster errors and move on to next rep
-        {
-            // Begin phase one:  batch reassignments
-            bool converged = batchUpdate(X, C, idx);
+    // Calculate cluster-wise sums of distances
+    ReplicateResult result;
+    result.D = distfun(X, C);
+    for(qint32 i = 0; i < k; ++i)
+        if (m[i] == 0)
+            result.D.col(i).fill(std::numeric_limits<double>::quiet_NaN());
 
-            // Begin phase two:  single reassignments
-            if (m_bOnline)
-                converged = onlineUpdate(X, C, idx);
+    result.sumD = VectorXd::Zero(k);
+    for(qint32 i = 0; i < n; ++i)
+        result.sumD[idx[i]] += result.D(i, idx[i]);
 
-            if (!converged)
-                printf("Failed To Converge during replicate %d\n", rep);
+    result.totsumD = result.sumD.sum();
+    result.idx = idx;
+    result.C = C;
 
-            // Calculate cluster-wise sums of distances
-            VectorXi nonempties = VectorXi::Zero(m.rows());
-            quint32 count = 0;
-            for(qint32 i = 0; i < m.rows(); ++i)
-            {
-                if(m[i] > 0)
-                {
-                    nonempties[i] = 1;
-                    ++count;
-                }
-            }
-            MatrixXd C_tmp(count,C.cols());
-            count = 0;
-            for(qint32 i = 0; i < nonempties.rows(); ++i)
-            {
-                if(nonempties[i])
-                {
-                    C_tmp.row(count) = C.row(i);
-                    ++count;
-                }
-            }
+//    printf("%d iterations, total sum of distances = %f\n", iter, result.totsumD);
 
-            MatrixXd D_tmp = distfun(X, C_tmp);//, iter);
-            count = 0;
-            for(qint32 i = 0; i < nonempties.rows(); ++i)
-            {
-                if(nonempties[i])
-                {
-                    D.col(i) = D_tmp.col(count);
-                    C.row(i) = C_tmp.row(count);
-                    ++count;
-                }
-            }
+    return result;
+}
+
+//=============================================================================================================
 
-            d = VectorXd::Zero(n);
-            for(qint32 i = 0; i < n; ++i)
-                d[i] += D.array()(idx[i]*n+i);//Colum Major
+void KMeans::initPlus(const MatrixXd& X,
+                      MatrixXd& C)
+{
+    std::uniform_int_distribution<qint32> sample(0, n - 1);
 
-            sumD = VectorXd::Zero(k);
-            for(qint32 i = 0; i < k; ++i)
-                for (qint32 j = 0; j < idx.rows(); ++j)
-                    if(idx[j] == i)
-                        sumD[i] += d[j];
+    C = MatrixXd::Zero(k,p);
+    C.row(0) = X.row(sample(m_generator));
 
-            totsumD = sumD.array().sum();
+    // Distance of every point to its closest centroid so far
+    VectorXd minD = distfun(X, C.topRows(1)).col(0);
 
-//            printf("%d iterations, total sum of distances = %f\n", iter, totsumD);
+    for(qint32 i = 1; i < k; ++i)
+    {
+        double sum = minD.sum();
+        qint32 next = n - 1;
 
-            // Save the best solution so far
-            if (totsumD < totsumDBest)
-            {
-                totsumDBest = totsumD;
-                idxBest = idx;
-                Cbest = C;
-                sumDBest = sumD;
-                Dbest = D;
-            }
-        }
-        catch (int e)
+        if (sum > 0)
         {
-            if(e == 0)
+            std::uniform_real_distribution<double> draw(0.0, sum);
+            double r = draw(m_generator);
+            double cumsum = 0;
+            for(qint32 j = 0; j < n; ++j)
             {
-                // If an empty cluster error occurred in one of multiple replicates, catch
-                // it, warn, and move on to next replicate.  Error only when all replicates
-                // fail.  Rethrow an other kind of error.
-                if (m_iReps == 1)
-                    return false;
-                else
+                cumsum += minD[j];
+                if (r < cumsum)
                 {
-                    emptyErrCnt = emptyErrCnt + 1;
-//                    printf("Replicate %d terminated: empty cluster created at iteration %d.\n", rep, iter);
-                    if (emptyErrCnt == m_iReps)
-                    {
-//                        error(message('EmptyClusterAllReps'));
-                        return false;
-                    }
-
+                    next = j;
+                    break;
                 }
             }
-        } // catch
-
-    } // replicates
-
-    // Return the best solution
-    idx = idxBest;
-    C = Cbest;
-    sumD = sumDBest;
-    D = Dbest;
+        }
+        else
+        {
+            // All points coincide with the centroids chosen so far
+            next = sample(m_generator);
+        }
 
-//if hadNaNs
-//    idx = statinsertnan(wasnan, idx);
-//end
-    return true;
+        C.row(i) = X.row(next);
+        minD = minD.cwiseMin(distfun(X, C.middleRows(i, 1)).col(0));
+    }
 }
 
 //=============================================================================================================
 
-bool KMeans::batchUpdate(const MatrixXd& X, MatrixXd& C, VectorXi& idx)
+bool KMeans::batchUpdate(const MatrixXd& X,
+                         MatrixXd& C,
+                         VectorXi& idx,
+                         const MatrixXd& D)
 {
-    // Every point moved, every cluster will need an update
-    qint32 i = 0;
-    VectorXi moved(n);
-    for(i = 0; i < n; ++i)
-        moved[i] = i;
-
-    VectorXi changed(k);
-    for(i = 0; i < k; ++i)
-        changed[i] = i;
-
-    previdx = VectorXi::Zero(n);
-
-    prevtotsumD = std::numeric_limits<double>::max();//max double
+    const double dInf = std::numeric_limits<double>::infinity();
+
+    // Upper bound of the distance of every point to its own centroid and lower
+    // bound of the distance to all other centroids, both in metric units.
+    // Points whose bounds rule out a closer centroid are not touched at all.
+    ArrayXd upper(n);
+    ArrayXd lower(n);
+    for(qint32 i = 0; i < n; ++i)
+    {
+        upper[i] = D(i, idx[i]);
+        lower[i] = dInf;
+        for(qint32 j = 0; j < k; ++j)
+            if (j != idx[i] && m[j] > 0 && D(i,j) < lower[i])
+                lower[i] = D(i,j);
+    }
+    upper = toMetric(upper);
+    lower = toMetric(lower);
 
-    MatrixXd D = MatrixXd::Zero(X.rows(), k);
+    VectorXi all(k);
+    for(qint32 i = 0; i < k; ++i)
+        all[i] = i;
 
     //
     // Begin phase one:  batch reassignments
@@ -352,158 +371,166 @@ bool KMeans::batchUpdate(const MatrixXd& X, MatrixXd& C, VectorXi& idx)
     {
         ++iter;
 
-        // Calculate the new cluster centroids and counts, and update the
-        // distance from every point to those new cluster centroids
+        // Calculate the new cluster centroids and counts
         MatrixXd C_new;
         VectorXi m_new;
-        KMeans::gcentroids(X, idx, changed, C_new, m_new);
-        MatrixXd D_new = distfun(X, C_new);//, iter);
-
-        for(qint32 i = 0; i < changed.rows(); ++i)
-        {
-            C.row(changed[i]) = C_new.row(i);
-            D.col(changed[i]) = D_new.col(i);
-            m[changed[i]] = m_new[i];
-        }
+        gcentroids(X, idx, all, C_new, m_new);
 
         // Deal with clusters that have just lost all their members
-        VectorXi empties = VectorXi::Zero(changed.rows());
-        for(qint32 i = 0; i < changed.rows(); ++i)
-            if(m(i) == 0)
-                empties[i] = 1;
-
-        if (empties.sum() > 0)
+        for(qint32 i = 0; i < k; ++i)
         {
+            if (m_new[i] > 0)
+                continue;
+
             if (m_sEmptyact.compare("error") == 0)
             {
+                for(qint32 j = 0; j < k; ++j)
+                    if (m_new[j] > 0)
+                        C.row(j) = C_new.row(j);
+                m = m_new;
                 return converged;
 //                throw 0;
-            }
-            else if (m_sEmptyact.compare("drop") == 0)
-            {
-    //            // Remove the empty cluster from any further processing
-    //            D(:,empties) = NaN;
-    //            changed = changed(m(changed) > 0);
-    //            warning('Empty cluster created at iteration %d during replicate %d.',iter, rep,);
             }
             else if (m_sEmptyact.compare("singleton") == 0)
             {
-    //            warning('Empty cluster created at iteration %d during replicate %d.', iter, rep);
-
-    //            for i = empties
-    //                d = D((idx-1)*n + (1:n)'); // use newly updated distances
-
-    //                % Find the point furthest away from its current cluster.
-    //                % Take that point out of its cluster and use it to create
-    //                % a new singleton cluster to replace the empty one.
-    //                [dlarge, lonely] = max(d);
-    //                from = idx(lonely); % taking from this cluster
-    //                if m(from) < 2
-    //                    % In the very unusual event that the cluster had only
-    //                    % one member, pick any other non-singleton point.
-    //                    from = find(m>1,1,'first');
-    //                    lonely = find(idx==from,1,'first');
-    //                end
-    //                C(i,:) = X(lonely,:);
-    //                m(i) = 1;
-    //                idx(lonely) = i;
-    //                D(:,i) = distfun(X, C(i,:), distance, iter);
-
-    //                % Update clusters from which points are taken
-    //                [C(from,:), m(from)] = gcentroids(X, idx, from, distance);
-    //                D(:,from) = distfun(X, C(from,:), distance, iter);
-    //                changed = unique([changed from]);
-    //            end
+                // Find the point furthest away from its current cluster.
+                // Take that point out of its cluster and use it to create
+                // a new singleton cluster to replace the empty one.
+                qint32 lonely = -1;
+                for(qint32 j = 0; j < n; ++j)
+                    if (m_new[idx[j]] > 1 && (lonely < 0 || upper[j] > upper[lonely]))
+                        lonely = j;
+                if (lonely < 0)
+                    continue;
+
+                qint32 from = idx[lonely];
+                idx[lonely] = i;
+                upper[lonely] = 0;
+                lower[lonely] = 0;
+
+                VectorXi changed(2);
+                changed << i, from;
+                MatrixXd C_changed;
+                VectorXi m_changed;
+                gcentroids(X, idx, changed, C_changed, m_changed);
+                for(qint32 j = 0; j < 2; ++j)
+                {
+                    C_new.row(changed[j]) = C_changed.row(j);
+                    m_new[changed[j]] = m_changed[j];
+                }
             }
+            // "drop": The cluster stays empty and is excluded from any further processing
         }
 
-        // Compute the total sum of distances for the current configuration.
-        totsumD = 0;
-        for(qint32 i = 0; i < n; ++i)
-            totsumD += D.array()(idx[i]*n+i);//Colum Major
-        // Test for a cycle: if objective is not decreased, back out
-        // the last step and move on to the single update phase
-        if(prevtotsumD <= totsumD)
+        // Move the centroids and loosen the bounds by the distance they moved
+        VectorXd drift = VectorXd::Zero(k);
+        for(qint32 i = 0; i < k; ++i)
         {
-            idx = previdx;
-            MatrixXd C_new;
-            VectorXi m_new;
-            gcentroids(X, idx, changed, C_new, m_new);
-            C.block(0,0,k,C.cols()) = C_new;
-            m.block(0,0,k,1) = m_new;
-            --iter;
-            break;
+            if (m_new[i] > 0)
+            {
+                drift[i] = centroidDist(C.row(i), C_new.row(i))(0,0);
+                C.row(i) = C_new.row(i);
+            }
         }
+        m = m_new;
 
-//        printf("%6d\t%6d\t%8d\t%12g\n",iter,1,moved.rows(),totsumD);
+//        printf("%6d\t%6d\t%12g\n",iter,1,drift.maxCoeff());
         if (iter >= m_iMaxit)
             break;
 
-        // Determine closest cluster for each point and reassign points to clusters
-        previdx = idx;
-        prevtotsumD = totsumD;
+        qint32 iMaxDrift;
+        double maxDrift = drift.maxCoeff(&iMaxDrift);
+        double secondDrift = 0;
+        for(qint32 i = 0; i < k; ++i)
+            if (i != iMaxDrift && drift[i] > secondDrift)
+                secondDrift = drift[i];
 
-        VectorXi nidx(D.rows());
-        for(qint32 i = 0; i < D.rows(); ++i)
-            d[i] = D.row(i).minCoeff(&nidx[i]);
+        for(qint32 i = 0; i < n; ++i)
+        {
+            upper[i] += drift[idx[i]];
+            lower[i] -= idx[i] == iMaxDrift ? secondDrift : maxDrift;
+        }
 
-        // Determine which points moved
-        VectorXi moved = VectorXi::Zero(nidx.rows());
-        qint32 count = 0;
-        for(qint32 i = 0; i < nidx.rows(); ++i)
+        // Half the distance of every centroid to its closest neighbour. A point
+        // closer than that to its own centroid can not be closer to any other.
+        MatrixXd CC = centroidDist(C, C);
+        VectorXd s(k);
+        for(qint32 i = 0; i < k; ++i)
         {
-            if(nidx[i] != previdx[i])
-            {
-                moved[count] = i;
-                ++count;
-            }
+            s[i] = dInf;
+            for(qint32 j = 0; j < k; ++j)
+                if (j != i && m[j] > 0 && CC(i,j) < s[i])
+                    s[i] = CC(i,j);
+            s[i] *= 0.5;
         }
-        moved.conservativeResize(count);
 
-        if (moved.rows() > 0)
+        // Collect the points for which a closer centroid can not be ruled out
+        std::vector<qint32> candidates;
+        for(qint32 i = 0; i < n; ++i)
+            if (upper[i] > std::max(lower[i], s[idx[i]]))
+                candidates.push_back(i);
+
+        if (candidates.empty())
+        {
+            converged = true;
+            break;
+        }
+
+        // Determine closest cluster for the candidates, using one distance
+        // evaluation for all of them, and reassign them
+        qint32 numCand = static_cast<qint32>(candidates.size());
+        MatrixXd Xcand(numCand, p);
+        for(qint32 j = 0; j < p; ++j)
+            for(qint32 i = 0; i < numCand; ++i)
+                Xcand(i,j) = X(candidates[i], j);
+
+        MatrixXd Dcand = distfun(Xcand, C);
+        for(qint32 j = 0; j < k; ++j)
+            if (m[j] == 0)
+                Dcand.col(j).fill(dInf);
+
+        ArrayXd first(numCand);
+        ArrayXd second(numCand);
+        qint32 nummoved = 0;
+        for(qint32 i = 0; i < numCand; ++i)
         {
             // Resolve ties in favor of not moving
-            VectorXi moved_new = VectorXi::Zero(moved.rows());
-            count = 0;
-            for(qint32 i = 0; i < moved.rows(); ++i)
+            qint32 best = idx[candidates[i]];
+            first[i] = Dcand(i, best);
+            for(qint32 j = 0; j < k; ++j)
             {
-                if(D.array()(previdx[moved[i]] * n + moved[i]) > d[moved[i]])
+                if (Dcand(i,j) < first[i])
                 {
-                    moved_new[count] = moved[i];
-                    ++count;
+                    best = j;
+                    first[i] = Dcand(i,j);
                 }
             }
-            moved_new.conservativeResize(count);
-            moved = moved_new;
+
+            second[i] = dInf;
+            for(qint32 j = 0; j < k; ++j)
+                if (j != best && Dcand(i,j) < second[i])
+                    second[i] = Dcand(i,j);
+
+            if (best != idx[candidates[i]])
+            {
+                idx[candidates[i]] = best;
+                ++nummoved;
+            }
         }
 
-        if (moved.rows() == 0)
+        first = toMetric(first);
+        second = toMetric(second);
+        for(qint32 i = 0; i < numCand; ++i)
+        {
+            upper[candidates[i]] = first[i];
+            lower[candidates[i]] = second[i];
+        }
+
+        if (nummoved == 0)
         {
             converged = true;
             break;
         }
-
-        for(qint32 i = 0; i < moved.rows(); ++i)
-            if(moved[i] >= 0)
-                idx[ moved[i] ] = nidx[ moved[i] ];
-
-        // Find clusters that gained or lost members
-        std::vector<int> tmp;
-        for(qint32 i = 0; i < moved.rows(); ++i)
-            tmp.push_back(idx[moved[i]]);
-        for(qint32 i = 0; i < moved.rows(); ++i)
-            tmp.push_back(previdx[moved[i]]);
-
-        std::sort(tmp.begin(),tmp.end());
-
-        std::vector<int>::iterator it;
-        it = std::unique(tmp.begin(),tmp.end());
-        tmp.resize( it - tmp.begin() );
-
-        changed.conservativeResize(tmp.size());
-
-        for(quint32 i = 0; i < tmp.size(); ++i)
-            changed[i] = tmp[i];
     } // phase one
     return converged;
 } // nested function
@@ -602,6 +629,12 @@ bool KMeans::onlineUpdate(const MatrixXd& X, MatrixXd& C, VectorXi& idx)
 
         if (m_sDistance.compare("sqeuclidean") == 0)
         {
+            // Distances to all changed centroids at once
+            MatrixXd Cchanged(changed.rows(), p);
+            for(qint32 j = 0; j < changed.rows(); ++j)
+                Cchanged.row(j) = C.row(changed[j]);
+            MatrixXd Dchanged = distfun(X, Cchanged);
+
             for(qint32 j = 0; j < changed.rows(); ++j)
             {
                 qint32 i = changed[j];
@@ -619,7 +652,7 @@ bool KMeans::onlineUpdate(const MatrixXd& X, MatrixXd& C, VectorXi& idx)
 
                 Del.col(i) = ((double)m[i] / ((double)m[i] + sgn.cast<double>().array()));
 
-                Del.col(i).array() *= (X - C.row(i).replicate(n,1)).array().pow(2).rowwise().sum().array();
+                Del.col(i).array() *= Dchanged.col(j).array();
             }
         }
         else if (m_sDistance.compare("cityblock") == 0)
@@ -679,8 +712,6 @@ bool KMeans::onlineUpdate(const MatrixXd& X, MatrixXd& C, VectorXi& idx)
                 Del.col(i) = 1 + sgn.cast<double>().array()*
                         (A - (B + 2 * sgn.cast<double>().array() * m[i] * XCi.array() + 1).sqrt());
 
-                std::cout << "Del.col(i)\n" << Del.col(i) << std::endl;
-
 //                Del(:,i) = 1 + sgn .*...
 //                      (m(i).*normC(i) - sqrt((m(i).*normC(i)).^2 + 2.*sgn.*m(i).*XCi + 1));
             }
@@ -726,7 +757,7 @@ bool KMeans::onlineUpdate(const MatrixXd& X, MatrixXd& C, VectorXi& idx)
         }
         moved.conservativeResize(count);
 
-        if (moved.sum() > 0)
+        if (moved.rows() > 0)
         {
             // Resolve ties in favor of not moving
             VectorXi moved_new = VectorXi::Zero(moved.rows());
@@ -867,27 +898,26 @@ bool KMeans::onlineUpdate(const MatrixXd& X, MatrixXd& C, VectorXi& idx)
 
 //=============================================================================================================
 //DISTFUN Calculate point to cluster centroid distances.
-MatrixXd KMeans::distfun(const MatrixXd& X, MatrixXd& C)//, qint32 iter)
+MatrixXd KMeans::distfun(const MatrixXd& X, const MatrixXd& C) const
 {
-    MatrixXd D = MatrixXd::Zero(n,C.rows());
+    MatrixXd D(X.rows(), C.rows());
     qint32 nclusts = C.rows();
 
     if (m_sDistance.compare("sqeuclidean") == 0)
     {
-        for(qint32 i = 0; i < nclusts; ++i)
-        {
-            D.col(i) = (X.col(0).array() - C(i,0)).pow(2);
-
-            for(qint32 j = 1; j < p; ++j)
-                D.col(i) = D.col(i).array() + (X.col(j).array() - C(i,j)).pow(2);
-        }
+        // |x - c|^2 = |x|^2 + |c|^2 - 2x'c, all clusters with one matrix product
+        // The row norms are evaluated as products, which traverse the column major data contiguously
+        D.noalias() = -2.0 * X * C.transpose();
+        D.colwise() += X.cwiseAbs2() * VectorXd::Ones(X.cols());
+        D.rowwise() += (C.cwiseAbs2() * VectorXd::Ones(C.cols())).transpose();
+        D = D.cwiseMax(0.0);
     }
     else if (m_sDistance.compare("cityblock") == 0)
     {
         for(qint32 i = 0; i < nclusts; ++i)
         {
             D.col(i) = (X.col(0).array() - C(i,0)).array().abs();
-            for(qint32 j = 1; j < p; ++j)
+            for(qint32 j = 1; j < X.cols(); ++j)
             {
                 D.col(i).array() += (X.col(j).array() - C(i,j)).array().abs();
             }
@@ -896,17 +926,12 @@ MatrixXd KMeans::distfun(const MatrixXd& X, MatrixXd& C)//, qint32 iter)
     else if (m_sDistance.compare("cosine") == 0 || m_sDistance.compare("correlation") == 0)
     {
         // The points are normalized, centroids are not, so normalize them
-        MatrixXd normC = C.array().pow(2).rowwise().sum().sqrt();
+        VectorXd normC = C.rowwise().norm();
 //        if any(normC < eps(class(normC))) % small relative to unit-length data points
 //            error('Zero cluster centroid created at iteration %d.',iter);
-        for (qint32 i = 0; i < nclusts; ++i)
-        {
-            MatrixXd C_tmp = (C.row(i).array() / normC(i,0)).transpose();
-            D.col(i) = X * C_tmp;//max(1 - X * (C(i,:)./normC(i))', 0);
-            for(qint32 j = 0; j < D.rows(); ++j)
-                if(D(j,i) < 0)
-                    D(j,i) = 0;
-        }
+        MatrixXd Cnorm = C.array().colwise() / normC.array();
+        D.noalias() = X * Cnorm.transpose();
+        D = (1.0 - D.array()).cwiseMax(0.0);//max(1 - X * (C(i,:)./normC(i))', 0);
     }
 //case 'hamming'
 //    for i = 1:nclusts
@@ -921,6 +946,38 @@ MatrixXd KMeans::distfun(const MatrixXd& X, MatrixXd& C)//, qint32 iter)
     return D;
 } // function
 
+//=============================================================================================================
+
+ArrayXd KMeans::toMetric(const ArrayXd& arrDist) const
+{
+    if (m_sDistance.compare("sqeuclidean") == 0)
+        return arrDist.sqrt();
+    else if (m_sDistance.compare("cosine") == 0 || m_sDistance.compare("correlation") == 0)
+        return (2.0 * arrDist).sqrt(); // |x - c| = sqrt(2(1 - x'c)) for unit vectors
+
+    return arrDist;
+}
+
+//=============================================================================================================
+
+MatrixXd KMeans::centroidDist(const MatrixXd& A, const MatrixXd& B) const
+{
+    MatrixXd D;
+    if (m_sDistance.compare("cosine") == 0 || m_sDistance.compare("correlation") == 0)
+    {
+        // distfun expects the points to be normalized
+        VectorXd normA = A.rowwise().norm();
+        D = distfun(A.array().colwise() / normA.array(), B);
+    }
+    else
+    {
+        D = distfun(A, B);
+    }
+
+    ArrayXd arrMetric = toMetric(Map<ArrayXd>(D.data(), D.size()));
+    return Map<MatrixXd>(arrMetric.data(), D.rows(), D.cols());
+}
+
 //=============================================================================================================
 //GCENTROIDS Centroids and counts stratified by group.
 void KMeans::gcentroids(const MatrixXd& X, const VectorXi& index, const VectorXi& clusts,
@@ -928,75 +985,74 @@ void KMeans::gcentroids(const MatrixXd& X, const VectorXi& index, const VectorXi
 {
     qint32 num = clusts.rows();
     centroids = MatrixXd::Zero(num,p);
-    centroids.fill(std::numeric_limits<double>::quiet_NaN());
     counts = VectorXi::Zero(num);
 
-    VectorXi members;
-
-    qint32 c;
-
+    // Position of every cluster in clusts, -1 if not requested
+    VectorXi pos = VectorXi::Constant(k, -1);
     for(qint32 i = 0; i < num; ++i)
+        pos[clusts[i]] = i;
+
+    if(m_sDistance.compare("cityblock") == 0)
     {
-        c = 0;
-        members = VectorXi::Zero(index.rows());
+        // Separate out the members of each requested cluster in a single pass
+        std::vector<std::vector<qint32> > members(num);
         for(qint32 j = 0; j < index.rows(); ++j)
+            if(pos[index[j]] >= 0)
+                members[pos[index[j]]].push_back(j);
+
+        // Component-wise median
+        std::vector<double> coord;
+        for(qint32 i = 0; i < num; ++i)
         {
-            if(index[j] == clusts[i])
-            {
-                members[c] = j;
-                ++c;
-            }
-        }
-        members.conservativeResize(c);
-        if (c > 0)
-        {
+            qint32 c = static_cast<qint32>(members[i].size());
             counts[i] = c;
-            if(m_sDistance.compare("sqeuclidean") == 0)
-            {
-                //Initialize
-                if(members.rows() > 0)
-                    centroids.row(i) = RowVectorXd::Zero(centroids.cols());
+            if (c == 0)
+                continue;
 
-                for(qint32 j = 0; j < members.rows(); ++j)
-                    centroids.row(i).array() += X.row(members[j]).array() / counts[i];
-            }
-            else if(m_sDistance.compare("cityblock") == 0)
+            coord.resize(c);
+            qint32 nn = c / 2;
+            for(qint32 h = 0; h < p; ++h)
             {
-                // Separate out sorted coords for points in i'th cluster,
-                // and use to compute a fast median, component-wise
-                MatrixXd Xsorted(counts[i],p);
-                c = 0;
-
-                for(qint32 j = 0; j < index.rows(); ++j)
-                {
-                    if(index[j] == clusts[i])
-                    {
-                        Xsorted.row(c) = X.row(j);
-                        ++c;
-                    }
-                }
-
-                for(qint32 j = 0; j < Xsorted.cols(); ++j)
-                    std::sort(Xsorted.col(j).data(),Xsorted.col(j).data()+Xsorted.rows());
+                for(qint32 j = 0; j < c; ++j)
+                    coord[j] = X(members[i][j], h);
 
-                qint32 nn = floor(0.5*(counts(i)))-1;
-                if (counts[i] % 2 == 0)
-                    centroids.row(i) = .5 * (Xsorted.row(nn) + Xsorted.row(nn+1));
+                std::nth_element(coord.begin(), coord.begin() + nn, coord.end());
+                if (c % 2 == 0)
+                    centroids(i,h) = .5 * (*std::max_element(coord.begin(), coord.begin() + nn) + coord[nn]);
                 else
-                    centroids.row(i) = Xsorted.row(nn+1);
+                    centroids(i,h) = coord[nn];
             }
-            else if(m_sDistance.compare("cosine") == 0 || m_sDistance.compare("correlation") == 0)
-            {
-                for(qint32 j = 0; j < members.rows(); ++j)
-                    centroids.row(i).array() += X.row(members[j]).array() / counts[i]; // unnormalized
-            }
-//            else if(m_sDistance.compare("hamming") == 0)
-//            {
-//                % Compute a fast median for binary data, component-wise
-//                centroids(i,:) = .5*sign(2*sum(X(members,:), 1) - counts(i)) + .5;
-//            }
         }
     }
+    else if(m_sDistance.compare("sqeuclidean") == 0 || m_sDistance.compare("cosine") == 0 || m_sDistance.compare("correlation") == 0)
+    {
+        // Sum up all members column by column, unnormalized for cosine and correlation
+        VectorXi target(index.rows());
+        for(qint32 j = 0; j < index.rows(); ++j)
+        {
+            target[j] = pos[index[j]];
+            if(target[j] >= 0)
+                ++counts[target[j]];
+        }
+
+        for(qint32 h = 0; h < p; ++h)
+            for(qint32 j = 0; j < index.rows(); ++j)
+                if(target[j] >= 0)
+                    centroids(target[j], h) += X(j,h);
+
+        for(qint32 i = 0; i < num; ++i)
+            if(counts[i] > 0)
+                centroids.row(i) /= counts[i];
+    }
+//    else if(m_sDistance.compare("hamming") == 0)
+//    {
+//        % Compute a fast median for binary data, component-wise
+//        centroids(i,:) = .5*sign(2*sum(X(members,:), 1) - counts(i)) + .5;
+//    }
+
+    for(qint32 i = 0; i < num; ++i)
+        if(counts[i] == 0)
+            centroids.row(i).fill(std::numeric_limits<double>::quiet_NaN());
 }// function
 
 //=============================================================================================================
@@ -1006,12 +1062,7 @@ double KMeans::unifrnd(double a, double b)
     if (a > b)
         return std::numeric_limits<double>::quiet_NaN();
 
-    double a2 = a/2.0;
-    double b2 = b/2.0;
-    double mu = a2+b2;
-    double sig = b2-a2;
-
-    double r = mu + sig * (2.0* (rand() % 1000)/1000 -1.0);
+    std::uniform_real_distribution<double> dist(a, b);
 
-    return r;
+    return dist(m_generator);
 }
@@ -42,6 +42,8 @@
 
 #include "utils_global.h"
 
+#include <random>
+
 //=============================================================================================================
 // QT INCLUDES
 //=============================================================================================================
@@ -75,7 +77,7 @@ public:
     typedef QSharedPointer<const KMeans> ConstSPtr; /**< Const shared pointer type for KMeans. */
 
     //distance {'sqeuclidean','cityblock','cosine','correlation','hamming'};
-    //startNames = {'uniform','sample','cluster'};
+    //startNames = {'plus','uniform','sample','cluster'};
     //emptyactNames = {'error','drop','singleton'};
 
     //=========================================================================================================
@@ -83,14 +85,14 @@ public:
      * Constructs a KMeans algorithm object.
      *
      * @param[in] distance   (optional) K-Means distance measure: "sqeuclidean" (default), "cityblock" , "cosine", "correlation", "hamming".
-     * @param[in] start      (optional) Cluster initialization: "sample" (default), "uniform", "cluster".
-     * @param[in] replicates (optional) Number of K-Means replicates, which are generated. Best is returned.
+     * @param[in] start      (optional) Cluster initialization: "plus" (k-means++, default), "sample", "uniform", "cluster".
+     * @param[in] replicates (optional) Number of K-Means replicates, which are generated in parallel. Best is returned.
      * @param[in] emptyact   (optional) What happens if a cluster wents empty: "error" (default), "drop", "singleton".
      * @param[in] online     (optional) If centroids should be updated during iterations: true (default), false.
      * @param[in] maxit      (optional) maximal number of iterations per replicate; 100 by default.
      */
     explicit KMeans(QString distance = QString("sqeuclidean") ,
-                    QString start = QString("sample"),
+                    QString start = QString("plus"),
                     qint32 replicates = 1,
                     QString emptyact = QString("error"),
                     bool online = true,
@@ -114,7 +116,51 @@ public:
                     Eigen::VectorXd& sumD,
                     Eigen::MatrixXd& D);
 
+    //=========================================================================================================
+    /**
+     * Sets the seed of the random generator. Replicate r is initialized with seed + r, so repeated calls to
+     * calculate() return the same clustering, independent of the order in which the replicates finish.
+     *
+     * @param[in] iSeed      The seed.
+     */
+    void setSeed(quint32 iSeed);
+
 private:
+    //=========================================================================================================
+    /**
+     * The outcome of a single replicate.
+     */
+    struct ReplicateResult {
+        Eigen::VectorXi idx;    /**< The cluster indeces of the points. */
+        Eigen::MatrixXd C;      /**< The cluster centroids. */
+        Eigen::VectorXd sumD;   /**< The within cluster sums of distances. */
+        Eigen::MatrixXd D;      /**< The point to centroid distances. */
+        double totsumD;         /**< The total sum of distances. */
+    };
+
+    //=========================================================================================================
+    /**
+     * Runs a single replicate. Uses the member state, so concurrent replicates need to run on copies.
+     *
+     * @param[in] X      Input data (rows = points; cols = p dimensional space).
+     * @param[in] rep    The replicate number, used to seed the random generator.
+     *
+     * @return The clustering of this replicate.
+     */
+    ReplicateResult runReplicate(const Eigen::MatrixXd& X,
+                                 qint32 rep);
+
+    //=========================================================================================================
+    /**
+     * k-means++ initialization: The first centroid is a random point, every further centroid is a point drawn
+     * with probability proportional to its distance to the closest centroid chosen so far.
+     *
+     * @param[in] X      Input data.
+     * @param[out] C     The initial centroids.
+     */
+    void initPlus(const Eigen::MatrixXd& X,
+                  Eigen::MatrixXd& C);
+
     //=========================================================================================================
     /**
      * Calculate point to cluster centroid distances.
@@ -125,21 +171,48 @@ private:
      * @return Cluster centroid distances.
      */
     Eigen::MatrixXd distfun(const Eigen::MatrixXd& X,
-                            Eigen::MatrixXd& C);//, qint32 iter);
+                            const Eigen::MatrixXd& C) const;
 
     //=========================================================================================================
     /**
-     * Updates clusters when points moved
+     * Maps distances as returned by distfun onto a metric which fulfills the triangle inequality. This is the
+     * identity for "cityblock", the euclidean distance for "sqeuclidean" and the chord length on the unit sphere
+     * for "cosine" and "correlation".
+     *
+     * @param[in] arrDist    Distances as returned by distfun.
+     *
+     * @return The metric distances.
+     */
+    Eigen::ArrayXd toMetric(const Eigen::ArrayXd& arrDist) const;
+
+    //=========================================================================================================
+    /**
+     * Metric distances between two sets of centroids.
+     *
+     * @param[in] A  First set of centroids.
+     * @param[in] B  Second set of centroids.
+     *
+     * @return The metric distances (rows = A; cols = B).
+     */
+    Eigen::MatrixXd centroidDist(const Eigen::MatrixXd& A,
+                                 const Eigen::MatrixXd& B) const;
+
+    //=========================================================================================================
+    /**
+     * Updates clusters when points moved. Distances are only recomputed for points whose upper bound to their
+     * own centroid exceeds the lower bound to all other centroids (Hamerly's triangle inequality pruning).
      *
      * @param[in] X          Input data.
      * @param[in, out] C     Cluster centroids.
      * @param[in, out] idx   The cluster indeces to which cluster the input points belong to.
+     * @param[in] D          The distances of all points to the initial centroids.
      *
      * @return true if converged, false otherwise.
      */
     bool batchUpdate(const Eigen::MatrixXd& X,
                      Eigen::MatrixXd& C,
-                     Eigen::VectorXi& idx);
+                     Eigen::VectorXi& idx,
+                     const Eigen::MatrixXd& D);
 
     //=========================================================================================================
     /**
@@ -183,11 +256,16 @@ private:
     double unifrnd(double a, double b);
 
     QString m_sDistance;    /**< Distance measurement to use: "sqeuclidean" (default), "cityblock" , "cosine", "correlation", "hamming". */
-    QString m_sStart;       /**< Initialization to use: "sample" (default), "uniform", "cluster". */
+    QString m_sStart;       /**< Initialization to use: "plus" (default), "sample", "uniform", "cluster". */
     qint32 m_iReps;         /**< Number of K-Means replicates, which should be generated. */
     QString m_sEmptyact;    /**< What should be done if a cluster wents empty: "error" (default), "drop", "singleton". */
     qint32 m_iMaxit;        /**< Maximal number of iterations per replicate. */
     bool m_bOnline;         /**< If online update should be performed. */
+    quint32 m_iSeed;        /**< Seed of the first replicate. */
+
+    std::mt19937 m_generator;   /**< Random generator of the current replicate. */
+    Eigen::RowVectorXd Xmins;   /**< Column minima of the input data, used by the "uniform" start. */
+    Eigen::RowVectorXd Xmaxs;   /**< Column maxima of the input data, used by the "uniform" start. */
 
     qint32 emptyErrCnt;     /**< Counts the occurence of empty errors. */
 
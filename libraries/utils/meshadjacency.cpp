@@ -0,0 +1,216 @@
+//=============================================================================================================
+/**
+ * @file     meshadjacency.cpp
+ * @author   agent <agent@local>
+ * @since    0.1.9
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, agent. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    MeshAdjacency class definition.
+ *
+ */
+
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include "meshadjacency.h"
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QtConcurrent>
+#include <QPair>
+
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace UTILSLIB;
+using namespace Eigen;
+
+//=============================================================================================================
+// DEFINE GLOBAL METHODS
+//=============================================================================================================
+
+/**
+ * Splits [0, iNumVertices) into ranges which are processed by the worker threads.
+ */
+static QVector<QPair<int,int> > vertexBlocks(int iNumVertices)
+{
+    const int iMinBlockSize = 4096;
+    int iNumBlocks = std::max(1, std::min(4 * QThread::idealThreadCount(), iNumVertices / iMinBlockSize));
+    int iBlockSize = (iNumVertices + iNumBlocks - 1) / iNumBlocks;
+
+    QVector<QPair<int,int> > vecBlocks;
+    for(int iBegin = 0; iBegin < iNumVertices; iBegin += iBlockSize) {
+        vecBlocks.append(qMakePair(iBegin, std::min(iBegin + iBlockSize, iNumVertices)));
+    }
+
+    return vecBlocks;
+}
+
+//=============================================================================================================
+// DEFINE MEMBER METHODS
+//=============================================================================================================
+
+MeshAdjacency::MeshAdjacency()
+{
+}
+
+//=============================================================================================================
+
+MeshAdjacency::MeshAdjacency(const MatrixX3i& matTris,
+                             int iNumVertices)
+{
+    const int iNumTris = static_cast<int>(matTris.rows());
+    if(iNumTris > 0) {
+        iNumVertices = std::max(iNumVertices, matTris.maxCoeff() + 1);
+    }
+    iNumVertices = std::max(iNumVertices, 0);
+
+    // Vertex to triangle: count, scan and scatter. Scattering in triangle order keeps every list sorted.
+    m_vecTriOffsets = VectorXi::Zero(iNumVertices + 1);
+    for(int k = 0; k < 3; ++k) {
+        for(int p = 0; p < iNumTris; ++p) {
+            ++m_vecTriOffsets[matTris(p,k) + 1];
+        }
+    }
+    std::partial_sum(m_vecTriOffsets.data(), m_vecTriOffsets.data() + m_vecTriOffsets.size(), m_vecTriOffsets.data());
+
+    m_vecTriIndices.resize(3 * iNumTris);
+    VectorXi vecCursor = m_vecTriOffsets.head(iNumVertices);
+    for(int p = 0; p < iNumTris; ++p) {
+        for(int k = 0; k < 3; ++k) {
+            m_vecTriIndices[vecCursor[matTris(p,k)]++] = p;
+        }
+    }
+
+    // Vertex to vertex: count the distinct neighbors, scan and fill. Vertices are independent of each other, so
+    // both passes run block wise in parallel.
+    QVector<QPair<int,int> > vecBlocks = vertexBlocks(iNumVertices);
+    int iMaxNeighborTri = 0;
+    for(int v = 0; v < iNumVertices; ++v) {
+        iMaxNeighborTri = std::max(iMaxNeighborTri, numNeighborTri(v));
+    }
+
+    m_vecVertOffsets = VectorXi::Zero(iNumVertices + 1);
+    QtConcurrent::blockingMap(vecBlocks, [&](const QPair<int,int>& block) {
+        std::vector<int> vecScratch(2 * iMaxNeighborTri);
+        for(int v = block.first; v < block.second; ++v) {
+            m_vecVertOffsets[v + 1] = collectNeighborVert(matTris, v, vecScratch.data());
+        }
+    });
+    std::partial_sum(m_vecVertOffsets.data(), m_vecVertOffsets.data() + m_vecVertOffsets.size(), m_vecVertOffsets.data());
+
+    m_vecVertIndices.resize(m_vecVertOffsets[iNumVertices]);
+    QtConcurrent::blockingMap(vecBlocks, [&](const QPair<int,int>& block) {
+        for(int v = block.first; v < block.second; ++v) {
+            collectNeighborVert(matTris, v, m_vecVertIndices.data() + m_vecVertOffsets[v]);
+        }
+    });
+}
+
+//=============================================================================================================
+
+MeshAdjacency MeshAdjacency::fromNeighborVert(const QVector<QVector<int> >& vecNeighborVertices)
+{
+    MeshAdjacency adjacency;
+
+    const int iNumVertices = vecNeighborVertices.size();
+    adjacency.m_vecVertOffsets.resize(iNumVertices + 1);
+    adjacency.m_vecVertOffsets[0] = 0;
+    for(int v = 0; v < iNumVertices; ++v) {
+        adjacency.m_vecVertOffsets[v + 1] = adjacency.m_vecVertOffsets[v] + vecNeighborVertices[v].size();
+    }
+
+    adjacency.m_vecVertIndices.resize(adjacency.m_vecVertOffsets[iNumVertices]);
+    for(int v = 0; v < iNumVertices; ++v) {
+        std::copy(vecNeighborVertices[v].constBegin(),
+                  vecNeighborVertices[v].constEnd(),
+                  adjacency.m_vecVertIndices.data() + adjacency.m_vecVertOffsets[v]);
+    }
+
+    adjacency.m_vecTriOffsets = VectorXi::Zero(iNumVertices + 1);
+
+    return adjacency;
+}
+
+//=============================================================================================================
+
+QVector<QVector<int> > MeshAdjacency::toNeighborVert() const
+{
+    QVector<QVector<int> > vecNeighborVertices(numVertices());
+
+    for(int v = 0; v < numVertices(); ++v) {
+        vecNeighborVertices[v].reserve(numNeighborVert(v));
+        std::copy(neighborVert(v), neighborVert(v) + numNeighborVert(v), std::back_inserter(vecNeighborVertices[v]));
+    }
+
+    return vecNeighborVertices;
+}
+
+//=============================================================================================================
+
+QVector<QVector<int> > MeshAdjacency::toNeighborTri() const
+{
+    QVector<QVector<int> > vecNeighborTriangles(numVertices());
+
+    for(int v = 0; v < numVertices(); ++v) {
+        vecNeighborTriangles[v].reserve(numNeighborTri(v));
+        std::copy(neighborTri(v), neighborTri(v) + numNeighborTri(v), std::back_inserter(vecNeighborTriangles[v]));
+    }
+
+    return vecNeighborTriangles;
+}
+
+//=============================================================================================================
+
+int MeshAdjacency::collectNeighborVert(const MatrixX3i& matTris,
+                                       int iVertex,
+                                       int* pNeighbors) const
+{
+    int iNumNeighbors = 0;
+    const int* pTris = neighborTri(iVertex);
+
+    for(int p = 0; p < numNeighborTri(iVertex); ++p) {
+        //Fit in the other vertices of the neighboring triangle
+        for(int c = 0; c < 3; ++c) {
+            int iVert = matTris(pTris[p], c);
+
+            if(iVert != iVertex && std::find(pNeighbors, pNeighbors + iNumNeighbors, iVert) == pNeighbors + iNumNeighbors) {
+                pNeighbors[iNumNeighbors++] = iVert;
+            }
+        }
+    }
+
+    return iNumNeighbors;
+}
@@ -0,0 +1,283 @@
+//=============================================================================================================
+/**
+ * @file     meshadjacency.h
+ * @author   agent <agent@local>
+ * @since    0.1.9
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, agent. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    MeshAdjacency class declaration.
+ *
+ */
+
+
+#ifndef MESHADJACENCY_H
+#define MESHADJACENCY_H
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include "utils_global.h"
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QSharedPointer>
+#include <QVector>
+
+//=============================================================================================================
+// EIGEN INCLUDES
+//=============================================================================================================
+
+#include <Eigen/Core>
+
+//=============================================================================================================
+// DEFINE NAMESPACE UTILSLIB
+//=============================================================================================================
+
+namespace UTILSLIB
+{
+
+//=============================================================================================================
+/**
+ * Immutable vertex to vertex and vertex to triangle adjacency of a triangle mesh in compressed sparse row (CSR)
+ * layout. The neighbors of vertex k are stored in indices[offsets[k]] ... indices[offsets[k+1]-1]. The neighboring
+ * triangles of a vertex are sorted by triangle index, the neighboring vertices are stored in the order they first
+ * appear in these triangles, which matches the order of the former neighbor_tri and neighbor_vert lists.
+ *
+ * @brief Compact CSR mesh topology.
+ */
+class UTILSSHARED_EXPORT MeshAdjacency
+{
+public:
+    typedef QSharedPointer<MeshAdjacency> SPtr;            /**< Shared pointer type for MeshAdjacency. */
+    typedef QSharedPointer<const MeshAdjacency> ConstSPtr; /**< Const shared pointer type for MeshAdjacency. */
+
+    //=========================================================================================================
+    /**
+     * Constructs an empty adjacency.
+     */
+    MeshAdjacency();
+
+    //=========================================================================================================
+    /**
+     * Builds the adjacency of the given triangulation.
+     *
+     * @param[in] matTris        The triangles, one per row.
+     * @param[in] iNumVertices   Number of vertices. If smaller than the largest vertex index + 1 the latter is used.
+     */
+    explicit MeshAdjacency(const Eigen::MatrixX3i& matTris,
+                           int iNumVertices = -1);
+
+    //=========================================================================================================
+    /**
+     * Builds a vertex to vertex only adjacency from per vertex neighbor lists.
+     *
+     * @param[in] vecNeighborVertices    The neighboring vertices of each vertex.
+     *
+     * @return the adjacency holding no triangle information.
+     */
+    static MeshAdjacency fromNeighborVert(const QVector<QVector<int> >& vecNeighborVertices);
+
+    //=========================================================================================================
+    /**
+     * Returns true if the adjacency holds no vertices.
+     *
+     * @return true if empty.
+     */
+    inline bool isEmpty() const;
+
+    //=========================================================================================================
+    /**
+     * Returns the number of vertices.
+     *
+     * @return the number of vertices.
+     */
+    inline int numVertices() const;
+
+    //=========================================================================================================
+    /**
+     * Returns the number of neighboring vertices of a vertex.
+     *
+     * @param[in] iVertex    The vertex index.
+     *
+     * @return the number of neighboring vertices.
+     */
+    inline int numNeighborVert(int iVertex) const;
+
+    //=========================================================================================================
+    /**
+     * Returns a pointer to the first neighboring vertex of a vertex.
+     *
+     * @param[in] iVertex    The vertex index.
+     *
+     * @return pointer to the first of numNeighborVert(iVertex) vertex indices.
+     */
+    inline const int* neighborVert(int iVertex) const;
+
+    //=========================================================================================================
+    /**
+     * Returns the number of neighboring triangles of a vertex.
+     *
+     * @param[in] iVertex    The vertex index.
+     *
+     * @return the number of neighboring triangles.
+     */
+    inline int numNeighborTri(int iVertex) const;
+
+    //=========================================================================================================
+    /**
+     * Returns a pointer to the first neighboring triangle of a vertex.
+     *
+     * @param[in] iVertex    The vertex index.
+     *
+     * @return pointer to the first of numNeighborTri(iVertex) triangle indices.
+     */
+    inline const int* neighborTri(int iVertex) const;
+
+    //=========================================================================================================
+    /**
+     * The CSR arrays. The offsets hold numVertices() + 1 entries.
+     *
+     * @return the requested CSR array.
+     */
+    inline const Eigen::VectorXi& vertOffsets() const;
+    inline const Eigen::VectorXi& vertIndices() const;
+    inline const Eigen::VectorXi& triOffsets() const;
+    inline const Eigen::VectorXi& triIndices() const;
+
+    //=========================================================================================================
+    /**
+     * Expands the vertex to vertex adjacency to per vertex lists.
+     *
+     * @return the neighboring vertices of each vertex.
+     */
+    QVector<QVector<int> > toNeighborVert() const;
+
+    //=========================================================================================================
+    /**
+     * Expands the vertex to triangle adjacency to per vertex lists.
+     *
+     * @return the neighboring triangles of each vertex.
+     */
+    QVector<QVector<int> > toNeighborTri() const;
+
+private:
+    //=========================================================================================================
+    /**
+     * Collects the distinct neighboring vertices of a vertex from its neighboring triangles.
+     *
+     * @param[in] matTris    The triangles.
+     * @param[in] iVertex    The vertex index.
+     * @param[out] pNeighbors    Receives the neighbors, must hold at least 2 * numNeighborTri(iVertex) entries.
+     *
+     * @return the number of distinct neighbors.
+     */
+    int collectNeighborVert(const Eigen::MatrixX3i& matTris,
+                            int iVertex,
+                            int* pNeighbors) const;
+
+    Eigen::VectorXi m_vecVertOffsets;   /**< CSR offsets of the vertex to vertex adjacency. */
+    Eigen::VectorXi m_vecVertIndices;   /**< CSR indices of the vertex to vertex adjacency. */
+    Eigen::VectorXi m_vecTriOffsets;    /**< CSR offsets of the vertex to triangle adjacency. */
+    Eigen::VectorXi m_vecTriIndices;    /**< CSR indices of the vertex to triangle adjacency. */
+};
+
+//=============================================================================================================
+// INLINE DEFINITIONS
+//=============================================================================================================
+
+inline bool MeshAdjacency::isEmpty() const
+{
+    return m_vecVertOffsets.size() <= 1;
+}
+
+//=============================================================================================================
+
+inline int MeshAdjacency::numVertices() const
+{
+    return m_vecVertOffsets.size() > 0 ? static_cast<int>(m_vecVertOffsets.size()) - 1 : 0;
+}
+
+//=============================================================================================================
+
+inline int MeshAdjacency::numNeighborVert(int iVertex) const
+{
+    return m_vecVertOffsets[iVertex + 1] - m_vecVertOffsets[iVertex];
+}
+
+//=============================================================================================================
+
+inline const int* MeshAdjacency::neighborVert(int iVertex) const
+{
+    return m_vecVertIndices.data() + m_vecVertOffsets[iVertex];
+}
+
+//=============================================================================================================
+
+inline int MeshAdjacency::numNeighborTri(int iVertex) const
+{
+    return m_vecTriOffsets[iVertex + 1] - m_vecTriOffsets[iVertex];
+}
+
+//=============================================================================================================
+
+inline const int* MeshAdjacency::neighborTri(int iVertex) const
+{
+    return m_vecTriIndices.data() + m_vecTriOffsets[iVertex];
+}
+
+//=============================================================================================================
+
+inline const Eigen::VectorXi& MeshAdjacency::vertOffsets() const
+{
+    return m_vecVertOffsets;
+}
+
+//=============================================================================================================
+
+inline const Eigen::VectorXi& MeshAdjacency::vertIndices() const
+{
+    return m_vecVertIndices;
+}
+
+//=============================================================================================================
+
+inline const Eigen::VectorXi& MeshAdjacency::triOffsets() const
+{
+    return m_vecTriOffsets;
+}
+
+//=============================================================================================================
+
+inline const Eigen::VectorXi& MeshAdjacency::triIndices() const
+{
+    return m_vecTriIndices;
+}
+} // NAMESPACE UTILSLIB
+
+#endif // MESHADJACENCY_H
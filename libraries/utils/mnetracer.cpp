@@ -32,8 +32,21 @@
  *
  */
 
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
 #include "mnetracer.h"
 
+#include <fstream>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <memory>
+#include <vector>
+#include <unordered_set>
+#include <cstdio>
 
 using namespace UTILSLIB;
 
@@ -42,255 +55,491 @@ using namespace UTILSLIB;
 //=============================================================================================================
 
 static const char* defaultTracerFileName("default_MNETracer_file.json");
-bool MNETracer::ms_bIsEnabled(false);
-std::ofstream MNETracer::ms_OutputFileStream;
-bool MNETracer::ms_bIsFirstEvent(true);
-std::mutex MNETracer::ms_outFileMutex;
-long long MNETracer::ms_iZeroTime(0);
+std::atomic<bool> MNETracer::ms_bIsEnabled(false);
+
+namespace {
 
 //=============================================================================================================
-// DEFINE MEMBER METHODS
+/**
+ * One recorded event. Names are not copied, they point to string literals or interned strings.
+ */
+struct TraceEvent
+{
+    const char* pName;          /**< Scope or counter name. */
+    const char* pFile;          /**< File of the scope, nullptr for counters. */
+    int         iLine;          /**< Line of the scope. */
+    long long   iTime;          /**< Start time in ns since the zero time. */
+    long long   iValue;         /**< Duration in ns for scopes, value for counters. */
+};
+
 //=============================================================================================================
+/**
+ * Lock free single producer, single consumer queue of the events of one thread. The owning thread pushes, the
+ * flusher drains.
+ */
+struct ThreadBuffer
+{
+    static const size_t ms_iCapacity = 1 << 14;     /**< Number of events, a power of two. */
+
+    explicit ThreadBuffer(int iId)
+    : events(ms_iCapacity)
+    , iHead(0)
+    , iTail(0)
+    , iNumDropped(0)
+    , bThreadFinished(false)
+    , iThreadId(iId)
+    , iSampleCounter(0)
+    {
+    }
 
-MNETracer::MNETracer(const std::string &file, const std::string &function, int lineNumber)
-: m_bIsInitialized(false)
-, m_bPrintToTerminal(false)
-, m_sFileName(file)
-, m_sFunctionName(function)
-, m_iLineNumber(lineNumber)
-, m_iThreadId("0")
-, m_iBeginTime(0)
-, m_iEndTime(0)
-, m_dDurationMilis(0.)
+    inline void push(const TraceEvent& event)
+    {
+        size_t iCurrentHead = iHead.load(std::memory_order_relaxed);
+        if(iCurrentHead - iTail.load(std::memory_order_acquire) >= ms_iCapacity) {
+            iNumDropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        events[iCurrentHead & (ms_iCapacity - 1)] = event;
+        iHead.store(iCurrentHead + 1, std::memory_order_release);
+    }
+
+    std::vector<TraceEvent>     events;             /**< The ring of events. */
+    std::atomic<size_t>         iHead;              /**< Number of pushed events, written by the owning thread. */
+    std::atomic<size_t>         iTail;              /**< Number of drained events, written by the flusher. */
+    std::atomic<long long>      iNumDropped;        /**< Number of events dropped because the ring was full. */
+    std::atomic<bool>           bThreadFinished;    /**< Whether the owning thread has exited. */
+    const int                   iThreadId;          /**< Id of the owning thread in the trace. */
+    unsigned int                iSampleCounter;     /**< Scope counter for sampling, owning thread only. */
+};
+
+//=============================================================================================================
+/**
+ * State shared by all tracers: the registered thread buffers, the output file and the flusher thread.
+ */
+struct TracerBackend
 {
-    if (ms_bIsEnabled)
+    TracerBackend()
+    : iZeroTime(0)
+    , iNumDroppedReleased(0)
+    , iFlushIntervalMs(50)
+    , iSamplingInterval(1)
+    , iNextThreadId(1)
+    , bFirstEvent(true)
+    , bStopFlusher(false)
     {
-        initialize();
-        writeBeginEvent();
     }
-}
+
+    ~TracerBackend()
+    {
+        // The application exits while tracing, still close the file properly
+        std::lock_guard<std::mutex> lock(controlMutex);
+        finish();
+    }
+
+    std::shared_ptr<ThreadBuffer> registerThread()
+    {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        buffers.push_back(std::make_shared<ThreadBuffer>(iNextThreadId++));
+        return buffers.back();
+    }
+
+    const char* intern(const std::string& sName)
+    {
+        std::lock_guard<std::mutex> lock(namesMutex);
+        return names.insert(sName).first->c_str();
+    }
+
+    long long timeNow() const
+    {
+        auto timeNow = std::chrono::steady_clock::now();
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(timeNow.time_since_epoch()).count()
+               - iZeroTime.load(std::memory_order_relaxed);
+    }
+
+    long long numDropped()
+    {
+        std::lock_guard<std::mutex> lock(registryMutex);
+
+        long long iNumDropped = iNumDroppedReleased.load();
+        for(const std::shared_ptr<ThreadBuffer>& pBuffer : buffers) {
+            iNumDropped += pBuffer->iNumDropped.load(std::memory_order_relaxed);
+        }
+        return iNumDropped;
+    }
+
+    void flush(bool bWrite);
+    void finish();
+    void writeEvent(const TraceEvent& event, int iThreadId);
+    void run();
+
+    std::atomic<long long>                      iZeroTime;          /**< Origin of all time stamps, in ns. */
+    std::atomic<long long>                      iNumDroppedReleased;/**< Dropped events of already released buffers. */
+    std::atomic<int>                            iFlushIntervalMs;   /**< Flush interval of the background thread. */
+    std::atomic<int>                            iSamplingInterval;  /**< Record every n-th scope of a thread. */
+
+    std::mutex                                  registryMutex;      /**< Guards buffers and iNextThreadId. */
+    std::vector<std::shared_ptr<ThreadBuffer> > buffers;            /**< Buffers of all threads which traced. */
+    int                                         iNextThreadId;      /**< Id of the next registered thread. */
+
+    std::mutex                                  namesMutex;         /**< Guards names. */
+    std::unordered_set<std::string>             names;              /**< Interned counter names. */
+
+    std::mutex                                  controlMutex;       /**< Serializes enable and disable. */
+    std::ofstream                               outputFileStream;   /**< Output file stream to write results. */
+    std::string                                 sLine;              /**< Scratch buffer of the flusher. */
+    bool                                        bFirstEvent;        /**< Whether no event was written yet. */
+
+    std::thread                                 flusher;            /**< Background thread writing the events. */
+    std::mutex                                  flusherMutex;       /**< Guards bStopFlusher. */
+    std::condition_variable                     flusherCondition;   /**< Wakes the flusher up early. */
+    bool                                        bStopFlusher;       /**< Whether the flusher should exit. */
+};
 
 //=============================================================================================================
 
-MNETracer::~MNETracer()
+TracerBackend& backend()
+{
+    static TracerBackend s_backend;
+    return s_backend;
+}
+
+//=============================================================================================================
+/**
+ * Marks the buffer of a thread as finished when the thread exits, the flusher releases it once it is drained.
+ */
+struct ThreadBufferHandle
 {
-    if (ms_bIsEnabled && m_bIsInitialized)
+    ~ThreadBufferHandle()
     {
-        registerFinalTime();
-        writeEndEvent();
-        if (m_bPrintToTerminal)
-        {
-            calculateDuration();
-            printDurationMiliSec();
+        if(pBuffer) {
+            pBuffer->bThreadFinished.store(true, std::memory_order_release);
         }
     }
-}
+
+    std::shared_ptr<ThreadBuffer> pBuffer;
+};
 
 //=============================================================================================================
 
-void MNETracer::enable(const std::string &jsonFileName)
+ThreadBuffer* threadBuffer()
 {
-    ms_OutputFileStream.open(jsonFileName);
-    writeHeader();
-    setZeroTime();
-    if (ms_OutputFileStream.is_open())
-    {
-        ms_bIsEnabled = true;
+    static thread_local ThreadBufferHandle t_handle;
+    if(!t_handle.pBuffer) {
+        t_handle.pBuffer = backend().registerThread();
     }
+    return t_handle.pBuffer.get();
 }
 
 //=============================================================================================================
 
-void MNETracer::enable()
+void appendEscaped(std::string& sOut, const char* pText)
 {
-    enable(defaultTracerFileName);
+    for(; *pText; ++pText) {
+        if(*pText == '\\' || *pText == '"') {
+            sOut.push_back('\\');
+        }
+        sOut.push_back(*pText);
+    }
 }
 
 //=============================================================================================================
 
-void MNETracer::disable()
+void TracerBackend::writeEvent(const TraceEvent& event, int iThreadId)
 {
-    if (ms_bIsEnabled)
-    {
-        writeFooter();
-        ms_OutputFileStream.flush();
-        ms_OutputFileStream.close();
-        ms_bIsEnabled = false;
+    char buffer[128];
+
+    sLine.clear();
+    sLine.append(bFirstEvent ? "" : ",");
+    sLine.append("{\"name\":\"");
+    appendEscaped(sLine, event.pName);
+
+    if(event.pFile) {
+        // Complete event, time stamps in us
+        std::snprintf(buffer, sizeof(buffer), "\",\"cat\":\"bst\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%d",
+                      event.iTime * 1e-3, event.iValue * 1e-3, iThreadId);
+        sLine.append(buffer);
+        sLine.append(",\"args\":{\"file path\":\"");
+        appendEscaped(sLine, event.pFile);
+        std::snprintf(buffer, sizeof(buffer), "\",\"line number\":%d}}\n", event.iLine);
+        sLine.append(buffer);
+    } else {
+        // Counter event
+        std::snprintf(buffer, sizeof(buffer), "\",\"ph\":\"C\",\"ts\":%.3f,\"pid\":1,\"tid\":%d,\"args\":{\"",
+                      event.iTime * 1e-3, iThreadId);
+        sLine.append(buffer);
+        appendEscaped(sLine, event.pName);
+        std::snprintf(buffer, sizeof(buffer), "\":%lld}}\n", event.iValue);
+        sLine.append(buffer);
     }
+
+    outputFileStream << sLine;
+    bFirstEvent = false;
 }
 
 //=============================================================================================================
 
-void MNETracer::start(const std::string &jsonFileName)
+void TracerBackend::flush(bool bWrite)
 {
-    enable(jsonFileName);
+    std::vector<std::shared_ptr<ThreadBuffer> > currentBuffers;
+    {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        currentBuffers = buffers;
+    }
+
+    for(const std::shared_ptr<ThreadBuffer>& pBuffer : currentBuffers) {
+        size_t iTail = pBuffer->iTail.load(std::memory_order_relaxed);
+        size_t iHead = pBuffer->iHead.load(std::memory_order_acquire);
+
+        if(bWrite) {
+            for(size_t i = iTail; i < iHead; ++i) {
+                writeEvent(pBuffer->events[i & (ThreadBuffer::ms_iCapacity - 1)], pBuffer->iThreadId);
+            }
+        }
+        pBuffer->iTail.store(iHead, std::memory_order_release);
+    }
+
+    if(bWrite) {
+        outputFileStream.flush();
+    }
+
+    // Release the buffers of exited threads once they are drained
+    std::lock_guard<std::mutex> lock(registryMutex);
+    for(size_t i = 0; i < buffers.size();) {
+        ThreadBuffer* pBuffer = buffers[i].get();
+        if(pBuffer->bThreadFinished.load(std::memory_order_acquire)
+           && pBuffer->iTail.load(std::memory_order_relaxed) == pBuffer->iHead.load(std::memory_order_acquire)) {
+            iNumDroppedReleased.fetch_add(pBuffer->iNumDropped.load(std::memory_order_relaxed));
+            buffers[i] = buffers.back();
+            buffers.pop_back();
+        } else {
+            ++i;
+        }
+    }
 }
 
 //=============================================================================================================
 
-void MNETracer::start()
+void TracerBackend::finish()
 {
-    enable();
+    // Called with controlMutex held, so no other enable or disable can start or join the flusher meanwhile
+    if(!flusher.joinable()) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> flusherLock(flusherMutex);
+        bStopFlusher = true;
+    }
+    flusherCondition.notify_all();
+    flusher.join();
+
+    // Write what is left and report the drops as a counter, so they are visible in the trace
+    flush(true);
+    long long iNumDropped = numDropped();
+    if (iNumDropped > 0)
+    {
+        writeEvent(TraceEvent{"MNETracer dropped events", nullptr, 0, timeNow(), iNumDropped}, 0);
+    }
+
+    outputFileStream << "]}";
+    outputFileStream.flush();
+    outputFileStream.close();
 }
 
 //=============================================================================================================
 
-void MNETracer::stop()
+void TracerBackend::run()
 {
-    disable();
+    std::unique_lock<std::mutex> lock(flusherMutex);
+    while(!bStopFlusher) {
+        flusherCondition.wait_for(lock, std::chrono::milliseconds(iFlushIntervalMs.load()));
+        if(bStopFlusher) {
+            break;
+        }
+
+        lock.unlock();
+        flush(true);
+        lock.lock();
+    }
 }
 
+} // namespace
+
+//=============================================================================================================
+// DEFINE MEMBER METHODS
 //=============================================================================================================
 
-void MNETracer::traceQuantity(const std::string &name, long val)
+MNETracer::MNETracer(const char* file, const char* function, int lineNumber)
+: m_pFileName(file)
+, m_pFunctionName(function)
+, m_iLineNumber(lineNumber)
+, m_iBeginTime(0)
+, m_bIsRecorded(false)
+, m_bPrintToTerminal(false)
 {
-    long long timeNow = getTimeNow() - ms_iZeroTime;
-    std::string s;
-    s.append("{\"name\":\"").append(name).append("\",\"ph\":\"C\",\"ts\":");
-    s.append(std::to_string(timeNow)).append(",\"pid\":1,\"tid\":1");
-    s.append(",\"args\":{\"").append(name).append("\":").append(std::to_string(val)).append("}}\n");
-    writeToFile(s);
+    if (isEnabled())
+    {
+        int iSamplingInterval = backend().iSamplingInterval.load(std::memory_order_relaxed);
+        m_bIsRecorded = iSamplingInterval <= 1
+                        || threadBuffer()->iSampleCounter++ % static_cast<unsigned int>(iSamplingInterval) == 0;
+        if (m_bIsRecorded)
+        {
+            m_iBeginTime = getTimeNow();
+        }
+    }
 }
 
 //=============================================================================================================
 
-void MNETracer::initialize()
+MNETracer::~MNETracer()
 {
-    registerConstructionTime();
-    registerThreadId();
-    formatFileName();
-    m_bIsInitialized = true;
+    if (m_bIsRecorded && isEnabled())
+    {
+        long long iEndTime = getTimeNow();
+        threadBuffer()->push(TraceEvent{m_pFunctionName, m_pFileName, m_iLineNumber, m_iBeginTime, iEndTime - m_iBeginTime});
+        if (m_bPrintToTerminal)
+        {
+            printDurationMiliSec(iEndTime);
+        }
+    }
 }
 
 //=============================================================================================================
 
-void MNETracer::setZeroTime()
+void MNETracer::enable(const std::string &jsonFileName)
 {
-    ms_iZeroTime = getTimeNow();
+    TracerBackend& tracer = backend();
+
+    // Stop a running session under the same lock which starts the new one
+    std::lock_guard<std::mutex> lock(tracer.controlMutex);
+    ms_bIsEnabled.store(false);
+    tracer.finish();
+
+    tracer.outputFileStream.open(jsonFileName);
+    if (!tracer.outputFileStream.is_open())
+    {
+        return;
+    }
+
+    tracer.outputFileStream << "{\"displayTimeUnit\": \"ms\",\"traceEvents\":[\n";
+    tracer.bFirstEvent = true;
+    tracer.iZeroTime.store(0);
+    tracer.iZeroTime.store(getTimeNow());
+
+    // Discard events left over from an earlier session
+    tracer.flush(false);
+    {
+        std::lock_guard<std::mutex> registryLock(tracer.registryMutex);
+        for(const std::shared_ptr<ThreadBuffer>& pBuffer : tracer.buffers) {
+            pBuffer->iNumDropped.store(0);
+        }
+        tracer.iNumDroppedReleased.store(0);
+    }
+
+    tracer.bStopFlusher = false;
+    tracer.flusher = std::thread(&TracerBackend::run, &tracer);
+    ms_bIsEnabled.store(true);
 }
 
 //=============================================================================================================
 
-void MNETracer::registerConstructionTime()
+void MNETracer::enable()
 {
-    m_iBeginTime = getTimeNow() - ms_iZeroTime;
+    enable(defaultTracerFileName);
 }
 
 //=============================================================================================================
 
-void MNETracer::registerFinalTime()
+void MNETracer::disable()
 {
-    m_iEndTime = getTimeNow() - ms_iZeroTime;
+    TracerBackend& tracer = backend();
+
+    std::lock_guard<std::mutex> lock(tracer.controlMutex);
+    ms_bIsEnabled.store(false);
+    tracer.finish();
 }
 
 //=============================================================================================================
 
-long long MNETracer::getTimeNow()
+void MNETracer::start(const std::string &jsonFileName)
 {
-    auto timeNow = std::chrono::high_resolution_clock::now();
-    return std::chrono::time_point_cast<std::chrono::microseconds>(timeNow).time_since_epoch().count();
+    enable(jsonFileName);
 }
 
 //=============================================================================================================
 
-void MNETracer::registerThreadId()
+void MNETracer::start()
 {
-    auto longId = std::hash<std::thread::id>{}(std::this_thread::get_id());
-    m_iThreadId = std::to_string(longId).substr(0, 5);
+    enable();
 }
 
 //=============================================================================================================
 
-void MNETracer::formatFunctionName()
+void MNETracer::stop()
 {
-    const char* pattern(" __cdecl");
-    constexpr int patternLenght(8);
-    size_t pos = m_sFunctionName.find(pattern);
-    if (pos != std::string::npos) {
-        m_sFunctionName.replace(pos, patternLenght, "");
-    }
+    disable();
 }
 
 //=============================================================================================================
 
-void MNETracer::formatFileName()
+void MNETracer::traceQuantity(const std::string &name, long val)
 {
-    const char* patternIn("\\");
-    const char* patternOut("\\\\");
-    constexpr int patternOutLength(4);
-    size_t start_pos = 0;
-    while ((start_pos = m_sFileName.find(patternIn, start_pos)) != std::string::npos)
+    if (isEnabled())
     {
-        m_sFileName.replace(start_pos, 1, patternOut);
-        start_pos += patternOutLength;
+        traceQuantity(internName(name), val);
     }
 }
 
 //=============================================================================================================
 
-void MNETracer::calculateDuration()
+void MNETracer::traceQuantity(const char* name, long val)
 {
-    m_dDurationMilis = (m_iEndTime - m_iBeginTime) * 0.001;
+    if (isEnabled())
+    {
+        threadBuffer()->push(TraceEvent{name, nullptr, 0, getTimeNow(), val});
+    }
 }
 
 //=============================================================================================================
 
-void MNETracer::printDurationMiliSec()
+const char* MNETracer::internName(const std::string &name)
 {
-    std::cout << "Scope: " << m_sFileName << " - " << m_sFunctionName << " DurationMs: " << m_dDurationMilis << "ms.\n";
+    return backend().intern(name);
 }
 
 //=============================================================================================================
 
-void MNETracer::writeHeader()
+void MNETracer::setSamplingInterval(int iInterval)
 {
-    writeToFile("{\"displayTimeUnit\": \"ms\",\"traceEvents\":[\n");
+    backend().iSamplingInterval.store(iInterval > 1 ? iInterval : 1);
 }
 
 //=============================================================================================================
 
-void MNETracer::writeFooter()
+void MNETracer::setFlushInterval(int iMilliSeconds)
 {
-    writeToFile("]}");
+    backend().iFlushIntervalMs.store(iMilliSeconds > 1 ? iMilliSeconds : 1);
 }
 
 //=============================================================================================================
 
-void MNETracer::writeToFile(const std::string& str)
+long long MNETracer::numDroppedEvents()
 {
-    ms_outFileMutex.lock();
-    if(ms_OutputFileStream.is_open()) {
-        ms_OutputFileStream << str;
-    }
-    ms_outFileMutex.unlock();
+    return backend().numDropped();
 }
 
 //=============================================================================================================
 
-void MNETracer::writeBeginEvent()
+long long MNETracer::getTimeNow()
 {
-    std::string s;
-    if (!ms_bIsFirstEvent)
-        s.append(",");
-
-    s.append("{\"name\":\"").append(m_sFunctionName).append("\",\"cat\":\"bst\",");
-    s.append("\"ph\":\"B\",\"ts\":").append(std::to_string(m_iBeginTime)).append(",\"pid\":1,\"tid\":");
-    s.append(m_iThreadId).append(",\"args\":{\"file path\":\"").append(m_sFileName).append("\",\"line number\":");
-    s.append(std::to_string(m_iLineNumber)).append("}}\n");
-    writeToFile(s);
-    ms_bIsFirstEvent = false;
+    return backend().timeNow();
 }
 
 //=============================================================================================================
 
-void MNETracer::writeEndEvent()
+void MNETracer::printDurationMiliSec(long long iEndTime)
 {
-    std::string s;
-    s.append(",{\"name\":\"").append(m_sFunctionName).append("\",\"cat\":\"bst\",");
-    s.append("\"ph\":\"E\",\"ts\":").append(std::to_string(m_iEndTime)).append(",\"pid\":1,\"tid\":");
-    s.append(m_iThreadId).append(",\"args\":{\"file path\":\"").append(m_sFileName).append("\",\"line number\":");
-    s.append(std::to_string(m_iLineNumber)).append("}}\n");
-    writeToFile(s);
+    std::cout << "Scope: " << m_pFileName << " - " << m_pFunctionName << " DurationMs: " << (iEndTime - m_iBeginTime) * 1e-6 << "ms.\n";
 }
 
 //=============================================================================================================
@@ -306,4 +555,3 @@ void MNETracer::setPrintToTerminal(bool s)
 {
     m_bPrintToTerminal = s;
 }
-
@@ -39,16 +39,22 @@
 // MACRO DEFINITIONS
 //=============================================================================================================
 
+#define MNE_TRACE_CONCAT_IMPL(A, B) A##B
+#define MNE_TRACE_CONCAT(A, B) MNE_TRACE_CONCAT_IMPL(A, B)
+
 #ifdef TRACE
-#define MNE_TRACE() UTILSLIB::MNETracer _mneTracer__LINE__(__FILE__,__func__,__LINE__);
+#define MNE_TRACE() UTILSLIB::MNETracer MNE_TRACE_CONCAT(_mneTracer, __LINE__)(__FILE__,__func__,__LINE__);
+#define MNE_TRACE_SCOPE(NAME) UTILSLIB::MNETracer MNE_TRACE_CONCAT(_mneTracer, __LINE__)(__FILE__,NAME,__LINE__);
 #define MNE_TRACER_ENABLE(FILENAME) UTILSLIB::MNETracer::enable(#FILENAME);
 #define MNE_TRACER_DISABLE UTILSLIB::MNETracer::disable();
-#define MNE_TRACE_VALUE(NAME, VALUE) UTILSLIB::MNETracer::traceQuantity(NAME, VALUE);
+#define MNE_TRACE_VALUE(NAME, VALUE) { static const char* MNE_TRACE_CONCAT(_mneTraceName, __LINE__) = UTILSLIB::MNETracer::internName(NAME); \
+                                     UTILSLIB::MNETracer::traceQuantity(MNE_TRACE_CONCAT(_mneTraceName, __LINE__), VALUE); }
 #else
 #define MNE_TRACE()
+#define MNE_TRACE_SCOPE(NAME)
 #define MNE_TRACER_ENABLE(FILENAME)
 #define MNE_TRACER_DISABLE
-#define MNE_TRACE_VALUE()
+#define MNE_TRACE_VALUE(NAME, VALUE)
 #endif
 
 #ifdef MNE_TRACE_MEMORY
@@ -83,11 +89,8 @@ void operator delete(void *memory, size_t size)
 #include "utils_global.h"
 
 #include <iostream>
-#include <fstream>
 #include <string>
-#include <chrono>
-#include <thread>
-#include <mutex>
+#include <atomic>
 
 //=============================================================================================================
 // DEFINE NAMESPACE MNESCAN
@@ -101,44 +104,47 @@ namespace UTILSLIB
  * (includeing scope blocks of code between brackets) that formats the output so that it is compatible with
  * Chrome browser's Tracing application (json format).
  *
- * The class is defined so that it has a some settings (ie. output file, zero time, etc...) which correspond to static
- * variables shared and accessible from all the instances of this class MNETracer. Each instance, in its contructor will
- * record the creation time and write to file that begin-measurement event.
- * Whenever the MNETracer object is destructued (normally by falling out of scope), the destructor of this class MNETracer will
- * be called and it is in the desctructor where the end-measurement event is recorded and written to file. So the time-alive (time
- * between the constructor and the desctructor calls, for objects of this class, will be linked to a specific scope (i.e. function).
+ * Each instance records its creation time in the constructor and, in the destructor, stores one complete event
+ * (name, start and duration) in a buffer owned by the calling thread. The buffers are lock free single producer
+ * queues of fixed size, so tracing does not serialize the traced threads. A background thread started by enable
+ * drains the buffers every few milliseconds and does all the formatting and file output. If a buffer runs full
+ * before it is drained, the events are dropped and counted instead of blocking the traced thread.
  *
- * Since this class is oriented as a development tool, all the events are written to the output file stream directly, so there
- * should be not much difficulty recovering the results even if the application crashed.
+ * Besides scopes, the tracer records counters (traceQuantity) and can sample scopes, i.e. only record every n-th
+ * scope of a thread, to keep the overhead and the file size down for very hot code.
  *
- * There are some additional macros defined to make is handy for the user to use this class.
+ * There are some additional macros defined to make is handy for the user to use this class. All of them compile
+ * to nothing unless MNE-CPP is built with MNECPP_CONFIG+=trace.
  * MNE_TRACER_ENABLE(filename) and MNE_TRACER_DISABLE macros will set the static variables like the output file initialization and
  * a few other needed variables. This should be called before any MNETracer is created, and after the last MNETracer object is destructed.
  * For instance, in the main.cpp file.
  * The MNE_TRACE() macro is to be used for marking which method, function or block of code is to be measured and traced.
+ * The MNE_TRACE_SCOPE(name) macro does the same with a given name, e.g. for one iteration of a processing loop. The
+ * name must be a string literal.
+ * The MNE_TRACE_VALUE(name, value) macro records a counter. The name is interned once per call site, so it must not
+ * change between the calls of one site.
  */
 class UTILSSHARED_EXPORT MNETracer
 {
 public:
     /**
      * @brief MNETracer constructor will check if the class "is enabled". If it is, it will record the creation time with respect to the
-     * ZeroTime set during the last enable function call. It will also write that time to the output file and if needed, it will also print
-     * it to terminal.
-     * @param function Function name where the MNETracer object is created.
-     * @param file File name where the MNETracer object is created.
-     * @param num Line number where the MNETracer object is created.
+     * ZeroTime set during the last enable function call.
+     * @param file File name where the MNETracer object is created. Must outlive the tracing, e.g. __FILE__.
+     * @param function Function or scope name. Must outlive the tracing, e.g. __func__ or a string literal.
+     * @param lineNumber Line number where the MNETracer object is created.
      */
-    MNETracer(const std::string& file, const std::string& function, int lineNumber);
+    MNETracer(const char* file, const char* function, int lineNumber);
 
     /**
-     * MNETracer destructor will check if the class "is enabled". If it is, it will record the destruction time with respect to the
-     * ZeroTime set during the last enable function call. It will also write that time to the output file and, if needed, it will also print
-     * it to terminal.
+     * MNETracer destructor will check if the class "is enabled". If it is, it stores the complete event in the buffer of the
+     * calling thread and, if needed, it will also print the duration to terminal.
      */
     ~MNETracer();
 
     /**
-     * The enable function initializes an output file (output file stream ie std::ofstream) to write the events.
+     * The enable function initializes an output file (output file stream ie std::ofstream) to write the events and starts
+     * the background thread which writes them.
      * @param jsonFileName is the name of the output file to configure as the outuput file (it is in json format).
      */
     static void enable(const std::string& jsonFileName);
@@ -149,8 +155,8 @@ public:
     static void enable();
 
     /**
-     * @brief disable If the class "is enabled" (it's static variabable ms_bIsEnabled is true), the output file has a Footer written to it and the
-     * output file stream is closed. Finally, the static member variable ms_bIsEnabled is set to false.
+     * @brief disable If the class "is enabled", the background thread is stopped, the remaining events and a Footer are written
+     * to the output file and the output file stream is closed.
      */
     static void disable();
 
@@ -171,124 +177,97 @@ public:
     static void stop();
 
     /**
-     * @brief traceQuantity Allows to keep track of a specific variable in the output tracing file.
-     * @param name Name of the variable to keep track of.
-     * @param val Value of the variable to keep track of.
-     */
-    static void traceQuantity(const std::string& name, long val);
-
-    /**
-     * Getter function for the member variable that defines whether the output should be printed to terminal, or only to a file.
+     * @brief isEnabled Returns whether events are currently recorded.
      * @return bool value.
      */
-    bool printToTerminalIsSet();
+    static inline bool isEnabled();
 
     /**
-     * Setter function for the member variable that defines whether the output should be printed to terminal, or only to a file.
-     * @param s bool value to set the output to terminal control member variable.
-     */
-    void setPrintToTerminal(bool s);
-
-private:
-    /**
-     * @brief writeHeader The outputfile needs a specific header to be compatible with Chrome Tracer app. This ads this header to
-     * the output file.
-     */
-    static void writeHeader();
-
-    /**
-     * @brief writeFooter The outputfile needs a specific footer to be compatible with Chrome Tracer app. and close the arrays defined in
-     * the json file.  This ads this footer (closing brackets) to the output file.
-     */
-    static void writeFooter();
-
-    /**
-     * @brief writeToFile This function writes a string to the output file.
-     * @param str String to write.
-     */
-    static void writeToFile(const std::string& str);
-
-    /**
-     * @brief setZeroTime Sets the zero time, which is the time that will be considered zero in the tracer result. Typically, this is called
-     * by the enable function.
+     * @brief traceQuantity Allows to keep track of a specific variable in the output tracing file. The name is interned on
+     * every call, which takes a lock. Hot code should intern the name once with internName, as MNE_TRACE_VALUE does.
+     * @param name Name of the variable to keep track of.
+     * @param val Value of the variable to keep track of.
      */
-    static void setZeroTime();
+    static void traceQuantity(const std::string& name, long val);
 
     /**
-     * @brief getTimeNow Wrapper function over chronos std library functionality to get the tick of this instant (in microseconds).
-     * @return The actual time now in microseconds.
+     * @brief traceQuantity Overload for names which outlive the tracing, i.e. string literals or names returned by internName.
+     * Does not lock.
+     * @param name Name of the variable to keep track of.
+     * @param val Value of the variable to keep track of.
      */
-    static long long getTimeNow();
+    static void traceQuantity(const char* name, long val);
 
     /**
-     * @brief initialize Formats the fileName, FunctionName and line of code text shown in each event saved to the output file.
-     * It then registers the threadId and the construction time for each instance of the class.
+     * @brief internName Stores a copy of a counter name for the lifetime of the program.
+     * @param name The counter name.
+     * @return The stored copy, to be passed to traceQuantity.
      */
-    void initialize();
+    static const char* internName(const std::string& name);
 
     /**
-     * Removes extra back-slashes from the filename string.
+     * @brief setSamplingInterval Only every n-th scope of each thread is recorded. Counters are always recorded.
+     * @param iInterval The sampling interval, 1 records every scope.
      */
-    void formatFileName();
+    static void setSamplingInterval(int iInterval);
 
     /**
-     * removes  "__cdecl" from the function name.
+     * @brief setFlushInterval Sets how often the background thread writes the buffered events to the output file.
+     * @param iMilliSeconds The flush interval in ms.
      */
-    void formatFunctionName();
+    static void setFlushInterval(int iMilliSeconds);
 
     /**
-     * Saves the construction time of this object. To later compute the time between construction and destruction of each object.
+     * @brief numDroppedEvents Returns the number of events which were dropped since the last enable call, because the buffer
+     * of their thread was full.
+     * @return The number of dropped events.
      */
-    void registerConstructionTime();
+    static long long numDroppedEvents();
 
     /**
-     * Saves the destruction time of this object. See registerConstructionTime.
+     * Getter function for the member variable that defines whether the output should be printed to terminal, or only to a file.
+     * @return bool value.
      */
-    void registerFinalTime();
+    bool printToTerminalIsSet();
 
     /**
-     * Stores a string, definiing a specific thread based on a hashing function. The same thread will always have the same stringId.
+     * Setter function for the member variable that defines whether the output should be printed to terminal, or only to a file.
+     * @param s bool value to set the output to terminal control member variable.
      */
-    void registerThreadId();
+    void setPrintToTerminal(bool s);
 
     /**
-     * Calculate duration between construction and destruction of an object.
+     * @brief getTimeNow Wrapper function over chronos std library functionality to get the tick of this instant with respect
+     * to the ZeroTime.
+     * @return The time now in nanoseconds.
      */
-    void calculateDuration();
+    static long long getTimeNow();
 
+private:
     /**
      * Print duration in miliseconds.
      */
-    void printDurationMiliSec();
+    void printDurationMiliSec(long long iEndTime);
 
-    /**
-     * Write an event of type B (begin) in the output file.
-     */
-    void writeBeginEvent();
+    static std::atomic<bool> ms_bIsEnabled;     /**< Bool variable to store if the "class" (ie. the MNETracer) has been enabled. */
 
-    /**
-     * Write an event of type E (end) in the ouptut file.
-     */
-    void writeEndEvent();
-
-    static bool ms_bIsEnabled;                  /**< Bool variable to store if the "class" (ie. the MNETracer) has been enabled. */
-    static std::ofstream ms_OutputFileStream;   /**< Output file stream to write results. */
-    static bool ms_bIsFirstEvent;               /**< Bool variable to check if this is the first event to be written to the file. */
-    static std::mutex ms_outFileMutex;          /**< Mutex to guard the writing to file between threads. */
-    static long long ms_iZeroTime;              /**< Integer value to store the origin-time (ie the Zero time) from which all other time measurements will depend. */
-
-    bool m_bIsInitialized;          /**< Store if this object has been initialized properly. */
-    bool m_bPrintToTerminal;        /**< Store if it is needed from this MNETracer object. to print to terminal too. */
-    std::string m_sFileName;        /**< String to store the code file name where the MNETracer obj is instantiated. */
-    std::string m_sFunctionName;    /**< String to store the function name. */
+    const char* m_pFileName;        /**< The code file name where the MNETracer obj is instantiated. */
+    const char* m_pFunctionName;    /**< The function or scope name. */
     int m_iLineNumber;              /**< The line number within the code file where the MNETracer obj is instantiated. */
-    std::string m_iThreadId;        /**< A string identifier for the thread id in which the MNETracer obj is instantiated. */
     long long m_iBeginTime;         /**< The time when the tracer MNETracer obj is created. */
-    long long m_iEndTime;           /**< The time when the tracer MNETracer obj is destructed. */
-    double m_dDurationMilis;        /**< The time difference between MNETracer object creation and destruction in in milli seconds. */
+    bool m_bIsRecorded;             /**< Store if this object records an event, i.e. the tracer was enabled and the scope was sampled. */
+    bool m_bPrintToTerminal;        /**< Store if it is needed from this MNETracer object. to print to terminal too. */
 }; // MNETracer
 
+//=============================================================================================================
+// INLINE DEFINITIONS
+//=============================================================================================================
+
+inline bool MNETracer::isEnabled()
+{
+    return ms_bIsEnabled.load(std::memory_order_relaxed);
+}
+
 } // namespace UTILSLIB
 
 #endif //if TRACE defined
-
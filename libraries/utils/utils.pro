@@ -64,6 +64,7 @@ contains(MNECPP_CONFIG, static) {
 
 SOURCES += \
     kmeans.cpp \
+    meshadjacency.cpp \
     mnemath.cpp \
     ioutils.cpp \
     layoutloader.cpp \
@@ -79,6 +80,7 @@ SOURCES += \
 
 HEADERS += \
     kmeans.h\
+    meshadjacency.h \
     utils_global.h \
     mnemath.h \
     ioutils.h \
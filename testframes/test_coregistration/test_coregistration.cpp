@@ -58,6 +58,7 @@
 #include <QDebug>
 #include <QFile>
 #include <QTest>
+#include <QElapsedTimer>
 
 //=============================================================================================================
 // Eigen
@@ -93,6 +94,7 @@ private slots:
     void initTestCase();
     void compareFitMatchedPoints();
     void comparePerformIcp();
+    void benchmarkIcpPointToPlane();
     void cleanupTestCase();
 
 private:
@@ -102,6 +104,11 @@ private:
     FiffCoordTrans transPerformICP;
     FiffCoordTrans transFitMatchedRef;
     FiffCoordTrans transPerformICPRef;
+    MNEProjectToSurface::SPtr mneSurfacePoints;
+    MatrixXf matHsp;
+    VectorXf vecWeightsICP;
+    float fTol;
+    float fMaxDist;
 };
 
 //=============================================================================================================
@@ -121,8 +128,8 @@ void TestCoregistration::initTestCase()
     QFile t_fileTransRefFit(QCoreApplication::applicationDirPath() + "/mne-cpp-test-data/MEG/sample/all-trans.fif");
     QFile t_fileTransRefIcp(QCoreApplication::applicationDirPath() + "/mne-cpp-test-data/Result/icp-trans.fif");
 
-    float fTol = 0.01/1000;
-    float fMaxDist = 0.02;
+    fTol = 0.01/1000;
+    fMaxDist = 0.02;
 
     // read reference Transformation
     transFitMatchedRef = FiffCoordTrans(t_fileTransRefFit);
@@ -133,7 +140,7 @@ void TestCoregistration::initTestCase()
     // read Bem
     MNEBem bemHead(t_fileBem);
     MNEBemSurface::SPtr bemSurface = MNEBemSurface::SPtr::create(bemHead[0]);
-    MNEProjectToSurface::SPtr mneSurfacePoints = MNEProjectToSurface::SPtr::create(*bemSurface);
+    mneSurfacePoints = MNEProjectToSurface::SPtr::create(*bemSurface);
 
     // read digitizer data
     QList<int> lPickFiducials({FIFFV_POINT_CARDINAL});
@@ -176,9 +183,9 @@ void TestCoregistration::initTestCase()
     transPerformICP = *new FiffCoordTrans(transFitMatched);
 
     // Prepare Icp:
-    VectorXf vecWeightsICP(digSetHsp.size()); // Weigths vector
+    vecWeightsICP.resize(digSetHsp.size()); // Weigths vector
     int iMaxIter = 20;
-    MatrixXf matHsp(digSetHsp.size(),3);
+    matHsp.resize(digSetHsp.size(),3);
 
     for(int i = 0; i < digSetHsp.size(); ++i) {
         matHsp(i,0) = digSetHsp[i].r[0]; matHsp(i,1) = digSetHsp[i].r[1]; matHsp(i,2) = digSetHsp[i].r[2];
@@ -226,6 +233,44 @@ void TestCoregistration::comparePerformIcp()
 
 //=============================================================================================================
 
+void TestCoregistration::benchmarkIcpPointToPlane()
+{
+    int iMaxIter = 50;
+    QElapsedTimer timer;
+
+    // Point-to-point: discard outliers first, then register without scaling
+    timer.start();
+    FiffCoordTrans transPointToPoint = transFitMatched;
+    MatrixXf matHspClean;
+    VectorXi vecTake;
+    QVERIFY(RTPROCESSINGLIB::discard3DPointOutliers(mneSurfacePoints, matHsp, transPointToPoint, vecTake, matHspClean, fMaxDist));
+    VectorXf vecWeightsICPClean(vecTake.size());
+    for(int i = 0; i < vecTake.size(); ++i) {
+        vecWeightsICPClean(i) = vecWeightsICP(vecTake(i));
+    }
+    float fRMSEPointToPoint = 0.0;
+    QVERIFY(RTPROCESSINGLIB::performIcp(mneSurfacePoints, matHspClean, transPointToPoint, fRMSEPointToPoint, false, iMaxIter, fTol, vecWeightsICPClean));
+    qint64 iTimePointToPoint = timer.elapsed();
+
+    // Point-to-plane: outliers are trimmed during the iterations
+    timer.restart();
+    FiffCoordTrans transPointToPlane = transFitMatched;
+    float fRMSEPointToPlane = 0.0;
+    float fInlierRatio = static_cast<float>(vecTake.size()) / matHsp.rows();
+    QVERIFY(RTPROCESSINGLIB::performIcpPointToPlane(mneSurfacePoints, matHsp, transPointToPlane, fRMSEPointToPlane, iMaxIter, fTol, fInlierRatio, vecWeightsICP));
+    qint64 iTimePointToPlane = timer.elapsed();
+
+    qInfo() << "[TestCoregistration::benchmarkIcpPointToPlane] Point-to-point:" << iTimePointToPoint << "ms, RMSE" << fRMSEPointToPoint * 1000 << "mm.";
+    qInfo() << "[TestCoregistration::benchmarkIcpPointToPlane] Point-to-plane:" << iTimePointToPlane << "ms, RMSE" << fRMSEPointToPlane * 1000 << "mm.";
+
+    // Both fits end up at about the same head position
+    QVERIFY(transPointToPlane.translationTo(transPointToPoint.trans) < 0.002f);
+    QVERIFY(transPointToPlane.angleTo(transPointToPoint.trans) < 2.0f);
+    QVERIFY(fRMSEPointToPlane <= fRMSEPointToPoint + 0.0005f);
+}
+
+//=============================================================================================================
+
 void TestCoregistration::cleanupTestCase()
 {
 }
@@ -0,0 +1,324 @@
+//=============================================================================================================
+/**
+ * @file     test_fiff_ch_name_index.cpp
+ * @author   agent <agent@local>
+ * @since    0.1.9
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, agent. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    Test for the hashed channel name index of FiffInfoBase, FiffCov and FiffNamedMatrix.
+ *
+ */
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include <utils/generics/applicationlogger.h>
+
+#include <fiff/fiff_info.h>
+#include <fiff/fiff_cov.h>
+#include <fiff/fiff_named_matrix.h>
+#include <fiff/fiff_ch_name_index.h>
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QtTest>
+#include <QElapsedTimer>
+
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace FIFFLIB;
+using namespace Eigen;
+
+//=============================================================================================================
+/**
+ * DECLARE CLASS TestFiffChNameIndex
+ *
+ * @brief The TestFiffChNameIndex class checks that the hashed channel name lookups give the same selections as
+ * the plain list scans.
+ *
+ */
+class TestFiffChNameIndex: public QObject
+{
+    Q_OBJECT
+
+public:
+    TestFiffChNameIndex();
+
+private slots:
+    void initTestCase();
+    void pickChannels();
+    void pickTypes();
+    void channelIndex();
+    void badMask();
+    void covAndNamedMatrix();
+    void benchmarkPickChannels();
+    void cleanupTestCase();
+
+private:
+    static RowVectorXi pickChannelsLinear(const QStringList& ch_names,
+                                          const QStringList& include,
+                                          const QStringList& exclude);
+
+    int m_iNChan;
+    FiffInfo m_info;
+};
+
+//=============================================================================================================
+
+TestFiffChNameIndex::TestFiffChNameIndex()
+: m_iNChan(2000)
+{
+}
+
+//=============================================================================================================
+
+void TestFiffChNameIndex::initTestCase()
+{
+    qInstallMessageHandler(UTILSLIB::ApplicationLogger::customLogWriter);
+
+    // Synthetic info: grad, grad, mag, eeg, with a stim channel every 100 channels and every 13th channel bad
+    for(int k = 0; k < m_iNChan; ++k) {
+        FiffChInfo ch;
+        ch.ch_name = QString("CH%1").arg(k, 4, 10, QChar('0'));
+
+        if(k % 100 == 99) {
+            ch.kind = FIFFV_STIM_CH;
+        } else if(k % 4 == 3) {
+            ch.kind = FIFFV_EEG_CH;
+            ch.unit = FIFF_UNIT_V;
+        } else {
+            ch.kind = FIFFV_MEG_CH;
+            ch.unit = (k % 4 == 2) ? FIFF_UNIT_T : FIFF_UNIT_T_M;
+        }
+
+        m_info.chs.append(ch);
+        m_info.ch_names.append(ch.ch_name);
+
+        if(k % 13 == 0) {
+            m_info.bads.append(ch.ch_name);
+        }
+    }
+    m_info.nchan = m_iNChan;
+}
+
+//=============================================================================================================
+
+void TestFiffChNameIndex::pickChannels()
+{
+    QStringList lInclude, lExclude;
+    for(int k = 0; k < m_iNChan; k += 7) {
+        lInclude << m_info.ch_names[k];
+    }
+    lInclude << "NOT_A_CHANNEL";
+    for(int k = 0; k < m_iNChan; k += 21) {
+        lExclude << m_info.ch_names[k];
+    }
+
+    // Duplicate names are picked once only
+    QStringList lNamesDuplicates = m_info.ch_names;
+    lNamesDuplicates << m_info.ch_names.mid(10, 50);
+
+    QVERIFY(FiffInfoBase::pick_channels(m_info.ch_names) == pickChannelsLinear(m_info.ch_names, QStringList(), QStringList()));
+    QVERIFY(FiffInfoBase::pick_channels(m_info.ch_names, lInclude) == pickChannelsLinear(m_info.ch_names, lInclude, QStringList()));
+    QVERIFY(FiffInfoBase::pick_channels(m_info.ch_names, QStringList(), m_info.bads) == pickChannelsLinear(m_info.ch_names, QStringList(), m_info.bads));
+    QVERIFY(FiffInfoBase::pick_channels(m_info.ch_names, lInclude, lExclude) == pickChannelsLinear(m_info.ch_names, lInclude, lExclude));
+    QVERIFY(FiffInfoBase::pick_channels(lNamesDuplicates, QStringList(), lExclude) == pickChannelsLinear(lNamesDuplicates, QStringList(), lExclude));
+}
+
+//=============================================================================================================
+
+void TestFiffChNameIndex::pickTypes()
+{
+    RowVectorXi selMag = m_info.pick_types(QString("mag"), false, false, QStringList(), m_info.bads);
+    RowVectorXi selEeg = m_info.pick_types(false, true, false, QStringList(), m_info.bads);
+
+    QStringList lMag, lEeg;
+    for(int k = 0; k < m_iNChan; ++k) {
+        if(m_info.chs[k].kind == FIFFV_MEG_CH && m_info.chs[k].unit == FIFF_UNIT_T) {
+            lMag << m_info.ch_names[k];
+        } else if(m_info.chs[k].kind == FIFFV_EEG_CH) {
+            lEeg << m_info.ch_names[k];
+        }
+    }
+
+    QVERIFY(selMag == pickChannelsLinear(m_info.ch_names, lMag, m_info.bads));
+    QVERIFY(selEeg == pickChannelsLinear(m_info.ch_names, lEeg, m_info.bads));
+}
+
+//=============================================================================================================
+
+void TestFiffChNameIndex::channelIndex()
+{
+    FiffInfo info(m_info);
+
+    for(int k = 0; k < m_iNChan; ++k) {
+        QCOMPARE(info.ch_index(info.ch_names[k]), k);
+    }
+    QCOMPARE(info.ch_index("NOT_A_CHANNEL"), -1);
+
+    // The index follows changes of the name list
+    info.ch_names[5] = "RENAMED";
+    QCOMPARE(info.ch_index("RENAMED"), 5);
+    QCOMPARE(info.ch_index(m_info.ch_names[5]), -1);
+    info.ch_names.append(m_info.ch_names[3]);
+    QCOMPARE(info.ch_index(m_info.ch_names[3]), 3);
+
+    // The original is untouched
+    QCOMPARE(m_info.ch_index(m_info.ch_names[5]), 5);
+    QCOMPARE(m_info.ch_index("RENAMED"), -1);
+}
+
+//=============================================================================================================
+
+void TestFiffChNameIndex::badMask()
+{
+    FiffInfo info(m_info);
+
+    QBitArray mask = info.bad_mask();
+    QCOMPARE(mask.size(), m_iNChan);
+    for(int k = 0; k < m_iNChan; ++k) {
+        QCOMPARE(mask.testBit(k), info.bads.contains(info.ch_names[k]));
+    }
+
+    info.bads.append(info.ch_names[1]);
+    QVERIFY(info.bad_mask().testBit(1));
+    QVERIFY(!m_info.bad_mask().testBit(1));
+
+    info.bads.clear();
+    QCOMPARE(info.bad_mask().count(true), 0);
+}
+
+//=============================================================================================================
+
+void TestFiffChNameIndex::covAndNamedMatrix()
+{
+    FiffCov cov;
+    cov.names = m_info.ch_names.mid(0, 100);
+    cov.bads = m_info.bads;
+    cov.dim = cov.names.size();
+    cov.data = MatrixXd::Identity(cov.dim, cov.dim);
+
+    QCOMPARE(cov.ch_index(cov.names[42]), 42);
+    QCOMPARE(cov.ch_index(m_info.ch_names[500]), -1);
+    QBitArray mask = cov.bad_mask();
+    for(int k = 0; k < cov.dim; ++k) {
+        QCOMPARE(mask.testBit(k), k % 13 == 0);
+    }
+
+    // Only the bads of the picked channels are kept
+    FiffCov covPicked = cov.pick_channels(cov.names.mid(20, 10));
+    QCOMPARE(covPicked.bads, QStringList() << m_info.ch_names[26]);
+
+    FiffNamedMatrix mat(2, 3, QStringList() << "a" << "b", QStringList() << "x" << "y" << "z", MatrixXd::Zero(2, 3));
+    QCOMPARE(mat.row_index("b"), 1);
+    QCOMPARE(mat.col_index("z"), 2);
+    mat.transpose_named_matrix();
+    QCOMPARE(mat.row_index("z"), 2);
+    QCOMPARE(mat.col_index("b"), 1);
+    QCOMPARE(mat.col_index("z"), -1);
+}
+
+//=============================================================================================================
+
+void TestFiffChNameIndex::benchmarkPickChannels()
+{
+    QElapsedTimer timer;
+
+    timer.start();
+    RowVectorXi selLinear = pickChannelsLinear(m_info.ch_names, QStringList(), m_info.bads);
+    qint64 iTimeLinear = timer.nsecsElapsed();
+
+    timer.start();
+    RowVectorXi selHashed = FiffInfoBase::pick_channels(m_info.ch_names, QStringList(), m_info.bads);
+    qint64 iTimeHashed = timer.nsecsElapsed();
+
+    QVERIFY(selHashed == selLinear);
+
+    qInfo() << "[TestFiffChNameIndex::benchmarkPickChannels]" << m_iNChan << "channels - pick_channels linear" << iTimeLinear / 1000000.0
+            << "ms, hashed" << iTimeHashed / 1000000.0 << "ms";
+
+    FiffInfo info(m_info);
+    QVector<int> vecLinear(m_iNChan), vecHashed(m_iNChan);
+
+    timer.start();
+    for(int k = 0; k < m_iNChan; ++k) {
+        vecLinear[k] = info.ch_names.indexOf(m_info.ch_names[m_iNChan - 1 - k]);
+    }
+    iTimeLinear = timer.nsecsElapsed();
+
+    timer.start();
+    for(int k = 0; k < m_iNChan; ++k) {
+        vecHashed[k] = info.ch_index(m_info.ch_names[m_iNChan - 1 - k]);
+    }
+    iTimeHashed = timer.nsecsElapsed();
+
+    QCOMPARE(vecHashed, vecLinear);
+
+    qInfo() << "[TestFiffChNameIndex::benchmarkPickChannels]" << m_iNChan << "channel lookups - indexOf" << iTimeLinear / 1000000.0
+            << "ms, ch_index (including index build)" << iTimeHashed / 1000000.0 << "ms";
+}
+
+//=============================================================================================================
+
+void TestFiffChNameIndex::cleanupTestCase()
+{
+}
+
+//=============================================================================================================
+
+RowVectorXi TestFiffChNameIndex::pickChannelsLinear(const QStringList& ch_names,
+                                                    const QStringList& include,
+                                                    const QStringList& exclude)
+{
+    // The list scan FiffInfoBase::pick_channels used before the hashed index
+    RowVectorXi sel = RowVectorXi::Zero(ch_names.size());
+    QStringList t_includedSelection;
+
+    qint32 count = 0;
+    for(qint32 k = 0; k < ch_names.size(); ++k) {
+        if((include.size() == 0 || include.contains(ch_names[k])) && !exclude.contains(ch_names[k])) {
+            if(!t_includedSelection.contains(ch_names[k])) {
+                sel[count] = k;
+                ++count;
+                t_includedSelection << ch_names[k];
+            }
+        }
+    }
+    sel.conservativeResize(count);
+    return sel;
+}
+
+//=============================================================================================================
+// MAIN
+//=============================================================================================================
+
+QTEST_GUILESS_MAIN(TestFiffChNameIndex)
+#include "test_fiff_ch_name_index.moc"
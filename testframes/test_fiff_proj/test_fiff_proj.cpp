@@ -0,0 +1,344 @@
+//=============================================================================================================
+/**
+ * @file     test_fiff_proj.cpp
+ * @author   agent <agent@local>
+ * @since    0.1.9
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, agent. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    Test for the SSP operators built by FiffProj::make_projector and their cache.
+ *
+ */
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include <utils/generics/applicationlogger.h>
+#include <utils/mnemath.h>
+
+#include <fiff/fiff_proj.h>
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QtTest>
+#include <QElapsedTimer>
+
+//=============================================================================================================
+// EIGEN INCLUDES
+//=============================================================================================================
+
+#include <Eigen/SVD>
+
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace FIFFLIB;
+using namespace UTILSLIB;
+using namespace Eigen;
+
+//=============================================================================================================
+/**
+ * DECLARE CLASS TestFiffProj
+ *
+ * @brief The TestFiffProj class checks the SSP operators of FiffProj::make_projector and their caching.
+ *
+ */
+class TestFiffProj: public QObject
+{
+    Q_OBJECT
+
+public:
+    TestFiffProj();
+
+private slots:
+    void initTestCase();
+    void compareReference();
+    void cacheHit();
+    void cacheInvalidation();
+    void benchmarkCache();
+    void cleanupTestCase();
+
+private:
+    static fiff_int_t makeProjectorReference(const QList<FiffProj>& projs,
+                                             const QStringList& ch_names,
+                                             MatrixXd& proj,
+                                             const QStringList& bads,
+                                             MatrixXd& U);
+
+    double dEpsilon;
+    int m_iNChan;
+    QStringList m_lChNames;
+    QStringList m_lBads;
+    QList<FiffProj> m_lProjs;
+};
+
+//=============================================================================================================
+
+TestFiffProj::TestFiffProj()
+: dEpsilon(1e-12)
+, m_iNChan(306)
+{
+}
+
+//=============================================================================================================
+
+void TestFiffProj::initTestCase()
+{
+    qInstallMessageHandler(UTILSLIB::ApplicationLogger::customLogWriter);
+
+    for(int k = 0; k < m_iNChan; ++k) {
+        m_lChNames << QString("MEG%1").arg(k, 4, 10, QChar('0'));
+    }
+    m_lBads << m_lChNames[3] << m_lChNames[100] << m_lChNames[250];
+
+    // Three active projectors on reordered channel subsets and one inactive one
+    std::srand(42);
+    for(int p = 0; p < 4; ++p) {
+        QStringList lCols;
+        for(int k = m_iNChan - 1 - p; k >= 0; k -= (p + 1)) {
+            lCols << m_lChNames[k];
+        }
+        int iNRow = p + 1;
+        FiffNamedMatrix matData(iNRow, lCols.size(), QStringList(), lCols, MatrixXd::Random(iNRow, lCols.size()));
+        m_lProjs.append(FiffProj(FIFFV_PROJ_ITEM_FIELD, p < 3, QString("Projector %1").arg(p), matData));
+    }
+}
+
+//=============================================================================================================
+
+void TestFiffProj::compareReference()
+{
+    FiffProj::clear_projector_cache();
+
+    MatrixXd proj, U, projRef, URef;
+    fiff_int_t nproj = FiffProj::make_projector(m_lProjs, m_lChNames, proj, m_lBads, U);
+    fiff_int_t nprojRef = makeProjectorReference(m_lProjs, m_lChNames, projRef, m_lBads, URef);
+
+    QCOMPARE(nproj, nprojRef);
+    QVERIFY(nproj > 0);
+    QVERIFY((proj - projRef).cwiseAbs().maxCoeff() < dEpsilon);
+    QVERIFY((U * U.transpose() - URef * URef.transpose()).cwiseAbs().maxCoeff() < dEpsilon);
+
+    // Without bads
+    nproj = FiffProj::make_projector(m_lProjs, m_lChNames, proj, QStringList(), U);
+    nprojRef = makeProjectorReference(m_lProjs, m_lChNames, projRef, QStringList(), URef);
+
+    QCOMPARE(nproj, nprojRef);
+    QVERIFY((proj - projRef).cwiseAbs().maxCoeff() < dEpsilon);
+}
+
+//=============================================================================================================
+
+void TestFiffProj::cacheHit()
+{
+    FiffProj::clear_projector_cache();
+    QCOMPARE(FiffProj::projector_cache_size(), 0);
+
+    MatrixXd proj, U, projHit, UHit;
+    fiff_int_t nproj = FiffProj::make_projector(m_lProjs, m_lChNames, proj, m_lBads, U);
+    QCOMPARE(FiffProj::projector_cache_size(), 1);
+
+    // Equal content in separate containers hits the same entry
+    QList<FiffProj> lProjsCopy;
+    for(int k = 0; k < m_lProjs.size(); ++k) {
+        FiffNamedMatrix matData(*m_lProjs[k].data);
+        lProjsCopy.append(FiffProj(m_lProjs[k].kind, m_lProjs[k].active, m_lProjs[k].desc, matData));
+    }
+    QStringList lChNamesCopy, lBadsCopy;
+    for(int k = 0; k < m_lChNames.size(); ++k) {
+        lChNamesCopy << QString(m_lChNames[k]);
+    }
+    lBadsCopy << m_lBads;
+
+    fiff_int_t nprojHit = FiffProj::make_projector(lProjsCopy, lChNamesCopy, projHit, lBadsCopy, UHit);
+    QCOMPARE(FiffProj::projector_cache_size(), 1);
+    QCOMPARE(nprojHit, nproj);
+    QVERIFY(projHit == proj);
+    QVERIFY(UHit == U);
+
+    // Descriptions and inactive items do not matter
+    lProjsCopy[0].desc = "Renamed";
+    lProjsCopy[3].data->data(0, 0) += 1.0;
+    FiffProj::make_projector(lProjsCopy, lChNamesCopy, projHit, lBadsCopy, UHit);
+    QCOMPARE(FiffProj::projector_cache_size(), 1);
+    QVERIFY(projHit == proj);
+}
+
+//=============================================================================================================
+
+void TestFiffProj::cacheInvalidation()
+{
+    FiffProj::clear_projector_cache();
+
+    MatrixXd proj, U, projRef, URef;
+    FiffProj::make_projector(m_lProjs, m_lChNames, proj, m_lBads, U);
+    QCOMPARE(FiffProj::projector_cache_size(), 1);
+
+    // Different bads
+    QStringList lBads = m_lBads;
+    lBads << m_lChNames[7];
+    fiff_int_t nproj = FiffProj::make_projector(m_lProjs, m_lChNames, proj, lBads, U);
+    fiff_int_t nprojRef = makeProjectorReference(m_lProjs, m_lChNames, projRef, lBads, URef);
+    QCOMPARE(FiffProj::projector_cache_size(), 2);
+    QCOMPARE(nproj, nprojRef);
+    QVERIFY((proj - projRef).cwiseAbs().maxCoeff() < dEpsilon);
+
+    // Different channel order
+    QStringList lChNames = m_lChNames;
+    lChNames.move(0, 1);
+    nproj = FiffProj::make_projector(m_lProjs, lChNames, proj, m_lBads, U);
+    nprojRef = makeProjectorReference(m_lProjs, lChNames, projRef, m_lBads, URef);
+    QCOMPARE(FiffProj::projector_cache_size(), 3);
+    QCOMPARE(nproj, nprojRef);
+    QVERIFY((proj - projRef).cwiseAbs().maxCoeff() < dEpsilon);
+
+    // Projector data changed in place
+    QList<FiffProj> lProjs = m_lProjs;
+    lProjs[1].data->data(0, 5) += 0.5;
+    nproj = FiffProj::make_projector(lProjs, m_lChNames, proj, m_lBads, U);
+    nprojRef = makeProjectorReference(lProjs, m_lChNames, projRef, m_lBads, URef);
+    QCOMPARE(FiffProj::projector_cache_size(), 4);
+    QCOMPARE(nproj, nprojRef);
+    QVERIFY((proj - projRef).cwiseAbs().maxCoeff() < dEpsilon);
+
+    // Activating a projector
+    lProjs = m_lProjs;
+    lProjs[3].active = true;
+    nproj = FiffProj::make_projector(lProjs, m_lChNames, proj, m_lBads, U);
+    nprojRef = makeProjectorReference(lProjs, m_lChNames, projRef, m_lBads, URef);
+    QCOMPARE(FiffProj::projector_cache_size(), 5);
+    QCOMPARE(nproj, nprojRef);
+    QVERIFY((proj - projRef).cwiseAbs().maxCoeff() < dEpsilon);
+
+    FiffProj::clear_projector_cache();
+    QCOMPARE(FiffProj::projector_cache_size(), 0);
+}
+
+//=============================================================================================================
+
+void TestFiffProj::benchmarkCache()
+{
+    FiffProj::clear_projector_cache();
+
+    MatrixXd proj, U, projRef, URef;
+    QElapsedTimer timer;
+
+    timer.start();
+    makeProjectorReference(m_lProjs, m_lChNames, projRef, m_lBads, URef);
+    qint64 iTimeRef = timer.nsecsElapsed();
+
+    timer.start();
+    FiffProj::make_projector(m_lProjs, m_lChNames, proj, m_lBads, U);
+    qint64 iTimeMiss = timer.nsecsElapsed();
+
+    timer.start();
+    FiffProj::make_projector(m_lProjs, m_lChNames, proj, m_lBads, U);
+    qint64 iTimeHit = timer.nsecsElapsed();
+
+    QVERIFY((proj - projRef).cwiseAbs().maxCoeff() < dEpsilon);
+
+    qInfo() << "[TestFiffProj::benchmarkCache]" << m_iNChan << "channels - reference" << iTimeRef / 1000000.0
+            << "ms, first call" << iTimeMiss / 1000000.0 << "ms, cached call" << iTimeHit / 1000000.0 << "ms";
+}
+
+//=============================================================================================================
+
+void TestFiffProj::cleanupTestCase()
+{
+    FiffProj::clear_projector_cache();
+}
+
+//=============================================================================================================
+
+fiff_int_t TestFiffProj::makeProjectorReference(const QList<FiffProj>& projs,
+                                                const QStringList& ch_names,
+                                                MatrixXd& proj,
+                                                const QStringList& bads,
+                                                MatrixXd& U)
+{
+    // The operator as make_projector built it before caching: full SVD and an identity copy
+    fiff_int_t nchan = ch_names.size();
+    proj = MatrixXd::Identity(nchan, nchan);
+    U = MatrixXd();
+
+    fiff_int_t nvec = 0;
+    for(int k = 0; k < projs.size(); ++k) {
+        if(projs[k].active) {
+            nvec += projs[k].data->nrow;
+        }
+    }
+
+    MatrixXd vecs = MatrixXd::Zero(nchan, nvec);
+    nvec = 0;
+    for(int k = 0; k < projs.size(); ++k) {
+        if(!projs[k].active) {
+            continue;
+        }
+        const FiffNamedMatrix& one = *projs[k].data;
+        for(int c = 0; c < nchan; ++c) {
+            int i = one.col_names.indexOf(ch_names[c]);
+            if(i > -1 && !bads.contains(ch_names[c])) {
+                for(int v = 0; v < one.nrow; ++v) {
+                    vecs(c, nvec + v) = one.data(v, i);
+                }
+            }
+        }
+        for(int v = 0; v < one.nrow; ++v) {
+            double onesize = vecs.col(nvec + v).norm();
+            if(onesize > 0.0) {
+                vecs.col(nvec + v) /= onesize;
+            }
+        }
+        nvec += one.nrow;
+    }
+
+    JacobiSVD<MatrixXd> svd(vecs, ComputeFullU);
+    VectorXd S = svd.singularValues();
+    MatrixXd t_U = svd.matrixU();
+    MNEMath::sort<double>(S, t_U);
+
+    fiff_int_t nproj = 0;
+    for(int k = 0; k < S.size(); ++k) {
+        if(S[k] / S[0] > 1e-2) {
+            ++nproj;
+        }
+    }
+
+    U = t_U.block(0, 0, t_U.rows(), nproj);
+    proj -= U * U.transpose();
+
+    return nproj;
+}
+
+//=============================================================================================================
+// MAIN
+//=============================================================================================================
+
+QTEST_GUILESS_MAIN(TestFiffProj)
+#include "test_fiff_proj.moc"
@@ -49,6 +49,7 @@
 //=============================================================================================================
 
 #include <QtTest>
+#include <QTemporaryDir>
 
 //=============================================================================================================
 // USED NAMESPACES
@@ -76,9 +77,18 @@ private slots:
     void compareData();
     void compareTimes();
     void compareInfo();
+    void compareSegments();
+    void compareDirScan();
+    void compareIndex();
     void cleanupTestCase();
 
 private:
+    //=========================================================================================================
+    /**
+     * Returns true if both trees have the same structure and tags.
+     */
+    bool isSameTree(const FiffDirNode::SPtr& pNodeA, const FiffDirNode::SPtr& pNodeB) const;
+
     double dEpsilon;
 
     FiffRawData rawFirstInRaw;
@@ -308,10 +318,189 @@ void TestFiffRWR::compareInfo()
 
 //=============================================================================================================
 
+void TestFiffRWR::compareSegments()
+{
+    // Unsorted, overlapping segments, some of them spanning several buffers
+    fiff_int_t nsamp = static_cast<fiff_int_t>(0.7f * rawFirstInRaw.info.sfreq);
+    fiff_int_t range = rawFirstInRaw.last_samp - rawFirstInRaw.first_samp - nsamp;
+
+    VectorXi vecFrom(6);
+    vecFrom << range / 2, 0, range, range / 3, range / 3 + 10, nsamp / 2;
+    vecFrom.array() += rawFirstInRaw.first_samp;
+
+    RowVectorXi vecPicks = RowVectorXi::LinSpaced(20, 0, 2 * 20 - 2);
+
+    MatrixXd matSegments;
+    QVERIFY(rawFirstInRaw.read_raw_segments(matSegments, vecFrom, nsamp, vecPicks));
+    QCOMPARE(matSegments.rows(), static_cast<Index>(vecPicks.size()));
+    QCOMPARE(matSegments.cols(), static_cast<Index>(vecFrom.size()) * nsamp);
+
+    MatrixXd matData, matTimes;
+    for(int i = 0; i < vecFrom.size(); ++i) {
+        QVERIFY(rawFirstInRaw.read_raw_segment(matData, matTimes, vecFrom[i], vecFrom[i] + nsamp - 1, vecPicks));
+        QVERIFY((matSegments.middleCols(static_cast<Index>(i) * nsamp, nsamp) - matData).cwiseAbs().maxCoeff() < dEpsilon);
+    }
+
+    // Segments beyond the recording are refused
+    vecFrom[0] = rawFirstInRaw.last_samp;
+    QVERIFY(!rawFirstInRaw.read_raw_segments(matSegments, vecFrom, nsamp, vecPicks));
+}
+
+//=============================================================================================================
+
+void TestFiffRWR::compareDirScan()
+{
+    QFile t_fileIn(QCoreApplication::applicationDirPath() + "/mne-cpp-test-data/MEG/sample/sample_audvis_trunc_raw.fif");
+    QFile t_fileNoDir(QCoreApplication::applicationDirPath() + "/mne-cpp-test-data/MEG/sample/sample_audvis_trunc_raw_test_nodir_out.fif");
+
+    // Copy of the file without directory pointer, so the directory has to be created by scanning all tags
+    QVERIFY(t_fileIn.open(QIODevice::ReadOnly));
+    QByteArray baFile = t_fileIn.readAll();
+    t_fileIn.close();
+
+    qint32 iFileIdSize = qFromBigEndian<qint32>(reinterpret_cast<const uchar*>(baFile.constData() + 8));
+    qint32 iDirPointerPos = 16 + iFileIdSize;
+    QCOMPARE(qFromBigEndian<qint32>(reinterpret_cast<const uchar*>(baFile.constData() + iDirPointerPos)), static_cast<qint32>(FIFF_DIR_POINTER));
+    qToBigEndian<qint32>(-1, reinterpret_cast<uchar*>(baFile.data() + iDirPointerPos + 16));
+
+    QVERIFY(t_fileNoDir.open(QIODevice::WriteOnly));
+    t_fileNoDir.write(baFile);
+    t_fileNoDir.close();
+
+    // Open both and time it
+    QElapsedTimer timer;
+    FiffStream::SPtr pStreamIn(new FiffStream(&t_fileIn));
+    timer.start();
+    QVERIFY(pStreamIn->open());
+    qint64 iTimeDir = timer.nsecsElapsed();
+
+    FiffStream::SPtr pStreamNoDir(new FiffStream(&t_fileNoDir));
+    timer.restart();
+    QVERIFY(pStreamNoDir->open());
+    qint64 iTimeScan = timer.nsecsElapsed();
+
+    qInfo() << "[TestFiffRWR::compareDirScan] Opening with directory" << iTimeDir / 1000 << "us, by scanning" << iTimeScan / 1000 << "us," << pStreamNoDir->nent() << "tags.";
+
+    QVERIFY(isSameTree(pStreamIn->dirtree(), pStreamNoDir->dirtree()));
+
+    pStreamIn->close();
+    pStreamNoDir->close();
+}
+
+//=============================================================================================================
+
+void TestFiffRWR::compareIndex()
+{
+    QTemporaryDir tmpDir;
+    QVERIFY(tmpDir.isValid());
+    FiffIndex::setCacheDir(tmpDir.path());
+
+    QFile t_fileIn(QCoreApplication::applicationDirPath() + "/mne-cpp-test-data/MEG/sample/sample_audvis_trunc_raw.fif");
+    QString sIndexFileName = FiffIndex::indexFileName(t_fileIn.fileName());
+    QVERIFY(!QFile::exists(sIndexFileName));
+
+    // The first setup scans the file and writes the index, the second one reads the index
+    QElapsedTimer timer;
+    FiffIndex::setEnabled(true);
+    timer.start();
+    FiffRawData rawScan(t_fileIn);
+    qint64 iTimeScan = timer.nsecsElapsed();
+    FiffIndex::setEnabled(false);
+    QVERIFY(QFile::exists(sIndexFileName));
+
+    timer.restart();
+    FiffRawData rawIndex(t_fileIn);
+    qint64 iTimeIndex = timer.nsecsElapsed();
+
+    qInfo() << "[TestFiffRWR::compareIndex] Raw setup by scanning" << iTimeScan / 1000 << "us, from the index" << iTimeIndex / 1000 << "us.";
+
+    QVERIFY(isSameTree(rawScan.file->dirtree(), rawIndex.file->dirtree()));
+    QCOMPARE(rawIndex.file->nent(), rawScan.file->nent());
+    QCOMPARE(rawIndex.first_samp, rawScan.first_samp);
+    QCOMPARE(rawIndex.last_samp, rawScan.last_samp);
+    QCOMPARE(rawIndex.rawdir.size(), rawScan.rawdir.size());
+    for(int k = 0; k < rawScan.rawdir.size(); ++k) {
+        QCOMPARE(rawIndex.rawdir[k].first, rawScan.rawdir[k].first);
+        QCOMPARE(rawIndex.rawdir[k].last, rawScan.rawdir[k].last);
+        QCOMPARE(rawIndex.rawdir[k].nsamp, rawScan.rawdir[k].nsamp);
+        QCOMPARE(rawIndex.rawdir[k].ent.isNull(), rawScan.rawdir[k].ent.isNull());
+        if(!rawScan.rawdir[k].ent.isNull()) {
+            QCOMPARE(rawIndex.rawdir[k].ent->pos, rawScan.rawdir[k].ent->pos);
+            QCOMPARE(rawIndex.rawdir[k].ent->type, rawScan.rawdir[k].ent->type);
+            QCOMPARE(rawIndex.rawdir[k].ent->size, rawScan.rawdir[k].ent->size);
+        }
+    }
+
+    MatrixXd matDataScan, matDataIndex, matTimes;
+    QVERIFY(rawScan.read_raw_segment(matDataScan, matTimes));
+    QVERIFY(rawIndex.read_raw_segment(matDataIndex, matTimes));
+    QVERIFY(matDataScan == matDataIndex);
+
+    // An index which does not match the file anymore is ignored
+    QFile t_fileChanged(tmpDir.filePath("sample_audvis_trunc_raw_changed.fif"));
+    QVERIFY(t_fileIn.copy(t_fileChanged.fileName()));
+    FiffIndex::setEnabled(true);
+    FiffRawData rawChanged(t_fileChanged);
+    FiffIndex::setEnabled(false);
+    QVERIFY(QFile::exists(FiffIndex::indexFileName(t_fileChanged.fileName())));
+
+    QVERIFY(t_fileChanged.open(QIODevice::Append));
+    t_fileChanged.write(QByteArray(16, 0));
+    t_fileChanged.close();
+
+    FiffIndex t_index;
+    QVERIFY(!t_index.read(t_fileChanged.fileName(), rawChanged.file->id()));
+    QVERIFY(t_index.read(t_fileIn.fileName(), rawScan.file->id()));
+    QVERIFY(t_index.hasRawDir(rawScan.info.nchan));
+
+    FiffIndex::setCacheDir(QString());
+}
+
+//=============================================================================================================
+
 void TestFiffRWR::cleanupTestCase()
 {
 }
 
+//=============================================================================================================
+
+bool TestFiffRWR::isSameTree(const FiffDirNode::SPtr& pNodeA, const FiffDirNode::SPtr& pNodeB) const
+{
+    if(pNodeA->type != pNodeB->type || pNodeA->nchild() != pNodeB->nchild()) {
+        return false;
+    }
+
+    // A stored directory may list the directory tag itself, which is not found when scanning
+    QList<const FiffDirEntry*> dirA, dirB;
+    for(const FiffDirEntry* pEnt : pNodeA->dir) {
+        if(pEnt->kind != FIFF_DIR) {
+            dirA.append(pEnt);
+        }
+    }
+    for(const FiffDirEntry* pEnt : pNodeB->dir) {
+        if(pEnt->kind != FIFF_DIR) {
+            dirB.append(pEnt);
+        }
+    }
+
+    if(dirA.size() != dirB.size()) {
+        return false;
+    }
+    for(int k = 0; k < dirA.size(); ++k) {
+        if(dirA[k]->kind != dirB[k]->kind || dirA[k]->type != dirB[k]->type || dirA[k]->size != dirB[k]->size || dirA[k]->pos != dirB[k]->pos) {
+            return false;
+        }
+    }
+
+    for(int k = 0; k < pNodeA->nchild(); ++k) {
+        if(!isSameTree(pNodeA->children[k], pNodeB->children[k])) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 //=============================================================================================================
 // MAIN
 //=============================================================================================================
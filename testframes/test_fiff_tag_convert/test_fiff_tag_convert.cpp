@@ -0,0 +1,369 @@
+//=============================================================================================================
+/**
+ * @file     test_fiff_tag_convert.cpp
+ * @author   agent <agent@local>
+ * @since    0.1.9
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, agent. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    Tests the vectorized byte order conversion of the fiff tags.
+ *
+ */
+
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include <fiff/fiff_tag.h>
+#include <fiff/fiff_file.h>
+#include <utils/ioutils.h>
+#include <utils/generics/applicationlogger.h>
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QtTest>
+#include <QtEndian>
+#include <QElapsedTimer>
+
+//=============================================================================================================
+// EIGEN INCLUDES
+//=============================================================================================================
+
+#include <Eigen/Dense>
+
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace FIFFLIB;
+using namespace UTILSLIB;
+using namespace Eigen;
+
+//=============================================================================================================
+/**
+ * DECLARE CLASS TestFiffTagConvert
+ *
+ * @brief The TestFiffTagConvert class checks the vectorized byte order conversion of the fiff tags against an
+ *        element wise reference and times it for every numeric tag type.
+ *
+ */
+class TestFiffTagConvert: public QObject
+{
+    Q_OBJECT
+
+public:
+    TestFiffTagConvert();
+
+private slots:
+    void initTestCase();
+    void convertSimpleTypes();
+    void convertStructs();
+    void convertMatrix();
+    void decodeBuffers();
+    void cleanupTestCase();
+
+private:
+    //=========================================================================================================
+    /**
+     * Creates a tag of the given type which holds the values in big endian byte order.
+     */
+    template<typename T, typename U>
+    static FiffTag::SPtr makeBigEndianTag(fiff_int_t type, const QVector<T>& values);
+
+    //=========================================================================================================
+    /**
+     * Converts a big endian tag of the given type, compares it to the original values and prints the timings of
+     * the vectorized conversion and of an element wise reference.
+     */
+    template<typename T, typename U>
+    void compareType(fiff_int_t type, const char* sTypeName, const QVector<T>& values);
+
+    //=========================================================================================================
+    /**
+     * Decodes a buffer tag of the given type lazily from big endian and from native data and compares both.
+     */
+    template<typename T, typename U>
+    void compareBuffer(fiff_int_t type, const char* sTypeName, const QVector<T>& values);
+
+    int iNumChannels;
+    int iNumSamples;
+    int iNumRepetitions;
+    QVector<qint16> vecShort;
+    QVector<qint32> vecInt;
+    QVector<qint64> vecLong;
+    QVector<float> vecFloat;
+    QVector<double> vecDouble;
+};
+
+//=============================================================================================================
+
+TestFiffTagConvert::TestFiffTagConvert()
+: iNumChannels(376)
+, iNumSamples(1200)
+, iNumRepetitions(20)
+{
+}
+
+//=============================================================================================================
+
+void TestFiffTagConvert::initTestCase()
+{
+    qInstallMessageHandler(UTILSLIB::ApplicationLogger::customLogWriter);
+
+    // An odd number of values also exercises the scalar tail of the kernels
+    int iNumValues = iNumChannels*iNumSamples + 3;
+    vecShort.resize(iNumValues);
+    vecInt.resize(iNumValues);
+    vecLong.resize(iNumValues);
+    vecFloat.resize(iNumValues);
+    vecDouble.resize(iNumValues);
+
+    qsrand(42);
+    for(int i = 0; i < iNumValues; ++i) {
+        qint32 iValue = qrand() - RAND_MAX/2;
+        vecShort[i] = static_cast<qint16>(iValue);
+        vecInt[i] = iValue;
+        vecLong[i] = static_cast<qint64>(iValue)*qrand();
+        vecFloat[i] = static_cast<float>(iValue)*1e-13f;
+        vecDouble[i] = static_cast<double>(iValue)*1e-13;
+    }
+}
+
+//=============================================================================================================
+
+void TestFiffTagConvert::convertSimpleTypes()
+{
+    compareType<qint16, quint16>(FIFFT_SHORT, "FIFFT_SHORT", vecShort);
+    compareType<qint16, quint16>(FIFFT_DAU_PACK16, "FIFFT_DAU_PACK16", vecShort);
+    compareType<qint32, quint32>(FIFFT_INT, "FIFFT_INT", vecInt);
+    compareType<qint64, quint64>(FIFFT_LONG, "FIFFT_LONG", vecLong);
+    compareType<float, quint32>(FIFFT_FLOAT, "FIFFT_FLOAT", vecFloat);
+    compareType<float, quint32>(FIFFT_COMPLEX_FLOAT, "FIFFT_COMPLEX_FLOAT", vecFloat.mid(0, vecFloat.size() - 1));
+    compareType<double, quint64>(FIFFT_DOUBLE, "FIFFT_DOUBLE", vecDouble);
+    compareType<double, quint64>(FIFFT_COMPLEX_DOUBLE, "FIFFT_COMPLEX_DOUBLE", vecDouble.mid(0, vecDouble.size() - 1));
+}
+
+//=============================================================================================================
+
+void TestFiffTagConvert::convertStructs()
+{
+    // Channel info records: the 20 leading words are swapped, the channel name is not
+    int iNumCh = 306;
+    FiffTag::SPtr pTag(new FiffTag());
+    pTag->type = FIFFT_CH_INFO_STRUCT;
+    pTag->resize(iNumCh*FiffChInfo::storageSize());
+    for(int k = 0; k < iNumCh; ++k) {
+        char* offset = pTag->data() + k*FiffChInfo::storageSize();
+        for(int w = 0; w < 20; ++w) {
+            qToBigEndian<quint32>(static_cast<quint32>(k*20 + w), offset + 4*w);
+        }
+        qstrncpy(offset + 80, QString("MEG %1").arg(k, 4, 10, QChar('0')).toLatin1().constData(), 16);
+    }
+
+    FiffTag::convert_tag_data(pTag, FIFFV_BIG_ENDIAN, FIFFV_NATIVE_ENDIAN);
+
+    for(int k = 0; k < iNumCh; ++k) {
+        const qint32* pWords = reinterpret_cast<const qint32*>(pTag->data() + k*FiffChInfo::storageSize());
+        for(int w = 0; w < 20; ++w) {
+            QCOMPARE(pWords[w], k*20 + w);
+        }
+        QCOMPARE(QString(pTag->data() + k*FiffChInfo::storageSize() + 80), QString("MEG %1").arg(k, 4, 10, QChar('0')));
+    }
+
+    // Coordinate transformations consist of words only and survive a round trip
+    FiffTag::SPtr pTrans(new FiffTag());
+    pTrans->type = FIFFT_COORD_TRANS_STRUCT;
+    pTrans->resize(2*FiffCoordTrans::storageSize());
+    for(int w = 0; w < pTrans->size()/4; ++w) {
+        reinterpret_cast<float*>(pTrans->data())[w] = 0.5f*w;
+    }
+    QByteArray baOriginal(pTrans->data(), pTrans->size());
+
+    FiffTag::convert_tag_data(pTrans, FIFFV_NATIVE_ENDIAN, FIFFV_BIG_ENDIAN);
+    QCOMPARE(qFromBigEndian<quint32>(pTrans->data() + 4), *reinterpret_cast<const quint32*>(baOriginal.constData() + 4));
+    FiffTag::convert_tag_data(pTrans, FIFFV_BIG_ENDIAN, FIFFV_NATIVE_ENDIAN);
+    QCOMPARE(QByteArray(pTrans->data(), pTrans->size()), baOriginal);
+}
+
+//=============================================================================================================
+
+void TestFiffTagConvert::convertMatrix()
+{
+    // Dense float matrix: data, followed by the dimensions and their number
+    int iRows = 61, iCols = 305;
+    FiffTag::SPtr pTag(new FiffTag());
+    pTag->type = FIFFT_MATRIX_FLOAT;
+    pTag->resize((iRows*iCols + 3)*4);
+    float* pData = reinterpret_cast<float*>(pTag->data());
+    for(int i = 0; i < iRows*iCols; ++i) {
+        pData[i] = vecFloat[i];
+    }
+    qint32* pDims = reinterpret_cast<qint32*>(pData + iRows*iCols);
+    pDims[0] = iCols;
+    pDims[1] = iRows;
+    pDims[2] = 2;
+    QByteArray baOriginal(pTag->data(), pTag->size());
+
+    FiffTag::convert_tag_data(pTag, FIFFV_NATIVE_ENDIAN, FIFFV_BIG_ENDIAN);
+    QCOMPARE(qFromBigEndian<qint32>(pTag->data() + pTag->size() - 4), 2);
+    QCOMPARE(qFromBigEndian<quint32>(pTag->data() + 4*(iRows*iCols - 1)), *reinterpret_cast<const quint32*>(baOriginal.constData() + 4*(iRows*iCols - 1)));
+
+    FiffTag::convert_tag_data(pTag, FIFFV_BIG_ENDIAN, FIFFV_NATIVE_ENDIAN);
+    QCOMPARE(QByteArray(pTag->data(), pTag->size()), baOriginal);
+    QCOMPARE(pTag->toFloatMatrix().rows(), static_cast<Index>(iRows));
+}
+
+//=============================================================================================================
+
+void TestFiffTagConvert::decodeBuffers()
+{
+    compareBuffer<qint16, quint16>(FIFFT_DAU_PACK16, "FIFFT_DAU_PACK16", vecShort);
+    compareBuffer<qint16, quint16>(FIFFT_SHORT, "FIFFT_SHORT", vecShort);
+    compareBuffer<qint32, quint32>(FIFFT_INT, "FIFFT_INT", vecInt);
+    compareBuffer<float, quint32>(FIFFT_FLOAT, "FIFFT_FLOAT", vecFloat);
+    compareBuffer<double, quint64>(FIFFT_DOUBLE, "FIFFT_DOUBLE", vecDouble);
+
+    // Unsupported buffer types are reported and zero filled
+    FiffTag::SPtr pTag(new FiffTag());
+    pTag->type = FIFFT_STRING;
+    pTag->resize(iNumChannels*iNumSamples);
+    MatrixXd matData;
+    QVERIFY(!pTag->toBufferMatrix(iNumChannels, iNumSamples, matData));
+    QCOMPARE(matData.cols(), static_cast<Index>(iNumSamples));
+    QVERIFY(matData.isZero(0));
+}
+
+//=============================================================================================================
+
+void TestFiffTagConvert::cleanupTestCase()
+{
+}
+
+//=============================================================================================================
+
+template<typename T, typename U>
+FiffTag::SPtr TestFiffTagConvert::makeBigEndianTag(fiff_int_t type, const QVector<T>& values)
+{
+    FiffTag::SPtr pTag(new FiffTag());
+    pTag->type = type;
+    pTag->resize(values.size()*sizeof(T));
+
+    U word;
+    for(int i = 0; i < values.size(); ++i) {
+        memcpy(&word, &values[i], sizeof(U));
+        qToBigEndian<U>(word, pTag->data() + i*sizeof(T));
+    }
+
+    return pTag;
+}
+
+//=============================================================================================================
+
+template<typename T, typename U>
+void TestFiffTagConvert::compareType(fiff_int_t type, const char* sTypeName, const QVector<T>& values)
+{
+    FiffTag::SPtr pTagBig = makeBigEndianTag<T, U>(type, values);
+    QElapsedTimer timer;
+
+    // Vectorized conversion
+    FiffTag::SPtr pTag;
+    qint64 iTimeVectorized = 0;
+    for(int r = 0; r < iNumRepetitions; ++r) {
+        pTag = FiffTag::SPtr(new FiffTag(pTagBig.data()));
+        timer.start();
+        FiffTag::convert_tag_data(pTag, FIFFV_BIG_ENDIAN, FIFFV_NATIVE_ENDIAN);
+        iTimeVectorized += timer.nsecsElapsed();
+    }
+
+    // Element wise reference
+    QVector<T> vecReference(values.size());
+    qint64 iTimeReference = 0;
+    U word;
+    for(int r = 0; r < iNumRepetitions; ++r) {
+        timer.start();
+        for(int i = 0; i < values.size(); ++i) {
+            word = qFromBigEndian<U>(pTagBig->data() + i*sizeof(T));
+            memcpy(&vecReference[i], &word, sizeof(U));
+        }
+        iTimeReference += timer.nsecsElapsed();
+    }
+
+    QCOMPARE(pTag->size(), pTagBig->size());
+    QVERIFY(memcmp(pTag->data(), values.constData(), values.size()*sizeof(T)) == 0);
+    QVERIFY(memcmp(vecReference.constData(), values.constData(), values.size()*sizeof(T)) == 0);
+
+    qInfo("[TestFiffTagConvert::convertSimpleTypes] %s: %d values, vectorized %.3f ms, element wise %.3f ms",
+          sTypeName, values.size(), iTimeVectorized/1e6/iNumRepetitions, iTimeReference/1e6/iNumRepetitions);
+}
+
+//=============================================================================================================
+
+template<typename T, typename U>
+void TestFiffTagConvert::compareBuffer(fiff_int_t type, const char* sTypeName, const QVector<T>& values)
+{
+    FiffTag::SPtr pTagLazy = makeBigEndianTag<T, U>(type, values.mid(0, iNumChannels*iNumSamples));
+    pTagLazy->endian = FIFFV_BIG_ENDIAN;
+
+    FiffTag::SPtr pTagNative(new FiffTag());
+    pTagNative->type = type;
+    pTagNative->append(reinterpret_cast<const char*>(values.constData()), static_cast<int>(iNumChannels*iNumSamples*sizeof(T)));
+
+    QElapsedTimer timer;
+    MatrixXd matLazy, matNative, matEager;
+    qint64 iTimeLazy = 0, iTimeEager = 0;
+    for(int r = 0; r < iNumRepetitions; ++r) {
+        timer.start();
+        QVERIFY(pTagLazy->toBufferMatrix(iNumChannels, iNumSamples, matLazy));
+        iTimeLazy += timer.nsecsElapsed();
+
+        // The former way: convert the whole tag first and decode it afterwards
+        FiffTag::SPtr pTag(new FiffTag(pTagLazy.data()));
+        pTag->endian = FIFFV_NATIVE_ENDIAN;
+        timer.start();
+        FiffTag::convert_tag_data(pTag, FIFFV_BIG_ENDIAN, FIFFV_NATIVE_ENDIAN);
+        QVERIFY(pTag->toBufferMatrix(iNumChannels, iNumSamples, matEager));
+        iTimeEager += timer.nsecsElapsed();
+    }
+    QVERIFY(pTagNative->toBufferMatrix(iNumChannels, iNumSamples, matNative));
+
+    QCOMPARE(matLazy.rows(), static_cast<Index>(iNumChannels));
+    QCOMPARE(matLazy.cols(), static_cast<Index>(iNumSamples));
+    QVERIFY(matLazy == matNative);
+    QVERIFY(matEager == matNative);
+    QCOMPARE(matNative(0, 1), static_cast<double>(values[iNumChannels]));
+
+    qInfo("[TestFiffTagConvert::decodeBuffers] %s: %d x %d buffer, lazy %.3f ms, convert and decode %.3f ms",
+          sTypeName, iNumChannels, iNumSamples, iTimeLazy/1e6/iNumRepetitions, iTimeEager/1e6/iNumRepetitions);
+}
+
+//=============================================================================================================
+// MAIN
+//=============================================================================================================
+
+QTEST_GUILESS_MAIN(TestFiffTagConvert)
+#include "test_fiff_tag_convert.moc"
@@ -44,6 +44,7 @@
 
 #include <fiff/fiff.h>
 #include <rtprocessing/helpers/filterkernel.h>
+#include <rtprocessing/helpers/iirfilter.h>
 #include <rtprocessing/filter.h>
 
 #include <Eigen/Dense>
@@ -56,6 +57,7 @@
 #include <QFile>
 #include <QCommandLineParser>
 #include <QtTest>
+#include <QElapsedTimer>
 
 //=============================================================================================================
 // USED NAMESPACES
@@ -84,6 +86,12 @@ private slots:
     void initTestCase();
     void compareData();
     void compareTimes();
+    void compareIirCutoff();
+    void compareIirStreaming();
+    void compareIirZeroPhase();
+    void compareIirOverlapAdd();
+    void compareIirFile();
+    void compareIirLatency();
     void cleanupTestCase();
 
 private:
@@ -231,6 +239,191 @@ void TestFiltering::compareTimes()
     QVERIFY( mTimesDiff.sum() < dEpsilon );
 }
 
+//=============================================================================================================
+
+void TestFiltering::compareIirCutoff()
+{
+    // Butterworth designs have an attenuation of exactly 3dB at their cutoff frequencies
+    IirFilter filter(FilterKernel::m_filterTypes.indexOf(FilterParameter("BPF")), 4, 0.2, 0.2, IirFilter::Butterworth);
+    RowVectorXcd vecResponse = filter.getFrequencyResponse(1001);
+
+    QVERIFY(std::abs(std::abs(vecResponse(100)) - std::sqrt(0.5)) < 1e-6);
+    QVERIFY(std::abs(std::abs(vecResponse(300)) - std::sqrt(0.5)) < 1e-6);
+    QVERIFY(std::abs(std::abs(vecResponse(200)) - 1.0) < 1e-3);
+    QVERIFY(std::abs(vecResponse(0)) < 1e-6);
+}
+
+//=============================================================================================================
+
+void TestFiltering::compareIirStreaming()
+{
+    // Filtering blocks one after another must equal filtering all data at once
+    IirFilter filterOnce(FilterKernel::m_filterTypes.indexOf(FilterParameter("HPF")), 6, 0.05, 0.0, IirFilter::Chebyshev);
+    IirFilter filterStream(filterOnce.getSos());
+
+    MatrixXd matData = MatrixXd::Random(8, 1000);
+    MatrixXd matOnce = matData;
+    filterOnce.apply(matOnce);
+
+    MatrixXd matStream(8, 1000);
+    for(int i = 0; i < 1000; i += 100) {
+        MatrixXd matBlock = matData.middleCols(i, 100);
+        filterStream.apply(matBlock);
+        matStream.middleCols(i, 100) = matBlock;
+    }
+
+    QVERIFY((matOnce - matStream).cwiseAbs().maxCoeff() < dEpsilon);
+}
+
+//=============================================================================================================
+
+void TestFiltering::compareIirZeroPhase()
+{
+    // A passband sine must pass the forward-backward filter without attenuation and without phase shift
+    double dSFreq = 1000.0;
+    FilterKernel kernel("iir_bpf",
+                        FilterKernel::m_filterTypes.indexOf(FilterParameter("BPF")),
+                        4,
+                        20.0/(dSFreq/2.0),
+                        20.0/(dSFreq/2.0),
+                        0.0,
+                        dSFreq,
+                        FilterKernel::m_designMethods.indexOf(FilterParameter("Butterworth")));
+    QVERIFY(kernel.isIir());
+
+    MatrixXd matData(2, 4000);
+    for(int i = 0; i < matData.cols(); ++i) {
+        matData(0, i) = std::sin(2.0 * M_PI * 20.0 * i / dSFreq);
+        matData(1, i) = std::cos(2.0 * M_PI * 20.0 * i / dSFreq);
+    }
+
+    MatrixXd matFiltered = RTPROCESSINGLIB::filterData(matData, kernel);
+
+    QCOMPARE(matFiltered.cols(), matData.cols());
+    QVERIFY((matFiltered - matData).middleCols(1000, 2000).cwiseAbs().maxCoeff() < 1e-2);
+}
+
+//=============================================================================================================
+
+void TestFiltering::compareIirOverlapAdd()
+{
+    // The overlap add path must pass IIR kernels through without delaying the data
+    double dSFreq = 1000.0;
+    FilterKernel kernel("iir_hpf",
+                        FilterKernel::m_filterTypes.indexOf(FilterParameter("HPF")),
+                        4,
+                        5.0/(dSFreq/2.0),
+                        0.0,
+                        0.0,
+                        dSFreq,
+                        FilterKernel::m_designMethods.indexOf(FilterParameter("Butterworth")));
+
+    MatrixXd matData = MatrixXd::Random(4, 1000);
+    MatrixXd matOnce = matData;
+    kernel.getIirFilter().apply(matOnce);
+
+    FilterOverlapAdd filterStream;
+    MatrixXd matStream(4, 1000);
+    for(int i = 0; i < 1000; i += 200) {
+        matStream.middleCols(i, 200) = filterStream.calculate(matData.middleCols(i, 200), kernel);
+    }
+
+    QVERIFY((matOnce - matStream).cwiseAbs().maxCoeff() < dEpsilon);
+}
+
+//=============================================================================================================
+
+void TestFiltering::compareIirFile()
+{
+    // Filtering the file block by block must match filtering the whole recording in memory
+    QFile t_fileIn(QCoreApplication::applicationDirPath() + "/mne-cpp-test-data/MEG/sample/sample_audvis_trunc_raw.fif");
+    QFile t_fileOut(QCoreApplication::applicationDirPath() + "/mne-cpp-test-data/MEG/sample/rtfilter_filterfile_iir_out_raw.fif");
+
+    QSharedPointer<FiffRawData> pRawIn = QSharedPointer<FiffRawData>::create(t_fileIn);
+    RowVectorXi vecPicks = pRawIn->info.pick_types(true, true, false);
+    double dSFreq = pRawIn->info.sfreq;
+
+    FilterKernel kernel("iir_bpf",
+                        FilterKernel::m_filterTypes.indexOf(FilterParameter("BPF")),
+                        4,
+                        10.0/(dSFreq/2.0),
+                        10.0/(dSFreq/2.0),
+                        0.0,
+                        dSFreq,
+                        FilterKernel::m_designMethods.indexOf(FilterParameter("Butterworth")));
+
+    QVERIFY(RTPROCESSINGLIB::filterFile(t_fileOut, pRawIn, kernel, vecPicks));
+
+    // The file must be cut into several blocks
+    QVERIFY(pRawIn->last_samp - pRawIn->first_samp + 1 > 2 * dSFreq);
+
+    MatrixXd matData, matTimes;
+    QVERIFY(pRawIn->read_raw_segment(matData, matTimes, pRawIn->first_samp, pRawIn->last_samp, vecPicks));
+    MatrixXd matMemory = RTPROCESSINGLIB::filterData(matData, kernel);
+
+    FiffRawData rawOut(t_fileOut);
+    MatrixXd matFile;
+    QVERIFY(rawOut.read_raw_segment(matFile, matTimes, rawOut.first_samp, rawOut.last_samp, vecPicks));
+
+    QCOMPARE(matFile.cols(), matMemory.cols());
+    QVERIFY((matFile - matMemory).cwiseAbs().maxCoeff() < 1e-4 * matMemory.cwiseAbs().maxCoeff());
+}
+
+//=============================================================================================================
+
+void TestFiltering::compareIirLatency()
+{
+    // Compare the cost of streaming a recording block by block through an IIR and a FIR band pass
+    // The overlap add FIR path needs blocks of at least the filter length
+    double dSFreq = 1000.0;
+    int iNumChannels = 306;
+    int iBlockSize = 512;
+    int iNumBlocks = 50;
+
+    FilterKernel kernelFir("fir_bpf",
+                           FilterKernel::m_filterTypes.indexOf(FilterParameter("BPF")),
+                           512,
+                           20.0/(dSFreq/2.0),
+                           20.0/(dSFreq/2.0),
+                           5.0/(dSFreq/2.0),
+                           dSFreq,
+                           FilterKernel::m_designMethods.indexOf(FilterParameter("Cosine")));
+    FilterKernel kernelIir("iir_bpf",
+                           FilterKernel::m_filterTypes.indexOf(FilterParameter("BPF")),
+                           4,
+                           20.0/(dSFreq/2.0),
+                           20.0/(dSFreq/2.0),
+                           0.0,
+                           dSFreq,
+                           FilterKernel::m_designMethods.indexOf(FilterParameter("Butterworth")));
+
+    RowVectorXi vecPicks = RowVectorXi::LinSpaced(iNumChannels, 0, iNumChannels - 1);
+    MatrixXd matBlock = MatrixXd::Random(iNumChannels, iBlockSize);
+
+    QElapsedTimer timer;
+
+    FilterOverlapAdd filterFir;
+    timer.start();
+    for(int i = 0; i < iNumBlocks; ++i) {
+        filterFir.calculate(matBlock, kernelFir, vecPicks);
+    }
+    qint64 iTimeFir = timer.nsecsElapsed();
+
+    FilterOverlapAdd filterIir;
+    timer.restart();
+    for(int i = 0; i < iNumBlocks; ++i) {
+        filterIir.calculate(matBlock, kernelIir, vecPicks);
+    }
+    qint64 iTimeIir = timer.nsecsElapsed();
+
+    qInfo() << "[TestFiltering::compareIirLatency] FIR delay" << kernelFir.getFilterOrder()/2 << "samples," << iTimeFir/iNumBlocks/1000 << "us per block";
+    qInfo() << "[TestFiltering::compareIirLatency] IIR delay 0 samples (causal)," << iTimeIir/iNumBlocks/1000 << "us per block";
+
+    QVERIFY(iTimeIir > 0);
+}
+
+//=============================================================================================================
+
 void TestFiltering::cleanupTestCase()
 {
 }
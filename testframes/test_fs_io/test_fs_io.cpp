@@ -0,0 +1,402 @@
+//=============================================================================================================
+/**
+ * @file     test_fs_io.cpp
+ * @author   agent <agent@local>
+ * @since    0.1.9
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, agent. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    Tests the bulk FreeSurfer surface, curvature and annotation readers.
+ *
+ */
+
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include <fs/surface.h>
+#include <fs/surfaceset.h>
+#include <fs/annotation.h>
+#include <fs/annotationset.h>
+#include <utils/generics/applicationlogger.h>
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QtTest>
+#include <QTemporaryDir>
+#include <QDataStream>
+#include <QFile>
+#include <QDir>
+
+//=============================================================================================================
+// EIGEN INCLUDES
+//=============================================================================================================
+
+#include <Eigen/Dense>
+
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace FSLIB;
+using namespace Eigen;
+
+//=============================================================================================================
+/**
+ * DECLARE CLASS TestFsIO
+ *
+ * @brief The TestFsIO class checks the bulk FreeSurfer readers against an element wise reference reader.
+ *
+ */
+class TestFsIO: public QObject
+{
+    Q_OBJECT
+
+public:
+    TestFsIO();
+
+private slots:
+    void initTestCase();
+    void compareSurface();
+    void compareCurvature();
+    void compareAnnotation();
+    void loadSubject();
+    void cleanupTestCase();
+
+private:
+    //=========================================================================================================
+    /**
+     * Writes the three byte magic numbers and integers of the FreeSurfer formats.
+     */
+    static void write3(QDataStream& stream, qint32 value);
+
+    //=========================================================================================================
+    /**
+     * Writes a triangle surface, a new style curvature and a version 2 annotation file.
+     */
+    void writeSurface(const QString& sFileName, const MatrixX3f& matRR, const MatrixX3i& matTris) const;
+    void writeCurvature(const QString& sFileName, const VectorXf& vecCurv) const;
+    void writeAnnotation(const QString& sFileName, const VectorXi& vecLabelIds) const;
+
+    //=========================================================================================================
+    /**
+     * Reads a triangle surface element by element, the way the readers used to do it.
+     */
+    static bool readSurfaceReference(const QString& sFileName, MatrixX3f& matRR, MatrixX3i& matTris);
+
+    QString sSubject;
+    QString sSubjectsDir;
+    int iNumVertices;
+    int iNumFaces;
+    int iNumLabels;
+    QTemporaryDir tmpDir;
+    MatrixX3f matRR;
+    MatrixX3i matTris;
+    VectorXf vecCurv;
+    VectorXi vecLabelIds;
+};
+
+//=============================================================================================================
+
+TestFsIO::TestFsIO()
+: sSubject("fsaverage")
+, iNumVertices(163842)
+, iNumFaces(327680)
+, iNumLabels(36)
+{
+}
+
+//=============================================================================================================
+
+void TestFsIO::initTestCase()
+{
+    qInstallMessageHandler(UTILSLIB::ApplicationLogger::customLogWriter);
+
+    QVERIFY(tmpDir.isValid());
+    sSubjectsDir = tmpDir.path();
+    QVERIFY(QDir(sSubjectsDir).mkpath(sSubject + "/surf"));
+    QVERIFY(QDir(sSubjectsDir).mkpath(sSubject + "/label"));
+
+    std::srand(42);
+
+    // Same sizes as fsaverage
+    matRR = 100.0f * MatrixX3f::Random(iNumVertices, 3);
+    matTris = MatrixX3i::Random(iNumFaces, 3).unaryExpr([this](int i) { return std::abs(i % iNumVertices); });
+    vecCurv = VectorXf::Random(iNumVertices);
+    vecLabelIds = VectorXi::Random(iNumVertices).unaryExpr([this](int i) { return std::abs(i % iNumLabels); });
+
+    QString sSurfDir = sSubjectsDir + "/" + sSubject + "/surf/";
+    QString sLabelDir = sSubjectsDir + "/" + sSubject + "/label/";
+
+    for(const QString& sHemi : QStringList() << "lh" << "rh") {
+        writeSurface(sSurfDir + sHemi + ".white", matRR, matTris);
+        writeSurface(sSurfDir + sHemi + ".pial", 1.1f * matRR, matTris);
+        writeCurvature(sSurfDir + sHemi + ".curv", vecCurv);
+        writeAnnotation(sLabelDir + sHemi + ".aparc.annot", vecLabelIds);
+        writeAnnotation(sLabelDir + sHemi + ".aparc.a2009s.annot", vecLabelIds);
+    }
+}
+
+//=============================================================================================================
+
+void TestFsIO::compareSurface()
+{
+    QString sFileName = sSubjectsDir + "/" + sSubject + "/surf/lh.white";
+
+    QElapsedTimer timer;
+    timer.start();
+    MatrixX3f matRRRef;
+    MatrixX3i matTrisRef;
+    QVERIFY(readSurfaceReference(sFileName, matRRRef, matTrisRef));
+    qint64 iTimeReference = timer.elapsed();
+
+    timer.restart();
+    Surface surface;
+    QVERIFY(Surface::read(sFileName, surface, false));
+    qint64 iTimeBulk = timer.elapsed();
+
+    qInfo() << "[TestFsIO::compareSurface] Element wise" << iTimeReference << "ms, bulk" << iTimeBulk << "ms (incl. normals)";
+
+    QCOMPARE(surface.rr().rows(), static_cast<Index>(iNumVertices));
+    QCOMPARE(surface.tris().rows(), static_cast<Index>(iNumFaces));
+    QVERIFY(surface.rr() == matRRRef);
+    QVERIFY(surface.tris() == matTrisRef);
+    QVERIFY(surface.tris() == matTris);
+    QVERIFY((surface.rr() - 0.001f * matRR).cwiseAbs().maxCoeff() < 1e-6f);
+    QCOMPARE(surface.hemi(), 0);
+}
+
+//=============================================================================================================
+
+void TestFsIO::compareCurvature()
+{
+    VectorXf vecCurvRead = Surface::read_curv(sSubjectsDir + "/" + sSubject + "/surf/rh.curv");
+
+    QVERIFY(vecCurvRead == vecCurv);
+}
+
+//=============================================================================================================
+
+void TestFsIO::compareAnnotation()
+{
+    Annotation annotation;
+    QVERIFY(Annotation::read(sSubjectsDir + "/" + sSubject + "/label/lh.aparc.annot", annotation));
+
+    QCOMPARE(annotation.getVertices().size(), static_cast<Index>(iNumVertices));
+    QVERIFY(annotation.getVertices() == VectorXi::LinSpaced(iNumVertices, 0, iNumVertices - 1));
+    QVERIFY(annotation.getLabelIds() == vecLabelIds);
+    QCOMPARE(annotation.getColortable().numEntries, iNumLabels);
+    QCOMPARE(annotation.getColortable().struct_names[3], QString("label_3"));
+}
+
+//=============================================================================================================
+
+void TestFsIO::loadSubject()
+{
+    QStringList lSurfs = QStringList() << "white" << "pial";
+    QStringList lAtlases = QStringList() << "aparc" << "aparc.a2009s";
+
+    // First load is as cold as it gets after writing the files, the second one is warm
+    for(const QString& sRun : QStringList() << "cold" << "warm") {
+        QElapsedTimer timer;
+        timer.start();
+        QList<SurfaceSet> lSequentialSurfaceSets;
+        QList<AnnotationSet> lSequentialAnnotationSets;
+        for(const QString& sSurf : lSurfs) {
+            SurfaceSet surfaceSet;
+            surfaceSet.insert(Surface(sSubject, 0, sSurf, sSubjectsDir));
+            surfaceSet.insert(Surface(sSubject, 1, sSurf, sSubjectsDir));
+            lSequentialSurfaceSets.append(surfaceSet);
+        }
+        for(const QString& sAtlas : lAtlases) {
+            AnnotationSet annotationSet;
+            annotationSet.insert(Annotation(sSubject, 0, sAtlas, sSubjectsDir));
+            annotationSet.insert(Annotation(sSubject, 1, sAtlas, sSubjectsDir));
+            lSequentialAnnotationSets.append(annotationSet);
+        }
+        qint64 iTimeSequential = timer.elapsed();
+
+        timer.restart();
+        QList<SurfaceSet> lSurfaceSets = SurfaceSet::read(sSubject, lSurfs, sSubjectsDir);
+        QList<AnnotationSet> lAnnotationSets = AnnotationSet::read(sSubject, lAtlases, sSubjectsDir);
+        qint64 iTimeConcurrent = timer.elapsed();
+
+        qInfo() << "[TestFsIO::loadSubject]" << sRun << "load, sequential" << iTimeSequential << "ms, concurrent" << iTimeConcurrent << "ms";
+
+        QCOMPARE(lSurfaceSets.size(), lSurfs.size());
+        QCOMPARE(lAnnotationSets.size(), lAtlases.size());
+        for(int i = 0; i < lSurfs.size(); ++i) {
+            QCOMPARE(lSurfaceSets[i].size(), 2);
+            QCOMPARE(lSurfaceSets[i].surf(), lSurfs[i]);
+            for(int iHemi = 0; iHemi < 2; ++iHemi) {
+                QVERIFY(lSurfaceSets[i][iHemi].rr() == lSequentialSurfaceSets[i][iHemi].rr());
+                QVERIFY(lSurfaceSets[i][iHemi].tris() == lSequentialSurfaceSets[i][iHemi].tris());
+                QVERIFY(lSurfaceSets[i][iHemi].curv() == vecCurv);
+            }
+        }
+        for(int i = 0; i < lAtlases.size(); ++i) {
+            QCOMPARE(lAnnotationSets[i].size(), 2);
+            for(int iHemi = 0; iHemi < 2; ++iHemi) {
+                QVERIFY(lAnnotationSets[i][iHemi].getLabelIds() == lSequentialAnnotationSets[i][iHemi].getLabelIds());
+            }
+        }
+    }
+
+    // Both hemispheres through the constructor
+    SurfaceSet surfaceSet(sSubject, 2, "white", sSubjectsDir);
+    QCOMPARE(surfaceSet.size(), 2);
+    QCOMPARE(surfaceSet[1].hemi(), 1);
+}
+
+//=============================================================================================================
+
+void TestFsIO::cleanupTestCase()
+{
+}
+
+//=============================================================================================================
+
+void TestFsIO::write3(QDataStream& stream, qint32 value)
+{
+    stream << static_cast<quint8>((value >> 16) & 0xff)
+           << static_cast<quint8>((value >> 8) & 0xff)
+           << static_cast<quint8>(value & 0xff);
+}
+
+//=============================================================================================================
+
+void TestFsIO::writeSurface(const QString& sFileName, const MatrixX3f& matRR, const MatrixX3i& matTris) const
+{
+    QFile file(sFileName);
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    QDataStream stream(&file);
+    stream.setByteOrder(QDataStream::BigEndian);
+    stream.setFloatingPointPrecision(QDataStream::SinglePrecision);
+
+    write3(stream, 16777214);
+    stream.writeRawData("created by test_fs_io\n\n", 23);
+    stream << static_cast<qint32>(matRR.rows()) << static_cast<qint32>(matTris.rows());
+    for(int i = 0; i < matRR.rows(); ++i) {
+        stream << matRR(i,0) << matRR(i,1) << matRR(i,2);
+    }
+    for(int i = 0; i < matTris.rows(); ++i) {
+        stream << matTris(i,0) << matTris(i,1) << matTris(i,2);
+    }
+}
+
+//=============================================================================================================
+
+void TestFsIO::writeCurvature(const QString& sFileName, const VectorXf& vecCurv) const
+{
+    QFile file(sFileName);
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    QDataStream stream(&file);
+    stream.setByteOrder(QDataStream::BigEndian);
+    stream.setFloatingPointPrecision(QDataStream::SinglePrecision);
+
+    write3(stream, 16777215);
+    stream << static_cast<qint32>(vecCurv.size()) << static_cast<qint32>(iNumFaces) << static_cast<qint32>(1);
+    for(int i = 0; i < vecCurv.size(); ++i) {
+        stream << vecCurv[i];
+    }
+}
+
+//=============================================================================================================
+
+void TestFsIO::writeAnnotation(const QString& sFileName, const VectorXi& vecLabelIds) const
+{
+    QFile file(sFileName);
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    QDataStream stream(&file);
+    stream.setByteOrder(QDataStream::BigEndian);
+
+    stream << static_cast<qint32>(vecLabelIds.size());
+    for(int i = 0; i < vecLabelIds.size(); ++i) {
+        stream << static_cast<qint32>(i) << vecLabelIds[i];
+    }
+
+    // Version 2 colortable
+    QByteArray origTab("test_fs_io");
+    stream << static_cast<qint32>(1) << static_cast<qint32>(-2) << static_cast<qint32>(iNumLabels);
+    stream << static_cast<qint32>(origTab.size());
+    stream.writeRawData(origTab.constData(), origTab.size());
+    stream << static_cast<qint32>(iNumLabels);
+    for(int i = 0; i < iNumLabels; ++i) {
+        QByteArray name = QString("label_%1").arg(i).toUtf8();
+        stream << static_cast<qint32>(i) << static_cast<qint32>(name.size());
+        stream.writeRawData(name.constData(), name.size());
+        stream << static_cast<qint32>(i) << static_cast<qint32>(2 * i) << static_cast<qint32>(3 * i) << static_cast<qint32>(0);
+    }
+}
+
+//=============================================================================================================
+
+bool TestFsIO::readSurfaceReference(const QString& sFileName, MatrixX3f& matRR, MatrixX3i& matTris)
+{
+    QFile file(sFileName);
+    if(!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    QDataStream stream(&file);
+    stream.setByteOrder(QDataStream::BigEndian);
+    stream.setFloatingPointPrecision(QDataStream::SinglePrecision);
+
+    quint8 magic[3];
+    stream >> magic[0] >> magic[1] >> magic[2];
+    file.readLine();
+    file.readLine();
+
+    qint32 nvert, nface;
+    stream >> nvert >> nface;
+
+    matRR.resize(nvert, 3);
+    for(int i = 0; i < nvert; ++i) {
+        for(int j = 0; j < 3; ++j) {
+            stream >> matRR(i,j);
+        }
+    }
+
+    matTris.resize(nface, 3);
+    for(int i = 0; i < nface; ++i) {
+        for(int j = 0; j < 3; ++j) {
+            stream >> matTris(i,j);
+        }
+    }
+
+    matRR *= 0.001f;
+
+    return stream.status() == QDataStream::Ok;
+}
+
+//=============================================================================================================
+// MAIN
+//=============================================================================================================
+
+QTEST_GUILESS_MAIN(TestFsIO)
+#include "test_fs_io.moc"
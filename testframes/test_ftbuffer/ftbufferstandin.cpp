@@ -0,0 +1,353 @@
+//=============================================================================================================
+/**
+ * @file     ftbufferstandin.cpp
+ * @author   agent <agent@local>
+ * @since    0.1.9
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, agent. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    Definition of the FtBufferStandIn Class.
+ *
+ */
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include "ftbufferstandin.h"
+
+#include <cstring>
+#include <algorithm>
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QMutexLocker>
+
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace FTBUFFERPLUGIN;
+
+//=============================================================================================================
+// DEFINE GLOBAL METHODS
+//=============================================================================================================
+
+namespace {
+    template<typename T>
+    void appendValue(QByteArray& baSamples,
+                     double dValue)
+    {
+        T value = static_cast<T>(dValue);
+        baSamples.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+}
+
+//=============================================================================================================
+// DEFINE MEMBER METHODS
+//=============================================================================================================
+
+FtBufferStandIn::FtBufferStandIn(int iNumChannels,
+                                 float fSampleFreq,
+                                 qint32 iDataType,
+                                 QObject* parent)
+: QTcpServer(parent)
+, m_iNumChannels(iNumChannels)
+, m_fSampleFreq(fSampleFreq)
+, m_iDataType(iDataType)
+, m_iNumSamples(0)
+, m_iStreamRemaining(0)
+, m_iStreamBlockSize(0)
+, m_bTruncateNext(false)
+, m_pWaitTimer(new QTimer(this))
+, m_pStreamTimer(new QTimer(this))
+{
+    switch (m_iDataType) {
+        case DATATYPE_INT16:
+            m_iSampleSize = 2;
+            break;
+        case DATATYPE_INT32:
+        case DATATYPE_FLOAT32:
+            m_iSampleSize = 4;
+            break;
+        default:
+            m_iDataType = DATATYPE_FLOAT64;
+            m_iSampleSize = 8;
+    }
+
+    m_clock.start();
+
+    m_pWaitTimer->setInterval(1);
+    connect(m_pWaitTimer, &QTimer::timeout,
+            this, &FtBufferStandIn::checkWaits);
+
+    connect(m_pStreamTimer, &QTimer::timeout, this, [this]() {
+        int iNumSamples = qMin(m_iStreamBlockSize, m_iStreamRemaining);
+        m_iStreamRemaining -= iNumSamples;
+        putSamples(iNumSamples);
+
+        if(m_iStreamRemaining <= 0) {
+            m_pStreamTimer->stop();
+        }
+    });
+}
+
+//=============================================================================================================
+
+void FtBufferStandIn::putSamples(int iNumSamples)
+{
+    m_baSamples.reserve(m_baSamples.size() + iNumSamples * m_iNumChannels * m_iSampleSize);
+
+    for(int s = m_iNumSamples; s < m_iNumSamples + iNumSamples; ++s) {
+        for(int c = 0; c < m_iNumChannels; ++c) {
+            switch (m_iDataType) {
+                case DATATYPE_INT16:
+                    appendValue<qint16>(m_baSamples, sampleValue(c, s));
+                    break;
+                case DATATYPE_INT32:
+                    appendValue<qint32>(m_baSamples, sampleValue(c, s));
+                    break;
+                case DATATYPE_FLOAT32:
+                    appendValue<float>(m_baSamples, sampleValue(c, s));
+                    break;
+                default:
+                    appendValue<double>(m_baSamples, sampleValue(c, s));
+            }
+        }
+    }
+
+    m_iNumSamples += iNumSamples;
+
+    {
+        QMutexLocker locker(&m_mutex);
+        m_vecAppendTimes.resize(m_iNumSamples);
+        std::fill(m_vecAppendTimes.end() - iNumSamples, m_vecAppendTimes.end(), clockNsecs());
+    }
+
+    checkWaits();
+}
+
+//=============================================================================================================
+
+void FtBufferStandIn::startStreaming(int iBlockSize,
+                                     int iIntervalMsec,
+                                     int iTotalSamples)
+{
+    m_iStreamBlockSize = iBlockSize;
+    m_iStreamRemaining = iTotalSamples;
+
+    m_pStreamTimer->setTimerType(Qt::PreciseTimer);
+    m_pStreamTimer->start(iIntervalMsec);
+}
+
+//=============================================================================================================
+
+void FtBufferStandIn::truncateNextResponse()
+{
+    m_bTruncateNext = true;
+}
+
+//=============================================================================================================
+
+qint64 FtBufferStandIn::clockNsecs() const
+{
+    return m_clock.nsecsElapsed();
+}
+
+//=============================================================================================================
+
+qint64 FtBufferStandIn::appendTime(int iSample) const
+{
+    QMutexLocker locker(&m_mutex);
+    return iSample >= 0 && iSample < m_vecAppendTimes.size() ? m_vecAppendTimes.at(iSample) : -1;
+}
+
+//=============================================================================================================
+
+double FtBufferStandIn::sampleValue(int iChannel,
+                                    int iSample)
+{
+    return (iSample % 1000) * 32 + (iChannel % 32);
+}
+
+//=============================================================================================================
+
+void FtBufferStandIn::incomingConnection(qintptr socketDescriptor)
+{
+    Client* pClient = new Client;
+    pClient->pSocket = new QTcpSocket(this);
+    pClient->bWaiting = false;
+    pClient->iWaitThreshold = 0;
+    pClient->iWaitDeadline = 0;
+
+    if(!pClient->pSocket->setSocketDescriptor(socketDescriptor)) {
+        delete pClient->pSocket;
+        delete pClient;
+        return;
+    }
+
+    m_lClients.append(pClient);
+
+    connect(pClient->pSocket, &QTcpSocket::readyRead, this, [this, pClient]() {
+        pClient->baInput.append(pClient->pSocket->readAll());
+        processRequests(pClient);
+    });
+
+    connect(pClient->pSocket, &QTcpSocket::disconnected, this, [this, pClient]() {
+        m_lClients.removeAll(pClient);
+        pClient->pSocket->deleteLater();
+        delete pClient;
+    });
+
+    if(!m_pWaitTimer->isActive()) {
+        m_pWaitTimer->start();
+    }
+}
+
+//=============================================================================================================
+
+void FtBufferStandIn::processRequests(Client* pClient)
+{
+    while(!pClient->bWaiting && pClient->baInput.size() >= static_cast<int>(sizeof(messagedef_t))) {
+        messagedef_t messagedef;
+        std::memcpy(&messagedef.version, pClient->baInput.constData(), sizeof(messagedef.version));
+        std::memcpy(&messagedef.command, pClient->baInput.constData() + 2, sizeof(messagedef.command));
+        std::memcpy(&messagedef.bufsize, pClient->baInput.constData() + 4, sizeof(messagedef.bufsize));
+
+        if(pClient->baInput.size() < static_cast<int>(sizeof(messagedef_t)) + messagedef.bufsize) {
+            return;
+        }
+
+        QByteArray baPayload = pClient->baInput.mid(sizeof(messagedef_t), messagedef.bufsize);
+        pClient->baInput.remove(0, sizeof(messagedef_t) + messagedef.bufsize);
+
+        if(messagedef.command == GET_HDR) {
+            headerdef_t headerdef;
+            headerdef.nchans = m_iNumChannels;
+            headerdef.nsamples = m_iNumSamples;
+            headerdef.nevents = 0;
+            headerdef.fsample = m_fSampleFreq;
+            headerdef.data_type = m_iDataType;
+            headerdef.bufsize = 0;
+
+            sendResponse(pClient->pSocket, GET_OK, QByteArray(reinterpret_cast<const char*>(&headerdef), sizeof(headerdef_t)));
+        } else if(messagedef.command == GET_DAT) {
+            datasel_t datasel;
+            datasel.begsample = 0;
+            datasel.endsample = m_iNumSamples - 1;
+
+            if(baPayload.size() >= static_cast<int>(sizeof(datasel_t))) {
+                std::memcpy(&datasel, baPayload.constData(), sizeof(datasel_t));
+            }
+
+            if(datasel.begsample < 0 || datasel.endsample >= m_iNumSamples || datasel.begsample > datasel.endsample) {
+                sendResponse(pClient->pSocket, GET_ERR);
+                continue;
+            }
+
+            const int iBytesPerSample = m_iNumChannels * m_iSampleSize;
+
+            datadef_t datadef;
+            datadef.nchans = m_iNumChannels;
+            datadef.nsamples = datasel.endsample - datasel.begsample + 1;
+            datadef.data_type = m_iDataType;
+            datadef.bufsize = datadef.nsamples * iBytesPerSample;
+
+            QByteArray baData(reinterpret_cast<const char*>(&datadef), sizeof(datadef_t));
+            baData.append(m_baSamples.constData() + datasel.begsample * iBytesPerSample, datadef.bufsize);
+
+            sendResponse(pClient->pSocket, GET_OK, baData);
+        } else if(messagedef.command == WAIT_DAT && baPayload.size() >= static_cast<int>(sizeof(waitdef_t))) {
+            waitdef_t waitdef;
+            std::memcpy(&waitdef, baPayload.constData(), sizeof(waitdef_t));
+
+            pClient->bWaiting = true;
+            pClient->iWaitThreshold = waitdef.threshold.nsamples;
+            pClient->iWaitDeadline = clockNsecs() + static_cast<qint64>(waitdef.milliseconds) * 1000000;
+
+            if(m_iNumSamples > pClient->iWaitThreshold || waitdef.milliseconds <= 0) {
+                answerWait(pClient);
+            }
+        } else {
+            sendResponse(pClient->pSocket, messagedef.command == WAIT_DAT ? WAIT_ERR : GET_ERR);
+        }
+    }
+}
+
+//=============================================================================================================
+
+void FtBufferStandIn::checkWaits()
+{
+    const qint64 iNow = clockNsecs();
+
+    for(Client* pClient : m_lClients) {
+        if(pClient->bWaiting && (m_iNumSamples > pClient->iWaitThreshold || iNow >= pClient->iWaitDeadline)) {
+            answerWait(pClient);
+
+            // Continue with the requests which were held back by the wait
+            processRequests(pClient);
+        }
+    }
+}
+
+//=============================================================================================================
+
+void FtBufferStandIn::answerWait(Client* pClient)
+{
+    pClient->bWaiting = false;
+
+    samples_events_t samplesEvents;
+    samplesEvents.nsamples = m_iNumSamples;
+    samplesEvents.nevents = 0;
+    sendResponse(pClient->pSocket, WAIT_OK, QByteArray(reinterpret_cast<const char*>(&samplesEvents), sizeof(samples_events_t)));
+}
+
+//=============================================================================================================
+
+void FtBufferStandIn::sendResponse(QTcpSocket* pSocket,
+                                   qint16 iCommand,
+                                   const QByteArray& baPayload)
+{
+    messagedef_t messagedef;
+    messagedef.version = VERSION;
+    messagedef.command = iCommand;
+    messagedef.bufsize = baPayload.size();
+
+    QByteArray baResponse;
+    baResponse.reserve(sizeof(messagedef_t) + baPayload.size());
+    baResponse.append(reinterpret_cast<const char*>(&messagedef.version), sizeof(messagedef.version));
+    baResponse.append(reinterpret_cast<const char*>(&messagedef.command), sizeof(messagedef.command));
+    baResponse.append(reinterpret_cast<const char*>(&messagedef.bufsize), sizeof(messagedef.bufsize));
+
+    if(m_bTruncateNext) {
+        m_bTruncateNext = false;
+    } else {
+        baResponse.append(baPayload);
+    }
+
+    pSocket->write(baResponse);
+}
@@ -0,0 +1,199 @@
+//=============================================================================================================
+/**
+ * @file     ftbufferstandin.h
+ * @author   agent <agent@local>
+ * @since    0.1.9
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, agent. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    Declaration of the FtBufferStandIn Class.
+ *
+ */
+
+#ifndef FTBUFFERSTANDIN_H
+#define FTBUFFERSTANDIN_H
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include "ftconnector.h"
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QElapsedTimer>
+#include <QByteArray>
+#include <QVector>
+#include <QMutex>
+#include <QTimer>
+#include <QList>
+
+//=============================================================================================================
+/**
+ * Minimal local stand-in for a FieldTrip buffer server. It answers GET_HDR, GET_DAT and WAIT_DAT for a single
+ * header with generated samples, so the FtConnector can be tested for latency and throughput without a
+ * FieldTrip installation. Requests of a client are answered in order, a pending WAIT_DAT holds back all
+ * following requests of that client, just like the original buffer server.
+ *
+ * The object must live in a thread with a running event loop. Apart from clockNsecs() and appendTime(), all
+ * methods must be called from that thread.
+ *
+ * @brief Local FieldTrip buffer stand-in server for tests.
+ */
+class FtBufferStandIn : public QTcpServer
+{
+    Q_OBJECT
+
+public:
+    //=========================================================================================================
+    /**
+     * Constructs a FtBufferStandIn.
+     *
+     * @param[in] iNumChannels   The number of channels.
+     * @param[in] fSampleFreq    The sampling frequency.
+     * @param[in] iDataType      The data type of the samples. DATATYPE_INT16, DATATYPE_INT32, DATATYPE_FLOAT32 and
+     *                           DATATYPE_FLOAT64 are supported.
+     * @param[in] parent         The parent object.
+     */
+    FtBufferStandIn(int iNumChannels,
+                    float fSampleFreq,
+                    qint32 iDataType,
+                    QObject* parent = Q_NULLPTR);
+
+    //=========================================================================================================
+    /**
+     * Appends generated samples and answers the WAIT_DAT requests which are satisfied by them.
+     *
+     * @param[in] iNumSamples    The number of samples to append.
+     */
+    void putSamples(int iNumSamples);
+
+    //=========================================================================================================
+    /**
+     * Starts appending iBlockSize samples every iIntervalMsec milliseconds until iTotalSamples were appended.
+     *
+     * @param[in] iBlockSize     The number of samples per block.
+     * @param[in] iIntervalMsec  The interval between two blocks.
+     * @param[in] iTotalSamples  The total number of samples to append.
+     */
+    void startStreaming(int iBlockSize,
+                        int iIntervalMsec,
+                        int iTotalSamples);
+
+    //=========================================================================================================
+    /**
+     * Cuts the next answer after its message definition, as if the buffer stalled in the middle of an answer.
+     */
+    void truncateNextResponse();
+
+    //=========================================================================================================
+    /**
+     * @return The nanoseconds since the construction of the stand-in. Can be called from any thread.
+     */
+    qint64 clockNsecs() const;
+
+    //=========================================================================================================
+    /**
+     * @param[in] iSample    The sample index.
+     *
+     * @return The clockNsecs() at which the sample was appended, -1 if it was not appended yet. Can be called
+     *         from any thread.
+     */
+    qint64 appendTime(int iSample) const;
+
+    //=========================================================================================================
+    /**
+     * @param[in] iChannel   The channel index.
+     * @param[in] iSample    The sample index.
+     *
+     * @return The generated value of the given sample. All values are exactly representable by all data types.
+     */
+    static double sampleValue(int iChannel,
+                              int iSample);
+
+protected:
+    //=========================================================================================================
+    void incomingConnection(qintptr socketDescriptor) override;
+
+private:
+    struct Client {
+        QTcpSocket* pSocket;            /**< The client socket. */
+        QByteArray  baInput;            /**< Received, not yet handled request bytes. */
+        bool        bWaiting;           /**< Whether a WAIT_DAT request is pending. */
+        qint32      iWaitThreshold;     /**< Sample threshold of the pending WAIT_DAT request. */
+        qint64      iWaitDeadline;      /**< Deadline of the pending WAIT_DAT request in clockNsecs(). */
+    };
+
+    //=========================================================================================================
+    /**
+     * Handles all complete requests of the client, until a WAIT_DAT request has to wait.
+     */
+    void processRequests(Client* pClient);
+
+    //=========================================================================================================
+    /**
+     * Answers all pending WAIT_DAT requests which are satisfied or timed out.
+     */
+    void checkWaits();
+
+    //=========================================================================================================
+    /**
+     * Sends a WAIT_OK with the current sample count.
+     */
+    void answerWait(Client* pClient);
+
+    //=========================================================================================================
+    /**
+     * Writes a message definition followed by the payload.
+     */
+    void sendResponse(QTcpSocket* pSocket,
+                      qint16 iCommand,
+                      const QByteArray& baPayload = QByteArray());
+
+    int                 m_iNumChannels;         /**< Number of channels. */
+    float               m_fSampleFreq;          /**< Sampling frequency. */
+    qint32              m_iDataType;            /**< Data type of the samples. */
+    int                 m_iSampleSize;          /**< Bytes per sample of one channel. */
+    int                 m_iNumSamples;          /**< Number of samples in the buffer. */
+    int                 m_iStreamRemaining;     /**< Number of samples left to stream. */
+    int                 m_iStreamBlockSize;     /**< Number of samples per streamed block. */
+    bool                m_bTruncateNext;        /**< Whether the next answer is cut after its message definition. */
+
+    QByteArray          m_baSamples;            /**< All samples, channels vary fastest. */
+    QList<Client*>      m_lClients;             /**< Connected clients. */
+
+    QElapsedTimer       m_clock;                /**< Clock for deadlines and latency measurements. */
+    mutable QMutex      m_mutex;                /**< Guards m_vecAppendTimes. */
+    QVector<qint64>     m_vecAppendTimes;       /**< clockNsecs() at which each sample was appended. */
+
+    QTimer*             m_pWaitTimer;           /**< Checks the deadlines of pending WAIT_DAT requests. */
+    QTimer*             m_pStreamTimer;         /**< Appends the streamed blocks. */
+};
+
+#endif // FTBUFFERSTANDIN_H
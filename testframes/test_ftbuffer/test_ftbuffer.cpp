@@ -0,0 +1,365 @@
+//=============================================================================================================
+/**
+ * @file     test_ftbuffer.cpp
+ * @author   agent <agent@local>
+ * @since    0.1.9
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, agent. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    Test for the FieldTrip buffer client.
+ *
+ */
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include <utils/generics/applicationlogger.h>
+
+#include "ftconnector.h"
+#include "ftbufferstandin.h"
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QtTest>
+#include <QThread>
+#include <QElapsedTimer>
+
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace FTBUFFERPLUGIN;
+using namespace Eigen;
+
+//=============================================================================================================
+/**
+ * DECLARE CLASS TestFtBuffer
+ *
+ * @brief The TestFtBuffer class tests the FieldTrip buffer client against a local stand-in server
+ *
+ */
+class TestFtBuffer: public QObject
+{
+    Q_OBJECT
+
+public:
+    TestFtBuffer();
+
+private slots:
+    void initTestCase();
+    void readHeader();
+    void readHeaderWhileWaitPending();
+    void recoverFromTruncatedAnswer();
+    void streamFloat32();
+    void streamInt16();
+    void throughput();
+    void cleanupTestCase();
+
+private:
+    //=========================================================================================================
+    /**
+     * Creates a stand-in server in the server thread and starts listening on a free local port.
+     */
+    FtBufferStandIn* startStandIn(int iNumChannels,
+                                  qint32 iDataType);
+
+    //=========================================================================================================
+    /**
+     * Streams small blocks in real time and verifies that every sample arrives once, in order and unaltered.
+     * Reports the latency between appending a block to the stand-in and receiving it with the FtConnector.
+     */
+    void streamAndVerify(qint32 iDataType);
+
+    //=========================================================================================================
+    /**
+     * @return The expected values of the samples [iFirstSample, iFirstSample + iNumSamples).
+     */
+    MatrixXd expectedData(int iNumChannels,
+                          int iFirstSample,
+                          int iNumSamples);
+
+    QThread     m_serverThread;
+    int         m_iNumChannels;
+    float       m_fSampleFreq;
+};
+
+//=============================================================================================================
+
+TestFtBuffer::TestFtBuffer()
+: m_iNumChannels(32)
+, m_fSampleFreq(1000.0f)
+{
+}
+
+//=============================================================================================================
+
+void TestFtBuffer::initTestCase()
+{
+    qInstallMessageHandler(UTILSLIB::ApplicationLogger::customLogWriter);
+
+    m_serverThread.start();
+}
+
+//=============================================================================================================
+
+void TestFtBuffer::readHeader()
+{
+    FtBufferStandIn* pStandIn = startStandIn(m_iNumChannels, DATATYPE_FLOAT32);
+    QMetaObject::invokeMethod(pStandIn, [pStandIn]() { pStandIn->putSamples(123); }, Qt::BlockingQueuedConnection);
+
+    FtConnector connector;
+    connector.setPort(pStandIn->serverPort());
+    QVERIFY(connector.connect());
+
+    FIFFLIB::FiffInfo info = connector.parseExtenedHeaders();
+    QCOMPARE(info.nchan, m_iNumChannels);
+    QCOMPARE(static_cast<float>(info.sfreq), m_fSampleFreq);
+    QCOMPARE(connector.getBufferInfo().iDataType, DATATYPE_FLOAT32);
+
+    connector.catchUpToBuffer();
+    QCOMPARE(connector.getBufferInfo().iNumSamples, 123);
+
+    connector.disconnect();
+    pStandIn->deleteLater();
+}
+
+//=============================================================================================================
+
+void TestFtBuffer::readHeaderWhileWaitPending()
+{
+    FtBufferStandIn* pStandIn = startStandIn(m_iNumChannels, DATATYPE_FLOAT32);
+    QMetaObject::invokeMethod(pStandIn, [pStandIn]() { pStandIn->putSamples(50); }, Qt::BlockingQueuedConnection);
+
+    FtConnector connector;
+    connector.setPort(pStandIn->serverPort());
+    QVERIFY(connector.connect());
+    QVERIFY(connector.getHeader());
+
+    // getData leaves the WAIT_DAT for the next block pending
+    QVERIFY(connector.getData());
+    QVERIFY(connector.getMatrix() == expectedData(m_iNumChannels, 0, 50));
+    connector.resetEmitData();
+
+    // The answer to the pending WAIT_DAT must not be taken for the header
+    QVERIFY(connector.getHeader());
+    QCOMPARE(connector.getBufferInfo().iNumChannels, m_iNumChannels);
+    QCOMPARE(connector.getBufferInfo().iNumNewSamples, 50);
+
+    QMetaObject::invokeMethod(pStandIn, [pStandIn]() { pStandIn->putSamples(20); }, Qt::BlockingQueuedConnection);
+
+    QVERIFY(connector.getData());
+    QVERIFY(connector.getMatrix() == expectedData(m_iNumChannels, 50, 20));
+
+    connector.disconnect();
+    pStandIn->deleteLater();
+}
+
+//=============================================================================================================
+
+void TestFtBuffer::recoverFromTruncatedAnswer()
+{
+    FtBufferStandIn* pStandIn = startStandIn(m_iNumChannels, DATATYPE_FLOAT32);
+    QMetaObject::invokeMethod(pStandIn, [pStandIn]() { pStandIn->putSamples(30); }, Qt::BlockingQueuedConnection);
+
+    FtConnector connector;
+    connector.setPort(pStandIn->serverPort());
+    QVERIFY(connector.connect());
+
+    // The header answer stalls after its message definition, the connector times out and reconnects
+    QMetaObject::invokeMethod(pStandIn, [pStandIn]() { pStandIn->truncateNextResponse(); }, Qt::BlockingQueuedConnection);
+    QVERIFY(!connector.getHeader());
+
+    // Later answers belong to later requests again
+    QVERIFY(connector.getHeader());
+    QCOMPARE(connector.getBufferInfo().iNumNewSamples, 30);
+
+    connector.catchUpToBuffer();
+    QCOMPARE(connector.getBufferInfo().iNumSamples, 30);
+
+    QMetaObject::invokeMethod(pStandIn, [pStandIn]() { pStandIn->putSamples(10); }, Qt::BlockingQueuedConnection);
+
+    QVERIFY(connector.getData());
+    QVERIFY(connector.getMatrix() == expectedData(m_iNumChannels, 30, 10));
+
+    connector.disconnect();
+    pStandIn->deleteLater();
+}
+
+//=============================================================================================================
+
+void TestFtBuffer::streamFloat32()
+{
+    streamAndVerify(DATATYPE_FLOAT32);
+}
+
+//=============================================================================================================
+
+void TestFtBuffer::streamInt16()
+{
+    streamAndVerify(DATATYPE_INT16);
+}
+
+//=============================================================================================================
+
+void TestFtBuffer::throughput()
+{
+    const int iNumChannels = 306;
+    const int iNumSamples = 30000;
+
+    FtBufferStandIn* pStandIn = startStandIn(iNumChannels, DATATYPE_FLOAT32);
+    QMetaObject::invokeMethod(pStandIn, [=]() { pStandIn->putSamples(iNumSamples); }, Qt::BlockingQueuedConnection);
+
+    FtConnector connector;
+    connector.setPort(pStandIn->serverPort());
+    QVERIFY(connector.connect());
+    QVERIFY(connector.getHeader());
+
+    QElapsedTimer timer;
+    timer.start();
+    QVERIFY(connector.getData());
+    qint64 iElapsed = timer.nsecsElapsed();
+
+    QCOMPARE(connector.getMatrix().rows(), static_cast<Index>(iNumChannels));
+    QCOMPARE(connector.getMatrix().cols(), static_cast<Index>(iNumSamples));
+    QVERIFY(connector.getMatrix() == expectedData(iNumChannels, 0, iNumSamples));
+
+    double dMegaBytes = iNumChannels * iNumSamples * sizeof(float) / 1.0e6;
+    qInfo() << "[TestFtBuffer::throughput]" << dMegaBytes << "MB in" << iElapsed / 1.0e6 << "ms,"
+            << dMegaBytes / (iElapsed / 1.0e9) << "MB/s";
+
+    connector.disconnect();
+    pStandIn->deleteLater();
+}
+
+//=============================================================================================================
+
+void TestFtBuffer::cleanupTestCase()
+{
+    m_serverThread.quit();
+    m_serverThread.wait();
+}
+
+//=============================================================================================================
+
+FtBufferStandIn* TestFtBuffer::startStandIn(int iNumChannels,
+                                            qint32 iDataType)
+{
+    FtBufferStandIn* pStandIn = new FtBufferStandIn(iNumChannels, m_fSampleFreq, iDataType);
+    pStandIn->moveToThread(&m_serverThread);
+
+    bool bListening = false;
+    QMetaObject::invokeMethod(pStandIn, [pStandIn, &bListening]() {
+        bListening = pStandIn->listen(QHostAddress::LocalHost, 0);
+    }, Qt::BlockingQueuedConnection);
+
+    if(!bListening) {
+        qWarning() << "[TestFtBuffer::startStandIn] Could not start stand-in server.";
+    }
+
+    return pStandIn;
+}
+
+//=============================================================================================================
+
+void TestFtBuffer::streamAndVerify(qint32 iDataType)
+{
+    const int iBlockSize = 10;
+    const int iIntervalMsec = 10;
+    const int iTotalSamples = 2000;
+
+    FtBufferStandIn* pStandIn = startStandIn(m_iNumChannels, iDataType);
+
+    FtConnector connector;
+    connector.setPort(pStandIn->serverPort());
+    QVERIFY(connector.connect());
+    QVERIFY(connector.getHeader());
+    connector.catchUpToBuffer();
+
+    QMetaObject::invokeMethod(pStandIn, [=]() {
+        pStandIn->startStreaming(iBlockSize, iIntervalMsec, iTotalSamples);
+    }, Qt::QueuedConnection);
+
+    int iReceived = 0;
+    int iNumBlocks = 0;
+    qint64 iLatencySum = 0;
+    qint64 iLatencyMax = 0;
+
+    QElapsedTimer timeout;
+    timeout.start();
+
+    while(iReceived < iTotalSamples && timeout.elapsed() < 30000) {
+        if(!connector.getData()) {
+            continue;
+        }
+
+        const MatrixXd& matData = connector.getMatrix();
+        qint64 iLatency = pStandIn->clockNsecs() - pStandIn->appendTime(iReceived + matData.cols() - 1);
+
+        QCOMPARE(matData.rows(), static_cast<Index>(m_iNumChannels));
+        QVERIFY(matData == expectedData(m_iNumChannels, iReceived, matData.cols()));
+
+        iReceived += matData.cols();
+        iLatencySum += iLatency;
+        iLatencyMax = qMax(iLatencyMax, iLatency);
+        iNumBlocks++;
+
+        connector.resetEmitData();
+    }
+
+    QCOMPARE(iReceived, iTotalSamples);
+
+    qInfo() << "[TestFtBuffer::streamAndVerify] Data type" << iDataType << ":" << iNumBlocks << "blocks, latency mean"
+            << iLatencySum / iNumBlocks / 1.0e6 << "ms, max" << iLatencyMax / 1.0e6 << "ms";
+
+    connector.disconnect();
+    pStandIn->deleteLater();
+}
+
+//=============================================================================================================
+
+MatrixXd TestFtBuffer::expectedData(int iNumChannels,
+                                    int iFirstSample,
+                                    int iNumSamples)
+{
+    MatrixXd matData(iNumChannels, iNumSamples);
+
+    for(int s = 0; s < iNumSamples; ++s) {
+        for(int c = 0; c < iNumChannels; ++c) {
+            matData(c, s) = FtBufferStandIn::sampleValue(c, iFirstSample + s);
+        }
+    }
+
+    return matData;
+}
+
+//=============================================================================================================
+// MAIN
+//=============================================================================================================
+
+QTEST_GUILESS_MAIN(TestFtBuffer)
+#include "test_ftbuffer.moc"
@@ -65,6 +65,7 @@ using namespace DISP3DLIB;
 using namespace MNELIB;
 using namespace Eigen;
 using namespace FIFFLIB;
+using namespace UTILSLIB;
 
 //=============================================================================================================
 /**
@@ -86,6 +87,8 @@ private slots:
     void testEmptyInputsForProjecting();
     void testEmptyInputsForSCDC();
     void testDimensionsForSCDC();
+    void testMeshAdjacency();
+    void testSparseSCDC();
     void cleanupTestCase();
 
 private:
@@ -204,6 +207,71 @@ void TestGeometryInfo::testDimensionsForSCDC() {
 
 //=============================================================================================================
 
+void TestGeometryInfo::testMeshAdjacency() {
+    // neighbor lists as they were built before the CSR adjacency
+    QVector<QVector<int> > vNeighborTri(realSurface.np);
+    for (int p = 0; p < realSurface.tris.rows(); ++p) {
+        for (int k = 0; k < 3; ++k) {
+            vNeighborTri[realSurface.tris(p, k)].append(p);
+        }
+    }
+    QVector<QVector<int> > vNeighborVert(realSurface.np);
+    for (int k = 0; k < realSurface.np; ++k) {
+        for (int p : vNeighborTri[k]) {
+            for (int c = 0; c < 3; ++c) {
+                int vert = realSurface.tris(p, c);
+                if (vert != k && !vNeighborVert[k].contains(vert)) {
+                    vNeighborVert[k].append(vert);
+                }
+            }
+        }
+    }
+
+    MeshAdjacency adjacency(realSurface.tris, realSurface.np);
+    QVERIFY(adjacency.numVertices() == realSurface.np);
+    QVERIFY(adjacency.toNeighborTri() == vNeighborTri);
+    QVERIFY(adjacency.toNeighborVert() == vNeighborVert);
+    QVERIFY(realSurface.neighbor_vert == vNeighborVert);
+    QVERIFY(realSurface.adjacency.vertIndices() == adjacency.vertIndices());
+
+    // distances on the CSR adjacency and on the per vertex lists
+    QVector<int> vSubset = QVector<int>() << 0 << 17 << realSurface.np - 1;
+    QSharedPointer<MatrixXd> pDistCsr = GeometryInfo::scdc(realSurface.rr, adjacency, vSubset, 0.05);
+    QSharedPointer<MatrixXd> pDistLists = GeometryInfo::scdc(realSurface.rr, vNeighborVert, vSubset, 0.05);
+    QVERIFY(*pDistCsr == *pDistLists);
+}
+
+//=============================================================================================================
+
+void TestGeometryInfo::testSparseSCDC()
+{
+    const double dCancelDist = 0.05;
+    QVector<int> vSubset;
+    for(int i = 0; i < realSurface.np; i += 50) {
+        vSubset.push_back(i);
+    }
+
+    QSharedPointer<MatrixXd> pDistDense = GeometryInfo::scdc(realSurface.rr, realSurface.neighbor_vert, vSubset, dCancelDist);
+    QSharedPointer<SparseMatrix<double> > pDistSparse = GeometryInfo::scdcSparse(realSurface.rr, realSurface.neighbor_vert, vSubset, dCancelDist);
+
+    QCOMPARE(pDistSparse->rows(), pDistDense->rows());
+    QCOMPARE(pDistSparse->cols(), pDistDense->cols());
+
+    // the sparse table holds exactly the dense entries inside the cancel distance
+    Index iNumInside = 0;
+    for(Index c = 0; c < pDistDense->cols(); ++c) {
+        for(Index r = 0; r < pDistDense->rows(); ++r) {
+            if((*pDistDense)(r, c) <= dCancelDist) {
+                ++iNumInside;
+                QCOMPARE(pDistSparse->coeff(r, c), (*pDistDense)(r, c));
+            }
+        }
+    }
+    QCOMPARE(static_cast<Index>(pDistSparse->nonZeros()), iNumInside);
+}
+
+//=============================================================================================================
+
 void TestGeometryInfo::cleanupTestCase() {
 }
 
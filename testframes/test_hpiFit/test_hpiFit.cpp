@@ -48,6 +48,7 @@
 
 #include <inverse/hpiFit/hpifit.h>
 #include <inverse/hpiFit/hpifitdata.h>
+#include <inverse/hpiFit/hpifitcontinuous.h>
 
 #include <utils/ioutils.h>
 #include <utils/mnemath.h>
@@ -98,6 +99,7 @@ private slots:
     void compareMove();
     void compareDetect();
     void compareTime();
+    void compareContinuous();
     void cleanupTestCase();
 
 private:
@@ -110,6 +112,7 @@ private:
     MatrixXd mHpiPos;
     MatrixXd mRefResult;
     MatrixXd mHpiResult;
+    MatrixXd mContinuousPos;
     QVector<int> vFreqs;
 };
 
@@ -230,6 +233,15 @@ void TestHpiFit::initTestCase()
         mHpiResult(i,1) = devHeadT.angleTo(pFiffInfo->dev_head_t.trans);
 
     }
+
+    // Fit the same windows with the parallel offline fit, seeded with the initial dev_head_t
+    QSharedPointer<FiffInfo> pFiffInfoContinuous = QSharedPointer<FiffInfo>(new FiffInfo(raw.info));
+    pFiffInfoContinuous->dev_head_t = devHeadT;
+    HPIFitContinuous hpiContinuous(pFiffInfoContinuous, true);
+    hpiContinuous.setWindow(quantum_sec, quantum_sec);
+    hpiContinuous.setAbortCriteria(200, 1e-5);
+    mContinuousPos = hpiContinuous.fit(raw, vFreqs, mProjectors, mRefPos.col(0).transpose().cast<float>());
+
     // For debug: position file for HPIFit
 //    UTILSLIB::IOUtils::write_eigen_matrix(mHpiPos, QCoreApplication::applicationDirPath() + "/MNE-sample-data/mHpiPos.txt");
 }
@@ -321,6 +333,22 @@ void TestHpiFit::compareTime()
 
 //=============================================================================================================
 
+void TestHpiFit::compareContinuous()
+{
+    QCOMPARE(mContinuousPos.rows(), mRefPos.rows());
+
+    for(int i = 1; i < 7; ++i) {
+        const double dDiff = std::abs((mRefPos.col(i)-mContinuousPos.col(i)).mean());
+        qDebug() << "ErrorContinuous col" << i << ":" << dDiff;
+        QVERIFY(dDiff < (i < 4 ? dErrorQuat : dErrorTrans));
+    }
+
+    MatrixXd mDiff = mRefPos.col(0)-mContinuousPos.col(0);
+    QVERIFY(std::abs(mDiff.mean()) < dErrorTime);
+}
+
+//=============================================================================================================
+
 void TestHpiFit::cleanupTestCase()
 {
 }
@@ -56,6 +56,7 @@
 //=============================================================================================================
 
 #include <QtTest>
+#include <QElapsedTimer>
 
 //=============================================================================================================
 // USED NAMESPACES
@@ -85,6 +86,7 @@ private slots:
     void testDimensionsForInterpolation();
     void testSumOfRow();
     void testEmptyInputsForWeightMatrix();
+    void testSparseInterpolationMat();
     void cleanupTestCase();
 
 private:
@@ -248,6 +250,62 @@ void TestInterpolation::testEmptyInputsForWeightMatrix()
 
 //=============================================================================================================
 
+void TestInterpolation::testSparseInterpolationMat()
+{
+    const double dCancelDist = 0.05;
+    QVector<int> vMappedSubSet = GeometryInfo::projectSensors(realSurface.rr,
+                                                              vMegSensors);
+
+    // bad channels, same ordering as used by filterBadChannels
+    QVector<int> vExcludeIndex;
+    int iCounter = 0;
+    for(const FiffChInfo &info : evoked.info.chs) {
+        if(info.kind == FIFFV_MEG_CH && (info.unit == FIFF_UNIT_T || info.unit == FIFF_UNIT_V)) {
+            if(evoked.info.bads.contains(info.ch_name)) {
+                vExcludeIndex.push_back(iCounter);
+            }
+            iCounter++;
+        }
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    QSharedPointer<MatrixXd> pDistDense = GeometryInfo::scdc(realSurface.rr,
+                                                             realSurface.neighbor_vert,
+                                                             vMappedSubSet,
+                                                             dCancelDist);
+    GeometryInfo::filterBadChannels(pDistDense,
+                                    evoked.info,
+                                    FIFFV_MEG_CH);
+    QSharedPointer<SparseMatrix<float> > pWDense = Interpolation::createInterpolationMat(vMappedSubSet,
+                                                                                       pDistDense,
+                                                                                       Interpolation::cubic,
+                                                                                       dCancelDist,
+                                                                                       vExcludeIndex);
+    qint64 iTimeDense = timer.restart();
+
+    QSharedPointer<SparseMatrix<double> > pDistSparse = GeometryInfo::scdcSparse(realSurface.rr,
+                                                                                 realSurface.neighbor_vert,
+                                                                                 vMappedSubSet,
+                                                                                 dCancelDist);
+    QSharedPointer<SparseMatrix<float> > pWSparse = Interpolation::createInterpolationMat(vMappedSubSet,
+                                                                                        pDistSparse,
+                                                                                        Interpolation::cubic,
+                                                                                        dCancelDist,
+                                                                                        vExcludeIndex);
+    qint64 iTimeSparse = timer.elapsed();
+
+    qInfo() << "[TestInterpolation::testSparseInterpolationMat] Dense" << iTimeDense << "ms, sparse" << iTimeSparse << "ms";
+
+    // both paths must yield the very same weights
+    QCOMPARE(pWSparse->rows(), pWDense->rows());
+    QCOMPARE(pWSparse->cols(), pWDense->cols());
+    QCOMPARE(pWSparse->nonZeros(), pWDense->nonZeros());
+    QVERIFY(SparseMatrix<float>(*pWSparse - *pWDense).norm() == 0.0f);
+}
+
+//=============================================================================================================
+
 void TestInterpolation::cleanupTestCase()
 {
 }
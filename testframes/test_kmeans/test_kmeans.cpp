@@ -0,0 +1,255 @@
+//=============================================================================================================
+/**
+ * @file     test_kmeans.cpp
+ * @author   agent <agent@local>
+ * @since    0.1.9
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, agent. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    Tests the KMeans clustering.
+ *
+ */
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include <utils/kmeans.h>
+#include <utils/generics/applicationlogger.h>
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QtTest>
+
+//=============================================================================================================
+// EIGEN INCLUDES
+//=============================================================================================================
+
+#include <Eigen/Dense>
+
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace UTILSLIB;
+using namespace Eigen;
+
+//=============================================================================================================
+/**
+ * DECLARE CLASS TestKMeans
+ *
+ * @brief The TestKMeans class checks the KMeans clustering on well separated synthetic clusters.
+ *
+ */
+class TestKMeans: public QObject
+{
+    Q_OBJECT
+
+public:
+    TestKMeans();
+
+private slots:
+    void initTestCase();
+    void recoverClusters();
+    void compareDistances();
+    void deterministicReplicates();
+    void cleanupTestCase();
+
+private:
+    //=========================================================================================================
+    /**
+     * Returns true if every true cluster is mapped onto exactly one label and vice versa.
+     */
+    bool isTrueClustering(const VectorXi& idx) const;
+
+    int iNumClusters;
+    int iNumPoints;
+    int iNumDims;
+    MatrixXd matX;
+    VectorXi vecLabels;
+};
+
+//=============================================================================================================
+
+TestKMeans::TestKMeans()
+: iNumClusters(6)
+, iNumPoints(600)
+, iNumDims(90)
+{
+}
+
+//=============================================================================================================
+
+void TestKMeans::initTestCase()
+{
+    qInstallMessageHandler(UTILSLIB::ApplicationLogger::customLogWriter);
+
+    std::srand(42);
+
+    // Cluster centers far apart compared to the spread of the points
+    MatrixXd matCenters = 10.0 * MatrixXd::Random(iNumClusters, iNumDims);
+
+    matX = 0.5 * MatrixXd::Random(iNumPoints, iNumDims);
+    vecLabels.resize(iNumPoints);
+    for(int i = 0; i < iNumPoints; ++i) {
+        vecLabels[i] = i % iNumClusters;
+        matX.row(i) += matCenters.row(vecLabels[i]);
+    }
+}
+
+//=============================================================================================================
+
+void TestKMeans::recoverClusters()
+{
+    QStringList lDistances = QStringList() << "sqeuclidean" << "cityblock" << "cosine";
+
+    for(const QString& sDistance : lDistances) {
+        KMeans kMeans(sDistance, QString("plus"), 3);
+
+        VectorXi idx;
+        MatrixXd C, D;
+        VectorXd sumD;
+        QVERIFY(kMeans.calculate(matX, iNumClusters, idx, C, sumD, D));
+
+        QCOMPARE(idx.size(), static_cast<Index>(iNumPoints));
+        QCOMPARE(C.rows(), static_cast<Index>(iNumClusters));
+        QCOMPARE(D.rows(), static_cast<Index>(iNumPoints));
+        QCOMPARE(D.cols(), static_cast<Index>(iNumClusters));
+        QVERIFY(isTrueClustering(idx));
+
+        // Every point ends up at its closest centroid
+        for(int i = 0; i < iNumPoints; ++i) {
+            QVERIFY(D(i, idx[i]) <= D.row(i).minCoeff() + 1e-10);
+        }
+    }
+}
+
+//=============================================================================================================
+
+void TestKMeans::compareDistances()
+{
+    QStringList lDistances = QStringList() << "sqeuclidean" << "cityblock" << "cosine";
+
+    for(const QString& sDistance : lDistances) {
+        KMeans kMeans(sDistance, QString("plus"), 1);
+
+        VectorXi idx;
+        MatrixXd C, D;
+        VectorXd sumD;
+        QVERIFY(kMeans.calculate(matX, iNumClusters, idx, C, sumD, D));
+
+        // Compare against the point to centroid distances computed one by one
+        double dMaxDiff = 0.0;
+        for(int i = 0; i < iNumPoints; ++i) {
+            for(int j = 0; j < iNumClusters; ++j) {
+                double dDist;
+                if(sDistance == "sqeuclidean") {
+                    dDist = (matX.row(i) - C.row(j)).squaredNorm();
+                } else if(sDistance == "cityblock") {
+                    dDist = (matX.row(i) - C.row(j)).cwiseAbs().sum();
+                } else {
+                    dDist = 1.0 - matX.row(i).normalized().dot(C.row(j).normalized());
+                }
+                dMaxDiff = std::max(dMaxDiff, std::abs(dDist - D(i,j)) / std::max(1.0, std::abs(dDist)));
+            }
+        }
+        QVERIFY(dMaxDiff < 1e-10);
+
+        VectorXd vecSumD = VectorXd::Zero(iNumClusters);
+        for(int i = 0; i < iNumPoints; ++i) {
+            vecSumD[idx[i]] += D(i, idx[i]);
+        }
+        QVERIFY((vecSumD - sumD).cwiseAbs().maxCoeff() < 1e-10 * std::max(1.0, sumD.sum()));
+    }
+}
+
+//=============================================================================================================
+
+void TestKMeans::deterministicReplicates()
+{
+    // More clusters than there are, so that the replicates end up in different local minima
+    KMeans kMeansFirst(QString("sqeuclidean"), QString("plus"), 4);
+    KMeans kMeansSecond(QString("sqeuclidean"), QString("plus"), 4);
+
+    VectorXi idxFirst, idxSecond;
+    MatrixXd CFirst, CSecond, DFirst, DSecond;
+    VectorXd sumDFirst, sumDSecond;
+    QVERIFY(kMeansFirst.calculate(matX, 2 * iNumClusters, idxFirst, CFirst, sumDFirst, DFirst));
+    QVERIFY(kMeansSecond.calculate(matX, 2 * iNumClusters, idxSecond, CSecond, sumDSecond, DSecond));
+
+    QVERIFY(idxFirst == idxSecond);
+    QVERIFY(CFirst == CSecond);
+
+    // The best replicate is never worse than any single replicate
+    for(quint32 iSeed = 0; iSeed < 4; ++iSeed) {
+        KMeans kMeansSingle(QString("sqeuclidean"), QString("plus"), 1);
+        kMeansSingle.setSeed(iSeed);
+
+        VectorXi idx;
+        MatrixXd C, D;
+        VectorXd sumD;
+        QVERIFY(kMeansSingle.calculate(matX, 2 * iNumClusters, idx, C, sumD, D));
+        QVERIFY(sumDFirst.sum() <= sumD.sum() + 1e-10);
+    }
+}
+
+//=============================================================================================================
+
+void TestKMeans::cleanupTestCase()
+{
+}
+
+//=============================================================================================================
+
+bool TestKMeans::isTrueClustering(const VectorXi& idx) const
+{
+    VectorXi vecMap = VectorXi::Constant(iNumClusters, -1);
+
+    for(int i = 0; i < iNumPoints; ++i) {
+        if(vecMap[vecLabels[i]] == -1) {
+            vecMap[vecLabels[i]] = idx[i];
+        } else if(vecMap[vecLabels[i]] != idx[i]) {
+            return false;
+        }
+    }
+
+    std::sort(vecMap.data(), vecMap.data() + vecMap.size());
+    for(int i = 0; i < iNumClusters; ++i) {
+        if(vecMap[i] != i) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+//=============================================================================================================
+// MAIN
+//=============================================================================================================
+
+QTEST_GUILESS_MAIN(TestKMeans)
+#include "test_kmeans.moc"
@@ -0,0 +1,298 @@
+//=============================================================================================================
+/**
+ * @file     test_mne_epoch_data_list.cpp
+ * @author   agent <agent@local>
+ * @since    0.1.9
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, agent. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    Test for the single sweep artifact scan of MNEEpochDataList against a per epoch check.
+ *
+ */
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include <utils/generics/applicationlogger.h>
+
+#include <fiff/fiff.h>
+
+#include <mne/mne_epoch_data_list.h>
+
+#include <algorithm>
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QtTest>
+
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace FIFFLIB;
+using namespace MNELIB;
+using namespace Eigen;
+
+//=============================================================================================================
+/**
+ * DECLARE CLASS TestMneEpochDataList
+ *
+ * @brief The TestMneEpochDataList class compares the single sweep artifact scan against a per epoch check
+ *
+ */
+class TestMneEpochDataList: public QObject
+{
+    Q_OBJECT
+
+public:
+    TestMneEpochDataList();
+
+private slots:
+    void initTestCase();
+    void compareScanForArtifacts();
+    void compareReadEpochs();
+    void cleanupTestCase();
+
+private:
+    //=========================================================================================================
+    /**
+     * Returns the rejection type (grad, mag, eeg or eog) of an info channel, an empty string if it has none.
+     */
+    QString rejectType(int iCh) const;
+
+    //=========================================================================================================
+    /**
+     * Reads one epoch on its own and returns the first picked channel exceeding its threshold, -1 if none did.
+     */
+    int checkEpoch(fiff_int_t from) const;
+
+    FiffRawData m_raw;
+    RowVectorXi m_vecPicks;
+    MatrixXi m_matEvents;
+    VectorXi m_vecFrom;
+    fiff_int_t m_iNumSamples;
+    float m_fTMin;
+    float m_fTMax;
+    QMap<QString,double> m_mapReject;
+    QVector<int> m_vecExpected;
+};
+
+//=============================================================================================================
+
+TestMneEpochDataList::TestMneEpochDataList()
+: m_iNumSamples(0)
+, m_fTMin(-0.1f)
+, m_fTMax(0.3f)
+{
+}
+
+//=============================================================================================================
+
+void TestMneEpochDataList::initTestCase()
+{
+    qInstallMessageHandler(UTILSLIB::ApplicationLogger::customLogWriter);
+
+    QFile t_fileIn(QCoreApplication::applicationDirPath() + "/mne-cpp-test-data/MEG/sample/sample_audvis_trunc_raw.fif");
+    m_raw = FiffRawData(t_fileIn);
+    QVERIFY(m_raw.info.chs.size() > 0);
+
+    m_vecPicks = m_raw.info.pick_types(true, true, false);
+
+    // Equally spaced events, half a second apart, which are all readable with the epoch window
+    fiff_int_t iStep = static_cast<fiff_int_t>(0.5 * m_raw.info.sfreq);
+    fiff_int_t iFirst = m_raw.first_samp + static_cast<fiff_int_t>(0.2 * m_raw.info.sfreq);
+    fiff_int_t iLast = m_raw.last_samp - static_cast<fiff_int_t>(0.4 * m_raw.info.sfreq);
+    int iNumEvents = (iLast - iFirst) / iStep + 1;
+    QVERIFY(iNumEvents >= 4);
+
+    m_matEvents = MatrixXi::Zero(iNumEvents, 3);
+    m_vecFrom.resize(iNumEvents);
+
+    for(int i = 0; i < iNumEvents; ++i) {
+        m_matEvents(i,0) = iFirst + i * iStep;
+        m_matEvents(i,2) = 1;
+
+        // Same window as MNEEpochDataList::readEpochs
+        m_vecFrom[i] = m_matEvents(i,0) + m_fTMin * m_raw.info.sfreq;
+        fiff_int_t to = m_matEvents(i,0) + floor(m_fTMax * m_raw.info.sfreq + 0.5);
+        m_iNumSamples = to - m_vecFrom[i] + 1;
+    }
+
+    // Pick the thresholds from the data, so that about half of the epochs exceed the gradiometer threshold and
+    // some more the EEG one
+    QVector<double> vecMaxGrad(iNumEvents, 0.0);
+    QVector<double> vecMaxEeg(iNumEvents, 0.0);
+    MatrixXd matData, matTimes;
+
+    for(int i = 0; i < iNumEvents; ++i) {
+        QVERIFY(m_raw.read_raw_segment(matData, matTimes, m_vecFrom[i], m_vecFrom[i] + m_iNumSamples - 1, m_vecPicks));
+
+        for(int j = 0; j < m_vecPicks.size(); ++j) {
+            if(m_raw.info.bads.contains(m_raw.info.chs.at(m_vecPicks[j]).ch_name)) {
+                continue;
+            }
+
+            double dPP = matData.row(j).maxCoeff() - matData.row(j).minCoeff();
+            QString sType = rejectType(m_vecPicks[j]);
+
+            if(sType == "grad") {
+                vecMaxGrad[i] = std::max(vecMaxGrad[i], dPP);
+            } else if(sType == "eeg") {
+                vecMaxEeg[i] = std::max(vecMaxEeg[i], dPP);
+            }
+        }
+    }
+
+    std::sort(vecMaxGrad.begin(), vecMaxGrad.end());
+    std::sort(vecMaxEeg.begin(), vecMaxEeg.end());
+    m_mapReject.insert("grad", vecMaxGrad[iNumEvents / 2]);
+    m_mapReject.insert("eeg", vecMaxEeg[(3 * iNumEvents) / 4]);
+
+    // The expected rejections, every epoch read and checked on its own
+    int iNumRejected = 0;
+    for(int i = 0; i < iNumEvents; ++i) {
+        m_vecExpected.append(checkEpoch(m_vecFrom[i]));
+        if(m_vecExpected.last() >= 0) {
+            ++iNumRejected;
+        }
+    }
+
+    qInfo() << "[TestMneEpochDataList::initTestCase]" << iNumRejected << "of" << iNumEvents << "epochs expected to be rejected.";
+
+    QVERIFY(iNumRejected > 0);
+    QVERIFY(iNumRejected < iNumEvents);
+}
+
+//=============================================================================================================
+
+void TestMneEpochDataList::compareScanForArtifacts()
+{
+    MatrixXd matEpochs;
+    QVERIFY(m_raw.read_raw_segments(matEpochs, m_vecFrom, m_iNumSamples, m_vecPicks));
+
+    QVector<int> vecRejectedCh = MNEEpochDataList::scanForArtifacts(matEpochs,
+                                                                    m_iNumSamples,
+                                                                    m_raw.info,
+                                                                    m_mapReject,
+                                                                    QStringList(),
+                                                                    m_vecPicks);
+
+    // Same epochs rejected, each by the same channel
+    QCOMPARE(vecRejectedCh, m_vecExpected);
+}
+
+//=============================================================================================================
+
+void TestMneEpochDataList::compareReadEpochs()
+{
+    MNEEpochDataList epochs = MNEEpochDataList::readEpochs(m_raw,
+                                                           m_matEvents,
+                                                           m_fTMin,
+                                                           m_fTMax,
+                                                           1,
+                                                           m_mapReject,
+                                                           QStringList(),
+                                                           m_vecPicks);
+
+    QCOMPARE(epochs.size(), m_vecExpected.size());
+
+    MatrixXd matData, matTimes;
+
+    for(int i = 0; i < epochs.size(); ++i) {
+        QCOMPARE(epochs.at(i)->bReject, m_vecExpected[i] >= 0);
+
+        QVERIFY(m_raw.read_raw_segment(matData, matTimes, m_vecFrom[i], m_vecFrom[i] + m_iNumSamples - 1, m_vecPicks));
+        QCOMPARE(epochs.at(i)->epoch.cols(), matData.cols());
+        QVERIFY(epochs.at(i)->epoch.isApprox(matData));
+    }
+}
+
+//=============================================================================================================
+
+void TestMneEpochDataList::cleanupTestCase()
+{
+}
+
+//=============================================================================================================
+
+QString TestMneEpochDataList::rejectType(int iCh) const
+{
+    const FiffChInfo& chInfo = m_raw.info.chs.at(iCh);
+
+    switch (chInfo.kind) {
+    case FIFFV_MEG_CH:
+        if(chInfo.unit == FIFF_UNIT_T) {
+            return "mag";
+        } else if(chInfo.unit == FIFF_UNIT_T_M) {
+            return "grad";
+        }
+    break;
+
+    case FIFFV_EEG_CH:
+        return "eeg";
+
+    case FIFFV_EOG_CH:
+        return "eog";
+    }
+
+    return QString();
+}
+
+//=============================================================================================================
+
+int TestMneEpochDataList::checkEpoch(fiff_int_t from) const
+{
+    MatrixXd matData, matTimes;
+    if(!m_raw.read_raw_segment(matData, matTimes, from, from + m_iNumSamples - 1, m_vecPicks)) {
+        qWarning("[TestMneEpochDataList::checkEpoch] Can't read the data segment starting at %d.", from);
+        return -1;
+    }
+
+    // The picks are sorted, so the first exceeding row is the first exceeding info channel
+    for(int j = 0; j < m_vecPicks.size(); ++j) {
+        int iCh = m_vecPicks[j];
+        QString sType = rejectType(iCh);
+
+        if(m_raw.info.bads.contains(m_raw.info.chs.at(iCh).ch_name) || !m_mapReject.contains(sType)) {
+            continue;
+        }
+
+        if(matData.row(j).maxCoeff() - matData.row(j).minCoeff() > m_mapReject.value(sType)) {
+            return iCh;
+        }
+    }
+
+    return -1;
+}
+
+//=============================================================================================================
+// MAIN
+//=============================================================================================================
+
+QTEST_GUILESS_MAIN(TestMneEpochDataList)
+#include "test_mne_epoch_data_list.moc"
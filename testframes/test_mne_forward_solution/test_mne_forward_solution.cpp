@@ -53,6 +53,13 @@
 //=============================================================================================================
 
 #include <QtTest>
+#include <QElapsedTimer>
+
+//=============================================================================================================
+// EIGEN INCLUDES
+//=============================================================================================================
+
+#include <Eigen/Geometry>
 
 //=============================================================================================================
 // USED NAMESPACES
@@ -79,9 +86,12 @@ private slots:
     void initTestCase();
     void computeForward();
     void compareForward();
+    void updateHeadPosIncremental();
     void cleanupTestCase();
 
 private:
+    ComputeFwdSettings::SPtr createMegSettings() const;
+
     double dEpsilon;
 
     QSharedPointer<MNEForwardSolution> m_pFwdMEGEEGRead;
@@ -186,6 +196,103 @@ void TestMneForwardSolution::compareForward()
 
 //=============================================================================================================
 
+void TestMneForwardSolution::updateHeadPosIncremental()
+{
+    printf(">>>>>>>>>>>>>>>>>>>>>>>>> Incremental MEG Forward Update >>>>>>>>>>>>>>>>>>>>>>>>>\n");
+
+    ComputeFwdSettings::SPtr pSettingsFull = createMegSettings();
+    ComputeFwdSettings::SPtr pSettingsInc = createMegSettings();
+    pSettingsInc->incremental_update = true;
+    pSettingsInc->incremental_tol = 0.0f;
+
+    QSharedPointer<ComputeFwd> pFwdFull = QSharedPointer<ComputeFwd>(new ComputeFwd(pSettingsFull));
+    pFwdFull->calculateFwd();
+    QSharedPointer<ComputeFwd> pFwdInc = QSharedPointer<ComputeFwd>(new ComputeFwd(pSettingsInc));
+    pFwdInc->calculateFwd();
+
+    // Simulated head poses: small rotations (deg) about different axes combined with translations (m)
+    QList<QPair<Eigen::Vector4f, Eigen::Vector3f> > lPoses;
+    lPoses << qMakePair(Eigen::Vector4f(0.5f, 0.0f, 0.0f, 1.0f), Eigen::Vector3f(0.001f, 0.0f, 0.0f));
+    lPoses << qMakePair(Eigen::Vector4f(1.0f, 0.0f, 1.0f, 0.0f), Eigen::Vector3f(0.0f, 0.002f, 0.0f));
+    lPoses << qMakePair(Eigen::Vector4f(2.0f, 1.0f, 0.0f, 0.0f), Eigen::Vector3f(0.0f, 0.0f, -0.003f));
+    lPoses << qMakePair(Eigen::Vector4f(1.5f, 1.0f, 1.0f, 1.0f), Eigen::Vector3f(-0.002f, 0.001f, 0.004f));
+    lPoses << qMakePair(Eigen::Vector4f(0.0f, 0.0f, 0.0f, 1.0f), Eigen::Vector3f(0.0f, 0.0f, 0.0f));
+
+    const FIFFLIB::FiffCoordTransOld meg_head_t = pSettingsFull->pFiffInfo->dev_head_t.toOld();
+    QElapsedTimer timer;
+
+    for(int i = 0; i < lPoses.size(); ++i) {
+        FIFFLIB::FiffCoordTransOld transPose(meg_head_t);
+        Eigen::Vector3f vecAxis = lPoses.at(i).first.tail(3).normalized();
+        Eigen::Matrix3f matRot = Eigen::AngleAxisf(lPoses.at(i).first(0) * float(M_PI) / 180.0f, vecAxis).toRotationMatrix();
+        transPose.rot = matRot * meg_head_t.rot;
+        transPose.move = meg_head_t.move + lPoses.at(i).second;
+        FIFFLIB::FiffCoordTransOld::add_inverse(&transPose);
+
+        timer.start();
+        pFwdFull->updateHeadPos(&transPose);
+        qint64 iTimeFull = timer.nsecsElapsed();
+
+        timer.start();
+        pFwdInc->updateHeadPos(&transPose);
+        qint64 iTimeInc = timer.nsecsElapsed();
+
+        double dRelErr = (pFwdInc->sol->data - pFwdFull->sol->data).norm() / pFwdFull->sol->data.norm();
+
+        qInfo() << "[TestMneForwardSolution::updateHeadPosIncremental] Pose" << i
+                << "- full update" << iTimeFull / 1000000.0 << "ms,"
+                << "incremental update" << iTimeInc / 1000000.0 << "ms,"
+                << "relative difference" << dRelErr;
+
+        QVERIFY(dRelErr < 1e-6);
+    }
+
+    // A motion below the tolerance keeps the previous rows
+    pSettingsInc->incremental_tol = 0.0001f;
+    Eigen::MatrixXd matPrevious = pFwdInc->sol->data;
+
+    FIFFLIB::FiffCoordTransOld transTiny(meg_head_t);
+    transTiny.move += Eigen::Vector3f(0.00001f, 0.0f, 0.0f);
+    FIFFLIB::FiffCoordTransOld::add_inverse(&transTiny);
+
+    timer.start();
+    pFwdInc->updateHeadPos(&transTiny);
+    qInfo() << "[TestMneForwardSolution::updateHeadPosIncremental] Sub-tolerance pose - incremental update" << timer.nsecsElapsed() / 1000000.0 << "ms";
+
+    pFwdFull->updateHeadPos(&transTiny);
+
+    QVERIFY(pFwdInc->sol->data == matPrevious);
+    QVERIFY((pFwdInc->sol->data - pFwdFull->sol->data).norm() / pFwdFull->sol->data.norm() < 1e-3);
+
+    printf("<<<<<<<<<<<<<<<<<<<<<<<<< Incremental MEG Forward Update Finished <<<<<<<<<<<<<<<<<<<<<<<<<\n");
+}
+
+//=============================================================================================================
+
+ComputeFwdSettings::SPtr TestMneForwardSolution::createMegSettings() const
+{
+    ComputeFwdSettings::SPtr pSettings = ComputeFwdSettings::SPtr(new ComputeFwdSettings);
+
+    pSettings->include_meg = true;
+    pSettings->include_eeg = false;
+    pSettings->accurate = true;
+    pSettings->srcname = QCoreApplication::applicationDirPath() + "/mne-cpp-test-data/subjects/sample/bem/sample-oct-6-src.fif";
+    pSettings->measname = QCoreApplication::applicationDirPath() + "/mne-cpp-test-data/MEG/sample/sample_audvis_trunc_raw.fif";
+    pSettings->mriname = QCoreApplication::applicationDirPath() + "/mne-cpp-test-data/MEG/sample/all-trans.fif";
+    pSettings->transname.clear();
+    pSettings->bemname = QCoreApplication::applicationDirPath() + "/mne-cpp-test-data/subjects/sample/bem/sample-1280-1280-1280-bem.fif";
+    pSettings->mindist = 5.0f/1000.0f;
+
+    QFile t_name(pSettings->measname);
+    FIFFLIB::FiffRawData raw(t_name);
+    pSettings->pFiffInfo = QSharedPointer<FIFFLIB::FiffInfo>(new FIFFLIB::FiffInfo(raw.info));
+    pSettings->checkIntegrity();
+
+    return pSettings;
+}
+
+//=============================================================================================================
+
 void TestMneForwardSolution::cleanupTestCase()
 {
 }
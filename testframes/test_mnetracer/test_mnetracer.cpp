@@ -0,0 +1,271 @@
+//=============================================================================================================
+/**
+ * @file     test_mnetracer.cpp
+ * @author   agent <agent@local>
+ * @since    0.1.9
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, agent. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    Test for the per thread event buffers of the MNETracer and their flushing.
+ *
+ */
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include <utils/generics/applicationlogger.h>
+#include <utils/mnetracer.h>
+
+#include <thread>
+#include <vector>
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QtTest>
+#include <QTemporaryDir>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QSet>
+
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace UTILSLIB;
+
+//=============================================================================================================
+/**
+ * DECLARE CLASS TestMNETracer
+ *
+ * @brief The TestMNETracer class tests the per thread event buffers of the MNETracer and their flushing.
+ *
+ */
+class TestMNETracer: public QObject
+{
+    Q_OBJECT
+
+public:
+    TestMNETracer();
+
+private slots:
+    void initTestCase();
+    void dropWhenBufferFull();
+    void flushAllThreads();
+    void restartConcurrently();
+    void cleanupTestCase();
+
+private:
+    //=========================================================================================================
+    /**
+     * Reads the trace file and returns its events, an empty array if it is no valid trace.
+     */
+    QJsonArray readEvents(const QString& sFileName);
+
+    //=========================================================================================================
+    /**
+     * Counts the events of the given phase, "X" for scopes and "C" for counters.
+     */
+    int countEvents(const QJsonArray& events,
+                    const QString& sPhase);
+
+    QTemporaryDir   m_tempDir;
+    int             m_iCapacity;
+};
+
+//=============================================================================================================
+
+TestMNETracer::TestMNETracer()
+: m_iCapacity(1 << 14)
+{
+}
+
+//=============================================================================================================
+
+void TestMNETracer::initTestCase()
+{
+    qInstallMessageHandler(UTILSLIB::ApplicationLogger::customLogWriter);
+
+    QVERIFY(m_tempDir.isValid());
+}
+
+//=============================================================================================================
+
+void TestMNETracer::dropWhenBufferFull()
+{
+    // The flusher must not drain the buffer while it is filled
+    const QString sFileName = m_tempDir.filePath("drop.json");
+    const int iNumOverflow = 100;
+
+    MNETracer::setFlushInterval(1000000);
+    MNETracer::enable(sFileName.toStdString());
+
+    for(int i = 0; i < m_iCapacity + iNumOverflow; ++i) {
+        MNETracer tracer(__FILE__, "scope", __LINE__);
+    }
+
+    QCOMPARE(MNETracer::numDroppedEvents(), static_cast<long long>(iNumOverflow));
+
+    MNETracer::disable();
+    MNETracer::setFlushInterval(50);
+
+    QJsonArray events = readEvents(sFileName);
+    QCOMPARE(countEvents(events, "X"), m_iCapacity);
+    QCOMPARE(countEvents(events, "C"), 1);
+    QCOMPARE(events.last().toObject()["args"].toObject()["MNETracer dropped events"].toInt(), iNumOverflow);
+}
+
+//=============================================================================================================
+
+void TestMNETracer::flushAllThreads()
+{
+    // Every thread records more events than its buffer holds, so nothing is lost only if the flusher keeps draining
+    const QString sFileName = m_tempDir.filePath("flush.json");
+    const int iNumThreads = 4;
+    const int iNumChunks = 20;
+    const int iChunkSize = 1000;
+
+    MNETracer::setFlushInterval(1);
+    MNETracer::enable(sFileName.toStdString());
+
+    const char* pCounterName = MNETracer::internName("chunk");
+
+    std::vector<std::thread> threads;
+    for(int t = 0; t < iNumThreads; ++t) {
+        threads.emplace_back([=]() {
+            for(int c = 0; c < iNumChunks; ++c) {
+                for(int i = 0; i < iChunkSize; ++i) {
+                    MNETracer tracer(__FILE__, "scope", __LINE__);
+                }
+                MNETracer::traceQuantity(pCounterName, c);
+                std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            }
+        });
+    }
+
+    for(std::thread& thread : threads) {
+        thread.join();
+    }
+
+    QCOMPARE(MNETracer::numDroppedEvents(), 0LL);
+
+    MNETracer::disable();
+    MNETracer::setFlushInterval(50);
+
+    QJsonArray events = readEvents(sFileName);
+    QCOMPARE(countEvents(events, "X"), iNumThreads * iNumChunks * iChunkSize);
+    QCOMPARE(countEvents(events, "C"), iNumThreads * iNumChunks);
+
+    QSet<int> threadIds;
+    for(const QJsonValue& event : events) {
+        threadIds.insert(event.toObject()["tid"].toInt());
+    }
+    QCOMPARE(threadIds.size(), iNumThreads);
+}
+
+//=============================================================================================================
+
+void TestMNETracer::restartConcurrently()
+{
+    // Enabling while another thread enables or disables must neither crash nor corrupt the file
+    const QString sFileName = m_tempDir.filePath("restart.json");
+    const int iNumThreads = 4;
+
+    std::vector<std::thread> threads;
+    for(int t = 0; t < iNumThreads; ++t) {
+        threads.emplace_back([=]() {
+            for(int i = 0; i < 25; ++i) {
+                MNETracer::enable(sFileName.toStdString());
+                {
+                    MNETracer tracer(__FILE__, "scope", __LINE__);
+                }
+                MNETracer::disable();
+            }
+        });
+    }
+
+    for(std::thread& thread : threads) {
+        thread.join();
+    }
+
+    QVERIFY(!MNETracer::isEnabled());
+
+    MNETracer::enable(sFileName.toStdString());
+    {
+        MNETracer tracer(__FILE__, "scope", __LINE__);
+    }
+    MNETracer::disable();
+
+    QCOMPARE(countEvents(readEvents(sFileName), "X"), 1);
+}
+
+//=============================================================================================================
+
+void TestMNETracer::cleanupTestCase()
+{
+}
+
+//=============================================================================================================
+
+QJsonArray TestMNETracer::readEvents(const QString& sFileName)
+{
+    QFile file(sFileName);
+    if(!file.open(QIODevice::ReadOnly)) {
+        return QJsonArray();
+    }
+
+    QJsonParseError error;
+    QJsonDocument document = QJsonDocument::fromJson(file.readAll(), &error);
+    if(error.error != QJsonParseError::NoError) {
+        qWarning() << "[TestMNETracer::readEvents]" << sFileName << "is no valid json:" << error.errorString();
+        return QJsonArray();
+    }
+
+    return document.object()["traceEvents"].toArray();
+}
+
+//=============================================================================================================
+
+int TestMNETracer::countEvents(const QJsonArray& events,
+                               const QString& sPhase)
+{
+    int iCount = 0;
+    for(const QJsonValue& event : events) {
+        if(event.toObject()["ph"].toString() == sPhase) {
+            ++iCount;
+        }
+    }
+    return iCount;
+}
+
+//=============================================================================================================
+// MAIN
+//=============================================================================================================
+
+QTEST_GUILESS_MAIN(TestMNETracer)
+#include "test_mnetracer.moc"
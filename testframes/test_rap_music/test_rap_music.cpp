@@ -0,0 +1,245 @@
+//=============================================================================================================
+/**
+ * @file     test_rap_music.cpp
+ * @author   agent <agent@local>
+ * @since    0.1.9
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, agent. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    Tests the RAP MUSIC pair scan.
+ *
+ */
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include <inverse/rapMusic/rapmusic.h>
+#include <mne/mne_forwardsolution.h>
+#include <fiff/fiff_named_matrix.h>
+#include <utils/generics/applicationlogger.h>
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QtTest>
+
+//=============================================================================================================
+// EIGEN INCLUDES
+//=============================================================================================================
+
+#include <Eigen/Dense>
+
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace INVERSELIB;
+using namespace MNELIB;
+using namespace FIFFLIB;
+using namespace Eigen;
+
+//=============================================================================================================
+/**
+ * Exposes the pair scan internals of RapMusic to compare them against the per pair SVD.
+ */
+class RapMusicProbe : public RapMusic
+{
+public:
+    RapMusicProbe(MNEForwardSolution& p_Fwd)
+    : RapMusic(p_Fwd, false, 2, 0.5)
+    {
+    }
+
+    //=========================================================================================================
+    /**
+     * Returns the largest difference between the per pair SVD and the precomputed source bases.
+     */
+    double maxPairDifference(const MatrixXd& p_matProjLeadField, const MatrixXd& p_matU_B) const
+    {
+        SourceBases t_sourceBases;
+        calcSourceBases(p_matProjLeadField, p_matU_B, t_sourceBases);
+
+        double t_dMaxDiff = 0.0;
+        MatrixX6T t_matProj_G(p_matProjLeadField.rows(), 6);
+
+        for(int i = 0; i < m_iNumLeadFieldCombinations; ++i) {
+            int idx1 = m_ppPairIdxCombinations[i]->x1;
+            int idx2 = m_ppPairIdxCombinations[i]->x2;
+
+            getGainMatrixPair(p_matProjLeadField, t_matProj_G, idx1, idx2);
+
+            t_dMaxDiff = std::max(t_dMaxDiff, std::fabs(subcorr(t_matProj_G, p_matU_B) - subcorr(t_sourceBases, idx1, idx2)));
+        }
+
+        return t_dMaxDiff;
+    }
+
+    //=========================================================================================================
+    /**
+     * Applies the projector of the given found source directions to the lead field, once via the full projector
+     * and once as low rank update. Returns the largest difference.
+     */
+    double maxProjectionDifference(const MatrixXd& p_matLeadField, const MatrixXd& p_matA_k_1) const
+    {
+        MatrixXd t_matOrthProj;
+        calcOrthProj(p_matA_k_1, t_matOrthProj);
+
+        MatrixXd t_matProjLeadField;
+        calcProjLeadField(p_matA_k_1, p_matLeadField, t_matProjLeadField);
+
+        return (t_matOrthProj * p_matLeadField - t_matProjLeadField).cwiseAbs().maxCoeff();
+    }
+};
+
+//=============================================================================================================
+/**
+ * DECLARE CLASS TestRapMusic
+ *
+ * @brief The TestRapMusic class checks the RAP MUSIC pair scan on a synthetic lead field.
+ *
+ */
+class TestRapMusic: public QObject
+{
+    Q_OBJECT
+
+public:
+    TestRapMusic();
+
+private slots:
+    void initTestCase();
+    void comparePairCorrelations();
+    void compareProjection();
+    void findSourcePair();
+    void cleanupTestCase();
+
+private:
+    double dEpsilon;
+    int iNumChannels;
+    int iNumSources;
+    MNEForwardSolution fwd;
+    MatrixXd matU_B;
+};
+
+//=============================================================================================================
+
+TestRapMusic::TestRapMusic()
+: dEpsilon(1e-10)
+, iNumChannels(64)
+, iNumSources(40)
+{
+}
+
+//=============================================================================================================
+
+void TestRapMusic::initTestCase()
+{
+    qInstallMessageHandler(UTILSLIB::ApplicationLogger::customLogWriter);
+
+    std::srand(42);
+
+    fwd.sol = FiffNamedMatrix::SDPtr(new FiffNamedMatrix());
+    fwd.sol->data = MatrixXd::Random(iNumChannels, 3 * iNumSources);
+    fwd.sol->nrow = iNumChannels;
+    fwd.sol->ncol = 3 * iNumSources;
+    fwd.nsource = iNumSources;
+
+    // One source with a rank deficient gain
+    fwd.sol->data.col(3 * 5 + 2) = fwd.sol->data.col(3 * 5) - 0.5 * fwd.sol->data.col(3 * 5 + 1);
+
+    matU_B = HouseholderQR<MatrixXd>(MatrixXd::Random(iNumChannels, 4)).householderQ() * MatrixXd::Identity(iNumChannels, 4);
+}
+
+//=============================================================================================================
+
+void TestRapMusic::comparePairCorrelations()
+{
+    RapMusicProbe rapMusic(fwd);
+
+    QVERIFY(rapMusic.maxPairDifference(fwd.sol->data, matU_B) < dEpsilon);
+
+    // Small gains trigger the rank truncation of the pair subspaces
+    QVERIFY(rapMusic.maxPairDifference(fwd.sol->data * 1e-6, matU_B) < dEpsilon);
+}
+
+//=============================================================================================================
+
+void TestRapMusic::compareProjection()
+{
+    RapMusicProbe rapMusic(fwd);
+
+    MatrixXd matA_k_1 = MatrixXd::Zero(iNumChannels, 3);
+    matA_k_1.col(0) = fwd.sol->data.middleCols(3 * 7, 3) * Vector3d(1.0, 2.0, 3.0);
+    matA_k_1.col(1) = fwd.sol->data.middleCols(3 * 21, 3) * Vector3d(-1.0, 0.5, 2.0);
+
+    QVERIFY(rapMusic.maxProjectionDifference(fwd.sol->data, matA_k_1) < dEpsilon);
+}
+
+//=============================================================================================================
+
+void TestRapMusic::findSourcePair()
+{
+    RapMusic rapMusic(fwd, false, 1, 0.5);
+
+    // Two correlated dipoles at sources 3 and 17
+    int iNumSamples = 200;
+    RowVectorXd vecTimeCourse(iNumSamples);
+    for(int i = 0; i < iNumSamples; ++i) {
+        vecTimeCourse(i) = std::sin(2.0 * M_PI * 10.0 * i / iNumSamples);
+    }
+
+    MatrixXd matMeasurement = fwd.sol->data.middleCols(3 * 3, 3) * Vector3d(0.0, 1.0, 0.0) * vecTimeCourse
+                              + fwd.sol->data.middleCols(3 * 17, 3) * Vector3d(1.0, 0.0, 1.0) * vecTimeCourse;
+
+    QList<DipolePair<double> > lDipoles;
+    rapMusic.calculateInverse(matMeasurement, lDipoles);
+
+    QCOMPARE(lDipoles.size(), 1);
+    QCOMPARE(lDipoles.first().m_iIdx1, 3);
+    QCOMPARE(lDipoles.first().m_iIdx2, 17);
+    QVERIFY(lDipoles.first().m_vCorrelation > 1.0 - 1e-6);
+
+    // The pre-screening must keep the winning pair
+    rapMusic.setPreScreening(5);
+    rapMusic.calculateInverse(matMeasurement, lDipoles);
+
+    QCOMPARE(lDipoles.size(), 1);
+    QCOMPARE(lDipoles.first().m_iIdx1, 3);
+    QCOMPARE(lDipoles.first().m_iIdx2, 17);
+}
+
+//=============================================================================================================
+
+void TestRapMusic::cleanupTestCase()
+{
+}
+
+//=============================================================================================================
+// MAIN
+//=============================================================================================================
+
+QTEST_GUILESS_MAIN(TestRapMusic)
+#include "test_rap_music.moc"
@@ -0,0 +1,517 @@
+//=============================================================================================================
+/**
+ * @file     test_rt_data_codec.cpp
+ * @author   agent <agent@local>
+ * @since    0.1.9
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, agent. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    Test for the compressed real-time data buffer encoding and the fan out to stream clients.
+ *
+ */
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include <utils/generics/applicationlogger.h>
+
+#include <fiff/fiff.h>
+
+#include <communication/rtClient/rtdatacodec.h>
+
+#include <algorithm>
+#include <limits>
+
+#include "fiffstreamclient.h"
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QtTest>
+#include <QElapsedTimer>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QSet>
+
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace FIFFLIB;
+using namespace COMMUNICATIONLIB;
+using namespace RTSERVER;
+using namespace Eigen;
+
+//=============================================================================================================
+/**
+ * Accepts connections and keeps their socket descriptors for FiffStreamClients.
+ */
+class DescriptorServer : public QTcpServer
+{
+public:
+    QList<qintptr> m_lSocketDescriptors;
+
+protected:
+    void incomingConnection(qintptr socketDescriptor) override
+    {
+        m_lSocketDescriptors.append(socketDescriptor);
+    }
+};
+
+//=============================================================================================================
+/**
+ * DECLARE CLASS TestRtDataCodec
+ *
+ * @brief The TestRtDataCodec class provides tests for the compressed real-time data buffer encoding
+ *
+ */
+class TestRtDataCodec: public QObject
+{
+    Q_OBJECT
+
+public:
+    TestRtDataCodec();
+
+private slots:
+    void initTestCase();
+    void compareRecordedData();
+    void compareWithoutCals();
+    void compareAdcValues();
+    void rejectCorruptBuffer();
+    void switchEncodingWhileStreaming();
+    void fanOutLatency();
+    void cleanupTestCase();
+
+private:
+    //=========================================================================================================
+    /**
+     * Verifies that every decoded sample lies within half a step (plus float rounding) of the original one.
+     */
+    void verifyError(const MatrixXf& matOriginal,
+                     const MatrixXf& matDecoded,
+                     const QByteArray& baEncoded);
+
+    MatrixXf    m_matData;
+    VectorXf    m_vecCals;
+};
+
+//=============================================================================================================
+
+TestRtDataCodec::TestRtDataCodec()
+{
+}
+
+//=============================================================================================================
+
+void TestRtDataCodec::initTestCase()
+{
+    qInstallMessageHandler(UTILSLIB::ApplicationLogger::customLogWriter);
+
+    QFile t_fileIn(QCoreApplication::applicationDirPath() + "/mne-cpp-test-data/MEG/sample/sample_audvis_trunc_raw.fif");
+
+    FiffRawData raw(t_fileIn);
+
+    MatrixXd matData, matTimes;
+    QVERIFY(raw.read_raw_segment(matData, matTimes, raw.first_samp, raw.last_samp));
+
+    m_matData = matData.cast<float>();
+
+    m_vecCals.resize(raw.info.chs.size());
+    for(int i = 0; i < raw.info.chs.size(); ++i) {
+        m_vecCals[i] = raw.info.chs.at(i).cal * raw.info.chs.at(i).range;
+    }
+}
+
+//=============================================================================================================
+
+void TestRtDataCodec::compareRecordedData()
+{
+    QElapsedTimer timer;
+    timer.start();
+    QByteArray baEncoded = RtDataCodec::encode(m_matData, m_vecCals);
+    qint64 iEncodeTime = timer.nsecsElapsed();
+
+    MatrixXf matDecoded;
+    timer.restart();
+    QVERIFY(RtDataCodec::decode(baEncoded, matDecoded));
+    qint64 iDecodeTime = timer.nsecsElapsed();
+
+    verifyError(m_matData, matDecoded, baEncoded);
+
+    qint64 iRawSize = m_matData.size() * static_cast<qint64>(sizeof(float));
+    qInfo() << "[TestRtDataCodec::compareRecordedData] float32" << iRawSize << "bytes, compressed" << baEncoded.size()
+            << "bytes, ratio" << static_cast<double>(iRawSize) / baEncoded.size();
+    qInfo() << "[TestRtDataCodec::compareRecordedData] encode" << iEncodeTime / 1000000.0 << "ms, decode"
+            << iDecodeTime / 1000000.0 << "ms for" << m_matData.rows() << "x" << m_matData.cols() << "samples";
+
+    QVERIFY(baEncoded.size() < iRawSize);
+}
+
+//=============================================================================================================
+
+void TestRtDataCodec::compareWithoutCals()
+{
+    // Without cals the steps are derived from the data, which keeps float32 precision
+    QByteArray baEncoded = RtDataCodec::encode(m_matData, VectorXf());
+
+    MatrixXf matDecoded;
+    QVERIFY(RtDataCodec::decode(baEncoded, matDecoded));
+
+    verifyError(m_matData, matDecoded, baEncoded);
+}
+
+//=============================================================================================================
+
+void TestRtDataCodec::compareAdcValues()
+{
+    // Integer multiples of the steps are reproduced exactly
+    VectorXf vecSteps = VectorXf::Constant(4, 0.5f);
+    MatrixXf matData(4, 1000);
+    for(int c = 0; c < matData.cols(); ++c) {
+        for(int r = 0; r < matData.rows(); ++r) {
+            matData(r,c) = 0.5f * static_cast<float>(((c * 7919 + r * 104729) % 20001) - 10000);
+        }
+    }
+
+    MatrixXf matDecoded;
+    QVERIFY(RtDataCodec::decode(RtDataCodec::encode(matData, vecSteps), matDecoded));
+
+    QCOMPARE(matDecoded.rows(), matData.rows());
+    QCOMPARE(matDecoded.cols(), matData.cols());
+    QVERIFY(matDecoded == matData);
+}
+
+//=============================================================================================================
+
+void TestRtDataCodec::rejectCorruptBuffer()
+{
+    QByteArray baEncoded = RtDataCodec::encode(m_matData.leftCols(100), m_vecCals);
+
+    MatrixXf matDecoded;
+    QVERIFY(!RtDataCodec::decode(baEncoded.left(4), matDecoded));
+    QVERIFY(!RtDataCodec::decode(baEncoded.left(baEncoded.size() / 2), matDecoded));
+
+    // A sample count the payload can't hold is rejected before the matrix is allocated
+    QByteArray baHeader;
+    QDataStream t_streamOut(&baHeader, QIODevice::WriteOnly);
+    t_streamOut << static_cast<qint32>(m_matData.rows()) << std::numeric_limits<qint32>::max();
+    QByteArray baHuge = baEncoded;
+    baHuge.replace(0, baHeader.size(), baHeader);
+    QVERIFY(!RtDataCodec::decode(baHuge, matDecoded));
+}
+
+//=============================================================================================================
+
+void TestRtDataCodec::switchEncodingWhileStreaming()
+{
+    // The test plays FiffStreamServer for a single FiffStreamClient: frames and encoding switches are queued to the
+    // client in the order in which the server emits them, and every buffer has to arrive in the encoding which
+    // was confirmed before it.
+    DescriptorServer t_server;
+    QVERIFY(t_server.listen(QHostAddress::LocalHost));
+
+    QTcpSocket t_socket;
+    t_socket.connectToHost(QHostAddress::LocalHost, t_server.serverPort());
+    QTRY_COMPARE(t_server.m_lSocketDescriptors.size(), 1);
+    QTRY_VERIFY(t_socket.state() == QAbstractSocket::ConnectedState);
+
+    FiffStreamClient t_client(0, t_server.m_lSocketDescriptors.first());
+    t_client.init();
+    t_client.startMeas(0);
+
+    QSet<qint32> t_setCompressedClients;
+    connect(&t_client, &FiffStreamClient::dataEncodingRequested, &t_client,
+            [&t_client, &t_setCompressedClients](qint32 id, qint32 encoding) {
+        if(encoding == FIFFV_MNE_RT_ENCODING_COMPRESSED) {
+            t_setCompressedClients.insert(id);
+        } else {
+            t_setCompressedClients.remove(id);
+        }
+        QMetaObject::invokeMethod(&t_client, [&t_client, encoding]() { t_client.setDataEncoding(encoding); }, Qt::QueuedConnection);
+    }, Qt::QueuedConnection);
+
+    auto forwardRawBuffer = [&](const MatrixXf& matData) {
+        QByteArray t_blockFrame, t_blockCompressedFrame;
+        if(t_setCompressedClients.isEmpty()) {
+            FiffStream t_FiffStreamOut(&t_blockFrame, QIODevice::WriteOnly);
+            t_FiffStreamOut.write_float(FIFF_DATA_BUFFER, matData.data(), matData.size());
+        } else {
+            FiffTag::SPtr t_pTag(new FiffTag());
+            t_pTag->kind = FIFF_MNE_RT_COMPRESSED_BUFFER;
+            t_pTag->type = FIFFT_BYTE;
+            t_pTag->next = FIFFV_NEXT_SEQ;
+            t_pTag->append(RtDataCodec::encode(matData, m_vecCals));
+            FiffStream t_FiffStreamOut(&t_blockCompressedFrame, QIODevice::WriteOnly);
+            t_FiffStreamOut.write_tag(t_pTag);
+        }
+        QMetaObject::invokeMethod(&t_client, [&t_client, t_blockFrame, t_blockCompressedFrame]() {
+            t_client.sendRawBuffer(t_blockFrame, t_blockCompressedFrame);
+        }, Qt::QueuedConnection);
+    };
+
+    auto requestEncoding = [&t_socket](qint32 encoding) {
+        FiffStream t_FiffStreamOut(&t_socket);
+        t_FiffStreamOut.write_rt_command(FIFFV_MNE_RT_SET_DATA_ENCODING, QString::number(encoding));
+        t_socket.flush();
+    };
+
+    // Stream while the encoding is switched to compressed and back, keep the tags in the order they arrive
+    const int iNSamples = 100;
+    const int iNAfterSwitch = 4;
+    QList<MatrixXf> lSent;
+    QList<FiffTag::SPtr> lReceived;
+    QByteArray baReceived;
+    int iNConfirmed = 0;
+    int iNSentAfterConfirm = 0;
+    bool bFloatRequested = false;
+    QElapsedTimer timer;
+    timer.start();
+
+    while(timer.elapsed() < 10000) {
+        if(iNConfirmed < 2 || iNSentAfterConfirm < iNAfterSwitch) {
+            lSent.append(m_matData.middleCols((lSent.size() * iNSamples) % (m_matData.cols() - iNSamples), iNSamples));
+            forwardRawBuffer(lSent.last());
+            if(iNConfirmed > 0) {
+                ++iNSentAfterConfirm;
+            }
+        }
+
+        if(lSent.size() == 2) {
+            requestEncoding(FIFFV_MNE_RT_ENCODING_COMPRESSED);
+        } else if(iNConfirmed == 1 && iNSentAfterConfirm == iNAfterSwitch && !bFloatRequested) {
+            // The buffers since the confirmation were serialized compressed, switch back
+            requestEncoding(FIFFV_MNE_RT_ENCODING_FLOAT);
+            bFloatRequested = true;
+        }
+
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+
+        // Split the received bytes into tags
+        baReceived.append(t_socket.readAll());
+        while(baReceived.size() >= 16) {
+            QDataStream t_streamHeader(baReceived);
+            qint32 iKind, iType, iSize;
+            t_streamHeader >> iKind >> iType >> iSize;
+            if(baReceived.size() < 16 + iSize) {
+                break;
+            }
+
+            QByteArray baTag = baReceived.left(16 + iSize);
+            baReceived.remove(0, 16 + iSize);
+
+            FiffStream t_FiffStreamIn(&baTag, QIODevice::ReadOnly);
+            FiffTag::SPtr t_pTag;
+            QVERIFY(t_FiffStreamIn.read_tag(t_pTag));
+            lReceived.append(t_pTag);
+
+            if(t_pTag->kind == FIFF_MNE_RT_DATA_ENCODING) {
+                ++iNConfirmed;
+                iNSentAfterConfirm = 0;
+            }
+        }
+
+        int iNBuffers = 0;
+        for(const FiffTag::SPtr& t_pTag : lReceived) {
+            if(t_pTag->kind == FIFF_DATA_BUFFER || t_pTag->kind == FIFF_MNE_RT_COMPRESSED_BUFFER) {
+                ++iNBuffers;
+            }
+        }
+        if(iNConfirmed == 2 && iNSentAfterConfirm >= iNAfterSwitch && iNBuffers == lSent.size()) {
+            break;
+        }
+    }
+
+    QCOMPARE(iNConfirmed, 2);
+
+    // Every buffer arrives once, in order and in the encoding confirmed before it
+    qint32 iEncoding = FIFFV_MNE_RT_ENCODING_FLOAT;
+    int iNCompressed = 0;
+    int iBuffer = 0;
+    for(const FiffTag::SPtr& t_pTag : lReceived) {
+        if(t_pTag->kind == FIFF_MNE_RT_DATA_ENCODING) {
+            iEncoding = *t_pTag->toInt();
+        } else if(t_pTag->kind == FIFF_DATA_BUFFER) {
+            QCOMPARE(iEncoding, FIFFV_MNE_RT_ENCODING_FLOAT);
+            QVERIFY(iBuffer < lSent.size());
+            MatrixXf matDecoded = Map<MatrixXf>(t_pTag->toFloat(), m_matData.rows(), iNSamples);
+            QVERIFY(matDecoded == lSent[iBuffer]);
+            ++iBuffer;
+        } else if(t_pTag->kind == FIFF_MNE_RT_COMPRESSED_BUFFER) {
+            QCOMPARE(iEncoding, FIFFV_MNE_RT_ENCODING_COMPRESSED);
+            QVERIFY(iBuffer < lSent.size());
+            MatrixXf matDecoded;
+            QVERIFY(RtDataCodec::decode(*t_pTag, matDecoded));
+            verifyError(lSent[iBuffer], matDecoded, *t_pTag);
+            ++iBuffer;
+            ++iNCompressed;
+        }
+    }
+
+    QCOMPARE(iBuffer, lSent.size());
+    QVERIFY(iNCompressed >= iNAfterSwitch);
+
+    qInfo() << "[TestRtDataCodec::switchEncodingWhileStreaming]" << lSent.size() << "buffers," << iNCompressed << "compressed";
+}
+
+//=============================================================================================================
+
+void TestRtDataCodec::fanOutLatency()
+{
+    // The test plays FiffStreamServer for a growing number of loopback clients. Every buffer is serialized once
+    // into a frame which all client queues share, the latency of a client is the time from handing the frame to
+    // the clients until the client received it completely. The next frame is sent once all clients received the
+    // previous one.
+    QList<int> lNumClients = QList<int>() << 1 << 4 << 16 << 32;
+    const int iNFrames = 50;
+
+    const MatrixXf matData = m_matData.leftCols(100);
+    QByteArray t_blockFrame;
+    FiffStream t_FiffStreamFrame(&t_blockFrame, QIODevice::WriteOnly);
+    t_FiffStreamFrame.write_float(FIFF_DATA_BUFFER, matData.data(), matData.size());
+
+    QByteArray t_blockStart;
+    FiffStream t_FiffStreamStart(&t_blockStart, QIODevice::WriteOnly);
+    t_FiffStreamStart.start_block(FIFFB_RAW_DATA);
+
+    for(int iNClients : lNumClients) {
+        DescriptorServer t_server;
+        QVERIFY(t_server.listen(QHostAddress::LocalHost));
+
+        QList<QSharedPointer<QTcpSocket> > lSockets;
+        for(int i = 0; i < iNClients; ++i) {
+            lSockets.append(QSharedPointer<QTcpSocket>(new QTcpSocket()));
+            lSockets.last()->connectToHost(QHostAddress::LocalHost, t_server.serverPort());
+        }
+
+        QTRY_COMPARE(t_server.m_lSocketDescriptors.size(), iNClients);
+        for(const QSharedPointer<QTcpSocket>& pSocket : lSockets) {
+            QTRY_VERIFY(pSocket->state() == QAbstractSocket::ConnectedState);
+        }
+
+        // The descriptors are accepted in the order in which the sockets connected
+        QList<QSharedPointer<FiffStreamClient> > lClients;
+        for(int i = 0; i < iNClients; ++i) {
+            lClients.append(QSharedPointer<FiffStreamClient>(new FiffStreamClient(i, t_server.m_lSocketDescriptors.at(i))));
+            lClients.last()->init();
+            lClients.last()->startMeas(i);
+        }
+
+        // Every client starts with the raw data block
+        for(const QSharedPointer<QTcpSocket>& pSocket : lSockets) {
+            QTRY_VERIFY(pSocket->bytesAvailable() >= t_blockStart.size());
+            QCOMPARE(pSocket->readAll(), t_blockStart);
+        }
+
+        QVector<double> vecLatency;
+        vecLatency.reserve(iNClients * iNFrames);
+        QVector<qint64> vecReceived(iNClients);
+        bool bIntact = true;
+        QElapsedTimer timer;
+
+        for(int f = 0; f < iNFrames; ++f) {
+            vecReceived.fill(0);
+            int iNDone = 0;
+
+            timer.start();
+            for(const QSharedPointer<FiffStreamClient>& pClient : lClients) {
+                pClient->sendRawBuffer(t_blockFrame, QByteArray());
+            }
+
+            while(iNDone < iNClients && timer.elapsed() < 10000) {
+                QCoreApplication::processEvents();
+
+                for(int i = 0; i < iNClients; ++i) {
+                    if(vecReceived[i] == t_blockFrame.size()) {
+                        continue;
+                    }
+
+                    const QByteArray baReceived = lSockets.at(i)->readAll();
+                    if(baReceived.isEmpty()) {
+                        continue;
+                    }
+
+                    bIntact = bIntact && baReceived == t_blockFrame.mid(vecReceived[i], baReceived.size());
+                    vecReceived[i] += baReceived.size();
+
+                    if(vecReceived[i] == t_blockFrame.size()) {
+                        vecLatency.append(timer.nsecsElapsed() / 1000.0);
+                        ++iNDone;
+                    }
+                }
+            }
+
+            QCOMPARE(iNDone, iNClients);
+        }
+
+        QVERIFY(bIntact);
+
+        std::sort(vecLatency.begin(), vecLatency.end());
+        qInfo() << "[TestRtDataCodec::fanOutLatency]" << iNClients << "clients," << t_blockFrame.size() << "bytes per frame, latency median"
+                << vecLatency.at(vecLatency.size() / 2) << "us, 95th percentile" << vecLatency.at((vecLatency.size() * 95) / 100)
+                << "us, max" << vecLatency.last() << "us";
+    }
+}
+
+//=============================================================================================================
+
+void TestRtDataCodec::cleanupTestCase()
+{
+}
+
+//=============================================================================================================
+
+void TestRtDataCodec::verifyError(const MatrixXf& matOriginal,
+                                  const MatrixXf& matDecoded,
+                                  const QByteArray& baEncoded)
+{
+    QCOMPARE(matDecoded.rows(), matOriginal.rows());
+    QCOMPARE(matDecoded.cols(), matOriginal.cols());
+
+    // Read back the steps from the header
+    QDataStream t_streamIn(baEncoded);
+    t_streamIn.setFloatingPointPrecision(QDataStream::SinglePrecision);
+    qint32 iChannels, iSamples;
+    t_streamIn >> iChannels >> iSamples;
+
+    for(int r = 0; r < matOriginal.rows(); ++r) {
+        float fStep;
+        t_streamIn >> fStep;
+
+        float fMaxError = (matDecoded.row(r) - matOriginal.row(r)).cwiseAbs().maxCoeff();
+        float fTolerance = 0.5f * fStep + 1e-6f * matOriginal.row(r).cwiseAbs().maxCoeff();
+
+        QVERIFY2(fMaxError <= fTolerance,
+                 QString("Channel %1: error %2 exceeds %3").arg(r).arg(fMaxError).arg(fTolerance).toUtf8().constData());
+    }
+}
+
+//=============================================================================================================
+// MAIN
+//=============================================================================================================
+
+QTEST_GUILESS_MAIN(TestRtDataCodec)
+#include "test_rt_data_codec.moc"
@@ -0,0 +1,271 @@
+//=============================================================================================================
+/**
+ * @file     test_scmeas_frames.cpp
+ * @author   agent <agent@local>
+ * @since    0.1.9
+ * @date     October, 2026
+ *
+ * @section  LICENSE
+ *
+ * Copyright (C) 2026, agent. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ * the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+ *       following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+ *       the following disclaimer in the documentation and/or other materials provided with the distribution.
+ *     * Neither the name of MNE-CPP authors nor the names of its contributors may be used
+ *       to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ * PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * @brief    Tests the shared data frames of the mne_scan measurement bus.
+ *
+ */
+
+//=============================================================================================================
+// INCLUDES
+//=============================================================================================================
+
+#include <scMeas/multisampleframe.h>
+
+#include <utils/generics/circularbuffer.h>
+#include <utils/generics/applicationlogger.h>
+
+//=============================================================================================================
+// QT INCLUDES
+//=============================================================================================================
+
+#include <QtTest>
+#include <QElapsedTimer>
+
+//=============================================================================================================
+// EIGEN INCLUDES
+//=============================================================================================================
+
+#include <Eigen/Core>
+
+//=============================================================================================================
+// USED NAMESPACES
+//=============================================================================================================
+
+using namespace SCMEASLIB;
+using namespace UTILSLIB;
+using namespace Eigen;
+
+//=============================================================================================================
+/**
+ * DECLARE CLASS TestScMeasFrames
+ *
+ * @brief The TestScMeasFrames class checks the shared data frames of the measurement bus and compares their
+ *        fan-out to several consumers with the former deep copy per consumer.
+ *
+ */
+class TestScMeasFrames: public QObject
+{
+    Q_OBJECT
+
+public:
+    TestScMeasFrames();
+
+private slots:
+    void initTestCase();
+    void shareFrames();
+    void reuseFrames();
+    void outliveFramePool();
+    void fanOut();
+    void cleanupTestCase();
+
+private:
+    int iNumChannels;
+    int iNumSamples;
+    int iNumBlocks;
+    int iNumConsumers;
+    int iNumRepetitions;
+    QList<MatrixXd> lBlocks;
+};
+
+//=============================================================================================================
+
+TestScMeasFrames::TestScMeasFrames()
+: iNumChannels(376)
+, iNumSamples(200)
+, iNumBlocks(10)
+, iNumConsumers(4)
+, iNumRepetitions(50)
+{
+}
+
+//=============================================================================================================
+
+void TestScMeasFrames::initTestCase()
+{
+    qInstallMessageHandler(UTILSLIB::ApplicationLogger::customLogWriter);
+
+    // Blocks as the FiffSimulator streams them, one notify of the measurement carries iNumBlocks of them
+    for(int i = 0; i < iNumBlocks; ++i) {
+        lBlocks.append(MatrixXd::Random(iNumChannels, iNumSamples));
+    }
+}
+
+//=============================================================================================================
+
+void TestScMeasFrames::shareFrames()
+{
+    MultiSampleFramePool pool;
+
+    MultiSampleFrame::ConstSPtr pFrame = pool.acquire(lBlocks.first(), 1000, 42);
+    MultiSampleFrame::ConstSPtr pShared = pFrame;
+
+    QVERIFY(pFrame->data() == lBlocks.first());
+    QCOMPARE(pFrame->firstSample(), static_cast<qint64>(1000));
+    QCOMPARE(pFrame->timestamp(), static_cast<qint64>(42));
+
+    // All consumers look at the same allocation
+    QCOMPARE(pShared->data().data(), pFrame->data().data());
+    QVERIFY(pFrame->data().data() != lBlocks.first().data());
+}
+
+//=============================================================================================================
+
+void TestScMeasFrames::reuseFrames()
+{
+    MultiSampleFramePool pool(4);
+
+    MultiSampleFrame::ConstSPtr pFrame = pool.acquire(lBlocks[0], 0, 0);
+    const double* pStorage = pFrame->data().data();
+    pFrame.reset();
+    QCOMPARE(pool.numFreeFrames(), 1);
+
+    // A released frame of the same size is reused with its storage
+    pFrame = pool.acquire(lBlocks[1], iNumSamples, 0);
+    QCOMPARE(pool.numAllocations(), static_cast<qint64>(1));
+    QCOMPARE(pool.numFreeFrames(), 0);
+    QCOMPARE(pFrame->data().data(), pStorage);
+    QVERIFY(pFrame->data() == lBlocks[1]);
+    QCOMPARE(pFrame->firstSample(), static_cast<qint64>(iNumSamples));
+
+    // The pool keeps at most the requested number of released frames
+    QList<MultiSampleFrame::ConstSPtr> lFrames;
+    for(int i = 0; i < 8; ++i) {
+        lFrames.append(pool.acquire(lBlocks[i % iNumBlocks], 0, 0));
+    }
+    lFrames.clear();
+    pFrame.reset();
+    QCOMPARE(pool.numFreeFrames(), 4);
+}
+
+//=============================================================================================================
+
+void TestScMeasFrames::outliveFramePool()
+{
+    MultiSampleFrame::ConstSPtr pFrame;
+
+    {
+        MultiSampleFramePool pool;
+        pFrame = pool.acquire(lBlocks.first(), 0, 0);
+    }
+
+    // The frame is still valid and is deleted instead of returned once released
+    QVERIFY(pFrame->data() == lBlocks.first());
+    pFrame.reset();
+}
+
+//=============================================================================================================
+
+void TestScMeasFrames::fanOut()
+{
+    QList<CircularBuffer_Matrix_double::SPtr> lMatrixBuffers;
+    QList<CircularBuffer<MultiSampleFrame::ConstSPtr>::SPtr> lFrameBuffers;
+    for(int i = 0; i < iNumConsumers; ++i) {
+        lMatrixBuffers.append(CircularBuffer_Matrix_double::SPtr::create(40));
+        lFrameBuffers.append(CircularBuffer<MultiSampleFrame::ConstSPtr>::SPtr::create(40));
+    }
+
+    QElapsedTimer timer;
+    double dChecksumMatrix = 0.0;
+    double dChecksumFrame = 0.0;
+
+    // Former fan-out, every consumer queues its own deep copy of every block
+    timer.start();
+    MatrixXd matData;
+    for(int r = 0; r < iNumRepetitions; ++r) {
+        QList<MatrixXd> lMeasurement;
+        for(int i = 0; i < lBlocks.size(); ++i) {
+            lMeasurement.append(lBlocks[i]);
+        }
+
+        for(int c = 0; c < iNumConsumers; ++c) {
+            for(int i = 0; i < lMeasurement.size(); ++i) {
+                QVERIFY(lMatrixBuffers[c]->push(lMeasurement[i]));
+            }
+            for(int i = 0; i < lMeasurement.size(); ++i) {
+                QVERIFY(lMatrixBuffers[c]->pop(matData));
+                dChecksumMatrix += matData(0, 0);
+            }
+        }
+    }
+    qint64 iTimeMatrix = timer.nsecsElapsed();
+
+    // Shared frames, the data is copied once into a pooled frame and all consumers queue references
+    MultiSampleFramePool pool;
+    qint64 iFirstSample = 0;
+
+    timer.start();
+    MultiSampleFrame::ConstSPtr pFrame;
+    for(int r = 0; r < iNumRepetitions; ++r) {
+        QList<MultiSampleFrame::ConstSPtr> lMeasurement;
+        for(int i = 0; i < lBlocks.size(); ++i) {
+            lMeasurement.append(pool.acquire(lBlocks[i], iFirstSample, 0));
+            iFirstSample += iNumSamples;
+        }
+
+        for(int c = 0; c < iNumConsumers; ++c) {
+            for(int i = 0; i < lMeasurement.size(); ++i) {
+                QVERIFY(lFrameBuffers[c]->push(lMeasurement[i]));
+            }
+            for(int i = 0; i < lMeasurement.size(); ++i) {
+                QVERIFY(lFrameBuffers[c]->pop(pFrame));
+                QCOMPARE(pFrame->data().data(), lMeasurement[i]->data().data());
+                dChecksumFrame += pFrame->data()(0, 0);
+            }
+        }
+    }
+    qint64 iTimeFrame = timer.nsecsElapsed();
+    pFrame.reset();
+
+    QCOMPARE(dChecksumFrame, dChecksumMatrix);
+    QCOMPARE(iFirstSample, static_cast<qint64>(iNumRepetitions*iNumBlocks*iNumSamples));
+
+    // Steady streaming reuses the frames of the previous notify
+    QVERIFY(pool.numAllocations() <= 2*iNumBlocks);
+
+    double dMBytesPerBlock = iNumChannels*iNumSamples*sizeof(double)/1e6;
+    qInfo("[TestScMeasFrames::fanOut] %d consumers, %d x %d blocks: deep copies %.1f MB in %.3f ms, shared frames %.1f MB in %.3f ms, %lld frame allocations",
+          iNumConsumers, iNumChannels, iNumSamples,
+          iNumRepetitions*iNumBlocks*(iNumConsumers + 1)*dMBytesPerBlock, iTimeMatrix/1e6,
+          iNumRepetitions*iNumBlocks*dMBytesPerBlock, iTimeFrame/1e6,
+          pool.numAllocations());
+}
+
+//=============================================================================================================
+
+void TestScMeasFrames::cleanupTestCase()
+{
+}
+
+//=============================================================================================================
+// MAIN
+//=============================================================================================================
+
+QTEST_GUILESS_MAIN(TestScMeasFrames)
+#include "test_scmeas_frames.moc"
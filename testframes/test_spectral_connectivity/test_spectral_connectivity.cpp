@@ -41,6 +41,7 @@
 #include <utils/generics/applicationlogger.h>
 
 #include <utils/ioutils.h>
+#include <utils/spectral.h>
 #include <connectivity/metrics/coherency.h>
 #include <connectivity/metrics/coherence.h>
 #include <connectivity/metrics/imagcoherence.h>
@@ -50,20 +51,24 @@
 #include <connectivity/metrics/weightedphaselagindex.h>
 #include <connectivity/metrics/debiasedsquaredweightedphaselagindex.h>
 #include <connectivity/metrics/crosscorrelation.h>
+#include <connectivity/connectivity.h>
 #include <connectivity/connectivitysettings.h>
 #include <connectivity/network/network.h>
+#include <connectivity/network/networkedge.h>
 
 //=============================================================================================================
 // QT INCLUDES
 //=============================================================================================================
 
 #include <QtTest>
+#include <QElapsedTimer>
 
 //=============================================================================================================
 // EIGEN INCLUDES
 //=============================================================================================================
 
 #include <Eigen/Core>
+#include <unsupported/Eigen/FFT>
 
 //=============================================================================================================
 // USED NAMESPACES
@@ -97,10 +102,19 @@ private slots:
     void spectralConnectivityCoherence();
     void spectralConnectivityImagCoherence();
     void spectralConnectivityXCOR();
+    void spectralConnectivityXCORBlocks();
+    void spectralConnectivityMultiMethods();
+    void spectralConnectivityMultiMethodsBenchmark();
     void cleanupTestCase();
 
 private:
     void compareConnectivity();
+    void compareNetworks(const Network& network,
+                         const Network& refNetwork);
+    Network calculateSingleMethod(const QString& sMethod,
+                                  ConnectivitySettings& connectivitySettings);
+    MatrixXd calculateXCORPairwise(const QList<MatrixXd>& lData,
+                                   int iNfft);
     QList<MatrixXd> readConnectivityData();
     double dEpsilon;
     double m_dConnectivityOutput;
@@ -348,6 +362,245 @@ void TestSpectralConnectivity::spectralConnectivityXCOR()
 
 //=============================================================================================================
 
+void TestSpectralConnectivity::spectralConnectivityXCORBlocks()
+{
+    //*********************************************************************************************************
+    // Compare the block wise cross correlation to one inverse FFT per pair for 64, 128 and 306 channels
+    //*********************************************************************************************************
+
+    QList<int> lNumberChannels = QList<int>() << 64 << 128 << 306;
+    int iNfft = 256;
+    QElapsedTimer timer;
+
+    for(int iNumberChannels : lNumberChannels) {
+        // Two trials so the order in which the trials are summed up does not matter
+        QList<MatrixXd> lData;
+        lData << MatrixXd::Random(iNumberChannels, iNfft) << MatrixXd::Random(iNumberChannels, iNfft);
+
+        ConnectivitySettings connectivitySettings;
+        connectivitySettings.setFFTSize(iNfft);
+        connectivitySettings.setWindowType("hanning");
+        connectivitySettings.append(lData);
+
+        timer.start();
+        MatrixXd matRefDist = calculateXCORPairwise(lData, iNfft);
+        qint64 iTimePairwise = timer.elapsed();
+
+        timer.restart();
+        Network network = CrossCorrelation::calculate(connectivitySettings);
+        qint64 iTimeBlocks = timer.elapsed();
+
+        QCOMPARE(network.getFullEdges().size(), iNumberChannels * (iNumberChannels + 1) / 2);
+
+        // The arithmetic per pair is unchanged, so the weights have to match exactly and not only up to qFuzzyCompare
+        for(const QSharedPointer<NetworkEdge>& pEdge : network.getFullEdges()) {
+            QVERIFY(pEdge->getMatrixWeight()(0,0) == matRefDist(pEdge->getStartNodeID(), pEdge->getEndNodeID()));
+        }
+
+        qInfo() << "[TestSpectralConnectivity::spectralConnectivityXCORBlocks]" << iNumberChannels << "channels, pairwise" << iTimePairwise << "ms, blocks" << iTimeBlocks << "ms";
+    }
+}
+
+//=============================================================================================================
+
+void TestSpectralConnectivity::spectralConnectivityMultiMethods()
+{
+    //*********************************************************************************************************
+    // Compute all spectral methods in one fused pass and compare them to the single metric results
+    //*********************************************************************************************************
+
+    QStringList lMethods = QStringList() << "WPLI" << "USPLI" << "PLI" << "COH" << "IMAGCOH" << "PLV" << "DSWPLI";
+
+    ConnectivitySettings connectivitySettings;
+    connectivitySettings.setFFTSize(128);
+    connectivitySettings.setWindowType("hanning");
+    connectivitySettings.setConnectivityMethods(lMethods);
+
+    for(int i = 0; i < 20; ++i) {
+        connectivitySettings.append(MatrixXd::Random(12, 128));
+    }
+
+    QList<Network> lNetworks = Connectivity::calculate(connectivitySettings);
+    QCOMPARE(lNetworks.size(), lMethods.size());
+
+    for(int i = 0; i < lNetworks.size(); ++i) {
+        compareNetworks(lNetworks.at(i),
+                        calculateSingleMethod(lNetworks.at(i).getConnectivityMethod(), connectivitySettings));
+    }
+
+    // Also check the fused pass on the reference data set
+    m_connectivitySettings.setConnectivityMethods(lMethods);
+    lNetworks = Connectivity::calculate(m_connectivitySettings);
+    QCOMPARE(lNetworks.size(), lMethods.size());
+
+    for(int i = 0; i < lNetworks.size(); ++i) {
+        compareNetworks(lNetworks.at(i),
+                        calculateSingleMethod(lNetworks.at(i).getConnectivityMethod(), m_connectivitySettings));
+    }
+}
+
+//=============================================================================================================
+
+void TestSpectralConnectivity::spectralConnectivityMultiMethodsBenchmark()
+{
+    //*********************************************************************************************************
+    // Compare the cost of five spectral methods to the cost of a single one on a 306 channel MEG sized data set
+    //*********************************************************************************************************
+
+    ConnectivitySettings connectivitySettings;
+    connectivitySettings.setFFTSize(256);
+    connectivitySettings.setWindowType("hanning");
+
+    for(int i = 0; i < 10; ++i) {
+        connectivitySettings.append(MatrixXd::Random(306, 256));
+    }
+
+    // Restrict the bins to keep the memory footprint of the single metric path reasonable
+    AbstractMetric::m_iNumberBinStart = 8;
+    AbstractMetric::m_iNumberBinAmount = 16;
+
+    QElapsedTimer timer;
+
+    connectivitySettings.setConnectivityMethods(QStringList() << "WPLI");
+    timer.start();
+    QList<Network> lNetworks = Connectivity::calculate(connectivitySettings);
+    qint64 iTimeSingle = timer.elapsed();
+    QCOMPARE(lNetworks.size(), 1);
+
+    QStringList lMethods = QStringList() << "WPLI" << "PLI" << "COH" << "IMAGCOH" << "PLV";
+
+    timer.restart();
+    for(const QString& sMethod : lMethods) {
+        calculateSingleMethod(sMethod, connectivitySettings);
+    }
+    qint64 iTimeSequential = timer.elapsed();
+
+    connectivitySettings.setConnectivityMethods(lMethods);
+    timer.restart();
+    lNetworks = Connectivity::calculate(connectivitySettings);
+    qint64 iTimeFused = timer.elapsed();
+    QCOMPARE(lNetworks.size(), lMethods.size());
+
+    qInfo() << "[TestSpectralConnectivity::spectralConnectivityMultiMethodsBenchmark] 306 channels, single metric" << iTimeSingle << "ms, five metrics one after another" << iTimeSequential << "ms, five metrics fused" << iTimeFused << "ms";
+
+    AbstractMetric::m_iNumberBinStart = -1;
+    AbstractMetric::m_iNumberBinAmount = -1;
+}
+
+//=============================================================================================================
+
+Network TestSpectralConnectivity::calculateSingleMethod(const QString& sMethod,
+                                                        ConnectivitySettings& connectivitySettings)
+{
+    if(sMethod == "WPLI") {
+        return WeightedPhaseLagIndex::calculate(connectivitySettings);
+    } else if(sMethod == "USPLI") {
+        return UnbiasedSquaredPhaseLagIndex::calculate(connectivitySettings);
+    } else if(sMethod == "PLI") {
+        return PhaseLagIndex::calculate(connectivitySettings);
+    } else if(sMethod == "COH") {
+        return Coherence::calculate(connectivitySettings);
+    } else if(sMethod == "IMAGCOH") {
+        return ImagCoherence::calculate(connectivitySettings);
+    } else if(sMethod == "PLV") {
+        return PhaseLockingValue::calculate(connectivitySettings);
+    } else if(sMethod == "DSWPLI") {
+        return DebiasedSquaredWeightedPhaseLagIndex::calculate(connectivitySettings);
+    }
+
+    return Network(sMethod);
+}
+
+//=============================================================================================================
+
+MatrixXd TestSpectralConnectivity::calculateXCORPairwise(const QList<MatrixXd>& lData,
+                                                         int iNfft)
+{
+    // One inverse FFT per pair, as CrossCorrelation::compute used to do it
+    QPair<MatrixXd, VectorXd> tapers = Spectral::generateTapers(lData.first().cols(), "hanning");
+    int iNRows = lData.first().rows();
+    double denom = tapers.second.sum();
+
+    FFT<double> fft;
+    fft.SetFlag(fft.HalfSpectrum);
+
+    MatrixXd matDist = MatrixXd::Zero(iNRows, iNRows);
+    RowVectorXd vecInputFFT, rowData;
+    RowVectorXcd vecResultFreq, vecResultXCor;
+    int idx = 0;
+
+    for(const MatrixXd& matData : lData) {
+        QList<MatrixXcd> lTapSpectra;
+
+        for(int i = 0; i < iNRows; ++i) {
+            rowData.array() = matData.row(i).array() - matData.row(i).mean();
+            MatrixXcd matTapSpectrum(tapers.first.rows(), int(floor(iNfft / 2.0)) + 1);
+
+            for(int j = 0; j < tapers.first.rows(); ++j) {
+                vecInputFFT = rowData.cwiseProduct(tapers.first.row(j));
+                fft.fwd(vecResultFreq, vecInputFFT, iNfft);
+                matTapSpectrum.row(j) = vecResultFreq * tapers.second(j);
+            }
+
+            lTapSpectra.append(matTapSpectrum);
+        }
+
+        MatrixXd matDistTrial = MatrixXd::Zero(iNRows, iNRows);
+
+        for(int i = 0; i < iNRows; ++i) {
+            vecResultFreq = lTapSpectra.at(i).colwise().sum() / denom;
+
+            for(int j = i; j < iNRows; ++j) {
+                vecResultXCor = vecResultFreq.cwiseProduct(lTapSpectra.at(j).colwise().sum() / denom);
+                fft.inv(vecInputFFT, vecResultXCor, iNfft);
+                vecInputFFT.maxCoeff(&idx);
+                matDistTrial(i,j) = vecInputFFT(idx);
+            }
+        }
+
+        matDist += matDistTrial;
+    }
+
+    return matDist / lData.size();
+}
+
+//=============================================================================================================
+
+void TestSpectralConnectivity::compareNetworks(const Network& network,
+                                               const Network& refNetwork)
+{
+    QCOMPARE(network.getConnectivityMethod(), refNetwork.getConnectivityMethod());
+    QCOMPARE(network.getFullEdges().size(), refNetwork.getFullEdges().size());
+
+    // The edge order of the coherence networks depends on the thread scheduling. Match edges by their nodes.
+    QMap<QPair<int,int>, MatrixXd> mapRefWeights;
+
+    for(const QSharedPointer<NetworkEdge>& pEdge : refNetwork.getFullEdges()) {
+        mapRefWeights.insert(qMakePair(pEdge->getStartNodeID(), pEdge->getEndNodeID()), pEdge->getMatrixWeight());
+    }
+
+    for(const QSharedPointer<NetworkEdge>& pEdge : network.getFullEdges()) {
+        QPair<int,int> pairNodes = qMakePair(pEdge->getStartNodeID(), pEdge->getEndNodeID());
+        QVERIFY(mapRefWeights.contains(pairNodes));
+
+        MatrixXd matWeight = pEdge->getMatrixWeight();
+        MatrixXd matRefWeight = mapRefWeights.value(pairNodes);
+        QCOMPARE(matWeight.rows(), matRefWeight.rows());
+        QCOMPARE(matWeight.cols(), matRefWeight.cols());
+
+        for(int i = 0; i < matWeight.size(); ++i) {
+            // Bins without any phase information yield NaN in both implementations
+            if(std::isnan(matWeight(i)) && std::isnan(matRefWeight(i))) {
+                continue;
+            }
+
+            QVERIFY(fabs(matWeight(i) - matRefWeight(i)) < dEpsilon);
+        }
+    }
+}
+
+//=============================================================================================================
+
 QList<MatrixXd> TestSpectralConnectivity::readConnectivityData()
 {
     MatrixXd inputTrials;
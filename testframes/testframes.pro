@@ -58,6 +58,17 @@ SUBDIRS += \
     test_fiff_digitizer \
     test_mne_msh_display_surface_set \
     test_mne_project_to_surface \
+    test_rt_data_codec \
+    test_ftbuffer \
+    test_rap_music \
+    test_kmeans \
+    test_fs_io \
+    test_fiff_tag_convert \
+    test_fiff_ch_name_index \
+    test_fiff_proj \
+    test_scmeas_frames \
+    test_mnetracer \
+    test_mne_epoch_data_list \
 
     qtHaveModule(charts) {
         SUBDIRS += \